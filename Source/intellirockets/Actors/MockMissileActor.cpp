@@ -10,12 +10,16 @@
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "Systems/ScenarioMenuSubsystem.h"
+#include "Systems/ScenarioCheckpoint.h"
 #include "Systems/ScenarioTestMetrics.h"
+#include "Systems/MissileTrace.h"
+#include "Systems/MissileTelemetryRecorder.h"
 #include "Actors/RadarJammerActor.h"
 #include "EngineUtils.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "CollisionQueryParams.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 AMockMissileActor::AMockMissileActor()
 {
@@ -83,6 +87,7 @@ void AMockMissileActor::InitializeMissile(AActor* InTarget, float InLaunchSpeed,
 {
 	// 允许目标为nullptr，导弹会在视野内自动搜索目标
 	TargetActor = InTarget;
+	TargetInstance = FBlueUnitHandle();
 	const float ClampedSpeed = FMath::Clamp(InLaunchSpeed, MinLaunchSpeed, MaxLaunchSpeed);
 	Speed = ClampedSpeed;
 	AscentSpeed = ClampedSpeed * 0.5f;
@@ -93,6 +98,7 @@ void AMockMissileActor::InitializeMissile(AActor* InTarget, float InLaunchSpeed,
 	StartLocation = GetActorLocation();
 	LastTargetSearchTime = 0.f;
 	bInJammerRange = false;
+	CurrentJammingRatio = -1.f;
 	bCountermeasureActive = false;
 	bShouldUseCountermeasure = false;
 	CountermeasureActivationTime = -1.f;
@@ -120,6 +126,7 @@ void AMockMissileActor::InitializeMissile(AActor* InTarget, float InLaunchSpeed,
 	// 初始化反制相关状态
 	bCountermeasureEnabled = false;  // 默认不启用，需要根据算法配置设置
 	bInJammerRange = false;
+	CurrentJammingRatio = -1.f;
 	bCountermeasureActive = false;
 	bShouldUseCountermeasure = false;
 	CountermeasureActivationTime = -1.f;
@@ -129,6 +136,9 @@ void AMockMissileActor::InitializeMissile(AActor* InTarget, float InLaunchSpeed,
 	SplitGroupId = INDEX_NONE;
 	bUseFixedSplitTarget = false;
 	FixedSplitTargetLocation = FVector::ZeroVector;
+
+	TRACE_MISSILE_SPAWN(this, bIsInterceptor, SplitGeneration);
+	TRACE_MISSILE_EVENT(this, Launch);
 	
 	// 如果提供了目标，缓存其位置；否则使用默认方向
 	if (TargetActor.IsValid())
@@ -363,6 +373,9 @@ void AMockMissileActor::TriggerImpact(AActor* OtherActor)
 
 void AMockMissileActor::Tick(float DeltaSeconds)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(AMockMissileActor::Tick);
+	TRACE_MISSILE_UPDATE_SCOPE(this);
+
 	Super::Tick(DeltaSeconds);
 
 	HandleLifetime(DeltaSeconds);
@@ -402,6 +415,7 @@ void AMockMissileActor::Tick(float DeltaSeconds)
 				LastTargetSearchTime = ElapsedLifetime;
 				
 				// 打印目标状态日志
+				FVector InstanceLocation;
 				if (TargetActor.IsValid())
 				{
 					UE_LOG(LogTemp, Log, TEXT("[Missile %s] 目标已锁定: %s (位置: %s, 距离: %.2f)"), 
@@ -410,6 +424,11 @@ void AMockMissileActor::Tick(float DeltaSeconds)
 						*TargetActor->GetActorLocation().ToString(), 
 						FVector::Dist(GetActorLocation(), TargetActor->GetActorLocation()));
 				}
+				else if (GetCurrentTargetLocation(InstanceLocation))
+				{
+					UE_LOG(LogTemp, Verbose, TEXT("[Missile %s] 目标已锁定: 实例 %d (位置: %s, 距离: %.2f)"), 
+						*GetName(), TargetInstance.Id, *InstanceLocation.ToString(), FVector::Dist(GetActorLocation(), InstanceLocation));
+				}
 				else
 				{
 					UE_LOG(LogTemp, Log, TEXT("[Missile %s] 当前无目标，正在搜索视野内的目标..."), *GetName());
@@ -422,8 +441,8 @@ void AMockMissileActor::Tick(float DeltaSeconds)
 				{
 					UE_LOG(LogTemp, Warning, TEXT("[Missile %s] 进入干扰区域，失去目标: %s"), 
 						*GetName(), *TargetActor->GetName());
-					TargetActor = nullptr;
 				}
+				ClearTarget();
 			}
 			
 			// 如果已经分裂或使用固定分裂目标，使用直线飞行（不再追踪）
@@ -453,6 +472,7 @@ void AMockMissileActor::HandleLifetime(float DeltaSeconds)
 		if (!bExpiredNotified)
 		{
 			bExpiredNotified = true;
+			TRACE_MISSILE_EVENT(this, Expired);
 			// 清除干扰区域的反制状态（导弹消失后恢复）
 			ClearJammerCountermeasure();
 			// 输出反制统计信息
@@ -492,9 +512,10 @@ void AMockMissileActor::UpdateAscent(float DeltaSeconds)
 	}
 	
 	// 在上升过程中，如果目标很近，提前开始制导
-	if (TargetActor.IsValid())
+	FVector AscentTargetLocation;
+	if (GetCurrentTargetLocation(AscentTargetLocation))
 	{
-		const float DistanceToTarget = FVector::Dist(CurrentLocation, TargetActor->GetActorLocation());
+		const float DistanceToTarget = FVector::Dist(CurrentLocation, AscentTargetLocation);
 		// 如果目标距离小于上升高度的2倍，提前开始制导
 		if (DistanceToTarget < AscentHeight * 2.f && DeltaHeight >= AscentHeight * 0.3f)
 		{
@@ -507,22 +528,27 @@ void AMockMissileActor::UpdateAscent(float DeltaSeconds)
 
 void AMockMissileActor::BeginHoming()
 {
+	if (bAscending)
+	{
+		TRACE_MISSILE_EVENT(this, BeginHoming);
+	}
 	bAscending = false;
 	
 	// 如果没有目标，尝试搜索一个
-	if (!TargetActor.IsValid())
+	FVector HomingTargetLocation;
+	if (!GetCurrentTargetLocation(HomingTargetLocation))
 	{
 		SearchAndLockTarget();
 	}
 	
 	// 如果仍然没有目标，使用当前方向继续飞行
-	if (!TargetActor.IsValid())
+	if (!GetCurrentTargetLocation(HomingTargetLocation))
 	{
 		CachedTargetLocation = GetActorLocation() + GetActorForwardVector() * 4000.f;
 	}
 	else
 	{
-		CachedTargetLocation = TargetActor->GetActorLocation();
+		CachedTargetLocation = HomingTargetLocation;
 	}
 	
 	// 计算抛物线轨迹的初始速度
@@ -651,9 +677,10 @@ void AMockMissileActor::UpdateHoming(float DeltaSeconds)
 	}
 	
 	// 更新目标位置（只有在没有绕过航点时才更新）
-	if (TargetActor.IsValid())
+	FVector CurrentTargetLocation;
+	if (GetCurrentTargetLocation(CurrentTargetLocation))
 	{
-		CachedTargetLocation = TargetActor->GetActorLocation();
+		CachedTargetLocation = CurrentTargetLocation;
 	}
 	else if (CachedTargetLocation.IsNearlyZero())
 	{
@@ -661,25 +688,20 @@ void AMockMissileActor::UpdateHoming(float DeltaSeconds)
 		CachedTargetLocation = GetActorLocation() + GetActorForwardVector() * 4000.f;
 	}
 	
-	// 优先检查到实际目标Actor的距离（更准确）
-	if (TargetActor.IsValid())
+	// 优先检查到实际目标的距离（更准确），命中距离阈值500厘米（5米），对于近处目标更友好
+	if (TryImpactCurrentTarget())
 	{
-		const float DistanceToActualTarget = FVector::Dist(CurrentLocation, TargetActor->GetActorLocation());
-		// 增加命中距离阈值到500厘米（5米），对于近处目标更友好
-		if (DistanceToActualTarget <= 500.f)
-		{
-			HandleImpact(TargetActor.Get());
-			return;
-		}
+		return;
 	}
 
 	const FVector ToTarget = CachedTargetLocation - CurrentLocation;
 	const float DistanceToTarget = ToTarget.Size();
 	
 	// HL分配算法：当导弹接近目标时（距离100米=10000cm）触发分裂
-	if (bHLAllocationEnabled && !bHasSplit && TargetActor.IsValid())
+	FVector SplitReferenceLocation;
+	if (bHLAllocationEnabled && !bHasSplit && GetCurrentTargetLocation(SplitReferenceLocation))
 	{
-		const float DistanceToActualTarget = FVector::Dist(CurrentLocation, TargetActor->GetActorLocation());
+		const float DistanceToActualTarget = FVector::Dist(CurrentLocation, SplitReferenceLocation);
 		if (DistanceToActualTarget < 10000.f) // 100米
 		{
 			TrySplitForClusterTargets(TargetActor.Get());
@@ -774,14 +796,7 @@ void AMockMissileActor::UpdateHoming(float DeltaSeconds)
 	}
 
 	// 再次检查到实际目标的距离（在移动后）
-	if (TargetActor.IsValid())
-	{
-		const float DistanceSq = FVector::DistSquared(GetActorLocation(), TargetActor->GetActorLocation());
-		if (DistanceSq <= FMath::Square(500.f)) // 增加到500厘米
-		{
-			HandleImpact(TargetActor.Get());
-		}
-	}
+	TryImpactCurrentTarget();
 }
 
 void AMockMissileActor::HandleImpact(AActor* HitActor)
@@ -799,7 +814,13 @@ void AMockMissileActor::HandleImpact(AActor* HitActor)
 			{
 				if (UScenarioMenuSubsystem* Subsystem = GameInstance->GetSubsystem<UScenarioMenuSubsystem>())
 				{
-					const FString HitName = (HitActor ? HitActor->GetName() : FString());
+					FString HitName = (HitActor ? HitActor->GetName() : FString());
+					// 实例化蓝方共用一个容器 Actor，按目标实例区分命中的目标
+					const FBlueForceInstances& Instances = Subsystem->GetBlueForceInstances();
+					if ((!HitActor || Instances.IsContainer(HitActor)) && Instances.Find(TargetInstance))
+					{
+						HitName = Instances.Find(TargetInstance)->Name;
+					}
 					Subsystem->RegisterHLSplitGroupHit(SplitGroupId, HitName);
 					if (bIsSplitChild)
 					{
@@ -814,6 +835,7 @@ void AMockMissileActor::HandleImpact(AActor* HitActor)
 	// 这里不再调用TrySplitForClusterTargets，因为应该在命中前就分裂
 
 	bHasImpacted = true;
+	TRACE_MISSILE_EVENT(this, Impact);
 	
 	// 记录命中时是否正在被干扰
 	UE_LOG(LogTemp, Log, TEXT("[Missile %s] 命中目标 %s，命中时是否正在被干扰: %s"), 
@@ -879,13 +901,18 @@ bool AMockMissileActor::IsTargetInView(AActor* Candidate) const
 		return false;
 	}
 
+	return IsLocationInView(Candidate->GetActorLocation(), Candidate);
+}
+
+bool AMockMissileActor::IsLocationInView(const FVector& Location, const AActor* IgnoredActor) const
+{
 	const FVector MissileLocation = GetActorLocation();
 	const FVector MissileForward = GetActorForwardVector();
-	const FVector ToTarget = Candidate->GetActorLocation() - MissileLocation;
+	const FVector ToTarget = Location - MissileLocation;
 	const float Distance = ToTarget.Size();
 
 	// 检查距离
-	if (Distance > ViewDistance || Distance < 100.f)
+	if (Distance > GetEffectiveViewDistance() || Distance < 100.f)
 	{
 		return false;
 	}
@@ -907,16 +934,20 @@ bool AMockMissileActor::IsTargetInView(AActor* Candidate) const
 		FHitResult HitResult;
 		FCollisionQueryParams QueryParams;
 		QueryParams.AddIgnoredActor(this);
-		QueryParams.AddIgnoredActor(Candidate);
+		if (IgnoredActor)
+		{
+			QueryParams.AddIgnoredActor(IgnoredActor);
+		}
 		QueryParams.bTraceComplex = false;
 
 		const FVector Start = MissileLocation;
-		const FVector End = Candidate->GetActorLocation();
+		const FVector End = Location;
 		
+		FScenarioPerformanceRecorder::NoteTraces();
 		if (World->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, QueryParams))
 		{
 			// 如果射线被遮挡，检查是否遮挡物就是目标本身（允许）
-			if (HitResult.GetActor() != Candidate)
+			if (HitResult.GetActor() != IgnoredActor)
 			{
 				return false; // 被其他物体遮挡
 			}
@@ -964,6 +995,135 @@ AActor* AMockMissileActor::FindTargetInView() const
 	return nullptr;
 }
 
+FBlueUnitHandle AMockMissileActor::FindTargetInstanceInView() const
+{
+	const FBlueForceInstances* Instances = GetBlueForceInstances();
+	if (!Instances || Instances->GetAliveCount() == 0)
+	{
+		return FBlueUnitHandle();
+	}
+
+	// 先按距离与视野锥筛选（不做射线），再由近到远做遮挡检测，
+	// 上千个实例时每次搜索也只需要少量射线
+	const FVector MissileLocation = GetActorLocation();
+	const FVector MissileForward = GetActorForwardVector();
+	const float CosViewAngle = FMath::Cos(FMath::DegreesToRadians(ViewAngle) * 0.5f);
+	const float MaxDistanceSq = FMath::Square(GetEffectiveViewDistance());
+
+	TArray<FBlueUnitHandle> AliveUnits;
+	Instances->GetAliveUnitsInRadius(MissileLocation, GetEffectiveViewDistance(), AliveUnits);
+
+	TArray<TPair<float, FBlueUnitHandle>> Candidates;
+	for (const FBlueUnitHandle& Handle : AliveUnits)
+	{
+		FVector Location;
+		if (!Instances->GetLocation(Handle, Location))
+		{
+			continue;
+		}
+		const FVector ToTarget = Location - MissileLocation;
+		const float DistanceSq = ToTarget.SizeSquared();
+		if (DistanceSq > MaxDistanceSq || DistanceSq < FMath::Square(100.f))
+		{
+			continue;
+		}
+		if (FVector::DotProduct(MissileForward, ToTarget.GetSafeNormal()) < CosViewAngle)
+		{
+			continue;
+		}
+		Candidates.Emplace(DistanceSq, Handle);
+	}
+
+	Candidates.Sort([](const TPair<float, FBlueUnitHandle>& A, const TPair<float, FBlueUnitHandle>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	constexpr int32 MaxOcclusionChecks = 8;
+	for (int32 Index = 0; Index < FMath::Min(Candidates.Num(), MaxOcclusionChecks); ++Index)
+	{
+		FVector Location;
+		Instances->GetLocation(Candidates[Index].Value, Location);
+		if (IsLocationInView(Location, Instances->GetContainer()))
+		{
+			return Candidates[Index].Value;
+		}
+	}
+	return FBlueUnitHandle();
+}
+
+const FBlueForceInstances* AMockMissileActor::GetBlueForceInstances() const
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			if (const UScenarioMenuSubsystem* Subsystem = GameInstance->GetSubsystem<UScenarioMenuSubsystem>())
+			{
+				return &Subsystem->GetBlueForceInstances();
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool AMockMissileActor::GetCurrentTargetLocation(FVector& OutLocation) const
+{
+	if (TargetActor.IsValid())
+	{
+		OutLocation = TargetActor->GetActorLocation();
+		return true;
+	}
+
+	if (TargetInstance.IsValid())
+	{
+		if (const FBlueForceInstances* Instances = GetBlueForceInstances())
+		{
+			return Instances->GetLocation(TargetInstance, OutLocation);
+		}
+	}
+	return false;
+}
+
+void AMockMissileActor::ClearTarget()
+{
+	TargetActor = nullptr;
+	TargetInstance = FBlueUnitHandle();
+}
+
+bool AMockMissileActor::TryImpactCurrentTarget()
+{
+	if (TargetActor.IsValid())
+	{
+		if (FVector::DistSquared(GetActorLocation(), TargetActor->GetActorLocation()) <= FMath::Square(500.f))
+		{
+			HandleImpact(TargetActor.Get());
+			return true;
+		}
+		return false;
+	}
+
+	FVector InstanceLocation;
+	if (GetCurrentTargetLocation(InstanceLocation) && FVector::DistSquared(GetActorLocation(), InstanceLocation) <= FMath::Square(500.f))
+	{
+		// 实例没有独立 Actor，以容器作为命中对象，具体摧毁哪些实例由子系统按爆炸位置判定
+		const FBlueForceInstances* Instances = GetBlueForceInstances();
+		HandleImpact(Instances ? Instances->GetContainer() : nullptr);
+		return true;
+	}
+	return false;
+}
+
+void AMockMissileActor::SetTargetInstance(const FBlueUnitHandle& InTargetInstance)
+{
+	TargetInstance = InTargetInstance;
+	FVector InstanceLocation;
+	if (!TargetActor.IsValid() && GetCurrentTargetLocation(InstanceLocation))
+	{
+		CachedTargetLocation = InstanceLocation;
+	}
+}
+
 void AMockMissileActor::SearchAndLockTarget()
 {
 	// 如果当前目标有效且在视野内，保持锁定
@@ -978,9 +1138,21 @@ void AMockMissileActor::SearchAndLockTarget()
 		// 目标不在视野内或已失效，清除目标
 		TargetActor = nullptr;
 	}
+	else if (TargetInstance.IsValid())
+	{
+		const FBlueForceInstances* Instances = GetBlueForceInstances();
+		FVector InstanceLocation;
+		if (Instances && Instances->GetLocation(TargetInstance, InstanceLocation) && IsLocationInView(InstanceLocation, Instances->GetContainer()))
+		{
+			CachedTargetLocation = InstanceLocation;
+			return;
+		}
+		TargetInstance = FBlueUnitHandle();
+	}
 
-	// 搜索视野内的新目标
+	// 搜索视野内的新目标（没有 Actor 目标时再搜索实例化蓝方）
 	AActor* NewTarget = FindTargetInView();
+	const FBlueUnitHandle NewInstance = NewTarget ? FBlueUnitHandle() : FindTargetInstanceInView();
 	if (NewTarget)
 	{
 		// 如果切换了目标，打印日志
@@ -993,6 +1165,10 @@ void AMockMissileActor::SearchAndLockTarget()
 				FVector::Dist(GetActorLocation(), NewTarget->GetActorLocation()));
 		}
 		
+		if (TargetActor.Get() != NewTarget)
+		{
+			TRACE_MISSILE_EVENT(this, TargetAcquired);
+		}
 		TargetActor = NewTarget;
 		CachedTargetLocation = NewTarget->GetActorLocation();
 		
@@ -1005,6 +1181,21 @@ void AMockMissileActor::SearchAndLockTarget()
 			BeginHoming();
 		}
 	}
+	else if (NewInstance.IsValid())
+	{
+		// 实例化蓝方：锁定视野内最近的实例
+		TRACE_MISSILE_EVENT(this, TargetAcquired);
+		SetTargetInstance(NewInstance);
+		UE_LOG(LogTemp, Verbose, TEXT("[Missile %s] 锁定新目标: 实例 %d (位置: %s)"),
+			*GetName(), NewInstance.Id, *CachedTargetLocation.ToString());
+
+		if (!bAscending)
+		{
+			LaunchLocation = GetActorLocation();
+			TrajectoryStartTime = ElapsedLifetime;
+			BeginHoming();
+		}
+	}
 	else if (!bAscending)
 	{
 		// 没有找到目标，但已经开始制导，继续按当前轨迹飞行
@@ -1050,16 +1241,123 @@ bool AMockMissileActor::IsInJammerRange() const
 	return false;
 }
 
+void AMockMissileActor::GetTelemetrySample(FMissileTelemetrySample& OutSample) const
+{
+	OutSample.Location = GetActorLocation();
+	OutSample.NearestJammerDistance = LastNearestJammerDistance;
+
+	if (bHasImpacted)
+	{
+		OutSample.State = EMissileTelemetryState::Terminated;
+	}
+	else if (bIsInterceptor)
+	{
+		OutSample.State = EMissileTelemetryState::Intercepting;
+	}
+	else if (bPerformingEvasiveManeuver)
+	{
+		OutSample.State = EMissileTelemetryState::Evading;
+	}
+	else if (bInJammerRange)
+	{
+		OutSample.State = EMissileTelemetryState::Jammed;
+	}
+	else if (bAscending)
+	{
+		OutSample.State = EMissileTelemetryState::Ascent;
+	}
+	else
+	{
+		OutSample.State = EMissileTelemetryState::Homing;
+	}
+
+	// 目标编号与回放/遥测的导弹标识、蓝方部署顺序一致，不使用会被复用的 UniqueID
+	OutSample.TargetKind = EMissileTelemetryTargetKind::None;
+	OutSample.TargetId = INDEX_NONE;
+	if (bIsInterceptor)
+	{
+		if (const AMockMissileActor* InterceptTarget = InterceptorTargetMissile.Get())
+		{
+			OutSample.TargetKind = EMissileTelemetryTargetKind::Missile;
+			OutSample.TargetId = static_cast<int32>(InterceptTarget->GetSessionSerial());
+		}
+	}
+	else if (const AActor* Target = TargetActor.Get())
+	{
+		if (UWorld* World = GetWorld())
+		{
+			if (UGameInstance* GameInstance = World->GetGameInstance())
+			{
+				if (const UScenarioMenuSubsystem* Subsystem = GameInstance->GetSubsystem<UScenarioMenuSubsystem>())
+				{
+					OutSample.TargetId = Subsystem->GetBlueUnitId(Target);
+					OutSample.TargetKind = OutSample.TargetId != INDEX_NONE ? EMissileTelemetryTargetKind::BlueUnit : EMissileTelemetryTargetKind::None;
+				}
+			}
+		}
+	}
+	else if (TargetInstance.IsValid())
+	{
+		OutSample.TargetKind = EMissileTelemetryTargetKind::BlueUnit;
+		OutSample.TargetId = TargetInstance.Id;
+	}
+}
+
+float AMockMissileActor::SampleJammingRatio() const
+{
+	if (!FJammingField::IsEnabled())
+	{
+		return -1.f;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UGameInstance* GameInstance = World->GetGameInstance())
+		{
+			if (UScenarioMenuSubsystem* Subsystem = GameInstance->GetSubsystem<UScenarioMenuSubsystem>())
+			{
+				const FJammingField& Field = Subsystem->GetJammingField();
+				if (!Field.IsEmpty())
+				{
+					return Field.Sample(GetActorLocation());
+				}
+			}
+		}
+	}
+	return -1.f;
+}
+
+float AMockMissileActor::GetEffectiveViewDistance() const
+{
+	if (CurrentJammingRatio <= 0.f)
+	{
+		return ViewDistance;
+	}
+	return ViewDistance * FMath::Pow(1.f + CurrentJammingRatio, -0.25f);
+}
+
 void AMockMissileActor::UpdateJammerDetection()
 {
 	bool bWasInRange = bInJammerRange;
-	bInJammerRange = IsInJammerRange();
+	// 干扰场启用时以干信比 >= 1（单个干扰器即 BaseRadius 以内）判定进入干扰区，可叠加多个干扰器并计入地形遮挡
+	CurrentJammingRatio = SampleJammingRatio();
+	bInJammerRange = CurrentJammingRatio >= 0.f ? CurrentJammingRatio >= 1.f : IsInJammerRange();
+
+	if (bInJammerRange && !bWasInRange)
+	{
+		TRACE_MISSILE_EVENT(this, EnterJammer);
+	}
+	else if (!bInJammerRange && bWasInRange)
+	{
+		TRACE_MISSILE_EVENT(this, ExitJammer);
+	}
 
 	ARadarJammerActor* NearestJammer = nullptr;
 	float NearestDistance = 0.f;
 	float NearestBaseRadius = 0.f;
 	float NearestHeightDiff = 0.f;
 	const bool bHasNearestJammer = GetNearestJammerInfo(NearestJammer, NearestDistance, NearestBaseRadius, NearestHeightDiff);
+	LastNearestJammerDistance = bHasNearestJammer ? NearestDistance : -1.f;
 
 	if (bHasNearestJammer && NearestJammer && !bJammerDetectionLogged)
 	{
@@ -1094,7 +1392,7 @@ void AMockMissileActor::UpdateJammerDetection()
 		if (bInJammerRange && !bWasInRange)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("[Missile %s] 进入雷达干扰区域，失去目标锁定（未启用反制功能）"), *GetName());
-			TargetActor = nullptr;
+			ClearTarget();
 		}
 		else if (!bInJammerRange && bWasInRange)
 		{
@@ -1103,6 +1401,14 @@ void AMockMissileActor::UpdateJammerDetection()
 		return;
 	}
 
+	// 提前反制（分支推演变体）：按当前速度预计在提前量内进入干扰区时即激活
+	if (CountermeasureLeadTime > 0.f && !bCountermeasureActive && !bInJammerRange && bHasNearestJammer
+		&& NearestDistance - NearestBaseRadius <= Velocity.Size() * CountermeasureLeadTime)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[Missile %s] 预计 %.2f 秒内进入干扰区域，提前开启反制系统"), *GetName(), CountermeasureLeadTime);
+		ActivateCountermeasure();
+	}
+
 	// 如果进入干扰区域
 	if (bInJammerRange && !bWasInRange)
 	{
@@ -1125,9 +1431,10 @@ void AMockMissileActor::UpdateJammerDetection()
 			if (LatestCountermeasureTime < 0.f)
 			{
 				LatestCountermeasureTime = ElapsedLifetime;
-				if (TargetActor.IsValid())
+				FVector CountermeasureTargetLocation;
+				if (GetCurrentTargetLocation(CountermeasureTargetLocation))
 				{
-					LatestCountermeasureDistance = FVector::Dist(GetActorLocation(), TargetActor->GetActorLocation());
+					LatestCountermeasureDistance = FVector::Dist(GetActorLocation(), CountermeasureTargetLocation);
 				}
 				else
 				{
@@ -1144,7 +1451,7 @@ void AMockMissileActor::UpdateJammerDetection()
 		}
 		
 		// 清除目标
-		TargetActor = nullptr;
+		ClearTarget();
 	}
 	// 如果离开干扰区域
 	else if (!bInJammerRange && bWasInRange)
@@ -1174,13 +1481,14 @@ void AMockMissileActor::UpdateJammerDetection()
 							const float LocalDistanceToJammer = FVector::Dist(MissileLocation, Jammer->GetActorLocation());
 							const float ActivationThreshold = Jammer->GetDetectionRadius();
 							
+							// 只提交影响，半径由干扰器在本帧末统一结算
 							if (LocalDistanceToJammer < ActivationThreshold)
 							{
-								Jammer->UpdateRadiusByMissileDistance(LocalDistanceToJammer);
+								Jammer->SubmitMissileInfluence(LocalDistanceToJammer);
 							}
 							else
 							{
-								Jammer->ClearCountermeasure();
+								Jammer->SubmitMissileRelease();
 							}
 						}
 					}
@@ -1215,6 +1523,7 @@ void AMockMissileActor::ActivateCountermeasure()
 			}
 		}
 		CountermeasureActivationTime = ElapsedLifetime;
+		TRACE_MISSILE_EVENT(this, CountermeasureActivated);
 		UE_LOG(LogTemp, Log, TEXT("[Missile %s] 激活反制系统，时间: %.2f秒"), *GetName(), CountermeasureActivationTime);
 		
 		// 更新所有干扰区域的反制状态
@@ -1235,8 +1544,8 @@ void AMockMissileActor::ActivateCountermeasure()
 							// 计算导弹到干扰器中心的距离
 							float DistanceToJammer = FVector::Dist(MissileLocation, Jammer->GetActorLocation());
 							
-							// 直接根据距离更新半径
-							Jammer->UpdateRadiusByMissileDistance(DistanceToJammer);
+							// 提交距离，由干扰器统一结算半径
+							Jammer->SubmitMissileInfluence(DistanceToJammer);
 						}
 					}
 				}
@@ -1253,7 +1562,12 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 	}
 
 	AActor* ReferenceActor = HitActor ? HitActor : TargetActor.Get();
-	if (!ReferenceActor)
+	FVector ImpactLocation;
+	if (ReferenceActor)
+	{
+		ImpactLocation = ReferenceActor->GetActorLocation();
+	}
+	else if (!GetCurrentTargetLocation(ImpactLocation))
 	{
 		return;
 	}
@@ -1281,12 +1595,20 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 	TArray<AActor*> BlueUnits;
 	Subsystem->GetActiveBlueUnits(BlueUnits);
 
-	const FVector ImpactLocation = ReferenceActor->GetActorLocation();
 	const float ClusterRadius = 8000.f;
 	const int32 MaxTotalMissiles = 4;
 	const int32 AdditionalSlots = MaxTotalMissiles - 1;
 
-	TArray<AActor*> CandidateTargets;
+	// 候选目标可以是蓝方 Actor，也可以是实例化蓝方单位
+	struct FSplitCandidate
+	{
+		AActor* Actor = nullptr;
+		FBlueUnitHandle Instance;
+		FVector Location = FVector::ZeroVector;
+		FString Name;
+	};
+
+	TArray<FSplitCandidate> CandidateTargets;
 	for (AActor* Candidate : BlueUnits)
 	{
 		if (!Candidate || Candidate == ReferenceActor)
@@ -1296,7 +1618,33 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 
 		if (FVector::Dist(ImpactLocation, Candidate->GetActorLocation()) <= ClusterRadius)
 		{
-			CandidateTargets.Add(Candidate);
+			FSplitCandidate& Entry = CandidateTargets.AddDefaulted_GetRef();
+			Entry.Actor = Candidate;
+			Entry.Location = Candidate->GetActorLocation();
+			Entry.Name = Candidate->GetName();
+		}
+	}
+
+	const FBlueForceInstances& Instances = Subsystem->GetBlueForceInstances();
+	if (Instances.GetAliveCount() > 0)
+	{
+		TArray<FBlueUnitHandle> AliveUnits;
+		Instances.GetAliveUnits(AliveUnits);
+		for (const FBlueUnitHandle& Handle : AliveUnits)
+		{
+			FVector Location;
+			if (Handle == TargetInstance || !Instances.GetLocation(Handle, Location))
+			{
+				continue;
+			}
+
+			if (FVector::Dist(ImpactLocation, Location) <= ClusterRadius)
+			{
+				FSplitCandidate& Entry = CandidateTargets.AddDefaulted_GetRef();
+				Entry.Instance = Handle;
+				Entry.Location = Location;
+				Entry.Name = Instances.Find(Handle)->Name;
+			}
 		}
 	}
 
@@ -1305,16 +1653,10 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 		return;
 	}
 
-	struct FTargetDistanceSorter
+	CandidateTargets.Sort([&ImpactLocation](const FSplitCandidate& A, const FSplitCandidate& B)
 	{
-		FVector RefLocation;
-		bool operator()(const AActor& A, const AActor& B) const
-		{
-			return FVector::DistSquared(RefLocation, A.GetActorLocation()) < FVector::DistSquared(RefLocation, B.GetActorLocation());
-		}
-	};
-
-	CandidateTargets.Sort(FTargetDistanceSorter{ ImpactLocation });
+		return FVector::DistSquared(ImpactLocation, A.Location) < FVector::DistSquared(ImpactLocation, B.Location);
+	});
 
 	const int32 SpawnCount = FMath::Min(AdditionalSlots, CandidateTargets.Num());
 	if (SpawnCount <= 0)
@@ -1323,6 +1665,7 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 	}
 
 	bHasSplit = true;
+	TRACE_MISSILE_EVENT(this, Split);
 
 	const FVector ParentForward = GetActorForwardVector().GetSafeNormal().IsNearlyZero() ? FVector::ForwardVector : GetActorForwardVector().GetSafeNormal();
 	FVector ParentRight = FVector::CrossProduct(ParentForward, FVector::UpVector).GetSafeNormal();
@@ -1344,11 +1687,7 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 
 	for (int32 i = 0; i < SpawnCount; ++i)
 	{
-		AActor* Candidate = CandidateTargets[i];
-		if (!Candidate)
-		{
-			continue;
-		}
+		const FSplitCandidate& Candidate = CandidateTargets[i];
 
 		const float SpreadIndex = (SpawnCount > 1) ? (i - (SpawnCount - 1) * 0.5f) : 0.f;
 		const FVector SpawnLocation = GetActorLocation()
@@ -1356,22 +1695,22 @@ void AMockMissileActor::TrySplitForClusterTargets(AActor* HitActor)
 			+ ParentRight * (SpreadIndex * LateralSpacing)
 			+ FVector::UpVector * VerticalOffset;
 
-		const FVector Direction = (Candidate->GetActorLocation() - SpawnLocation).GetSafeNormal();
+		const FVector Direction = (Candidate.Location - SpawnLocation).GetSafeNormal();
 		if (Direction.IsNearlyZero())
 		{
 			continue;
 		}
 
 		const FRotator SpawnRotation = Direction.Rotation();
-		if (AMockMissileActor* NewMissile = Subsystem->SpawnMissile(World, Candidate, false, &SpawnLocation, &SpawnRotation))
+		if (AMockMissileActor* NewMissile = Subsystem->SpawnMissile(World, Candidate.Actor, false, &SpawnLocation, &SpawnRotation, Candidate.Instance))
 		{
 			NewMissile->SetSplitGeneration(SplitGeneration + 1);
 			NewMissile->SetSplitGroupId(NewSplitGroupId);
-			NewMissile->SetFixedSplitTarget(Candidate->GetActorLocation());
+			NewMissile->SetFixedSplitTarget(Candidate.Location);
 			Subsystem->RegisterHLSplitChildSpawn();
 			Subsystem->UpdateMissileSplitMeta(NewMissile, true, NewSplitGroupId);
 			SpawnedChildren.Add(NewMissile);
-			UE_LOG(LogTemp, Log, TEXT("[Missile %s] HL 分配：生成分裂导弹 -> %s (直线飞行模式)"), *GetName(), *Candidate->GetName());
+			UE_LOG(LogTemp, Log, TEXT("[Missile %s] HL 分配：生成分裂导弹 -> %s (直线飞行模式)"), *GetName(), *Candidate.Name);
 		}
 	}
 
@@ -1419,7 +1758,7 @@ void AMockMissileActor::ClearJammerCountermeasure()
 				{
 					if (Jammer)
 					{
-						Jammer->ClearCountermeasure();
+						Jammer->SubmitMissileRelease();
 					}
 				}
 			}
@@ -1513,9 +1852,9 @@ void AMockMissileActor::UpdateBallisticStraightLine(float DeltaSeconds)
 	{
 		TargetLocation = FixedSplitTargetLocation;
 	}
-	else if (TargetActor.IsValid())
+	else
 	{
-		TargetLocation = TargetActor->GetActorLocation();
+		GetCurrentTargetLocation(TargetLocation);
 	}
 
 	FVector Direction = (TargetLocation - CurrentLocation).GetSafeNormal();
@@ -1535,15 +1874,8 @@ void AMockMissileActor::UpdateBallisticStraightLine(float DeltaSeconds)
 	}
 	SetActorRotation(Direction.Rotation());
 	
-	// 检查是否命中目标
-	if (TargetActor.IsValid())
-	{
-		const float DistanceSq = FVector::DistSquared(GetActorLocation(), TargetActor->GetActorLocation());
-		if (DistanceSq <= FMath::Square(500.f)) // 500厘米命中距离
-		{
-			HandleImpact(TargetActor.Get());
-		}
-	}
+	// 检查是否命中目标（500厘米命中距离）
+	TryImpactCurrentTarget();
 }
 
 void AMockMissileActor::SetFixedSplitTarget(const FVector& Location)
@@ -1765,7 +2097,8 @@ void AMockMissileActor::UpdateTrajectoryOptimization()
 		return;
 	}
 	
-	if (!TargetActor.IsValid())
+	FVector TargetLocation;
+	if (!GetCurrentTargetLocation(TargetLocation))
 	{
 		if (bHasAvoidanceWaypoint)
 		{
@@ -1776,7 +2109,6 @@ void AMockMissileActor::UpdateTrajectoryOptimization()
 	}
 	
 	const FVector CurrentLocation = GetActorLocation();
-	const FVector TargetLocation = TargetActor->GetActorLocation();
 	
 	// 减少日志输出频率，避免日志过多
 	static float LastLogTime = 0.f;
@@ -1801,8 +2133,8 @@ void AMockMissileActor::UpdateTrajectoryOptimization()
 		{
 			UE_LOG(LogTemp, Warning, TEXT("[Missile %s] 在干扰区域内，失去目标: %s"), 
 				*GetName(), *TargetActor->GetName());
-			TargetActor = nullptr;
 		}
+		ClearTarget();
 		
 		return;
 	}
@@ -1923,6 +2255,8 @@ void AMockMissileActor::ConfigureInterceptorRole(AMockMissileActor* TargetMissil
 	EvasiveTimeRemaining = 0.f;
 	CurrentEvasiveDirection = FVector::ZeroVector;
 
+	TRACE_MISSILE_SPAWN(this, true, SplitGeneration);
+
 	UE_LOG(LogTemp, Log, TEXT("[Missile %s] 配置为拦截导弹，目标=%s，速度=%.1f"), 
 		*GetName(),
 		TargetMissile ? *TargetMissile->GetName() : TEXT("未知"),
@@ -1983,6 +2317,7 @@ void AMockMissileActor::HandleInterceptedByEnemy(AMockMissileActor* Interceptor)
 	}
 
 	bHasImpacted = true;
+	TRACE_MISSILE_EVENT(this, Intercepted);
 
 	UE_LOG(LogTemp, Warning, TEXT("[Missile %s] 被拦截导弹 %s 击毁，任务失败"), 
 		*GetName(),
@@ -2129,6 +2464,7 @@ void AMockMissileActor::StartEvasiveManeuver(const FVector& ThreatDirection)
 	EvasionCooldown = 2.5f;
 	EvasiveDirectionFlipTimer = EvasiveDirectionFlipInterval;
 	EvasiveSpeedBoostTime = 1.2f;
+	TRACE_MISSILE_EVENT(this, EvadeStart);
 
 	UE_LOG(LogTemp, Log, TEXT("[Missile %s] 触发躲避动作，方向=%s"), 
 		*GetName(),
@@ -2147,6 +2483,7 @@ void AMockMissileActor::StopEvasiveManeuver()
 	CurrentEvasiveDirection = FVector::ZeroVector;
 	EvasiveDirectionFlipTimer = 0.f;
 	EvasiveSpeedBoostTime = 0.f;
+	TRACE_MISSILE_EVENT(this, EvadeStop);
 
 	UE_LOG(LogTemp, Log, TEXT("[Missile %s] 结束躲避动作"), *GetName());
 }
@@ -2201,3 +2538,165 @@ void AMockMissileActor::GetCountermeasureStats(FMissileCountermeasureStats& OutS
 	}
 }
 
+
+void AMockMissileActor::CaptureCheckpointState(FMissileCheckpointState& OutState) const
+{
+	OutState.Location = GetActorLocation();
+	OutState.Rotation = GetActorRotation();
+	OutState.TargetName.Reset();
+	if (!bIsInterceptor)
+	{
+		if (const AActor* Target = TargetActor.Get())
+		{
+			OutState.TargetName = Target->GetName();
+		}
+		else if (const FBlueForceInstances* Instances = GetBlueForceInstances())
+		{
+			if (const FBlueUnitInstance* Instance = Instances->IsAlive(TargetInstance) ? Instances->Find(TargetInstance) : nullptr)
+			{
+				OutState.TargetName = Instance->Name;
+			}
+		}
+	}
+
+	OutState.Speed = Speed;
+	OutState.AscentSpeed = AscentSpeed;
+	OutState.AscentHeight = AscentHeight;
+	OutState.MaxLifetime = MaxLifetime;
+	OutState.ElapsedLifetime = ElapsedLifetime;
+	OutState.bAscending = bAscending;
+	OutState.Gravity = Gravity;
+	OutState.InitialVelocity = InitialVelocity;
+	OutState.LaunchLocation = LaunchLocation;
+	OutState.TrajectoryStartTime = TrajectoryStartTime;
+	OutState.Velocity = Velocity;
+	OutState.StartLocation = StartLocation;
+	OutState.CachedTargetLocation = CachedTargetLocation;
+	OutState.LastTargetSearchTime = LastTargetSearchTime;
+
+	OutState.bCountermeasureEnabled = bCountermeasureEnabled;
+	OutState.bInJammerRange = bInJammerRange;
+	OutState.CurrentJammingRatio = CurrentJammingRatio;
+	OutState.LastNearestJammerDistance = LastNearestJammerDistance;
+	OutState.bCountermeasureActive = bCountermeasureActive;
+	OutState.CountermeasureActivationTime = CountermeasureActivationTime;
+	OutState.LatestCountermeasureTime = LatestCountermeasureTime;
+	OutState.LatestCountermeasureDistance = LatestCountermeasureDistance;
+	OutState.bShouldUseCountermeasure = bShouldUseCountermeasure;
+	OutState.bElectromagneticInterferenceActive = bElectromagneticInterferenceActive;
+	OutState.bJammerDetectionLogged = bJammerDetectionLogged;
+	OutState.JammerDetectionTime = JammerDetectionTime;
+	OutState.JammerDetectionDistance = JammerDetectionDistance;
+	OutState.JammerDetectionBaseRadius = JammerDetectionBaseRadius;
+	OutState.JammerDetectionHeightDifference = JammerDetectionHeightDifference;
+	OutState.CountermeasureActivationDistanceToJammer = CountermeasureActivationDistanceToJammer;
+	OutState.CountermeasureActivationBaseRadius = CountermeasureActivationBaseRadius;
+	OutState.CountermeasureActivationHeightDifference = CountermeasureActivationHeightDifference;
+
+	OutState.bHLAllocationEnabled = bHLAllocationEnabled;
+	OutState.bHasSplit = bHasSplit;
+	OutState.SplitGeneration = SplitGeneration;
+	OutState.bUseFixedSplitTarget = bUseFixedSplitTarget;
+	OutState.FixedSplitTargetLocation = FixedSplitTargetLocation;
+	OutState.SplitGroupId = SplitGroupId;
+	OutState.bIsSplitChild = bIsSplitChild;
+
+	OutState.bTrajectoryOptimizationEnabled = bTrajectoryOptimizationEnabled;
+	OutState.AvoidanceWaypoint = AvoidanceWaypoint;
+	OutState.bHasAvoidanceWaypoint = bHasAvoidanceWaypoint;
+	OutState.LastTrajectoryOptimizationUpdate = LastTrajectoryOptimizationUpdate;
+
+	OutState.bEvasiveSubsystemEnabled = bEvasiveSubsystemEnabled;
+	OutState.bPerformingEvasiveManeuver = bPerformingEvasiveManeuver;
+	OutState.EvasiveTimeRemaining = EvasiveTimeRemaining;
+	OutState.EvasionCooldown = EvasionCooldown;
+	OutState.CurrentEvasiveDirection = CurrentEvasiveDirection;
+	OutState.EvasiveDirectionFlipTimer = EvasiveDirectionFlipTimer;
+	OutState.EvasiveSpeedBoostTime = EvasiveSpeedBoostTime;
+	OutState.bIsInterceptor = bIsInterceptor;
+}
+
+void AMockMissileActor::RestoreCheckpointState(const FMissileCheckpointState& State, AActor* InTargetActor, const FBlueUnitHandle& InTargetInstance, AMockMissileActor* InInterceptorTarget)
+{
+	SetActorLocationAndRotation(State.Location, State.Rotation);
+
+	bIsInterceptor = State.bIsInterceptor;
+	InterceptorTargetMissile = bIsInterceptor ? InInterceptorTarget : nullptr;
+	TargetActor = bIsInterceptor ? InInterceptorTarget : InTargetActor;
+	TargetInstance = bIsInterceptor ? FBlueUnitHandle() : InTargetInstance;
+
+	Speed = State.Speed;
+	AscentSpeed = State.AscentSpeed;
+	AscentHeight = State.AscentHeight;
+	MaxLifetime = State.MaxLifetime;
+	ElapsedLifetime = State.ElapsedLifetime;
+	bAscending = State.bAscending;
+	Gravity = State.Gravity;
+	InitialVelocity = State.InitialVelocity;
+	LaunchLocation = State.LaunchLocation;
+	TrajectoryStartTime = State.TrajectoryStartTime;
+	Velocity = State.Velocity;
+	StartLocation = State.StartLocation;
+	CachedTargetLocation = State.CachedTargetLocation;
+	LastTargetSearchTime = State.LastTargetSearchTime;
+	bHasImpacted = false;
+	bExpiredNotified = false;
+
+	bCountermeasureEnabled = State.bCountermeasureEnabled;
+	bInJammerRange = State.bInJammerRange;
+	CurrentJammingRatio = State.CurrentJammingRatio;
+	LastNearestJammerDistance = State.LastNearestJammerDistance;
+	bCountermeasureActive = State.bCountermeasureActive;
+	CountermeasureActivationTime = State.CountermeasureActivationTime;
+	LatestCountermeasureTime = State.LatestCountermeasureTime;
+	LatestCountermeasureDistance = State.LatestCountermeasureDistance;
+	bShouldUseCountermeasure = State.bShouldUseCountermeasure;
+	bElectromagneticInterferenceActive = State.bElectromagneticInterferenceActive;
+	bJammerDetectionLogged = State.bJammerDetectionLogged;
+	JammerDetectionTime = State.JammerDetectionTime;
+	JammerDetectionDistance = State.JammerDetectionDistance;
+	JammerDetectionBaseRadius = State.JammerDetectionBaseRadius;
+	JammerDetectionHeightDifference = State.JammerDetectionHeightDifference;
+	CountermeasureActivationDistanceToJammer = State.CountermeasureActivationDistanceToJammer;
+	CountermeasureActivationBaseRadius = State.CountermeasureActivationBaseRadius;
+	CountermeasureActivationHeightDifference = State.CountermeasureActivationHeightDifference;
+	bCountermeasureStatsSubmitted = false;
+
+	bHLAllocationEnabled = State.bHLAllocationEnabled;
+	bHasSplit = State.bHasSplit;
+	SplitGeneration = State.SplitGeneration;
+	bUseFixedSplitTarget = State.bUseFixedSplitTarget;
+	FixedSplitTargetLocation = State.FixedSplitTargetLocation;
+	SplitGroupId = State.SplitGroupId;
+	bIsSplitChild = State.bIsSplitChild;
+
+	bTrajectoryOptimizationEnabled = State.bTrajectoryOptimizationEnabled;
+	AvoidanceWaypoint = State.AvoidanceWaypoint;
+	bHasAvoidanceWaypoint = State.bHasAvoidanceWaypoint;
+	LastTrajectoryOptimizationUpdate = State.LastTrajectoryOptimizationUpdate;
+
+	bEvasiveSubsystemEnabled = State.bEvasiveSubsystemEnabled;
+	bPerformingEvasiveManeuver = State.bPerformingEvasiveManeuver;
+	EvasiveTimeRemaining = State.EvasiveTimeRemaining;
+	EvasionCooldown = State.EvasionCooldown;
+	CurrentEvasiveDirection = State.CurrentEvasiveDirection;
+	EvasiveDirectionFlipTimer = State.EvasiveDirectionFlipTimer;
+	EvasiveSpeedBoostTime = State.EvasiveSpeedBoostTime;
+
+	// 拖尾从恢复位置重新开始，不连接检查点之前的轨迹
+	LastTrailLocation = State.Location;
+	bTrailActive = true;
+
+	TRACE_MISSILE_SPAWN(this, bIsInterceptor, SplitGeneration);
+}
+
+void AMockMissileActor::DisableCountermeasure()
+{
+	if (bCountermeasureActive)
+	{
+		ClearJammerCountermeasure();
+	}
+	bCountermeasureEnabled = false;
+	bCountermeasureActive = false;
+	CountermeasureLeadTime = 0.f;
+}
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Systems/BlueForceInstances.h"
 #include "MockMissileActor.generated.h"
 
 class UStaticMeshComponent;
@@ -32,6 +33,10 @@ public:
 	/** 初始化导弹逻辑参数与目标（目标可以为nullptr，导弹会在视野内自动搜索） */
 	void InitializeMissile(AActor* InTarget, float InLaunchSpeed, float InMaxLifetime);
 	
+	/** 以实例化蓝方单位为目标（在 InitializeMissile 之后调用） */
+	void SetTargetInstance(const FBlueUnitHandle& InTargetInstance);
+	const FBlueUnitHandle& GetTargetInstance() const { return TargetInstance; }
+
 	/** 设置导弹的算法配置，用于决定是否启用反制/分裂等功能 */
 	void SetAlgorithmConfig(const TArray<FString>& AlgorithmNames, const TArray<FString>& PrototypeNames);
 
@@ -48,6 +53,21 @@ public:
 	/** 获取反制统计数据（供ScenarioMenuSubsystem使用） */
 	void GetCountermeasureStats(struct FMissileCountermeasureStats& OutStats) const;
 
+	/** 填写一次遥测采样（供 FMissileTelemetryRecorder 使用） */
+	void GetTelemetrySample(struct FMissileTelemetrySample& OutSample) const;
+
+	/** 写出检查点所需的全部飞行/反制/分裂/躲避状态，目标以名称记录 */
+	void CaptureCheckpointState(struct FMissileCheckpointState& OutState) const;
+
+	/** 从检查点恢复状态；目标已由调用方按名称解析，拦截弹的目标为 InInterceptorTarget */
+	void RestoreCheckpointState(const struct FMissileCheckpointState& State, AActor* InTargetActor, const FBlueUnitHandle& InTargetInstance, AMockMissileActor* InInterceptorTarget);
+
+	/** 分支推演：按当前速度预计 Seconds 秒内进入干扰区时提前激活反制（0 为原逻辑） */
+	void SetCountermeasureLeadTime(float Seconds) { CountermeasureLeadTime = FMath::Max(0.f, Seconds); }
+
+	/** 分支推演对照组：关闭反制功能，已激活的反制同时释放 */
+	void DisableCountermeasure();
+
 	/** 设置外观（静态网格 + 基础材质 + 颜色） */
 	void SetupAppearance(UStaticMesh* InMesh, UMaterialInterface* InBaseMaterial, const FLinearColor& TintColor);
 
@@ -63,6 +83,13 @@ public:
 	/** 返回是否为拦截导弹 */
 	bool IsInterceptor() const { return bIsInterceptor; }
 
+	/**
+	 * 本次测试会话内的导弹序号（由场景子系统生成时分配，从 1 递增、不复用；回放、遥测与 MissileTrace 以此标识导弹）。
+	 * 须在 InitializeMissile / ConfigureInterceptorRole / RestoreCheckpointState 之前设置，这些函数会发出 Spawn 追踪事件。
+	 */
+	void SetSessionSerial(uint32 InSerial) { SessionSerial = InSerial; }
+	uint32 GetSessionSerial() const { return SessionSerial; }
+
 	/** 获取拦截导弹当前锁定的目标导弹（仅拦截导弹有效） */
 	AMockMissileActor* GetInterceptorTarget() const { return InterceptorTargetMissile.Get(); }
 
@@ -97,6 +124,7 @@ private:
 	UPointLightComponent* LightComponent;
 
 	TWeakObjectPtr<AActor> TargetActor;
+	FBlueUnitHandle TargetInstance; // 实例化蓝方模式下的目标，与 TargetActor 二选一
 
 	float Speed = 3000.f;
 	float AscentSpeed = 2000.f;
@@ -140,8 +168,17 @@ private:
 	
 	// 目标搜索相关
 	bool IsTargetInView(AActor* Candidate) const;
+	bool IsLocationInView(const FVector& Location, const AActor* IgnoredActor) const;
 	AActor* FindTargetInView() const;
+	FBlueUnitHandle FindTargetInstanceInView() const;
 	void SearchAndLockTarget();
+	const FBlueForceInstances* GetBlueForceInstances() const;
+	/** 当前目标（Actor 或实例）的位置，无目标时返回 false */
+	bool GetCurrentTargetLocation(FVector& OutLocation) const;
+	/** 失去目标：同时清除 Actor 与实例目标 */
+	void ClearTarget();
+	/** 到达当前目标 500 厘米内时触发命中，返回是否已命中 */
+	bool TryImpactCurrentTarget();
 	
 	// 视野参数
 	float ViewDistance = 50000.f; // 视野距离（厘米）
@@ -152,11 +189,14 @@ private:
 	// 雷达干扰相关
 	bool bCountermeasureEnabled = false; // 是否启用了反制功能（根据算法配置决定）
 	bool bInJammerRange = false; // 是否在干扰区域内
+	float CurrentJammingRatio = -1.f; // 当前位置的干信比（干扰场关闭时为 -1）
+	float LastNearestJammerDistance = -1.f; // 最近一次干扰检测时到最近干扰器的距离（无干扰器时为 -1）
 	bool bCountermeasureActive = false; // 是否启用反制
 	float CountermeasureActivationTime = -1.f; // 反制激活时间
 	float LatestCountermeasureTime = -1.f; // 最晚需要反制的时间
 	float LatestCountermeasureDistance = -1.f; // 最晚需要反制时与目标的距离
 	bool bShouldUseCountermeasure = false; // 是否需要使用反制
+	float CountermeasureLeadTime = 0.f; // 反制提前量（秒），仅分支推演变体使用
 	bool bElectromagneticInterferenceActive = false; // 是否处于电磁干扰测试环境
 	bool bJammerDetectionLogged = false;
 	float JammerDetectionTime = -1.f;
@@ -187,6 +227,10 @@ private:
 	
 	// 干扰检测和反制
 	bool IsInJammerRange() const;
+	/** 从干扰场插值当前位置的干信比；干扰场未启用或为空时返回 -1 */
+	float SampleJammingRatio() const;
+	/** 导引头作用距离：按干信比缩短（雷达方程 R ∝ (S/(S+J))^(1/4)） */
+	float GetEffectiveViewDistance() const;
 	void UpdateJammerDetection();
 	void ActivateCountermeasure();
 	void ClearJammerCountermeasure(); // 清除干扰区域的反制状态
@@ -219,6 +263,7 @@ private:
 
 	bool bIsInterceptor = false;
 	TWeakObjectPtr<AMockMissileActor> InterceptorTargetMissile;
+	uint32 SessionSerial = 0;
 };
 
 
@@ -5,10 +5,13 @@
 #include "UObject/ConstructorHelpers.h"
 #include "DrawDebugHelpers.h"
 #include "Math/UnrealMathUtility.h"
+#include "Systems/ScenarioAssetPreloader.h"
 
 ARadarJammerActor::ARadarJammerActor()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	// 在所有导弹（默认 TG_PrePhysics）提交本帧影响之后再结算
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 
 	// 创建根组件
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -40,6 +43,8 @@ void ARadarJammerActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	ResolveMissileInfluence();
+
 	// 如果启用了反制，半径会根据导弹距离在UpdateRadiusByMissileDistance中更新
 	// 这里只处理未启用反制的情况
 	if (!bCountermeasureActive)
@@ -49,6 +54,12 @@ void ARadarJammerActor::Tick(float DeltaTime)
 	
 	// 使用平滑插值更新可视化，避免闪烁
 	UpdateVisualizationSmooth(DeltaTime);
+
+	// 半径已稳定：关闭 Tick，直到下一次半径变化或导弹提交影响时唤醒
+	if (VisualizedRadius == JammerRadius)
+	{
+		SetActorTickEnabled(false);
+	}
 }
 
 void ARadarJammerActor::UpdateRadiusByMissileDistance(float MissileDistance)
@@ -89,6 +100,8 @@ void ARadarJammerActor::UpdateRadiusByMissileDistance(float MissileDistance)
 		// 确保半径不会太小
 		JammerRadius = FMath::Max(JammerRadius, BaseRadius * 0.05f);
 	}
+
+	WakeVisualization();
 }
 
 float ARadarJammerActor::GetActivationDistance() const
@@ -105,18 +118,8 @@ void ARadarJammerActor::SetJammerRadius(float InRadius)
 {
 	BaseRadius = FMath::Max(100.f, InRadius);
 	JammerRadius = BaseRadius;
-	VisualizedRadius = JammerRadius;
-	TargetVisualRadius = JammerRadius;
-	LastGeneratedRadius = 0.f; // 强制重新生成网格
+	// 直接跳到新半径（只改缩放，不重建网格）
 	UpdateVisualization();
-	
-	// 如果已经开始，立即更新可视化，确保半径变化可见
-	if (HasActorBegunPlay())
-	{
-		// 强制重新生成网格，确保半径变化立即生效
-		GenerateSphereMesh(VisualizedRadius);
-		LastGeneratedRadius = VisualizedRadius;
-	}
 }
 
 bool ARadarJammerActor::IsPointInJammerRange(const FVector& Point) const
@@ -144,7 +147,9 @@ void ARadarJammerActor::SetCountermeasureActive(bool bActive)
 	if (!bActive)
 	{
 		CountermeasureStrength = 0.f;
+		JammerRadius = BaseRadius;
 	}
+	WakeVisualization();
 }
 
 void ARadarJammerActor::ClearCountermeasure()
@@ -153,6 +158,45 @@ void ARadarJammerActor::ClearCountermeasure()
 	CountermeasureStrength = 0.f;
 	JammerRadius = BaseRadius; // 立即恢复原始半径
 	TargetVisualRadius = BaseRadius; // 更新目标可视化半径
+	WakeVisualization();
+}
+
+void ARadarJammerActor::SubmitMissileInfluence(float MissileDistance)
+{
+	PendingNearestMissileDistance = PendingNearestMissileDistance < 0.f
+		? MissileDistance
+		: FMath::Min(PendingNearestMissileDistance, MissileDistance);
+	SetActorTickEnabled(true);
+}
+
+void ARadarJammerActor::SubmitMissileRelease()
+{
+	bPendingMissileRelease = true;
+	SetActorTickEnabled(true);
+}
+
+void ARadarJammerActor::ResolveMissileInfluence()
+{
+	// 半径随距离单调变化，最近的导弹即压制最强的导弹；有任何导弹仍在影响时忽略释放请求
+	if (PendingNearestMissileDistance >= 0.f)
+	{
+		UpdateRadiusByMissileDistance(PendingNearestMissileDistance);
+	}
+	else if (bPendingMissileRelease)
+	{
+		ClearCountermeasure();
+	}
+
+	PendingNearestMissileDistance = -1.f;
+	bPendingMissileRelease = false;
+}
+
+void ARadarJammerActor::WakeVisualization()
+{
+	if (VisualizedRadius != JammerRadius && !IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+	}
 }
 
 void ARadarJammerActor::UpdateVisualization()
@@ -160,42 +204,22 @@ void ARadarJammerActor::UpdateVisualization()
 	// 初始化可视化半径
 	VisualizedRadius = JammerRadius;
 	TargetVisualRadius = JammerRadius;
-	LastGeneratedRadius = 0.f; // 重置，强制重新生成
-	
-	// 生成球体网格
-	GenerateSphereMesh(VisualizedRadius);
-	LastGeneratedRadius = VisualizedRadius;
+
+	// 半球网格只生成一次，之后的半径变化都通过组件缩放实现
+	if (!bHemisphereGenerated)
+	{
+		GenerateHemisphereMesh();
+	}
+	ApplyVisualRadius(VisualizedRadius);
 
 	// 创建或更新材质
 	if (!DynamicMaterial)
 	{
-		// 尝试加载支持透明的材质（按优先级顺序）
-		UMaterialInterface* BaseMaterial = nullptr;
-		
-		// 1. 优先尝试加载自定义透明材质
-		BaseMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Game/Materials/M_RadarJammerTranslucent"));
-		if (BaseMaterial)
+		// 按优先级取支持透明的材质：自定义透明材质 > 引擎内置材质 > 基础材质（可能不支持透明）
+		// 材质在 Step3 确认后已异步预加载，这里通常直接命中内存
+		UMaterialInterface* BaseMaterial = ScenarioAssets::ResolveJammerMaterial();
+		if (BaseMaterial && FSoftObjectPath(BaseMaterial) == ScenarioAssets::GetJammerMaterialPaths().Last())
 		{
-			UE_LOG(LogTemp, Log, TEXT("RadarJammerActor: Loaded custom translucent material"));
-		}
-		
-		// 2. 尝试使用StarterContent中的透明材质（但这些可能有反射）
-		// 跳过这些，因为它们可能有反射效果
-		
-		// 3. 尝试使用引擎内置的可能支持透明的材质
-		if (!BaseMaterial)
-		{
-			BaseMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/EditorMaterials/WidgetMaterial"));
-		}
-		if (!BaseMaterial)
-		{
-			BaseMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/EditorMaterials/UnlitColor"));
-		}
-		
-		// 4. 最后使用基础材质（可能不支持透明）
-		if (!BaseMaterial)
-		{
-			BaseMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
 			UE_LOG(LogTemp, Warning, TEXT("RadarJammerActor: Using BasicShapeMaterial (may not support transparency). Please create a translucent material at Content/Materials/M_RadarJammerTranslucent"));
 		}
 		
@@ -244,6 +268,7 @@ void ARadarJammerActor::UpdateVisualizationSmooth(float DeltaTime)
 	const float RadiusDelta = FMath::Abs(TargetVisualRadius - VisualizedRadius);
 	
 	// 如果差值很小，直接设置目标值，避免微小抖动
+	const float PreviousRadius = VisualizedRadius;
 	if (RadiusDelta < 1.f)
 	{
 		VisualizedRadius = TargetVisualRadius;
@@ -254,23 +279,27 @@ void ARadarJammerActor::UpdateVisualizationSmooth(float DeltaTime)
 		VisualizedRadius = FMath::FInterpTo(VisualizedRadius, TargetVisualRadius, DeltaTime, InterpSpeed);
 	}
 	
-	// 如果半径变化，重新生成球体网格
-	const float MeshRadiusDelta = FMath::Abs(VisualizedRadius - LastGeneratedRadius);
-	if (MeshRadiusDelta > 1.f) // 如果半径变化超过1cm，重新生成网格
+	// 半径变化只更新组件缩放（变换更新），不再重建和上传网格
+	if (VisualizedRadius != PreviousRadius)
 	{
-		GenerateSphereMesh(VisualizedRadius);
-		LastGeneratedRadius = VisualizedRadius;
+		ApplyVisualRadius(VisualizedRadius);
 	}
 }
 
-void ARadarJammerActor::GenerateSphereMesh(float Radius)
+void ARadarJammerActor::ApplyVisualRadius(float Radius)
+{
+	MeshComponent->SetRelativeScale3D(FVector(FMath::Max(Radius, 1.f) / UnitHemisphereRadius));
+}
+
+void ARadarJammerActor::GenerateHemisphereMesh()
 {
 	// 清除现有网格
 	MeshComponent->ClearAllMeshSections();
 	
-	// 球体生成参数
-	const int32 Segments = 32; // 球体的分段数（越高越平滑，但性能开销越大）
-	const int32 Rings = 16;    // 球体的环数
+	// 半球生成参数（干扰区域只在地面以上，下半球不生成）
+	const int32 Segments = 32; // 经向分段数（越高越平滑，但性能开销越大）
+	const int32 Rings = 8;     // 从顶点到赤道的环数
+	const float Radius = UnitHemisphereRadius;
 	
 	TArray<FVector> Vertices;
 	TArray<int32> Triangles;
@@ -278,10 +307,10 @@ void ARadarJammerActor::GenerateSphereMesh(float Radius)
 	TArray<FVector2D> UVs;
 	TArray<FProcMeshTangent> Tangents;
 	
-	// 生成球体顶点
+	// 生成半球顶点
 	for (int32 Ring = 0; Ring <= Rings; ++Ring)
 	{
-		float Theta = Ring * UE_PI / Rings; // 从0到PI
+		float Theta = Ring * UE_HALF_PI / Rings; // 从0到PI/2
 		float SinTheta = FMath::Sin(Theta);
 		float CosTheta = FMath::Cos(Theta);
 		
@@ -328,8 +357,9 @@ void ARadarJammerActor::GenerateSphereMesh(float Radius)
 		}
 	}
 	
-	// 创建网格section
-	MeshComponent->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, TArray<FColor>(), Tangents, true);
+	// 创建网格section（组件本身无碰撞，不烘焙碰撞数据）
+	MeshComponent->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, TArray<FColor>(), Tangents, false);
+	bHemisphereGenerated = true;
 }
 
 void ARadarJammerActor::CreateDefaultTranslucentMaterial()
@@ -337,7 +367,7 @@ void ARadarJammerActor::CreateDefaultTranslucentMaterial()
 	// 尝试创建一个简单的透明材质
 	// 注意：在C++中直接创建支持透明的材质比较复杂
 	// 这里我们尝试使用一个可能支持透明的默认材质
-	UMaterialInterface* BaseMaterial = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
+	UMaterialInterface* BaseMaterial = ScenarioAssets::ResolveOrLoad<UMaterialInterface>(ScenarioAssets::GetJammerMaterialPaths().Last());
 	
 	if (BaseMaterial)
 	{
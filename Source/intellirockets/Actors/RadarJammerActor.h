@@ -54,6 +54,16 @@ public:
 	/** 根据导弹距离更新干扰半径（直接基于距离计算，不使用插值） */
 	void UpdateRadiusByMissileDistance(float MissileDistance);
 
+	/**
+	 * 导弹提交本帧对该干扰器的反制影响（导弹到干扰器中心的距离）。
+	 * 同一帧内的所有提交在干扰器 Tick 中统一结算一次：取最近导弹的距离计算半径，
+	 * 结果与导弹的 Tick 顺序无关。
+	 */
+	void SubmitMissileInfluence(float MissileDistance);
+
+	/** 导弹提交本帧"不再影响该干扰器"；若同一帧没有任何导弹提交影响，结算时恢复原始半径 */
+	void SubmitMissileRelease();
+
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Components, meta = (AllowPrivateAccess = "true"))
 	UProceduralMeshComponent* MeshComponent;
@@ -72,11 +82,23 @@ private:
 	
 	float VisualizedRadius = 5000.f; // 当前可视化的半径（用于平滑插值）
 	float TargetVisualRadius = 5000.f; // 目标可视化半径
-	float LastGeneratedRadius = 0.f; // 上一次生成网格时的半径
+	// 本帧待结算的导弹影响（-1 表示没有导弹提交距离）
+	float PendingNearestMissileDistance = -1.f;
+	bool bPendingMissileRelease = false;
+
+	bool bHemisphereGenerated = false; // 单位半球网格只生成一次，半径通过组件缩放体现
+
+	// 单位半球网格的半径（厘米）；可视半径 = UnitHemisphereRadius * 组件缩放
+	static constexpr float UnitHemisphereRadius = 100.f;
 
 	void UpdateVisualization();
 	void UpdateVisualizationSmooth(float DeltaTime);
-	void GenerateSphereMesh(float Radius);
+	void GenerateHemisphereMesh();
+	void ApplyVisualRadius(float Radius);
+	/** 目标半径与可视半径不一致时恢复 Tick；半径稳定后 Tick 会自行关闭 */
+	void WakeVisualization();
+	/** 将本帧提交的导弹影响结算为干扰半径，并清空缓冲 */
+	void ResolveMissileInfluence();
 	void CreateDefaultTranslucentMaterial();
 };
 
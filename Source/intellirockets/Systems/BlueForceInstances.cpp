@@ -0,0 +1,447 @@
+#include "Systems/BlueForceInstances.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
+
+const FName FBlueForceInstances::ContainerTag(TEXT("BlueUnitInstances"));
+
+namespace
+{
+	constexpr float GridCellSize = 5000.f; // 与导弹 AoE 半径同一量级（厘米）
+}
+
+AActor* FBlueForceInstances::EnsureContainer(UWorld* World)
+{
+	if (AActor* Existing = Container.Get())
+	{
+		if (!Existing->IsPendingKillPending() && Existing->GetWorld() == World)
+		{
+			return Existing;
+		}
+	}
+
+	// 世界已切换（重新加载关卡）时旧容器随旧世界销毁，元数据一并作废
+	Units.Reset();
+	UnitTypes.Reset();
+	AliveCount = 0;
+	ResetGrid();
+
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* NewContainer = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!NewContainer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FBlueForceInstances: failed to spawn container actor"));
+		return nullptr;
+	}
+
+	USceneComponent* Root = NewObject<USceneComponent>(NewContainer, TEXT("Root"));
+	NewContainer->SetRootComponent(Root);
+	Root->RegisterComponent();
+	NewContainer->AddInstanceComponent(Root);
+	NewContainer->Tags.AddUnique(FName(TEXT("BlueUnit")));
+	NewContainer->Tags.AddUnique(ContainerTag);
+
+	Container = NewContainer;
+	return NewContainer;
+}
+
+int32 FBlueForceInstances::FindOrAddType(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	for (int32 TypeIndex = 0; TypeIndex < UnitTypes.Num(); ++TypeIndex)
+	{
+		if (UnitTypes[TypeIndex].Mesh.Get() == Mesh && UnitTypes[TypeIndex].Component.IsValid())
+		{
+			return TypeIndex;
+		}
+	}
+
+	AActor* Owner = Container.Get();
+	if (!Owner || !Mesh)
+	{
+		return INDEX_NONE;
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(Owner);
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		Component->SetMaterial(0, Material);
+	}
+	Component->SetCollisionProfileName(TEXT("BlockAll"));
+	Component->SetupAttachment(Owner->GetRootComponent());
+	Component->RegisterComponent();
+	Owner->AddInstanceComponent(Component);
+
+	FUnitType& NewType = UnitTypes.AddDefaulted_GetRef();
+	NewType.Mesh = Mesh;
+	NewType.Component = Component;
+	return UnitTypes.Num() - 1;
+}
+
+FBlueUnitHandle FBlueForceInstances::AddUnit(UWorld* World, UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform, const FString& MarkerName, const TArray<FName>& Tags)
+{
+	if (!Mesh || !EnsureContainer(World))
+	{
+		return FBlueUnitHandle();
+	}
+
+	const int32 TypeIndex = FindOrAddType(Mesh, Material);
+	if (!UnitTypes.IsValidIndex(TypeIndex))
+	{
+		return FBlueUnitHandle();
+	}
+
+	FUnitType& Type = UnitTypes[TypeIndex];
+	const int32 InstanceIndex = Type.Component->AddInstance(Transform, /*bWorldSpace*/ true);
+	if (InstanceIndex == INDEX_NONE)
+	{
+		return FBlueUnitHandle();
+	}
+
+	FBlueUnitInstance& Unit = Units.AddDefaulted_GetRef();
+	Unit.Handle.Id = Units.Num() - 1;
+	Unit.TypeIndex = TypeIndex;
+	Unit.InstanceIndex = InstanceIndex;
+	Unit.Transform = Transform;
+	Unit.MarkerName = MarkerName;
+	Unit.Name = FString::Printf(TEXT("BlueUnit_%d"), Unit.Handle.Id);
+	Unit.Tags = Tags;
+	Unit.bAlive = true;
+
+	if (Type.InstanceToUnit.Num() <= InstanceIndex)
+	{
+		Type.InstanceToUnit.SetNum(InstanceIndex + 1);
+	}
+	Type.InstanceToUnit[InstanceIndex] = Unit.Handle.Id;
+
+	const FIntPoint Cell = GetCell(Transform.GetLocation());
+	if (GridCells.Num() == 0)
+	{
+		GridMin = Cell;
+		GridMax = Cell;
+	}
+	else
+	{
+		GridMin = GridMin.ComponentMin(Cell);
+		GridMax = GridMax.ComponentMax(Cell);
+	}
+	GridCells.FindOrAdd(Cell).Add(Unit.Handle.Id);
+
+	++AliveCount;
+	return Unit.Handle;
+}
+
+bool FBlueForceInstances::RemoveUnit(const FBlueUnitHandle& Handle)
+{
+	if (!Units.IsValidIndex(Handle.Id) || !Units[Handle.Id].bAlive)
+	{
+		return false;
+	}
+
+	FBlueUnitInstance& Unit = Units[Handle.Id];
+	Unit.bAlive = false;
+	--AliveCount;
+
+	const FIntPoint Cell = GetCell(Unit.GetLocation());
+	if (TArray<int32>* CellUnits = GridCells.Find(Cell))
+	{
+		CellUnits->RemoveSingleSwap(Handle.Id);
+		if (CellUnits->Num() == 0)
+		{
+			GridCells.Remove(Cell);
+		}
+	}
+
+	if (!UnitTypes.IsValidIndex(Unit.TypeIndex))
+	{
+		return true;
+	}
+
+	FUnitType& Type = UnitTypes[Unit.TypeIndex];
+	UHierarchicalInstancedStaticMeshComponent* Component = Type.Component.Get();
+	const int32 RemovedIndex = Unit.InstanceIndex;
+	Unit.InstanceIndex = INDEX_NONE;
+	if (!Component || !Type.InstanceToUnit.IsValidIndex(RemovedIndex))
+	{
+		return true;
+	}
+
+	// HISM 删除实例时总是把最后一个实例换到被删位置
+	Component->RemoveInstance(RemovedIndex);
+	const int32 LastIndex = Type.InstanceToUnit.Num() - 1;
+	if (RemovedIndex != LastIndex)
+	{
+		const int32 MovedUnit = Type.InstanceToUnit[LastIndex];
+		Type.InstanceToUnit[RemovedIndex] = MovedUnit;
+		Units[MovedUnit].InstanceIndex = RemovedIndex;
+	}
+	Type.InstanceToUnit.RemoveAt(LastIndex);
+	return true;
+}
+
+int32 FBlueForceInstances::RemoveUnitsInRadius(const FVector& Center, float Radius, TArray<FBlueUnitHandle>& OutRemoved)
+{
+	OutRemoved.Reset();
+	const float RadiusSq = FMath::Square(Radius);
+
+	TArray<TPair<float, FBlueUnitHandle>> InRange;
+	ForEachUnitNear(Center, Radius, [&](int32 UnitIndex)
+	{
+		const FBlueUnitInstance& Unit = Units[UnitIndex];
+		const float DistanceSq = FVector::DistSquared(Center, Unit.GetLocation());
+		if (DistanceSq <= RadiusSq)
+		{
+			InRange.Emplace(DistanceSq, Unit.Handle);
+		}
+	});
+
+	InRange.Sort([](const TPair<float, FBlueUnitHandle>& A, const TPair<float, FBlueUnitHandle>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<float, FBlueUnitHandle>& Entry : InRange)
+	{
+		if (RemoveUnit(Entry.Value))
+		{
+			OutRemoved.Add(Entry.Value);
+		}
+	}
+	return OutRemoved.Num();
+}
+
+void FBlueForceInstances::Reset()
+{
+	if (AActor* Existing = Container.Get())
+	{
+		if (!Existing->IsPendingKillPending())
+		{
+			Existing->Destroy();
+		}
+	}
+	Container.Reset();
+	UnitTypes.Reset();
+	Units.Reset();
+	AliveCount = 0;
+	ResetGrid();
+}
+
+void FBlueForceInstances::ResetGrid()
+{
+	GridCells.Reset();
+	GridMin = FIntPoint::ZeroValue;
+	GridMax = FIntPoint::ZeroValue;
+}
+
+FIntPoint FBlueForceInstances::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / GridCellSize), FMath::FloorToInt(Location.Y / GridCellSize));
+}
+
+void FBlueForceInstances::ForEachUnitNear(const FVector& Center, float Radius, TFunctionRef<void(int32 UnitIndex)> Visitor) const
+{
+	if (GridCells.Num() == 0)
+	{
+		return;
+	}
+
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.f)).ComponentMax(GridMin);
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.f)).ComponentMin(GridMax);
+	if (MinCell.X > MaxCell.X || MinCell.Y > MaxCell.Y)
+	{
+		return;
+	}
+
+	// 查询范围覆盖的网格多于已占用的网格时（例如导弹视野）直接遍历已占用网格
+	const int64 RangeCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+	if (RangeCells > GridCells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Pair : GridCells)
+		{
+			if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+			{
+				for (const int32 UnitIndex : Pair.Value)
+				{
+					Visitor(UnitIndex);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const TArray<int32>* CellUnits = GridCells.Find(FIntPoint(X, Y)))
+			{
+				for (const int32 UnitIndex : *CellUnits)
+				{
+					Visitor(UnitIndex);
+				}
+			}
+		}
+	}
+}
+
+void FBlueForceInstances::GetAliveUnitsInRadius(const FVector& Center, float Radius, TArray<FBlueUnitHandle>& OutHandles) const
+{
+	OutHandles.Reset();
+	const float RadiusSq = FMath::Square(Radius);
+	ForEachUnitNear(Center, Radius, [&](int32 UnitIndex)
+	{
+		if (FVector::DistSquared(Center, Units[UnitIndex].GetLocation()) <= RadiusSq)
+		{
+			OutHandles.Add(Units[UnitIndex].Handle);
+		}
+	});
+}
+
+bool FBlueForceInstances::IsAlive(const FBlueUnitHandle& Handle) const
+{
+	return Units.IsValidIndex(Handle.Id) && Units[Handle.Id].bAlive && Container.IsValid();
+}
+
+bool FBlueForceInstances::GetLocation(const FBlueUnitHandle& Handle, FVector& OutLocation) const
+{
+	if (!IsAlive(Handle))
+	{
+		return false;
+	}
+	OutLocation = Units[Handle.Id].GetLocation();
+	return true;
+}
+
+const FBlueUnitInstance* FBlueForceInstances::Find(const FBlueUnitHandle& Handle) const
+{
+	return Units.IsValidIndex(Handle.Id) ? &Units[Handle.Id] : nullptr;
+}
+
+bool FBlueForceInstances::GetAppearance(const FBlueUnitHandle& Handle, UStaticMesh*& OutMesh, UMaterialInterface*& OutMaterial) const
+{
+	OutMesh = nullptr;
+	OutMaterial = nullptr;
+	const FBlueUnitInstance* Unit = Find(Handle);
+	if (!Unit || !UnitTypes.IsValidIndex(Unit->TypeIndex))
+	{
+		return false;
+	}
+
+	const FUnitType& Type = UnitTypes[Unit->TypeIndex];
+	OutMesh = Type.Mesh.Get();
+	if (const UHierarchicalInstancedStaticMeshComponent* Component = Type.Component.Get())
+	{
+		OutMaterial = Component->GetMaterial(0);
+	}
+	return OutMesh != nullptr;
+}
+
+void FBlueForceInstances::GetAliveUnits(TArray<FBlueUnitHandle>& OutHandles) const
+{
+	OutHandles.Reset(AliveCount);
+	for (const FBlueUnitInstance& Unit : Units)
+	{
+		if (Unit.bAlive)
+		{
+			OutHandles.Add(Unit.Handle);
+		}
+	}
+}
+
+FBlueUnitHandle FBlueForceInstances::SelectNext(int32& InOutCursor) const
+{
+	const int32 UnitCount = Units.Num();
+	if (AliveCount == 0 || UnitCount == 0)
+	{
+		return FBlueUnitHandle();
+	}
+
+	InOutCursor = FMath::Max(0, InOutCursor) % UnitCount;
+	for (int32 Attempt = 0; Attempt < UnitCount; ++Attempt)
+	{
+		const int32 Index = (InOutCursor + Attempt) % UnitCount;
+		if (Units[Index].bAlive)
+		{
+			InOutCursor = (Index + 1) % UnitCount;
+			return Units[Index].Handle;
+		}
+	}
+	return FBlueUnitHandle();
+}
+
+FBlueUnitHandle FBlueForceInstances::FindNearest(const FVector& Location, float MaxDistance, const FBlueUnitHandle& Exclude) const
+{
+	FBlueUnitHandle Best;
+	if (GridCells.Num() == 0)
+	{
+		return Best;
+	}
+
+	// 从所在网格向外逐圈搜索：第 Ring 圈中的点水平距离至少为 (Ring - 1) * GridCellSize，
+	// 已找到的最近单位比这更近时停止
+	float BestDistanceSq = MaxDistance > 0.f ? FMath::Square(MaxDistance) : MAX_FLT;
+	const FIntPoint Origin = GetCell(Location);
+	int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(Origin.X - GridMin.X), FMath::Abs(GridMax.X - Origin.X)),
+		FMath::Max(FMath::Abs(Origin.Y - GridMin.Y), FMath::Abs(GridMax.Y - Origin.Y)));
+	if (MaxDistance > 0.f)
+	{
+		MaxRing = FMath::Min(MaxRing, FMath::CeilToInt(MaxDistance / GridCellSize) + 1);
+	}
+
+	auto VisitCell = [&](int32 X, int32 Y)
+	{
+		const TArray<int32>* CellUnits = GridCells.Find(FIntPoint(X, Y));
+		if (!CellUnits)
+		{
+			return;
+		}
+		for (const int32 UnitIndex : *CellUnits)
+		{
+			const FBlueUnitInstance& Unit = Units[UnitIndex];
+			if (Unit.Handle == Exclude)
+			{
+				continue;
+			}
+			const float DistanceSq = FVector::DistSquared(Location, Unit.GetLocation());
+			if (DistanceSq <= BestDistanceSq)
+			{
+				BestDistanceSq = DistanceSq;
+				Best = Unit.Handle;
+			}
+		}
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Best.IsValid() && FMath::Square(FMath::Max(0, Ring - 1) * GridCellSize) > BestDistanceSq)
+		{
+			break;
+		}
+		for (int32 DY = -Ring; DY <= Ring; ++DY)
+		{
+			const bool bEdgeRow = FMath::Abs(DY) == Ring;
+			for (int32 DX = -Ring; DX <= Ring; DX += bEdgeRow ? 1 : FMath::Max(1, 2 * Ring))
+			{
+				VisitCell(Origin.X + DX, Origin.Y + DY);
+			}
+		}
+	}
+	return Best;
+}
+
+bool FBlueForceInstances::IsContainer(const AActor* Actor) const
+{
+	return Actor && Actor == Container.Get();
+}
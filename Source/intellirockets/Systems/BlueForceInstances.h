@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+class UStaticMesh;
+class UMaterialInterface;
+class UHierarchicalInstancedStaticMeshComponent;
+
+/** 实例化蓝方单位句柄：在一次部署内唯一，单位被摧毁后句柄仍可查询（bAlive = false） */
+struct FBlueUnitHandle
+{
+	int32 Id = INDEX_NONE;
+
+	bool IsValid() const { return Id != INDEX_NONE; }
+	bool operator==(const FBlueUnitHandle& Other) const { return Id == Other.Id; }
+	bool operator!=(const FBlueUnitHandle& Other) const { return Id != Other.Id; }
+
+	friend uint32 GetTypeHash(const FBlueUnitHandle& Handle) { return ::GetTypeHash(Handle.Id); }
+};
+
+/** 单个实例的元数据（标签、存活标记、所属部署点） */
+struct FBlueUnitInstance
+{
+	FBlueUnitHandle Handle;
+	int32 TypeIndex = INDEX_NONE;   // 对应 UnitTypes 中的组件
+	int32 InstanceIndex = INDEX_NONE; // 当前在 HISM 中的实例下标，移除后为 INDEX_NONE
+	FTransform Transform;
+	FString MarkerName;
+	FString Name;                   // 用于记录/日志，与 Actor 模式下的 GetName() 对应
+	TArray<FName> Tags;
+	bool bAlive = false;
+
+	FVector GetLocation() const { return Transform.GetLocation(); }
+	bool HasTag(FName Tag) const { return Tags.Contains(Tag); }
+};
+
+/**
+ * 实例化蓝方兵力：每种单位（网格体）一个 HierarchicalInstancedStaticMeshComponent，
+ * 挂在同一个容器 Actor 上，整支兵力只占少量绘制调用，不再为每个单位生成 AStaticMeshActor。
+ * 目标选择、AoE 毁伤与监控都通过 FBlueUnitHandle 进行；摧毁时逐实例移除。
+ * 存活单位同时登记在水平方向的均匀网格中（单位部署后不再移动），按半径/最近邻查询只访问附近的网格。
+ */
+class FBlueForceInstances
+{
+public:
+	/** 容器 Actor 的标签，导弹命中容器时据此识别为蓝方单位 */
+	static const FName ContainerTag;
+
+	/** 添加一个单位，首次遇到该网格体时创建对应组件 */
+	FBlueUnitHandle AddUnit(UWorld* World, UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform, const FString& MarkerName, const TArray<FName>& Tags);
+
+	/** 逐实例移除（摧毁），返回是否确实移除了一个存活单位 */
+	bool RemoveUnit(const FBlueUnitHandle& Handle);
+
+	/** 移除半径内的全部存活单位，OutRemoved 按距离从近到远排列 */
+	int32 RemoveUnitsInRadius(const FVector& Center, float Radius, TArray<FBlueUnitHandle>& OutRemoved);
+
+	/** 销毁容器与全部实例 */
+	void Reset();
+
+	bool IsAlive(const FBlueUnitHandle& Handle) const;
+	bool GetLocation(const FBlueUnitHandle& Handle, FVector& OutLocation) const;
+	const FBlueUnitInstance* Find(const FBlueUnitHandle& Handle) const;
+
+	/** 单位所属组件的网格体与材质（用于会话回放记录外观） */
+	bool GetAppearance(const FBlueUnitHandle& Handle, UStaticMesh*& OutMesh, UMaterialInterface*& OutMaterial) const;
+
+	int32 GetAliveCount() const { return AliveCount; }
+	int32 GetTotalCount() const { return Units.Num(); }
+	void GetAliveUnits(TArray<FBlueUnitHandle>& OutHandles) const;
+
+	/** 从 Cursor 开始轮询下一个存活单位（与 Actor 模式的 NextTargetCursor 语义一致） */
+	FBlueUnitHandle SelectNext(int32& InOutCursor) const;
+
+	/** 半径内离 Location 最近的存活单位，MaxDistance <= 0 表示不限距离 */
+	FBlueUnitHandle FindNearest(const FVector& Location, float MaxDistance, const FBlueUnitHandle& Exclude = FBlueUnitHandle()) const;
+
+	/** 与 Center 距离不超过 Radius 的全部存活单位（不保证顺序） */
+	void GetAliveUnitsInRadius(const FVector& Center, float Radius, TArray<FBlueUnitHandle>& OutHandles) const;
+
+	bool IsContainer(const AActor* Actor) const;
+	AActor* GetContainer() const { return Container.Get(); }
+
+private:
+	struct FUnitType
+	{
+		TWeakObjectPtr<UStaticMesh> Mesh;
+		TWeakObjectPtr<UHierarchicalInstancedStaticMeshComponent> Component;
+		TArray<int32> InstanceToUnit; // HISM 实例下标 -> Units 下标
+	};
+
+	AActor* EnsureContainer(UWorld* World);
+	int32 FindOrAddType(UStaticMesh* Mesh, UMaterialInterface* Material);
+	void ResetGrid();
+	static FIntPoint GetCell(const FVector& Location);
+	/** 遍历水平距离可能不超过 Radius 的网格中的存活单位下标 */
+	void ForEachUnitNear(const FVector& Center, float Radius, TFunctionRef<void(int32 UnitIndex)> Visitor) const;
+
+	TWeakObjectPtr<AActor> Container;
+	TArray<FUnitType> UnitTypes;
+	TArray<FBlueUnitInstance> Units; // 下标即 Handle.Id
+	int32 AliveCount = 0;
+
+	TMap<FIntPoint, TArray<int32>> GridCells; // 网格 -> 存活单位下标
+	FIntPoint GridMin = FIntPoint::ZeroValue;  // 曾登记过单位的网格范围（移除单位时不收缩）
+	FIntPoint GridMax = FIntPoint::ZeroValue;
+};
@@ -0,0 +1,198 @@
+#include "Systems/BlueUnitPlacement.h"
+
+#include "Systems/ScenarioPerformanceRecorder.h"
+#include "Async/ParallelFor.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "NavigationSystem.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarGroundCellSize(
+		TEXT("ir.BlueForce.GroundCellSize"),
+		200.f,
+		TEXT("蓝方落地高度缓存的网格边长（厘米）；<= 0 时每个槽位单独做精确射线（仍批量并行）"));
+
+	TAutoConsoleVariable<float> CVarGroundMaxCornerDelta(
+		TEXT("ir.BlueForce.GroundMaxCornerDelta"),
+		250.f,
+		TEXT("网格四角高差超过该值（厘米）时不插值，改用精确射线"));
+
+	TAutoConsoleVariable<int32> CVarParallelPlacement(
+		TEXT("ir.BlueForce.ParallelPlacement"),
+		1,
+		TEXT("1: 落地射线在任务线程上并行执行；0: 在游戏线程上顺序执行"));
+
+	const float NoGroundHeight = TNumericLimits<float>::Lowest();
+	constexpr float TraceUp = 6000.f;
+	constexpr float TraceDown = 12000.f;
+
+	bool TraceGround(const UWorld* World, const FVector& Location, const FCollisionQueryParams& Params, float& OutHeight)
+	{
+		FHitResult Hit;
+		const FVector TraceStart = Location + FVector(0.f, 0.f, TraceUp);
+		const FVector TraceEnd = Location - FVector(0.f, 0.f, TraceDown);
+		if (World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, Params) && Hit.bBlockingHit)
+		{
+			OutHeight = Hit.ImpactPoint.Z;
+			return true;
+		}
+		return false;
+	}
+
+	EParallelForFlags GetParallelFlags()
+	{
+		return CVarParallelPlacement.GetValueOnGameThread() > 0 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	}
+}
+
+int32 FBlueUnitPlacementService::ProjectToGround(UWorld* World, TArray<FVector>& InOutLocations, float HeightOffset, const TArray<AActor*>& IgnoredActors)
+{
+	if (!World || InOutLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const float CellSize = CVarGroundCellSize.GetValueOnGameThread();
+	if (CachedWorld.Get() != World || !FMath::IsNearlyEqual(CachedCellSize, CellSize))
+	{
+		Invalidate();
+		CachedWorld = World;
+		CachedCellSize = CellSize;
+	}
+
+	FCollisionQueryParams Params(NAME_None, /*bTraceComplex*/ true);
+	Params.AddIgnoredActors(IgnoredActors);
+
+	const int32 SlotCount = InOutLocations.Num();
+	TArray<float> GroundZ;
+	GroundZ.Init(NoGroundHeight, SlotCount);
+	TArray<int32> ExactSlots;
+	int32 CornerTraceCount = 0;
+
+	if (CellSize > 0.f)
+	{
+		// 1. 收集缓存中缺失的网格角点（去重）
+		TArray<FIntPoint> MissingCorners;
+		TArray<float> MissingCornerReferenceZ;
+		TSet<FIntPoint> PendingCorners;
+		for (const FVector& Location : InOutLocations)
+		{
+			const FIntPoint BaseCell(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+			for (int32 Corner = 0; Corner < 4; ++Corner)
+			{
+				const FIntPoint CornerCell = BaseCell + FIntPoint(Corner & 1, Corner >> 1);
+				if (!GroundHeights.Contains(CornerCell) && !PendingCorners.Contains(CornerCell))
+				{
+					PendingCorners.Add(CornerCell);
+					MissingCorners.Add(CornerCell);
+					MissingCornerReferenceZ.Add(Location.Z);
+				}
+			}
+		}
+
+		// 2. 缺失角点一次性并行检测
+		TArray<float> CornerHeights;
+		CornerHeights.Init(NoGroundHeight, MissingCorners.Num());
+		ParallelFor(MissingCorners.Num(), [&](int32 Index)
+		{
+			const FVector SamplePoint(MissingCorners[Index].X * CellSize, MissingCorners[Index].Y * CellSize, MissingCornerReferenceZ[Index]);
+			float Height = 0.f;
+			if (TraceGround(World, SamplePoint, Params, Height))
+			{
+				CornerHeights[Index] = Height;
+			}
+		}, GetParallelFlags());
+
+		for (int32 Index = 0; Index < MissingCorners.Num(); ++Index)
+		{
+			GroundHeights.Add(MissingCorners[Index], CornerHeights[Index]);
+		}
+		CornerTraceCount = MissingCorners.Num();
+
+		// 3. 双线性插值；角点缺失或高差过大的槽位留给精确射线
+		const float MaxCornerDelta = CVarGroundMaxCornerDelta.GetValueOnGameThread();
+		for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+		{
+			const FVector& Location = InOutLocations[Slot];
+			const float CellX = Location.X / CellSize;
+			const float CellY = Location.Y / CellSize;
+			const FIntPoint BaseCell(FMath::FloorToInt(CellX), FMath::FloorToInt(CellY));
+
+			const float H00 = GroundHeights.FindRef(BaseCell);
+			const float H10 = GroundHeights.FindRef(BaseCell + FIntPoint(1, 0));
+			const float H01 = GroundHeights.FindRef(BaseCell + FIntPoint(0, 1));
+			const float H11 = GroundHeights.FindRef(BaseCell + FIntPoint(1, 1));
+			const float MinHeight = FMath::Min(FMath::Min(H00, H10), FMath::Min(H01, H11));
+			const float MaxHeight = FMath::Max(FMath::Max(H00, H10), FMath::Max(H01, H11));
+			if (MinHeight == NoGroundHeight || MaxHeight - MinHeight > MaxCornerDelta)
+			{
+				ExactSlots.Add(Slot);
+				continue;
+			}
+
+			const float FracX = CellX - BaseCell.X;
+			const float FracY = CellY - BaseCell.Y;
+			GroundZ[Slot] = FMath::BiLerp(H00, H10, H01, H11, FracX, FracY);
+		}
+	}
+	else
+	{
+		ExactSlots.Reserve(SlotCount);
+		for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+		{
+			ExactSlots.Add(Slot);
+		}
+	}
+
+	// 4. 精确射线同样批量并行
+	ParallelFor(ExactSlots.Num(), [&](int32 Index)
+	{
+		const int32 Slot = ExactSlots[Index];
+		float Height = 0.f;
+		if (TraceGround(World, InOutLocations[Slot], Params, Height))
+		{
+			GroundZ[Slot] = Height;
+		}
+	}, GetParallelFlags());
+
+	FScenarioPerformanceRecorder::NoteTraces(CornerTraceCount + ExactSlots.Num());
+
+	// 5. 应用结果；射线未命中时在游戏线程上回退到导航网格
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(World);
+	int32 ResolvedCount = 0;
+	int32 NavFallbackCount = 0;
+	for (int32 Slot = 0; Slot < SlotCount; ++Slot)
+	{
+		FVector& Location = InOutLocations[Slot];
+		if (GroundZ[Slot] != NoGroundHeight)
+		{
+			Location.Z = GroundZ[Slot] + HeightOffset;
+			++ResolvedCount;
+			continue;
+		}
+
+		FNavLocation ProjectedNav;
+		if (NavSys && NavSys->ProjectPointToNavigation(Location, ProjectedNav, FVector(400.f, 400.f, 1200.f)))
+		{
+			Location = ProjectedNav.Location + FVector(0.f, 0.f, HeightOffset);
+			++ResolvedCount;
+			++NavFallbackCount;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BlueUnitPlacement: projected %d/%d slots in %.2f ms (corner traces=%d, exact traces=%d, nav fallbacks=%d, cached samples=%d)"),
+		ResolvedCount, SlotCount, (FPlatformTime::Seconds() - StartSeconds) * 1000.0,
+		CornerTraceCount, ExactSlots.Num(), NavFallbackCount, GroundHeights.Num());
+	return ResolvedCount;
+}
+
+void FBlueUnitPlacementService::Invalidate()
+{
+	GroundHeights.Reset();
+	CachedWorld.Reset();
+	CachedCellSize = 0.f;
+}
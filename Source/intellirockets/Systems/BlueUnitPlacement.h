@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * 蓝方单位落地投影：
+ * 部署时先算出全部槽位，再一次性投影到地面，而不是每个单位在游戏线程上各做一次 18000 厘米的复杂射线。
+ *
+ * - 地面高度按网格（ir.BlueForce.GroundCellSize）采样并缓存，槽位高度由所在格四角双线性插值；
+ *   缺失的角点在同一批次中并行检测，同一地图的后续部署（原地重置、批量/蒙特卡洛运行）基本不再发射线。
+ * - 四角高差过大（悬崖、建筑边缘）或角点未命中的槽位改为精确射线，同样并行批量执行。
+ * - 射线仍未命中的槽位在游戏线程上回退到导航网格投影。
+ */
+class FBlueUnitPlacementService
+{
+public:
+	/**
+	 * 将 InOutLocations 投影到地面并加上 HeightOffset；无法投影的位置保持不变。
+	 * IgnoredActors 通常是已部署的蓝方单位，避免把单位顶部当作地面。
+	 * 返回成功投影的数量。
+	 */
+	int32 ProjectToGround(UWorld* World, TArray<FVector>& InOutLocations, float HeightOffset, const TArray<AActor*>& IgnoredActors);
+
+	/** 清空高度缓存（地图几何改变时调用；切换世界时自动清空） */
+	void Invalidate();
+
+	int32 GetCachedSampleCount() const { return GroundHeights.Num(); }
+
+private:
+	TWeakObjectPtr<UWorld> CachedWorld;
+	float CachedCellSize = 0.f;
+	TMap<FIntPoint, float> GroundHeights; // 角点 -> 地面高度，未命中为 NoGroundHeight
+};
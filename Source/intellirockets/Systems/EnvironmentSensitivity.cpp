@@ -0,0 +1,138 @@
+#include "Systems/EnvironmentSensitivity.h"
+#include "Async/ParallelFor.h"
+
+namespace EnvironmentSensitivity
+{
+	const TArray<EScenarioFactor>& GetSweepFactors()
+	{
+		static const TArray<EScenarioFactor> Factors = { EScenarioFactor::Weather, EScenarioFactor::Time, EScenarioFactor::Map };
+		return Factors;
+	}
+
+	void Sweep(const FScenarioTestConfig& BaseConfig, const FEnvironmentEvaluator& Evaluator, FEnvironmentSensitivityResult& OutResult)
+	{
+		OutResult = FEnvironmentSensitivityResult();
+
+		const TArray<EScenarioFactor>& Factors = GetSweepFactors();
+		TArray<int32> LevelCounts;
+		TArray<int32> BaseLevels;
+		int32 CellCount = 1;
+		for (const EScenarioFactor Factor : Factors)
+		{
+			const int32 Levels = OrthogonalDesign::GetFactorLevelCount(Factor);
+			LevelCounts.Add(Levels);
+			CellCount *= Levels;
+		}
+		BaseLevels.Add(FMath::Clamp(BaseConfig.WeatherIndex, 0, LevelCounts[0] - 1));
+		BaseLevels.Add(FMath::Clamp(BaseConfig.TimeIndex, 0, LevelCounts[1] - 1));
+		BaseLevels.Add(FMath::Clamp(BaseConfig.MapIndex, 0, LevelCounts[2] - 1));
+
+		// 单元下标按因素顺序混合进制编码，第一个因素为最高位
+		const auto EncodeCell = [&LevelCounts](const TArray<int32>& Levels)
+		{
+			int32 Cell = 0;
+			for (int32 FactorIndex = 0; FactorIndex < Levels.Num(); ++FactorIndex)
+			{
+				Cell = Cell * LevelCounts[FactorIndex] + Levels[FactorIndex];
+			}
+			return Cell;
+		};
+
+		TArray<TArray<FIndicatorEvaluationResult>> CellResults;
+		CellResults.SetNum(CellCount);
+		ParallelFor(CellCount, [&](int32 Cell)
+		{
+			FScenarioTestConfig Config = BaseConfig;
+			int32 Remainder = Cell;
+			for (int32 FactorIndex = Factors.Num() - 1; FactorIndex >= 0; --FactorIndex)
+			{
+				OrthogonalDesign::ApplyFactorLevel(Factors[FactorIndex], Remainder % LevelCounts[FactorIndex], Config);
+				Remainder /= LevelCounts[FactorIndex];
+			}
+			Evaluator(Config, CellResults[Cell]);
+		});
+
+		OutResult.BaseWeatherIndex = BaseLevels[0];
+		OutResult.BaseTimeIndex = BaseLevels[1];
+		OutResult.BaseMapIndex = BaseLevels[2];
+		OutResult.CellCount = CellCount;
+
+		const TArray<FIndicatorEvaluationResult>& Baseline = CellResults[EncodeCell(BaseLevels)];
+		for (int32 Index = 0; Index < Baseline.Num(); ++Index)
+		{
+			const FIndicatorEvaluationResult& Base = Baseline[Index];
+			if (!Base.bHasData)
+			{
+				continue;
+			}
+
+			FEnvironmentIndicatorSensitivity& Sensitivity = OutResult.Indicators.AddDefaulted_GetRef();
+			Sensitivity.IndicatorId = Base.IndicatorId;
+			Sensitivity.DisplayName = Base.DisplayName;
+			Sensitivity.BaselineValue = Base.Value;
+			Sensitivity.TargetValue = Base.TargetValue;
+			Sensitivity.bHigherIsBetter = Base.bHigherIsBetter;
+			Sensitivity.bBaselinePass = Base.bPass;
+
+			for (const TArray<FIndicatorEvaluationResult>& Results : CellResults)
+			{
+				if (Results.IsValidIndex(Index) && Results[Index].bHasData && Results[Index].bPass)
+				{
+					++Sensitivity.PassingCells;
+				}
+			}
+
+			// 单因素遍历：其余因素保持基线水平
+			for (int32 FactorIndex = 0; FactorIndex < Factors.Num(); ++FactorIndex)
+			{
+				FEnvironmentFactorSwing& Swing = Sensitivity.Swings.AddDefaulted_GetRef();
+				Swing.Factor = Factors[FactorIndex];
+				Swing.LevelCount = LevelCounts[FactorIndex];
+				Swing.WorstLevel = Swing.BestLevel = BaseLevels[FactorIndex];
+				Swing.WorstValue = Swing.BestValue = Base.Value;
+
+				TArray<int32> Levels = BaseLevels;
+				for (int32 Level = 0; Level < LevelCounts[FactorIndex]; ++Level)
+				{
+					Levels[FactorIndex] = Level;
+					const TArray<FIndicatorEvaluationResult>& Results = CellResults[EncodeCell(Levels)];
+					if (!Results.IsValidIndex(Index) || !Results[Index].bHasData)
+					{
+						continue;
+					}
+
+					const float Value = Results[Index].Value;
+					const bool bBetter = Base.bHigherIsBetter ? Value > Swing.BestValue : Value < Swing.BestValue;
+					const bool bWorse = Base.bHigherIsBetter ? Value < Swing.WorstValue : Value > Swing.WorstValue;
+					if (bBetter)
+					{
+						Swing.BestValue = Value;
+						Swing.BestLevel = Level;
+					}
+					if (bWorse)
+					{
+						Swing.WorstValue = Value;
+						Swing.WorstLevel = Level;
+					}
+					Swing.PassingLevels += Results[Index].bPass ? 1 : 0;
+				}
+			}
+
+			Sensitivity.Swings.Sort([](const FEnvironmentFactorSwing& A, const FEnvironmentFactorSwing& B)
+			{
+				return A.GetSwing() > B.GetSwing();
+			});
+		}
+
+		// 受环境影响最大的指标排在前面；各指标单位不同，按相对目标值的比例比较
+		const auto GetRelativeSwing = [](const FEnvironmentIndicatorSensitivity& Sensitivity)
+		{
+			const float Swing = Sensitivity.Swings.Num() > 0 ? Sensitivity.Swings[0].GetSwing() : 0.f;
+			return Swing / FMath::Max(FMath::Abs(Sensitivity.TargetValue), KINDA_SMALL_NUMBER);
+		};
+		OutResult.Indicators.StableSort([&GetRelativeSwing](const FEnvironmentIndicatorSensitivity& A, const FEnvironmentIndicatorSensitivity& B)
+		{
+			return GetRelativeSwing(A) > GetRelativeSwing(B);
+		});
+	}
+}
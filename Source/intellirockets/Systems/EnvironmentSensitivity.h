@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/OrthogonalDesign.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+/**
+ * 环境因素敏感性分析：对已完成会话的发射记录，在天气 × 时间 × 地图的全部组合下重新评估指标。
+ * - 不重新仿真：发射记录的统计只做一次，每个组合只替换环境因子（BuildEnvironmentEffect）后重新评估；
+ * - 各组合互相独立，用 ParallelFor 并行计算；
+ * - 以当前会话的环境为基线，逐个因素遍历其全部水平（其余因素保持基线），得到龙卷风图所需的最差/最好值。
+ */
+
+/** 在给定环境配置下重新评估全部指标，结果顺序与 BuildIndicatorEvaluations 一致；会在多个工作线程上同时调用 */
+using FEnvironmentEvaluator = TFunction<void(const FScenarioTestConfig& Config, TArray<FIndicatorEvaluationResult>& OutResults)>;
+
+/** 单个因素对某项指标的影响（龙卷风图的一根条） */
+struct FEnvironmentFactorSwing
+{
+	EScenarioFactor Factor = EScenarioFactor::Weather;
+	int32 WorstLevel = 0;
+	int32 BestLevel = 0;
+	float WorstValue = 0.f;
+	float BestValue = 0.f;
+	int32 PassingLevels = 0; // 该因素各水平中（其余因素为基线）达标的数量
+	int32 LevelCount = 0;
+
+	float GetSwing() const { return FMath::Abs(BestValue - WorstValue); }
+};
+
+struct FEnvironmentIndicatorSensitivity
+{
+	FString IndicatorId;
+	FString DisplayName;
+	float BaselineValue = 0.f;
+	float TargetValue = 0.f;
+	bool bHigherIsBetter = true;
+	bool bBaselinePass = false;
+	int32 PassingCells = 0; // 全部组合中达标的数量
+	TArray<FEnvironmentFactorSwing> Swings; // 按影响从大到小排序
+};
+
+struct FEnvironmentSensitivityResult
+{
+	int32 BaseWeatherIndex = 0;
+	int32 BaseTimeIndex = 0;
+	int32 BaseMapIndex = 0;
+	int32 CellCount = 0;
+	TArray<FEnvironmentIndicatorSensitivity> Indicators; // 仅包含有数据的指标
+};
+
+namespace EnvironmentSensitivity
+{
+	/** 参与扫描的因素：天气、时间、地图 */
+	const TArray<EScenarioFactor>& GetSweepFactors();
+
+	void Sweep(const FScenarioTestConfig& BaseConfig, const FEnvironmentEvaluator& Evaluator, FEnvironmentSensitivityResult& OutResult);
+}
@@ -0,0 +1,211 @@
+#include "Systems/IndicatorBootstrap.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Templates/TypeHash.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarBootstrapResamples(
+		TEXT("ir.Bootstrap.Resamples"),
+		1000,
+		TEXT("指标置信区间的 Bootstrap 重抽样次数（0 关闭）"));
+
+	TAutoConsoleVariable<int32> CVarBootstrapSeed(
+		TEXT("ir.Bootstrap.Seed"),
+		20240611,
+		TEXT("Bootstrap 重抽样的随机种子（相同记录与种子得到相同区间）"));
+
+	TAutoConsoleVariable<int32> CVarBootstrapMinRecords(
+		TEXT("ir.Bootstrap.MinRecords"),
+		10,
+		TEXT("发射记录少于该数量时不给出置信结论（样本过少时重抽样区间会严重低估不确定性）"));
+
+	constexpr int32 ResamplesPerChunk = 16;
+	constexpr float LowerQuantile = 0.025f;
+	constexpr float UpperQuantile = 0.975f;
+}
+
+FIndicatorBootstrap::~FIndicatorBootstrap()
+{
+	Reset();
+}
+
+bool FIndicatorBootstrap::IsEnabled()
+{
+	return CVarBootstrapResamples.GetValueOnGameThread() > 0;
+}
+
+void FIndicatorBootstrap::Start(int32 NumRecords, const TArray<FIndicatorEvaluationResult>& PointEvaluations, FIndicatorSampleEvaluator&& Evaluator)
+{
+	Reset();
+
+	ResampleCount = FMath::Clamp(CVarBootstrapResamples.GetValueOnGameThread(), 1, 100000);
+	const uint32 Seed = static_cast<uint32>(CVarBootstrapSeed.GetValueOnGameThread());
+	const int32 MinRecords = FMath::Max(2, CVarBootstrapMinRecords.GetValueOnGameThread());
+
+	State = MakeShared<FSharedState, ESPMode::ThreadSafe>();
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> SharedState = State;
+	const int32 Resamples = ResampleCount;
+	Future = Async(EAsyncExecution::Thread, [SharedState, NumRecords, Resamples, Seed, MinRecords, PointEvaluations, Evaluator = MoveTemp(Evaluator)]()
+	{
+		const double StartSeconds = FPlatformTime::Seconds();
+		Run(NumRecords, Resamples, Seed, MinRecords, PointEvaluations, Evaluator, *SharedState);
+		UE_LOG(LogTemp, Log, TEXT("IndicatorBootstrap: %d resamples of %d records, %d indicators in %.2fs%s"),
+			Resamples, NumRecords, PointEvaluations.Num(), FPlatformTime::Seconds() - StartSeconds,
+			SharedState->bCancelRequested ? TEXT(" (cancelled)") : TEXT(""));
+	});
+}
+
+void FIndicatorBootstrap::Reset()
+{
+	if (State.IsValid())
+	{
+		State->bCancelRequested = true;
+	}
+	if (Future.IsValid())
+	{
+		Future.Wait();
+	}
+	Future = TFuture<void>();
+	State.Reset();
+}
+
+bool FIndicatorBootstrap::IsRunning() const
+{
+	return Future.IsValid() && !Future.IsReady();
+}
+
+bool FIndicatorBootstrap::HasResults() const
+{
+	return Future.IsValid() && Future.IsReady() && State.IsValid() && !State->bCancelRequested;
+}
+
+float FIndicatorBootstrap::GetProgress() const
+{
+	if (!State.IsValid() || ResampleCount <= 0)
+	{
+		return 0.f;
+	}
+	return FMath::Clamp(static_cast<float>(State->ResamplesDone.load()) / ResampleCount, 0.f, 1.f);
+}
+
+FIndicatorConfidenceInterval FIndicatorBootstrap::GetInterval(int32 Index) const
+{
+	if (!HasResults() || !State->Intervals.IsValidIndex(Index))
+	{
+		return FIndicatorConfidenceInterval();
+	}
+	return State->Intervals[Index];
+}
+
+void FIndicatorBootstrap::Run(int32 NumRecords, int32 Resamples, uint32 Seed, int32 MinRecords, const TArray<FIndicatorEvaluationResult>& PointEvaluations, const FIndicatorSampleEvaluator& Evaluator, FSharedState& State)
+{
+	const int32 NumIndicators = PointEvaluations.Num();
+	TArray<FIndicatorConfidenceInterval>& Intervals = State.Intervals;
+	Intervals.SetNum(NumIndicators);
+
+	TArray<int32> Resampled;
+	for (int32 Index = 0; Index < NumIndicators; ++Index)
+	{
+		const FIndicatorEvaluationResult& Point = PointEvaluations[Index];
+		if (!Point.bHasData || !Point.bRecordBased)
+		{
+			Intervals[Index].Verdict = EIndicatorConfidence::NotApplicable;
+		}
+		else if (NumRecords < MinRecords)
+		{
+			Intervals[Index].Verdict = EIndicatorConfidence::InsufficientData;
+		}
+		else
+		{
+			Resampled.Add(Index);
+		}
+	}
+	if (Resampled.Num() == 0)
+	{
+		State.ResamplesDone = Resamples;
+		return;
+	}
+
+	// 按 [重抽样][指标] 存放，NaN 表示该次重抽样中指标无数据
+	TArray<float> Values;
+	Values.Init(NAN, Resamples * NumIndicators);
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Resamples, ResamplesPerChunk);
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		TArray<int32> SampleIndices;
+		SampleIndices.SetNumUninitialized(NumRecords);
+		TArray<FIndicatorEvaluationResult> SampleResults;
+
+		const int32 ChunkEnd = FMath::Min(Resamples, (Chunk + 1) * ResamplesPerChunk);
+		for (int32 Resample = Chunk * ResamplesPerChunk; Resample < ChunkEnd; ++Resample)
+		{
+			if (State.bCancelRequested)
+			{
+				return;
+			}
+
+			FRandomStream Stream(static_cast<int32>(HashCombine(Seed, static_cast<uint32>(Resample))));
+			for (int32 Slot = 0; Slot < NumRecords; ++Slot)
+			{
+				SampleIndices[Slot] = Stream.RandHelper(NumRecords);
+			}
+			// 按发射顺序排列；依赖顺序的自动发射间隔由调用方按原始序列预先计算，不在样本内求相邻差
+			SampleIndices.Sort();
+
+			Evaluator(SampleIndices, SampleResults);
+			float* Row = Values.GetData() + static_cast<int64>(Resample) * NumIndicators;
+			for (const int32 Index : Resampled)
+			{
+				if (SampleResults.IsValidIndex(Index) && SampleResults[Index].bHasData)
+				{
+					Row[Index] = SampleResults[Index].Value;
+				}
+			}
+			++State.ResamplesDone;
+		}
+	});
+
+	if (State.bCancelRequested)
+	{
+		return;
+	}
+
+	TArray<float> Column;
+	Column.Reserve(Resamples);
+	for (const int32 Index : Resampled)
+	{
+		Column.Reset();
+		for (int32 Resample = 0; Resample < Resamples; ++Resample)
+		{
+			const float Value = Values[static_cast<int64>(Resample) * NumIndicators + Index];
+			if (!FMath::IsNaN(Value))
+			{
+				Column.Add(Value);
+			}
+		}
+
+		FIndicatorConfidenceInterval& Interval = Intervals[Index];
+		// 多数重抽样中该指标没有样本（例如只有少数导弹触发了干扰），区间不可信
+		if (Column.Num() * 2 < Resamples)
+		{
+			Interval.Verdict = EIndicatorConfidence::InsufficientData;
+			continue;
+		}
+
+		Column.Sort();
+		const int32 Last = Column.Num() - 1;
+		Interval.Lower = Column[FMath::FloorToInt(LowerQuantile * Last)];
+		Interval.Upper = Column[FMath::CeilToInt(UpperQuantile * Last)];
+
+		const FIndicatorEvaluationResult& Point = PointEvaluations[Index];
+		const bool bAllPass = Point.bHigherIsBetter ? Interval.Lower >= Point.TargetValue : Interval.Upper <= Point.TargetValue;
+		const bool bAllFail = Point.bHigherIsBetter ? Interval.Upper < Point.TargetValue : Interval.Lower > Point.TargetValue;
+		Interval.Verdict = bAllPass ? EIndicatorConfidence::ConfidentPass
+			: (bAllFail ? EIndicatorConfidence::ConfidentFail : EIndicatorConfidence::Inconclusive);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Systems/ScenarioTestMetrics.h"
+
+#include <atomic>
+
+/** 指标区间估计结论 */
+enum class EIndicatorConfidence : uint8
+{
+	Pending,          // 计算中
+	NotApplicable,    // 无数据，或指标不是由逐发记录统计得出（感知、分裂计数等）
+	InsufficientData, // 发射记录少于 ir.Bootstrap.MinRecords
+	ConfidentPass,    // 置信区间整体达标
+	ConfidentFail,    // 置信区间整体未达标
+	Inconclusive,     // 置信区间跨过目标值
+};
+
+struct FIndicatorConfidenceInterval
+{
+	EIndicatorConfidence Verdict = EIndicatorConfidence::Pending;
+	float Lower = 0.f;
+	float Upper = 0.f;
+};
+
+/** 以重抽样后的记录下标重新评估全部指标；结果顺序须与点估计一致。会在多个工作线程上同时调用 */
+using FIndicatorSampleEvaluator = TFunction<void(TConstArrayView<int32> SampleIndices, TArray<FIndicatorEvaluationResult>& OutResults)>;
+
+/**
+ * 指标的 Bootstrap 置信区间：对发射记录有放回重抽样 ir.Bootstrap.Resamples 次，
+ * 每次重新计算汇总与指标，取 2.5%/97.5% 分位数作为 95% 置信区间。
+ * - 第 i 次重抽样使用由 ir.Bootstrap.Seed 与 i 派生的随机流，结果与线程数量、调度顺序无关；
+ * - 在后台线程启动，重抽样分块交给 ParallelFor，界面通过 GetProgress/GetInterval 轮询，不阻塞游戏线程。
+ */
+class FIndicatorBootstrap
+{
+public:
+	~FIndicatorBootstrap();
+
+	/** ir.Bootstrap.Resamples > 0 */
+	static bool IsEnabled();
+
+	/** 开始计算（取消正在进行的计算）；Evaluator 持有所需数据的副本 */
+	void Start(int32 NumRecords, const TArray<FIndicatorEvaluationResult>& PointEvaluations, FIndicatorSampleEvaluator&& Evaluator);
+	/** 取消并等待后台线程退出，清空结果 */
+	void Reset();
+
+	bool IsRunning() const;
+	bool HasResults() const;
+	/** 0-1 */
+	float GetProgress() const;
+	int32 GetResampleCount() const { return ResampleCount; }
+	/** Index 与 BuildIndicatorEvaluations 的顺序一致 */
+	FIndicatorConfidenceInterval GetInterval(int32 Index) const;
+
+private:
+	struct FSharedState
+	{
+		std::atomic<int32> ResamplesDone{ 0 };
+		std::atomic<bool> bCancelRequested{ false };
+		TArray<FIndicatorConfidenceInterval> Intervals; // 后台线程写入，完成后只读
+	};
+
+	static void Run(int32 NumRecords, int32 Resamples, uint32 Seed, int32 MinRecords, const TArray<FIndicatorEvaluationResult>& PointEvaluations, const FIndicatorSampleEvaluator& Evaluator, FSharedState& State);
+
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> State;
+	TFuture<void> Future;
+	int32 ResampleCount = 0;
+};
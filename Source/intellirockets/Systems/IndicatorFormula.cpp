@@ -0,0 +1,635 @@
+#include "Systems/IndicatorFormula.h"
+#include "UI/Data/IndicatorDataCache.h"
+
+namespace
+{
+	struct FFormulaVariableName
+	{
+		const TCHAR* Name;
+		EIndicatorFormulaVariable Variable;
+	};
+
+	const FFormulaVariableName FormulaVariableNames[] =
+	{
+		{ TEXT("totalShots"), EIndicatorFormulaVariable::TotalShots },
+		{ TEXT("manualShots"), EIndicatorFormulaVariable::ManualShots },
+		{ TEXT("autoShots"), EIndicatorFormulaVariable::AutoShots },
+		{ TEXT("hits"), EIndicatorFormulaVariable::Hits },
+		{ TEXT("directHits"), EIndicatorFormulaVariable::DirectHits },
+		{ TEXT("aoeHits"), EIndicatorFormulaVariable::AoEHits },
+		{ TEXT("misses"), EIndicatorFormulaVariable::Misses },
+		{ TEXT("hitRate"), EIndicatorFormulaVariable::HitRate },
+		{ TEXT("directHitRate"), EIndicatorFormulaVariable::DirectHitRate },
+		{ TEXT("averageFlightTime"), EIndicatorFormulaVariable::AverageFlightTime },
+		{ TEXT("averageLaunchDistance"), EIndicatorFormulaVariable::AverageLaunchDistance },
+		{ TEXT("averageDestroyedPerHit"), EIndicatorFormulaVariable::AverageDestroyedPerHit },
+		{ TEXT("averageAutoLaunchInterval"), EIndicatorFormulaVariable::AverageAutoLaunchInterval },
+		{ TEXT("sessionDuration"), EIndicatorFormulaVariable::SessionDuration },
+		{ TEXT("hlSplitAttempts"), EIndicatorFormulaVariable::HLSplitAttempts },
+		{ TEXT("hlSplitSuccesses"), EIndicatorFormulaVariable::HLSplitSuccesses },
+		{ TEXT("hlSplitChildShots"), EIndicatorFormulaVariable::HLSplitChildShots },
+		{ TEXT("hlSplitChildHits"), EIndicatorFormulaVariable::HLSplitChildHits },
+		{ TEXT("hlSplitGroups"), EIndicatorFormulaVariable::HLSplitGroups },
+		{ TEXT("hlSplitGroupUniqueTargets"), EIndicatorFormulaVariable::HLSplitGroupUniqueTargets },
+		{ TEXT("countermeasureDetectionMargin"), EIndicatorFormulaVariable::CountermeasureDetectionMargin },
+		{ TEXT("countermeasureActivationDelay"), EIndicatorFormulaVariable::CountermeasureActivationDelay },
+		{ TEXT("countermeasureOnTimeRate"), EIndicatorFormulaVariable::CountermeasureOnTimeRate },
+		{ TEXT("countermeasureActivationDistance"), EIndicatorFormulaVariable::CountermeasureActivationDistance },
+		{ TEXT("countermeasureActivationHeightDiff"), EIndicatorFormulaVariable::CountermeasureActivationHeightDiff },
+		{ TEXT("countermeasureSuppressionRate"), EIndicatorFormulaVariable::CountermeasureSuppressionRate },
+		{ TEXT("countermeasureRadiusReductionRate"), EIndicatorFormulaVariable::CountermeasureRadiusReductionRate },
+		{ TEXT("countermeasureCoverageRate"), EIndicatorFormulaVariable::CountermeasureCoverageRate },
+		{ TEXT("countermeasureDuration"), EIndicatorFormulaVariable::CountermeasureDuration },
+		{ TEXT("countermeasureResourceCostScore"), EIndicatorFormulaVariable::CountermeasureResourceCostScore },
+
+		{ TEXT("autoRecordShots"), EIndicatorFormulaVariable::AutoRecordShots },
+		{ TEXT("autoHits"), EIndicatorFormulaVariable::AutoHits },
+		{ TEXT("autoHitRate"), EIndicatorFormulaVariable::AutoHitRate },
+		{ TEXT("autoFireRatio"), EIndicatorFormulaVariable::AutoFireRatio },
+		{ TEXT("autoFlightTime"), EIndicatorFormulaVariable::AutoFlightTime },
+		{ TEXT("autoFlightSamples"), EIndicatorFormulaVariable::AutoFlightSamples },
+
+		{ TEXT("perception.correct"), EIndicatorFormulaVariable::PerceptionCorrect },
+		{ TEXT("perception.falsePositives"), EIndicatorFormulaVariable::PerceptionFalsePositives },
+		{ TEXT("perception.falseNegatives"), EIndicatorFormulaVariable::PerceptionFalseNegatives },
+		{ TEXT("perception.recognitionTime"), EIndicatorFormulaVariable::PerceptionRecognitionTime },
+		{ TEXT("perception.recognitionSamples"), EIndicatorFormulaVariable::PerceptionRecognitionSamples },
+		{ TEXT("perception.lightTotal"), EIndicatorFormulaVariable::PerceptionLightTotal },
+		{ TEXT("perception.lightCorrect"), EIndicatorFormulaVariable::PerceptionLightCorrect },
+		{ TEXT("perception.weatherTotal"), EIndicatorFormulaVariable::PerceptionWeatherTotal },
+		{ TEXT("perception.weatherCorrect"), EIndicatorFormulaVariable::PerceptionWeatherCorrect },
+		{ TEXT("perception.maxTracks"), EIndicatorFormulaVariable::PerceptionMaxTracks },
+		{ TEXT("perception.trackingError"), EIndicatorFormulaVariable::PerceptionTrackingError },
+		{ TEXT("perception.trackingSamples"), EIndicatorFormulaVariable::PerceptionTrackingSamples },
+		{ TEXT("perception.jamLightTotal"), EIndicatorFormulaVariable::PerceptionJamLightTotal },
+		{ TEXT("perception.jamLightCorrect"), EIndicatorFormulaVariable::PerceptionJamLightCorrect },
+		{ TEXT("perception.jamMediumTotal"), EIndicatorFormulaVariable::PerceptionJamMediumTotal },
+		{ TEXT("perception.jamMediumCorrect"), EIndicatorFormulaVariable::PerceptionJamMediumCorrect },
+		{ TEXT("perception.interferenceTotal"), EIndicatorFormulaVariable::PerceptionInterferenceTotal },
+		{ TEXT("perception.interferenceCorrect"), EIndicatorFormulaVariable::PerceptionInterferenceCorrect },
+		{ TEXT("perception.frequencyAdjustTotal"), EIndicatorFormulaVariable::PerceptionFrequencyAdjustTotal },
+		{ TEXT("perception.frequencyAdjustSuccess"), EIndicatorFormulaVariable::PerceptionFrequencyAdjustSuccess },
+		{ TEXT("perception.recoveryTime"), EIndicatorFormulaVariable::PerceptionRecoveryTime },
+		{ TEXT("perception.recoverySamples"), EIndicatorFormulaVariable::PerceptionRecoverySamples },
+		{ TEXT("perception.keypartTotal"), EIndicatorFormulaVariable::PerceptionKeypartTotal },
+		{ TEXT("perception.keypartCorrect"), EIndicatorFormulaVariable::PerceptionKeypartCorrect },
+		{ TEXT("perception.heatTrackError"), EIndicatorFormulaVariable::PerceptionHeatTrackError },
+		{ TEXT("perception.heatTrackSamples"), EIndicatorFormulaVariable::PerceptionHeatTrackSamples },
+	};
+	static_assert(UE_ARRAY_COUNT(FormulaVariableNames) == static_cast<int32>(EIndicatorFormulaVariable::Count), "FormulaVariableNames must cover every EIndicatorFormulaVariable");
+
+	bool FindFormulaVariable(const FString& Name, int32& OutIndex)
+	{
+		for (const FFormulaVariableName& Entry : FormulaVariableNames)
+		{
+			if (Name.Equals(Entry.Name, ESearchCase::CaseSensitive))
+			{
+				OutIndex = static_cast<int32>(Entry.Variable);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	double SafeDivide(double Numerator, double Denominator)
+	{
+		return Denominator != 0.0 ? Numerator / Denominator : 0.0;
+	}
+}
+
+void FIndicatorFormulaContext::Bind(const FMissileTestSummary& Summary, const FPerceptionRuntimeStats& Perception, TConstArrayView<const FMissileTestRecord*> Records)
+{
+	const auto Set = [this](EIndicatorFormulaVariable Variable, double Value)
+	{
+		Values[static_cast<int32>(Variable)] = Value;
+	};
+
+	Set(EIndicatorFormulaVariable::TotalShots, Summary.TotalShots);
+	Set(EIndicatorFormulaVariable::ManualShots, Summary.ManualShots);
+	Set(EIndicatorFormulaVariable::AutoShots, Summary.AutoShots);
+	Set(EIndicatorFormulaVariable::Hits, Summary.Hits);
+	Set(EIndicatorFormulaVariable::DirectHits, Summary.DirectHits);
+	Set(EIndicatorFormulaVariable::AoEHits, Summary.AoEHits);
+	Set(EIndicatorFormulaVariable::Misses, Summary.Misses);
+	Set(EIndicatorFormulaVariable::HitRate, Summary.HitRate);
+	Set(EIndicatorFormulaVariable::DirectHitRate, Summary.DirectHitRate);
+	Set(EIndicatorFormulaVariable::AverageFlightTime, Summary.AverageFlightTime);
+	Set(EIndicatorFormulaVariable::AverageLaunchDistance, Summary.AverageLaunchDistance);
+	Set(EIndicatorFormulaVariable::AverageDestroyedPerHit, Summary.AverageDestroyedPerHit);
+	Set(EIndicatorFormulaVariable::AverageAutoLaunchInterval, Summary.AverageAutoLaunchInterval);
+	Set(EIndicatorFormulaVariable::SessionDuration, Summary.SessionDuration);
+	Set(EIndicatorFormulaVariable::HLSplitAttempts, Summary.HLSplitAttemptCount);
+	Set(EIndicatorFormulaVariable::HLSplitSuccesses, Summary.HLSplitSuccessCount);
+	Set(EIndicatorFormulaVariable::HLSplitChildShots, Summary.HLSplitChildShotCount);
+	Set(EIndicatorFormulaVariable::HLSplitChildHits, Summary.HLSplitChildHitCount);
+	Set(EIndicatorFormulaVariable::HLSplitGroups, Summary.HLSplitGroupCount);
+	Set(EIndicatorFormulaVariable::HLSplitGroupUniqueTargets, Summary.HLSplitGroupUniqueTargetsTotal);
+	Set(EIndicatorFormulaVariable::CountermeasureDetectionMargin, Summary.CountermeasureAverageDetectionMarginPercent);
+	Set(EIndicatorFormulaVariable::CountermeasureActivationDelay, Summary.CountermeasureAverageActivationDelay);
+	Set(EIndicatorFormulaVariable::CountermeasureOnTimeRate, Summary.CountermeasureOnTimeRate);
+	Set(EIndicatorFormulaVariable::CountermeasureActivationDistance, Summary.CountermeasureAverageActivationDistance);
+	Set(EIndicatorFormulaVariable::CountermeasureActivationHeightDiff, Summary.CountermeasureAverageActivationHeightDiff);
+	Set(EIndicatorFormulaVariable::CountermeasureSuppressionRate, Summary.CountermeasureSuppressionSuccessRate);
+	Set(EIndicatorFormulaVariable::CountermeasureRadiusReductionRate, Summary.CountermeasureAverageRadiusReductionRate);
+	Set(EIndicatorFormulaVariable::CountermeasureCoverageRate, Summary.CountermeasureCoverageSuccessRate);
+	Set(EIndicatorFormulaVariable::CountermeasureDuration, Summary.CountermeasureAverageDuration);
+	Set(EIndicatorFormulaVariable::CountermeasureResourceCostScore, Summary.CountermeasureResourceCostScore);
+
+	// 自动发射聚合只需遍历一次记录，所有公式共用
+	int32 AutoShots = 0;
+	int32 AutoHits = 0;
+	double AutoFlightTime = 0.0;
+	int32 AutoFlightSamples = 0;
+	for (const FMissileTestRecord* Record : Records)
+	{
+		if (!Record->bAutoFire)
+		{
+			continue;
+		}
+		++AutoShots;
+		if (Record->DestroyedCount > 0)
+		{
+			++AutoHits;
+		}
+		const float FlightDuration = Record->GetFlightDuration();
+		if (FlightDuration > 0.f)
+		{
+			AutoFlightTime += FlightDuration;
+			++AutoFlightSamples;
+		}
+	}
+	Set(EIndicatorFormulaVariable::AutoRecordShots, AutoShots);
+	Set(EIndicatorFormulaVariable::AutoHits, AutoHits);
+	Set(EIndicatorFormulaVariable::AutoHitRate, SafeDivide(AutoHits * 100.0, AutoShots));
+	Set(EIndicatorFormulaVariable::AutoFireRatio, SafeDivide(Summary.AutoShots * 100.0, Summary.TotalShots));
+	Set(EIndicatorFormulaVariable::AutoFlightTime, SafeDivide(AutoFlightTime, AutoFlightSamples));
+	Set(EIndicatorFormulaVariable::AutoFlightSamples, AutoFlightSamples);
+
+	Set(EIndicatorFormulaVariable::PerceptionCorrect, Perception.NumDetectionsCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionFalsePositives, Perception.NumFalsePositives);
+	Set(EIndicatorFormulaVariable::PerceptionFalseNegatives, Perception.NumFalseNegatives);
+	Set(EIndicatorFormulaVariable::PerceptionRecognitionTime, Perception.TotalRecognitionTimeSeconds);
+	Set(EIndicatorFormulaVariable::PerceptionRecognitionSamples, Perception.NumRecognitionSamples);
+	Set(EIndicatorFormulaVariable::PerceptionLightTotal, Perception.SamplesLightTotal);
+	Set(EIndicatorFormulaVariable::PerceptionLightCorrect, Perception.SamplesLightCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionWeatherTotal, Perception.SamplesWeatherTotal);
+	Set(EIndicatorFormulaVariable::PerceptionWeatherCorrect, Perception.SamplesWeatherCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionMaxTracks, Perception.MaxSimultaneousTracksObserved);
+	Set(EIndicatorFormulaVariable::PerceptionTrackingError, Perception.TotalTrackingErrorMeters);
+	Set(EIndicatorFormulaVariable::PerceptionTrackingSamples, Perception.NumTrackingErrorSamples);
+	Set(EIndicatorFormulaVariable::PerceptionJamLightTotal, Perception.SamplesJamLightTotal);
+	Set(EIndicatorFormulaVariable::PerceptionJamLightCorrect, Perception.SamplesJamLightCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionJamMediumTotal, Perception.SamplesJamMediumTotal);
+	Set(EIndicatorFormulaVariable::PerceptionJamMediumCorrect, Perception.SamplesJamMediumCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionInterferenceTotal, Perception.SamplesInterferenceDetectedTotal);
+	Set(EIndicatorFormulaVariable::PerceptionInterferenceCorrect, Perception.SamplesInterferenceDetectedCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionFrequencyAdjustTotal, Perception.SamplesFrequencyAdjustTotal);
+	Set(EIndicatorFormulaVariable::PerceptionFrequencyAdjustSuccess, Perception.SamplesFrequencyAdjustSuccess);
+	Set(EIndicatorFormulaVariable::PerceptionRecoveryTime, Perception.TotalRecoveryTimeSeconds);
+	Set(EIndicatorFormulaVariable::PerceptionRecoverySamples, Perception.NumRecoverySamples);
+	Set(EIndicatorFormulaVariable::PerceptionKeypartTotal, Perception.SamplesKeypartTotal);
+	Set(EIndicatorFormulaVariable::PerceptionKeypartCorrect, Perception.SamplesKeypartCorrect);
+	Set(EIndicatorFormulaVariable::PerceptionHeatTrackError, Perception.TotalHeatTrackErrorMeters);
+	Set(EIndicatorFormulaVariable::PerceptionHeatTrackSamples, Perception.NumHeatTrackSamples);
+}
+
+/**
+ * 递归下降编译器：边解析边输出后缀字节码，并跟踪求值栈深度。
+ *   ternary := or ('?' ternary ':' ternary)?
+ *   or      := and ('||' and)*
+ *   and     := compare ('&&' compare)*
+ *   compare := sum (('<' | '<=' | '>' | '>=' | '==' | '!=') sum)?
+ *   sum     := product (('+' | '-') product)*
+ *   product := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | primary
+ *   primary := number | variable | function '(' args ')' | '(' ternary ')'
+ */
+class FIndicatorFormulaCompiler
+{
+public:
+	using EOp = FIndicatorFormulaProgram::EOp;
+
+	FIndicatorFormulaCompiler(const FString& InSource, FIndicatorFormulaProgram& InProgram)
+		: Source(InSource)
+		, Program(InProgram)
+	{
+	}
+
+	bool Run(FString& OutError)
+	{
+		ParseTernary();
+		SkipWhitespace();
+		if (Error.IsEmpty() && Position < Source.Len())
+		{
+			Fail(FString::Printf(TEXT("无法识别的字符 '%c'"), Source[Position]));
+		}
+		OutError = Error;
+		return Error.IsEmpty();
+	}
+
+private:
+	void Fail(const FString& Message)
+	{
+		if (Error.IsEmpty())
+		{
+			Error = FString::Printf(TEXT("%s（位置 %d）"), *Message, Position);
+		}
+	}
+
+	void Emit(EOp Op, int32 Operand, int32 StackDelta)
+	{
+		Program.Code.Add({ Op, Operand });
+		Depth += StackDelta;
+		if (Depth > FIndicatorFormulaProgram::MaxStackDepth)
+		{
+			Fail(TEXT("公式嵌套过深"));
+		}
+	}
+
+	void SkipWhitespace()
+	{
+		while (Position < Source.Len() && FChar::IsWhitespace(Source[Position]))
+		{
+			++Position;
+		}
+	}
+
+	bool Match(const TCHAR* Token)
+	{
+		SkipWhitespace();
+		const int32 Length = FCString::Strlen(Token);
+		if (Source.Len() - Position >= Length && FCString::Strncmp(*Source + Position, Token, Length) == 0)
+		{
+			Position += Length;
+			return true;
+		}
+		return false;
+	}
+
+	void Expect(const TCHAR* Token)
+	{
+		if (!Match(Token))
+		{
+			Fail(FString::Printf(TEXT("缺少 '%s'"), Token));
+		}
+	}
+
+	void ParseTernary()
+	{
+		ParseOr();
+		if (Match(TEXT("?")))
+		{
+			ParseTernary();
+			Expect(TEXT(":"));
+			ParseTernary();
+			Emit(EOp::Select, 0, -2);
+		}
+	}
+
+	void ParseOr()
+	{
+		ParseAnd();
+		while (Error.IsEmpty() && Match(TEXT("||")))
+		{
+			ParseAnd();
+			Emit(EOp::Or, 0, -1);
+		}
+	}
+
+	void ParseAnd()
+	{
+		ParseCompare();
+		while (Error.IsEmpty() && Match(TEXT("&&")))
+		{
+			ParseCompare();
+			Emit(EOp::And, 0, -1);
+		}
+	}
+
+	void ParseCompare()
+	{
+		ParseSum();
+		struct FOperator
+		{
+			const TCHAR* Token;
+			EOp Op;
+		};
+		// 双字符运算符先于单字符匹配
+		static const FOperator Operators[] =
+		{
+			{ TEXT("<="), EOp::LessEqual },
+			{ TEXT(">="), EOp::GreaterEqual },
+			{ TEXT("=="), EOp::Equal },
+			{ TEXT("!="), EOp::NotEqual },
+			{ TEXT("<"), EOp::Less },
+			{ TEXT(">"), EOp::Greater },
+		};
+		for (const FOperator& Operator : Operators)
+		{
+			if (Match(Operator.Token))
+			{
+				ParseSum();
+				Emit(Operator.Op, 0, -1);
+				return;
+			}
+		}
+	}
+
+	void ParseSum()
+	{
+		ParseProduct();
+		while (Error.IsEmpty())
+		{
+			if (Match(TEXT("+")))
+			{
+				ParseProduct();
+				Emit(EOp::Add, 0, -1);
+			}
+			else if (Match(TEXT("-")))
+			{
+				ParseProduct();
+				Emit(EOp::Sub, 0, -1);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	void ParseProduct()
+	{
+		ParseUnary();
+		while (Error.IsEmpty())
+		{
+			if (Match(TEXT("*")))
+			{
+				ParseUnary();
+				Emit(EOp::Mul, 0, -1);
+			}
+			else if (Match(TEXT("/")))
+			{
+				ParseUnary();
+				Emit(EOp::Div, 0, -1);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	void ParseUnary()
+	{
+		if (Match(TEXT("-")))
+		{
+			ParseUnary();
+			Emit(EOp::Neg, 0, 0);
+			return;
+		}
+		ParsePrimary();
+	}
+
+	void ParsePrimary()
+	{
+		SkipWhitespace();
+		if (!Error.IsEmpty())
+		{
+			return;
+		}
+		if (Position >= Source.Len())
+		{
+			Fail(TEXT("公式意外结束"));
+			return;
+		}
+
+		if (Match(TEXT("(")))
+		{
+			ParseTernary();
+			Expect(TEXT(")"));
+			return;
+		}
+
+		const TCHAR First = Source[Position];
+		if (FChar::IsDigit(First) || First == TEXT('.'))
+		{
+			const int32 Start = Position;
+			while (Position < Source.Len() && (FChar::IsDigit(Source[Position]) || Source[Position] == TEXT('.')))
+			{
+				++Position;
+			}
+			const int32 ConstantIndex = Program.Constants.Add(FCString::Atod(*Source.Mid(Start, Position - Start)));
+			Emit(EOp::PushConst, ConstantIndex, 1);
+			return;
+		}
+
+		if (FChar::IsAlpha(First) || First == TEXT('_'))
+		{
+			const int32 Start = Position;
+			while (Position < Source.Len() && (FChar::IsAlnum(Source[Position]) || Source[Position] == TEXT('_') || Source[Position] == TEXT('.')))
+			{
+				++Position;
+			}
+			const FString Name = Source.Mid(Start, Position - Start);
+			if (Match(TEXT("(")))
+			{
+				ParseCall(Name);
+				return;
+			}
+
+			int32 VariableIndex = INDEX_NONE;
+			if (!FindFormulaVariable(Name, VariableIndex))
+			{
+				Fail(FString::Printf(TEXT("未知变量 '%s'"), *Name));
+				return;
+			}
+			Emit(EOp::LoadVar, VariableIndex, 1);
+			return;
+		}
+
+		Fail(FString::Printf(TEXT("无法识别的字符 '%c'"), First));
+	}
+
+	void ParseCall(const FString& Name)
+	{
+		struct FFunction
+		{
+			const TCHAR* Name;
+			EOp Op;
+			int32 ArgumentCount;
+		};
+		static const FFunction Functions[] =
+		{
+			{ TEXT("min"), EOp::Min, 2 },
+			{ TEXT("max"), EOp::Max, 2 },
+			{ TEXT("clamp"), EOp::Clamp, 3 },
+			{ TEXT("abs"), EOp::Abs, 1 },
+			{ TEXT("pct"), EOp::Percent, 2 },
+		};
+
+		const FFunction* Function = nullptr;
+		for (const FFunction& Candidate : Functions)
+		{
+			if (Name.Equals(Candidate.Name, ESearchCase::CaseSensitive))
+			{
+				Function = &Candidate;
+				break;
+			}
+		}
+		if (!Function)
+		{
+			Fail(FString::Printf(TEXT("未知函数 '%s'"), *Name));
+			return;
+		}
+
+		for (int32 ArgumentIndex = 0; ArgumentIndex < Function->ArgumentCount && Error.IsEmpty(); ++ArgumentIndex)
+		{
+			if (ArgumentIndex > 0)
+			{
+				Expect(TEXT(","));
+			}
+			ParseTernary();
+		}
+		Expect(TEXT(")"));
+		Emit(Function->Op, 0, 1 - Function->ArgumentCount);
+	}
+
+	const FString& Source;
+	FIndicatorFormulaProgram& Program;
+	int32 Position = 0;
+	int32 Depth = 0;
+	FString Error;
+};
+
+bool FIndicatorFormulaProgram::Compile(const FString& Source, FString& OutError)
+{
+	Code.Reset();
+	Constants.Reset();
+
+	FIndicatorFormulaCompiler Compiler(Source, *this);
+	if (!Compiler.Run(OutError))
+	{
+		Code.Reset();
+		Constants.Reset();
+		return false;
+	}
+	return true;
+}
+
+double FIndicatorFormulaProgram::Execute(const FIndicatorFormulaContext& Context) const
+{
+	// 编译时已保证栈深度不超过 MaxStackDepth
+	double Stack[MaxStackDepth];
+	int32 Top = -1;
+
+	for (const FInstruction& Instruction : Code)
+	{
+		switch (Instruction.Op)
+		{
+		case EOp::PushConst:
+			Stack[++Top] = Constants[Instruction.Operand];
+			break;
+		case EOp::LoadVar:
+			Stack[++Top] = Context.Values[Instruction.Operand];
+			break;
+		case EOp::Neg:
+			Stack[Top] = -Stack[Top];
+			break;
+		case EOp::Abs:
+			Stack[Top] = FMath::Abs(Stack[Top]);
+			break;
+		case EOp::Select:
+			Top -= 2;
+			Stack[Top] = Stack[Top] != 0.0 ? Stack[Top + 1] : Stack[Top + 2];
+			break;
+		case EOp::Clamp:
+			Top -= 2;
+			Stack[Top] = FMath::Clamp(Stack[Top], Stack[Top + 1], Stack[Top + 2]);
+			break;
+		default:
+		{
+			const double Right = Stack[Top--];
+			double& Left = Stack[Top];
+			switch (Instruction.Op)
+			{
+			case EOp::Add: Left = Left + Right; break;
+			case EOp::Sub: Left = Left - Right; break;
+			case EOp::Mul: Left = Left * Right; break;
+			case EOp::Div: Left = SafeDivide(Left, Right); break;
+			case EOp::Less: Left = Left < Right ? 1.0 : 0.0; break;
+			case EOp::LessEqual: Left = Left <= Right ? 1.0 : 0.0; break;
+			case EOp::Greater: Left = Left > Right ? 1.0 : 0.0; break;
+			case EOp::GreaterEqual: Left = Left >= Right ? 1.0 : 0.0; break;
+			case EOp::Equal: Left = Left == Right ? 1.0 : 0.0; break;
+			case EOp::NotEqual: Left = Left != Right ? 1.0 : 0.0; break;
+			case EOp::And: Left = (Left != 0.0 && Right != 0.0) ? 1.0 : 0.0; break;
+			case EOp::Or: Left = (Left != 0.0 || Right != 0.0) ? 1.0 : 0.0; break;
+			case EOp::Min: Left = FMath::Min(Left, Right); break;
+			case EOp::Max: Left = FMath::Max(Left, Right); break;
+			case EOp::Percent: Left = SafeDivide(Left * 100.0, Right); break;
+			default: break;
+			}
+			break;
+		}
+		}
+	}
+
+	return Top >= 0 ? Stack[Top] : 0.0;
+}
+
+TSharedPtr<const FIndicatorFormulaTable, ESPMode::ThreadSafe> FIndicatorFormulaTable::LoadFromFile(const FString& FilePath)
+{
+	FIndicatorCatalog Catalog;
+	if (!FIndicatorDataCache::Load(FilePath, Catalog))
+	{
+		return nullptr;
+	}
+	return Build(Catalog.Data);
+}
+
+TSharedRef<const FIndicatorFormulaTable, ESPMode::ThreadSafe> FIndicatorFormulaTable::Build(const FIndicatorData& Data)
+{
+	TSharedRef<FIndicatorFormulaTable, ESPMode::ThreadSafe> Table = MakeShared<FIndicatorFormulaTable, ESPMode::ThreadSafe>();
+	int32 FailedCount = 0;
+
+	const auto AddIndicator = [&Table, &FailedCount](const FIndicatorInfo& Indicator)
+	{
+		if (Indicator.Formula.IsEmpty() || Table->Entries.Contains(Indicator.Id))
+		{
+			return;
+		}
+
+		FIndicatorFormulaEntry Entry;
+		FString Error;
+		if (!Entry.Program.Compile(Indicator.Formula, Error))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("IndicatorFormula: 指标 %s 的公式无效：%s"), *Indicator.Id, *Error);
+			++FailedCount;
+			return;
+		}
+		Entry.TargetValue = Indicator.TargetValue;
+		Entry.bHigherIsBetter = Indicator.bHigherIsBetter;
+		Entry.bRecordBased = Indicator.bRecordBased;
+		Entry.Unit = Indicator.Unit;
+		Entry.Remark = Indicator.EvaluationRemark;
+		Table->Entries.Add(Indicator.Id, MoveTemp(Entry));
+	};
+
+	for (const FIndicatorCategory& Category : Data.Categories)
+	{
+		for (const FIndicatorSubCategory& SubCategory : Category.SubCategories)
+		{
+			for (const FIndicatorInfo& Indicator : SubCategory.Indicators)
+			{
+				AddIndicator(Indicator);
+			}
+		}
+	}
+	for (const FIndicatorInfo& Indicator : Data.EvaluationOnlyIndicators)
+	{
+		AddIndicator(Indicator);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("IndicatorFormula: compiled %d indicator formulas (%d failed)"), Table->Entries.Num(), FailedCount);
+	return Table;
+}
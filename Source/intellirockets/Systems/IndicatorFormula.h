@@ -0,0 +1,174 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/ScenarioTestMetrics.h"
+
+struct FIndicatorData;
+
+/**
+ * 指标公式中可引用的变量：会话汇总、逐发记录聚合与感知统计。
+ * 名称见 IndicatorFormula.cpp 中的变量表（如 hitRate、autoHitRate、perception.falsePositives）。
+ */
+enum class EIndicatorFormulaVariable : uint8
+{
+	// 会话汇总（FMissileTestSummary）
+	TotalShots,
+	ManualShots,
+	AutoShots,
+	Hits,
+	DirectHits,
+	AoEHits,
+	Misses,
+	HitRate,
+	DirectHitRate,
+	AverageFlightTime,
+	AverageLaunchDistance,
+	AverageDestroyedPerHit,
+	AverageAutoLaunchInterval,
+	SessionDuration,
+	HLSplitAttempts,
+	HLSplitSuccesses,
+	HLSplitChildShots,
+	HLSplitChildHits,
+	HLSplitGroups,
+	HLSplitGroupUniqueTargets,
+	CountermeasureDetectionMargin,
+	CountermeasureActivationDelay,
+	CountermeasureOnTimeRate,
+	CountermeasureActivationDistance,
+	CountermeasureActivationHeightDiff,
+	CountermeasureSuppressionRate,
+	CountermeasureRadiusReductionRate,
+	CountermeasureCoverageRate,
+	CountermeasureDuration,
+	CountermeasureResourceCostScore,
+
+	// 逐发记录聚合
+	AutoRecordShots,
+	AutoHits,
+	AutoHitRate,
+	AutoFireRatio,
+	AutoFlightTime,
+	AutoFlightSamples,
+
+	// 感知统计（FPerceptionRuntimeStats）
+	PerceptionCorrect,
+	PerceptionFalsePositives,
+	PerceptionFalseNegatives,
+	PerceptionRecognitionTime,
+	PerceptionRecognitionSamples,
+	PerceptionLightTotal,
+	PerceptionLightCorrect,
+	PerceptionWeatherTotal,
+	PerceptionWeatherCorrect,
+	PerceptionMaxTracks,
+	PerceptionTrackingError,
+	PerceptionTrackingSamples,
+	PerceptionJamLightTotal,
+	PerceptionJamLightCorrect,
+	PerceptionJamMediumTotal,
+	PerceptionJamMediumCorrect,
+	PerceptionInterferenceTotal,
+	PerceptionInterferenceCorrect,
+	PerceptionFrequencyAdjustTotal,
+	PerceptionFrequencyAdjustSuccess,
+	PerceptionRecoveryTime,
+	PerceptionRecoverySamples,
+	PerceptionKeypartTotal,
+	PerceptionKeypartCorrect,
+	PerceptionHeatTrackError,
+	PerceptionHeatTrackSamples,
+
+	Count
+};
+
+/** 一次指标计算的变量取值，每次 EvaluateIndicators 绑定一次，所有公式共用 */
+struct FIndicatorFormulaContext
+{
+	double Values[static_cast<int32>(EIndicatorFormulaVariable::Count)] = {};
+
+	void Bind(const FMissileTestSummary& Summary, const FPerceptionRuntimeStats& Perception, TConstArrayView<const FMissileTestRecord*> Records);
+};
+
+/**
+ * 编译后的指标公式（栈式字节码）。
+ *
+ * 语法：数字、变量、+ - * /、比较（< <= > >= == !=）、&& ||、三元 c ? a : b、括号，
+ * 函数 min(a, b)、max(a, b)、clamp(x, lo, hi)、abs(x)、pct(a, b)（= a * 100 / b）。
+ * 除数为 0 时结果为 0（与原先各指标“无样本记 0”的写法一致）；三元两侧都会求值，公式无副作用。
+ */
+class FIndicatorFormulaProgram
+{
+public:
+	static constexpr int32 MaxStackDepth = 32;
+
+	bool Compile(const FString& Source, FString& OutError);
+	double Execute(const FIndicatorFormulaContext& Context) const;
+
+	bool IsValid() const { return Code.Num() > 0; }
+
+private:
+	enum class EOp : uint8
+	{
+		PushConst,
+		LoadVar,
+		Add,
+		Sub,
+		Mul,
+		Div,
+		Neg,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		And,
+		Or,
+		Select,
+		Min,
+		Max,
+		Clamp,
+		Abs,
+		Percent,
+	};
+
+	struct FInstruction
+	{
+		EOp Op = EOp::PushConst;
+		int32 Operand = 0; // PushConst：常量下标；LoadVar：变量下标
+	};
+
+	friend class FIndicatorFormulaCompiler;
+
+	TArray<FInstruction> Code;
+	TArray<double> Constants;
+};
+
+/** 单个指标的求值定义（来自 DecisionIndicators.json 的 formula / targetValue / higherIsBetter / unit / evaluationRemark） */
+struct FIndicatorFormulaEntry
+{
+	FIndicatorFormulaProgram Program;
+	float TargetValue = 0.f;
+	bool bHigherIsBetter = true;
+	bool bRecordBased = true;
+	FString Unit;
+	FString Remark;
+};
+
+/**
+ * 指标 Id -> 已编译公式表。加载时一次性编译，之后只读，可在后台线程（置信区间、环境敏感性）并发查询。
+ * 同一 Id 出现多次时以第一次为准；公式编译失败的指标记录警告并视为未实现。
+ */
+class FIndicatorFormulaTable
+{
+public:
+	static TSharedPtr<const FIndicatorFormulaTable, ESPMode::ThreadSafe> LoadFromFile(const FString& FilePath);
+	static TSharedRef<const FIndicatorFormulaTable, ESPMode::ThreadSafe> Build(const FIndicatorData& Data);
+
+	const FIndicatorFormulaEntry* Find(const FString& IndicatorId) const { return Entries.Find(IndicatorId); }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	TMap<FString, FIndicatorFormulaEntry> Entries;
+};
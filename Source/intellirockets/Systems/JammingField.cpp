@@ -0,0 +1,299 @@
+#include "Systems/JammingField.h"
+
+#include "Actors/RadarJammerActor.h"
+#include "Systems/ScenarioPerformanceRecorder.h"
+#include "Async/ParallelFor.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarJammingField(
+		TEXT("ir.Jamming.Field"),
+		0,
+		TEXT("1: 生成干扰器时烘焙干扰场，导弹按干信比分级受扰（进入判定与导引头作用距离）；0: 使用二值半球判定"));
+
+	TAutoConsoleVariable<float> CVarJammingCellSize(
+		TEXT("ir.Jamming.CellSize"),
+		1000.f,
+		TEXT("干扰场体素边长（厘米）；在干扰场清空后（下一次生成干扰器时）生效"));
+
+	TAutoConsoleVariable<float> CVarJammingRangeMultiplier(
+		TEXT("ir.Jamming.RangeMultiplier"),
+		2.5f,
+		TEXT("干扰场作用范围 = BaseRadius * 该值；默认与干扰器的检测半径（BaseRadius * 2.5）一致"));
+
+	TAutoConsoleVariable<int32> CVarJammingTerrainMasking(
+		TEXT("ir.Jamming.TerrainMasking"),
+		1,
+		TEXT("1: 烘焙时检测干扰器到体素的地形遮挡；0: 不检测"));
+
+	TAutoConsoleVariable<float> CVarJammingTerrainMaskFactor(
+		TEXT("ir.Jamming.TerrainMaskFactor"),
+		0.1f,
+		TEXT("被地形遮挡的体素的干信比衰减系数"));
+
+	constexpr float MaxJammingRatio = 100.f;
+	constexpr float MaskTraceStartHeight = 300.f; // 遮挡射线起点抬高，避免从干扰器所在单位内部出发
+	constexpr float VerifyTolerance = 0.25f; // 贴地探测点插值结果与解析值允许的相对偏差
+
+	/** 干扰只覆盖上方半球：低于干扰器的点按半球底面高度取值 */
+	FVector ClampToHemisphere(const FVector& Point, const FVector& Center)
+	{
+		return FVector(Point.X, Point.Y, FMath::Max(Point.Z, Center.Z));
+	}
+
+	float ComputeJammingRatio(const FVector& Point, const FVector& Center, float BaseRadius, float MinDistance)
+	{
+		const float Distance = FMath::Max(FVector::Dist(Point, Center), MinDistance);
+		return FMath::Min(FMath::Square(BaseRadius / Distance), MaxJammingRatio);
+	}
+
+	/** 烘焙校验点：干扰器水平方向半个基础半径处、半球底面高度（解析值为 4） */
+	FVector MakeVerifyProbe(const FVector& Center, float BaseRadius)
+	{
+		return Center + FVector(BaseRadius * 0.5f, 0.f, 0.f);
+	}
+}
+
+bool FJammingField::IsEnabled()
+{
+	return CVarJammingField.GetValueOnGameThread() > 0;
+}
+
+void FJammingField::AddJammer(UWorld* World, const ARadarJammerActor* Jammer, const TArray<AActor*>& IgnoredActors)
+{
+	if (!World || !Jammer)
+	{
+		return;
+	}
+
+	const TObjectKey<ARadarJammerActor> Key(Jammer);
+	if (Sources.Contains(Key))
+	{
+		return;
+	}
+
+	if (CellSize <= 0.f)
+	{
+		CellSize = FMath::Max(100.f, CVarJammingCellSize.GetValueOnGameThread());
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	TArray<TPair<FIntVector, float>> Contributions;
+	ComputeContributions(World, Jammer, IgnoredActors, Contributions);
+
+	FSource& Source = Sources.Add(Key);
+	Source.Jammer = Jammer;
+	Source.Center = Jammer->GetActorLocation();
+	Source.BaseRadius = Jammer->GetBaseRadius();
+	Source.Range = Source.BaseRadius * FMath::Max(1.f, CVarJammingRangeMultiplier.GetValueOnGameThread());
+	Source.Voxels.Reserve(Contributions.Num());
+	for (const TPair<FIntVector, float>& Contribution : Contributions)
+	{
+		Source.Voxels.Add(Contribution.Key, Contribution.Value);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("JammingField: baked %s (radius %.0f) into %d voxels in %.2f ms (total voxels=%d)"),
+		*Jammer->GetName(), Source.BaseRadius, Contributions.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0, GetVoxelCount());
+}
+
+void FJammingField::Reset()
+{
+	Sources.Reset();
+	CellSize = 0.f;
+}
+
+int32 FJammingField::GetVoxelCount() const
+{
+	int32 Count = 0;
+	for (const TPair<TObjectKey<ARadarJammerActor>, FSource>& Pair : Sources)
+	{
+		Count += Pair.Value.Voxels.Num();
+	}
+	return Count;
+}
+
+void FJammingField::ComputeContributions(UWorld* World, const ARadarJammerActor* Jammer, const TArray<AActor*>& IgnoredActors, TArray<TPair<FIntVector, float>>& OutContributions) const
+{
+	OutContributions.Reset();
+
+	const FVector Center = Jammer->GetActorLocation();
+	const float BaseRadius = Jammer->GetBaseRadius();
+	const float Range = BaseRadius * FMath::Max(1.f, CVarJammingRangeMultiplier.GetValueOnGameThread());
+	const float RangeSq = FMath::Square(Range);
+
+	// 收集作用范围内、干扰器上方半球中的体素角点；最底层角点低于半球底面，按底面高度计入
+	const FIntVector MinCorner(
+		FMath::FloorToInt((Center.X - Range) / CellSize),
+		FMath::FloorToInt((Center.Y - Range) / CellSize),
+		FMath::FloorToInt(Center.Z / CellSize));
+	const FIntVector MaxCorner(
+		FMath::CeilToInt((Center.X + Range) / CellSize),
+		FMath::CeilToInt((Center.Y + Range) / CellSize),
+		FMath::CeilToInt((Center.Z + Range) / CellSize));
+
+	TArray<FIntVector> Corners;
+	for (int32 Z = MinCorner.Z; Z <= MaxCorner.Z; ++Z)
+	{
+		for (int32 Y = MinCorner.Y; Y <= MaxCorner.Y; ++Y)
+		{
+			for (int32 X = MinCorner.X; X <= MaxCorner.X; ++X)
+			{
+				if (FVector::DistSquared(ClampToHemisphere(FVector(X, Y, Z) * CellSize, Center), Center) <= RangeSq)
+				{
+					Corners.Emplace(X, Y, Z);
+				}
+			}
+		}
+	}
+
+	const bool bTerrainMasking = CVarJammingTerrainMasking.GetValueOnGameThread() > 0;
+	const float MaskFactor = FMath::Clamp(CVarJammingTerrainMaskFactor.GetValueOnGameThread(), 0.f, 1.f);
+	FCollisionQueryParams Params(NAME_None, /*bTraceComplex*/ false);
+	Params.AddIgnoredActor(Jammer);
+	Params.AddIgnoredActors(IgnoredActors);
+	const FVector TraceStart = Center + FVector(0.f, 0.f, MaskTraceStartHeight);
+	const float MinDistance = CellSize * 0.5f;
+
+	TArray<float> Values;
+	Values.SetNumZeroed(Corners.Num());
+	ParallelFor(Corners.Num(), [&](int32 Index)
+	{
+		const FVector Point = ClampToHemisphere(FVector(Corners[Index]) * CellSize, Center);
+		float Ratio = ComputeJammingRatio(Point, Center, BaseRadius, MinDistance);
+
+		FHitResult Hit;
+		if (bTerrainMasking && World->LineTraceSingleByChannel(Hit, TraceStart, Point, ECC_Visibility, Params))
+		{
+			Ratio *= MaskFactor;
+		}
+		Values[Index] = Ratio;
+	});
+
+	if (bTerrainMasking)
+	{
+		FScenarioPerformanceRecorder::NoteTraces(Corners.Num());
+	}
+
+	OutContributions.Reserve(Corners.Num());
+	for (int32 Index = 0; Index < Corners.Num(); ++Index)
+	{
+		if (Values[Index] > KINDA_SMALL_NUMBER)
+		{
+			OutContributions.Emplace(Corners[Index], Values[Index]);
+		}
+	}
+}
+
+int32 FJammingField::Verify(UWorld* World, const TArray<AActor*>& IgnoredActors) const
+{
+	if (!World)
+	{
+		return 0;
+	}
+
+	const bool bTerrainMasking = CVarJammingTerrainMasking.GetValueOnGameThread() > 0;
+	int32 NumFailed = 0;
+	for (const TPair<TObjectKey<ARadarJammerActor>, FSource>& Pair : Sources)
+	{
+		const FSource& Source = Pair.Value;
+		const ARadarJammerActor* Jammer = Source.Jammer.Get();
+		if (!Jammer)
+		{
+			continue;
+		}
+
+		const FVector Probe = MakeVerifyProbe(Source.Center, Source.BaseRadius);
+		if (bTerrainMasking)
+		{
+			// 探测点本身被遮挡时周围角点的遮挡情况不一致，插值与解析值不可比
+			FCollisionQueryParams Params(NAME_None, /*bTraceComplex*/ false);
+			Params.AddIgnoredActor(Jammer);
+			Params.AddIgnoredActors(IgnoredActors);
+			FHitResult Hit;
+			FScenarioPerformanceRecorder::NoteTraces();
+			if (World->LineTraceSingleByChannel(Hit, Source.Center + FVector(0.f, 0.f, MaskTraceStartHeight), Probe, ECC_Visibility, Params))
+			{
+				UE_LOG(LogTemp, Log, TEXT("JammingField: %s verify probe is terrain-masked, skipped"), *Jammer->GetName());
+				continue;
+			}
+		}
+
+		// 按基础半径比较，与反制造成的当前半径收缩无关
+		const float Baked = SampleSource(Source, Probe);
+		const float Expected = ComputeJammingRatio(Probe, Source.Center, Source.BaseRadius, CellSize * 0.5f);
+		const float RelativeError = FMath::Abs(Baked - Expected) / FMath::Max(Expected, KINDA_SMALL_NUMBER);
+		if (RelativeError > VerifyTolerance)
+		{
+			++NumFailed;
+			UE_LOG(LogTemp, Warning, TEXT("JammingField: %s near-ground J/S %.3f differs from analytic %.3f by %.0f%% (cell size %.0f too coarse for radius %.0f?)"),
+				*Jammer->GetName(), Baked, Expected, RelativeError * 100.f, CellSize, Source.BaseRadius);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("JammingField: %s near-ground J/S %.3f vs analytic %.3f (%.0f%%)"),
+				*Jammer->GetName(), Baked, Expected, RelativeError * 100.f);
+		}
+	}
+	return NumFailed;
+}
+
+float FJammingField::Sample(const FVector& Location) const
+{
+	if (Sources.Num() == 0 || CellSize <= 0.f)
+	{
+		return 0.f;
+	}
+
+	float Total = 0.f;
+	for (const TPair<TObjectKey<ARadarJammerActor>, FSource>& Pair : Sources)
+	{
+		const FSource& Source = Pair.Value;
+		// 体素只覆盖作用范围（含插值所需的一圈角点），范围外直接跳过
+		if (FVector::DistSquared(Location, Source.Center) > FMath::Square(Source.Range + CellSize * 2.f))
+		{
+			continue;
+		}
+
+		const ARadarJammerActor* Jammer = Source.Jammer.Get();
+		if (!Jammer || Source.BaseRadius <= 0.f)
+		{
+			continue;
+		}
+
+		const float Scale = FMath::Square(Jammer->GetJammerRadius() / Source.BaseRadius);
+		if (Scale > 0.f)
+		{
+			Total += SampleSource(Source, Location) * Scale;
+		}
+	}
+	return Total;
+}
+
+float FJammingField::SampleSource(const FSource& Source, const FVector& Location) const
+{
+	const FVector Cell = Location / CellSize;
+	const FIntVector Base(FMath::FloorToInt(Cell.X), FMath::FloorToInt(Cell.Y), FMath::FloorToInt(Cell.Z));
+	const FVector Frac = Cell - FVector(Base);
+
+	float Corners[8];
+	bool bAnyCorner = false;
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const float* Value = Source.Voxels.Find(Base + FIntVector(Corner & 1, (Corner >> 1) & 1, Corner >> 2));
+		Corners[Corner] = Value ? *Value : 0.f;
+		bAnyCorner |= Value != nullptr;
+	}
+	if (!bAnyCorner)
+	{
+		return 0.f;
+	}
+
+	const float Z0 = FMath::BiLerp(Corners[0], Corners[1], Corners[2], Corners[3], Frac.X, Frac.Y);
+	const float Z1 = FMath::BiLerp(Corners[4], Corners[5], Corners[6], Corners[7], Frac.X, Frac.Y);
+	return FMath::Lerp(Z0, Z1, Frac.Z);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class ARadarJammerActor;
+class UWorld;
+
+/**
+ * 电磁干扰场：把每个干扰器的干信比（J/S）预先烘焙到稀疏体素网格中，导弹每帧只做一次三线性插值查询。
+ *
+ * - 单个干扰器的贡献按基础半径烘焙为 (BaseRadius / 距离)^2，在 BaseRadius 处为 1，超出 BaseRadius * ir.Jamming.RangeMultiplier 后为 0；
+ *   与 IsPointInJammerRange 一致只覆盖干扰器上方的半球，半球底面以下的最底层角点按底面高度取值，保证贴地插值不被低估。
+ * - 干扰器到体素之间被地形遮挡时贡献乘以 ir.Jamming.TerrainMaskFactor（遮挡射线在烘焙时并行执行）。
+ * - 每个干扰器单独保存体素，查询时乘以 (当前半径 / BaseRadius)^2 后叠加：反制导致干扰半径收缩时，
+ *   干信比为 1 的等值面随当前半径移动，与二值半球判定一致，且无需重新烘焙。
+ * - 体素以网格角点为键（ir.Jamming.CellSize），不存在的角点视为 0。
+ */
+class FJammingField
+{
+public:
+	/** ir.Jamming.Field：为 0 时不烘焙干扰场，导弹沿用二值半球判定 */
+	static bool IsEnabled();
+
+	/** 生成干扰器后调用，烘焙其贡献；已烘焙过的干扰器直接返回。IgnoredActors 不参与地形遮挡检测 */
+	void AddJammer(UWorld* World, const ARadarJammerActor* Jammer, const TArray<AActor*>& IgnoredActors);
+
+	void Reset();
+
+	/** 三线性插值得到 Location 处的干信比；没有干扰时为 0 */
+	float Sample(const FVector& Location) const;
+
+	/**
+	 * 校验烘焙精度（ir.Jamming.Verify）：在每个干扰器附近贴地取一点，比较插值结果与解析值，
+	 * 偏差过大时记录警告。返回偏差超限的干扰器数量。
+	 */
+	int32 Verify(UWorld* World, const TArray<AActor*>& IgnoredActors) const;
+
+	bool IsEmpty() const { return Sources.Num() == 0; }
+	int32 GetVoxelCount() const;
+
+private:
+	/** 单个干扰器按基础半径烘焙的体素 */
+	struct FSource
+	{
+		TWeakObjectPtr<const ARadarJammerActor> Jammer;
+		FVector Center = FVector::ZeroVector;
+		float BaseRadius = 0.f;
+		float Range = 0.f;
+		TMap<FIntVector, float> Voxels;
+	};
+
+	void ComputeContributions(UWorld* World, const ARadarJammerActor* Jammer, const TArray<AActor*>& IgnoredActors, TArray<TPair<FIntVector, float>>& OutContributions) const;
+	float SampleSource(const FSource& Source, const FVector& Location) const;
+
+	float CellSize = 0.f;
+	TMap<TObjectKey<ARadarJammerActor>, FSource> Sources;
+};
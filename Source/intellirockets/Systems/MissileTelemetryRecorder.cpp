@@ -0,0 +1,495 @@
+#include "Systems/MissileTelemetryRecorder.h"
+
+#include "Actors/MockMissileActor.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarTelemetrySampleRate(
+		TEXT("ir.Telemetry.SampleRate"),
+		0.f,
+		TEXT("导弹遥测采样频率（Hz，按世界时间）；0 关闭遥测记录"));
+
+	TAutoConsoleVariable<int32> CVarTelemetryMaxSamplesPerMissile(
+		TEXT("ir.Telemetry.MaxSamplesPerMissile"),
+		1024,
+		TEXT("单枚导弹保留的样本上限，达到后用 Douglas-Peucker 压缩到一半"));
+
+	TAutoConsoleVariable<float> CVarTelemetryErrorBound(
+		TEXT("ir.Telemetry.ErrorBound"),
+		50.f,
+		TEXT("轨迹压缩允许的位置误差（厘米）"));
+
+	TAutoConsoleVariable<int32> CVarTelemetryMemoryBudgetMB(
+		TEXT("ir.Telemetry.MemoryBudgetMB"),
+		64,
+		TEXT("遥测数据内存预算（MB），超出后压缩并淘汰最旧的已结束轨迹"));
+
+	TAutoConsoleVariable<int32> CVarTelemetryExport(
+		TEXT("ir.Telemetry.Export"),
+		1,
+		TEXT("1: 测试结束时把遥测数据导出到 Saved/Telemetry"));
+
+	// 超出预算时已结束轨迹压缩到的关键点数量
+	constexpr int32 BudgetCompactedSamples = 32;
+	constexpr int32 MaxCompactionAttempts = 16;
+
+	constexpr uint32 TelemetryFileMagic = 0x4D545249; // "IRTM"
+	constexpr uint32 TelemetryFileVersion = 2; // 2: 新增 TargetKind 列
+
+	template <typename T>
+	void CompactColumn(TArray<T>& Column, const TBitArray<>& Keep)
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < Column.Num(); ++ReadIndex)
+		{
+			if (Keep[ReadIndex])
+			{
+				Column[WriteIndex++] = Column[ReadIndex];
+			}
+		}
+		Column.SetNum(WriteIndex, EAllowShrinking::No);
+	}
+
+	template <typename T>
+	void WriteColumn(FArchive& Ar, const TArray<T>& Column)
+	{
+		Ar.Serialize(const_cast<T*>(Column.GetData()), Column.Num() * sizeof(T));
+	}
+}
+
+void FMissileTelemetryRecorder::FTrack::RemoveUnflagged(const TBitArray<>& Keep)
+{
+	CompactColumn(Time, Keep);
+	CompactColumn(Position, Keep);
+	CompactColumn(Velocity, Keep);
+	CompactColumn(State, Keep);
+	CompactColumn(JammerDistance, Keep);
+	CompactColumn(TargetKind, Keep);
+	CompactColumn(TargetId, Keep);
+}
+
+void FMissileTelemetryRecorder::FTrack::Shrink()
+{
+	Time.Shrink();
+	Position.Shrink();
+	Velocity.Shrink();
+	State.Shrink();
+	JammerDistance.Shrink();
+	TargetKind.Shrink();
+	TargetId.Shrink();
+}
+
+int64 FMissileTelemetryRecorder::FTrack::GetAllocatedSize() const
+{
+	return Time.GetAllocatedSize() + Position.GetAllocatedSize() + Velocity.GetAllocatedSize()
+		+ State.GetAllocatedSize() + JammerDistance.GetAllocatedSize()
+		+ TargetKind.GetAllocatedSize() + TargetId.GetAllocatedSize()
+		+ Name.GetAllocatedSize() + sizeof(FTrack);
+}
+
+FMissileTelemetryRecorder::~FMissileTelemetryRecorder()
+{
+	Stop();
+}
+
+bool FMissileTelemetryRecorder::IsEnabled()
+{
+	return CVarTelemetrySampleRate.GetValueOnGameThread() > 0.f;
+}
+
+float FMissileTelemetryRecorder::GetSampleRate() const
+{
+	return CVarTelemetrySampleRate.GetValueOnGameThread();
+}
+
+void FMissileTelemetryRecorder::Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles)
+{
+	Reset();
+	if (!World || !InCollectMissiles)
+	{
+		return;
+	}
+
+	WorldWeak = World;
+	CollectMissiles = MoveTemp(InCollectMissiles);
+	StartWorldSeconds = World->GetTimeSeconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMissileTelemetryRecorder::HandleTick));
+}
+
+void FMissileTelemetryRecorder::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	for (FTrack& Track : Tracks)
+	{
+		Track.bFinished = true;
+	}
+	TrackLookup.Reset();
+}
+
+void FMissileTelemetryRecorder::Reset()
+{
+	Stop();
+	Tracks.Reset();
+	TrackLookup.Reset();
+	CollectMissiles = nullptr;
+	WorldWeak = nullptr;
+	StartWorldSeconds = 0.0;
+	LastSampleWorldSeconds = -1.0;
+	TotalSamples = 0;
+	SampleTick = 0;
+	EvictedTrackCount = 0;
+	bBudgetWarningLogged = false;
+}
+
+bool FMissileTelemetryRecorder::HandleTick(float DeltaTime)
+{
+	UWorld* World = WorldWeak.Get();
+	const float SampleRate = GetSampleRate();
+	if (!World || SampleRate <= 0.f)
+	{
+		return true;
+	}
+
+	// 按世界时间采样，暂停或时间膨胀时样本间隔保持一致
+	const double WorldSeconds = World->GetTimeSeconds();
+	if (LastSampleWorldSeconds >= 0.0 && WorldSeconds - LastSampleWorldSeconds < 1.0 / SampleRate)
+	{
+		return true;
+	}
+	LastSampleWorldSeconds = WorldSeconds;
+	++SampleTick;
+
+	TArray<AMockMissileActor*> Missiles;
+	CollectMissiles(Missiles);
+
+	const float Seconds = static_cast<float>(WorldSeconds - StartWorldSeconds);
+	const int32 MaxSamples = FMath::Max(16, CVarTelemetryMaxSamplesPerMissile.GetValueOnGameThread());
+	const float ErrorBound = CVarTelemetryErrorBound.GetValueOnGameThread();
+	for (AMockMissileActor* Missile : Missiles)
+	{
+		if (!Missile || Missile->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		const TObjectKey<AMockMissileActor> MissileKey(Missile);
+		int32 TrackIndex = INDEX_NONE;
+		if (const int32* Found = TrackLookup.Find(MissileKey))
+		{
+			TrackIndex = *Found;
+		}
+		else
+		{
+			TrackIndex = Tracks.AddDefaulted();
+			FTrack& NewTrack = Tracks[TrackIndex];
+			NewTrack.MissileKey = MissileKey;
+			NewTrack.MissileId = Missile->GetSessionSerial();
+			NewTrack.Name = Missile->GetName();
+			NewTrack.bInterceptor = Missile->IsInterceptor();
+			TrackLookup.Add(MissileKey, TrackIndex);
+		}
+
+		FTrack& Track = Tracks[TrackIndex];
+		FMissileTelemetrySample Sample;
+		Missile->GetTelemetrySample(Sample);
+		AppendSample(Track, Sample, Seconds);
+		Track.LastSeenTick = SampleTick;
+
+		if (Track.Num() >= MaxSamples)
+		{
+			TotalSamples -= CompactTrack(Track, MaxSamples / 2, ErrorBound);
+		}
+	}
+
+	// 本次采样未出现的导弹视为已结束
+	for (FTrack& Track : Tracks)
+	{
+		if (!Track.bFinished && Track.LastSeenTick != SampleTick)
+		{
+			Track.bFinished = true;
+			TrackLookup.Remove(Track.MissileKey);
+		}
+	}
+
+	EnforceMemoryBudget();
+	return true;
+}
+
+void FMissileTelemetryRecorder::AppendSample(FTrack& Track, const FMissileTelemetrySample& Sample, float Seconds)
+{
+	const FVector3f Position(Sample.Location);
+	FVector3f Velocity = FVector3f::ZeroVector;
+	if (Track.Num() > 0)
+	{
+		const float DeltaSeconds = Seconds - Track.Time.Last();
+		if (DeltaSeconds > KINDA_SMALL_NUMBER)
+		{
+			Velocity = (Position - Track.Position.Last()) / DeltaSeconds;
+		}
+	}
+
+	Track.Time.Add(Seconds);
+	Track.Position.Add(Position);
+	Track.Velocity.Add(Velocity);
+	Track.State.Add(static_cast<uint8>(Sample.State));
+	Track.JammerDistance.Add(Sample.NearestJammerDistance);
+	Track.TargetKind.Add(static_cast<uint8>(Sample.TargetKind));
+	Track.TargetId.Add(Sample.TargetId);
+	++TotalSamples;
+}
+
+int32 FMissileTelemetryRecorder::CompactTrack(FTrack& Track, int32 MaxSamples, float ErrorBound)
+{
+	const int32 Count = Track.Num();
+	if (Count <= FMath::Max(2, MaxSamples))
+	{
+		return 0;
+	}
+
+	// 状态或目标发生变化的样本（及其前一个样本）作为锚点始终保留
+	TArray<int32> Anchors;
+	Anchors.Add(0);
+	for (int32 Index = 1; Index < Count - 1; ++Index)
+	{
+		if (Track.State[Index] != Track.State[Index - 1] || Track.TargetId[Index] != Track.TargetId[Index - 1]
+			|| Track.TargetKind[Index] != Track.TargetKind[Index - 1])
+		{
+			if (Anchors.Last() != Index - 1)
+			{
+				Anchors.Add(Index - 1);
+			}
+			Anchors.Add(Index);
+		}
+	}
+	if (Anchors.Last() != Count - 1)
+	{
+		Anchors.Add(Count - 1);
+	}
+
+	TBitArray<> Keep;
+	TArray<TPair<int32, int32>> Segments;
+	float Epsilon = FMath::Max(ErrorBound, 1.f);
+	int32 KeptCount = Count;
+	for (int32 Attempt = 0; Attempt < MaxCompactionAttempts; ++Attempt)
+	{
+		Keep.Init(false, Count);
+		Segments.Reset();
+		for (int32 AnchorIndex = 0; AnchorIndex < Anchors.Num(); ++AnchorIndex)
+		{
+			Keep[Anchors[AnchorIndex]] = true;
+			if (AnchorIndex > 0)
+			{
+				Segments.Emplace(Anchors[AnchorIndex - 1], Anchors[AnchorIndex]);
+			}
+		}
+
+		// 迭代式 Douglas-Peucker
+		while (Segments.Num() > 0)
+		{
+			const TPair<int32, int32> Segment = Segments.Pop(EAllowShrinking::No);
+			if (Segment.Value - Segment.Key < 2)
+			{
+				continue;
+			}
+
+			const FVector Start(Track.Position[Segment.Key]);
+			const FVector End(Track.Position[Segment.Value]);
+			int32 FarthestIndex = INDEX_NONE;
+			float FarthestDistance = Epsilon;
+			for (int32 Index = Segment.Key + 1; Index < Segment.Value; ++Index)
+			{
+				const float Distance = FMath::PointDistToSegment(FVector(Track.Position[Index]), Start, End);
+				if (Distance > FarthestDistance)
+				{
+					FarthestDistance = Distance;
+					FarthestIndex = Index;
+				}
+			}
+
+			if (FarthestIndex != INDEX_NONE)
+			{
+				Keep[FarthestIndex] = true;
+				Segments.Emplace(Segment.Key, FarthestIndex);
+				Segments.Emplace(FarthestIndex, Segment.Value);
+			}
+		}
+
+		KeptCount = Keep.CountSetBits();
+		if (KeptCount <= MaxSamples)
+		{
+			break;
+		}
+		Epsilon *= 2.f;
+	}
+
+	Track.RemoveUnflagged(Keep);
+	return Count - KeptCount;
+}
+
+void FMissileTelemetryRecorder::EnforceMemoryBudget()
+{
+	const int64 BudgetBytes = static_cast<int64>(FMath::Max(1, CVarTelemetryMemoryBudgetMB.GetValueOnGameThread())) * 1024 * 1024;
+	int64 UsedBytes = GetMemoryBytes();
+	if (UsedBytes <= BudgetBytes)
+	{
+		return;
+	}
+
+	// 1. 已结束的轨迹从旧到新压缩到少量关键点
+	const float ErrorBound = CVarTelemetryErrorBound.GetValueOnGameThread();
+	for (FTrack& Track : Tracks)
+	{
+		if (UsedBytes <= BudgetBytes)
+		{
+			return;
+		}
+		if (!Track.bFinished || Track.bBudgetCompacted)
+		{
+			continue;
+		}
+
+		const int64 BeforeBytes = Track.GetAllocatedSize();
+		TotalSamples -= CompactTrack(Track, BudgetCompactedSamples, ErrorBound * 4.f);
+		Track.Shrink();
+		Track.bBudgetCompacted = true;
+		UsedBytes -= BeforeBytes - Track.GetAllocatedSize();
+	}
+
+	// 2. 仍超出预算时淘汰最旧的已结束轨迹
+	int32 EvictCount = 0;
+	for (int32 Index = 0; Index < Tracks.Num() && UsedBytes > BudgetBytes; ++Index)
+	{
+		if (!Tracks[Index].bFinished)
+		{
+			continue;
+		}
+		UsedBytes -= Tracks[Index].GetAllocatedSize();
+		TotalSamples -= Tracks[Index].Num();
+		Tracks[Index].MissileId = 0; // 标记淘汰
+		++EvictCount;
+	}
+
+	if (EvictCount > 0)
+	{
+		Tracks.RemoveAll([](const FTrack& Track)
+		{
+			return Track.MissileId == 0;
+		});
+		EvictedTrackCount += EvictCount;
+		RebuildTrackLookup();
+	}
+
+	if (UsedBytes > BudgetBytes && !bBudgetWarningLogged)
+	{
+		bBudgetWarningLogged = true;
+		UE_LOG(LogTemp, Warning, TEXT("MissileTelemetry: 在飞导弹轨迹已超出内存预算（%.1f MB），请调低 ir.Telemetry.MaxSamplesPerMissile 或采样频率"),
+			UsedBytes / (1024.0 * 1024.0));
+	}
+}
+
+void FMissileTelemetryRecorder::RebuildTrackLookup()
+{
+	TrackLookup.Reset();
+	for (int32 Index = 0; Index < Tracks.Num(); ++Index)
+	{
+		if (!Tracks[Index].bFinished)
+		{
+			TrackLookup.Add(Tracks[Index].MissileKey, Index);
+		}
+	}
+}
+
+int64 FMissileTelemetryRecorder::GetMemoryBytes() const
+{
+	int64 Bytes = Tracks.GetAllocatedSize() + TrackLookup.GetAllocatedSize();
+	for (const FTrack& Track : Tracks)
+	{
+		Bytes += Track.GetAllocatedSize() - sizeof(FTrack);
+	}
+	return Bytes;
+}
+
+void FMissileTelemetryRecorder::ForEachTrack(TFunctionRef<void(const FMissileTelemetryTrackView&)> Visitor) const
+{
+	for (const FTrack& Track : Tracks)
+	{
+		FMissileTelemetryTrackView View;
+		View.MissileId = Track.MissileId;
+		View.Name = Track.Name;
+		View.bInterceptor = Track.bInterceptor;
+		View.bFinished = Track.bFinished;
+		View.Time = Track.Time;
+		View.Position = Track.Position;
+		View.Velocity = Track.Velocity;
+		View.State = Track.State;
+		View.JammerDistance = Track.JammerDistance;
+		View.TargetKind = Track.TargetKind;
+		View.TargetId = Track.TargetId;
+		Visitor(View);
+	}
+}
+
+bool FMissileTelemetryRecorder::ExportBinary(const FString& FilePath) const
+{
+	if (Tracks.Num() == 0)
+	{
+		return false;
+	}
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MissileTelemetry: 无法创建文件 %s"), *FilePath);
+		return false;
+	}
+
+	// 文件头：魔数、版本、轨迹数；每条轨迹：Id、名称、标志位、样本数，随后各列按顺序原样写出
+	uint32 Magic = TelemetryFileMagic;
+	uint32 Version = TelemetryFileVersion;
+	int32 TrackCount = Tracks.Num();
+	*Ar << Magic << Version << TrackCount;
+	for (const FTrack& Track : Tracks)
+	{
+		uint32 MissileId = Track.MissileId;
+		FString Name = Track.Name;
+		uint8 Flags = (Track.bInterceptor ? 1 : 0) | (Track.bFinished ? 2 : 0);
+		int32 SampleCount = Track.Num();
+		*Ar << MissileId << Name << Flags << SampleCount;
+
+		WriteColumn(*Ar, Track.Time);
+		WriteColumn(*Ar, Track.Position);
+		WriteColumn(*Ar, Track.Velocity);
+		WriteColumn(*Ar, Track.State);
+		WriteColumn(*Ar, Track.JammerDistance);
+		WriteColumn(*Ar, Track.TargetKind);
+		WriteColumn(*Ar, Track.TargetId);
+	}
+
+	return Ar->Close() && !Ar->IsError();
+}
+
+FString FMissileTelemetryRecorder::ExportToTelemetryDir() const
+{
+	if (!IsEnabled() || CVarTelemetryExport.GetValueOnGameThread() == 0 || Tracks.Num() == 0)
+	{
+		return FString();
+	}
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") / FString::Printf(TEXT("MissileTelemetry_%s.irtm"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	if (!ExportBinary(FilePath))
+	{
+		return FString();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MissileTelemetry: 已导出 %d 条轨迹、%lld 个样本（%.1f KB，淘汰 %d 条）到 %s"),
+		Tracks.Num(), TotalSamples, GetMemoryBytes() / 1024.0, EvictedTrackCount, *FilePath);
+	return FilePath;
+}
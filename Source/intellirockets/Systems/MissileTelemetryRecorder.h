@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+
+class AMockMissileActor;
+class UWorld;
+
+/** 遥测样本中的导弹状态（导出文件按该编号存储，新增状态只能追加在末尾） */
+enum class EMissileTelemetryState : uint8
+{
+	Ascent,
+	Homing,
+	Evading,
+	Jammed,
+	Intercepting,
+	Terminated,
+};
+
+/** 遥测样本中目标的类别，决定 TargetId 所在的编号空间（导出文件按该编号存储，新增类别只能追加在末尾） */
+enum class EMissileTelemetryTargetKind : uint8
+{
+	None,
+	Missile,  // 拦截弹的目标导弹：TargetId 为导弹会话序号
+	BlueUnit, // 蓝方单位：TargetId 为部署序号（Actor 与实例化模式一致）
+};
+
+/** 导弹单次遥测采样（由导弹填写，速度由记录器根据相邻样本差分得到） */
+struct FMissileTelemetrySample
+{
+	FVector Location = FVector::ZeroVector;
+	EMissileTelemetryState State = EMissileTelemetryState::Ascent;
+	float NearestJammerDistance = -1.f; // 无干扰器时为 -1
+	EMissileTelemetryTargetKind TargetKind = EMissileTelemetryTargetKind::None;
+	int32 TargetId = INDEX_NONE; // 按 TargetKind 解释：导弹会话序号或蓝方单位部署序号；无目标时为 INDEX_NONE
+};
+
+/**
+ * 单枚导弹轨迹的只读列视图：直接指向记录器内部的列数组（零拷贝），
+ * 在记录器下一次采样、压缩或 Reset 之前有效。
+ */
+struct FMissileTelemetryTrackView
+{
+	uint32 MissileId = 0;
+	FStringView Name;
+	bool bInterceptor = false;
+	bool bFinished = false;
+	TConstArrayView<float> Time; // 相对 Begin 的世界时间（秒）
+	TConstArrayView<FVector3f> Position;
+	TConstArrayView<FVector3f> Velocity;
+	TConstArrayView<uint8> State; // EMissileTelemetryState
+	TConstArrayView<float> JammerDistance;
+	TConstArrayView<uint8> TargetKind; // EMissileTelemetryTargetKind
+	TConstArrayView<int32> TargetId;
+};
+
+/**
+ * 导弹遥测记录：
+ * - 按 ir.Telemetry.SampleRate 采样所有在飞导弹，每枚导弹一组列数组（时间、位置、速度、状态、最近干扰器距离、目标）；
+ * - 单枚导弹样本数达到 ir.Telemetry.MaxSamplesPerMissile 时用 Douglas-Peucker 压缩位置折线
+ *   （误差 ir.Telemetry.ErrorBound，状态或目标变化的样本始终保留），必要时逐步放大误差直到压到一半容量；
+ * - 全部轨迹超过 ir.Telemetry.MemoryBudgetMB 时，先把已结束的轨迹从旧到新压缩到少量关键点，仍超出则淘汰最旧的已结束轨迹，
+ *   长时间的批量/蒙特卡洛运行内存也保持在预算内；
+ * - 导出时各列直接从内存写入二进制文件（Saved/Telemetry/MissileTelemetry_*.irtm），不做中间拷贝。
+ */
+class FMissileTelemetryRecorder
+{
+public:
+	~FMissileTelemetryRecorder();
+
+	/** ir.Telemetry.SampleRate > 0 时开启 */
+	static bool IsEnabled();
+
+	/** 开始采样；CollectMissiles 每次采样时返回当前在飞的导弹（重复调用会清空并重新开始） */
+	void Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles);
+
+	/** 停止采样，保留已记录的数据 */
+	void Stop();
+
+	/** 停止采样并清空数据 */
+	void Reset();
+
+	bool IsRecording() const { return TickerHandle.IsValid(); }
+
+	/** 按轨迹创建顺序遍历所有轨迹（零拷贝视图） */
+	void ForEachTrack(TFunctionRef<void(const FMissileTelemetryTrackView&)> Visitor) const;
+
+	int32 GetTrackCount() const { return Tracks.Num(); }
+	int64 GetSampleCount() const { return TotalSamples; }
+	int64 GetMemoryBytes() const;
+	int32 GetEvictedTrackCount() const { return EvictedTrackCount; }
+
+	/** 导出为二进制列式文件，成功返回 true */
+	bool ExportBinary(const FString& FilePath) const;
+
+	/** ir.Telemetry.Export 开启且有数据时导出到 Saved/Telemetry，返回输出路径 */
+	FString ExportToTelemetryDir() const;
+
+private:
+	struct FTrack
+	{
+		TObjectKey<AMockMissileActor> MissileKey;
+		uint32 MissileId = 0;
+		FString Name;
+		bool bInterceptor = false;
+		bool bFinished = false;
+		bool bBudgetCompacted = false;
+		uint32 LastSeenTick = 0;
+
+		TArray<float> Time;
+		TArray<FVector3f> Position;
+		TArray<FVector3f> Velocity;
+		TArray<uint8> State;
+		TArray<float> JammerDistance;
+		TArray<uint8> TargetKind;
+		TArray<int32> TargetId;
+
+		int32 Num() const { return Time.Num(); }
+		int64 GetAllocatedSize() const;
+		void RemoveUnflagged(const TBitArray<>& Keep);
+		void Shrink();
+	};
+
+	bool HandleTick(float DeltaTime);
+	float GetSampleRate() const;
+	void AppendSample(FTrack& Track, const FMissileTelemetrySample& Sample, float Seconds);
+	/** Douglas-Peucker 压缩到不超过 MaxSamples 个样本，返回移除的样本数 */
+	int32 CompactTrack(FTrack& Track, int32 MaxSamples, float ErrorBound);
+	void EnforceMemoryBudget();
+	void RebuildTrackLookup();
+
+	TArray<FTrack> Tracks;
+	/** 未结束轨迹：导弹 -> 轨迹下标。轨迹结束时移除，导弹销毁后同一对象复用不会续写旧轨迹 */
+	TMap<TObjectKey<AMockMissileActor>, int32> TrackLookup;
+	TFunction<void(TArray<AMockMissileActor*>&)> CollectMissiles;
+	TWeakObjectPtr<UWorld> WorldWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartWorldSeconds = 0.0;
+	double LastSampleWorldSeconds = -1.0;
+	int64 TotalSamples = 0;
+	uint32 SampleTick = 0;
+	bool bBudgetWarningLogged = false;
+	int32 EvictedTrackCount = 0;
+};
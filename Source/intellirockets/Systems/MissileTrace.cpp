@@ -0,0 +1,360 @@
+#include "Systems/MissileTrace.h"
+#include "Actors/MockMissileActor.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+#if MISSILE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(MissileChannel)
+
+UE_TRACE_EVENT_BEGIN(Missile, Spawn)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, MissileId)
+	UE_TRACE_EVENT_FIELD(uint8, bInterceptor)
+	UE_TRACE_EVENT_FIELD(uint8, SplitGeneration)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Missile, Lifecycle)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, MissileId)
+	UE_TRACE_EVENT_FIELD(uint8, Event)
+	UE_TRACE_EVENT_FIELD(float, X)
+	UE_TRACE_EVENT_FIELD(float, Y)
+	UE_TRACE_EVENT_FIELD(float, Z)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Missile, UpdateCost)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint32, MissileId)
+UE_TRACE_EVENT_END()
+
+#endif
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarMissileTimeline(
+		TEXT("ir.MissileTrace.Timeline"),
+		0,
+		TEXT("1: 记录导弹生命周期时间线，测试结束时导出到 Saved/Profiling（Chrome Trace 格式）"));
+
+	// 单帧耗时样本上限（约 20 枚导弹 60 帧跑 3 分钟），超出后只计数不记录
+	constexpr int32 MaxTimelineCostSamples = 200000;
+
+	struct FTimelineTrack
+	{
+		FString Name;
+		bool bInterceptor = false;
+		int32 SplitGeneration = 0;
+	};
+
+	struct FTimelineEvent
+	{
+		uint32 MissileId = 0;
+		EMissileTraceEvent Event = EMissileTraceEvent::Launch;
+		double Seconds = 0.0;
+	};
+
+	struct FTimelineCostSample
+	{
+		uint32 MissileId = 0;
+		double StartSeconds = 0.0;
+		double DurationSeconds = 0.0;
+	};
+
+	struct FMissileTimeline
+	{
+		TMap<uint32, FTimelineTrack> Tracks;
+		TArray<FTimelineEvent> Events;
+		TArray<FTimelineCostSample> CostSamples;
+		double BaseSeconds = -1.0;
+		int32 DroppedCostSamples = 0;
+	};
+
+	FMissileTimeline& GetTimeline()
+	{
+		static FMissileTimeline Timeline;
+		return Timeline;
+	}
+
+	bool IsTimelineEnabled()
+	{
+		return CVarMissileTimeline.GetValueOnGameThread() != 0;
+	}
+
+	bool IsChannelEnabled()
+	{
+#if MISSILE_TRACE_ENABLED
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(MissileChannel);
+#else
+		return false;
+#endif
+	}
+
+	double ToTimelineSeconds(FMissileTimeline& Timeline, uint64 Cycles)
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(Cycles);
+		if (Timeline.BaseSeconds < 0.0)
+		{
+			Timeline.BaseSeconds = Seconds;
+		}
+		return Seconds - Timeline.BaseSeconds;
+	}
+
+	/** 飞行阶段切换事件返回新阶段名称，终止事件返回空字符串，其余返回 nullptr */
+	const TCHAR* GetPhaseForEvent(EMissileTraceEvent Event)
+	{
+		switch (Event)
+		{
+		case EMissileTraceEvent::Launch: return TEXT("Ascent");
+		case EMissileTraceEvent::BeginHoming: return TEXT("Homing");
+		case EMissileTraceEvent::Split: return TEXT("Ballistic");
+		case EMissileTraceEvent::Impact:
+		case EMissileTraceEvent::Intercepted:
+		case EMissileTraceEvent::Expired: return TEXT("");
+		default: return nullptr;
+		}
+	}
+
+	void AppendCompleteEvent(FString& Out, const TCHAR* Name, uint32 Tid, double StartSeconds, double DurationSeconds)
+	{
+		Out += FString::Printf(TEXT(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}"),
+			Name, Tid, StartSeconds * 1000000.0, FMath::Max(0.0, DurationSeconds) * 1000000.0);
+	}
+}
+
+const TCHAR* MissileTrace::GetEventName(EMissileTraceEvent Event)
+{
+	switch (Event)
+	{
+	case EMissileTraceEvent::Launch: return TEXT("Launch");
+	case EMissileTraceEvent::BeginHoming: return TEXT("BeginHoming");
+	case EMissileTraceEvent::TargetAcquired: return TEXT("TargetAcquired");
+	case EMissileTraceEvent::EnterJammer: return TEXT("EnterJammer");
+	case EMissileTraceEvent::ExitJammer: return TEXT("ExitJammer");
+	case EMissileTraceEvent::CountermeasureActivated: return TEXT("CountermeasureActivated");
+	case EMissileTraceEvent::Split: return TEXT("Split");
+	case EMissileTraceEvent::EvadeStart: return TEXT("EvadeStart");
+	case EMissileTraceEvent::EvadeStop: return TEXT("EvadeStop");
+	case EMissileTraceEvent::Impact: return TEXT("Impact");
+	case EMissileTraceEvent::Intercepted: return TEXT("Intercepted");
+	case EMissileTraceEvent::Expired: return TEXT("Expired");
+	default: return TEXT("Unknown");
+	}
+}
+
+bool MissileTrace::IsActive()
+{
+	return IsChannelEnabled() || IsTimelineEnabled();
+}
+
+void MissileTrace::OutputSpawn(const AMockMissileActor* Missile, bool bInterceptor, int32 SplitGeneration)
+{
+	if (!Missile)
+	{
+		return;
+	}
+
+	// 以会话序号标识导弹（UniqueID 在 GC 后会复用）；序号由场景子系统在 SpawnActor 之后、初始化导弹之前分配
+	const uint32 MissileId = Missile->GetSessionSerial();
+	if (MissileId == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MissileTrace: %s traced before its session serial was assigned"), *Missile->GetName());
+	}
+	const FString Name = Missile->GetName();
+
+#if MISSILE_TRACE_ENABLED
+	UE_TRACE_LOG(Missile, Spawn, MissileChannel)
+		<< Spawn.Cycle(FPlatformTime::Cycles64())
+		<< Spawn.MissileId(MissileId)
+		<< Spawn.bInterceptor(bInterceptor ? 1 : 0)
+		<< Spawn.SplitGeneration(static_cast<uint8>(FMath::Clamp(SplitGeneration, 0, 255)))
+		<< Spawn.Name(*Name, Name.Len());
+#endif
+
+	if (IsTimelineEnabled())
+	{
+		FTimelineTrack& Track = GetTimeline().Tracks.FindOrAdd(MissileId);
+		Track.Name = Name;
+		Track.bInterceptor = bInterceptor;
+		Track.SplitGeneration = SplitGeneration;
+	}
+}
+
+void MissileTrace::OutputEvent(const AMockMissileActor* Missile, EMissileTraceEvent Event)
+{
+	if (!Missile)
+	{
+		return;
+	}
+
+	const uint64 Cycle = FPlatformTime::Cycles64();
+	const uint32 MissileId = Missile->GetSessionSerial();
+
+#if MISSILE_TRACE_ENABLED
+	if (IsChannelEnabled())
+	{
+		const FVector Location = Missile->GetActorLocation();
+		UE_TRACE_LOG(Missile, Lifecycle, MissileChannel)
+			<< Lifecycle.Cycle(Cycle)
+			<< Lifecycle.MissileId(MissileId)
+			<< Lifecycle.Event(static_cast<uint8>(Event))
+			<< Lifecycle.X(static_cast<float>(Location.X))
+			<< Lifecycle.Y(static_cast<float>(Location.Y))
+			<< Lifecycle.Z(static_cast<float>(Location.Z));
+
+		// 书签可直接在 Insights 时间视图中看到，无需自定义分析器
+		TRACE_BOOKMARK(TEXT("%s %s"), *Missile->GetName(), GetEventName(Event));
+	}
+#endif
+
+	if (IsTimelineEnabled())
+	{
+		FMissileTimeline& Timeline = GetTimeline();
+		if (!Timeline.Tracks.Contains(MissileId))
+		{
+			Timeline.Tracks.Add(MissileId).Name = Missile->GetName();
+		}
+
+		FTimelineEvent& Entry = Timeline.Events.AddDefaulted_GetRef();
+		Entry.MissileId = MissileId;
+		Entry.Event = Event;
+		Entry.Seconds = ToTimelineSeconds(Timeline, Cycle);
+	}
+}
+
+void MissileTrace::OutputUpdateCost(const AMockMissileActor* Missile, uint64 StartCycle, uint64 EndCycle)
+{
+	if (!Missile)
+	{
+		return;
+	}
+
+	const uint32 MissileId = Missile->GetSessionSerial();
+
+#if MISSILE_TRACE_ENABLED
+	UE_TRACE_LOG(Missile, UpdateCost, MissileChannel)
+		<< UpdateCost.StartCycle(StartCycle)
+		<< UpdateCost.EndCycle(EndCycle)
+		<< UpdateCost.MissileId(MissileId);
+#endif
+
+	if (IsTimelineEnabled())
+	{
+		FMissileTimeline& Timeline = GetTimeline();
+		if (Timeline.CostSamples.Num() >= MaxTimelineCostSamples)
+		{
+			++Timeline.DroppedCostSamples;
+			return;
+		}
+
+		FTimelineCostSample& Sample = Timeline.CostSamples.AddDefaulted_GetRef();
+		Sample.MissileId = MissileId;
+		Sample.StartSeconds = ToTimelineSeconds(Timeline, StartCycle);
+		Sample.DurationSeconds = FPlatformTime::ToSeconds64(EndCycle - StartCycle);
+	}
+}
+
+void MissileTrace::ResetTimeline()
+{
+	GetTimeline() = FMissileTimeline();
+}
+
+bool MissileTrace::ExportTimeline(const FString& FilePath)
+{
+	const FMissileTimeline& Timeline = GetTimeline();
+	if (Timeline.Events.Num() == 0 && Timeline.CostSamples.Num() == 0)
+	{
+		return false;
+	}
+
+	FString Out;
+	Out.Reserve(128 * (Timeline.Events.Num() + Timeline.CostSamples.Num() + Timeline.Tracks.Num() * 4) + 256);
+	Out += TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	Out += TEXT("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Missiles\"}}");
+
+	// 每枚导弹一条轨道（tid = 导弹会话序号）
+	for (const TPair<uint32, FTimelineTrack>& Pair : Timeline.Tracks)
+	{
+		const FString TrackName = FString::Printf(TEXT("%s%s%s"),
+			*Pair.Value.Name,
+			Pair.Value.bInterceptor ? TEXT(" [拦截]") : TEXT(""),
+			Pair.Value.SplitGeneration > 0 ? TEXT(" [分裂]") : TEXT(""));
+		Out += FString::Printf(TEXT(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}"),
+			Pair.Key, *TrackName.ReplaceCharWithEscapedChar());
+	}
+
+	// 飞行阶段（Ascent / Homing / Ballistic）按事件顺序拼成连续区段
+	TMap<uint32, TPair<const TCHAR*, double>> OpenPhases;
+	TMap<uint32, double> LastSeen;
+	for (const FTimelineEvent& Entry : Timeline.Events)
+	{
+		Out += FString::Printf(TEXT(",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}"),
+			MissileTrace::GetEventName(Entry.Event), Entry.MissileId, Entry.Seconds * 1000000.0);
+		LastSeen.FindOrAdd(Entry.MissileId) = Entry.Seconds;
+
+		const TCHAR* NextPhase = GetPhaseForEvent(Entry.Event);
+		if (!NextPhase)
+		{
+			continue;
+		}
+
+		if (const TPair<const TCHAR*, double>* Open = OpenPhases.Find(Entry.MissileId))
+		{
+			AppendCompleteEvent(Out, Open->Key, Entry.MissileId, Open->Value, Entry.Seconds - Open->Value);
+			OpenPhases.Remove(Entry.MissileId);
+		}
+
+		if (*NextPhase != TEXT('\0'))
+		{
+			OpenPhases.Add(Entry.MissileId, TPair<const TCHAR*, double>(NextPhase, Entry.Seconds));
+		}
+	}
+
+	for (const FTimelineCostSample& Sample : Timeline.CostSamples)
+	{
+		AppendCompleteEvent(Out, TEXT("Update"), Sample.MissileId, Sample.StartSeconds, Sample.DurationSeconds);
+		double& Last = LastSeen.FindOrAdd(Sample.MissileId);
+		Last = FMath::Max(Last, Sample.StartSeconds + Sample.DurationSeconds);
+	}
+
+	// 测试结束时仍在飞行的导弹：阶段截止到最后一次记录
+	for (const TPair<uint32, TPair<const TCHAR*, double>>& Pair : OpenPhases)
+	{
+		const double* Last = LastSeen.Find(Pair.Key);
+		const double EndSeconds = Last ? *Last : Pair.Value.Value;
+		AppendCompleteEvent(Out, Pair.Value.Key, Pair.Key, Pair.Value.Value, EndSeconds - Pair.Value.Value);
+	}
+
+	Out += TEXT("\n]}\n");
+
+	if (Timeline.DroppedCostSamples > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MissileTrace: 时间线耗时样本已达上限，丢弃 %d 条"), Timeline.DroppedCostSamples);
+	}
+
+	return FFileHelper::SaveStringToFile(Out, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString MissileTrace::ExportTimelineToProfilingDir()
+{
+	if (!IsTimelineEnabled())
+	{
+		return FString();
+	}
+
+	const FString FilePath = FPaths::ProfilingDir() / FString::Printf(TEXT("MissileTimeline_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	if (!ExportTimeline(FilePath))
+	{
+		return FString();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MissileTrace: 时间线已导出 %s（可用 chrome://tracing 或 Perfetto 打开）"), *FilePath);
+	return FilePath;
+}
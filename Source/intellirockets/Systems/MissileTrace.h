@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+class AMockMissileActor;
+
+// 非 Shipping 且引擎启用 Trace 时编译导弹生命周期追踪
+#ifndef MISSILE_TRACE_ENABLED
+	#define MISSILE_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+/**
+ * 导弹生命周期事件（Trace 通道与导出时间线共用同一编号，新增事件只能追加在末尾）
+ */
+enum class EMissileTraceEvent : uint8
+{
+	Launch,
+	BeginHoming,
+	TargetAcquired,
+	EnterJammer,
+	ExitJammer,
+	CountermeasureActivated,
+	Split,
+	EvadeStart,
+	EvadeStop,
+	Impact,
+	Intercepted,
+	Expired,
+};
+
+#if MISSILE_TRACE_ENABLED
+// 使用 -trace=cpu,Missile 启动即可在 Unreal Insights 中录制导弹事件
+UE_TRACE_CHANNEL_EXTERN(MissileChannel)
+#endif
+
+/**
+ * 导弹生命周期追踪：
+ * - 通过自定义 TraceLog 通道输出紧凑的生命周期事件、状态切换与每枚导弹的单帧更新耗时；
+ * - 开启 ir.MissileTrace.Timeline 后同时记录到内存时间线，测试结束时导出为
+ *   Chrome Trace 格式（Saved/Profiling/MissileTimeline_*.json），每枚导弹一条轨道。
+ */
+namespace MissileTrace
+{
+	const TCHAR* GetEventName(EMissileTraceEvent Event);
+
+	/** 声明（或更新）导弹轨道：名称、是否为拦截导弹、分裂层级 */
+	void OutputSpawn(const AMockMissileActor* Missile, bool bInterceptor, int32 SplitGeneration);
+
+	/** 输出一次生命周期事件 */
+	void OutputEvent(const AMockMissileActor* Missile, EMissileTraceEvent Event);
+
+	/** 输出一次导弹 Tick 的耗时（Cycles64） */
+	void OutputUpdateCost(const AMockMissileActor* Missile, uint64 StartCycle, uint64 EndCycle);
+
+	/** Trace 通道或时间线任一开启时返回 true，用于跳过计时开销 */
+	bool IsActive();
+
+	/** 清空内存时间线（新测试会话开始时调用） */
+	void ResetTimeline();
+
+	/** 将内存时间线导出到指定文件，成功返回 true */
+	bool ExportTimeline(const FString& FilePath);
+
+	/** 导出到 Saved/Profiling 目录，返回输出路径（无数据时返回空字符串） */
+	FString ExportTimelineToProfilingDir();
+}
+
+#if MISSILE_TRACE_ENABLED
+
+/** 统计一次导弹更新耗时，析构时输出 */
+struct FMissileUpdateTraceScope
+{
+	explicit FMissileUpdateTraceScope(const AMockMissileActor* InMissile)
+		: Missile(InMissile)
+		, StartCycle(MissileTrace::IsActive() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FMissileUpdateTraceScope()
+	{
+		if (StartCycle != 0)
+		{
+			MissileTrace::OutputUpdateCost(Missile, StartCycle, FPlatformTime::Cycles64());
+		}
+	}
+
+	const AMockMissileActor* Missile;
+	uint64 StartCycle;
+};
+
+#define TRACE_MISSILE_SPAWN(Missile, bInterceptor, SplitGeneration) MissileTrace::OutputSpawn(Missile, bInterceptor, SplitGeneration)
+#define TRACE_MISSILE_EVENT(Missile, Event) MissileTrace::OutputEvent(Missile, EMissileTraceEvent::Event)
+#define TRACE_MISSILE_UPDATE_SCOPE(Missile) FMissileUpdateTraceScope PREPROCESSOR_JOIN(MissileUpdateTraceScope, __LINE__)(Missile)
+
+#else
+
+#define TRACE_MISSILE_SPAWN(Missile, bInterceptor, SplitGeneration)
+#define TRACE_MISSILE_EVENT(Missile, Event)
+#define TRACE_MISSILE_UPDATE_SCOPE(Missile)
+
+#endif
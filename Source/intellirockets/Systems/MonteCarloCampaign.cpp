@@ -0,0 +1,488 @@
+#include "Systems/MonteCarloCampaign.h"
+#include "Systems/ScenarioMenuSubsystem.h"
+#include "Systems/ScenarioConfigIO.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarMonteCarloMinRuns(
+		TEXT("ir.MonteCarlo.MinRuns"),
+		5,
+		TEXT("随机采样测试判定收敛前的最少轮数"));
+
+	TAutoConsoleVariable<int32> CVarMonteCarloMaxRuns(
+		TEXT("ir.MonteCarlo.MaxRuns"),
+		100,
+		TEXT("随机采样测试最多轮数（未收敛时在此停止）"));
+
+	TAutoConsoleVariable<float> CVarMonteCarloRelativeCI(
+		TEXT("ir.MonteCarlo.RelativeCI"),
+		0.05f,
+		TEXT("收敛阈值：95% 置信区间半宽不超过均值的该比例"));
+
+	TAutoConsoleVariable<float> CVarMonteCarloAbsoluteCI(
+		TEXT("ir.MonteCarlo.AbsoluteCI"),
+		1.0f,
+		TEXT("收敛阈值：95% 置信区间半宽不超过该绝对值（指标原始单位，均值接近 0 时生效）"));
+
+	TAutoConsoleVariable<int32> CVarMonteCarloShotsPerRun(
+		TEXT("ir.MonteCarlo.ShotsPerRun"),
+		8,
+		TEXT("随机采样测试每轮自动发射数量"));
+
+	constexpr double DeploymentTimeoutSeconds = 300.0;
+	constexpr float RunTimeoutSeconds = 180.f;
+
+	const TCHAR* HitRateIndicatorId = TEXT("hitRate");
+
+	// 双侧 95% t 分布临界值，自由度 1~30；更大自由度取正态近似
+	double GetTCritical95(int32 DegreesOfFreedom)
+	{
+		static const double Table[30] =
+		{
+			12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+			2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+			2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+		};
+		if (DegreesOfFreedom < 1)
+		{
+			return 0.0;
+		}
+		return DegreesOfFreedom <= 30 ? Table[DegreesOfFreedom - 1] : 1.96;
+	}
+}
+
+void FRunningStat::Add(double Value)
+{
+	++Count;
+	const double Delta = Value - Mean;
+	Mean += Delta / Count;
+	M2 += Delta * (Value - Mean);
+	Min = Count == 1 ? Value : FMath::Min(Min, Value);
+	Max = Count == 1 ? Value : FMath::Max(Max, Value);
+}
+
+double FRunningStat::GetHalfWidth95() const
+{
+	if (Count < 2)
+	{
+		return TNumericLimits<double>::Max();
+	}
+	return GetTCritical95(Count - 1) * GetStdDev() / FMath::Sqrt(static_cast<double>(Count));
+}
+
+void FMonteCarloAggregates::Reset()
+{
+	RunCount = 0;
+	Indicators.Reset();
+	Totals = FMissileTestSummary();
+	FlightTimeShotSum = 0.0;
+}
+
+FMonteCarloIndicatorStats& FMonteCarloAggregates::FindOrAddIndicator(const FString& Id, const FString& Name)
+{
+	for (FMonteCarloIndicatorStats& Indicator : Indicators)
+	{
+		if (Indicator.Id == Id)
+		{
+			return Indicator;
+		}
+	}
+	FMonteCarloIndicatorStats& Indicator = Indicators.AddDefaulted_GetRef();
+	Indicator.Id = Id;
+	Indicator.Name = Name;
+	return Indicator;
+}
+
+void FMonteCarloAggregates::AddRun(const FMissileTestSummary& Summary, const TArray<FIndicatorEvaluationResult>& Evaluations)
+{
+	++RunCount;
+
+	Totals.TotalShots += Summary.TotalShots;
+	Totals.Hits += Summary.Hits;
+	Totals.DirectHits += Summary.DirectHits;
+	Totals.AoEHits += Summary.AoEHits;
+	Totals.Misses += Summary.Misses;
+	Totals.SessionDuration += Summary.SessionDuration;
+	FlightTimeShotSum += static_cast<double>(Summary.AverageFlightTime) * Summary.TotalShots;
+
+	FMonteCarloIndicatorStats& HitRate = FindOrAddIndicator(HitRateIndicatorId, TEXT("命中率(%)"));
+	HitRate.Value.Add(Summary.HitRate);
+
+	for (const FIndicatorEvaluationResult& Evaluation : Evaluations)
+	{
+		if (!Evaluation.bHasData)
+		{
+			continue;
+		}
+		FMonteCarloIndicatorStats& Indicator = FindOrAddIndicator(Evaluation.IndicatorId, Evaluation.DisplayName);
+		Indicator.bHasTarget = true;
+		Indicator.TargetValue = Evaluation.TargetValue;
+		Indicator.bHigherIsBetter = Evaluation.bHigherIsBetter;
+		Indicator.Value.Add(Evaluation.Value);
+		Indicator.PassCount += Evaluation.bPass ? 1 : 0;
+	}
+}
+
+bool FMonteCarloAggregates::UpdateConvergence(int32 MinRuns, float RelativeTolerance, float AbsoluteTolerance)
+{
+	bool bAllConverged = Indicators.Num() > 0;
+	for (FMonteCarloIndicatorStats& Indicator : Indicators)
+	{
+		const double Threshold = FMath::Max(RelativeTolerance * FMath::Abs(Indicator.Value.Mean), static_cast<double>(AbsoluteTolerance));
+		Indicator.bConverged = Indicator.Value.Count >= FMath::Max(2, MinRuns) && Indicator.Value.GetHalfWidth95() <= Threshold;
+		bAllConverged &= Indicator.bConverged;
+	}
+	return bAllConverged;
+}
+
+TSharedRef<FJsonObject> FMonteCarloAggregates::ToJson() const
+{
+	TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetNumberField(TEXT("runs"), RunCount);
+
+	TArray<TSharedPtr<FJsonValue>> Items;
+	for (const FMonteCarloIndicatorStats& Indicator : Indicators)
+	{
+		TSharedRef<FJsonObject> Item = MakeShareable(new FJsonObject);
+		Item->SetStringField(TEXT("id"), Indicator.Id);
+		Item->SetStringField(TEXT("name"), Indicator.Name);
+		Item->SetNumberField(TEXT("samples"), Indicator.Value.Count);
+		Item->SetNumberField(TEXT("mean"), Indicator.Value.Mean);
+		Item->SetNumberField(TEXT("stdDev"), Indicator.Value.GetStdDev());
+		Item->SetNumberField(TEXT("min"), Indicator.Value.Min);
+		Item->SetNumberField(TEXT("max"), Indicator.Value.Max);
+		if (Indicator.Value.Count > 1)
+		{
+			Item->SetNumberField(TEXT("ciHalfWidth95"), Indicator.Value.GetHalfWidth95());
+		}
+		Item->SetBoolField(TEXT("converged"), Indicator.bConverged);
+		if (Indicator.bHasTarget)
+		{
+			Item->SetNumberField(TEXT("targetValue"), Indicator.TargetValue);
+			Item->SetBoolField(TEXT("higherIsBetter"), Indicator.bHigherIsBetter);
+			Item->SetNumberField(TEXT("passRate"), Indicator.GetPassRate());
+		}
+		Items.Add(MakeShareable(new FJsonValueObject(Item)));
+	}
+	Root->SetArrayField(TEXT("indicators"), Items);
+	return Root;
+}
+
+void FMonteCarloAggregates::BuildHistoryResult(FMissileTestSummary& OutSummary, TArray<FIndicatorEvaluationResult>& OutEvaluations) const
+{
+	OutSummary = Totals;
+	OutSummary.HitRate = Totals.TotalShots > 0 ? (static_cast<float>(Totals.Hits) * 100.f / Totals.TotalShots) : 0.f;
+	OutSummary.DirectHitRate = Totals.Hits > 0 ? (static_cast<float>(Totals.DirectHits) * 100.f / Totals.Hits) : 0.f;
+	OutSummary.AverageFlightTime = Totals.TotalShots > 0 ? static_cast<float>(FlightTimeShotSum / Totals.TotalShots) : 0.f;
+
+	OutEvaluations.Reset();
+	for (const FMonteCarloIndicatorStats& Indicator : Indicators)
+	{
+		if (!Indicator.bHasTarget || Indicator.Value.Count == 0)
+		{
+			continue;
+		}
+
+		const float Mean = static_cast<float>(Indicator.Value.Mean);
+		FIndicatorEvaluationResult& Evaluation = OutEvaluations.AddDefaulted_GetRef();
+		Evaluation.IndicatorId = Indicator.Id;
+		Evaluation.DisplayName = Indicator.Name;
+		Evaluation.bHasData = true;
+		Evaluation.Value = Mean;
+		Evaluation.TargetValue = Indicator.TargetValue;
+		Evaluation.bHigherIsBetter = Indicator.bHigherIsBetter;
+		Evaluation.bPass = Indicator.bHigherIsBetter ? (Mean >= Indicator.TargetValue) : (Mean <= Indicator.TargetValue);
+		Evaluation.StatusText = Evaluation.bPass ? TEXT("达标") : TEXT("未达标");
+		Evaluation.ValueText = Indicator.Value.Count > 1
+			? FString::Printf(TEXT("%.2f ± %.2f"), Mean, Indicator.Value.GetHalfWidth95())
+			: FString::Printf(TEXT("%.2f"), Mean);
+		Evaluation.TargetText = FString::Printf(TEXT("%s %.2f"), Indicator.bHigherIsBetter ? TEXT("≥") : TEXT("≤"), Indicator.TargetValue);
+		Evaluation.RemarkText = FString::Printf(TEXT("%d 轮均值，逐轮达标率 %.0f%%"), Indicator.Value.Count, Indicator.GetPassRate());
+	}
+}
+
+int32 FMonteCarloCampaign::GetMinRunsSetting()
+{
+	return FMath::Max(2, CVarMonteCarloMinRuns.GetValueOnGameThread());
+}
+
+float FMonteCarloCampaign::GetRelativeToleranceSetting()
+{
+	return FMath::Max(0.f, CVarMonteCarloRelativeCI.GetValueOnGameThread());
+}
+
+float FMonteCarloCampaign::GetAbsoluteToleranceSetting()
+{
+	return FMath::Max(0.f, CVarMonteCarloAbsoluteCI.GetValueOnGameThread());
+}
+
+FMonteCarloCampaign::FMonteCarloCampaign(UScenarioMenuSubsystem* InSubsystem)
+	: SubsystemWeak(InSubsystem)
+{
+}
+
+FMonteCarloCampaign::~FMonteCarloCampaign()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FMonteCarloCampaign::Start(const FScenarioTestConfig& InConfig)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem || IsRunning())
+	{
+		return false;
+	}
+
+	Config = InConfig;
+	// 蒙特卡洛每轮随机部署，不使用手动部署
+	Config.bBlueCustomDeployment = false;
+
+	MinRuns = GetMinRunsSetting();
+	MaxRuns = FMath::Max(MinRuns, CVarMonteCarloMaxRuns.GetValueOnGameThread());
+	ShotsPerRun = FMath::Clamp(CVarMonteCarloShotsPerRun.GetValueOnGameThread(), 1, 20);
+	RelativeTolerance = GetRelativeToleranceSetting();
+	AbsoluteTolerance = GetAbsoluteToleranceSetting();
+	BaseSeed = static_cast<int32>(FPlatformTime::Cycles() & 0x7fffffff);
+
+	Aggregates.Reset();
+	CurrentRun = 0;
+	TimedOutRuns = 0;
+	bConverged = false;
+	StopReason.Reset();
+
+	OutputDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("MonteCarlo") / FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+	ScenarioConfigIO::SaveConfigToFile(OutputDirectory / TEXT("scenario.json"), Config);
+
+	UE_LOG(LogTemp, Log, TEXT("[MonteCarlo] Campaign started: runs=%d..%d shots/run=%d relCI=%.3f absCI=%.3f seed=%d out=%s"),
+		MinRuns, MaxRuns, ShotsPerRun, RelativeTolerance, AbsoluteTolerance, BaseSeed, *OutputDirectory);
+
+	FMath::RandInit(BaseSeed);
+	FMath::SRandInit(BaseSeed);
+	Subsystem->StartScenarioWithConfig(Config);
+
+	Phase = EPhase::WaitingForDeployment;
+	PhaseStartSeconds = FPlatformTime::Seconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMonteCarloCampaign::HandleTick));
+	return true;
+}
+
+void FMonteCarloCampaign::Stop(const FString& Reason)
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	// 未完成的一轮结算后丢弃，保证汇总只包含完整轮次
+	if (UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get())
+	{
+		if (Phase == EPhase::Firing || Phase == EPhase::WaitingForMissiles)
+		{
+			Subsystem->ClearAutoFire();
+			Subsystem->CompleteMissileTest();
+		}
+	}
+	Finish(Reason);
+}
+
+double FMonteCarloCampaign::GetWorldSeconds() const
+{
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	const UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+bool FMonteCarloCampaign::HandleTick(float DeltaTime)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	UWorld* World = Subsystem->GetWorld();
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForDeployment:
+		if (FPlatformTime::Seconds() - PhaseStartSeconds > DeploymentTimeoutSeconds)
+		{
+			Finish(TEXT("地图加载或蓝方部署超时"));
+			return false;
+		}
+		if (!Subsystem->bHasPendingScenarioConfig && World && World->HasBegunPlay())
+		{
+			if (Subsystem->GetActiveBlueUnitCount() == 0)
+			{
+				Finish(TEXT("未能部署任何蓝方单位"));
+				return false;
+			}
+			BeginRun();
+		}
+		break;
+
+	case EPhase::Firing:
+		Subsystem->BeginMissileAutoFire(ShotsPerRun);
+		Phase = EPhase::WaitingForMissiles;
+		PhaseStartSeconds = GetWorldSeconds();
+		break;
+
+	case EPhase::WaitingForMissiles:
+	{
+		Subsystem->CleanupMissiles();
+		const bool bAllResolved = Subsystem->AutoFireRemaining <= 0
+			&& Subsystem->ActiveMissiles.Num() == 0
+			&& Subsystem->ActiveInterceptorMissiles.Num() == 0;
+		const bool bTimedOut = GetWorldSeconds() - PhaseStartSeconds > RunTimeoutSeconds;
+		if (bAllResolved || bTimedOut)
+		{
+			FinishRun(!bAllResolved);
+		}
+		break;
+	}
+
+	case EPhase::Finished:
+		break;
+	}
+
+	return Phase != EPhase::Finished;
+}
+
+void FMonteCarloCampaign::BeginRun()
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	if (!World)
+	{
+		Finish(TEXT("运行过程中世界已失效"));
+		return;
+	}
+
+	// 第一轮沿用 StartScenarioWithConfig 的部署，之后每轮换种子原地重新部署
+	if (CurrentRun > 0)
+	{
+		const int32 Seed = BaseSeed + CurrentRun;
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+		Subsystem->ResetMissileTestSession();
+		Subsystem->ResetScenarioInPlace(World, Subsystem->ActiveScenarioConfig, false);
+	}
+
+	Phase = EPhase::Firing;
+}
+
+void FMonteCarloCampaign::FinishRun(bool bTimedOut)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		Finish(TEXT("运行状态异常"));
+		return;
+	}
+
+	Subsystem->CompleteMissileTest();
+
+	const int32 Seed = BaseSeed + CurrentRun;
+	const FMissileTestSummary& Summary = Subsystem->GetMissileTestSummary();
+	TArray<FIndicatorEvaluationResult> Evaluations;
+	Subsystem->BuildIndicatorEvaluations(Evaluations);
+
+	// 超时轮次的导弹未全部结算，结果有偏，不并入汇总
+	if (bTimedOut)
+	{
+		++TimedOutRuns;
+	}
+	else
+	{
+		Aggregates.AddRun(Summary, Evaluations);
+		bConverged = Aggregates.UpdateConvergence(MinRuns, RelativeTolerance, AbsoluteTolerance);
+	}
+
+	// 每轮一行，边跑边写，中途退出也能保留已完成的数据
+	TSharedRef<FJsonObject> RunObject = MakeShareable(new FJsonObject);
+	RunObject->SetNumberField(TEXT("run"), CurrentRun);
+	RunObject->SetNumberField(TEXT("seed"), Seed);
+	RunObject->SetBoolField(TEXT("timedOut"), bTimedOut);
+	RunObject->SetNumberField(TEXT("shots"), Summary.TotalShots);
+	RunObject->SetNumberField(TEXT("hitRate"), Summary.HitRate);
+	TSharedRef<FJsonObject> Values = MakeShareable(new FJsonObject);
+	for (const FIndicatorEvaluationResult& Evaluation : Evaluations)
+	{
+		if (Evaluation.bHasData)
+		{
+			Values->SetNumberField(Evaluation.IndicatorId, Evaluation.Value);
+		}
+	}
+	RunObject->SetObjectField(TEXT("values"), Values);
+
+	FString Line;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	FJsonSerializer::Serialize(RunObject, Writer);
+	Line += TEXT("\n");
+	FFileHelper::SaveStringToFile(Line, *(OutputDirectory / TEXT("runs.jsonl")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+
+	UE_LOG(LogTemp, Log, TEXT("[MonteCarlo] Run %d finished HitRate=%.1f%% converged=%d%s"),
+		CurrentRun + 1, Summary.HitRate, bConverged ? 1 : 0, bTimedOut ? TEXT(" (timeout, discarded)") : TEXT(""));
+
+	++CurrentRun;
+	if (bConverged)
+	{
+		Finish(FString::Printf(TEXT("已收敛（%d 轮）"), Aggregates.GetRunCount()));
+	}
+	else if (CurrentRun >= MaxRuns)
+	{
+		Finish(FString::Printf(TEXT("达到最大轮数 %d，未完全收敛"), MaxRuns));
+	}
+	else
+	{
+		BeginRun();
+	}
+}
+
+void FMonteCarloCampaign::Finish(const FString& Reason)
+{
+	Phase = EPhase::Finished;
+	StopReason = Reason;
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetStringField(TEXT("timestamp"), FDateTime::Now().ToIso8601());
+	Root->SetStringField(TEXT("result"), Reason);
+	Root->SetBoolField(TEXT("converged"), bConverged);
+	Root->SetNumberField(TEXT("baseSeed"), BaseSeed);
+	Root->SetNumberField(TEXT("shotsPerRun"), ShotsPerRun);
+	Root->SetNumberField(TEXT("minRuns"), MinRuns);
+	Root->SetNumberField(TEXT("maxRuns"), MaxRuns);
+	Root->SetNumberField(TEXT("relativeCI"), RelativeTolerance);
+	Root->SetNumberField(TEXT("absoluteCI"), AbsoluteTolerance);
+	Root->SetNumberField(TEXT("timedOutRuns"), TimedOutRuns);
+	Root->SetObjectField(TEXT("aggregates"), Aggregates.ToJson());
+	ScenarioConfigIO::WriteJsonToFile(Root, OutputDirectory / TEXT("summary.json"));
+
+	UE_LOG(LogTemp, Log, TEXT("[MonteCarlo] Campaign finished: %s (%d runs, results: %s)"), *Reason, Aggregates.GetRunCount(), *OutputDirectory);
+
+	OnFinished.ExecuteIfBound();
+}
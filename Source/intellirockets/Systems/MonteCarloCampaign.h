@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+class UScenarioMenuSubsystem;
+class FJsonObject;
+
+/** 流式均值/方差（Welford），不保存样本 */
+struct FRunningStat
+{
+	int32 Count = 0;
+	double Mean = 0.0;
+	double M2 = 0.0;
+	double Min = 0.0;
+	double Max = 0.0;
+
+	void Add(double Value);
+	double GetVariance() const { return Count > 1 ? M2 / (Count - 1) : 0.0; }
+	double GetStdDev() const { return FMath::Sqrt(GetVariance()); }
+	/** 均值的 95% 置信区间半宽（小样本使用 t 分布） */
+	double GetHalfWidth95() const;
+};
+
+struct FMonteCarloIndicatorStats
+{
+	FString Id;
+	FString Name;
+	bool bHasTarget = false;
+	float TargetValue = 0.f;
+	bool bHigherIsBetter = true;
+	FRunningStat Value;
+	int32 PassCount = 0;
+	bool bConverged = false;
+
+	float GetPassRate() const { return Value.Count > 0 ? PassCount * 100.f / Value.Count : 0.f; }
+};
+
+/**
+ * 随机采样测试的运行期汇总：每轮结束后把命中率与各指标数值并入，
+ * 当所有有数据的指标置信区间半宽都小于阈值时判定收敛。
+ */
+class FMonteCarloAggregates
+{
+public:
+	void Reset();
+	void AddRun(const FMissileTestSummary& Summary, const TArray<FIndicatorEvaluationResult>& Evaluations);
+
+	/** 更新各指标收敛标记：半宽 <= max(RelativeTolerance * |均值|, AbsoluteTolerance) */
+	bool UpdateConvergence(int32 MinRuns, float RelativeTolerance, float AbsoluteTolerance);
+
+	int32 GetRunCount() const { return RunCount; }
+	const TArray<FMonteCarloIndicatorStats>& GetIndicators() const { return Indicators; }
+
+	TSharedRef<FJsonObject> ToJson() const;
+
+	/** 结果历史的聚合条目：发射与命中计数、时长取各轮之和，命中率按合计重新计算，指标取各轮均值 */
+	void BuildHistoryResult(FMissileTestSummary& OutSummary, TArray<FIndicatorEvaluationResult>& OutEvaluations) const;
+
+private:
+	FMonteCarloIndicatorStats& FindOrAddIndicator(const FString& Id, const FString& Name);
+
+	int32 RunCount = 0;
+	TArray<FMonteCarloIndicatorStats> Indicators; // 第一项为命中率
+	FMissileTestSummary Totals; // 各轮计数与时长之和
+	double FlightTimeShotSum = 0.0; // 各轮平均飞行时间 * 发射数之和
+};
+
+/**
+ * 随机采样蒙特卡洛测试（TestMethodTypeIndex == 0）：
+ * 在当前进程中重复“部署 -> 自动发射 -> 结算”，每轮使用新的随机种子，
+ * 结果流式写入 Saved/MonteCarlo/<时间戳>/runs.jsonl 并并入 FMonteCarloAggregates，
+ * 收敛或达到最大轮数后结束。
+ *
+ * 控制台变量：
+ *   ir.MonteCarlo.MinRuns / MaxRuns      最少/最多轮数
+ *   ir.MonteCarlo.RelativeCI             相对置信区间半宽阈值（相对均值）
+ *   ir.MonteCarlo.AbsoluteCI             绝对置信区间半宽阈值（指标原始单位）
+ *   ir.MonteCarlo.ShotsPerRun            每轮自动发射数量
+ */
+class FMonteCarloCampaign
+{
+public:
+	DECLARE_DELEGATE(FOnFinished);
+
+	explicit FMonteCarloCampaign(UScenarioMenuSubsystem* InSubsystem);
+	~FMonteCarloCampaign();
+
+	bool Start(const FScenarioTestConfig& InConfig);
+	/** 提前结束（例如用户按 P），当前未完成的一轮不计入汇总 */
+	void Stop(const FString& Reason);
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+	bool HasResults() const { return Aggregates.GetRunCount() > 0; }
+	const FMonteCarloAggregates& GetAggregates() const { return Aggregates; }
+	const FScenarioTestConfig& GetConfig() const { return Config; }
+	int32 GetMaxRuns() const { return MaxRuns; }
+	bool IsConverged() const { return bConverged; }
+	const FString& GetStopReason() const { return StopReason; }
+	const FString& GetOutputDirectory() const { return OutputDirectory; }
+
+	/** 命令行/批量运行共用的收敛参数 */
+	static int32 GetMinRunsSetting();
+	static float GetRelativeToleranceSetting();
+	static float GetAbsoluteToleranceSetting();
+
+	FOnFinished OnFinished;
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForDeployment,
+		Firing,
+		WaitingForMissiles,
+		Finished,
+	};
+
+	bool HandleTick(float DeltaTime);
+	void BeginRun();
+	void FinishRun(bool bTimedOut);
+	void Finish(const FString& Reason);
+	double GetWorldSeconds() const;
+
+	TWeakObjectPtr<UScenarioMenuSubsystem> SubsystemWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FScenarioTestConfig Config;
+	FMonteCarloAggregates Aggregates;
+	FString OutputDirectory;
+	FString StopReason;
+
+	int32 MinRuns = 5;
+	int32 MaxRuns = 100;
+	int32 ShotsPerRun = 8;
+	float RelativeTolerance = 0.05f;
+	float AbsoluteTolerance = 1.f;
+	int32 BaseSeed = 0;
+
+	EPhase Phase = EPhase::Finished;
+	int32 CurrentRun = 0;
+	int32 TimedOutRuns = 0;
+	double PhaseStartSeconds = 0.0;
+	bool bConverged = false;
+};
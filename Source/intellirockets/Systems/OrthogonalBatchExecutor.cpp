@@ -0,0 +1,458 @@
+#include "Systems/OrthogonalBatchExecutor.h"
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/ScenarioHeadlessRunner.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarOrthogonalMaxWorkers(
+		TEXT("ir.Orthogonal.MaxWorkers"),
+		0,
+		TEXT("正交批量测试并行工作进程数（0 = 逻辑核数的一半，最多 8）"));
+
+	TAutoConsoleVariable<int32> CVarOrthogonalRunsPerCell(
+		TEXT("ir.Orthogonal.RunsPerCell"),
+		3,
+		TEXT("正交批量测试每个试验单元的重复次数"));
+
+	TAutoConsoleVariable<int32> CVarOrthogonalShotsPerRun(
+		TEXT("ir.Orthogonal.ShotsPerRun"),
+		8,
+		TEXT("正交批量测试每次运行的自动发射数量"));
+
+	// 与无界面运行的单次超时保持一致，另加进程启动与地图加载时间
+	constexpr float RunTimeoutSeconds = 180.f;
+	constexpr float WorkerStartupSeconds = 120.f;
+
+	const TCHAR* HitRateResponseId = TEXT("hitRate");
+	const TCHAR* PassRateResponseId = TEXT("passRate");
+}
+
+FOrthogonalBatchExecutor::FOrthogonalBatchExecutor()
+{
+}
+
+FOrthogonalBatchExecutor::~FOrthogonalBatchExecutor()
+{
+	Cancel();
+}
+
+bool FOrthogonalBatchExecutor::Start(const FScenarioTestConfig& InBaseConfig, FString& OutError)
+{
+	if (IsRunning())
+	{
+		OutError = TEXT("正交批量测试正在运行");
+		return false;
+	}
+
+	if (!OrthogonalDesign::GenerateDesign(InBaseConfig, TArray<EScenarioFactor>(), EOrthogonalArrayType::Auto, Design))
+	{
+		OutError = TEXT("无法生成正交设计");
+		return false;
+	}
+	BaseConfig = InBaseConfig;
+
+	const int32 CVarWorkers = CVarOrthogonalMaxWorkers.GetValueOnGameThread();
+	MaxWorkers = CVarWorkers > 0 ? CVarWorkers : FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() / 2, 1, 8);
+	RunsPerCell = FMath::Max(1, CVarOrthogonalRunsPerCell.GetValueOnGameThread());
+	ShotsPerRun = FMath::Clamp(CVarOrthogonalShotsPerRun.GetValueOnGameThread(), 1, 20);
+	CellTimeoutSeconds = RunsPerCell * RunTimeoutSeconds + WorkerStartupSeconds;
+	BaseSeed = static_cast<int32>(FPlatformTime::Cycles() & 0x7fffffff);
+
+	OutputDirectory = FPaths::ProjectSavedDir() / TEXT("OrthogonalRuns") / FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	OutputDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+	// 每个单元写一份场景文件，runner 字段携带重复次数与种子；同一单元内各次运行种子为 Seed + run
+	for (int32 CellIndex = 0; CellIndex < Design.Cells.Num(); ++CellIndex)
+	{
+		TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+		Root->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Design.Cells[CellIndex]));
+
+		TSharedRef<FJsonObject> Runner = MakeShareable(new FJsonObject);
+		Runner->SetNumberField(TEXT("repetitions"), RunsPerCell);
+		Runner->SetNumberField(TEXT("shotsPerRun"), ShotsPerRun);
+		Runner->SetNumberField(TEXT("timeoutSeconds"), RunTimeoutSeconds);
+		Runner->SetNumberField(TEXT("seed"), BaseSeed + CellIndex * RunsPerCell);
+		Root->SetObjectField(TEXT("runner"), Runner);
+
+		TSharedRef<FJsonObject> Orthogonal = MakeShareable(new FJsonObject);
+		Orthogonal->SetStringField(TEXT("array"), Design.Array.Name);
+		Orthogonal->SetNumberField(TEXT("cell"), CellIndex);
+		TSharedRef<FJsonObject> Levels = MakeShareable(new FJsonObject);
+		for (int32 FactorIndex = 0; FactorIndex < Design.Factors.Num(); ++FactorIndex)
+		{
+			const EScenarioFactor Factor = Design.Factors[FactorIndex];
+			Levels->SetStringField(OrthogonalDesign::GetFactorName(Factor),
+				OrthogonalDesign::GetFactorLevelName(Factor, Design.CellLevels[CellIndex][FactorIndex]));
+		}
+		Orthogonal->SetObjectField(TEXT("levels"), Levels);
+		Root->SetObjectField(TEXT("orthogonal"), Orthogonal);
+
+		if (!ScenarioConfigIO::WriteJsonToFile(Root, GetCellScenarioPath(CellIndex)))
+		{
+			OutError = FString::Printf(TEXT("无法写入场景文件 %s"), *GetCellScenarioPath(CellIndex));
+			return false;
+		}
+	}
+
+	CellResults.Reset();
+	CellResults.SetNum(Design.Cells.Num());
+	MainEffects = FOrthogonalMainEffects();
+	Totals = FMissileTestSummary();
+	FlightTimeShotSum = 0.0;
+	ActiveWorkers.Reset();
+	NextCell = 0;
+	FinishedCells = 0;
+	FailedCells = 0;
+	bHasResults = false;
+
+	UE_LOG(LogTemp, Log, TEXT("[Orthogonal] %s: %d cells, %d factors, workers=%d runs/cell=%d shots/run=%d out=%s"),
+		*Design.Array.Name, Design.Cells.Num(), Design.Factors.Num(), MaxWorkers, RunsPerCell, ShotsPerRun, *OutputDirectory);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FOrthogonalBatchExecutor::HandleTick), 0.5f);
+	return true;
+}
+
+void FOrthogonalBatchExecutor::Cancel()
+{
+	for (FWorker& Worker : ActiveWorkers)
+	{
+		if (Worker.Process.IsValid())
+		{
+			FPlatformProcess::TerminateProc(Worker.Process, true);
+			FPlatformProcess::CloseProc(Worker.Process);
+		}
+	}
+	ActiveWorkers.Reset();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+FString FOrthogonalBatchExecutor::GetCellScenarioPath(int32 CellIndex) const
+{
+	return OutputDirectory / FString::Printf(TEXT("cell_%02d.json"), CellIndex);
+}
+
+FString FOrthogonalBatchExecutor::GetCellResultPath(int32 CellIndex) const
+{
+	return OutputDirectory / FString::Printf(TEXT("cell_%02d_result.json"), CellIndex);
+}
+
+bool FOrthogonalBatchExecutor::LaunchCell(int32 CellIndex)
+{
+	FWorker Worker;
+	Worker.CellIndex = CellIndex;
+	Worker.StartSeconds = FPlatformTime::Seconds();
+	Worker.Process = FScenarioHeadlessRunner::LaunchWorkerProcess(GetCellScenarioPath(CellIndex), GetCellResultPath(CellIndex));
+	if (!Worker.Process.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Orthogonal] Failed to launch worker for cell %d"), CellIndex);
+		return false;
+	}
+
+	ActiveWorkers.Add(Worker);
+	return true;
+}
+
+bool FOrthogonalBatchExecutor::HandleTick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = ActiveWorkers.Num() - 1; Index >= 0; --Index)
+	{
+		FWorker& Worker = ActiveWorkers[Index];
+		int32 ReturnCode = -1;
+		if (FPlatformProcess::IsProcRunning(Worker.Process))
+		{
+			if (Now - Worker.StartSeconds < CellTimeoutSeconds)
+			{
+				continue;
+			}
+			UE_LOG(LogTemp, Warning, TEXT("[Orthogonal] Cell %d timed out, terminating worker"), Worker.CellIndex);
+			FPlatformProcess::TerminateProc(Worker.Process, true);
+		}
+		else
+		{
+			FPlatformProcess::GetProcReturnCode(Worker.Process, &ReturnCode);
+		}
+
+		FPlatformProcess::CloseProc(Worker.Process);
+		CollectCell(Worker.CellIndex, ReturnCode);
+		ActiveWorkers.RemoveAtSwap(Index);
+	}
+
+	while (ActiveWorkers.Num() < MaxWorkers && NextCell < Design.Cells.Num())
+	{
+		const int32 CellIndex = NextCell++;
+		if (!LaunchCell(CellIndex))
+		{
+			CollectCell(CellIndex, -1);
+		}
+	}
+
+	if (ActiveWorkers.Num() == 0 && NextCell >= Design.Cells.Num())
+	{
+		TickerHandle.Reset();
+		FinishBatch();
+		return false;
+	}
+	return true;
+}
+
+void FOrthogonalBatchExecutor::CollectCell(int32 CellIndex, int32 ReturnCode)
+{
+	++FinishedCells;
+
+	// 退出码 0/1 均为有效结果（1 仅表示存在未达标指标）
+	FString JsonString;
+	TSharedPtr<FJsonObject> Root;
+	const bool bLoaded = (ReturnCode == 0 || ReturnCode == 1)
+		&& FFileHelper::LoadFileToString(JsonString, *GetCellResultPath(CellIndex))
+		&& FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), Root)
+		&& Root.IsValid();
+
+	const TArray<TSharedPtr<FJsonValue>>* Runs = nullptr;
+	if (!bLoaded || !Root->TryGetArrayField(TEXT("runs"), Runs) || Runs->Num() == 0)
+	{
+		++FailedCells;
+		UE_LOG(LogTemp, Warning, TEXT("[Orthogonal] Cell %d produced no results (exit code %d)"), CellIndex, ReturnCode);
+		return;
+	}
+
+	FOrthogonalCellResult& Cell = CellResults[CellIndex];
+	Cell.ResponseNames.Add(HitRateResponseId, TEXT("命中率(%)"));
+	Cell.ResponseNames.Add(PassRateResponseId, TEXT("指标达标率(%)"));
+
+	for (const TSharedPtr<FJsonValue>& RunValue : *Runs)
+	{
+		const TSharedPtr<FJsonObject> Run = RunValue.IsValid() ? RunValue->AsObject() : nullptr;
+		if (!Run.IsValid())
+		{
+			continue;
+		}
+
+		bool bTimedOut = false;
+		if (Run->TryGetBoolField(TEXT("timedOut"), bTimedOut) && bTimedOut)
+		{
+			continue;
+		}
+
+		const TSharedPtr<FJsonObject>* Summary = nullptr;
+		double HitRate = 0.0;
+		if (Run->TryGetObjectField(TEXT("summary"), Summary) && (*Summary)->TryGetNumberField(TEXT("hitRate"), HitRate))
+		{
+			Cell.Samples.FindOrAdd(HitRateResponseId).Add(static_cast<float>(HitRate));
+
+			int32 Count = 0;
+			double Seconds = 0.0;
+			if ((*Summary)->TryGetNumberField(TEXT("totalShots"), Count))
+			{
+				Totals.TotalShots += Count;
+				if ((*Summary)->TryGetNumberField(TEXT("averageFlightTime"), Seconds))
+				{
+					FlightTimeShotSum += Seconds * Count;
+				}
+			}
+			Totals.Hits += (*Summary)->TryGetNumberField(TEXT("hits"), Count) ? Count : 0;
+			Totals.DirectHits += (*Summary)->TryGetNumberField(TEXT("directHits"), Count) ? Count : 0;
+			Totals.AoEHits += (*Summary)->TryGetNumberField(TEXT("aoeHits"), Count) ? Count : 0;
+			Totals.Misses += (*Summary)->TryGetNumberField(TEXT("misses"), Count) ? Count : 0;
+			Totals.SessionDuration += (*Summary)->TryGetNumberField(TEXT("sessionDuration"), Seconds) ? static_cast<float>(Seconds) : 0.f;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Evaluations = nullptr;
+		if (!Run->TryGetArrayField(TEXT("evaluations"), Evaluations))
+		{
+			continue;
+		}
+
+		int32 Evaluated = 0;
+		int32 Passed = 0;
+		for (const TSharedPtr<FJsonValue>& EvaluationValue : *Evaluations)
+		{
+			const TSharedPtr<FJsonObject> Evaluation = EvaluationValue.IsValid() ? EvaluationValue->AsObject() : nullptr;
+			bool bHasData = false;
+			double NumericValue = 0.0;
+			if (!Evaluation.IsValid() || !Evaluation->TryGetBoolField(TEXT("hasData"), bHasData) || !bHasData)
+			{
+				continue;
+			}
+
+			++Evaluated;
+			bool bPass = false;
+			if (Evaluation->TryGetBoolField(TEXT("pass"), bPass) && bPass)
+			{
+				++Passed;
+			}
+
+			FString Id;
+			if (Evaluation->TryGetStringField(TEXT("id"), Id) && Evaluation->TryGetNumberField(TEXT("numericValue"), NumericValue))
+			{
+				Cell.Samples.FindOrAdd(Id).Add(static_cast<float>(NumericValue));
+				FString Name;
+				if (Evaluation->TryGetStringField(TEXT("name"), Name))
+				{
+					Cell.ResponseNames.Add(Id, Name);
+				}
+				bool bHigherIsBetter = true;
+				if (Evaluation->TryGetBoolField(TEXT("higherIsBetter"), bHigherIsBetter))
+				{
+					Cell.ResponseHigherIsBetter.Add(Id, bHigherIsBetter);
+				}
+				double TargetValue = 0.0;
+				if (Evaluation->TryGetNumberField(TEXT("targetValue"), TargetValue))
+				{
+					Cell.ResponseTargets.Add(Id, static_cast<float>(TargetValue));
+				}
+			}
+		}
+
+		if (Evaluated > 0)
+		{
+			Cell.Samples.FindOrAdd(PassRateResponseId).Add(Passed * 100.f / Evaluated);
+		}
+	}
+
+	Cell.bCompleted = Cell.Samples.Num() > 0;
+	if (!Cell.bCompleted)
+	{
+		++FailedCells;
+	}
+}
+
+void FOrthogonalBatchExecutor::BuildHistoryResult(FMissileTestSummary& OutSummary, TArray<FIndicatorEvaluationResult>& OutEvaluations) const
+{
+	OutSummary = Totals;
+	OutSummary.HitRate = Totals.TotalShots > 0 ? (static_cast<float>(Totals.Hits) * 100.f / Totals.TotalShots) : 0.f;
+	OutSummary.DirectHitRate = Totals.Hits > 0 ? (static_cast<float>(Totals.DirectHits) * 100.f / Totals.Hits) : 0.f;
+	OutSummary.AverageFlightTime = Totals.TotalShots > 0 ? static_cast<float>(FlightTimeShotSum / Totals.TotalShots) : 0.f;
+
+	// 只汇总带目标值的指标；命中率已在汇总中，达标率由下面的逐指标结果体现
+	struct FResponseTotal
+	{
+		FString Name;
+		bool bHigherIsBetter = true;
+		float TargetValue = 0.f;
+		double Sum = 0.0;
+		int32 Count = 0;
+	};
+	TMap<FString, FResponseTotal> ResponseTotals;
+	for (const FOrthogonalCellResult& Cell : CellResults)
+	{
+		for (const TPair<FString, TArray<float>>& Pair : Cell.Samples)
+		{
+			const float* Target = Cell.ResponseTargets.Find(Pair.Key);
+			if (!Target)
+			{
+				continue;
+			}
+
+			FResponseTotal& Total = ResponseTotals.FindOrAdd(Pair.Key);
+			if (Total.Count == 0)
+			{
+				const FString* Name = Cell.ResponseNames.Find(Pair.Key);
+				const bool* bHigherIsBetter = Cell.ResponseHigherIsBetter.Find(Pair.Key);
+				Total.Name = Name ? *Name : Pair.Key;
+				Total.bHigherIsBetter = bHigherIsBetter ? *bHigherIsBetter : true;
+				Total.TargetValue = *Target;
+			}
+			for (float Value : Pair.Value)
+			{
+				Total.Sum += Value;
+				++Total.Count;
+			}
+		}
+	}
+
+	OutEvaluations.Reset();
+	for (const TPair<FString, FResponseTotal>& Pair : ResponseTotals)
+	{
+		const FResponseTotal& Total = Pair.Value;
+		if (Total.Count == 0)
+		{
+			continue;
+		}
+
+		const float Mean = static_cast<float>(Total.Sum / Total.Count);
+		FIndicatorEvaluationResult& Evaluation = OutEvaluations.AddDefaulted_GetRef();
+		Evaluation.IndicatorId = Pair.Key;
+		Evaluation.DisplayName = Total.Name;
+		Evaluation.bHasData = true;
+		Evaluation.Value = Mean;
+		Evaluation.TargetValue = Total.TargetValue;
+		Evaluation.bHigherIsBetter = Total.bHigherIsBetter;
+		Evaluation.bPass = Total.bHigherIsBetter ? (Mean >= Total.TargetValue) : (Mean <= Total.TargetValue);
+		Evaluation.StatusText = Evaluation.bPass ? TEXT("达标") : TEXT("未达标");
+		Evaluation.ValueText = FString::Printf(TEXT("%.2f"), Mean);
+		Evaluation.TargetText = FString::Printf(TEXT("%s %.2f"), Total.bHigherIsBetter ? TEXT("≥") : TEXT("≤"), Total.TargetValue);
+		Evaluation.RemarkText = FString::Printf(TEXT("正交试验 %d 个单元共 %d 次运行的均值"), MainEffects.CompletedCells, Total.Count);
+	}
+}
+
+void FOrthogonalBatchExecutor::FinishBatch()
+{
+	OrthogonalDesign::ComputeMainEffects(Design, CellResults, MainEffects);
+	bHasResults = true;
+
+	OrthogonalDesign::ExportMainEffectsCsv(MainEffects, OutputDirectory / TEXT("main_effects.csv"));
+
+	TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetStringField(TEXT("array"), MainEffects.ArrayName);
+	Root->SetNumberField(TEXT("cells"), MainEffects.CellCount);
+	Root->SetNumberField(TEXT("completedCells"), MainEffects.CompletedCells);
+	Root->SetNumberField(TEXT("runsPerCell"), RunsPerCell);
+	Root->SetNumberField(TEXT("shotsPerRun"), ShotsPerRun);
+
+	TArray<TSharedPtr<FJsonValue>> Responses;
+	for (const FOrthogonalResponseEffects& Response : MainEffects.Responses)
+	{
+		TSharedRef<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
+		ResponseObject->SetStringField(TEXT("id"), Response.Id);
+		ResponseObject->SetStringField(TEXT("name"), Response.Name);
+		ResponseObject->SetBoolField(TEXT("higherIsBetter"), Response.bHigherIsBetter);
+
+		TArray<TSharedPtr<FJsonValue>> Factors;
+		for (const FOrthogonalFactorEffect& Effect : Response.Factors)
+		{
+			TSharedRef<FJsonObject> FactorObject = MakeShareable(new FJsonObject);
+			FactorObject->SetStringField(TEXT("factor"), OrthogonalDesign::GetFactorName(Effect.Factor));
+			FactorObject->SetNumberField(TEXT("range"), Effect.Range);
+			FactorObject->SetStringField(TEXT("bestLevel"), Effect.BestLevel != INDEX_NONE ? OrthogonalDesign::GetFactorLevelName(Effect.Factor, Effect.BestLevel) : FString());
+
+			TArray<TSharedPtr<FJsonValue>> Levels;
+			for (int32 Level = 0; Level < Effect.LevelMeans.Num(); ++Level)
+			{
+				TSharedRef<FJsonObject> LevelObject = MakeShareable(new FJsonObject);
+				LevelObject->SetStringField(TEXT("level"), OrthogonalDesign::GetFactorLevelName(Effect.Factor, Level));
+				LevelObject->SetNumberField(TEXT("cells"), Effect.LevelSamples[Level]);
+				if (Effect.LevelSamples[Level] > 0)
+				{
+					LevelObject->SetNumberField(TEXT("mean"), Effect.LevelMeans[Level]);
+				}
+				Levels.Add(MakeShareable(new FJsonValueObject(LevelObject)));
+			}
+			FactorObject->SetArrayField(TEXT("levels"), Levels);
+			Factors.Add(MakeShareable(new FJsonValueObject(FactorObject)));
+		}
+		ResponseObject->SetArrayField(TEXT("factors"), Factors);
+		Responses.Add(MakeShareable(new FJsonValueObject(ResponseObject)));
+	}
+	Root->SetArrayField(TEXT("responses"), Responses);
+	ScenarioConfigIO::WriteJsonToFile(Root, OutputDirectory / TEXT("main_effects.json"));
+
+	UE_LOG(LogTemp, Log, TEXT("[Orthogonal] Batch finished: %d/%d cells completed, %d failed, results in %s"),
+		MainEffects.CompletedCells, MainEffects.CellCount, FailedCells, *OutputDirectory);
+
+	OnFinished.ExecuteIfBound();
+}
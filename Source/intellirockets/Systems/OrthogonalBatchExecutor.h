@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "Systems/OrthogonalDesign.h"
+#include "Systems/ScenarioTestMetrics.h"
+
+/**
+ * 正交试验批量执行：
+ * 把每个试验单元写成场景文件，启动本机工作进程池（无界面场景运行，-nullrhi）并行执行，
+ * 全部完成后读取各单元结果，计算主效应表并导出到 Saved/OrthogonalRuns/<时间戳>/。
+ *
+ * 控制台变量：
+ *   ir.Orthogonal.MaxWorkers    并行工作进程数（0 = 逻辑核数的一半，最多 8）
+ *   ir.Orthogonal.RunsPerCell   每个单元重复次数
+ *   ir.Orthogonal.ShotsPerRun   每次自动发射数量
+ */
+class FOrthogonalBatchExecutor
+{
+public:
+	DECLARE_DELEGATE(FOnFinished);
+
+	FOrthogonalBatchExecutor();
+	~FOrthogonalBatchExecutor();
+
+	/** 生成设计并启动工作进程，失败时返回 false 并填写 OutError */
+	bool Start(const FScenarioTestConfig& InBaseConfig, FString& OutError);
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+	bool HasResults() const { return bHasResults; }
+
+	int32 GetCellCount() const { return Design.Cells.Num(); }
+	int32 GetFinishedCellCount() const { return FinishedCells; }
+	int32 GetFailedCellCount() const { return FailedCells; }
+	int32 GetActiveWorkerCount() const { return ActiveWorkers.Num(); }
+
+	const FOrthogonalDesign& GetDesign() const { return Design; }
+	const FOrthogonalMainEffects& GetMainEffects() const { return MainEffects; }
+	const FString& GetOutputDirectory() const { return OutputDirectory; }
+	const FScenarioTestConfig& GetBaseConfig() const { return BaseConfig; }
+
+	/** 结果历史的聚合条目：发射与命中计数、时长取全部有效运行之和，指标取全部运行的均值 */
+	void BuildHistoryResult(FMissileTestSummary& OutSummary, TArray<FIndicatorEvaluationResult>& OutEvaluations) const;
+
+	FOnFinished OnFinished;
+
+private:
+	struct FWorker
+	{
+		int32 CellIndex = INDEX_NONE;
+		FProcHandle Process;
+		double StartSeconds = 0.0;
+	};
+
+	bool HandleTick(float DeltaTime);
+	bool LaunchCell(int32 CellIndex);
+	void CollectCell(int32 CellIndex, int32 ReturnCode);
+	void FinishBatch();
+
+	FString GetCellScenarioPath(int32 CellIndex) const;
+	FString GetCellResultPath(int32 CellIndex) const;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FScenarioTestConfig BaseConfig;
+	FOrthogonalDesign Design;
+	TArray<FOrthogonalCellResult> CellResults;
+	FMissileTestSummary Totals; // 全部有效运行的计数与时长之和
+	double FlightTimeShotSum = 0.0; // 各次平均飞行时间 * 发射数之和
+	FOrthogonalMainEffects MainEffects;
+	FString OutputDirectory;
+
+	TArray<FWorker> ActiveWorkers;
+	int32 NextCell = 0;
+	int32 FinishedCells = 0;
+	int32 FailedCells = 0;
+	int32 MaxWorkers = 1;
+	int32 RunsPerCell = 1;
+	int32 ShotsPerRun = 1;
+	float CellTimeoutSeconds = 0.f;
+	int32 BaseSeed = 0;
+	bool bHasResults = false;
+};
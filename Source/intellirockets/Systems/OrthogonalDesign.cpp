@@ -0,0 +1,411 @@
+#include "Systems/OrthogonalDesign.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// GF(s) 运算：s 为素数时按模 s；s == 4 时使用 GF(2^2)（加法为异或，乘法查对数表）
+	int32 GFAdd(int32 S, int32 A, int32 B)
+	{
+		return S == 4 ? (A ^ B) : (A + B) % S;
+	}
+
+	int32 GFMul(int32 S, int32 A, int32 B)
+	{
+		if (A == 0 || B == 0)
+		{
+			return 0;
+		}
+		if (S == 4)
+		{
+			static const int32 Log4[4] = { -1, 0, 1, 2 };
+			static const int32 Exp4[3] = { 1, 2, 3 };
+			return Exp4[(Log4[A] + Log4[B]) % 3];
+		}
+		return (A * B) % S;
+	}
+
+	/**
+	 * 构造 L_{s^n}：行取 GF(s)^n 的全部向量，列取首个非零分量为 1 的非零向量，元素为两者内积。
+	 * 任意两列线性无关，因此任意两列上每个水平组合恰好出现 s^(n-2) 次。
+	 */
+	FOrthogonalArray BuildGaloisArray(const TCHAR* Name, int32 S, int32 N)
+	{
+		FOrthogonalArray Array;
+		Array.Name = Name;
+		Array.Levels = S;
+
+		int32 Runs = 1;
+		for (int32 Index = 0; Index < N; ++Index)
+		{
+			Runs *= S;
+		}
+
+		auto ToVector = [S, N](int32 Value)
+		{
+			TArray<int32> Digits;
+			Digits.SetNumZeroed(N);
+			for (int32 Index = N - 1; Index >= 0; --Index)
+			{
+				Digits[Index] = Value % S;
+				Value /= S;
+			}
+			return Digits;
+		};
+
+		TArray<TArray<int32>> ColumnVectors;
+		for (int32 Value = 1; Value < Runs; ++Value)
+		{
+			TArray<int32> Vector = ToVector(Value);
+			for (int32 Component : Vector)
+			{
+				if (Component != 0)
+				{
+					if (Component == 1)
+					{
+						ColumnVectors.Add(MoveTemp(Vector));
+					}
+					break;
+				}
+			}
+		}
+
+		Array.Runs = Runs;
+		Array.Columns = ColumnVectors.Num();
+		Array.Cells.SetNumZeroed(Array.Runs * Array.Columns);
+		for (int32 Run = 0; Run < Runs; ++Run)
+		{
+			const TArray<int32> Row = ToVector(Run);
+			for (int32 Column = 0; Column < Array.Columns; ++Column)
+			{
+				int32 Sum = 0;
+				for (int32 Index = 0; Index < N; ++Index)
+				{
+					Sum = GFAdd(S, Sum, GFMul(S, Row[Index], ColumnVectors[Column][Index]));
+				}
+				Array.Cells[Run * Array.Columns + Column] = static_cast<uint8>(Sum);
+			}
+		}
+		return Array;
+	}
+
+	// 反制措施的水平：无 / 电磁干扰 / 通信干扰 / 全部
+	const TArray<int32>& GetCountermeasureLevel(int32 Level)
+	{
+		static const TArray<TArray<int32>> Levels = { {}, { 0 }, { 1 }, { 0, 1, 2 } };
+		return Levels[FMath::Clamp(Level, 0, Levels.Num() - 1)];
+	}
+
+	FString EscapeCsv(const FString& In)
+	{
+		if (In.Contains(TEXT(",")) || In.Contains(TEXT("\"")) || In.Contains(TEXT("\n")) || In.Contains(TEXT("\r")))
+		{
+			return FString::Printf(TEXT("\"%s\""), *In.Replace(TEXT("\""), TEXT("\"\"")));
+		}
+		return In;
+	}
+}
+
+FOrthogonalArray FOrthogonalArray::Build(EOrthogonalArrayType Type)
+{
+	switch (Type)
+	{
+	case EOrthogonalArrayType::L9:
+		return BuildGaloisArray(TEXT("L9(3^4)"), 3, 2);
+	case EOrthogonalArrayType::L16:
+		return BuildGaloisArray(TEXT("L16(4^5)"), 4, 2);
+	case EOrthogonalArrayType::L25:
+		return BuildGaloisArray(TEXT("L25(5^6)"), 5, 2);
+	case EOrthogonalArrayType::L27:
+	case EOrthogonalArrayType::Auto:
+	default:
+		return BuildGaloisArray(TEXT("L27(3^13)"), 3, 3);
+	}
+}
+
+namespace OrthogonalDesign
+{
+	int32 GetFactorLevelCount(EScenarioFactor Factor)
+	{
+		switch (Factor)
+		{
+		case EScenarioFactor::Weather: return 4;
+		case EScenarioFactor::Time: return 2;
+		case EScenarioFactor::Map: return 4;
+		case EScenarioFactor::Density: return 3;
+		case EScenarioFactor::Countermeasure: return 4;
+		case EScenarioFactor::EnemyForce: return 5;
+		case EScenarioFactor::EquipmentCapability: return 5;
+		case EScenarioFactor::TargetAccuracy: return 3;
+		default: return 1;
+		}
+	}
+
+	FString GetFactorName(EScenarioFactor Factor)
+	{
+		switch (Factor)
+		{
+		case EScenarioFactor::Weather: return TEXT("天气");
+		case EScenarioFactor::Time: return TEXT("时间");
+		case EScenarioFactor::Map: return TEXT("地图");
+		case EScenarioFactor::Density: return TEXT("目标密度");
+		case EScenarioFactor::Countermeasure: return TEXT("反制措施");
+		case EScenarioFactor::EnemyForce: return TEXT("敌方兵力");
+		case EScenarioFactor::EquipmentCapability: return TEXT("装备能力");
+		case EScenarioFactor::TargetAccuracy: return TEXT("目指准确性");
+		default: return TEXT("未知");
+		}
+	}
+
+	FString GetFactorLevelName(EScenarioFactor Factor, int32 Level)
+	{
+		static const TCHAR* WeatherNames[] = { TEXT("晴天"), TEXT("海杂波"), TEXT("气动热效应"), TEXT("雾天") };
+		static const TCHAR* TimeNames[] = { TEXT("白天"), TEXT("夜晚") };
+		static const TCHAR* MapNames[] = { TEXT("沙漠"), TEXT("森林"), TEXT("雪地"), TEXT("海边") };
+		static const TCHAR* DensityNames[] = { TEXT("密集"), TEXT("正常"), TEXT("稀疏") };
+		static const TCHAR* CountermeasureLevelNames[] = { TEXT("无"), TEXT("电磁干扰"), TEXT("通信干扰"), TEXT("全部") };
+		static const TCHAR* ForceNames[] = { TEXT("无防空系统"), TEXT("基础防空系统"), TEXT("加强型防空系统"), TEXT("高级防空系统"), TEXT("多层体系化防空系统") };
+		static const TCHAR* EquipmentNames[] = { TEXT("近程"), TEXT("中近程"), TEXT("中程"), TEXT("中远程"), TEXT("远程") };
+		static const TCHAR* AccuracyNames[] = { TEXT("高精度"), TEXT("中等精度"), TEXT("低精度") };
+
+		const int32 Clamped = FMath::Clamp(Level, 0, GetFactorLevelCount(Factor) - 1);
+		switch (Factor)
+		{
+		case EScenarioFactor::Weather: return WeatherNames[Clamped];
+		case EScenarioFactor::Time: return TimeNames[Clamped];
+		case EScenarioFactor::Map: return MapNames[Clamped];
+		case EScenarioFactor::Density: return DensityNames[Clamped];
+		case EScenarioFactor::Countermeasure: return CountermeasureLevelNames[Clamped];
+		case EScenarioFactor::EnemyForce: return ForceNames[Clamped];
+		case EScenarioFactor::EquipmentCapability: return EquipmentNames[Clamped];
+		case EScenarioFactor::TargetAccuracy: return AccuracyNames[Clamped];
+		default: return FString::FromInt(Level);
+		}
+	}
+
+	void ApplyFactorLevel(EScenarioFactor Factor, int32 Level, FScenarioTestConfig& InOutConfig)
+	{
+		switch (Factor)
+		{
+		case EScenarioFactor::Weather: InOutConfig.WeatherIndex = Level; break;
+		case EScenarioFactor::Time: InOutConfig.TimeIndex = Level; break;
+		case EScenarioFactor::Map: InOutConfig.MapIndex = Level; break;
+		case EScenarioFactor::Density: InOutConfig.DensityIndex = Level; break;
+		case EScenarioFactor::Countermeasure: InOutConfig.CountermeasureIndices = GetCountermeasureLevel(Level); break;
+		case EScenarioFactor::EnemyForce: InOutConfig.EnemyForceIndex = Level; break;
+		case EScenarioFactor::EquipmentCapability: InOutConfig.EquipmentCapabilityIndex = Level; break;
+		case EScenarioFactor::TargetAccuracy: InOutConfig.TargetAccuracyIndex = Level; break;
+		default: break;
+		}
+	}
+
+	int32 MapArrayLevel(int32 ArrayLevel, int32 ArrayLevels, int32 FactorLevels)
+	{
+		if (FactorLevels <= 1 || ArrayLevels <= 1)
+		{
+			return 0;
+		}
+		if (FactorLevels <= ArrayLevels)
+		{
+			// 拟水平法：多出的正交表水平循环映射回已有水平
+			return ArrayLevel % FactorLevels;
+		}
+		// 因素水平多于正交表水平：在全部水平中均匀抽取（包含两端）
+		return FMath::RoundToInt(static_cast<float>(ArrayLevel) * (FactorLevels - 1) / (ArrayLevels - 1));
+	}
+
+	EOrthogonalArrayType ChooseArrayType(int32 FactorCount)
+	{
+		if (FactorCount <= 4)
+		{
+			return EOrthogonalArrayType::L9;
+		}
+		if (FactorCount <= 5)
+		{
+			return EOrthogonalArrayType::L16;
+		}
+		if (FactorCount <= 6)
+		{
+			return EOrthogonalArrayType::L25;
+		}
+		return EOrthogonalArrayType::L27;
+	}
+
+	bool GenerateDesign(const FScenarioTestConfig& BaseConfig, const TArray<EScenarioFactor>& Factors, EOrthogonalArrayType Type, FOrthogonalDesign& OutDesign)
+	{
+		OutDesign = FOrthogonalDesign();
+
+		if (Factors.Num() > 0)
+		{
+			for (EScenarioFactor Factor : Factors)
+			{
+				OutDesign.Factors.AddUnique(Factor);
+			}
+		}
+		else
+		{
+			for (uint8 Index = 0; Index < static_cast<uint8>(EScenarioFactor::Count); ++Index)
+			{
+				OutDesign.Factors.Add(static_cast<EScenarioFactor>(Index));
+			}
+		}
+
+		if (Type == EOrthogonalArrayType::Auto)
+		{
+			Type = ChooseArrayType(OutDesign.Factors.Num());
+		}
+		OutDesign.Array = FOrthogonalArray::Build(Type);
+
+		if (OutDesign.Factors.Num() > OutDesign.Array.Columns)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[Orthogonal] %s has only %d columns, cannot place %d factors"),
+				*OutDesign.Array.Name, OutDesign.Array.Columns, OutDesign.Factors.Num());
+			return false;
+		}
+
+		const int32 ArrayLevels = OutDesign.Array.Levels;
+		for (int32 Run = 0; Run < OutDesign.Array.Runs; ++Run)
+		{
+			FScenarioTestConfig CellConfig = BaseConfig;
+			CellConfig.TestMethodTypeIndex = 1;
+			CellConfig.bBlueCustomDeployment = false;
+			CellConfig.PresetIndex = -1;
+
+			TArray<int32>& Levels = OutDesign.CellLevels.AddDefaulted_GetRef();
+			for (int32 FactorIndex = 0; FactorIndex < OutDesign.Factors.Num(); ++FactorIndex)
+			{
+				const EScenarioFactor Factor = OutDesign.Factors[FactorIndex];
+				const int32 Level = MapArrayLevel(OutDesign.Array.Get(Run, FactorIndex), ArrayLevels, GetFactorLevelCount(Factor));
+				ApplyFactorLevel(Factor, Level, CellConfig);
+				Levels.Add(Level);
+			}
+			CellConfig.MapLevelName = NAME_None;
+			OutDesign.Cells.Add(MoveTemp(CellConfig));
+		}
+		return true;
+	}
+
+	void ComputeMainEffects(const FOrthogonalDesign& Design, const TArray<FOrthogonalCellResult>& CellResults, FOrthogonalMainEffects& OutEffects)
+	{
+		OutEffects = FOrthogonalMainEffects();
+		OutEffects.ArrayName = Design.Array.Name;
+		OutEffects.CellCount = Design.Cells.Num();
+
+		// 响应按首次出现的顺序排列（命中率、达标率在前，各指标在后）
+		TArray<FString> ResponseIds;
+		for (const FOrthogonalCellResult& Cell : CellResults)
+		{
+			if (!Cell.bCompleted)
+			{
+				continue;
+			}
+			++OutEffects.CompletedCells;
+			for (const TPair<FString, TArray<float>>& Pair : Cell.Samples)
+			{
+				ResponseIds.AddUnique(Pair.Key);
+			}
+		}
+
+		for (const FString& ResponseId : ResponseIds)
+		{
+			FOrthogonalResponseEffects& Response = OutEffects.Responses.AddDefaulted_GetRef();
+			Response.Id = ResponseId;
+			Response.Name = ResponseId;
+
+			for (int32 FactorIndex = 0; FactorIndex < Design.Factors.Num(); ++FactorIndex)
+			{
+				const EScenarioFactor Factor = Design.Factors[FactorIndex];
+				const int32 LevelCount = GetFactorLevelCount(Factor);
+
+				TArray<double> Sums;
+				Sums.SetNumZeroed(LevelCount);
+				FOrthogonalFactorEffect& Effect = Response.Factors.AddDefaulted_GetRef();
+				Effect.Factor = Factor;
+				Effect.LevelSamples.SetNumZeroed(LevelCount);
+
+				for (int32 CellIndex = 0; CellIndex < CellResults.Num() && CellIndex < Design.CellLevels.Num(); ++CellIndex)
+				{
+					const FOrthogonalCellResult& Cell = CellResults[CellIndex];
+					const TArray<float>* Samples = Cell.bCompleted ? Cell.Samples.Find(ResponseId) : nullptr;
+					if (!Samples || Samples->Num() == 0)
+					{
+						continue;
+					}
+					if (const FString* Name = Cell.ResponseNames.Find(ResponseId))
+					{
+						Response.Name = *Name;
+					}
+					if (const bool* bHigher = Cell.ResponseHigherIsBetter.Find(ResponseId))
+					{
+						Response.bHigherIsBetter = *bHigher;
+					}
+
+					double CellSum = 0.0;
+					for (float Sample : *Samples)
+					{
+						CellSum += Sample;
+					}
+					const int32 Level = Design.CellLevels[CellIndex][FactorIndex];
+					Sums[Level] += CellSum / Samples->Num();
+					++Effect.LevelSamples[Level];
+				}
+
+				float MinMean = TNumericLimits<float>::Max();
+				float MaxMean = TNumericLimits<float>::Lowest();
+				Effect.LevelMeans.SetNum(LevelCount);
+				for (int32 Level = 0; Level < LevelCount; ++Level)
+				{
+					if (Effect.LevelSamples[Level] == 0)
+					{
+						Effect.LevelMeans[Level] = NAN;
+						continue;
+					}
+					const float Mean = static_cast<float>(Sums[Level] / Effect.LevelSamples[Level]);
+					Effect.LevelMeans[Level] = Mean;
+					const bool bBetter = Effect.BestLevel == INDEX_NONE
+						|| (Response.bHigherIsBetter ? Mean > Effect.LevelMeans[Effect.BestLevel] : Mean < Effect.LevelMeans[Effect.BestLevel]);
+					if (bBetter)
+					{
+						Effect.BestLevel = Level;
+					}
+					MinMean = FMath::Min(MinMean, Mean);
+					MaxMean = FMath::Max(MaxMean, Mean);
+				}
+				Effect.Range = Effect.BestLevel != INDEX_NONE ? MaxMean - MinMean : 0.f;
+			}
+
+			Response.Factors.Sort([](const FOrthogonalFactorEffect& A, const FOrthogonalFactorEffect& B)
+			{
+				return A.Range > B.Range;
+			});
+		}
+	}
+
+	bool ExportMainEffectsCsv(const FOrthogonalMainEffects& Effects, const FString& FilePath)
+	{
+		FString Csv = TEXT("响应,因素,极差R,最优水平,水平,均值,样本单元数\n");
+		for (const FOrthogonalResponseEffects& Response : Effects.Responses)
+		{
+			for (const FOrthogonalFactorEffect& Effect : Response.Factors)
+			{
+				const FString BestName = Effect.BestLevel != INDEX_NONE ? GetFactorLevelName(Effect.Factor, Effect.BestLevel) : TEXT("-");
+				for (int32 Level = 0; Level < Effect.LevelMeans.Num(); ++Level)
+				{
+					const bool bHasSamples = Effect.LevelSamples.IsValidIndex(Level) && Effect.LevelSamples[Level] > 0;
+					Csv += FString::Printf(TEXT("%s,%s,%.4f,%s,%s,%s,%d\n"),
+						*EscapeCsv(Response.Name),
+						*GetFactorName(Effect.Factor),
+						Effect.Range,
+						*EscapeCsv(BestName),
+						*EscapeCsv(GetFactorLevelName(Effect.Factor, Level)),
+						bHasSamples ? *FString::Printf(TEXT("%.4f"), Effect.LevelMeans[Level]) : TEXT(""),
+						bHasSamples ? Effect.LevelSamples[Level] : 0);
+				}
+			}
+		}
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+		return FFileHelper::SaveStringToFile(Csv, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8);
+	}
+}
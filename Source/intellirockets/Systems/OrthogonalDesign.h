@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/SScenarioScreen.h"
+
+/**
+ * 正交试验设计（正交测试方法，TestMethodTypeIndex == 1）：
+ * - 在有限域 GF(s) 上构造 L9(3^4) / L16(4^5) / L25(5^6) / L27(3^13) 正交表；
+ * - 把 FScenarioTestConfig 中的环境/编队因素分配到正交表的列上，生成每个试验单元的场景配置；
+ * - 汇总各单元结果，按因素水平求均值并做极差分析（主效应表）。
+ */
+
+/** 参与正交设计的场景因素 */
+enum class EScenarioFactor : uint8
+{
+	Weather,
+	Time,
+	Map,
+	Density,
+	Countermeasure,
+	EnemyForce,
+	EquipmentCapability,
+	TargetAccuracy,
+	Count
+};
+
+enum class EOrthogonalArrayType : uint8
+{
+	Auto,
+	L9,
+	L16,
+	L25,
+	L27,
+};
+
+struct FOrthogonalArray
+{
+	FString Name;
+	int32 Levels = 0;
+	int32 Runs = 0;
+	int32 Columns = 0;
+	TArray<uint8> Cells; // 行优先，Runs * Columns
+
+	int32 Get(int32 Run, int32 Column) const { return Cells[Run * Columns + Column]; }
+
+	/** 构造指定类型的正交表（Auto 视为 L27） */
+	static FOrthogonalArray Build(EOrthogonalArrayType Type);
+};
+
+struct FOrthogonalDesign
+{
+	FOrthogonalArray Array;
+	TArray<EScenarioFactor> Factors;
+	TArray<TArray<int32>> CellLevels; // [单元][因素] -> 因素实际水平
+	TArray<FScenarioTestConfig> Cells;
+};
+
+/** 单个响应（命中率或某项指标）的主效应 */
+struct FOrthogonalFactorEffect
+{
+	EScenarioFactor Factor = EScenarioFactor::Weather;
+	TArray<float> LevelMeans; // 各水平均值，无样本的水平为 NaN
+	TArray<int32> LevelSamples;
+	float Range = 0.f; // 极差 R，越大说明该因素影响越显著
+	int32 BestLevel = INDEX_NONE;
+};
+
+struct FOrthogonalResponseEffects
+{
+	FString Id;
+	FString Name;
+	bool bHigherIsBetter = true;
+	TArray<FOrthogonalFactorEffect> Factors; // 按极差从大到小排序
+};
+
+struct FOrthogonalMainEffects
+{
+	FString ArrayName;
+	int32 CellCount = 0;
+	int32 CompletedCells = 0;
+	TArray<FOrthogonalResponseEffects> Responses;
+};
+
+/** 单元的测量结果：响应 Id -> 各轮数值 */
+struct FOrthogonalCellResult
+{
+	bool bCompleted = false;
+	TMap<FString, TArray<float>> Samples;
+	TMap<FString, FString> ResponseNames;
+	TMap<FString, bool> ResponseHigherIsBetter;
+	TMap<FString, float> ResponseTargets; // 指标目标值（命中率与达标率没有目标值）
+};
+
+namespace OrthogonalDesign
+{
+	int32 GetFactorLevelCount(EScenarioFactor Factor);
+	FString GetFactorName(EScenarioFactor Factor);
+	FString GetFactorLevelName(EScenarioFactor Factor, int32 Level);
+
+	/** 把因素水平写入配置 */
+	void ApplyFactorLevel(EScenarioFactor Factor, int32 Level, FScenarioTestConfig& InOutConfig);
+
+	/** 正交表水平映射为因素水平：因素水平少于正交表时取拟水平，多于时均匀抽取 */
+	int32 MapArrayLevel(int32 ArrayLevel, int32 ArrayLevels, int32 FactorLevels);
+
+	/** 选择可容纳全部因素且试验次数最少的正交表 */
+	EOrthogonalArrayType ChooseArrayType(int32 FactorCount);
+
+	/** 以 BaseConfig 为模板生成试验单元；Factors 为空时使用全部因素 */
+	bool GenerateDesign(const FScenarioTestConfig& BaseConfig, const TArray<EScenarioFactor>& Factors, EOrthogonalArrayType Type, FOrthogonalDesign& OutDesign);
+
+	/** 根据各单元结果计算主效应（极差分析） */
+	void ComputeMainEffects(const FOrthogonalDesign& Design, const TArray<FOrthogonalCellResult>& CellResults, FOrthogonalMainEffects& OutEffects);
+
+	/** 主效应表导出为 CSV（UTF-8 BOM，便于 Excel 打开） */
+	bool ExportMainEffectsCsv(const FOrthogonalMainEffects& Effects, const FString& FilePath);
+}
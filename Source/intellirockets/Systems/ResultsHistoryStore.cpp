@@ -0,0 +1,361 @@
+#include "Systems/ResultsHistoryStore.h"
+
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/ScenarioHeadlessRunner.h"
+#include "Algo/Reverse.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarHistoryRecord(
+		TEXT("ir.History.Record"),
+		1,
+		TEXT("1: 测试结束后把配置、汇总与指标评估追加到 Saved/ResultsHistory，供 Step5 历史趋势查询"));
+
+	constexpr uint32 IndexFileMagic = 0x49485249; // "IRHI"
+	constexpr uint32 IndexFileVersion = 1;
+	constexpr int64 IndexHeaderSize = sizeof(uint32) * 2;
+	// Timestamp + ConfigHash + AlgorithmMask + 4 个下标 + TotalShots + 4 个指标 + DetailOffset + DetailSize
+	constexpr int64 IndexEntrySize = 8 + 4 + 8 + 4 + 4 + 16 + 8 + 4;
+	constexpr int32 MaxAlgorithms = 64;
+
+	FString GetHistoryDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ResultsHistory");
+	}
+
+	FString GetIndexPath() { return GetHistoryDir() / TEXT("sessions.irhi"); }
+	FString GetDetailPath() { return GetHistoryDir() / TEXT("sessions.irhd"); }
+	FString GetAlgorithmPath() { return GetHistoryDir() / TEXT("algorithms.txt"); }
+
+	/** 读写共用，字段顺序即文件格式 */
+	void SerializeEntry(FArchive& Ar, FResultsHistoryEntry& Entry)
+	{
+		int64 Ticks = Entry.Timestamp.GetTicks();
+		Ar << Ticks;
+		Ar << Entry.ConfigHash;
+		Ar << Entry.AlgorithmMask;
+		Ar << Entry.MapIndex;
+		Ar << Entry.WeatherIndex;
+		Ar << Entry.TimeIndex;
+		Ar << Entry.DensityIndex;
+		Ar << Entry.TotalShots;
+		Ar << Entry.HitRate;
+		Ar << Entry.DirectHitRate;
+		Ar << Entry.AverageFlightTime;
+		Ar << Entry.SessionDuration;
+		Ar << Entry.DetailOffset;
+		Ar << Entry.DetailSize;
+		if (Ar.IsLoading())
+		{
+			Entry.Timestamp = FDateTime(Ticks);
+		}
+	}
+
+	FString ToCondensedJson(const TSharedRef<FJsonObject>& JsonObject)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Out;
+	}
+
+	TSharedPtr<FJsonObject> ReadDetails(FArchive& Reader, const FResultsHistoryEntry& Entry)
+	{
+		if (Entry.DetailSize <= 0 || Entry.DetailOffset + Entry.DetailSize > Reader.TotalSize())
+		{
+			return nullptr;
+		}
+
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(Entry.DetailSize);
+		Reader.Seek(Entry.DetailOffset);
+		Reader.Serialize(Bytes.GetData(), Bytes.Num());
+		if (Reader.IsError())
+		{
+			return nullptr;
+		}
+
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		const FString JsonString(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonObject))
+		{
+			return nullptr;
+		}
+		return JsonObject;
+	}
+}
+
+bool FResultsHistoryStore::IsEnabled()
+{
+	// 正交试验的工作进程并行运行，各自的结果由主进程汇总，不在这里追加以免多个进程同时写入
+	return CVarHistoryRecord.GetValueOnGameThread() != 0 && !FScenarioHeadlessRunner::IsRequested();
+}
+
+uint32 FResultsHistoryStore::ComputeConfigHash(const FScenarioTestConfig& Config)
+{
+	return FCrc::StrCrc32(*ToCondensedJson(ScenarioConfigIO::ConfigToJson(Config)));
+}
+
+void FResultsHistoryStore::EnsureLoaded() const
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+	Entries.Reset();
+	Algorithms.Reset();
+
+	FFileHelper::LoadFileToStringArray(Algorithms, *GetAlgorithmPath());
+
+	TArray<uint8> IndexBytes;
+	if (!FFileHelper::LoadFileToArray(IndexBytes, *GetIndexPath(), FILEREAD_Silent) || IndexBytes.Num() < IndexHeaderSize)
+	{
+		return;
+	}
+
+	FMemoryReader Reader(IndexBytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != IndexFileMagic || Version != IndexFileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ResultsHistory: index file has unknown format, ignored"));
+		return;
+	}
+
+	const int64 DetailFileSize = FMath::Max<int64>(IFileManager::Get().FileSize(*GetDetailPath()), 0);
+
+	// 末尾残缺的索引项（写入中断）不计入
+	const int64 EntryCount = (IndexBytes.Num() - IndexHeaderSize) / IndexEntrySize;
+	Entries.Reserve(static_cast<int32>(EntryCount));
+	for (int64 Index = 0; Index < EntryCount; ++Index)
+	{
+		FResultsHistoryEntry Entry;
+		SerializeEntry(Reader, Entry);
+		if (Reader.IsError() || Entry.DetailOffset + Entry.DetailSize > DetailFileSize)
+		{
+			break;
+		}
+		Entries.Add(Entry);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ResultsHistory: loaded %d sessions"), Entries.Num());
+}
+
+int32 FResultsHistoryStore::GetEntryCount() const
+{
+	EnsureLoaded();
+	return Entries.Num();
+}
+
+int32 FResultsHistoryStore::FindOrAddAlgorithm(const FString& Name)
+{
+	const int32 Existing = Algorithms.IndexOfByKey(Name);
+	if (Existing != INDEX_NONE || Algorithms.Num() >= MaxAlgorithms)
+	{
+		return Existing;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Name + LINE_TERMINATOR, *GetAlgorithmPath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		return INDEX_NONE;
+	}
+	return Algorithms.Add(Name);
+}
+
+bool FResultsHistoryStore::BuildAlgorithmMask(const TArray<FString>& Names, uint64& OutMask) const
+{
+	OutMask = 0;
+	for (const FString& Name : Names)
+	{
+		const int32 Bit = Algorithms.IndexOfByKey(Name);
+		if (Bit == INDEX_NONE)
+		{
+			return false;
+		}
+		OutMask |= (1ull << Bit);
+	}
+	return true;
+}
+
+int32 FResultsHistoryStore::Append(const FScenarioTestConfig& Config, const FMissileTestSummary& Summary, const TArray<FIndicatorEvaluationResult>& Evaluations, const FResultsHistoryArtifacts& Artifacts)
+{
+	EnsureLoaded();
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString Directory = GetHistoryDir();
+	if (!FileManager.MakeDirectory(*Directory, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ResultsHistory: failed to create %s"), *Directory);
+		return INDEX_NONE;
+	}
+
+	FResultsHistoryEntry Entry;
+	Entry.Timestamp = FDateTime::Now();
+	Entry.ConfigHash = ComputeConfigHash(Config);
+	Entry.MapIndex = static_cast<int8>(Config.MapIndex);
+	Entry.WeatherIndex = static_cast<int8>(Config.WeatherIndex);
+	Entry.TimeIndex = static_cast<int8>(Config.TimeIndex);
+	Entry.DensityIndex = static_cast<int8>(Config.DensityIndex);
+	Entry.TotalShots = Summary.TotalShots;
+	Entry.HitRate = Summary.HitRate;
+	Entry.DirectHitRate = Summary.DirectHitRate;
+	Entry.AverageFlightTime = Summary.AverageFlightTime;
+	Entry.SessionDuration = Summary.SessionDuration;
+
+	for (const FString& Name : Config.SelectedAlgorithmNames)
+	{
+		const int32 Bit = FindOrAddAlgorithm(Name);
+		if (Bit == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ResultsHistory: algorithm %s not indexed (dictionary full)"), *Name);
+			continue;
+		}
+		Entry.AlgorithmMask |= (1ull << Bit);
+	}
+
+	// 详情：与 Step5 导出的 summary.json 使用相同的字段
+	TSharedRef<FJsonObject> Details = MakeShareable(new FJsonObject);
+	Details->SetStringField(TEXT("timestamp"), Entry.Timestamp.ToIso8601());
+	Details->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Config));
+	Details->SetObjectField(TEXT("summary"), ScenarioConfigIO::SummaryToJson(Summary));
+	TArray<TSharedPtr<FJsonValue>> EvaluationArray;
+	for (const FIndicatorEvaluationResult& Evaluation : Evaluations)
+	{
+		EvaluationArray.Add(MakeShareable(new FJsonValueObject(ScenarioConfigIO::EvaluationToJson(Evaluation))));
+	}
+	Details->SetArrayField(TEXT("evaluations"), EvaluationArray);
+	TSharedRef<FJsonObject> ArtifactObject = MakeShareable(new FJsonObject);
+	ArtifactObject->SetStringField(TEXT("telemetry"), Artifacts.TelemetryFile);
+	ArtifactObject->SetStringField(TEXT("replay"), Artifacts.ReplayFile);
+	ArtifactObject->SetStringField(TEXT("timeline"), Artifacts.TimelineFile);
+	Details->SetObjectField(TEXT("artifacts"), ArtifactObject);
+	if (!Artifacts.BatchKind.IsEmpty())
+	{
+		TSharedRef<FJsonObject> BatchObject = MakeShareable(new FJsonObject);
+		BatchObject->SetStringField(TEXT("kind"), Artifacts.BatchKind);
+		BatchObject->SetNumberField(TEXT("runs"), Artifacts.BatchRuns);
+		BatchObject->SetStringField(TEXT("result"), Artifacts.BatchResultFile);
+		Details->SetObjectField(TEXT("batch"), BatchObject);
+	}
+
+	const FTCHARToUTF8 Utf8(*ToCondensedJson(Details));
+	const FString DetailPath = GetDetailPath();
+	Entry.DetailOffset = FMath::Max<int64>(FileManager.FileSize(*DetailPath), 0);
+	Entry.DetailSize = Utf8.Length();
+
+	// 先写详情再写索引：索引项存在即说明详情已完整落盘
+	{
+		TUniquePtr<FArchive> DetailWriter(FileManager.CreateFileWriter(*DetailPath, FILEWRITE_Append));
+		if (!DetailWriter)
+		{
+			UE_LOG(LogTemp, Error, TEXT("ResultsHistory: failed to open %s"), *DetailPath);
+			return INDEX_NONE;
+		}
+		DetailWriter->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+		if (!DetailWriter->Close())
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	// 索引文件长度必须正好是文件头加上已加载的索引项，否则（写入中断留下的残缺项、加载时被忽略的项、
+	// 未知格式）直接追加会让之后的所有索引项错位，此时用内存中的有效索引项重写整个文件
+	const FString IndexPath = GetIndexPath();
+	const int64 ExpectedIndexSize = IndexHeaderSize + Entries.Num() * IndexEntrySize;
+	const int64 IndexFileSize = FileManager.FileSize(*IndexPath);
+	const bool bRewriteIndex = IndexFileSize != ExpectedIndexSize;
+	if (bRewriteIndex && IndexFileSize > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ResultsHistory: index size %lld does not match %d sessions, rewriting"), IndexFileSize, Entries.Num());
+	}
+
+	TUniquePtr<FArchive> IndexWriter(FileManager.CreateFileWriter(*IndexPath, bRewriteIndex ? 0 : FILEWRITE_Append));
+	if (!IndexWriter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ResultsHistory: failed to open %s"), *IndexPath);
+		return INDEX_NONE;
+	}
+	if (bRewriteIndex)
+	{
+		uint32 Magic = IndexFileMagic;
+		uint32 Version = IndexFileVersion;
+		*IndexWriter << Magic;
+		*IndexWriter << Version;
+		for (FResultsHistoryEntry& Existing : Entries)
+		{
+			SerializeEntry(*IndexWriter, Existing);
+		}
+	}
+	SerializeEntry(*IndexWriter, Entry);
+	if (!IndexWriter->Close())
+	{
+		return INDEX_NONE;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ResultsHistory: appended session #%d (hash %08x)"), Entries.Num(), Entry.ConfigHash);
+	return Entries.Add(Entry);
+}
+
+void FResultsHistoryStore::Query(const FResultsHistoryQuery& InQuery, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	EnsureLoaded();
+
+	uint64 RequiredMask = 0;
+	if (!BuildAlgorithmMask(InQuery.RequiredAlgorithms, RequiredMask))
+	{
+		return; // 从未记录过的算法
+	}
+
+	// 从最新的一条往前扫描，便于 MaxResults 提前结束
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		const FResultsHistoryEntry& Entry = Entries[Index];
+		if ((InQuery.MapIndex != INDEX_NONE && Entry.MapIndex != InQuery.MapIndex)
+			|| (InQuery.WeatherIndex != INDEX_NONE && Entry.WeatherIndex != InQuery.WeatherIndex)
+			|| (InQuery.TimeIndex != INDEX_NONE && Entry.TimeIndex != InQuery.TimeIndex)
+			|| (InQuery.ConfigHash != 0 && Entry.ConfigHash != InQuery.ConfigHash)
+			|| (Entry.AlgorithmMask & RequiredMask) != RequiredMask
+			|| Entry.Timestamp < InQuery.From
+			|| Entry.Timestamp > InQuery.To)
+		{
+			continue;
+		}
+
+		OutIndices.Add(Index);
+		if (InQuery.MaxResults > 0 && OutIndices.Num() >= InQuery.MaxResults)
+		{
+			break;
+		}
+	}
+
+	Algo::Reverse(OutIndices);
+}
+
+TSharedPtr<FJsonObject> FResultsHistoryStore::LoadDetails(int32 Index) const
+{
+	EnsureLoaded();
+	if (!Entries.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetDetailPath()));
+	return Reader ? ReadDetails(*Reader, Entries[Index]) : nullptr;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+class FJsonObject;
+
+/** 单次会话的索引项：只含筛选字段与关键指标，详情按偏移从数据文件读取 */
+struct FResultsHistoryEntry
+{
+	FDateTime Timestamp;
+	uint32 ConfigHash = 0;
+	uint64 AlgorithmMask = 0; // 算法名称字典中的位
+	int8 MapIndex = INDEX_NONE;
+	int8 WeatherIndex = INDEX_NONE;
+	int8 TimeIndex = INDEX_NONE;
+	int8 DensityIndex = INDEX_NONE;
+	int32 TotalShots = 0;
+	float HitRate = 0.f;
+	float DirectHitRate = 0.f;
+	float AverageFlightTime = 0.f;
+	float SessionDuration = 0.f;
+	int64 DetailOffset = 0;
+	int32 DetailSize = 0;
+};
+
+/** 查询条件：INDEX_NONE / 空 / 0 表示不限 */
+struct FResultsHistoryQuery
+{
+	int32 MapIndex = INDEX_NONE;
+	int32 WeatherIndex = INDEX_NONE;
+	int32 TimeIndex = INDEX_NONE;
+	uint32 ConfigHash = 0;
+	TArray<FString> RequiredAlgorithms; // 会话的算法集合须包含这些算法
+	FDateTime From = FDateTime::MinValue();
+	FDateTime To = FDateTime::MaxValue();
+	int32 MaxResults = 0; // > 0 时只返回最新的 N 条
+};
+
+/** 会话附带的文件（遥测、回放、时间线），未生成的为空 */
+struct FResultsHistoryArtifacts
+{
+	FString TelemetryFile;
+	FString ReplayFile;
+	FString TimelineFile;
+	FString BatchKind; // 批量运行的聚合条目（MonteCarlo / Orthogonal），单次会话为空
+	FString BatchResultFile; // 批量运行的汇总文件
+	int32 BatchRuns = 0; // 聚合的有效运行次数
+};
+
+/**
+ * 跨会话的测试结果历史（Saved/ResultsHistory）：
+ * - sessions.irhd：追加写入的详情（配置、汇总、指标评估、附带文件路径），每条为一段 UTF-8 JSON；
+ * - sessions.irhi：追加写入的定长索引项（时间、配置哈希、算法位图、地图/天气/时间、关键指标、详情偏移），
+ *   启动后一次性读入内存，数万条会话的筛选只在内存中完成；
+ * - algorithms.txt：算法名称字典，行号即 AlgorithmMask 中的位（最多 64 种）。
+ * 先写详情再写索引，中断写入时残缺的索引项或越界的详情在加载时被忽略，下一次追加时按有效索引项重写索引文件。
+ * 单写入者：无界面工作进程不追加（其结果写入各自的结果文件）；蒙特卡洛/正交批量运行的各轮不逐轮追加，
+ * 批量结束时追加一条聚合条目（详情中带 batch 字段）。
+ */
+class FResultsHistoryStore
+{
+public:
+	/** ir.History.Record */
+	static bool IsEnabled();
+	static uint32 ComputeConfigHash(const FScenarioTestConfig& Config);
+
+	/** 追加一次会话，返回索引下标；失败返回 INDEX_NONE */
+	int32 Append(const FScenarioTestConfig& Config, const FMissileTestSummary& Summary, const TArray<FIndicatorEvaluationResult>& Evaluations, const FResultsHistoryArtifacts& Artifacts);
+
+	/** 按时间顺序返回匹配的索引下标 */
+	void Query(const FResultsHistoryQuery& Query, TArray<int32>& OutIndices) const;
+
+	int32 GetEntryCount() const;
+	const FResultsHistoryEntry& GetEntry(int32 Index) const { return Entries[Index]; }
+
+	/** 读取单条会话详情（config / summary / evaluations / artifacts） */
+	TSharedPtr<FJsonObject> LoadDetails(int32 Index) const;
+
+private:
+	void EnsureLoaded() const;
+	int32 FindOrAddAlgorithm(const FString& Name);
+	bool BuildAlgorithmMask(const TArray<FString>& Names, uint64& OutMask) const;
+
+	mutable bool bLoaded = false;
+	mutable TArray<FResultsHistoryEntry> Entries;
+	mutable TArray<FString> Algorithms;
+};
@@ -0,0 +1,258 @@
+#include "Systems/ScenarioActorRegistry.h"
+
+#include "Engine/DirectionalLight.h"
+#include "Engine/ExponentialHeightFog.h"
+#include "Engine/Level.h"
+#include "Engine/PostProcessVolume.h"
+#include "Engine/SkyLight.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	constexpr int32 RoleCount = static_cast<int32>(EScenarioActorRole::Count);
+
+	void ClassifyActor(const AActor* Actor, TArray<EScenarioActorRole, TInlineAllocator<2>>& OutRoles)
+	{
+		if (Actor->IsA<ADirectionalLight>())
+		{
+			OutRoles.Add(EScenarioActorRole::DirectionalLight);
+		}
+		else if (Actor->IsA<ASkyLight>())
+		{
+			OutRoles.Add(EScenarioActorRole::SkyLight);
+		}
+		else if (Actor->IsA<AExponentialHeightFog>())
+		{
+			OutRoles.Add(EScenarioActorRole::HeightFog);
+		}
+		else if (Actor->IsA<APostProcessVolume>())
+		{
+			OutRoles.Add(EScenarioActorRole::PostProcessVolume);
+		}
+		else if (Actor->IsA<APlayerStart>())
+		{
+			OutRoles.Add(EScenarioActorRole::PlayerStart);
+		}
+
+		// 名称规则与原先的全世界扫描保持一致
+		const FString ActorName = Actor->GetName();
+		if (ActorName.StartsWith(TEXT("BP_")) && ActorName.Contains(TEXT("BluePotentialDeployLocation")))
+		{
+			OutRoles.Add(EScenarioActorRole::DeployMarker);
+		}
+		if (ActorName.Contains(TEXT("BP_BlueRocketSpawn")))
+		{
+			OutRoles.Add(EScenarioActorRole::RocketSpawnAnchor);
+		}
+		if (ActorName.Contains(TEXT("BP_BlueDefendZone")))
+		{
+			OutRoles.Add(EScenarioActorRole::DefendZoneAnchor);
+		}
+	}
+}
+
+FScenarioActorRegistry::~FScenarioActorRegistry()
+{
+	Reset();
+}
+
+void FScenarioActorRegistry::EnsureWorld(UWorld* World)
+{
+	if (!World || IndexedWorld.Get() == World)
+	{
+		return;
+	}
+
+	Reset();
+	IndexedWorld = World;
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	int32 ScannedCount = 0;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		RegisterActor(*It);
+		++ScannedCount;
+	}
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FScenarioActorRegistry::HandleActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FScenarioActorRegistry::HandleActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FScenarioActorRegistry::HandleLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FScenarioActorRegistry::HandleLevelRemoved);
+
+	UE_LOG(LogTemp, Log, TEXT("ScenarioActorRegistry: indexed %d/%d actors in world %s (%.2f ms)"),
+		IndexedActors.Num(), ScannedCount, *World->GetName(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
+
+void FScenarioActorRegistry::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsPendingKillPending() || IndexedActors.Contains(Actor))
+	{
+		return;
+	}
+
+	TArray<EScenarioActorRole, TInlineAllocator<2>> Roles;
+	ClassifyActor(Actor, Roles);
+	if (Roles.Num() == 0 && Actor->Tags.Num() == 0)
+	{
+		return;
+	}
+
+	IndexedActors.Add(Actor);
+	for (EScenarioActorRole Role : Roles)
+	{
+		RoleActors[static_cast<int32>(Role)].Add(Actor);
+	}
+	for (const FName& Tag : Actor->Tags)
+	{
+		if (!Tag.IsNone())
+		{
+			TagActors.FindOrAdd(Tag).AddUnique(Actor);
+		}
+	}
+}
+
+void FScenarioActorRegistry::UnregisterActor(AActor* Actor)
+{
+	const TWeakObjectPtr<AActor> Key(Actor);
+	if (!Actor || !IndexedActors.Remove(Key))
+	{
+		return;
+	}
+
+	for (int32 RoleIndex = 0; RoleIndex < RoleCount; ++RoleIndex)
+	{
+		RoleActors[RoleIndex].Remove(Key);
+	}
+	for (const FName& Tag : Actor->Tags)
+	{
+		if (TArray<TWeakObjectPtr<AActor>>* Entries = TagActors.Find(Tag))
+		{
+			Entries->Remove(Key);
+		}
+	}
+}
+
+void FScenarioActorRegistry::HandleActorSpawned(AActor* Actor)
+{
+	RegisterActor(Actor);
+}
+
+void FScenarioActorRegistry::HandleActorDestroyed(AActor* Actor)
+{
+	UnregisterActor(Actor);
+}
+
+void FScenarioActorRegistry::HandleLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != IndexedWorld.Get())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterActor(Actor);
+	}
+}
+
+void FScenarioActorRegistry::HandleLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != IndexedWorld.Get())
+	{
+		return;
+	}
+
+	// Level 为空表示整个世界正在拆除
+	if (!Level)
+	{
+		Reset();
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		UnregisterActor(Actor);
+	}
+}
+
+void FScenarioActorRegistry::PruneInvalid(TArray<TWeakObjectPtr<AActor>>& Entries)
+{
+	Entries.RemoveAll([](const TWeakObjectPtr<AActor>& Entry)
+	{
+		return !Entry.IsValid() || Entry->IsPendingKillPending();
+	});
+}
+
+void FScenarioActorRegistry::GetActors(UWorld* World, EScenarioActorRole Role, TArray<AActor*>& OutActors)
+{
+	OutActors.Reset();
+	if (Role == EScenarioActorRole::Count)
+	{
+		return;
+	}
+
+	EnsureWorld(World);
+	TArray<TWeakObjectPtr<AActor>>& Entries = RoleActors[static_cast<int32>(Role)];
+	PruneInvalid(Entries);
+	OutActors.Reserve(Entries.Num());
+	for (const TWeakObjectPtr<AActor>& Entry : Entries)
+	{
+		OutActors.Add(Entry.Get());
+	}
+}
+
+AActor* FScenarioActorRegistry::GetFirst(UWorld* World, EScenarioActorRole Role)
+{
+	if (Role == EScenarioActorRole::Count)
+	{
+		return nullptr;
+	}
+
+	EnsureWorld(World);
+	TArray<TWeakObjectPtr<AActor>>& Entries = RoleActors[static_cast<int32>(Role)];
+	PruneInvalid(Entries);
+	return Entries.Num() > 0 ? Entries[0].Get() : nullptr;
+}
+
+void FScenarioActorRegistry::AppendActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors)
+{
+	EnsureWorld(World);
+	TArray<TWeakObjectPtr<AActor>>* Entries = TagActors.Find(Tag);
+	if (!Entries)
+	{
+		return;
+	}
+
+	PruneInvalid(*Entries);
+	for (const TWeakObjectPtr<AActor>& Entry : *Entries)
+	{
+		OutActors.AddUnique(Entry.Get());
+	}
+}
+
+void FScenarioActorRegistry::Reset()
+{
+	if (UWorld* World = IndexedWorld.Get())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+	LevelAddedHandle.Reset();
+	LevelRemovedHandle.Reset();
+
+	IndexedWorld.Reset();
+	for (int32 RoleIndex = 0; RoleIndex < RoleCount; ++RoleIndex)
+	{
+		RoleActors[RoleIndex].Reset();
+	}
+	TagActors.Reset();
+	IndexedActors.Reset();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+/** 场景相关 Actor 的角色 */
+enum class EScenarioActorRole : uint8
+{
+	DeployMarker,       // 名称匹配 BP_BluePotentialDeployLocation（未打标签时的回退）
+	RocketSpawnAnchor,  // 名称包含 BP_BlueRocketSpawn
+	DefendZoneAnchor,   // 名称包含 BP_BlueDefendZone
+	DirectionalLight,
+	SkyLight,
+	HeightFog,
+	PostProcessVolume,
+	PlayerStart,
+	Count
+};
+
+/**
+ * 场景 Actor 索引：
+ * 首次查询某个世界时遍历一次全部 Actor，按角色与标签建立索引；之后通过世界的 Actor 生成/销毁回调
+ * 以及关卡流送的加入/移除回调增量维护，部署点、锚点和环境 Actor 的查找不再扫描整个世界。
+ *
+ * - 只保存弱引用，失效条目在查询时顺带清理。
+ * - 标签在 Actor 加入世界时索引；生成后才追加的标签不会被收录（蓝方单位等运行时标签不经由本索引查询）。
+ * - 切换世界时自动重建。
+ */
+class FScenarioActorRegistry
+{
+public:
+	FScenarioActorRegistry() = default;
+	~FScenarioActorRegistry();
+
+	FScenarioActorRegistry(const FScenarioActorRegistry&) = delete;
+	FScenarioActorRegistry& operator=(const FScenarioActorRegistry&) = delete;
+
+	/** 按加入顺序返回指定角色的所有有效 Actor */
+	void GetActors(UWorld* World, EScenarioActorRole Role, TArray<AActor*>& OutActors);
+
+	/** 返回指定角色的第一个有效 Actor，没有则返回 nullptr */
+	AActor* GetFirst(UWorld* World, EScenarioActorRole Role);
+
+	template <typename T>
+	T* GetFirst(UWorld* World, EScenarioActorRole Role)
+	{
+		return Cast<T>(GetFirst(World, Role));
+	}
+
+	/** 追加带有指定标签的所有有效 Actor（已在 OutActors 中的不重复添加） */
+	void AppendActorsWithTag(UWorld* World, FName Tag, TArray<AActor*>& OutActors);
+
+	/** 解绑回调并清空索引 */
+	void Reset();
+
+	int32 GetIndexedActorCount() const { return IndexedActors.Num(); }
+
+private:
+	void EnsureWorld(UWorld* World);
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAdded(ULevel* Level, UWorld* World);
+	void HandleLevelRemoved(ULevel* Level, UWorld* World);
+
+	static void PruneInvalid(TArray<TWeakObjectPtr<AActor>>& Entries);
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	TArray<TWeakObjectPtr<AActor>> RoleActors[static_cast<int32>(EScenarioActorRole::Count)];
+	TMap<FName, TArray<TWeakObjectPtr<AActor>>> TagActors;
+	TSet<TWeakObjectPtr<AActor>> IndexedActors;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
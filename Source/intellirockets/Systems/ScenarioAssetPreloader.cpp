@@ -0,0 +1,243 @@
+#include "Systems/ScenarioAssetPreloader.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInterface.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	const TCHAR* BlueUnitMeshPaths[ScenarioAssets::BlueUnitTypeCount] =
+	{
+		TEXT("/Game/Military_Free/Meshes/SM_radiostation_001.SM_radiostation_001"),
+		TEXT("/Game/T-34-85/Models/SM_T-34-85.SM_T-34-85"),
+		TEXT("/Game/Military_Free/Meshes/SM_tank_tower_001.SM_tank_tower_001"),
+	};
+
+	const TCHAR* BlueUnitMaterialPaths[ScenarioAssets::BlueUnitTypeCount] =
+	{
+		TEXT("/Game/StarterContent/Materials/M_Metal_Copper.M_Metal_Copper"),
+		TEXT("/Game/StarterContent/Materials/M_Metal_Gold.M_Metal_Gold"),
+		TEXT("/Game/StarterContent/Materials/M_Metal_Burnished_Steel.M_Metal_Burnished_Steel"),
+	};
+
+	const TCHAR* MapPreviewPaths[ScenarioAssets::MapPreviewCount] =
+	{
+		TEXT("/Game/Map_Cover/Desert.Desert"),
+		TEXT("/Game/Map_Cover/Forest.Forest"),
+		TEXT("/Game/Map_Cover/Snow.Snow"),
+		TEXT("/Game/Map_Cover/Sea.Sea"),
+	};
+
+	bool DoesAssetExist(const FSoftObjectPath& Path)
+	{
+		return Path.IsValid() && (Path.ResolveObject() != nullptr || FPackageName::DoesPackageExist(Path.GetLongPackageName()));
+	}
+
+	void AddIfExists(TArray<FSoftObjectPath>& OutPaths, const FSoftObjectPath& Path)
+	{
+		// 可选资源（例如编辑器材质在打包后不存在）不加入请求，避免异步加载报错
+		if (DoesAssetExist(Path))
+		{
+			OutPaths.AddUnique(Path);
+		}
+	}
+}
+
+FSoftObjectPath ScenarioAssets::GetMissileMeshPath()
+{
+	return FSoftObjectPath(TEXT("/Game/Sayantan/Props/Small/CruiseMissile_FREE/Models/SM_CruiseMissile.SM_CruiseMissile"));
+}
+
+FSoftObjectPath ScenarioAssets::GetMissileMaterialPath()
+{
+	return FSoftObjectPath(TEXT("/Game/StarterContent/Materials/M_Glow.M_Glow"));
+}
+
+FSoftObjectPath ScenarioAssets::GetBlueUnitMeshPath(int32 TypeIndex)
+{
+	return FSoftObjectPath(BlueUnitMeshPaths[FMath::Clamp(TypeIndex, 0, BlueUnitTypeCount - 1)]);
+}
+
+FSoftObjectPath ScenarioAssets::GetBlueUnitMaterialPath(int32 TypeIndex)
+{
+	return FSoftObjectPath(BlueUnitMaterialPaths[FMath::Clamp(TypeIndex, 0, BlueUnitTypeCount - 1)]);
+}
+
+FSoftObjectPath ScenarioAssets::GetDefaultMaterialPath()
+{
+	return FSoftObjectPath(TEXT("/Engine/EngineMaterials/DefaultMaterial.DefaultMaterial"));
+}
+
+const TArray<FSoftObjectPath>& ScenarioAssets::GetJammerMaterialPaths()
+{
+	static const TArray<FSoftObjectPath> Paths =
+	{
+		FSoftObjectPath(TEXT("/Game/Materials/M_RadarJammerTranslucent.M_RadarJammerTranslucent")),
+		FSoftObjectPath(TEXT("/Engine/EditorMaterials/WidgetMaterial.WidgetMaterial")),
+		FSoftObjectPath(TEXT("/Engine/EditorMaterials/UnlitColor.UnlitColor")),
+		FSoftObjectPath(TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial")),
+	};
+	return Paths;
+}
+
+FSoftObjectPath ScenarioAssets::GetMapPreviewPath(int32 MapIndex)
+{
+	return MapIndex >= 0 && MapIndex < MapPreviewCount ? FSoftObjectPath(MapPreviewPaths[MapIndex]) : FSoftObjectPath();
+}
+
+UMaterialInterface* ScenarioAssets::ResolveJammerMaterial()
+{
+	for (const FSoftObjectPath& Path : GetJammerMaterialPaths())
+	{
+		if (UMaterialInterface* Material = ResolveLoaded<UMaterialInterface>(Path))
+		{
+			return Material;
+		}
+		if (DoesAssetExist(Path))
+		{
+			if (UMaterialInterface* Material = ResolveOrLoad<UMaterialInterface>(Path))
+			{
+				return Material;
+			}
+		}
+	}
+	return nullptr;
+}
+
+UObject* ScenarioAssets::ResolveOrLoad(const FSoftObjectPath& Path)
+{
+	if (!Path.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (UObject* Loaded = Path.ResolveObject())
+	{
+		return Loaded;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("ScenarioAssets: synchronous load of '%s' (not preloaded)"), *Path.ToString());
+	return Path.TryLoad();
+}
+
+FScenarioAssetPreloader& FScenarioAssetPreloader::Get()
+{
+	static FScenarioAssetPreloader Instance;
+	return Instance;
+}
+
+void FScenarioAssetPreloader::PreloadScenarioAssets(const FScenarioTestConfig& Config)
+{
+	if (!UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> Paths;
+	AddIfExists(Paths, ScenarioAssets::GetMissileMeshPath());
+	AddIfExists(Paths, ScenarioAssets::GetMissileMaterialPath());
+	AddIfExists(Paths, ScenarioAssets::GetDefaultMaterialPath());
+	for (int32 TypeIndex = 0; TypeIndex < ScenarioAssets::BlueUnitTypeCount; ++TypeIndex)
+	{
+		AddIfExists(Paths, ScenarioAssets::GetBlueUnitMeshPath(TypeIndex));
+		AddIfExists(Paths, ScenarioAssets::GetBlueUnitMaterialPath(TypeIndex));
+	}
+	// 干扰区域只在选择了反制措施时生成
+	if (Config.CountermeasureIndices.Num() > 0)
+	{
+		for (const FSoftObjectPath& Path : ScenarioAssets::GetJammerMaterialPaths())
+		{
+			AddIfExists(Paths, Path);
+		}
+	}
+
+	// 先发起新请求再释放旧句柄，两次请求共有的资源不会在中间被回收
+	const TSharedPtr<FStreamableHandle> PreviousHandle = ScenarioHandle;
+
+	RequestedAssetCount = Paths.Num();
+	RequestStartSeconds = FPlatformTime::Seconds();
+	ScenarioHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate::CreateLambda([this]()
+	{
+		UE_LOG(LogTemp, Log, TEXT("ScenarioAssetPreloader: %d assets ready in %.0f ms"),
+			RequestedAssetCount, (FPlatformTime::Seconds() - RequestStartSeconds) * 1000.0);
+	}), FStreamableManager::AsyncLoadHighPriority);
+
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->ReleaseHandle();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ScenarioAssetPreloader: requested %d scenario assets"), RequestedAssetCount);
+}
+
+void FScenarioAssetPreloader::PreloadMapPreviews(FSimpleDelegate OnLoaded)
+{
+	if (PreviewHandle.IsValid() && PreviewHandle->HasLoadCompleted())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	PendingPreviewCallbacks.Add(MoveTemp(OnLoaded));
+	if (PreviewHandle.IsValid() && PreviewHandle->IsLoadingInProgress())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> Paths;
+	for (int32 MapIndex = 0; MapIndex < ScenarioAssets::MapPreviewCount; ++MapIndex)
+	{
+		AddIfExists(Paths, ScenarioAssets::GetMapPreviewPath(MapIndex));
+	}
+
+	const auto FlushCallbacks = [this]()
+	{
+		TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingPreviewCallbacks);
+		for (FSimpleDelegate& Callback : Callbacks)
+		{
+			Callback.ExecuteIfBound();
+		}
+	};
+
+	if (Paths.Num() == 0 || !UAssetManager::IsInitialized())
+	{
+		FlushCallbacks();
+		return;
+	}
+
+	PreviewHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate::CreateLambda(FlushCallbacks));
+	if (!PreviewHandle.IsValid())
+	{
+		FlushCallbacks();
+	}
+}
+
+bool FScenarioAssetPreloader::IsLoading() const
+{
+	return ScenarioHandle.IsValid() && ScenarioHandle->IsLoadingInProgress();
+}
+
+float FScenarioAssetPreloader::GetProgress() const
+{
+	return ScenarioHandle.IsValid() ? ScenarioHandle->GetProgress() : 1.f;
+}
+
+void FScenarioAssetPreloader::ReleaseAll()
+{
+	if (ScenarioHandle.IsValid())
+	{
+		ScenarioHandle->ReleaseHandle();
+		ScenarioHandle.Reset();
+	}
+	if (PreviewHandle.IsValid())
+	{
+		PreviewHandle->ReleaseHandle();
+		PreviewHandle.Reset();
+	}
+	PendingPreviewCallbacks.Reset();
+	RequestedAssetCount = 0;
+}
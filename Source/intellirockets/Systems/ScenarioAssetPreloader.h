@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UI/SScenarioScreen.h"
+
+struct FStreamableHandle;
+class UStaticMesh;
+class UMaterialInterface;
+class UTexture2D;
+
+/**
+ * 场景资源路径与解析：
+ * 导弹/蓝方单位/干扰区域/地图预览所用资源集中在这里，
+ * 解析时优先取内存中已加载（已预加载）的对象，未加载时才同步加载并记录日志，便于发现卡顿来源。
+ */
+namespace ScenarioAssets
+{
+	constexpr int32 BlueUnitTypeCount = 3;
+	constexpr int32 MapPreviewCount = 4;
+
+	FSoftObjectPath GetMissileMeshPath();
+	FSoftObjectPath GetMissileMaterialPath();
+	FSoftObjectPath GetBlueUnitMeshPath(int32 TypeIndex);
+	FSoftObjectPath GetBlueUnitMaterialPath(int32 TypeIndex);
+	FSoftObjectPath GetDefaultMaterialPath();
+	/** 干扰区域半透明材质候选，按优先级排列 */
+	const TArray<FSoftObjectPath>& GetJammerMaterialPaths();
+	FSoftObjectPath GetMapPreviewPath(int32 MapIndex);
+
+	/** 按优先级取第一个存在的干扰区域材质 */
+	UMaterialInterface* ResolveJammerMaterial();
+
+	/** 已在内存中则直接返回，否则同步加载（会在日志中提示未预加载） */
+	UObject* ResolveOrLoad(const FSoftObjectPath& Path);
+
+	template<typename T>
+	T* ResolveOrLoad(const FSoftObjectPath& Path)
+	{
+		return Cast<T>(ResolveOrLoad(Path));
+	}
+
+	/** 仅在内存中查找，不触发加载 */
+	template<typename T>
+	T* ResolveLoaded(const FSoftObjectPath& Path)
+	{
+		return Cast<T>(Path.ResolveObject());
+	}
+}
+
+/**
+ * 异步预加载：Step3 环境确认后通过 FStreamableManager 请求本次场景需要的全部资源，
+ * 句柄持有期间资源不会被 GC 回收，部署与首次发射时不再同步加载。
+ */
+class FScenarioAssetPreloader
+{
+public:
+	static FScenarioAssetPreloader& Get();
+
+	/** 请求场景资源（导弹、蓝方单位、干扰材质），重复调用会替换上一次请求 */
+	void PreloadScenarioAssets(const FScenarioTestConfig& Config);
+
+	/** 请求全部地图预览图，完成后回调（已在内存中时立即回调） */
+	void PreloadMapPreviews(FSimpleDelegate OnLoaded);
+
+	bool IsLoading() const;
+	/** 0~1，无请求时为 1 */
+	float GetProgress() const;
+	int32 GetRequestedAssetCount() const { return RequestedAssetCount; }
+
+	void ReleaseAll();
+
+private:
+	TSharedPtr<FStreamableHandle> ScenarioHandle;
+	TSharedPtr<FStreamableHandle> PreviewHandle;
+	TArray<FSimpleDelegate> PendingPreviewCallbacks;
+	int32 RequestedAssetCount = 0;
+	double RequestStartSeconds = 0.0;
+};
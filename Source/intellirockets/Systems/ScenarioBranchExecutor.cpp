@@ -0,0 +1,359 @@
+#include "Systems/ScenarioBranchExecutor.h"
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/ScenarioHeadlessRunner.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarBranchMaxWorkers(
+		TEXT("ir.Branch.MaxWorkers"),
+		0,
+		TEXT("分支推演并行工作进程数（0 = 每个变体一个进程，最多 8）"));
+
+	TAutoConsoleVariable<FString> CVarBranchCountermeasureLeads(
+		TEXT("ir.Branch.CountermeasureLeads"),
+		TEXT("0.5,1.0"),
+		TEXT("分支推演默认变体的反制提前量（秒，逗号分隔），每个值生成一个分支"));
+
+	TAutoConsoleVariable<int32> CVarBranchIncludeNoCountermeasure(
+		TEXT("ir.Branch.IncludeNoCountermeasure"),
+		1,
+		TEXT("1: 分支推演默认变体包含关闭反制的对照组"));
+
+	// 与无界面运行的单次超时保持一致，另加进程启动与地图加载时间
+	constexpr float RunTimeoutSeconds = 180.f;
+	constexpr float WorkerStartupSeconds = 120.f;
+}
+
+FScenarioBranchExecutor::~FScenarioBranchExecutor()
+{
+	Cancel();
+}
+
+void FScenarioBranchExecutor::MakeDefaultVariants(const FScenarioCheckpoint& Checkpoint, TArray<FScenarioBranchVariant>& OutVariants)
+{
+	OutVariants.Reset();
+
+	FScenarioBranchVariant& Baseline = OutVariants.AddDefaulted_GetRef();
+	Baseline.Name = TEXT("基线（原样继续）");
+
+	TArray<FString> LeadTexts;
+	CVarBranchCountermeasureLeads.GetValueOnGameThread().ParseIntoArray(LeadTexts, TEXT(","));
+	for (const FString& LeadText : LeadTexts)
+	{
+		const float Lead = FCString::Atof(*LeadText.TrimStartAndEnd());
+		if (Lead > 0.f)
+		{
+			FScenarioBranchVariant& Variant = OutVariants.AddDefaulted_GetRef();
+			Variant.Name = FString::Printf(TEXT("反制提前 %.1f 秒"), Lead);
+			Variant.CountermeasureLeadSeconds = Lead;
+		}
+	}
+
+	if (CVarBranchIncludeNoCountermeasure.GetValueOnGameThread() > 0)
+	{
+		FScenarioBranchVariant& Variant = OutVariants.AddDefaulted_GetRef();
+		Variant.Name = TEXT("关闭反制");
+		Variant.bDisableCountermeasure = true;
+	}
+}
+
+bool FScenarioBranchExecutor::Start(const FScenarioCheckpoint& Checkpoint, const TArray<FScenarioBranchVariant>& Variants, FString& OutError)
+{
+	if (IsRunning())
+	{
+		OutError = TEXT("分支推演正在运行");
+		return false;
+	}
+	if (Variants.Num() == 0)
+	{
+		OutError = TEXT("没有要运行的分支变体");
+		return false;
+	}
+
+	OutputDirectory = FPaths::ProjectSavedDir() / TEXT("Branches") / FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"));
+	OutputDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+	const FString CheckpointPath = OutputDirectory / TEXT("checkpoint.ircp");
+	if (!Checkpoint.SaveToFile(CheckpointPath))
+	{
+		OutError = FString::Printf(TEXT("无法写入检查点 %s"), *CheckpointPath);
+		return false;
+	}
+
+	// 每个变体一份场景文件：配置取自检查点，branch 字段指向同一检查点
+	for (int32 BranchIndex = 0; BranchIndex < Variants.Num(); ++BranchIndex)
+	{
+		TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+		Root->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Checkpoint.Config));
+
+		TSharedRef<FJsonObject> Runner = MakeShareable(new FJsonObject);
+		Runner->SetNumberField(TEXT("repetitions"), 1);
+		Runner->SetNumberField(TEXT("timeoutSeconds"), RunTimeoutSeconds);
+		Root->SetObjectField(TEXT("runner"), Runner);
+
+		TSharedRef<FJsonObject> Branch = MakeShareable(new FJsonObject);
+		Branch->SetStringField(TEXT("checkpoint"), CheckpointPath);
+		Branch->SetObjectField(TEXT("variant"), Variants[BranchIndex].ToJson());
+		Root->SetObjectField(TEXT("branch"), Branch);
+
+		if (!ScenarioConfigIO::WriteJsonToFile(Root, GetBranchScenarioPath(BranchIndex)))
+		{
+			OutError = FString::Printf(TEXT("无法写入场景文件 %s"), *GetBranchScenarioPath(BranchIndex));
+			return false;
+		}
+	}
+
+	const int32 CVarWorkers = CVarBranchMaxWorkers.GetValueOnGameThread();
+	MaxWorkers = FMath::Clamp(CVarWorkers > 0 ? CVarWorkers : Variants.Num(), 1, 8);
+	BranchTimeoutSeconds = RunTimeoutSeconds + WorkerStartupSeconds;
+	CheckpointSessionSeconds = Checkpoint.SessionSeconds;
+
+	Results.Reset();
+	for (const FScenarioBranchVariant& Variant : Variants)
+	{
+		Results.AddDefaulted_GetRef().Variant = Variant;
+	}
+	ActiveWorkers.Reset();
+	NextBranch = 0;
+	FinishedBranches = 0;
+	bHasResults = false;
+
+	UE_LOG(LogTemp, Log, TEXT("[Branch] Checkpoint at %.1fs (%d missiles, %d records), %d branches, workers=%d out=%s"),
+		Checkpoint.SessionSeconds, Checkpoint.Missiles.Num(), Checkpoint.Records.Num(), Variants.Num(), MaxWorkers, *OutputDirectory);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioBranchExecutor::HandleTick), 0.5f);
+	return true;
+}
+
+void FScenarioBranchExecutor::Cancel()
+{
+	for (FWorker& Worker : ActiveWorkers)
+	{
+		if (Worker.Process.IsValid())
+		{
+			FPlatformProcess::TerminateProc(Worker.Process, true);
+			FPlatformProcess::CloseProc(Worker.Process);
+		}
+	}
+	ActiveWorkers.Reset();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+FString FScenarioBranchExecutor::GetBranchScenarioPath(int32 BranchIndex) const
+{
+	return OutputDirectory / FString::Printf(TEXT("branch_%02d.json"), BranchIndex);
+}
+
+FString FScenarioBranchExecutor::GetBranchResultPath(int32 BranchIndex) const
+{
+	return OutputDirectory / FString::Printf(TEXT("branch_%02d_result.json"), BranchIndex);
+}
+
+bool FScenarioBranchExecutor::LaunchBranch(int32 BranchIndex)
+{
+	FWorker Worker;
+	Worker.BranchIndex = BranchIndex;
+	Worker.StartSeconds = FPlatformTime::Seconds();
+	Worker.Process = FScenarioHeadlessRunner::LaunchWorkerProcess(GetBranchScenarioPath(BranchIndex), GetBranchResultPath(BranchIndex));
+	if (!Worker.Process.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Branch] Failed to launch worker for branch %d"), BranchIndex);
+		return false;
+	}
+
+	ActiveWorkers.Add(Worker);
+	return true;
+}
+
+bool FScenarioBranchExecutor::HandleTick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = ActiveWorkers.Num() - 1; Index >= 0; --Index)
+	{
+		FWorker& Worker = ActiveWorkers[Index];
+		int32 ReturnCode = -1;
+		bool bWorkerTimedOut = false;
+		if (FPlatformProcess::IsProcRunning(Worker.Process))
+		{
+			if (Now - Worker.StartSeconds < BranchTimeoutSeconds)
+			{
+				continue;
+			}
+			UE_LOG(LogTemp, Warning, TEXT("[Branch] Branch %d timed out, terminating worker"), Worker.BranchIndex);
+			FPlatformProcess::TerminateProc(Worker.Process, true);
+			bWorkerTimedOut = true;
+		}
+		else
+		{
+			FPlatformProcess::GetProcReturnCode(Worker.Process, &ReturnCode);
+		}
+
+		FPlatformProcess::CloseProc(Worker.Process);
+		CollectBranch(Worker.BranchIndex, ReturnCode, bWorkerTimedOut);
+		ActiveWorkers.RemoveAtSwap(Index);
+	}
+
+	while (ActiveWorkers.Num() < MaxWorkers && NextBranch < Results.Num())
+	{
+		const int32 BranchIndex = NextBranch++;
+		if (!LaunchBranch(BranchIndex))
+		{
+			CollectBranch(BranchIndex, -1);
+		}
+	}
+
+	if (ActiveWorkers.Num() == 0 && NextBranch >= Results.Num())
+	{
+		TickerHandle.Reset();
+		FinishBranches();
+		return false;
+	}
+	return true;
+}
+
+void FScenarioBranchExecutor::CollectBranch(int32 BranchIndex, int32 ReturnCode, bool bWorkerTimedOut)
+{
+	++FinishedBranches;
+	FScenarioBranchResult& Result = Results[BranchIndex];
+	Result.bFinished = true;
+
+	// 工作进程被强制终止：结果文件可能不完整，不读取，按超时分支上报
+	if (bWorkerTimedOut)
+	{
+		Result.bTimedOut = true;
+		UE_LOG(LogTemp, Warning, TEXT("[Branch] Branch %d (%s) timed out after %.0f s without results"), BranchIndex, *Result.Variant.Name, BranchTimeoutSeconds);
+		return;
+	}
+
+	// 导弹结算前超时也以退出码 2 结束但仍写出该轮结果（timedOut），因此只看结果文件中是否有这一轮
+	FString JsonString;
+	TSharedPtr<FJsonObject> Root;
+	const bool bLoaded = ReturnCode >= 0
+		&& FFileHelper::LoadFileToString(JsonString, *GetBranchResultPath(BranchIndex))
+		&& FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), Root)
+		&& Root.IsValid();
+
+	const TArray<TSharedPtr<FJsonValue>>* Runs = nullptr;
+	const TSharedPtr<FJsonObject> Run = bLoaded && Root->TryGetArrayField(TEXT("runs"), Runs) && Runs->Num() > 0
+		? (*Runs)[0]->AsObject() : nullptr;
+	const TSharedPtr<FJsonObject>* Summary = nullptr;
+	if (!Run.IsValid() || !Run->TryGetObjectField(TEXT("summary"), Summary))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Branch] Branch %d (%s) produced no results (exit code %d)"), BranchIndex, *Result.Variant.Name, ReturnCode);
+		return;
+	}
+
+	Result.bCompleted = true;
+	Run->TryGetBoolField(TEXT("timedOut"), Result.bTimedOut);
+	(*Summary)->TryGetNumberField(TEXT("totalShots"), Result.TotalShots);
+	(*Summary)->TryGetNumberField(TEXT("hits"), Result.Hits);
+	double HitRate = 0.0;
+	if ((*Summary)->TryGetNumberField(TEXT("hitRate"), HitRate))
+	{
+		Result.HitRate = static_cast<float>(HitRate);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Evaluations = nullptr;
+	if (Run->TryGetArrayField(TEXT("evaluations"), Evaluations))
+	{
+		for (const TSharedPtr<FJsonValue>& EvaluationValue : *Evaluations)
+		{
+			const TSharedPtr<FJsonObject> Evaluation = EvaluationValue.IsValid() ? EvaluationValue->AsObject() : nullptr;
+			bool bHasData = false;
+			if (!Evaluation.IsValid() || !Evaluation->TryGetBoolField(TEXT("hasData"), bHasData) || !bHasData)
+			{
+				continue;
+			}
+
+			++Result.EvaluatedIndicators;
+			bool bPass = false;
+			if (Evaluation->TryGetBoolField(TEXT("pass"), bPass) && bPass)
+			{
+				++Result.PassedIndicators;
+			}
+
+			FString Id;
+			double NumericValue = 0.0;
+			if (Evaluation->TryGetStringField(TEXT("id"), Id) && Evaluation->TryGetNumberField(TEXT("numericValue"), NumericValue))
+			{
+				Result.IndicatorValues.Add(Id, static_cast<float>(NumericValue));
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[Branch] Branch %d (%s) finished: Shots=%d Hits=%d HitRate=%.1f%% Indicators=%d/%d%s"),
+		BranchIndex, *Result.Variant.Name, Result.TotalShots, Result.Hits, Result.HitRate,
+		Result.PassedIndicators, Result.EvaluatedIndicators, Result.bTimedOut ? TEXT(" (timeout)") : TEXT(""));
+}
+
+void FScenarioBranchExecutor::FinishBranches()
+{
+	bHasResults = true;
+
+	// 与基线分支逐项对比：命中率与各指标数值之差
+	const FScenarioBranchResult& Baseline = Results[0];
+	TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetNumberField(TEXT("checkpointSessionSeconds"), CheckpointSessionSeconds);
+	Root->SetBoolField(TEXT("baselineCompleted"), Baseline.bCompleted);
+
+	TArray<TSharedPtr<FJsonValue>> Branches;
+	for (const FScenarioBranchResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> BranchObject = MakeShareable(new FJsonObject);
+		BranchObject->SetObjectField(TEXT("variant"), Result.Variant.ToJson());
+		BranchObject->SetBoolField(TEXT("completed"), Result.bCompleted);
+		BranchObject->SetBoolField(TEXT("timedOut"), Result.bTimedOut);
+		if (Result.bCompleted)
+		{
+			BranchObject->SetNumberField(TEXT("totalShots"), Result.TotalShots);
+			BranchObject->SetNumberField(TEXT("hits"), Result.Hits);
+			BranchObject->SetNumberField(TEXT("hitRate"), Result.HitRate);
+			BranchObject->SetNumberField(TEXT("evaluatedIndicators"), Result.EvaluatedIndicators);
+			BranchObject->SetNumberField(TEXT("passedIndicators"), Result.PassedIndicators);
+
+			if (Baseline.bCompleted)
+			{
+				BranchObject->SetNumberField(TEXT("hitRateDelta"), Result.HitRate - Baseline.HitRate);
+				TSharedRef<FJsonObject> Deltas = MakeShareable(new FJsonObject);
+				for (const TPair<FString, float>& Pair : Result.IndicatorValues)
+				{
+					if (const float* BaselineValue = Baseline.IndicatorValues.Find(Pair.Key))
+					{
+						Deltas->SetNumberField(Pair.Key, Pair.Value - *BaselineValue);
+					}
+				}
+				BranchObject->SetObjectField(TEXT("indicatorDeltas"), Deltas);
+			}
+		}
+		Branches.Add(MakeShareable(new FJsonValueObject(BranchObject)));
+	}
+	Root->SetArrayField(TEXT("branches"), Branches);
+	ScenarioConfigIO::WriteJsonToFile(Root, OutputDirectory / TEXT("comparison.json"));
+
+	int32 CompletedBranches = 0;
+	int32 TimedOutBranches = 0;
+	for (const FScenarioBranchResult& Result : Results)
+	{
+		CompletedBranches += Result.bCompleted ? 1 : 0;
+		TimedOutBranches += Result.bTimedOut ? 1 : 0;
+	}
+	UE_LOG(LogTemp, Log, TEXT("[Branch] All branches finished: %d/%d completed, %d timed out, results in %s"),
+		CompletedBranches, Results.Num(), TimedOutBranches, *OutputDirectory);
+
+	OnFinished.ExecuteIfBound();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "Systems/ScenarioCheckpoint.h"
+
+/** 单个分支的结算结果（来自工作进程的结果文件） */
+struct FScenarioBranchResult
+{
+	FScenarioBranchVariant Variant;
+	bool bFinished = false;
+	bool bCompleted = false; // 工作进程正常结束并写出了结果
+	bool bTimedOut = false;  // 导弹在超时前未全部结算；工作进程超时被终止时同样为 true（此时 bCompleted 为 false）
+	int32 TotalShots = 0;
+	int32 Hits = 0;
+	float HitRate = 0.f;
+	int32 EvaluatedIndicators = 0;
+	int32 PassedIndicators = 0;
+	TMap<FString, float> IndicatorValues; // 指标 Id -> 数值
+};
+
+/**
+ * 分支推演（what-if）：
+ * 把检查点写入 Saved/Branches/<时间戳>/checkpoint.ircp，为每个变体生成一份带 branch 字段的场景文件，
+ * 在本机工作进程池中以无界面模式并行运行（各分支从检查点恢复后继续），全部结束后与基线分支对比，
+ * 对比结果写入同目录的 comparison.json。
+ *
+ * 各分支使用检查点中的同一随机种子，变体之间的差异只来自变体本身（配对比较）。
+ *
+ * 控制台变量：
+ *   ir.Branch.MaxWorkers         并行工作进程数（0 = 每个变体一个进程，最多 8）
+ *   ir.Branch.CountermeasureLeads 默认变体的反制提前量（秒，逗号分隔）
+ *   ir.Branch.IncludeNoCountermeasure 默认变体是否包含关闭反制的对照组
+ */
+class FScenarioBranchExecutor
+{
+public:
+	DECLARE_DELEGATE(FOnFinished);
+
+	~FScenarioBranchExecutor();
+
+	/** 基线 + ir.Branch.* 指定的默认变体 */
+	static void MakeDefaultVariants(const FScenarioCheckpoint& Checkpoint, TArray<FScenarioBranchVariant>& OutVariants);
+
+	/** 写出检查点与各分支场景文件并启动工作进程；第一个变体作为对比基线 */
+	bool Start(const FScenarioCheckpoint& Checkpoint, const TArray<FScenarioBranchVariant>& Variants, FString& OutError);
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+	bool HasResults() const { return bHasResults; }
+
+	int32 GetBranchCount() const { return Results.Num(); }
+	int32 GetFinishedBranchCount() const { return FinishedBranches; }
+	int32 GetActiveWorkerCount() const { return ActiveWorkers.Num(); }
+	float GetCheckpointSessionSeconds() const { return CheckpointSessionSeconds; }
+
+	/** 下标 0 为基线 */
+	const TArray<FScenarioBranchResult>& GetResults() const { return Results; }
+	const FString& GetOutputDirectory() const { return OutputDirectory; }
+
+	FOnFinished OnFinished;
+
+private:
+	struct FWorker
+	{
+		int32 BranchIndex = INDEX_NONE;
+		FProcHandle Process;
+		double StartSeconds = 0.0;
+	};
+
+	bool HandleTick(float DeltaTime);
+	bool LaunchBranch(int32 BranchIndex);
+	void CollectBranch(int32 BranchIndex, int32 ReturnCode, bool bWorkerTimedOut = false);
+	void FinishBranches();
+
+	FString GetBranchScenarioPath(int32 BranchIndex) const;
+	FString GetBranchResultPath(int32 BranchIndex) const;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	TArray<FScenarioBranchResult> Results;
+	FString OutputDirectory;
+	float CheckpointSessionSeconds = 0.f;
+
+	TArray<FWorker> ActiveWorkers;
+	int32 NextBranch = 0;
+	int32 FinishedBranches = 0;
+	int32 MaxWorkers = 1;
+	float BranchTimeoutSeconds = 0.f;
+	bool bHasResults = false;
+};
@@ -0,0 +1,212 @@
+#include "Systems/ScenarioCheckpoint.h"
+#include "Systems/ScenarioConfigIO.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include <type_traits>
+
+namespace
+{
+	constexpr uint32 CheckpointFileMagic = 0x50435249; // "IRCP"
+	constexpr uint32 CheckpointFileVersion = 1;
+
+	// 感知统计只含计数与累计值，检查点只在同一可执行文件之间传递，按内存布局整块读写
+	static_assert(std::is_trivially_copyable_v<FPerceptionRuntimeStats>, "FPerceptionRuntimeStats must stay trivially copyable");
+
+	/** 读取数量字段并做基本校验，防止损坏文件导致超大分配 */
+	bool SerializeCount(FArchive& Ar, int32& Count)
+	{
+		Ar << Count;
+		if (Ar.IsLoading() && (Count < 0 || Count > 1000000))
+		{
+			Ar.SetError();
+		}
+		return !Ar.IsError();
+	}
+
+	void SerializeCountermeasureStats(FArchive& Ar, FMissileCountermeasureStats& Stats)
+	{
+		Ar << Stats.bCountermeasureEnabled << Stats.bDetectionLogged << Stats.bCountermeasureTriggered << Stats.bCountermeasureActivated;
+		Ar << Stats.DetectionTime << Stats.DetectionDistanceToJammer << Stats.DetectionBaseRadius << Stats.DetectionHeightDifference;
+		Ar << Stats.CountermeasureTriggerTime << Stats.CountermeasureTargetDistance;
+		Ar << Stats.CountermeasureActivationTime << Stats.CountermeasureActivationDistanceToJammer
+			<< Stats.CountermeasureActivationBaseRadius << Stats.CountermeasureActivationHeightDifference
+			<< Stats.CountermeasureActivationRadiusReductionPercent << Stats.CountermeasureDuration;
+		Ar << Stats.bLostTargetInJammerRange << Stats.bEnteredJammerRange << Stats.JammerRangeExitTime;
+	}
+
+	void SerializeRecord(FArchive& Ar, FMissileTestRecord& Record)
+	{
+		Ar << Record.LaunchTimeSeconds << Record.bAutoFire << Record.TargetInstanceId << Record.TargetName;
+		Ar << Record.LaunchLocation << Record.TargetLocation << Record.InitialDistance;
+		Ar << Record.ImpactTimeSeconds << Record.bImpactRegistered << Record.bDirectHit << Record.DestroyedCount;
+		Ar << Record.bExpired << Record.bTargetDestroyed << Record.bIsSplitChild << Record.SplitGroupId;
+		SerializeCountermeasureStats(Ar, Record.CountermeasureStats);
+	}
+}
+
+TSharedRef<FJsonObject> FScenarioBranchVariant::ToJson() const
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetStringField(TEXT("name"), Name);
+	JsonObject->SetNumberField(TEXT("countermeasureLeadSeconds"), CountermeasureLeadSeconds);
+	JsonObject->SetBoolField(TEXT("disableCountermeasure"), bDisableCountermeasure);
+	return JsonObject;
+}
+
+bool FScenarioBranchVariant::FromJson(const TSharedPtr<FJsonObject>& JsonObject)
+{
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	*this = FScenarioBranchVariant();
+	JsonObject->TryGetStringField(TEXT("name"), Name);
+	JsonObject->TryGetNumberField(TEXT("countermeasureLeadSeconds"), CountermeasureLeadSeconds);
+	JsonObject->TryGetBoolField(TEXT("disableCountermeasure"), bDisableCountermeasure);
+	CountermeasureLeadSeconds = FMath::Max(0.f, CountermeasureLeadSeconds);
+	return true;
+}
+
+void FMissileCheckpointState::Serialize(FArchive& Ar)
+{
+	Ar << Location << Rotation << RecordIndex << InterceptorTargetIndex << TargetName;
+
+	Ar << Speed << AscentSpeed << AscentHeight << MaxLifetime << ElapsedLifetime << bAscending << Gravity;
+	Ar << InitialVelocity << LaunchLocation << TrajectoryStartTime << Velocity << StartLocation << CachedTargetLocation << LastTargetSearchTime;
+
+	Ar << bCountermeasureEnabled << bInJammerRange << CurrentJammingRatio << LastNearestJammerDistance;
+	Ar << bCountermeasureActive << CountermeasureActivationTime << LatestCountermeasureTime << LatestCountermeasureDistance;
+	Ar << bShouldUseCountermeasure << bElectromagneticInterferenceActive;
+	Ar << bJammerDetectionLogged << JammerDetectionTime << JammerDetectionDistance << JammerDetectionBaseRadius << JammerDetectionHeightDifference;
+	Ar << CountermeasureActivationDistanceToJammer << CountermeasureActivationBaseRadius << CountermeasureActivationHeightDifference;
+
+	Ar << bHLAllocationEnabled << bHasSplit << SplitGeneration << bUseFixedSplitTarget << FixedSplitTargetLocation << SplitGroupId << bIsSplitChild;
+
+	Ar << bTrajectoryOptimizationEnabled << AvoidanceWaypoint << bHasAvoidanceWaypoint << LastTrajectoryOptimizationUpdate;
+
+	Ar << bEvasiveSubsystemEnabled << bPerformingEvasiveManeuver << EvasiveTimeRemaining << EvasionCooldown;
+	Ar << CurrentEvasiveDirection << EvasiveDirectionFlipTimer << EvasiveSpeedBoostTime << bIsInterceptor;
+}
+
+void FScenarioCheckpoint::Serialize(FArchive& Ar)
+{
+	// 文件头：魔数、版本、地图、采集时间；配置以 JSON 文本保存，随后依次为会话状态、单位、干扰器、导弹、记录与统计
+	uint32 Magic = CheckpointFileMagic;
+	uint32 Version = CheckpointFileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != CheckpointFileMagic || Version != CheckpointFileVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+	Ar << MapName << CapturedAt;
+
+	FString ConfigText;
+	if (Ar.IsSaving())
+	{
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ConfigText);
+		FJsonSerializer::Serialize(ScenarioConfigIO::ConfigToJson(Config), Writer);
+	}
+	Ar << ConfigText;
+	if (Ar.IsLoading())
+	{
+		TSharedPtr<FJsonObject> ConfigObject;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ConfigText), ConfigObject)
+			|| !ScenarioConfigIO::ConfigFromJson(ConfigObject, Config))
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+
+	Ar << WorldSeconds << SessionSeconds << RandomSeed << AutoFireRemaining << NextTargetCursor;
+
+	int32 UnitCount = Units.Num();
+	if (!SerializeCount(Ar, UnitCount))
+	{
+		return;
+	}
+	Units.SetNum(UnitCount);
+	for (FScenarioCheckpointUnit& Unit : Units)
+	{
+		Ar << Unit.Name << Unit.MeshPath << Unit.MaterialPath << Unit.Transform;
+	}
+
+	int32 JammerCount = Jammers.Num();
+	if (!SerializeCount(Ar, JammerCount))
+	{
+		return;
+	}
+	Jammers.SetNum(JammerCount);
+	for (FScenarioCheckpointJammer& Jammer : Jammers)
+	{
+		Ar << Jammer.Location << Jammer.BaseRadius << Jammer.bCountermeasureActive;
+	}
+
+	int32 MissileCount = Missiles.Num();
+	if (!SerializeCount(Ar, MissileCount))
+	{
+		return;
+	}
+	Missiles.SetNum(MissileCount);
+	for (FMissileCheckpointState& Missile : Missiles)
+	{
+		Missile.Serialize(Ar);
+	}
+
+	int32 RecordCount = Records.Num();
+	if (!SerializeCount(Ar, RecordCount))
+	{
+		return;
+	}
+	Records.SetNum(RecordCount);
+	for (FMissileTestRecord& Record : Records)
+	{
+		SerializeRecord(Ar, Record);
+	}
+
+	Ar.Serialize(&Perception, sizeof(Perception));
+	Ar << HLSplitAttemptCount << HLSplitSuccessCount << HLSplitChildShotCount << HLSplitChildHitCount << HLSplitGroupCount << HLSplitGroupIdSeed;
+	Ar << HLSplitGroupHits;
+}
+
+bool FScenarioCheckpoint::SaveToFile(const FString& FilePath) const
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioCheckpoint: 无法创建文件 %s"), *FilePath);
+		return false;
+	}
+
+	const_cast<FScenarioCheckpoint*>(this)->Serialize(*Ar);
+	return Ar->Close() && !Ar->IsError();
+}
+
+bool FScenarioCheckpoint::LoadFromFile(const FString& FilePath)
+{
+	*this = FScenarioCheckpoint();
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioCheckpoint: 无法打开文件 %s"), *FilePath);
+		return false;
+	}
+
+	Serialize(*Ar);
+	if (Ar->IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioCheckpoint: 文件格式或版本不匹配 %s"), *FilePath);
+		*this = FScenarioCheckpoint();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+class FJsonObject;
+
+/** 分支推演变体：从检查点继续时对导弹行为的改动，默认值即按原样继续（基线） */
+struct FScenarioBranchVariant
+{
+	FString Name;
+	float CountermeasureLeadSeconds = 0.f; // 反制提前量：按当前速度预计该时间内进入干扰区即激活反制
+	bool bDisableCountermeasure = false;   // 关闭反制（对照组）
+
+	bool IsBaseline() const { return CountermeasureLeadSeconds <= 0.f && !bDisableCountermeasure; }
+
+	TSharedRef<FJsonObject> ToJson() const;
+	bool FromJson(const TSharedPtr<FJsonObject>& JsonObject);
+};
+
+/** 单枚导弹/拦截弹的完整状态（由 AMockMissileActor 读写，目标按名称在恢复时重新解析） */
+struct FMissileCheckpointState
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	int32 RecordIndex = INDEX_NONE;            // MissileTestRecords 下标，拦截弹为 INDEX_NONE
+	int32 InterceptorTargetIndex = INDEX_NONE; // 拦截目标在检查点导弹列表中的下标
+	FString TargetName;                        // 目标单位名称（Actor 或实例），无目标为空
+
+	// 飞行
+	float Speed = 0.f;
+	float AscentSpeed = 0.f;
+	float AscentHeight = 0.f;
+	float MaxLifetime = 0.f;
+	float ElapsedLifetime = 0.f;
+	bool bAscending = false;
+	float Gravity = 0.f;
+	FVector InitialVelocity = FVector::ZeroVector;
+	FVector LaunchLocation = FVector::ZeroVector;
+	float TrajectoryStartTime = 0.f;
+	FVector Velocity = FVector::ZeroVector;
+	FVector StartLocation = FVector::ZeroVector;
+	FVector CachedTargetLocation = FVector::ZeroVector;
+	float LastTargetSearchTime = 0.f;
+
+	// 干扰与反制
+	bool bCountermeasureEnabled = false;
+	bool bInJammerRange = false;
+	float CurrentJammingRatio = -1.f;
+	float LastNearestJammerDistance = -1.f;
+	bool bCountermeasureActive = false;
+	float CountermeasureActivationTime = -1.f;
+	float LatestCountermeasureTime = -1.f;
+	float LatestCountermeasureDistance = -1.f;
+	bool bShouldUseCountermeasure = false;
+	bool bElectromagneticInterferenceActive = false;
+	bool bJammerDetectionLogged = false;
+	float JammerDetectionTime = -1.f;
+	float JammerDetectionDistance = -1.f;
+	float JammerDetectionBaseRadius = 0.f;
+	float JammerDetectionHeightDifference = 0.f;
+	float CountermeasureActivationDistanceToJammer = -1.f;
+	float CountermeasureActivationBaseRadius = 0.f;
+	float CountermeasureActivationHeightDifference = 0.f;
+
+	// HL 分配
+	bool bHLAllocationEnabled = false;
+	bool bHasSplit = false;
+	int32 SplitGeneration = 0;
+	bool bUseFixedSplitTarget = false;
+	FVector FixedSplitTargetLocation = FVector::ZeroVector;
+	int32 SplitGroupId = INDEX_NONE;
+	bool bIsSplitChild = false;
+
+	// 轨迹优化
+	bool bTrajectoryOptimizationEnabled = false;
+	FVector AvoidanceWaypoint = FVector::ZeroVector;
+	bool bHasAvoidanceWaypoint = false;
+	float LastTrajectoryOptimizationUpdate = 0.f;
+
+	// 躲避对抗与拦截
+	bool bEvasiveSubsystemEnabled = false;
+	bool bPerformingEvasiveManeuver = false;
+	float EvasiveTimeRemaining = 0.f;
+	float EvasionCooldown = 0.f;
+	FVector CurrentEvasiveDirection = FVector::ZeroVector;
+	float EvasiveDirectionFlipTimer = 0.f;
+	float EvasiveSpeedBoostTime = 0.f;
+	bool bIsInterceptor = false;
+
+	void Serialize(FArchive& Ar);
+};
+
+struct FScenarioCheckpointUnit
+{
+	FString Name;
+	FString MeshPath;
+	FString MaterialPath;
+	FTransform Transform;
+};
+
+struct FScenarioCheckpointJammer
+{
+	FVector Location = FVector::ZeroVector;
+	float BaseRadius = 0.f;
+	bool bCountermeasureActive = false;
+};
+
+/**
+ * 交战中途的场景检查点（Saved/Branches/<时间戳>/checkpoint.ircp）：
+ * 配置、存活蓝方单位、干扰器及半径、全部在飞导弹与拦截弹状态、发射记录、会话统计与随机种子。
+ * - 时间以会话开始为基准保存，恢复时平移到新世界的时间轴上；
+ * - 全局随机数发生器的内部状态无法读出，采集时以新种子重新初始化，当前会话与各分支从同一状态继续；
+ * - 只在同一可执行文件的工作进程之间传递，版本不一致时拒绝读取。
+ */
+struct FScenarioCheckpoint
+{
+	FScenarioTestConfig Config;
+	FString MapName;
+	FString CapturedAt;
+	double WorldSeconds = 0.0;   // 采集时的世界时间
+	float SessionSeconds = 0.f;  // 采集时距会话开始的时间
+	int32 RandomSeed = 0;
+	int32 AutoFireRemaining = 0;
+	int32 NextTargetCursor = 0;
+
+	TArray<FScenarioCheckpointUnit> Units;
+	TArray<FScenarioCheckpointJammer> Jammers;
+	TArray<FMissileCheckpointState> Missiles; // 拦截弹在前，导弹在后
+	TArray<FMissileTestRecord> Records;       // TargetActor 不保存，恢复时按 TargetName 重新解析
+
+	FPerceptionRuntimeStats Perception;
+	int32 HLSplitAttemptCount = 0;
+	int32 HLSplitSuccessCount = 0;
+	int32 HLSplitChildShotCount = 0;
+	int32 HLSplitChildHitCount = 0;
+	int32 HLSplitGroupCount = 0;
+	int32 HLSplitGroupIdSeed = 0;
+	TMap<int32, TSet<FString>> HLSplitGroupHits;
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	/** 读写共用（FArchive 方向决定） */
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,334 @@
+#include "Systems/ScenarioConfigIO.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	const TCHAR* MapLevelPaths[] =
+	{
+		TEXT("/Game/Desert/Desert"),
+		TEXT("/Game/EF_Grounds/Maps/ExampleMap"),
+		TEXT("/Game/ProceduralNtr_vol2/maps/Demo_Scene"),
+		TEXT("/Game/MWLandscapeAutoMaterial/Maps/LandscapeAutoMaterial_Island_Example")  // 插件地图使用插件路径格式（不带/Game/前缀）
+	};
+
+	TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<int32>& Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		for (int32 Value : Values)
+		{
+			Out.Add(MakeShareable(new FJsonValueNumber(Value)));
+		}
+		return Out;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		for (const FString& Value : Values)
+		{
+			Out.Add(MakeShareable(new FJsonValueString(Value)));
+		}
+		return Out;
+	}
+
+	void ReadIntArray(const TSharedPtr<FJsonObject>& JsonObject, const TCHAR* Field, TArray<int32>& OutValues)
+	{
+		OutValues.Reset();
+		const TArray<TSharedPtr<FJsonValue>>* Values;
+		if (JsonObject->TryGetArrayField(Field, Values))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Values)
+			{
+				OutValues.Add(static_cast<int32>(Value->AsNumber()));
+			}
+		}
+	}
+
+	void ReadStringArray(const TSharedPtr<FJsonObject>& JsonObject, const TCHAR* Field, TArray<FString>& OutValues)
+	{
+		OutValues.Reset();
+		const TArray<TSharedPtr<FJsonValue>>* Values;
+		if (JsonObject->TryGetArrayField(Field, Values))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Values)
+			{
+				OutValues.Add(Value->AsString());
+			}
+		}
+	}
+
+	void ReadRowTexts(const TSharedPtr<FJsonObject>& JsonObject, const TCHAR* Field, TArray<TArray<FString>>& OutRows)
+	{
+		OutRows.Reset();
+		const TArray<TSharedPtr<FJsonValue>>* Rows;
+		if (JsonObject->TryGetArrayField(Field, Rows))
+		{
+			for (const TSharedPtr<FJsonValue>& RowValue : *Rows)
+			{
+				TArray<FString>& Row = OutRows.AddDefaulted_GetRef();
+				const TArray<TSharedPtr<FJsonValue>>* Cols;
+				if (RowValue->TryGetArray(Cols))
+				{
+					for (const TSharedPtr<FJsonValue>& Col : *Cols)
+					{
+						Row.Add(Col->AsString());
+					}
+				}
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> RowTextsToJson(const TArray<TArray<FString>>& Rows)
+	{
+		TArray<TSharedPtr<FJsonValue>> Out;
+		for (const TArray<FString>& Row : Rows)
+		{
+			Out.Add(MakeShareable(new FJsonValueArray(ToJsonArray(Row))));
+		}
+		return Out;
+	}
+
+	void ReadInt(const TSharedPtr<FJsonObject>& JsonObject, const TCHAR* Field, int32& OutValue)
+	{
+		int32 Value = 0;
+		if (JsonObject->TryGetNumberField(Field, Value))
+		{
+			OutValue = Value;
+		}
+	}
+}
+
+const TCHAR* ScenarioConfigIO::GetMapLevelPath(int32 MapIndex)
+{
+	if (MapIndex >= 0 && MapIndex < UE_ARRAY_COUNT(MapLevelPaths))
+	{
+		return MapLevelPaths[MapIndex];
+	}
+	return nullptr;
+}
+
+void ScenarioConfigIO::ResolveMapLevelName(FScenarioTestConfig& InOutConfig)
+{
+	// 注意：插件地图使用插件路径格式（如 /MWLandscapeAutoMaterial/...），不要添加 /Game/ 前缀
+	const TCHAR* LevelPath = GetMapLevelPath(InOutConfig.MapIndex);
+	InOutConfig.MapLevelName = LevelPath ? FName(LevelPath) : NAME_None;
+}
+
+TSharedRef<FJsonObject> ScenarioConfigIO::ConfigToJson(const FScenarioTestConfig& Config)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetNumberField(TEXT("testMethodTypeIndex"), Config.TestMethodTypeIndex);
+	JsonObject->SetNumberField(TEXT("testMethodIndex"), Config.TestMethodIndex);
+	JsonObject->SetNumberField(TEXT("environmentInterferenceIndex"), Config.EnvironmentInterferenceIndex);
+	JsonObject->SetArrayField(TEXT("tableRowIndices"), ToJsonArray(Config.SelectedTableRowIndices));
+	JsonObject->SetArrayField(TEXT("tableRowTexts"), RowTextsToJson(Config.SelectedTableRowTexts));
+	JsonObject->SetArrayField(TEXT("prototypeRowIndices"), ToJsonArray(Config.SelectedPrototypeRowIndices));
+	JsonObject->SetArrayField(TEXT("prototypeRowTexts"), RowTextsToJson(Config.SelectedPrototypeRowTexts));
+	JsonObject->SetArrayField(TEXT("algorithmNames"), ToJsonArray(Config.SelectedAlgorithmNames));
+	JsonObject->SetArrayField(TEXT("prototypeNames"), ToJsonArray(Config.SelectedPrototypeNames));
+	JsonObject->SetArrayField(TEXT("indicatorIds"), ToJsonArray(Config.SelectedIndicatorIds));
+	JsonObject->SetArrayField(TEXT("indicatorDetails"), ToJsonArray(Config.SelectedIndicatorDetails));
+	JsonObject->SetNumberField(TEXT("weatherIndex"), Config.WeatherIndex);
+	JsonObject->SetNumberField(TEXT("timeIndex"), Config.TimeIndex);
+	JsonObject->SetNumberField(TEXT("mapIndex"), Config.MapIndex);
+	JsonObject->SetNumberField(TEXT("densityIndex"), Config.DensityIndex);
+	JsonObject->SetArrayField(TEXT("countermeasureIndices"), ToJsonArray(Config.CountermeasureIndices));
+	JsonObject->SetBoolField(TEXT("blueCustomDeployment"), Config.bBlueCustomDeployment);
+	JsonObject->SetNumberField(TEXT("presetIndex"), Config.PresetIndex);
+	JsonObject->SetNumberField(TEXT("enemyForceIndex"), Config.EnemyForceIndex);
+	JsonObject->SetNumberField(TEXT("friendlyForceIndex"), Config.FriendlyForceIndex);
+	JsonObject->SetNumberField(TEXT("equipmentCapabilityIndex"), Config.EquipmentCapabilityIndex);
+	JsonObject->SetNumberField(TEXT("formationModeIndex"), Config.FormationModeIndex);
+	JsonObject->SetNumberField(TEXT("targetAccuracyIndex"), Config.TargetAccuracyIndex);
+	return JsonObject;
+}
+
+bool ScenarioConfigIO::ConfigFromJson(const TSharedPtr<FJsonObject>& JsonObject, FScenarioTestConfig& OutConfig)
+{
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	OutConfig = FScenarioTestConfig();
+	ReadInt(JsonObject, TEXT("testMethodTypeIndex"), OutConfig.TestMethodTypeIndex);
+	ReadInt(JsonObject, TEXT("testMethodIndex"), OutConfig.TestMethodIndex);
+	ReadInt(JsonObject, TEXT("environmentInterferenceIndex"), OutConfig.EnvironmentInterferenceIndex);
+	ReadIntArray(JsonObject, TEXT("tableRowIndices"), OutConfig.SelectedTableRowIndices);
+	ReadRowTexts(JsonObject, TEXT("tableRowTexts"), OutConfig.SelectedTableRowTexts);
+	ReadIntArray(JsonObject, TEXT("prototypeRowIndices"), OutConfig.SelectedPrototypeRowIndices);
+	ReadRowTexts(JsonObject, TEXT("prototypeRowTexts"), OutConfig.SelectedPrototypeRowTexts);
+	ReadStringArray(JsonObject, TEXT("algorithmNames"), OutConfig.SelectedAlgorithmNames);
+	ReadStringArray(JsonObject, TEXT("prototypeNames"), OutConfig.SelectedPrototypeNames);
+	ReadStringArray(JsonObject, TEXT("indicatorIds"), OutConfig.SelectedIndicatorIds);
+	ReadStringArray(JsonObject, TEXT("indicatorDetails"), OutConfig.SelectedIndicatorDetails);
+	ReadInt(JsonObject, TEXT("weatherIndex"), OutConfig.WeatherIndex);
+	ReadInt(JsonObject, TEXT("timeIndex"), OutConfig.TimeIndex);
+	ReadInt(JsonObject, TEXT("mapIndex"), OutConfig.MapIndex);
+	ReadInt(JsonObject, TEXT("densityIndex"), OutConfig.DensityIndex);
+	ReadIntArray(JsonObject, TEXT("countermeasureIndices"), OutConfig.CountermeasureIndices);
+	JsonObject->TryGetBoolField(TEXT("blueCustomDeployment"), OutConfig.bBlueCustomDeployment);
+	ReadInt(JsonObject, TEXT("presetIndex"), OutConfig.PresetIndex);
+	ReadInt(JsonObject, TEXT("enemyForceIndex"), OutConfig.EnemyForceIndex);
+	ReadInt(JsonObject, TEXT("friendlyForceIndex"), OutConfig.FriendlyForceIndex);
+	ReadInt(JsonObject, TEXT("equipmentCapabilityIndex"), OutConfig.EquipmentCapabilityIndex);
+	ReadInt(JsonObject, TEXT("formationModeIndex"), OutConfig.FormationModeIndex);
+	ReadInt(JsonObject, TEXT("targetAccuracyIndex"), OutConfig.TargetAccuracyIndex);
+
+	ResolveMapLevelName(OutConfig);
+	return true;
+}
+
+bool ScenarioConfigIO::LoadConfigFromFile(const FString& FilePath, FScenarioTestConfig& OutConfig, TSharedPtr<FJsonObject>* OutRoot)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load scenario file: %s"), *FilePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse scenario file: %s"), *FilePath);
+		return false;
+	}
+
+	// 场景文件可以直接是配置对象，也可以把配置放在 "config" 字段下
+	const TSharedPtr<FJsonObject>* ConfigObject = nullptr;
+	const TSharedPtr<FJsonObject> Source = JsonObject->TryGetObjectField(TEXT("config"), ConfigObject) ? *ConfigObject : JsonObject;
+
+	if (OutRoot)
+	{
+		*OutRoot = JsonObject;
+	}
+	return ConfigFromJson(Source, OutConfig);
+}
+
+bool ScenarioConfigIO::SaveConfigToFile(const FString& FilePath, const FScenarioTestConfig& Config)
+{
+	return WriteJsonToFile(ConfigToJson(Config), FilePath);
+}
+
+TSharedRef<FJsonObject> ScenarioConfigIO::SummaryToJson(const FMissileTestSummary& Summary)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetNumberField(TEXT("totalShots"), Summary.TotalShots);
+	JsonObject->SetNumberField(TEXT("manualShots"), Summary.ManualShots);
+	JsonObject->SetNumberField(TEXT("autoShots"), Summary.AutoShots);
+	JsonObject->SetNumberField(TEXT("hits"), Summary.Hits);
+	JsonObject->SetNumberField(TEXT("directHits"), Summary.DirectHits);
+	JsonObject->SetNumberField(TEXT("aoeHits"), Summary.AoEHits);
+	JsonObject->SetNumberField(TEXT("misses"), Summary.Misses);
+	JsonObject->SetNumberField(TEXT("hitRate"), Summary.HitRate);
+	JsonObject->SetNumberField(TEXT("directHitRate"), Summary.DirectHitRate);
+	JsonObject->SetNumberField(TEXT("averageFlightTime"), Summary.AverageFlightTime);
+	JsonObject->SetNumberField(TEXT("averageLaunchDistance"), Summary.AverageLaunchDistance);
+	JsonObject->SetNumberField(TEXT("averageDestroyedPerHit"), Summary.AverageDestroyedPerHit);
+	JsonObject->SetNumberField(TEXT("averageAutoLaunchInterval"), Summary.AverageAutoLaunchInterval);
+	JsonObject->SetNumberField(TEXT("sessionDuration"), Summary.SessionDuration);
+	JsonObject->SetNumberField(TEXT("hlSplitAttemptCount"), Summary.HLSplitAttemptCount);
+	JsonObject->SetNumberField(TEXT("hlSplitSuccessCount"), Summary.HLSplitSuccessCount);
+	JsonObject->SetNumberField(TEXT("hlSplitChildShotCount"), Summary.HLSplitChildShotCount);
+	JsonObject->SetNumberField(TEXT("hlSplitChildHitCount"), Summary.HLSplitChildHitCount);
+	JsonObject->SetNumberField(TEXT("hlSplitGroupCount"), Summary.HLSplitGroupCount);
+	JsonObject->SetNumberField(TEXT("hlSplitGroupUniqueTargetsTotal"), Summary.HLSplitGroupUniqueTargetsTotal);
+	JsonObject->SetNumberField(TEXT("countermeasureDetectionSamples"), Summary.CountermeasureDetectionSamples);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageDetectionMarginPercent"), Summary.CountermeasureAverageDetectionMarginPercent);
+	JsonObject->SetNumberField(TEXT("countermeasureActivationSamples"), Summary.CountermeasureActivationSamples);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageActivationDelay"), Summary.CountermeasureAverageActivationDelay);
+	JsonObject->SetNumberField(TEXT("countermeasureOnTimeRate"), Summary.CountermeasureOnTimeRate);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageActivationDistance"), Summary.CountermeasureAverageActivationDistance);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageActivationHeightDiff"), Summary.CountermeasureAverageActivationHeightDiff);
+	JsonObject->SetNumberField(TEXT("countermeasureSuppressionSuccessRate"), Summary.CountermeasureSuppressionSuccessRate);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageRadiusReductionRate"), Summary.CountermeasureAverageRadiusReductionRate);
+	JsonObject->SetNumberField(TEXT("countermeasureCoverageSuccessRate"), Summary.CountermeasureCoverageSuccessRate);
+	JsonObject->SetNumberField(TEXT("countermeasureAverageDuration"), Summary.CountermeasureAverageDuration);
+	JsonObject->SetNumberField(TEXT("countermeasureResourceCostScore"), Summary.CountermeasureResourceCostScore);
+
+	const FScenarioPerformanceStats& Perf = Summary.Performance;
+	if (Perf.bValid)
+	{
+		TSharedRef<FJsonObject> PerfObject = MakeShareable(new FJsonObject);
+		TArray<TSharedPtr<FJsonValue>> Histogram;
+		for (int32 Bucket = 0; Bucket < FScenarioPerformanceStats::NumFrameTimeBuckets; ++Bucket)
+		{
+			Histogram.Add(MakeShareable(new FJsonValueNumber(Perf.FrameTimeHistogram[Bucket])));
+		}
+		TArray<TSharedPtr<FJsonValue>> BucketEdges;
+		for (int32 Edge = 0; Edge < FScenarioPerformanceStats::NumFrameTimeBuckets - 1; ++Edge)
+		{
+			BucketEdges.Add(MakeShareable(new FJsonValueNumber(FScenarioPerformanceStats::GetFrameTimeBucketEdges()[Edge])));
+		}
+		PerfObject->SetArrayField(TEXT("frameTimeHistogram"), Histogram);
+		PerfObject->SetArrayField(TEXT("frameTimeBucketEdgesMs"), BucketEdges);
+		PerfObject->SetNumberField(TEXT("frameCount"), Perf.FrameCount);
+		PerfObject->SetNumberField(TEXT("averageFrameTimeMs"), Perf.AverageFrameTimeMs);
+		PerfObject->SetNumberField(TEXT("maxFrameTimeMs"), Perf.MaxFrameTimeMs);
+		PerfObject->SetNumberField(TEXT("averageFps"), Perf.AverageFps);
+		PerfObject->SetNumberField(TEXT("wallDuration"), Perf.WallDuration);
+		PerfObject->SetNumberField(TEXT("simDuration"), Perf.SimDuration);
+		PerfObject->SetNumberField(TEXT("simToWallRatio"), Perf.SimToWallRatio);
+		PerfObject->SetNumberField(TEXT("peakConcurrentMissiles"), Perf.PeakConcurrentMissiles);
+		PerfObject->SetNumberField(TEXT("missileSpawnCount"), Perf.MissileSpawnCount);
+		PerfObject->SetNumberField(TEXT("missileDestroyCount"), Perf.MissileDestroyCount);
+		PerfObject->SetNumberField(TEXT("interceptorSpawnCount"), Perf.InterceptorSpawnCount);
+		PerfObject->SetNumberField(TEXT("interceptorDestroyCount"), Perf.InterceptorDestroyCount);
+		PerfObject->SetNumberField(TEXT("blueUnitSpawnCount"), Perf.BlueUnitSpawnCount);
+		PerfObject->SetNumberField(TEXT("blueUnitDestroyCount"), Perf.BlueUnitDestroyCount);
+		PerfObject->SetNumberField(TEXT("traceCount"), static_cast<double>(Perf.TraceCount));
+		PerfObject->SetBoolField(TEXT("degradedFrameRate"), Perf.bDegradedFrameRate);
+		PerfObject->SetStringField(TEXT("degradedReason"), Perf.DegradedReason);
+		JsonObject->SetObjectField(TEXT("performance"), PerfObject);
+	}
+
+	return JsonObject;
+}
+
+TSharedRef<FJsonObject> ScenarioConfigIO::EvaluationToJson(const FIndicatorEvaluationResult& Evaluation)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetStringField(TEXT("id"), Evaluation.IndicatorId);
+	JsonObject->SetStringField(TEXT("name"), Evaluation.DisplayName);
+	JsonObject->SetStringField(TEXT("status"), Evaluation.StatusText);
+	JsonObject->SetStringField(TEXT("value"), Evaluation.ValueText);
+	JsonObject->SetStringField(TEXT("target"), Evaluation.TargetText);
+	JsonObject->SetStringField(TEXT("remark"), Evaluation.RemarkText);
+	JsonObject->SetBoolField(TEXT("hasData"), Evaluation.bHasData);
+	JsonObject->SetBoolField(TEXT("pass"), Evaluation.bPass);
+	if (Evaluation.bHasData)
+	{
+		JsonObject->SetNumberField(TEXT("numericValue"), Evaluation.Value);
+		JsonObject->SetNumberField(TEXT("targetValue"), Evaluation.TargetValue);
+		JsonObject->SetBoolField(TEXT("higherIsBetter"), Evaluation.bHigherIsBetter);
+	}
+	return JsonObject;
+}
+
+bool ScenarioConfigIO::WriteJsonToFile(const TSharedRef<FJsonObject>& JsonObject, const FString& FilePath)
+{
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	if (!FJsonSerializer::Serialize(JsonObject, Writer))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to serialize JSON for %s"), *FilePath);
+		return false;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(OutputString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write file: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
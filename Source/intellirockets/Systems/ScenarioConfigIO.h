@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+class FJsonObject;
+
+/**
+ * 场景配置/测试结果的 JSON 读写：
+ * - 场景文件（*.json）保存一份 FScenarioTestConfig，可由界面 SaveAll 生成，供无界面批量运行读取；
+ * - 测试结果输出 FMissileTestSummary 与指标评估结果。
+ */
+namespace ScenarioConfigIO
+{
+	/** 地图索引对应的关卡路径，越界返回 nullptr */
+	const TCHAR* GetMapLevelPath(int32 MapIndex);
+
+	/** 根据 MapIndex 填充 MapLevelName（越界时置空） */
+	void ResolveMapLevelName(FScenarioTestConfig& InOutConfig);
+
+	TSharedRef<FJsonObject> ConfigToJson(const FScenarioTestConfig& Config);
+	bool ConfigFromJson(const TSharedPtr<FJsonObject>& JsonObject, FScenarioTestConfig& OutConfig);
+
+	/** 读取场景文件；OutRoot 可选，用于读取文件中的其他字段（例如批量运行参数） */
+	bool LoadConfigFromFile(const FString& FilePath, FScenarioTestConfig& OutConfig, TSharedPtr<FJsonObject>* OutRoot = nullptr);
+	bool SaveConfigToFile(const FString& FilePath, const FScenarioTestConfig& Config);
+
+	TSharedRef<FJsonObject> SummaryToJson(const FMissileTestSummary& Summary);
+	TSharedRef<FJsonObject> EvaluationToJson(const FIndicatorEvaluationResult& Evaluation);
+
+	bool WriteJsonToFile(const TSharedRef<FJsonObject>& JsonObject, const FString& FilePath);
+}
@@ -0,0 +1,435 @@
+#include "Systems/ScenarioHeadlessRunner.h"
+#include "Systems/ScenarioMenuSubsystem.h"
+#include "Systems/ScenarioConfigIO.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// 等待地图加载与部署完成的最长真实时间（秒）
+	constexpr double DeploymentTimeoutSeconds = 300.0;
+
+	FString MakeAbsolutePath(const FString& InPath)
+	{
+		return FPaths::IsRelative(InPath) ? FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), InPath) : InPath;
+	}
+}
+
+bool FScenarioHeadlessRunner::IsRequested()
+{
+	FString ScenarioFile;
+	return FParse::Value(FCommandLine::Get(), TEXT("ScenarioFile="), ScenarioFile) && !ScenarioFile.IsEmpty();
+}
+
+FScenarioHeadlessRunner::FScenarioHeadlessRunner(UScenarioMenuSubsystem* InSubsystem)
+	: SubsystemWeak(InSubsystem)
+{
+}
+
+FScenarioHeadlessRunner::~FScenarioHeadlessRunner()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FScenarioHeadlessRunner::Start()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("ScenarioFile="), ScenarioFilePath);
+	ScenarioFilePath = MakeAbsolutePath(ScenarioFilePath);
+
+	TSharedPtr<FJsonObject> Root;
+	if (!ScenarioConfigIO::LoadConfigFromFile(ScenarioFilePath, Config, &Root))
+	{
+		Finish(ExitError, FString::Printf(TEXT("无法读取场景文件 %s"), *ScenarioFilePath));
+		return false;
+	}
+
+	// 场景文件中的 runner 字段提供默认值，命令行参数优先
+	const TSharedPtr<FJsonObject>* RunnerObject = nullptr;
+	if (Root.IsValid() && Root->TryGetObjectField(TEXT("runner"), RunnerObject))
+	{
+		(*RunnerObject)->TryGetNumberField(TEXT("repetitions"), Repetitions);
+		(*RunnerObject)->TryGetNumberField(TEXT("shotsPerRun"), ShotsPerRun);
+		(*RunnerObject)->TryGetNumberField(TEXT("timeoutSeconds"), RunTimeoutSeconds);
+		bHasSeed = (*RunnerObject)->TryGetNumberField(TEXT("seed"), BaseSeed);
+		(*RunnerObject)->TryGetBoolField(TEXT("stopOnConvergence"), bStopOnConvergence);
+	}
+
+	const TSharedPtr<FJsonObject>* BranchObject = nullptr;
+	if (Root.IsValid() && Root->TryGetObjectField(TEXT("branch"), BranchObject))
+	{
+		(*BranchObject)->TryGetStringField(TEXT("checkpoint"), CheckpointFilePath);
+		CheckpointFilePath = MakeAbsolutePath(CheckpointFilePath);
+		if (!Checkpoint.LoadFromFile(CheckpointFilePath))
+		{
+			Finish(ExitError, FString::Printf(TEXT("无法读取检查点 %s"), *CheckpointFilePath));
+			return false;
+		}
+		const TSharedPtr<FJsonObject>* VariantObject = nullptr;
+		if ((*BranchObject)->TryGetObjectField(TEXT("variant"), VariantObject))
+		{
+			BranchVariant.FromJson(*VariantObject);
+		}
+		bIsBranch = true;
+	}
+
+	FParse::Value(CommandLine, TEXT("ScenarioRuns="), Repetitions);
+	FParse::Value(CommandLine, TEXT("ScenarioShots="), ShotsPerRun);
+	FParse::Value(CommandLine, TEXT("ScenarioTimeout="), RunTimeoutSeconds);
+	bHasSeed |= FParse::Value(CommandLine, TEXT("ScenarioSeed="), BaseSeed);
+	bStopOnConvergence |= FParse::Param(CommandLine, TEXT("ScenarioConverge"));
+	// 收敛提前结束只对随机采样测试方法有意义
+	bStopOnConvergence &= Config.TestMethodTypeIndex == 0;
+
+	// 分支从检查点继续，只有一轮且种子来自检查点
+	if (bIsBranch)
+	{
+		Repetitions = 1;
+		bStopOnConvergence = false;
+		BaseSeed = Checkpoint.RandomSeed;
+		bHasSeed = true;
+	}
+
+	Repetitions = FMath::Max(1, Repetitions);
+	ShotsPerRun = FMath::Clamp(ShotsPerRun, 1, 20);
+	RunTimeoutSeconds = FMath::Max(10.f, RunTimeoutSeconds);
+	if (!bHasSeed)
+	{
+		BaseSeed = static_cast<int32>(FPlatformTime::Cycles() & 0x7fffffff);
+	}
+
+	if (!FParse::Value(CommandLine, TEXT("ScenarioOut="), OutputFilePath) || OutputFilePath.IsEmpty())
+	{
+		OutputFilePath = FPaths::ProjectSavedDir() / TEXT("ScenarioRuns") / FString::Printf(TEXT("%s_%s.json"),
+			*FPaths::GetBaseFilename(ScenarioFilePath), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	}
+	OutputFilePath = MakeAbsolutePath(OutputFilePath);
+
+	// 无界面运行不支持手动部署
+	Config.bBlueCustomDeployment = false;
+
+	UE_LOG(LogTemp, Log, TEXT("Headless scenario: file=%s runs=%d shots=%d timeout=%.0fs seed=%d out=%s"),
+		*ScenarioFilePath, Repetitions, ShotsPerRun, RunTimeoutSeconds, BaseSeed, *OutputFilePath);
+
+	Phase = EPhase::WaitingForWorld;
+	PhaseStartSeconds = FPlatformTime::Seconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioHeadlessRunner::HandleTick));
+	return true;
+}
+
+double FScenarioHeadlessRunner::GetWorldSeconds() const
+{
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	const UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+bool FScenarioHeadlessRunner::HandleTick(float DeltaTime)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	UWorld* World = Subsystem->GetWorld();
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForWorld:
+		if (World && World->IsGameWorld() && World->HasBegunPlay())
+		{
+			FMath::RandInit(BaseSeed);
+			FMath::SRandInit(BaseSeed);
+			Subsystem->StartScenarioWithConfig(Config);
+			Phase = EPhase::WaitingForDeployment;
+			PhaseStartSeconds = NowSeconds;
+		}
+		break;
+
+	case EPhase::WaitingForDeployment:
+		if (NowSeconds - PhaseStartSeconds > DeploymentTimeoutSeconds)
+		{
+			Finish(ExitError, TEXT("地图加载或蓝方部署超时"));
+			return false;
+		}
+		// OpenLevel 后 FinalizeScenarioAfterLoad 会清除待部署标记
+		if (!Subsystem->bHasPendingScenarioConfig && World && World->HasBegunPlay())
+		{
+			if (Subsystem->GetActiveBlueUnitCount() == 0)
+			{
+				Finish(ExitError, TEXT("未能部署任何蓝方单位（检查地图中的 BluePotentialDeployLocation 部署点）"));
+				return false;
+			}
+			CurrentRun = 0;
+			if (bIsBranch)
+			{
+				BeginBranchRun();
+			}
+			else
+			{
+				BeginRun();
+			}
+		}
+		break;
+
+	case EPhase::Firing:
+		Subsystem->BeginMissileAutoFire(ShotsPerRun);
+		Phase = EPhase::WaitingForMissiles;
+		PhaseStartSeconds = GetWorldSeconds();
+		break;
+
+	case EPhase::WaitingForMissiles:
+	{
+		Subsystem->CleanupMissiles();
+		const bool bAllResolved = Subsystem->AutoFireRemaining <= 0
+			&& Subsystem->ActiveMissiles.Num() == 0
+			&& Subsystem->ActiveInterceptorMissiles.Num() == 0;
+		const bool bTimedOut = GetWorldSeconds() - PhaseStartSeconds > RunTimeoutSeconds;
+		if (bAllResolved || bTimedOut)
+		{
+			FinishRun(!bAllResolved);
+			if (Phase == EPhase::Finished)
+			{
+				return false;
+			}
+		}
+		break;
+	}
+
+	case EPhase::Finished:
+		return false;
+	}
+
+	return true;
+}
+
+void FScenarioHeadlessRunner::BeginRun()
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	if (!World)
+	{
+		Finish(ExitError, TEXT("运行过程中世界已失效"));
+		return;
+	}
+
+	const int32 Seed = BaseSeed + CurrentRun;
+	if (CurrentRun > 0)
+	{
+		// 后续轮次在当前地图上重新部署，不再重新加载关卡
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+		Subsystem->ResetMissileTestSession();
+		Subsystem->ResetScenarioInPlace(World, Subsystem->ActiveScenarioConfig, false);
+	}
+
+	FRunResult& Run = Results.AddDefaulted_GetRef();
+	Run.RunIndex = CurrentRun;
+	Run.Seed = Seed;
+
+	UE_LOG(LogTemp, Log, TEXT("Headless scenario: run %d/%d started (seed=%d, blue units=%d)"),
+		CurrentRun + 1, Repetitions, Seed, Subsystem->GetActiveBlueUnitCount());
+
+	Phase = EPhase::Firing;
+}
+
+void FScenarioHeadlessRunner::BeginBranchRun()
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	if (!World)
+	{
+		Finish(ExitError, TEXT("运行过程中世界已失效"));
+		return;
+	}
+
+	// 部署阶段生成的随机兵力由检查点中的单位替换
+	if (!Subsystem->RestoreCheckpoint(World, Checkpoint, BranchVariant))
+	{
+		Finish(ExitError, FString::Printf(TEXT("无法恢复检查点 %s"), *CheckpointFilePath));
+		return;
+	}
+
+	FRunResult& Run = Results.AddDefaulted_GetRef();
+	Run.RunIndex = 0;
+	Run.Seed = Checkpoint.RandomSeed;
+
+	UE_LOG(LogTemp, Log, TEXT("Headless scenario: branch '%s' restored (missiles=%d, blue units=%d, auto fire remaining=%d)"),
+		*BranchVariant.Name, Checkpoint.Missiles.Num(), Subsystem->GetActiveBlueUnitCount(), Checkpoint.AutoFireRemaining);
+
+	Phase = EPhase::WaitingForMissiles;
+	PhaseStartSeconds = GetWorldSeconds();
+}
+
+void FScenarioHeadlessRunner::FinishRun(bool bTimedOut)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem || Results.Num() == 0)
+	{
+		Finish(ExitError, TEXT("运行状态异常"));
+		return;
+	}
+
+	Subsystem->CompleteMissileTest();
+
+	FRunResult& Run = Results.Last();
+	Run.bTimedOut = bTimedOut;
+	Run.Summary = Subsystem->GetMissileTestSummary();
+	Subsystem->BuildIndicatorEvaluations(Run.Evaluations);
+
+	Run.bPass = !bTimedOut;
+	for (const FIndicatorEvaluationResult& Evaluation : Run.Evaluations)
+	{
+		if (Evaluation.bHasData && !Evaluation.bPass)
+		{
+			Run.bPass = false;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Headless scenario: run %d/%d finished Shots=%d Hits=%d HitRate=%.1f%% Pass=%d%s"),
+		CurrentRun + 1, Repetitions, Run.Summary.TotalShots, Run.Summary.Hits, Run.Summary.HitRate,
+		Run.bPass ? 1 : 0, bTimedOut ? TEXT(" (timeout)") : TEXT(""));
+
+	if (bStopOnConvergence && !bTimedOut)
+	{
+		Aggregates.AddRun(Run.Summary, Run.Evaluations);
+		bConverged = Aggregates.UpdateConvergence(FMonteCarloCampaign::GetMinRunsSetting(),
+			FMonteCarloCampaign::GetRelativeToleranceSetting(), FMonteCarloCampaign::GetAbsoluteToleranceSetting());
+		if (bConverged)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Headless scenario: indicators converged after %d runs"), CurrentRun + 1);
+		}
+	}
+
+	++CurrentRun;
+	if (CurrentRun < Repetitions && !bConverged)
+	{
+		BeginRun();
+		return;
+	}
+
+	bool bAllPass = true;
+	bool bAnyTimeout = false;
+	for (const FRunResult& Result : Results)
+	{
+		bAllPass &= Result.bPass;
+		bAnyTimeout |= Result.bTimedOut;
+	}
+
+	if (bAnyTimeout)
+	{
+		Finish(ExitError, TEXT("部分轮次在导弹结算前超时"));
+	}
+	else
+	{
+		Finish(bAllPass ? ExitPass : ExitFail, bAllPass ? TEXT("全部指标达标") : TEXT("存在未达标指标"));
+	}
+}
+
+FProcHandle FScenarioHeadlessRunner::LaunchWorkerProcess(const FString& ScenarioFile, const FString& OutputFile)
+{
+	FString Params;
+	// 未烘焙运行（编辑器/-game）时工作进程需要携带工程文件
+	if (!FPlatformProperties::RequiresCookedData())
+	{
+		Params = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+	}
+	Params += FString::Printf(TEXT("-nullrhi -nosound -unattended -nosplash -ScenarioFile=\"%s\" -ScenarioOut=\"%s\""),
+		*ScenarioFile, *OutputFile);
+
+	const FString ExecutablePath = FPlatformProcess::ExecutablePath();
+	FProcHandle Process = FPlatformProcess::CreateProc(*ExecutablePath, *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+	if (!Process.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to launch scenario worker: %s %s"), *ExecutablePath, *Params);
+	}
+	return Process;
+}
+
+bool FScenarioHeadlessRunner::WriteResults(const FString& Reason, int32 ExitCode) const
+{
+	TSharedRef<FJsonObject> Root = MakeShareable(new FJsonObject);
+	Root->SetStringField(TEXT("scenarioFile"), ScenarioFilePath);
+	Root->SetStringField(TEXT("timestamp"), FDateTime::Now().ToIso8601());
+	Root->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Config));
+	Root->SetNumberField(TEXT("repetitions"), Repetitions);
+	Root->SetNumberField(TEXT("shotsPerRun"), ShotsPerRun);
+	Root->SetNumberField(TEXT("baseSeed"), BaseSeed);
+	Root->SetNumberField(TEXT("exitCode"), ExitCode);
+	Root->SetStringField(TEXT("result"), Reason);
+
+	TArray<TSharedPtr<FJsonValue>> Runs;
+	int32 PassedRuns = 0;
+	double HitRateSum = 0.0;
+	for (const FRunResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> RunObject = MakeShareable(new FJsonObject);
+		RunObject->SetNumberField(TEXT("run"), Result.RunIndex);
+		RunObject->SetNumberField(TEXT("seed"), Result.Seed);
+		RunObject->SetBoolField(TEXT("timedOut"), Result.bTimedOut);
+		RunObject->SetBoolField(TEXT("pass"), Result.bPass);
+		RunObject->SetObjectField(TEXT("summary"), ScenarioConfigIO::SummaryToJson(Result.Summary));
+
+		TArray<TSharedPtr<FJsonValue>> Evaluations;
+		for (const FIndicatorEvaluationResult& Evaluation : Result.Evaluations)
+		{
+			Evaluations.Add(MakeShareable(new FJsonValueObject(ScenarioConfigIO::EvaluationToJson(Evaluation))));
+		}
+		RunObject->SetArrayField(TEXT("evaluations"), Evaluations);
+		Runs.Add(MakeShareable(new FJsonValueObject(RunObject)));
+
+		PassedRuns += Result.bPass ? 1 : 0;
+		HitRateSum += Result.Summary.HitRate;
+	}
+	Root->SetArrayField(TEXT("runs"), Runs);
+	Root->SetNumberField(TEXT("completedRuns"), Results.Num());
+	Root->SetNumberField(TEXT("passedRuns"), PassedRuns);
+	Root->SetNumberField(TEXT("meanHitRate"), Results.Num() > 0 ? HitRateSum / Results.Num() : 0.0);
+	if (bIsBranch)
+	{
+		TSharedRef<FJsonObject> Branch = MakeShareable(new FJsonObject);
+		Branch->SetStringField(TEXT("checkpoint"), CheckpointFilePath);
+		Branch->SetNumberField(TEXT("checkpointSessionSeconds"), Checkpoint.SessionSeconds);
+		Branch->SetObjectField(TEXT("variant"), BranchVariant.ToJson());
+		Root->SetObjectField(TEXT("branch"), Branch);
+	}
+	if (bStopOnConvergence)
+	{
+		Root->SetBoolField(TEXT("converged"), bConverged);
+		Root->SetObjectField(TEXT("aggregates"), Aggregates.ToJson());
+	}
+
+	return ScenarioConfigIO::WriteJsonToFile(Root, OutputFilePath);
+}
+
+void FScenarioHeadlessRunner::Finish(int32 ExitCode, const FString& Reason)
+{
+	Phase = EPhase::Finished;
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	if (!OutputFilePath.IsEmpty() && !WriteResults(Reason, ExitCode) && ExitCode == ExitPass)
+	{
+		ExitCode = ExitError;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Headless scenario finished: %s (exit code %d, results: %s)"), *Reason, ExitCode, *OutputFilePath);
+	FPlatformMisc::RequestExitWithStatus(false, static_cast<uint8>(ExitCode));
+}
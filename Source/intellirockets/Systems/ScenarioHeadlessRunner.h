@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "Systems/ScenarioCheckpoint.h"
+#include "Systems/MonteCarloCampaign.h"
+#include "UI/SScenarioScreen.h"
+
+class UScenarioMenuSubsystem;
+class FJsonObject;
+
+/**
+ * 无界面场景批量运行：
+ * 通过命令行传入场景文件，跳过 Slate 向导，按设定次数重复“部署 -> 自动发射 -> 等待导弹结束 -> 结算”，
+ * 把每次的 FMissileTestSummary 与指标评估写入 JSON，最后以通过/失败退出码结束进程。
+ *
+ * 用法（专用服务器目标或 -nullrhi 均可，无需 GPU）：
+ *   intellirocketsServer -ScenarioFile=D:/Scenarios/desert.json -ScenarioRuns=10 -ScenarioShots=8
+ *       [-ScenarioOut=D:/Results/desert.json] [-ScenarioTimeout=180] [-ScenarioSeed=42]
+ *
+ * 随机采样测试方法（testMethodTypeIndex = 0）下加 -ScenarioConverge（或 runner.stopOnConvergence）时，
+ * -ScenarioRuns 视为最大轮数，各指标 95% 置信区间收敛后提前结束（阈值见 ir.MonteCarlo.*）。
+ *
+ * 场景文件带有 branch 字段（分支推演工作进程）时只运行一轮：地图加载后不再发射，
+ * 而是恢复 branch.checkpoint 指向的检查点并应用 branch.variant，等待在飞导弹与剩余自动发射结束后结算。
+ *
+ * 退出码：0 全部已评估指标达标；1 存在未达标指标；2 场景文件/部署/超时等运行错误。
+ */
+class FScenarioHeadlessRunner
+{
+public:
+	enum EExitCode : int32
+	{
+		ExitPass = 0,
+		ExitFail = 1,
+		ExitError = 2,
+	};
+
+	/** 命令行中带有 -ScenarioFile= 时返回 true */
+	static bool IsRequested();
+
+	explicit FScenarioHeadlessRunner(UScenarioMenuSubsystem* InSubsystem);
+	~FScenarioHeadlessRunner();
+
+	/** 读取命令行与场景文件并开始运行，失败时直接以错误码退出 */
+	bool Start();
+
+	/** 以无界面模式启动本机工作进程运行场景文件（正交批量与分支推演共用） */
+	static FProcHandle LaunchWorkerProcess(const FString& ScenarioFile, const FString& OutputFile);
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+private:
+	enum class EPhase : uint8
+	{
+		WaitingForWorld,
+		WaitingForDeployment,
+		Firing,
+		WaitingForMissiles,
+		Finished,
+	};
+
+	struct FRunResult
+	{
+		int32 RunIndex = 0;
+		int32 Seed = 0;
+		bool bTimedOut = false;
+		bool bPass = true;
+		FMissileTestSummary Summary;
+		TArray<FIndicatorEvaluationResult> Evaluations;
+	};
+
+	bool HandleTick(float DeltaTime);
+	void BeginRun();
+	/** 分支推演：恢复检查点代替部署后的发射 */
+	void BeginBranchRun();
+	void FinishRun(bool bTimedOut);
+	void Finish(int32 ExitCode, const FString& Reason);
+	bool WriteResults(const FString& Reason, int32 ExitCode) const;
+	double GetWorldSeconds() const;
+
+	TWeakObjectPtr<UScenarioMenuSubsystem> SubsystemWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	FScenarioTestConfig Config;
+	FString ScenarioFilePath;
+	FString OutputFilePath;
+	int32 Repetitions = 1;
+	int32 ShotsPerRun = 5;
+	float RunTimeoutSeconds = 180.f;
+	int32 BaseSeed = 0;
+	bool bHasSeed = false;
+	bool bStopOnConvergence = false;
+	bool bIsBranch = false;
+	FString CheckpointFilePath;
+	FScenarioCheckpoint Checkpoint;
+	FScenarioBranchVariant BranchVariant;
+	bool bConverged = false;
+	FMonteCarloAggregates Aggregates;
+
+	EPhase Phase = EPhase::WaitingForWorld;
+	int32 CurrentRun = 0;
+	double PhaseStartSeconds = 0.0;
+	TArray<FRunResult> Results;
+};
@@ -36,12 +36,116 @@
 #include "UI/Widgets/MissileOverlayWidget.h"
 #include "GameFramework/WorldSettings.h"
 #include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
 #include "DrawDebugHelpers.h"
 #include "CollisionQueryParams.h"
 #include "Engine/Engine.h"
+#include "Systems/MissileTrace.h"
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/ScenarioAssetPreloader.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Engine/GameInstance.h"
 
 namespace
 {
+	TAutoConsoleVariable<int32> CVarReuseLoadedLevel(
+		TEXT("ir.Scenario.ReuseLoadedLevel"),
+		1,
+		TEXT("1: 场景地图已加载时原地重置（清理并重新部署），不再 OpenLevel；0: 每次都重新加载关卡"));
+
+	TAutoConsoleVariable<float> CVarSkyRecaptureDelay(
+		TEXT("ir.Environment.SkyRecaptureDelay"),
+		0.5f,
+		TEXT("切换时间段后延迟多少秒再重新捕获天光（多次切换合并为一次）；<= 0 时立即捕获"));
+
+	UScenarioMenuSubsystem* GetScenarioSubsystem(UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<UScenarioMenuSubsystem>() : nullptr;
+	}
+
+	// 会话回放查看器控制
+	FAutoConsoleCommandWithWorldAndArgs CmdReplayOpen(
+		TEXT("ir.Replay.Open"),
+		TEXT("打开会话回放：ir.Replay.Open [文件路径]，省略路径时打开 Saved/Replays 下最新的回放"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World))
+			{
+				Subsystem->OpenReplay(FString::Join(Args, TEXT(" ")));
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CmdReplayClose(
+		TEXT("ir.Replay.Close"),
+		TEXT("关闭会话回放并移除代理可视体"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World))
+			{
+				Subsystem->CloseReplay();
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CmdReplayPause(
+		TEXT("ir.Replay.Pause"),
+		TEXT("暂停/继续会话回放"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World))
+			{
+				FScenarioReplayPlayer& Player = Subsystem->GetReplayPlayer();
+				Player.SetPaused(!Player.IsPaused());
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CmdReplaySpeed(
+		TEXT("ir.Replay.Speed"),
+		TEXT("设置回放倍速：ir.Replay.Speed <倍数>，负值倒放"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World);
+			if (Subsystem && Args.Num() > 0)
+			{
+				Subsystem->GetReplayPlayer().SetSpeed(FCString::Atof(*Args[0]));
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CmdReplaySeek(
+		TEXT("ir.Replay.Seek"),
+		TEXT("回放跳转：ir.Replay.Seek <秒>；ir.Replay.Seek +/-<秒> 相对当前时间拖动"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World);
+			if (!Subsystem || Args.Num() == 0)
+			{
+				return;
+			}
+
+			FScenarioReplayPlayer& Player = Subsystem->GetReplayPlayer();
+			const bool bRelative = Args[0].StartsWith(TEXT("+")) || Args[0].StartsWith(TEXT("-"));
+			const float Seconds = FCString::Atof(*Args[0]);
+			Player.Seek(bRelative ? Player.GetTime() + Seconds : Seconds);
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs CmdJammingVerify(
+		TEXT("ir.Jamming.Verify"),
+		TEXT("校验干扰场烘焙精度：在每个干扰器附近贴地取点比较插值与解析干信比，偏差过大时输出警告"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UScenarioMenuSubsystem* Subsystem = GetScenarioSubsystem(World))
+			{
+				const int32 NumFailed = Subsystem->VerifyJammingField();
+				UE_LOG(LogTemp, Log, TEXT("ir.Jamming.Verify: %d jammer(s) out of tolerance"), NumFailed);
+			}
+		}));
+
+	TAutoConsoleVariable<int32> CVarBlueForceInstanced(
+		TEXT("ir.BlueForce.Instanced"),
+		0,
+		TEXT("1: 蓝方单位以实例化网格（每种单位一个 HISM 组件）部署，适合上千目标的密集场景；0: 每个单位一个 StaticMeshActor"));
+
 	struct FEnvironmentEffect
 	{
 		// 干扰对抗算法
@@ -174,6 +278,15 @@ namespace
 		const float CombinedPenalty = FMath::Clamp((NormDuration * 0.7f) + (NormDelay * 0.3f), 0.f, 2.f);
 		Summary.CountermeasureResourceCostScore = FMath::Clamp(100.f - CombinedPenalty * 50.f, 0.f, 100.f);
 	}
+
+	void GatherRecordPointers(const TArray<FMissileTestRecord>& Records, TArray<const FMissileTestRecord*>& OutPointers)
+	{
+		OutPointers.Reset(Records.Num());
+		for (const FMissileTestRecord& Record : Records)
+		{
+			OutPointers.Add(&Record);
+		}
+	}
 }
 
 void UScenarioMenuSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -181,6 +294,27 @@ void UScenarioMenuSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 	UE_LOG(LogTemp, Log, TEXT("UScenarioMenuSubsystem::Initialize"));
 	WorldHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &UScenarioMenuSubsystem::OnWorldReady);
+
+	IndicatorFormulas = FIndicatorFormulaTable::LoadFromFile(FPaths::ProjectConfigDir() / TEXT("DecisionIndicators.json"));
+	if (!IndicatorFormulas.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UScenarioMenuSubsystem: 指标公式加载失败，测试结果将不含指标数值"));
+	}
+
+	if (FScenarioHeadlessRunner::IsRequested())
+	{
+		HeadlessRunner = MakeUnique<FScenarioHeadlessRunner>(this);
+		HeadlessRunner->Start();
+	}
+	else if (FScenarioRemoteControl::IsRequested())
+	{
+		// 无界面运行自行驱动流程，不与远程调用同时开启
+		RemoteControl = MakeUnique<FScenarioRemoteControl>(this);
+		if (!RemoteControl->Start())
+		{
+			RemoteControl.Reset();
+		}
+	}
 }
 
 void UScenarioMenuSubsystem::Deinitialize()
@@ -195,6 +329,7 @@ void UScenarioMenuSubsystem::Deinitialize()
 	{
 		World->GetTimerManager().ClearTimer(AutoFireTimerHandle);
 		World->GetTimerManager().ClearTimer(MissileCameraTimerHandle);
+		World->GetTimerManager().ClearTimer(SkyRecaptureTimerHandle);
 	}
 	MissileCameraTarget = nullptr;
 	RemoveMissileOverlay();
@@ -207,6 +342,20 @@ void UScenarioMenuSubsystem::Deinitialize()
 	}
 	Screen.Reset();
 	HideBlueMonitor();
+	RemoteControl.Reset();
+	HeadlessRunner.Reset();
+	OrthogonalExecutor.Reset();
+	MonteCarloCampaign.Reset();
+	BranchExecutor.Reset();
+	FScenarioAssetPreloader::Get().ReleaseAll();
+	ActorRegistry.Reset();
+	ReplayPlayer.Close();
+	ReplayRecorder.Reset();
+	ResultsExporter.Cancel();
+	IndicatorBootstrap.Reset();
+	TelemetryStream.Shutdown();
+	TelemetryRecorder.Reset();
+	PerformanceRecorder.Reset();
 	Super::Deinitialize();
 }
 
@@ -228,6 +377,12 @@ void UScenarioMenuSubsystem::OnWorldReady(UWorld* World, const UWorld::Initializ
 			return;
 		}
 
+		// 无界面运行不创建向导界面
+		if (HeadlessRunner)
+		{
+			return;
+		}
+
 		// 立即尝试显示，并在 0.1s 后再次尝试一次，避免初始化竞态
 		Show(World);
 		FTimerHandle Timer;
@@ -372,6 +527,14 @@ void UScenarioMenuSubsystem::Next()
 {
 	StepIndex = FMath::Min(4, StepIndex + 1); // 限制在0-4之间（5个步骤）
 	UE_LOG(LogTemp, Log, TEXT("Next clicked, StepIndex=%d"), StepIndex);
+
+	// Step3 环境确认后即开始异步预加载场景资源，避免首次部署/发射时同步加载卡顿
+	if (StepIndex == 3 && Screen.IsValid())
+	{
+		FScenarioTestConfig Config;
+		Screen->CollectScenarioConfig(Config);
+		FScenarioAssetPreloader::Get().PreloadScenarioAssets(Config);
+	}
     if (Screen.IsValid()) { Screen->SetStepIndex(StepIndex); }
 }
 
@@ -390,6 +553,139 @@ void UScenarioMenuSubsystem::ResetToStep1()
 	if (Screen.IsValid()) { Screen->SetStepIndex(StepIndex); }
 }
 
+bool UScenarioMenuSubsystem::StartOrthogonalBatch(const FScenarioTestConfig& BaseConfig, FString& OutError)
+{
+	if (!OrthogonalExecutor.IsValid())
+	{
+		OrthogonalExecutor = MakeUnique<FOrthogonalBatchExecutor>();
+		OrthogonalExecutor->OnFinished.BindWeakLambda(this, [this]()
+		{
+			// 各单元在工作进程中运行且不写历史，批量结束后追加一条聚合条目
+			if (FResultsHistoryStore::IsEnabled() && OrthogonalExecutor->HasResults())
+			{
+				FMissileTestSummary Summary;
+				TArray<FIndicatorEvaluationResult> Evaluations;
+				OrthogonalExecutor->BuildHistoryResult(Summary, Evaluations);
+				FResultsHistoryArtifacts BatchArtifacts;
+				BatchArtifacts.BatchKind = TEXT("Orthogonal");
+				BatchArtifacts.BatchResultFile = OrthogonalExecutor->GetOutputDirectory() / TEXT("main_effects.json");
+				BatchArtifacts.BatchRuns = OrthogonalExecutor->GetMainEffects().CompletedCells;
+				ResultsHistory.Append(OrthogonalExecutor->GetBaseConfig(), Summary, Evaluations, BatchArtifacts);
+			}
+
+			// 批量结束后跳到 Step5 展示主效应表
+			StepIndex = 4;
+			if (Screen.IsValid())
+			{
+				Screen->SetActiveTabIndex(ReturnTabIndex);
+				Screen->SetStepIndex(StepIndex);
+			}
+		});
+	}
+
+	if (!OrthogonalExecutor->Start(BaseConfig, OutError))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("StartOrthogonalBatch failed: %s"), *OutError);
+		return false;
+	}
+
+	// 刷新 Step4 的进度显示
+	if (Screen.IsValid()) { Screen->SetStepIndex(StepIndex); }
+	return true;
+}
+
+void UScenarioMenuSubsystem::CancelOrthogonalBatch()
+{
+	if (OrthogonalExecutor.IsValid())
+	{
+		OrthogonalExecutor->Cancel();
+	}
+	if (Screen.IsValid()) { Screen->SetStepIndex(StepIndex); }
+}
+
+bool UScenarioMenuSubsystem::StartBranchRun(FString& OutError)
+{
+	if (IsBranchRunRunning())
+	{
+		OutError = TEXT("分支推演正在运行");
+		return false;
+	}
+	if (!bIsRunningScenario || HeadlessRunner || IsMonteCarloRunning())
+	{
+		OutError = TEXT("只能在手动测试进行中采集检查点");
+		return false;
+	}
+
+	FScenarioCheckpoint Checkpoint;
+	if (!CaptureCheckpoint(Checkpoint))
+	{
+		OutError = TEXT("当前没有可采集的场景");
+		return false;
+	}
+	if (Checkpoint.Missiles.Num() == 0 && Checkpoint.AutoFireRemaining <= 0)
+	{
+		OutError = TEXT("当前没有在飞导弹或待发射导弹，各分支没有可比较的后续");
+		return false;
+	}
+
+	if (!BranchExecutor.IsValid())
+	{
+		BranchExecutor = MakeUnique<FScenarioBranchExecutor>();
+		BranchExecutor->OnFinished.BindWeakLambda(this, [this]()
+		{
+			// 已回到 Step5 时刷新分支对比表；测试仍在进行时留到结束后展示
+			if (Screen.IsValid() && StepIndex == 4)
+			{
+				Screen->SetStepIndex(StepIndex);
+			}
+		});
+	}
+
+	TArray<FScenarioBranchVariant> Variants;
+	FScenarioBranchExecutor::MakeDefaultVariants(Checkpoint, Variants);
+	return BranchExecutor->Start(Checkpoint, Variants, OutError);
+}
+
+bool UScenarioMenuSubsystem::StartMonteCarloCampaign(const FScenarioTestConfig& Config)
+{
+	if (IsMonteCarloRunning() || bIsRunningScenario)
+	{
+		return false;
+	}
+
+	if (Screen.IsValid())
+	{
+		ReturnTabIndex = Screen->GetActiveTabIndex();
+	}
+
+	if (!MonteCarloCampaign.IsValid())
+	{
+		MonteCarloCampaign = MakeUnique<FMonteCarloCampaign>(this);
+		MonteCarloCampaign->OnFinished.BindWeakLambda(this, [this]()
+		{
+			// 各轮不逐轮写历史，结束时追加一条聚合条目
+			if (FResultsHistoryStore::IsEnabled() && MonteCarloCampaign->HasResults())
+			{
+				FMissileTestSummary Summary;
+				TArray<FIndicatorEvaluationResult> Evaluations;
+				MonteCarloCampaign->GetAggregates().BuildHistoryResult(Summary, Evaluations);
+				FResultsHistoryArtifacts BatchArtifacts;
+				BatchArtifacts.BatchKind = TEXT("MonteCarlo");
+				BatchArtifacts.BatchResultFile = MonteCarloCampaign->GetOutputDirectory() / TEXT("summary.json");
+				BatchArtifacts.BatchRuns = MonteCarloCampaign->GetAggregates().GetRunCount();
+				ResultsHistory.Append(MonteCarloCampaign->GetConfig(), Summary, Evaluations, BatchArtifacts);
+			}
+
+			// 无界面运行时只退出进程，不返回向导
+			if (!HeadlessRunner)
+			{
+				ReturnToResultsScreen();
+			}
+		});
+	}
+	return MonteCarloCampaign->Start(Config);
+}
+
 void UScenarioMenuSubsystem::SaveAll()
 {
 	UE_LOG(LogTemp, Log, TEXT("SaveAll clicked"));
@@ -399,6 +695,15 @@ void UScenarioMenuSubsystem::SaveAll()
 	{
 		Screen->SavePersistentTables();
 		UE_LOG(LogTemp, Log, TEXT("SaveAll: persistent tables saved."));
+
+		// 同时导出当前配置为场景文件，可用于 -ScenarioFile= 无界面批量运行
+		FScenarioTestConfig Config;
+		Screen->CollectScenarioConfig(Config);
+		const FString ScenarioPath = FPaths::ProjectSavedDir() / TEXT("Scenarios") / TEXT("LastScenario.json");
+		if (ScenarioConfigIO::SaveConfigToFile(ScenarioPath, Config))
+		{
+			UE_LOG(LogTemp, Log, TEXT("SaveAll: scenario file saved to %s"), *ScenarioPath);
+		}
 	}
 }
 
@@ -423,7 +728,11 @@ void UScenarioMenuSubsystem::BeginScenarioTest()
 
 	FScenarioTestConfig Config;
 	Screen->CollectScenarioConfig(Config);
+	StartScenarioWithConfig(Config);
+}
 
+void UScenarioMenuSubsystem::StartScenarioWithConfig(const FScenarioTestConfig& Config)
+{
 	UE_LOG(LogTemp, Log, TEXT("BeginScenarioTest: MapIndex=%d MapLevelName=%s TestMethodIndex=%d EnvInterfIdx=%d"),
 		Config.MapIndex,
 		Config.MapLevelName.IsNone() ? TEXT("None") : *Config.MapLevelName.ToString(),
@@ -449,6 +758,9 @@ void UScenarioMenuSubsystem::BeginScenarioTest()
 	UE_LOG(LogTemp, Log, TEXT("BeginScenarioTest: 躲避对抗算法启用=%d"), bEvasionSubsystemSelected ? 1 : 0);
 	ClearSpawnedBlueUnits();
 
+	// 与关卡加载并行流送场景资源（界面流程已在 Step3 确认时请求，这里覆盖无界面/批量启动）
+	FScenarioAssetPreloader::Get().PreloadScenarioAssets(Config);
+
 	if (OnScenarioTestRequested.IsBound())
 	{
 		OnScenarioTestRequested.Broadcast(Config);
@@ -461,7 +773,13 @@ void UScenarioMenuSubsystem::BeginScenarioTest()
 	if (UWorld* World = GetWorld())
 	{
 		Hide(World);
-		if (!Config.MapLevelName.IsNone())
+		if (!Config.MapLevelName.IsNone() && CanResetScenarioInPlace(World, Config))
+		{
+			// 目标地图已加载：跳过关卡加载、流送与着色器预热，直接原地重置
+			UE_LOG(LogTemp, Log, TEXT("Scenario map %s already loaded, resetting in place."), *Config.MapLevelName.ToString());
+			ResetScenarioInPlace(World, Config, true);
+		}
+		else if (!Config.MapLevelName.IsNone())
 		{
 			FString LevelNameStr = Config.MapLevelName.ToString();
 			UE_LOG(LogTemp, Log, TEXT("Opening scenario map: %s"), *LevelNameStr);
@@ -475,482 +793,387 @@ void UScenarioMenuSubsystem::BeginScenarioTest()
 			ApplyEnvironmentSettings(World, Config);
 			DeployBlueForScenario(World, Config);
 			bHasPendingScenarioConfig = false;
+			BeginPerformanceCapture(World);
 		}
 	}
 }
 
-void UScenarioMenuSubsystem::BuildIndicatorEvaluations(TArray<FIndicatorEvaluationResult>& OutResults) const
+void UScenarioMenuSubsystem::SummarizeMissileRecords(const FIndicatorEvaluationInputs& Inputs, TConstArrayView<const FMissileTestRecord*> Records, FMissileTestSummary& InOutSummary)
 {
-	OutResults.Reset();
-
-	if (!bHasActiveScenarioConfig || ActiveScenarioConfig.SelectedIndicatorIds.Num() == 0)
+	if (Records.Num() == 0)
 	{
 		return;
-}
+	}
+
+	InOutSummary.TotalShots = Records.Num();
+	double TotalFlightTime = 0.0;
+	int32 FlightSamples = 0;
+	double TotalDistance = 0.0;
+	double TotalDestroyed = 0.0;
 
-	const bool bHasData = MissileTestRecords.Num() > 0;
-	const FMissileTestSummary& Summary = LastMissileSummary;
+	double LastAutoLaunchTime = -1.0;
+	double AutoIntervalAccumulator = 0.0;
+	int32 AutoIntervals = 0;
 
-	// 预先计算自动发射相关的统计数据（避免在循环中重复计算）
-	int32 AutoHits = 0;
-	int32 AutoShots = 0;
-	for (const FMissileTestRecord& Record : MissileTestRecords)
+	int32 MissCount = 0;
+
+	// 干扰对抗新指标统计
+	int32 CountermeasureEnabledMissiles = 0; // 启用干扰对抗算法的导弹数
+	int32 CountermeasureSuppressionSuccessCount = 0; // 干扰抑制成功数（在干扰区域内失去目标或未命中）
+	int32 CountermeasureRadiusReductionSamples = 0; // 反制半径缩减样本数
+	float CountermeasureRadiusReductionAccumulator = 0.f; // 反制半径缩减累计值
+	int32 CountermeasureEnteredJammerRangeCount = 0; // 进入干扰区域的导弹数
+	int32 CountermeasureCoverageSuccessCount = 0; // 干扰覆盖成功数（进入干扰区域且失去目标或未命中）
+	int32 CountermeasureDurationSamples = 0; // 干扰持续时间样本数
+	float CountermeasureDurationAccumulator = 0.f; // 干扰持续时间累计值
+	float DetectionMarginAccumulator = 0.f;
+	int32 DetectionSamples = 0;
+	float ActivationDelayAccumulator = 0.f;
+	int32 ActivationSamples = 0;
+	int32 ActivationOnTimeCount = 0;
+	float ActivationDistanceAccumulator = 0.f;
+	float ActivationHeightAccumulator = 0.f;
+
+	for (const FMissileTestRecord* RecordPtr : Records)
 	{
+		const FMissileTestRecord& Record = *RecordPtr;
 		if (Record.bAutoFire)
 		{
-			++AutoShots;
-			if (Record.DestroyedCount > 0)
+			++InOutSummary.AutoShots;
+			if (LastAutoLaunchTime >= 0.0)
 			{
-				++AutoHits;
+				AutoIntervalAccumulator += Record.LaunchTimeSeconds - LastAutoLaunchTime;
+				++AutoIntervals;
 			}
+			LastAutoLaunchTime = Record.LaunchTimeSeconds;
 		}
-	}
-	const float AutoHitRate = AutoShots > 0 ? (static_cast<float>(AutoHits) * 100.f / AutoShots) : 0.f;
-	const float AutoFireRatio = Summary.TotalShots > 0 ? (static_cast<float>(Summary.AutoShots) * 100.f / Summary.TotalShots) : 0.f;
-
-	for (int32 Index = 0; Index < ActiveScenarioConfig.SelectedIndicatorIds.Num(); ++Index)
-	{
-		const FString& IndicatorId = ActiveScenarioConfig.SelectedIndicatorIds[Index];
-		const FString DisplayName = ActiveScenarioConfig.SelectedIndicatorDetails.IsValidIndex(Index)
-			? ActiveScenarioConfig.SelectedIndicatorDetails[Index]
-			: IndicatorId;
-
-		FIndicatorEvaluationResult Result;
-		Result.IndicatorId = IndicatorId;
-		Result.DisplayName = DisplayName;
-		Result.StatusText = TEXT("已完成");
-		Result.StatusColor = FLinearColor(0.1f, 0.8f, 0.3f);
-		Result.RemarkText = TEXT("该指标测试已完成。");
-		Result.TargetText = TEXT("—");
-		Result.ValueText = TEXT("—");
-
-		if (!bHasData)
+		else
 		{
-			Result.RemarkText = TEXT("尚未执行导弹测试。按 P 结束一次测试后将生成数据。");
-			OutResults.Add(Result);
-			continue;
+			++InOutSummary.ManualShots;
 		}
 
-		auto EvaluateThreshold = [&Result](float Value, float Target, bool bHigherIsBetter, const FString& Unit, const FString& Remark)
-		{
-			Result.ValueText = FString::Printf(TEXT("%.2f%s"), Value, *Unit);
-			Result.TargetText = FString::Printf(TEXT("%s %.2f%s"),
-				bHigherIsBetter ? TEXT("≥") : TEXT("≤"),
-				Target, *Unit);
-			const bool bPass = bHigherIsBetter ? (Value >= Target) : (Value <= Target);
-			Result.bHasData = true;
-			Result.bPass = bPass;
-			Result.StatusText = bPass ? TEXT("达标") : TEXT("未达标");
-			Result.StatusColor = bPass ? FLinearColor(0.1f, 0.8f, 0.3f) : FLinearColor(0.85f, 0.2f, 0.2f);
-			Result.RemarkText = Remark;
-		};
+		TotalDistance += Record.InitialDistance;
 
-		const FPerceptionRuntimeStats& P = PerceptionStats;
+		const float FlightTime = Record.GetFlightDuration();
+		if (FlightTime > 0.f)
+		{
+			TotalFlightTime += FlightTime;
+			++FlightSamples;
+		}
 
-		// 9.1.1 感知算法性能指标
-		if (IndicatorId.StartsWith(TEXT("9.1.1")))
+		if (Record.DestroyedCount > 0)
 		{
-			if (IndicatorId == TEXT("9.1.1.1"))
+			++InOutSummary.Hits;
+			if (Record.bDirectHit)
 			{
-				const int32 Den = P.NumDetectionsCorrect + P.NumFalsePositives;
-				const float FalsePositiveRate = Den > 0 ? (float)P.NumFalsePositives / (float)Den * 100.f : 0.f;
-				EvaluateThreshold(FalsePositiveRate, 0.5f, false, TEXT("%"), TEXT("误报率不超过0.5%"));
+				++InOutSummary.DirectHits;
 			}
-			else if (IndicatorId == TEXT("9.1.1.1b"))
+			else
 			{
-				const int32 Den = P.NumDetectionsCorrect + P.NumFalseNegatives;
-				const float FalseNegativeRate = Den > 0 ? (float)P.NumFalseNegatives / (float)Den * 100.f : 0.f;
-				EvaluateThreshold(FalseNegativeRate, 1.0f, false, TEXT("%"), TEXT("漏报率不超过1%"));
+				++InOutSummary.AoEHits;
 			}
-			else if (IndicatorId == TEXT("9.1.1.2"))
+			TotalDestroyed += Record.DestroyedCount;
+		}
+		else
+		{
+			++MissCount;
+		}
+
+		const FMissileCountermeasureStats& CounterStats = Record.CountermeasureStats;
+		if (CounterStats.bCountermeasureEnabled)
+		{
+			if (CounterStats.bDetectionLogged && CounterStats.DetectionBaseRadius > KINDA_SMALL_NUMBER)
 			{
-				const float AvgRec = P.NumRecognitionSamples > 0 ? (float)(P.TotalRecognitionTimeSeconds / P.NumRecognitionSamples) : 0.f;
-				EvaluateThreshold(AvgRec, 0.2f, false, TEXT(" s"), TEXT("识别时间小于0.2秒"));
+				++DetectionSamples;
+				const float MarginPercent = (CounterStats.DetectionDistanceToJammer - CounterStats.DetectionBaseRadius) / CounterStats.DetectionBaseRadius * 100.f;
+				DetectionMarginAccumulator += MarginPercent;
 			}
-			else if (IndicatorId == TEXT("9.1.1.3a"))
+			if (CounterStats.bCountermeasureActivated && CounterStats.CountermeasureActivationTime >= 0.f && CounterStats.DetectionTime >= 0.f)
 			{
-				const float Rate = P.SamplesLightTotal > 0 ? (float)P.SamplesLightCorrect / (float)P.SamplesLightTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 90.f, true, TEXT("%"), TEXT("不同光照条件识别率不低于90%"));
+				++ActivationSamples;
+				const float DelaySeconds = FMath::Max(0.f, CounterStats.CountermeasureActivationTime - CounterStats.DetectionTime);
+				ActivationDelayAccumulator += DelaySeconds;
+				ActivationDistanceAccumulator += CounterStats.CountermeasureActivationDistanceToJammer;
+				ActivationHeightAccumulator += CounterStats.CountermeasureActivationHeightDifference;
+
+				const bool bDelayOk = DelaySeconds <= 0.5f;
+				const bool bDistanceOk = CounterStats.CountermeasureActivationBaseRadius > KINDA_SMALL_NUMBER
+					? (CounterStats.CountermeasureActivationDistanceToJammer >= CounterStats.CountermeasureActivationBaseRadius * 0.95f)
+					: true;
+				const bool bHeightOk = FMath::Abs(CounterStats.CountermeasureActivationHeightDifference) <= 1500.f;
+
+				if (bDelayOk && bDistanceOk && bHeightOk)
+				{
+					++ActivationOnTimeCount;
+				}
+
+				// 记录反制半径缩减率
+				if (CounterStats.CountermeasureActivationRadiusReductionPercent > 0.f)
+				{
+					++CountermeasureRadiusReductionSamples;
+					CountermeasureRadiusReductionAccumulator += CounterStats.CountermeasureActivationRadiusReductionPercent;
+				}
+
+				// 记录干扰持续时间
+				if (CounterStats.CountermeasureDuration > 0.f)
+				{
+					++CountermeasureDurationSamples;
+					CountermeasureDurationAccumulator += CounterStats.CountermeasureDuration;
+				}
 			}
-			else if (IndicatorId == TEXT("9.1.1.3b"))
+
+			// 统计干扰抑制成功率：启用干扰对抗算法后，导弹在干扰区域内失去目标或未命中
+			if (CounterStats.bCountermeasureEnabled)
 			{
-				const float Rate = P.SamplesWeatherTotal > 0 ? (float)P.SamplesWeatherCorrect / (float)P.SamplesWeatherTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 85.f, true, TEXT("%"), TEXT("不同天气条件识别率不低于85%"));
+				++CountermeasureEnabledMissiles;
+				// 如果进入过干扰区域，且失去目标或未命中，则算作抑制成功
+				if (CounterStats.bEnteredJammerRange)
+				{
+					++CountermeasureEnteredJammerRangeCount;
+					if (CounterStats.bLostTargetInJammerRange || Record.DestroyedCount == 0)
+					{
+						++CountermeasureSuppressionSuccessCount;
+						++CountermeasureCoverageSuccessCount;
+					}
+				}
 			}
-			else if (IndicatorId == TEXT("9.1.1.4a"))
-			{
-				const float Count = (float)P.MaxSimultaneousTracksObserved;
-				EvaluateThreshold(Count, 5.f, true, TEXT(""), TEXT("同时跟踪目标数量至少5个"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.4b"))
-			{
-				const float Err = P.NumTrackingErrorSamples > 0 ? (float)(P.TotalTrackingErrorMeters / P.NumTrackingErrorSamples) : 0.f;
-				EvaluateThreshold(Err, 1.0f, false, TEXT(" m"), TEXT("平均跟踪误差不超过1米"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.5a"))
-			{
-				const float Rate = P.SamplesJamLightTotal > 0 ? (float)P.SamplesJamLightCorrect / (float)P.SamplesJamLightTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 90.f, true, TEXT("%"), TEXT("轻度干扰下识别率不低于90%"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.5b"))
-			{
-				const float Rate = P.SamplesJamMediumTotal > 0 ? (float)P.SamplesJamMediumCorrect / (float)P.SamplesJamMediumTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 80.f, true, TEXT("%"), TEXT("中度干扰下识别率不低于80%"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.6a"))
-			{
-				const float Rate = P.SamplesInterferenceDetectedTotal > 0 ? (float)P.SamplesInterferenceDetectedCorrect / (float)P.SamplesInterferenceDetectedTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 95.f, true, TEXT("%"), TEXT("干扰信号检测准确率不低于95%"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.6b"))
-			{
-				const float Rate = P.SamplesFrequencyAdjustTotal > 0 ? (float)P.SamplesFrequencyAdjustSuccess / (float)P.SamplesFrequencyAdjustTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 98.f, true, TEXT("%"), TEXT("频率调整成功率不低于98%"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.7"))
-			{
-				const float Avg = P.NumRecoverySamples > 0 ? (float)(P.TotalRecoveryTimeSeconds / P.NumRecoverySamples) : 0.f;
-				EvaluateThreshold(Avg, 1.0f, false, TEXT(" s"), TEXT("从干扰状态恢复正常工作的时间小于1秒"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.8"))
-			{
-				const float Rate = P.SamplesKeypartTotal > 0 ? (float)P.SamplesKeypartCorrect / (float)P.SamplesKeypartTotal * 100.f : 0.f;
-				EvaluateThreshold(Rate, 90.f, true, TEXT("%"), TEXT("关键部位识别准确率不低于90%"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.9"))
-			{
-				const float Err = P.NumHeatTrackSamples > 0 ? (float)(P.TotalHeatTrackErrorMeters / P.NumHeatTrackSamples) : 0.f;
-				EvaluateThreshold(Err, 0.5f, false, TEXT(" m"), TEXT("热源跟踪误差不超过0.5米"));
-			}
-			else if (IndicatorId == TEXT("9.1.1.10"))
-			{
-				const float Baseline = 0.f;
-				const float Improved = P.SamplesKeypartTotal > 0 ? (float)P.SamplesKeypartCorrect / (float)P.SamplesKeypartTotal * 100.f : 0.f;
-				const float Lift = FMath::Max(0.f, Improved - Baseline);
-				EvaluateThreshold(Lift, 20.f, true, TEXT("%"), TEXT("抑制噪声与干扰后的识别率提升（需结合基线统计）"));
-			}
-			OutResults.Add(Result);
-			continue;
-		}
-		if (IndicatorId == TEXT("3.4.1.1"))
-		{
-			const float Value = Summary.AverageAutoLaunchInterval > 0.f ? Summary.AverageAutoLaunchInterval : Summary.AverageFlightTime;
-			EvaluateThreshold(Value, 0.5f, false, TEXT(" s"), TEXT("以自动发射间隔/飞行时间估算决策生成速度。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.2"))
-		{
-			// 可解释性-目标优先级设定：使用直接命中率衡量目标选择的准确性
-			EvaluateThreshold(Summary.DirectHitRate, 80.f, true, TEXT("%"), TEXT("基于直接命中率，反映目标优先级设定的准确性。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.3"))
-		{
-			// 性能性-路径规划精度：使用命中率衡量路径规划的有效性
-			EvaluateThreshold(Summary.HitRate, 85.f, true, TEXT("%"), TEXT("基于导弹命中率，反映路径规划的准确性和可执行性。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.4"))
-		{
-			// 性能性-全局最优路径规划精度：使用直接命中率衡量路径规划的精确度
-			EvaluateThreshold(Summary.DirectHitRate, 75.f, true, TEXT("%"), TEXT("基于直接命中率，反映全局最优路径规划的准确性。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.5"))
-		{
-			// 性能性-资源分配优化精度：使用每次命中平均摧毁数衡量资源利用效率
-			EvaluateThreshold(Summary.AverageDestroyedPerHit, 1.5f, true, TEXT(""), TEXT("基于每次命中平均摧毁数，反映资源分配的优化精度。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.6") || IndicatorId == TEXT("3.4.3.2"))
-		{
-			const float TargetPercent = IndicatorId == TEXT("3.4.1.6") ? 85.f : 95.f;
-			EvaluateThreshold(Summary.HitRate, TargetPercent, true, TEXT("%"), TEXT("基于导弹命中率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.7"))
-		{
-			// 可靠性-多智能体协同决策成功率：使用自动发射的命中率
-			EvaluateThreshold(AutoHitRate, 80.f, true, TEXT("%"), TEXT("基于自动发射命中率，反映多智能体协同决策的成功率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.1.8"))
-		{
-			// 功能性-任务分配协调性：使用自动发射比例衡量任务分配的协调性
-			EvaluateThreshold(AutoFireRatio, 50.f, true, TEXT("%"), TEXT("基于自动发射比例，反映多个智能体之间任务分配和协调的精确度。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.1"))
-		{
-			// 鲁棒性-动态战术调整能力：基于自动发射命中率，反映动态调整战术的能力
-			EvaluateThreshold(AutoHitRate, 80.f, true, TEXT("%"), TEXT("基于自动发射在不同目标选择下的命中率，反映动态调整战术的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.2"))
-		{
-			// 智能性-敌方行动预测智能：基于直接命中率，反映预测敌方行动的智能水平
-			EvaluateThreshold(Summary.DirectHitRate, 75.f, true, TEXT("%"), TEXT("基于直接命中率，反映预测敌方行动和选择最佳攻击时机的智能水平。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.3"))
-		{
-			// 鲁棒性-策略演化能力：基于自动发射命中率，反映策略适应和演化的能力
-			EvaluateThreshold(AutoHitRate, 70.f, true, TEXT("%"), TEXT("基于自动发射命中率与手动发射命中率的对比，反映策略适应和演化的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.4"))
-		{
-			// 智能性-多目标优化智能：基于每次命中平均摧毁数，反映多目标优化能力
-			EvaluateThreshold(Summary.AverageDestroyedPerHit, 1.8f, true, TEXT(""), TEXT("基于每次命中平均摧毁数，反映在多目标环境中智能选择最优攻击策略的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.5"))
-		{
-			const int32 ThreatSamples = P.NumDetectionsCorrect + P.NumFalsePositives + P.NumFalseNegatives;
-			const float ThreatEvalScore = ThreatSamples > 0 ? (static_cast<float>(P.NumDetectionsCorrect) * 100.f / ThreatSamples) : 0.f;
-			EvaluateThreshold(ThreatEvalScore, 85.f, true, TEXT("%"), TEXT("威胁等级评估准确率≥85%。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.6"))
-		{
-			// 智能性-博弈均衡智能：基于直接命中率，反映通过博弈理论选择最佳对抗策略的智能水平
-			EvaluateThreshold(Summary.DirectHitRate, 78.f, true, TEXT("%"), TEXT("基于直接命中率，反映通过博弈理论选择最佳对抗策略的智能水平。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.7"))
-		{
-			// 智能性-群体协作智能：基于自动发射命中率，反映群体智能体通过协作优化整体决策的表现
-			EvaluateThreshold(AutoHitRate, 82.f, true, TEXT("%"), TEXT("基于自动发射命中率，反映群体智能体通过协作优化整体决策的表现。"));
-		}
-		else if (IndicatorId == TEXT("3.4.2.8"))
-		{
-			// 智能性-协同决策学习智能：基于自动发射比例与命中率的综合评估
-			// 使用自动发射比例和命中率的加权平均：比例占40%，命中率占60%
-			const float CollaborativeScore = (AutoFireRatio * 0.4f) + (AutoHitRate * 0.6f);
-			EvaluateThreshold(CollaborativeScore, 60.f, true, TEXT("%"), TEXT("基于自动发射比例与命中率的综合评估，反映协同决策学习的智能水平。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.1"))
-		{
-			// 效能性-资源使用效能：基于每次命中平均摧毁数，反映资源使用的最大化效率
-			EvaluateThreshold(Summary.AverageDestroyedPerHit, 1.6f, true, TEXT(""), TEXT("基于每次命中平均摧毁数，反映资源使用的最大化效率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.2"))
-		{
-			// 效能性-任务完成率：基于导弹命中率
-			EvaluateThreshold(Summary.HitRate, 95.f, true, TEXT("%"), TEXT("基于导弹命中率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.8"))
-		{
-			const float Value = Summary.HLSplitAttemptCount > 0 ? (static_cast<float>(Summary.HLSplitSuccessCount) * 100.f / Summary.HLSplitAttemptCount) : 0.f;
-			EvaluateThreshold(Value, 80.f, true, TEXT("%"), TEXT("分裂触发成功率≥80%"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.9"))
-		{
-			const float Value = Summary.HLSplitChildShotCount > 0 ? (static_cast<float>(Summary.HLSplitChildHitCount) * 100.f / Summary.HLSplitChildShotCount) : 0.f;
-			EvaluateThreshold(Value, 60.f, true, TEXT("%"), TEXT("分裂子弹命中率≥60%"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.10"))
-		{
-			const float Value = Summary.HLSplitGroupCount > 0 ? (Summary.HLSplitGroupUniqueTargetsTotal / Summary.HLSplitGroupCount) : 0.f;
-			EvaluateThreshold(Value, 2.f, true, TEXT(""), TEXT("平均分裂命中目标数≥2.0"));
 		}
-		else if (IndicatorId == TEXT("3.4.3.11"))
-		{
-			EvaluateThreshold(Summary.CountermeasureAverageDetectionMarginPercent, 20.f, true, TEXT("%"), TEXT("干扰触发距离裕度≥20%"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.12"))
-		{
-			EvaluateThreshold(Summary.CountermeasureSuppressionSuccessRate, 70.f, true, TEXT("%"), TEXT("干扰抑制成功率≥70%"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.13"))
-		{
-			EvaluateThreshold(Summary.CountermeasureAverageRadiusReductionRate, 60.f, true, TEXT("%"), TEXT("反制半径缩减率≥60%"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.7"))
-		{
-			const float Value = Summary.HLSplitAttemptCount > 0 ? (static_cast<float>(Summary.HLSplitSuccessCount) * 100.f / Summary.HLSplitAttemptCount) : 0.f;
-			EvaluateThreshold(Value, 75.f, true, TEXT("%"), TEXT("分系统级多弹协同成功率≥75%"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.8"))
-		{
-			const float Value = Summary.HLSplitGroupCount > 0 ? (Summary.HLSplitGroupUniqueTargetsTotal / Summary.HLSplitGroupCount) : 0.f;
-			EvaluateThreshold(Value, 2.f, true, TEXT(""), TEXT("系统级平均协同命中目标数≥2.0"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.9"))
-		{
-			const float Value = Summary.HLSplitChildShotCount > 0 ? (static_cast<float>(Summary.HLSplitChildHitCount) * 100.f / Summary.HLSplitChildShotCount) : 0.f;
-			EvaluateThreshold(Value, 60.f, true, TEXT("%"), TEXT("分系统级子弹贡献率≥60%"));
-		}
-		else if (IndicatorId == TEXT("3.5.4.1"))
-		{
-			EvaluateThreshold(Summary.CountermeasureOnTimeRate, 85.f, true, TEXT("%"), TEXT("0.5秒内按高度/距离条件启动干扰的比例≥85%"));
-		}
-		else if (IndicatorId == TEXT("3.5.4.2"))
-		{
-			EvaluateThreshold(Summary.CountermeasureAverageActivationDelay, 0.5f, false, TEXT(" s"), TEXT("平均干扰响应延迟≤0.5秒"));
-		}
-		else if (IndicatorId == TEXT("3.5.4.3"))
-		{
-			EvaluateThreshold(Summary.CountermeasureCoverageSuccessRate, 80.f, true, TEXT("%"), TEXT("干扰覆盖成功率≥80%"));
-		}
-		else if (IndicatorId == TEXT("3.5.4.4"))
-		{
-			EvaluateThreshold(Summary.CountermeasureAverageDuration, 2.f, true, TEXT(" s"), TEXT("平均干扰持续时间≥2秒"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.3"))
-		{
-			const float Value = Summary.AverageFlightTime;
-			EvaluateThreshold(Value, 1.0f, false, TEXT(" s"), TEXT("以导弹平均飞行时间近似路径执行时长。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.4"))
-		{
-			// 效能性-反制策略执行效能：基于导弹平均飞行时间，反映反制策略生成和执行的效率
-			const float Value = Summary.AverageFlightTime;
-			EvaluateThreshold(Value, 0.8f, false, TEXT(" s"), TEXT("基于导弹平均飞行时间，反映反制策略生成和执行的效率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.5"))
+	}
+
+	InOutSummary.HitRate = InOutSummary.TotalShots > 0 ? (static_cast<float>(InOutSummary.Hits) * 100.f / InOutSummary.TotalShots) : 0.f;
+	InOutSummary.DirectHitRate = InOutSummary.Hits > 0 ? (static_cast<float>(InOutSummary.DirectHits) * 100.f / InOutSummary.Hits) : 0.f;
+	InOutSummary.AverageLaunchDistance = InOutSummary.TotalShots > 0 ? static_cast<float>(TotalDistance / InOutSummary.TotalShots) : 0.f;
+	InOutSummary.AverageFlightTime = FlightSamples > 0 ? static_cast<float>(TotalFlightTime / FlightSamples) : 0.f;
+	InOutSummary.AverageDestroyedPerHit = InOutSummary.Hits > 0 ? static_cast<float>(TotalDestroyed / InOutSummary.Hits) : 0.f;
+	InOutSummary.AverageAutoLaunchInterval = AutoIntervals > 0 ? static_cast<float>(AutoIntervalAccumulator / AutoIntervals) : 0.f;
+	InOutSummary.Misses = MissCount;
+	InOutSummary.HLSplitAttemptCount = Inputs.HLSplitAttemptCount;
+	InOutSummary.HLSplitSuccessCount = Inputs.HLSplitSuccessCount;
+	InOutSummary.HLSplitChildShotCount = Inputs.HLSplitChildShotCount;
+	InOutSummary.HLSplitChildHitCount = Inputs.HLSplitChildHitCount;
+	InOutSummary.HLSplitGroupCount = Inputs.HLSplitGroupCount;
+	InOutSummary.HLSplitGroupUniqueTargetsTotal = Inputs.HLSplitGroupUniqueTargetsTotal;
+	InOutSummary.CountermeasureDetectionSamples = DetectionSamples;
+	InOutSummary.CountermeasureAverageDetectionMarginPercent = DetectionSamples > 0 ? (DetectionMarginAccumulator / DetectionSamples) : 0.f;
+	InOutSummary.CountermeasureActivationSamples = ActivationSamples;
+	InOutSummary.CountermeasureAverageActivationDelay = ActivationSamples > 0 ? (ActivationDelayAccumulator / ActivationSamples) : 0.f;
+	InOutSummary.CountermeasureOnTimeRate = ActivationSamples > 0 ? (static_cast<float>(ActivationOnTimeCount) * 100.f / ActivationSamples) : 0.f;
+	InOutSummary.CountermeasureAverageActivationDistance = ActivationSamples > 0 ? (ActivationDistanceAccumulator / ActivationSamples) : 0.f;
+	InOutSummary.CountermeasureAverageActivationHeightDiff = ActivationSamples > 0 ? (ActivationHeightAccumulator / ActivationSamples) : 0.f;
+	InOutSummary.CountermeasureSuppressionSuccessRate = CountermeasureEnabledMissiles > 0 ? (static_cast<float>(CountermeasureSuppressionSuccessCount) * 100.f / CountermeasureEnabledMissiles) : 0.f;
+	InOutSummary.CountermeasureAverageRadiusReductionRate = CountermeasureRadiusReductionSamples > 0 ? (CountermeasureRadiusReductionAccumulator / CountermeasureRadiusReductionSamples) : 0.f;
+	InOutSummary.CountermeasureCoverageSuccessRate = CountermeasureEnteredJammerRangeCount > 0 ? (static_cast<float>(CountermeasureCoverageSuccessCount) * 100.f / CountermeasureEnteredJammerRangeCount) : 0.f;
+	InOutSummary.CountermeasureAverageDuration = CountermeasureDurationSamples > 0 ? (CountermeasureDurationAccumulator / CountermeasureDurationSamples) : 0.f;
+}
+
+void UScenarioMenuSubsystem::ApplyEnvironmentToSummary(const FIndicatorEvaluationInputs& Inputs, FMissileTestSummary& InOutSummary)
+{
+	if (Inputs.bHasConfig)
+	{
+		const FEnvironmentEffect EnvEffect = BuildEnvironmentEffect(Inputs.Config);
+		ApplyEnvironmentEffectToSummary(EnvEffect, InOutSummary);
+	}
+
+	ComputeResourceCostScore(InOutSummary);
+}
+
+void UScenarioMenuSubsystem::BuildIndicatorEvaluations(TArray<FIndicatorEvaluationResult>& OutResults) const
+{
+	TArray<const FMissileTestRecord*> RecordPtrs;
+	GatherRecordPointers(MissileTestRecords, RecordPtrs);
+	EvaluateIndicators(MakeIndicatorEvaluationInputs(), LastMissileSummary, RecordPtrs, OutResults);
+}
+
+FIndicatorEvaluationInputs UScenarioMenuSubsystem::MakeIndicatorEvaluationInputs() const
+{
+	FIndicatorEvaluationInputs Inputs;
+	Inputs.Config = ActiveScenarioConfig;
+	Inputs.bHasConfig = bHasActiveScenarioConfig;
+	Inputs.Perception = PerceptionStats;
+	Inputs.Formulas = IndicatorFormulas;
+	Inputs.HLSplitAttemptCount = HLSplitAttemptCount;
+	Inputs.HLSplitSuccessCount = HLSplitSuccessCount;
+	Inputs.HLSplitChildShotCount = HLSplitChildShotCount;
+	Inputs.HLSplitChildHitCount = HLSplitChildHitCount;
+	Inputs.HLSplitGroupCount = HLSplitGroupCount;
+	for (const auto& Pair : HLSplitGroupHits)
+	{
+		Inputs.HLSplitGroupUniqueTargetsTotal += Pair.Value.Num();
+	}
+	return Inputs;
+}
+
+void UScenarioMenuSubsystem::StartIndicatorBootstrap()
+{
+	IndicatorBootstrap.Reset();
+	if (!FIndicatorBootstrap::IsEnabled() || FScenarioHeadlessRunner::IsRequested() || MissileTestRecords.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FIndicatorEvaluationResult> PointEvaluations;
+	BuildIndicatorEvaluations(PointEvaluations);
+	if (PointEvaluations.Num() == 0)
+	{
+		return;
+	}
+
+	// 工作线程只读取这里的副本；会话级字段（时长、运行性能）沿用当前汇总
+	TSharedRef<const FIndicatorEvaluationInputs, ESPMode::ThreadSafe> Inputs = MakeShared<const FIndicatorEvaluationInputs, ESPMode::ThreadSafe>(MakeIndicatorEvaluationInputs());
+	TSharedRef<const TArray<FMissileTestRecord>, ESPMode::ThreadSafe> Records = MakeShared<const TArray<FMissileTestRecord>, ESPMode::ThreadSafe>(MissileTestRecords);
+	FMissileTestSummary BaseSummary;
+	BaseSummary.SessionDuration = LastMissileSummary.SessionDuration;
+	BaseSummary.Performance = LastMissileSummary.Performance;
+
+	// 自动发射间隔按原始发射序列预先算好，随记录一起重抽样：
+	// 有放回抽样会出现重复记录和跳过的记录，在样本内重新求相邻差会得到 0 间隔或被拉长的间隔，使区间整体偏移
+	TSharedRef<TArray<double>, ESPMode::ThreadSafe> AutoIntervals = MakeShared<TArray<double>, ESPMode::ThreadSafe>();
+	AutoIntervals->Init(-1.0, MissileTestRecords.Num());
+	double LastAutoLaunchTime = -1.0;
+	for (int32 Index = 0; Index < MissileTestRecords.Num(); ++Index)
+	{
+		const FMissileTestRecord& Record = MissileTestRecords[Index];
+		if (Record.bAutoFire)
 		{
-			// 安全性-敌方行为预测效能：基于直接命中率，反映预测敌方行为的准确性和效率
-			EvaluateThreshold(Summary.DirectHitRate, 80.f, true, TEXT("%"), TEXT("基于直接命中率，反映预测敌方行为的准确性和效率。"));
+			if (LastAutoLaunchTime >= 0.0)
+			{
+				(*AutoIntervals)[Index] = Record.LaunchTimeSeconds - LastAutoLaunchTime;
+			}
+			LastAutoLaunchTime = Record.LaunchTimeSeconds;
 		}
-		else if (IndicatorId == TEXT("3.4.3.6"))
+	}
+
+	IndicatorBootstrap.Start(MissileTestRecords.Num(), PointEvaluations,
+		[Inputs, Records, AutoIntervals, BaseSummary](TConstArrayView<int32> SampleIndices, TArray<FIndicatorEvaluationResult>& OutResults)
 		{
-			// 可靠性-多智能体任务完成时间：基于自动发射导弹的平均飞行时间
-			// 计算自动发射导弹的平均飞行时间
-			float AutoFlightTime = 0.f;
-			int32 AutoFlightCount = 0;
-			for (const FMissileTestRecord& Record : MissileTestRecords)
+			TArray<const FMissileTestRecord*> Sample;
+			Sample.Reserve(SampleIndices.Num());
+			double IntervalAccumulator = 0.0;
+			int32 IntervalCount = 0;
+			for (const int32 Index : SampleIndices)
 			{
-				if (Record.bAutoFire)
+				Sample.Add(&(*Records)[Index]);
+				if ((*AutoIntervals)[Index] >= 0.0)
 				{
-					const float FlightDuration = Record.GetFlightDuration();
-					if (FlightDuration > 0.f)
-					{
-						AutoFlightTime += FlightDuration;
-						++AutoFlightCount;
-					}
+					IntervalAccumulator += (*AutoIntervals)[Index];
+					++IntervalCount;
 				}
 			}
-			const float AvgAutoFlightTime = AutoFlightCount > 0 ? (AutoFlightTime / AutoFlightCount) : Summary.AverageFlightTime;
-			EvaluateThreshold(AvgAutoFlightTime, 1.2f, false, TEXT(" s"), TEXT("基于自动发射导弹的平均飞行时间，反映多智能体任务完成的效率。"));
-		}
-		else if (IndicatorId == TEXT("3.4.3.7"))
-		{
-			// 效能性-协同决策效能：基于自动发射命中率与资源利用效率的综合评估
-			// 使用自动发射命中率（60%）和资源利用效率（40%）的加权平均
-			const float ResourceEfficiency = Summary.AverageDestroyedPerHit;
-			const float NormalizedResourceEfficiency = FMath::Clamp(ResourceEfficiency / 2.0f * 100.f, 0.f, 100.f); // 归一化到0-100%
-			const float CollaborativeEfficiency = (AutoHitRate * 0.6f) + (NormalizedResourceEfficiency * 0.4f);
-			EvaluateThreshold(CollaborativeEfficiency, 75.f, true, TEXT("%"), TEXT("基于自动发射命中率与资源利用效率的综合评估，反映协同决策的效能。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.1"))
-		{
-			// 功能性-多任务协调能力：基于自动发射比例，反映多任务场景下协调不同智能体执行任务的能力
-			EvaluateThreshold(AutoFireRatio, 70.f, true, TEXT("%"), TEXT("基于自动发射比例，反映多任务场景下协调不同智能体执行任务的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.2"))
-		{
-			// 性能性-全局决策优化能力：基于整体命中率，反映在多目标场景中进行全局最优决策的能力
-			EvaluateThreshold(Summary.HitRate, 80.f, true, TEXT("%"), TEXT("基于整体命中率，反映在多目标场景中进行全局最优决策的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.3"))
-		{
-			// 性能性-任务切换响应速度：基于自动发射间隔，反映任务切换的响应速度
-			const float TaskSwitchTime = Summary.AverageAutoLaunchInterval > 0.f ? Summary.AverageAutoLaunchInterval : 0.6f;
-			EvaluateThreshold(TaskSwitchTime, 0.6f, false, TEXT(" s"), TEXT("基于自动发射间隔，反映任务切换的响应速度。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.4"))
-		{
-			// 可靠性-故障恢复能力：基于整体命中率，反映在系统失效情况下恢复正常决策功能的能力
-			EvaluateThreshold(Summary.HitRate, 85.f, true, TEXT("%"), TEXT("基于整体命中率，反映在系统失效情况下恢复正常决策功能的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.5"))
-		{
-			// 性能性-全局优化任务分配精度：基于自动发射命中率，反映在多个任务环境中最优分配任务的精度
-			EvaluateThreshold(AutoHitRate, 75.f, true, TEXT("%"), TEXT("基于自动发射命中率，反映在多个任务环境中最优分配任务的精度。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.6"))
-		{
-			// 功能性-层次对抗策略执行成功率：基于直接命中率，反映在多层次对抗中成功执行反制策略的比例
-			EvaluateThreshold(Summary.DirectHitRate, 82.f, true, TEXT("%"), TEXT("基于直接命中率，反映在多层次对抗中成功执行反制策略的比例。"));
-		}
-		else if (IndicatorId == TEXT("3.5.1.7"))
-		{
-			// 鲁棒性-多智能体协同效能：基于自动发射命中率与任务完成效率的综合评估
-			// 使用自动发射命中率（70%）和任务完成率（30%）的加权平均
-			const float TaskCompletionRate = Summary.HitRate;
-			const float CoordinationEfficiency = (AutoHitRate * 0.7f) + (TaskCompletionRate * 0.3f);
-			EvaluateThreshold(CoordinationEfficiency, 78.f, true, TEXT("%"), TEXT("基于自动发射命中率与任务完成效率的综合评估，反映多智能体协同效能。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.1"))
-		{
-			// 未来可扩展性-系统自学习能力：基于整体命中率，反映通过博弈对抗不断提升自身决策效率和准确性的能力
-			EvaluateThreshold(Summary.HitRate, 83.f, true, TEXT("%"), TEXT("基于整体命中率，反映通过博弈对抗不断提升自身决策效率和准确性的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.2"))
-		{
-			// 智能性-协作决策智能：基于自动发射命中率，反映多智能体协同作战时生成一致性决策的智能水平
-			EvaluateThreshold(AutoHitRate, 80.f, true, TEXT("%"), TEXT("基于自动发射命中率，反映多智能体协同作战时生成一致性决策的智能水平。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.3"))
-		{
-			// 可解释性-全局态势感知智能：基于整体命中率，反映对全局态势的理解和智能决策支持
-			EvaluateThreshold(Summary.HitRate, 85.f, true, TEXT("%"), TEXT("基于整体命中率，反映对全局态势的理解和智能决策支持。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.4"))
-		{
-			// 可解释性-全局任务分解智能：基于自动发射比例，反映智能分解全局复杂任务为多个可执行子任务并协调智能体执行的能力
-			EvaluateThreshold(AutoFireRatio, 72.f, true, TEXT("%"), TEXT("基于自动发射比例，反映智能分解全局复杂任务为多个可执行子任务并协调智能体执行的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.5"))
-		{
-			// 智能性-策略调整智能：基于直接命中率，反映在对抗环境中根据实时战场态势智能调整反制策略的能力
-			EvaluateThreshold(Summary.DirectHitRate, 79.f, true, TEXT("%"), TEXT("基于直接命中率，反映在对抗环境中根据实时战场态势智能调整反制策略的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.2.6"))
-		{
-			// 智能性-集群协作智能：基于自动发射命中率与任务完成率的综合评估
-			// 使用自动发射命中率（65%）和任务完成率（35%）的加权平均
-			const float TaskCompletionRate = Summary.HitRate;
-			const float SwarmCollaborationIntelligence = (AutoHitRate * 0.65f) + (TaskCompletionRate * 0.35f);
-			EvaluateThreshold(SwarmCollaborationIntelligence, 81.f, true, TEXT("%"), TEXT("基于自动发射命中率与任务完成率的综合评估，反映智能协调多个智能体协同完成任务的能力。"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.1"))
-		{
-			// 效能性-任务分配效能：基于自动发射比例，反映在不同智能体之间分配任务的效率和合理性
-			EvaluateThreshold(AutoFireRatio, 68.f, true, TEXT("%"), TEXT("基于自动发射比例，反映在不同智能体之间分配任务的效率和合理性。"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.2"))
-		{
-			// 效能性-作战资源管理效能：基于每次命中平均摧毁数，反映在复杂战场中有效管理和调度资源的表现
-			EvaluateThreshold(Summary.AverageDestroyedPerHit, 1.7f, true, TEXT(""), TEXT("基于每次命中平均摧毁数，反映在复杂战场中有效管理和调度资源的表现。"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.3"))
-		{
-			// 效能性-任务完成时间：基于导弹平均飞行时间，反映系统完成任务所需的平均时间
-			const float Value = Summary.AverageFlightTime;
-			EvaluateThreshold(Value, 1.1f, false, TEXT(" s"), TEXT("基于导弹平均飞行时间，反映系统完成任务所需的平均时间。"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.4"))
-		{
-			EvaluateThreshold(Summary.CountermeasureResourceCostScore, 77.f, true, TEXT("%"), TEXT("系统资源消耗控制水平≥77%。"));
-		}
-		else if (IndicatorId == TEXT("3.5.3.5"))
+
+			FMissileTestSummary Summary = BaseSummary;
+			SummarizeMissileRecords(*Inputs, Sample, Summary);
+			Summary.AverageAutoLaunchInterval = IntervalCount > 0 ? static_cast<float>(IntervalAccumulator / IntervalCount) : 0.f;
+			ApplyEnvironmentToSummary(*Inputs, Summary);
+			EvaluateIndicators(*Inputs, Summary, Sample, OutResults);
+		});
+}
+
+const FEnvironmentSensitivityResult* UScenarioMenuSubsystem::RunEnvironmentSensitivitySweep()
+{
+	if (EnvironmentSweepResult.IsSet())
+	{
+		return EnvironmentSweepResult.GetPtrOrNull();
+	}
+	if (!bHasActiveScenarioConfig || MissileTestRecords.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	// 发射记录只统计一次，各环境组合复用这份未应用环境因子的汇总
+	const FIndicatorEvaluationInputs BaseInputs = MakeIndicatorEvaluationInputs();
+	TArray<const FMissileTestRecord*> RecordPtrs;
+	GatherRecordPointers(MissileTestRecords, RecordPtrs);
+	FMissileTestSummary RawSummary;
+	RawSummary.SessionDuration = LastMissileSummary.SessionDuration;
+	RawSummary.Performance = LastMissileSummary.Performance;
+	SummarizeMissileRecords(BaseInputs, RecordPtrs, RawSummary);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	FEnvironmentSensitivityResult& Result = EnvironmentSweepResult.Emplace();
+	EnvironmentSensitivity::Sweep(ActiveScenarioConfig, [&BaseInputs, &RecordPtrs, &RawSummary](const FScenarioTestConfig& Config, TArray<FIndicatorEvaluationResult>& OutResults)
+	{
+		FIndicatorEvaluationInputs Inputs = BaseInputs;
+		Inputs.Config = Config;
+		FMissileTestSummary Summary = RawSummary;
+		ApplyEnvironmentToSummary(Inputs, Summary);
+		EvaluateIndicators(Inputs, Summary, RecordPtrs, OutResults);
+	}, Result);
+
+	UE_LOG(LogTemp, Log, TEXT("EnvironmentSensitivity: %d combinations x %d indicators in %.1f ms"),
+		Result.CellCount, Result.Indicators.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return &Result;
+}
+
+void UScenarioMenuSubsystem::EvaluateIndicators(const FIndicatorEvaluationInputs& Inputs, const FMissileTestSummary& Summary, TConstArrayView<const FMissileTestRecord*> Records, TArray<FIndicatorEvaluationResult>& OutResults)
+{
+	OutResults.Reset();
+
+	if (!Inputs.bHasConfig || Inputs.Config.SelectedIndicatorIds.Num() == 0)
+	{
+		return;
+}
+
+	const bool bHasData = Records.Num() > 0;
+
+	// 变量只绑定一次，各指标公式按 Id 查表后直接执行字节码
+	FIndicatorFormulaContext FormulaContext;
+	if (bHasData)
+	{
+		FormulaContext.Bind(Summary, Inputs.Perception, Records);
+	}
+
+	for (int32 Index = 0; Index < Inputs.Config.SelectedIndicatorIds.Num(); ++Index)
+	{
+		const FString& IndicatorId = Inputs.Config.SelectedIndicatorIds[Index];
+		const FString DisplayName = Inputs.Config.SelectedIndicatorDetails.IsValidIndex(Index)
+			? Inputs.Config.SelectedIndicatorDetails[Index]
+			: IndicatorId;
+
+		FIndicatorEvaluationResult Result;
+		Result.IndicatorId = IndicatorId;
+		Result.DisplayName = DisplayName;
+		Result.StatusText = TEXT("已完成");
+		Result.StatusColor = FLinearColor(0.1f, 0.8f, 0.3f);
+		Result.RemarkText = TEXT("该指标测试已完成。");
+		Result.TargetText = TEXT("—");
+		Result.ValueText = TEXT("—");
+
+		const FIndicatorFormulaEntry* Formula = Inputs.Formulas.IsValid() ? Inputs.Formulas->Find(IndicatorId) : nullptr;
+		if (Formula)
 		{
-			// 安全性-策略反制效能：基于导弹平均飞行时间，反映反制策略的生成和执行效能
-			const float Value = Summary.AverageFlightTime;
-			EvaluateThreshold(Value, 0.9f, false, TEXT(" s"), TEXT("基于导弹平均飞行时间，反映反制策略的生成和执行效能。"));
+			Result.bRecordBased = Formula->bRecordBased;
 		}
-		else if (IndicatorId == TEXT("3.5.3.6"))
+
+		if (!bHasData)
 		{
-			// 效能性-集群任务执行效能：基于自动发射命中率与资源利用效率的综合评估
-			// 使用自动发射命中率（55%）和资源利用效率（45%）的加权平均
-			const float ResourceEfficiency = Summary.AverageDestroyedPerHit;
-			const float NormalizedResourceEfficiency = FMath::Clamp(ResourceEfficiency / 2.0f * 100.f, 0.f, 100.f); // 归一化到0-100%
-			const float SwarmExecutionEfficiency = (AutoHitRate * 0.55f) + (NormalizedResourceEfficiency * 0.45f);
-			EvaluateThreshold(SwarmExecutionEfficiency, 80.f, true, TEXT("%"), TEXT("基于自动发射命中率与资源利用效率的综合评估，反映通过群体算法高效完成任务的能力。"));
+			Result.RemarkText = TEXT("尚未执行导弹测试。按 P 结束一次测试后将生成数据。");
+			OutResults.Add(Result);
+			continue;
 		}
-		else
+
+		if (!Formula)
 		{
-			if (false)
-			{
-				// placeholder for future mappings
-			}
-			else
-			{
-				if (bHasData)
-				{
-					Result.RemarkText = TEXT("尚未为该指标实现数据采集与计算。");
-				}
-			}
+			Result.RemarkText = TEXT("尚未为该指标实现数据采集与计算。");
+			OutResults.Add(Result);
+			continue;
 		}
 
+		const float Value = static_cast<float>(Formula->Program.Execute(FormulaContext));
+		const float Target = Formula->TargetValue;
+		const bool bPass = Formula->bHigherIsBetter ? (Value >= Target) : (Value <= Target);
+		Result.ValueText = FString::Printf(TEXT("%.2f%s"), Value, *Formula->Unit);
+		Result.TargetText = FString::Printf(TEXT("%s %.2f%s"),
+			Formula->bHigherIsBetter ? TEXT("≥") : TEXT("≤"),
+			Target, *Formula->Unit);
+		Result.bHasData = true;
+		Result.bPass = bPass;
+		Result.Value = Value;
+		Result.TargetValue = Target;
+		Result.bHigherIsBetter = Formula->bHigherIsBetter;
+		Result.StatusText = bPass ? TEXT("达标") : TEXT("未达标");
+		Result.StatusColor = bPass ? FLinearColor(0.1f, 0.8f, 0.3f) : FLinearColor(0.85f, 0.2f, 0.2f);
+		Result.RemarkText = Formula->Remark;
+
 		OutResults.Add(Result);
 	}
 }
@@ -1011,90 +1234,110 @@ void UScenarioMenuSubsystem::ApplyEnvironmentSettings(UWorld* World, const FScen
 	{
 		return;
 	}
-	
+
 	const bool bDay = Config.TimeIndex == 0;
+	const bool bFoggy = Config.WeatherIndex == 3; // 雾天
 	const float TargetExposure = bDay ? 1.0f : 0.7f;
 
-	UKismetSystemLibrary::ExecuteConsoleCommand(World, TEXT("r.EyeAdaptationQuality 0"));
-
-	auto ConfigureExposure = [TargetExposure](FPostProcessSettings& Settings)
-	{
-		Settings.bOverride_AutoExposureMethod = true;
-		Settings.AutoExposureMethod = EAutoExposureMethod::AEM_Manual;
-		Settings.bOverride_AutoExposureBias = true;
-		Settings.AutoExposureBias = 0.f;
-		Settings.bOverride_AutoExposureMinBrightness = true;
-		Settings.AutoExposureMinBrightness = TargetExposure;
-		Settings.bOverride_AutoExposureMaxBrightness = true;
-        Settings.AutoExposureMaxBrightness = TargetExposure;
-		Settings.bOverride_AutoExposureApplyPhysicalCameraExposure = true;
-		Settings.AutoExposureApplyPhysicalCameraExposure = false;
-		Settings.bOverride_AutoExposureSpeedDown = true;
-		Settings.AutoExposureSpeedDown = 30.f;
-		Settings.bOverride_AutoExposureSpeedUp = true;
-		Settings.AutoExposureSpeedUp = 30.f;
-	};
-
-	// 时间段 -> 太阳角度和颜色
-	if (ADirectionalLight* Dir = Cast<ADirectionalLight>(UGameplayStatics::GetActorOfClass(World, ADirectionalLight::StaticClass())))
+	// 与当前已应用的环境状态比较，只应用发生变化的部分；切换世界（重新加载关卡）时全部重新应用
+	const bool bSameWorld = AppliedEnvironment.World.Get() == World;
+	const bool bApplyTime = !bSameWorld || AppliedEnvironment.bDay != bDay;
+	const bool bApplyWeather = !bSameWorld || AppliedEnvironment.bFoggy != bFoggy;
+	if (!bApplyTime && !bApplyWeather)
 	{
-		if (UDirectionalLightComponent* LightComp = Cast<UDirectionalLightComponent>(Dir->GetLightComponent()))
-		{
-			const float TargetPitch = bDay ? -35.f : -12.f;
-			FRotator NewRotation = Dir->GetActorRotation();
-			NewRotation.Pitch = TargetPitch;
-			Dir->SetActorRotation(NewRotation);
-
-			LightComp->SetIntensity(bDay ? 50.f : 1.2f);
-			LightComp->SetLightColor(bDay ? FLinearColor(1.f, 0.95f, 0.85f) : FLinearColor(0.2f, 0.25f, 0.35f));
-			LightComp->MarkRenderStateDirty();
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Directional light found but has no directional light component."));
-		}
+		UE_LOG(LogTemp, Log, TEXT("Environment settings unchanged, skipped. Weather=%d Time=%d MapIndex=%d"), Config.WeatherIndex, Config.TimeIndex, Config.MapIndex);
+		return;
 	}
 
-	if (ASkyLight* Sky = Cast<ASkyLight>(UGameplayStatics::GetActorOfClass(World, ASkyLight::StaticClass())))
+	if (IConsoleVariable* EyeAdaptationQuality = IConsoleManager::Get().FindConsoleVariable(TEXT("r.EyeAdaptationQuality")))
 	{
-		if (USkyLightComponent* SkyComp = Sky->GetLightComponent())
+		if (EyeAdaptationQuality->GetInt() != 0)
 		{
-			SkyComp->SetIntensity(bDay ? 1.2f : 0.3f);
-			SkyComp->SetVolumetricScatteringIntensity(bDay ? 1.0f : 0.35f);
-			SkyComp->bLowerHemisphereIsBlack = !bDay;
-			SkyComp->SetLowerHemisphereColor(bDay ? FLinearColor::Black : FLinearColor(0.01f, 0.01f, 0.015f));
-			SkyComp->MarkRenderStateDirty();
-			SkyComp->RecaptureSky();
+			EyeAdaptationQuality->Set(0, ECVF_SetByCode);
 		}
 	}
 
-
-	// 雾密度
-	for (TActorIterator<AExponentialHeightFog> It(World); It; ++It)
+	if (bApplyTime)
 	{
-		if (UExponentialHeightFogComponent* FogComp = It->GetComponent())
+		auto ConfigureExposure = [TargetExposure](FPostProcessSettings& Settings)
+		{
+			Settings.bOverride_AutoExposureMethod = true;
+			Settings.AutoExposureMethod = EAutoExposureMethod::AEM_Manual;
+			Settings.bOverride_AutoExposureBias = true;
+			Settings.AutoExposureBias = 0.f;
+			Settings.bOverride_AutoExposureMinBrightness = true;
+			Settings.AutoExposureMinBrightness = TargetExposure;
+			Settings.bOverride_AutoExposureMaxBrightness = true;
+			Settings.AutoExposureMaxBrightness = TargetExposure;
+			Settings.bOverride_AutoExposureApplyPhysicalCameraExposure = true;
+			Settings.AutoExposureApplyPhysicalCameraExposure = false;
+			Settings.bOverride_AutoExposureSpeedDown = true;
+			Settings.AutoExposureSpeedDown = 30.f;
+			Settings.bOverride_AutoExposureSpeedUp = true;
+			Settings.AutoExposureSpeedUp = 30.f;
+		};
+
+		// 时间段 -> 太阳角度和颜色
+		if (ADirectionalLight* Dir = ActorRegistry.GetFirst<ADirectionalLight>(World, EScenarioActorRole::DirectionalLight))
 		{
-			if (Config.WeatherIndex == 3) // 雾天
+			if (UDirectionalLightComponent* LightComp = Cast<UDirectionalLightComponent>(Dir->GetLightComponent()))
 			{
-				FogComp->SetFogDensity(0.9f);
+				const float TargetPitch = bDay ? -35.f : -12.f;
+				FRotator NewRotation = Dir->GetActorRotation();
+				NewRotation.Pitch = TargetPitch;
+				Dir->SetActorRotation(NewRotation);
+
+				LightComp->SetIntensity(bDay ? 50.f : 1.2f);
+				LightComp->SetLightColor(bDay ? FLinearColor(1.f, 0.95f, 0.85f) : FLinearColor(0.2f, 0.25f, 0.35f));
+				LightComp->MarkRenderStateDirty();
 			}
 			else
 			{
-				FogComp->SetFogDensity(0.002f);
+				UE_LOG(LogTemp, Warning, TEXT("Directional light found but has no directional light component."));
+			}
+		}
+
+		if (ASkyLight* Sky = ActorRegistry.GetFirst<ASkyLight>(World, EScenarioActorRole::SkyLight))
+		{
+			if (USkyLightComponent* SkyComp = Sky->GetLightComponent())
+			{
+				SkyComp->SetIntensity(bDay ? 1.2f : 0.3f);
+				SkyComp->SetVolumetricScatteringIntensity(bDay ? 1.0f : 0.35f);
+				SkyComp->bLowerHemisphereIsBlack = !bDay;
+				SkyComp->SetLowerHemisphereColor(bDay ? FLinearColor::Black : FLinearColor(0.01f, 0.01f, 0.015f));
+				SkyComp->MarkRenderStateDirty();
+				ScheduleSkyRecapture(World, SkyComp);
+			}
+		}
+
+		TArray<AActor*> VolumeActors;
+		ActorRegistry.GetActors(World, EScenarioActorRole::PostProcessVolume, VolumeActors);
+		for (AActor* VolumeActor : VolumeActors)
+		{
+			APostProcessVolume* Volume = Cast<APostProcessVolume>(VolumeActor);
+			if (!Volume)
+			{
+				continue;
 			}
+
+			FPostProcessSettings& Settings = Volume->Settings;
+			ConfigureExposure(Settings);
 		}
 	}
 
-	for (TActorIterator<APostProcessVolume> It(World); It; ++It)
+	// 雾密度
+	if (bApplyWeather)
 	{
-		APostProcessVolume* Volume = *It;
-		if (!Volume)
+		TArray<AActor*> FogActors;
+		ActorRegistry.GetActors(World, EScenarioActorRole::HeightFog, FogActors);
+		for (AActor* FogActor : FogActors)
 		{
-			continue;
+			AExponentialHeightFog* Fog = Cast<AExponentialHeightFog>(FogActor);
+			if (UExponentialHeightFogComponent* FogComp = Fog ? Fog->GetComponent() : nullptr)
+			{
+				FogComp->SetFogDensity(bFoggy ? 0.9f : 0.002f);
+			}
 		}
-
-		FPostProcessSettings& Settings = Volume->Settings;
-		ConfigureExposure(Settings);
 	}
 
 	// 若需要，可在具体关卡的后处理体积上调整；当前版本未直接修改 WorldSettings。
@@ -1111,18 +1354,50 @@ void UScenarioMenuSubsystem::ApplyEnvironmentSettings(UWorld* World, const FScen
 		}
 	}*/
 
-	UE_LOG(LogTemp, Log, TEXT("Environment settings applied. Weather=%d Time=%d MapIndex=%d"), Config.WeatherIndex, Config.TimeIndex, Config.MapIndex);
+	AppliedEnvironment.World = World;
+	AppliedEnvironment.bDay = bDay;
+	AppliedEnvironment.bFoggy = bFoggy;
+
+	UE_LOG(LogTemp, Log, TEXT("Environment settings applied. Weather=%d Time=%d MapIndex=%d (time=%s, weather=%s)"), Config.WeatherIndex, Config.TimeIndex, Config.MapIndex,
+		bApplyTime ? TEXT("applied") : TEXT("unchanged"), bApplyWeather ? TEXT("applied") : TEXT("unchanged"));
 }
 
-void UScenarioMenuSubsystem::FinalizeScenarioAfterLoad()
+void UScenarioMenuSubsystem::ScheduleSkyRecapture(UWorld* World, USkyLightComponent* SkyComp)
 {
-	UWorld* World = PendingScenarioWorld.Get();
-	if (!World)
+	// 实时捕获的天光每帧自行更新，不需要手动重新捕获
+	if (!World || !SkyComp || SkyComp->bRealTimeCapture)
 	{
 		return;
 	}
 
-	if (!bHasPendingScenarioConfig)
+	const float Delay = CVarSkyRecaptureDelay.GetValueOnGameThread();
+	if (Delay <= 0.f)
+	{
+		SkyComp->RecaptureSky();
+		return;
+	}
+
+	// 延迟并合并：连续多次切换时间段只在最后一次之后重新捕获一次，避免与部署、开火挤在同一帧造成卡顿
+	TWeakObjectPtr<USkyLightComponent> WeakSky(SkyComp);
+	World->GetTimerManager().SetTimer(SkyRecaptureTimerHandle, FTimerDelegate::CreateLambda([WeakSky]()
+	{
+		if (USkyLightComponent* Sky = WeakSky.Get())
+		{
+			Sky->RecaptureSky();
+			UE_LOG(LogTemp, Log, TEXT("Environment: deferred sky recapture done."));
+		}
+	}), Delay, false);
+}
+
+void UScenarioMenuSubsystem::FinalizeScenarioAfterLoad()
+{
+	UWorld* World = PendingScenarioWorld.Get();
+	if (!World)
+	{
+		return;
+	}
+
+	if (!bHasPendingScenarioConfig)
 	{
 		World->GetTimerManager().ClearTimer(PendingScenarioTimerHandle);
 		PendingScenarioWorld = nullptr;
@@ -1150,7 +1425,65 @@ void UScenarioMenuSubsystem::FinalizeScenarioAfterLoad()
 		ApplyEnvironmentSettings(World, PendingScenarioConfig);
 		DeployBlueForScenario(World, PendingScenarioConfig);
 		bHasPendingScenarioConfig = false;
+		BeginPerformanceCapture(World);
+	}
+}
+
+bool UScenarioMenuSubsystem::CanResetScenarioInPlace(UWorld* World, const FScenarioTestConfig& Config) const
+{
+	if (!World || !World->IsGameWorld() || !World->HasBegunPlay() || Config.MapLevelName.IsNone())
+	{
+		return false;
+	}
+
+	if (CVarReuseLoadedLevel.GetValueOnGameThread() == 0)
+	{
+		return false;
+	}
+
+	// 仍有上一次 OpenLevel 的待处理部署时不能复用
+	if (PendingScenarioWorld.IsValid())
+	{
+		return false;
 	}
+
+	// MapLevelName 可能是完整包路径或短名；PIE 下包名带有 UEDPIE_ 前缀
+	const FString CurrentPackage = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	const FString TargetMap = Config.MapLevelName.ToString();
+	const bool bSameMap = TargetMap.StartsWith(TEXT("/"))
+		? CurrentPackage.Equals(TargetMap, ESearchCase::IgnoreCase)
+		: FPackageName::GetShortName(CurrentPackage).Equals(TargetMap, ESearchCase::IgnoreCase);
+
+	return bSameMap && AreScenarioLevelsReady(World);
+}
+
+void UScenarioMenuSubsystem::ResetScenarioInPlace(UWorld* World, const FScenarioTestConfig& Config, bool bApplyEnvironment)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// 蓝方单位、干扰区域、导弹与拦截弹、自动发射计时器、导弹跟随相机
+	ClearSpawnedBlueUnits();
+	RemoveMissileOverlay();
+	FocusInitialView();
+
+	// 导弹轨迹为持久化调试线
+	FlushPersistentDebugLines(World);
+
+	if (bApplyEnvironment)
+	{
+		ApplyEnvironmentSettings(World, Config);
+	}
+	DeployBlueForScenario(World, Config);
+	bHasPendingScenarioConfig = false;
+	BeginPerformanceCapture(World);
+
+	UE_LOG(LogTemp, Log, TEXT("ResetScenarioInPlace: done in %.1f ms (blue units=%d)"),
+		(FPlatformTime::Seconds() - StartSeconds) * 1000.0, GetActiveBlueUnitCount());
 }
 
 bool UScenarioMenuSubsystem::AreScenarioLevelsReady(UWorld* World) const
@@ -1248,7 +1581,7 @@ void UScenarioMenuSubsystem::DeployBlueForScenario(UWorld* World, const FScenari
 	}
 
 	// 暂存玩家初始视角
-	APlayerStart* PlayerStart = Cast<APlayerStart>(UGameplayStatics::GetActorOfClass(World, APlayerStart::StaticClass()));
+	APlayerStart* PlayerStart = ActorRegistry.GetFirst<APlayerStart>(World, EScenarioActorRole::PlayerStart);
 	FVector Origin = FVector::ZeroVector;
 	FRotator Facing = FRotator::ZeroRotator;
 	if (PlayerStart)
@@ -1289,13 +1622,13 @@ void UScenarioMenuSubsystem::DeployBlueForScenario(UWorld* World, const FScenari
 	TArray<AActor*> SpawnMarkers;
 	const FName PrimaryTag = FName(TEXT("BluePotentialDeployLocation"));
 	const FName LegacyTag = FName(TEXT("PotentialBlueDeployLocation"));
-	UGameplayStatics::GetAllActorsWithTag(World, PrimaryTag, SpawnMarkers);
+	ActorRegistry.AppendActorsWithTag(World, PrimaryTag, SpawnMarkers);
 	UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: actors with tag %s = %d"), *PrimaryTag.ToString(), SpawnMarkers.Num());
 
 	if (LegacyTag != PrimaryTag)
 	{
 		TArray<AActor*> LegacyActors;
-		UGameplayStatics::GetAllActorsWithTag(World, LegacyTag, LegacyActors);
+		ActorRegistry.AppendActorsWithTag(World, LegacyTag, LegacyActors);
 		if (LegacyActors.Num() > 0)
 		{
 			UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: actors with legacy tag %s = %d"), *LegacyTag.ToString(), LegacyActors.Num());
@@ -1308,39 +1641,24 @@ void UScenarioMenuSubsystem::DeployBlueForScenario(UWorld* World, const FScenari
 
 	if (SpawnMarkers.Num() == 0)
 	{
-		// 严格匹配：只查找名称完全为 BP_BluePotentialDeployLocation 的 Actor
-		TArray<AActor*> AllActors;
-		UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-		const FString TargetName = TEXT("BP_BluePotentialDeployLocation");
-		for (AActor* Actor : AllActors)
+		// 名称匹配：以 BP_ 开头且包含 BluePotentialDeployLocation 的 Actor（由索引在加入世界时归类）
+		ActorRegistry.GetActors(World, EScenarioActorRole::DeployMarker, SpawnMarkers);
+		for (AActor* Actor : SpawnMarkers)
 		{
-			if (!Actor)
-			{
-				continue;
-			}
-
-			const FString ActorName = Actor->GetName();
-			// 严格匹配：名称完全等于 BP_BluePotentialDeployLocation，或者包含但以 BP_ 开头
-			if (ActorName == TargetName || (ActorName.StartsWith(TEXT("BP_")) && ActorName.Contains(TEXT("BluePotentialDeployLocation"))))
-			{
-				SpawnMarkers.Add(Actor);
-				UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: found deploy location actor %s (Class=%s)"), *ActorName, *Actor->GetClass()->GetName());
-			}
+			UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: found deploy location actor %s (Class=%s)"), *Actor->GetName(), *Actor->GetClass()->GetName());
 		}
 
 		UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: name search matched %d actors"), SpawnMarkers.Num());
 
 		if (SpawnMarkers.Num() == 0)
 		{
-			const int32 SampleCount = FMath::Min(20, AllActors.Num());
+			// 仅在失败时遍历前若干个 Actor 输出诊断信息
+			int32 Index = 0;
 			UE_LOG(LogTemp, Warning, TEXT("DeployBlueForScenario: 未找到 BP_BluePotentialDeployLocation. Sample of world actors:"));
-			for (int32 Index = 0; Index < SampleCount; ++Index)
+			for (TActorIterator<AActor> It(World); It && Index < 20; ++It, ++Index)
 			{
-				AActor* Sample = AllActors[Index];
-				if (Sample)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("  [%d] %s (Class=%s, Tags=%d)"), Index, *Sample->GetName(), *Sample->GetClass()->GetName(), Sample->Tags.Num());
-				}
+				AActor* Sample = *It;
+				UE_LOG(LogTemp, Warning, TEXT("  [%d] %s (Class=%s, Tags=%d)"), Index, *Sample->GetName(), *Sample->GetClass()->GetName(), Sample->Tags.Num());
 			}
 		}
 	}
@@ -1410,6 +1728,17 @@ void UScenarioMenuSubsystem::DeployBlueForScenario(UWorld* World, const FScenari
 		MarkersToUse = FMath::Clamp(DesiredMarkerCount, 1, SpawnMarkers.Num());
 	}
 
+	// 先计算全部槽位，再一次性投影到地面后生成
+	struct FPendingBlueUnit
+	{
+		int32 MarkerIndex = INDEX_NONE;
+		FString MarkerName;
+		UStaticMesh* Mesh = nullptr;
+		UMaterialInterface* Material = nullptr;
+	};
+	TArray<FPendingBlueUnit> PendingUnits;
+	TArray<FVector> PendingLocations;
+
 	for (int32 MarkerIndex = 0; MarkerIndex < MarkersToUse; ++MarkerIndex)
 	{
 		AActor* Marker = SpawnMarkers[MarkerIndex];
@@ -1472,23 +1801,38 @@ void UScenarioMenuSubsystem::DeployBlueForScenario(UWorld* World, const FScenari
 				MatForType = DefaultUnitMaterial;
 			}
 
-			if (!SpawnBlueUnitAtLocation(World, DesiredLocation, BlueUnitFacing, MarkerName, MeshForType, MatForType, Config.CountermeasureIndices))
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to place unit at marker %s"), *MarkerName);
-			}
-			else
-			{
-				++LocalCount;
-			}
+			FPendingBlueUnit& Pending = PendingUnits.AddDefaulted_GetRef();
+			Pending.MarkerIndex = MarkerIndex;
+			Pending.MarkerName = MarkerName;
+			Pending.Mesh = MeshForType;
+			Pending.Material = MatForType;
+			PendingLocations.Add(DesiredLocation);
+			++LocalCount;
 		}
+	}
 
-		if (BlueMarkerSpawnCounts.IsValidIndex(MarkerIndex))
+	TArray<AActor*> PlacementIgnoredActors;
+	GetActiveBlueUnits(PlacementIgnoredActors);
+	if (AActor* InstanceContainer = BlueForceInstances.GetContainer())
+	{
+		PlacementIgnoredActors.Add(InstanceContainer);
+	}
+	BlueUnitPlacement.ProjectToGround(World, PendingLocations, 30.f, PlacementIgnoredActors);
+
+	for (int32 PendingIndex = 0; PendingIndex < PendingUnits.Num(); ++PendingIndex)
+	{
+		const FPendingBlueUnit& Pending = PendingUnits[PendingIndex];
+		if (!SpawnBlueUnitAtLocation(World, PendingLocations[PendingIndex], BlueUnitFacing, Pending.MarkerName, Pending.Mesh, Pending.Material, Config.CountermeasureIndices, /*bGroundProjected*/ true))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to place unit at marker %s"), *Pending.MarkerName);
+		}
+		else if (BlueMarkerSpawnCounts.IsValidIndex(Pending.MarkerIndex))
 		{
-			BlueMarkerSpawnCounts[MarkerIndex] = ExistingCount + LocalCount;
+			++BlueMarkerSpawnCounts[Pending.MarkerIndex];
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: Spawned %d blue units (DensityIndex=%d)."), ActiveBlueUnits.Num(), Config.DensityIndex);
+	UE_LOG(LogTemp, Log, TEXT("DeployBlueForScenario: Spawned %d blue units (DensityIndex=%d, instanced=%d)."), GetActiveBlueUnitCount(), Config.DensityIndex, BlueForceInstances.GetAliveCount() > 0 ? 1 : 0);
 	
 	// 如果选择了电磁干扰（CountermeasureIndices包含0），在蓝方目标附近生成雷达干扰区域
 	if (Config.CountermeasureIndices.Contains(0))
@@ -1514,7 +1858,10 @@ void UScenarioMenuSubsystem::ClearSpawnedBlueUnits()
 		}
 	}
 	ActiveBlueUnits.Reset();
+	BlueUnitIds.Reset();
+	BlueForceInstances.Reset();
 	NextTargetCursor = 0;
+	PerformanceRecorder.ResetBlueUnitCounters();
 	
 	// 清除雷达干扰区域
 	ClearRadarJammers();
@@ -1578,27 +1925,21 @@ UMaterialInterface* UScenarioMenuSubsystem::ResolveBlueUnitMaterial() const
 
 UStaticMesh* UScenarioMenuSubsystem::ResolveBlueUnitMeshByType(int32 TypeIndex) const
 {
-	static const TCHAR* MeshPaths[] =
-	{
-		TEXT("/Game/Military_Free/Meshes/SM_radiostation_001.SM_radiostation_001"),
-		TEXT("/Game/T-34-85/Models/SM_T-34-85.SM_T-34-85"),
-		TEXT("/Game/Military_Free/Meshes/SM_tank_tower_001.SM_tank_tower_001"),
-	};
-
-	constexpr int32 MaxTypes = UE_ARRAY_COUNT(MeshPaths);
+	constexpr int32 MaxTypes = ScenarioAssets::BlueUnitTypeCount;
 	const int32 SafeIndex = FMath::Clamp(TypeIndex, 0, MaxTypes - 1);
 
 	static TWeakObjectPtr<UStaticMesh> MeshCache[MaxTypes];
 	if (!MeshCache[SafeIndex].IsValid())
 	{
-		FSoftObjectPath MeshPath(MeshPaths[SafeIndex]);
-		if (UStaticMesh* LoadedMesh = Cast<UStaticMesh>(MeshPath.TryLoad()))
+		// Step3 确认后已异步预加载，这里通常直接命中内存
+		const FSoftObjectPath MeshPath = ScenarioAssets::GetBlueUnitMeshPath(SafeIndex);
+		if (UStaticMesh* LoadedMesh = ScenarioAssets::ResolveOrLoad<UStaticMesh>(MeshPath))
 		{
 			MeshCache[SafeIndex] = LoadedMesh;
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("ResolveBlueUnitMeshByType: failed to load mesh at '%s' (Type=%d)."), MeshPaths[SafeIndex], SafeIndex);
+			UE_LOG(LogTemp, Warning, TEXT("ResolveBlueUnitMeshByType: failed to load mesh at '%s' (Type=%d)."), *MeshPath.ToString(), SafeIndex);
 			return nullptr;
 		}
 	}
@@ -1608,30 +1949,22 @@ UStaticMesh* UScenarioMenuSubsystem::ResolveBlueUnitMeshByType(int32 TypeIndex)
 
 UMaterialInterface* UScenarioMenuSubsystem::ResolveBlueUnitMaterialByType(int32 TypeIndex) const
 {
-	static const TCHAR* MaterialPaths[] =
-	{
-		TEXT("/Game/StarterContent/Materials/M_Metal_Copper.M_Metal_Copper"),
-		TEXT("/Game/StarterContent/Materials/M_Metal_Gold.M_Metal_Gold"),
-		TEXT("/Game/StarterContent/Materials/M_Metal_Burnished_Steel.M_Metal_Burnished_Steel"),
-	};
-
-	constexpr int32 MaxTypes = UE_ARRAY_COUNT(MaterialPaths);
+	constexpr int32 MaxTypes = ScenarioAssets::BlueUnitTypeCount;
 	const int32 SafeIndex = FMath::Clamp(TypeIndex, 0, MaxTypes - 1);
 
 	static TWeakObjectPtr<UMaterialInterface> MaterialCache[MaxTypes];
 	if (!MaterialCache[SafeIndex].IsValid())
 	{
-		FSoftObjectPath MaterialPath(MaterialPaths[SafeIndex]);
-		if (UMaterialInterface* LoadedMaterial = Cast<UMaterialInterface>(MaterialPath.TryLoad()))
+		const FSoftObjectPath MaterialPath = ScenarioAssets::GetBlueUnitMaterialPath(SafeIndex);
+		if (UMaterialInterface* LoadedMaterial = ScenarioAssets::ResolveOrLoad<UMaterialInterface>(MaterialPath))
 		{
 			MaterialCache[SafeIndex] = LoadedMaterial;
 		}
 		else
 		{
-			UE_LOG(LogTemp, Warning, TEXT("ResolveBlueUnitMaterialByType: failed to load material at '%s' (Type=%d)."), MaterialPaths[SafeIndex], SafeIndex);
+			UE_LOG(LogTemp, Warning, TEXT("ResolveBlueUnitMaterialByType: failed to load material at '%s' (Type=%d)."), *MaterialPath.ToString(), SafeIndex);
 			// Fallback to default engine material
-			FSoftObjectPath DefaultPath(TEXT("/Engine/EngineMaterials/DefaultMaterial.DefaultMaterial"));
-			if (UMaterialInterface* DefaultMat = Cast<UMaterialInterface>(DefaultPath.TryLoad()))
+			if (UMaterialInterface* DefaultMat = ScenarioAssets::ResolveOrLoad<UMaterialInterface>(ScenarioAssets::GetDefaultMaterialPath()))
 			{
 				MaterialCache[SafeIndex] = DefaultMat;
 			}
@@ -1999,37 +2332,71 @@ void UScenarioMenuSubsystem::RestorePreviousPawn()
 	bHasOverviewHome = false;
 }
 
-bool UScenarioMenuSubsystem::SpawnBlueUnitAtLocation(UWorld* World, const FVector& DesiredLocation, const FRotator& Facing, const FString& MarkerName, UStaticMesh* UnitMesh, UMaterialInterface* UnitMaterial, const TArray<int32>& CountermeasureIndices)
+bool UScenarioMenuSubsystem::SpawnBlueUnitAtLocation(UWorld* World, const FVector& DesiredLocation, const FRotator& Facing, const FString& MarkerName, UStaticMesh* UnitMesh, UMaterialInterface* UnitMaterial, const TArray<int32>& CountermeasureIndices, bool bGroundProjected, AActor** OutActor, FBlueUnitHandle* OutInstance)
 {
+	if (OutActor)
+	{
+		*OutActor = nullptr;
+	}
+	if (OutInstance)
+	{
+		*OutInstance = FBlueUnitHandle();
+	}
+
 	if (!World || !UnitMesh)
 	{
 		return false;
 	}
 
 	FVector SpawnLocation = DesiredLocation;
-
-	const FVector TraceStart = SpawnLocation + FVector(0.f, 0.f, 6000.f);
-	const FVector TraceEnd = SpawnLocation - FVector(0.f, 0.f, 12000.f);
-	FHitResult Hit;
-	FCollisionQueryParams Params(NAME_None, false);
-	Params.bTraceComplex = true;
-	const bool bHit = World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_Visibility, Params);
-	if (bHit && Hit.bBlockingHit)
-	{
-		SpawnLocation = Hit.ImpactPoint + FVector(0.f, 0.f, 30.f);
-	}
-	else if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(World))
+	if (!bGroundProjected)
 	{
-		FNavLocation ProjectedNav;
-		if (NavSys->ProjectPointToNavigation(SpawnLocation, ProjectedNav, FVector(400.f, 400.f, 1200.f)))
+		// 单个单位（手动部署）也走投影服务，共享高度缓存
+		TArray<FVector> SingleLocation = { SpawnLocation };
+		TArray<AActor*> PlacementIgnoredActors;
+		GetActiveBlueUnits(PlacementIgnoredActors);
+		if (AActor* InstanceContainer = BlueForceInstances.GetContainer())
 		{
-			SpawnLocation = ProjectedNav.Location + FVector(0.f, 0.f, 30.f);
+			PlacementIgnoredActors.Add(InstanceContainer);
 		}
+		BlueUnitPlacement.ProjectToGround(World, SingleLocation, 30.f, PlacementIgnoredActors);
+		SpawnLocation = SingleLocation[0];
 	}
 
 	const FString MarkerLabel = MarkerName.IsEmpty() ? TEXT("ManualLocation") : MarkerName;
 	UE_LOG(LogTemp, Log, TEXT("Placing unit near %s -> %s"), *MarkerLabel, *SpawnLocation.ToString());
 
+	TArray<FName> UnitTags;
+	UnitTags.Add(FName(TEXT("BlueUnit")));
+	for (int32 Countermeasure : CountermeasureIndices)
+	{
+		switch (Countermeasure)
+		{
+		case 0: UnitTags.AddUnique(FName(TEXT("Blue_ECM"))); break;
+		case 1: UnitTags.AddUnique(FName(TEXT("Blue_CommJamming"))); break;
+		case 2: UnitTags.AddUnique(FName(TEXT("Blue_TargetMobility"))); break;
+		default: break;
+		}
+	}
+
+	// 实例化模式：只向对应单位类型的 HISM 组件添加一个实例
+	if (CVarBlueForceInstanced.GetValueOnGameThread() > 0)
+	{
+		const FBlueUnitHandle Handle = BlueForceInstances.AddUnit(World, UnitMesh, UnitMaterial, FTransform(Facing, SpawnLocation), MarkerLabel, UnitTags);
+		if (!Handle.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to add blue unit instance at %s"), *SpawnLocation.ToString());
+			return false;
+		}
+		PerformanceRecorder.NoteBlueUnitSpawned();
+		ReplayRecorder.AddBlueUnit(BlueForceInstances.Find(Handle)->Name, FTransform(Facing, SpawnLocation), UnitMesh, UnitMaterial);
+		if (OutInstance)
+		{
+			*OutInstance = Handle;
+		}
+		return true;
+	}
+
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
@@ -2054,20 +2421,20 @@ bool UScenarioMenuSubsystem::SpawnBlueUnitAtLocation(UWorld* World, const FVecto
 		}
 	}
 
-	Spawned->Tags.AddUnique(FName(TEXT("BlueUnit")));
-	for (int32 Countermeasure : CountermeasureIndices)
+	for (const FName& Tag : UnitTags)
 	{
-		switch (Countermeasure)
-		{
-		case 0: Spawned->Tags.AddUnique(FName(TEXT("Blue_ECM"))); break;
-		case 1: Spawned->Tags.AddUnique(FName(TEXT("Blue_CommJamming"))); break;
-		case 2: Spawned->Tags.AddUnique(FName(TEXT("Blue_TargetMobility"))); break;
-		default: break;
-		}
+		Spawned->Tags.AddUnique(Tag);
 	}
 
 	ActiveBlueUnits.Add(Spawned);
+	BlueUnitIds.Add(Spawned, BlueUnitIds.Num());
+	PerformanceRecorder.NoteBlueUnitSpawned();
+	ReplayRecorder.AddBlueUnit(Spawned->GetName(), Spawned->GetActorTransform(), UnitMesh, UnitMaterial);
 	UE_LOG(LogTemp, Log, TEXT("Blue unit spawned at %s"), *SpawnLocation.ToString());
+	if (OutActor)
+	{
+		*OutActor = Spawned;
+	}
 	return true;
 }
 
@@ -2084,12 +2451,13 @@ bool UScenarioMenuSubsystem::FireSingleMissile(bool bFromAutoFire /*= false*/)
 
 	// 尝试选择一个目标，但不强制要求（允许为nullptr，导弹会在视野内自动搜索）
 	AActor* Target = SelectNextBlueTarget();
-	if (!Target)
+	const FBlueUnitHandle TargetInstance = Target ? FBlueUnitHandle() : BlueForceInstances.SelectNext(NextTargetCursor);
+	if (!Target && !TargetInstance.IsValid())
 	{
 		UE_LOG(LogTemp, Log, TEXT("FireSingleMissile: no initial target, missile will search for targets in view."));
 	}
 
-	AMockMissileActor* Missile = SpawnMissile(World, Target, bFromAutoFire);
+	AMockMissileActor* Missile = SpawnMissile(World, Target, bFromAutoFire, nullptr, nullptr, TargetInstance);
 	if (!Missile)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FireSingleMissile: failed to spawn missile."));
@@ -2111,7 +2479,7 @@ void UScenarioMenuSubsystem::FireMultipleMissiles(int32 Count)
 	BeginMissileAutoFire(SafeCount);
 }
 
-AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* Target, bool bFromAutoFire, const FVector* OverrideLocation, const FRotator* OverrideRotation)
+AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* Target, bool bFromAutoFire, const FVector* OverrideLocation, const FRotator* OverrideRotation, const FBlueUnitHandle& TargetInstance)
 {
 	if (!World)
 	{
@@ -2135,9 +2503,18 @@ AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* T
 	{
 		LaunchRotation = *OverrideRotation;
 	}
-	else if (OverrideLocation && Target)
+	else if (OverrideLocation && (Target || BlueForceInstances.IsAlive(TargetInstance)))
 	{
-		const FVector Dir = (Target->GetActorLocation() - SpawnLocation).GetSafeNormal();
+		FVector TargetLocation;
+		if (Target)
+		{
+			TargetLocation = Target->GetActorLocation();
+		}
+		else
+		{
+			BlueForceInstances.GetLocation(TargetInstance, TargetLocation);
+		}
+		const FVector Dir = (TargetLocation - SpawnLocation).GetSafeNormal();
 		if (!Dir.IsNearlyZero())
 		{
 			LaunchRotation = Dir.Rotation();
@@ -2157,6 +2534,7 @@ AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* T
 	{
 		return nullptr;
 	}
+	Missile->SetSessionSerial(NextMissileSerial++);
 
 	if (MissileMesh || MissileMaterial)
 	{
@@ -2164,6 +2542,10 @@ AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* T
 	}
 
 	Missile->InitializeMissile(Target, 4500.f, 45.f);
+	if (!Target && TargetInstance.IsValid())
+	{
+		Missile->SetTargetInstance(TargetInstance);
+	}
 	
 	// 设置算法配置，决定是否启用反制等功能
 	if (bHasActiveScenarioConfig)
@@ -2173,6 +2555,7 @@ AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* T
 		const bool bElectromagnetic = ActiveScenarioConfig.CountermeasureIndices.Contains(0);
 		Missile->SetInterferenceMode(bElectromagnetic);
 	}
+	ApplyBranchVariant(Missile);
 
 	if (bEvasionSubsystemSelected)
 	{
@@ -2183,10 +2566,13 @@ AMockMissileActor* UScenarioMenuSubsystem::SpawnMissile(UWorld* World, AActor* T
 	Missile->OnExpired.AddUObject(this, &UScenarioMenuSubsystem::HandleMissileExpired);
 
 	ActiveMissiles.Add(Missile);
-	RecordMissileLaunch(Missile, Target, SpawnLocation, bFromAutoFire);
+	PerformanceRecorder.NoteMissileSpawned(ActiveMissiles.Num());
+	RecordMissileLaunch(Missile, Target, TargetInstance, SpawnLocation, bFromAutoFire);
 
+	const FBlueUnitInstance* InstanceInfo = Target ? nullptr : BlueForceInstances.Find(TargetInstance);
 	UE_LOG(LogTemp, Log, TEXT("SpawnMissile: launched missile %s from %s"), 
-		Target ? *FString::Printf(TEXT("toward %s"), *Target->GetName()) : TEXT("(no initial target, will search)"), 
+		Target ? *FString::Printf(TEXT("toward %s"), *Target->GetName())
+			: (InstanceInfo ? *FString::Printf(TEXT("toward %s"), *InstanceInfo->Name) : TEXT("(no initial target, will search)")), 
 		*SpawnLocation.ToString());
 	RebuildViewSequence();
 	return Missile;
@@ -2252,6 +2638,7 @@ void UScenarioMenuSubsystem::SpawnInterceptorForMissile(AMockMissileActor* Targe
 		UE_LOG(LogTemp, Warning, TEXT("SpawnInterceptorForMissile: failed to spawn interceptor"));
 		return;
 	}
+	Interceptor->SetSessionSerial(NextMissileSerial++);
 
 	Interceptor->SetupAppearance(ResolveMissileMesh(), ResolveMissileMaterial(), FLinearColor(0.1f, 0.4f, 1.f));
 
@@ -2264,6 +2651,8 @@ void UScenarioMenuSubsystem::SpawnInterceptorForMissile(AMockMissileActor* Targe
 	Interceptor->OnExpired.AddUObject(this, &UScenarioMenuSubsystem::HandleInterceptorExpired);
 
 	ActiveInterceptorMissiles.Add(Interceptor);
+	PerformanceRecorder.NoteInterceptorSpawned();
+	RecordScenarioEvent(EScenarioReplayEvent::InterceptorLaunch, static_cast<int32>(Interceptor->GetSessionSerial()), SpawnLocation);
 
 	UE_LOG(LogTemp, Log, TEXT("SpawnInterceptorForMissile: spawned interceptor %s targeting %s"), 
 		*Interceptor->GetName(), 
@@ -2310,6 +2699,12 @@ void UScenarioMenuSubsystem::GetActiveBlueUnits(TArray<AActor*>& OutUnits) const
 	}
 }
 
+int32 UScenarioMenuSubsystem::GetBlueUnitId(const AActor* Unit) const
+{
+	const int32* Found = Unit ? BlueUnitIds.Find(Unit) : nullptr;
+	return Found ? *Found : INDEX_NONE;
+}
+
 void UScenarioMenuSubsystem::GetActiveRadarJammers(TArray<ARadarJammerActor*>& OutJammers) const
 {
 	OutJammers.Reset();
@@ -2349,25 +2744,42 @@ void UScenarioMenuSubsystem::SpawnRadarJammers(UWorld* World)
 
 	ClearRadarJammers();
 
-	// 获取所有有效的蓝方单位
-	TArray<AActor*> ValidBlueUnits;
+	// 获取所有有效的蓝方单位（Actor 与实例化单位）的位置
+	TArray<FVector> ValidBlueUnitLocations;
+	TArray<FString> ValidBlueUnitNames;
 	for (const TWeakObjectPtr<AActor>& Ptr : ActiveBlueUnits)
 	{
 		if (AActor* Unit = Ptr.Get())
 		{
 			if (!Unit->IsPendingKillPending())
 			{
-				ValidBlueUnits.Add(Unit);
+				ValidBlueUnitLocations.Add(Unit->GetActorLocation());
+				ValidBlueUnitNames.Add(Unit->GetName());
 			}
 		}
 	}
+	TArray<FBlueUnitHandle> InstanceHandles;
+	BlueForceInstances.GetAliveUnits(InstanceHandles);
+	for (const FBlueUnitHandle& Handle : InstanceHandles)
+	{
+		const FBlueUnitInstance* Instance = BlueForceInstances.Find(Handle);
+		ValidBlueUnitLocations.Add(Instance->GetLocation());
+		ValidBlueUnitNames.Add(Instance->Name);
+	}
 
-	if (ValidBlueUnits.Num() == 0)
+	if (ValidBlueUnitLocations.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("SpawnRadarJammers: No valid blue units found."));
 		return;
 	}
 
+	const bool bBakeJammingField = FJammingField::IsEnabled();
+	TArray<AActor*> JammingIgnoredActors;
+	if (bBakeJammingField)
+	{
+		CollectJammingIgnoredActors(JammingIgnoredActors);
+	}
+
 	if (AActor* DefendZoneAnchor = GetBlueDefendZoneAnchor())
 	{
 		FActorSpawnParameters Params;
@@ -2387,6 +2799,10 @@ void UScenarioMenuSubsystem::SpawnRadarJammers(UWorld* World)
 			}
 			Jammer->SetJammerRadius(JammerRadius);
 			ActiveRadarJammers.Add(Jammer);
+			if (bBakeJammingField)
+			{
+				JammingField.AddJammer(World, Jammer, JammingIgnoredActors);
+			}
 			UE_LOG(LogTemp, Log, TEXT("SpawnRadarJammers: Spawned jammer at defend zone anchor %s (radius %.1f, desert=%s)"),
 				*DefendZoneAnchor->GetName(), JammerRadius, bIsDesertMap ? TEXT("yes") : TEXT("no"));
 		}
@@ -2398,7 +2814,7 @@ void UScenarioMenuSubsystem::SpawnRadarJammers(UWorld* World)
 	}
 
 	// 随机选择一个蓝方目标，在其附近生成雷达干扰区域（作为兜底方案）
-	const int32 NumJammers = FMath::Min(1, ValidBlueUnits.Num());
+	const int32 NumJammers = FMath::Min(1, ValidBlueUnitLocations.Num());
 	TArray<int32> SelectedIndices;
 	const FString CurrentMapName = World->GetMapName();
 	const bool bIsDesertMap = CurrentMapName.Contains(TEXT("Desert")) || CurrentMapName.Contains(TEXT("沙漠"));
@@ -2408,12 +2824,12 @@ void UScenarioMenuSubsystem::SpawnRadarJammers(UWorld* World)
 		int32 RandomIndex;
 		do
 		{
-			RandomIndex = FMath::RandRange(0, ValidBlueUnits.Num() - 1);
+			RandomIndex = FMath::RandRange(0, ValidBlueUnitLocations.Num() - 1);
 		} while (SelectedIndices.Contains(RandomIndex));
 		
 		SelectedIndices.Add(RandomIndex);
-		AActor* TargetUnit = ValidBlueUnits[RandomIndex];
-		FVector UnitLocation = TargetUnit->GetActorLocation();
+		const FString& TargetUnitName = ValidBlueUnitNames[RandomIndex];
+		FVector UnitLocation = ValidBlueUnitLocations[RandomIndex];
 
 		// 设置干扰半径（5000-8000厘米），沙漠地图变为2.5倍
 		float JammerRadius = FMath::RandRange(5000.f, 8000.f);
@@ -2450,19 +2866,52 @@ void UScenarioMenuSubsystem::SpawnRadarJammers(UWorld* World)
 		{
 			Jammer->SetJammerRadius(JammerRadius);
 			ActiveRadarJammers.Add(Jammer);
+			if (bBakeJammingField)
+			{
+				JammingField.AddJammer(World, Jammer, JammingIgnoredActors);
+			}
 			
 			// 验证目标是否在干扰区域内（应该在边缘）
 			float DistanceToTarget = FVector::Dist(JammerLocation, UnitLocation);
 			float DistanceRatio = DistanceToTarget / JammerRadius;
 			
 			UE_LOG(LogTemp, Log, TEXT("SpawnRadarJammers: Created jammer at %s with radius %.2f cm near target %s (target distance: %.2f cm, ratio: %.2f%%)"), 
-				*JammerLocation.ToString(), JammerRadius, *TargetUnit->GetName(), DistanceToTarget, DistanceRatio * 100.f);
+				*JammerLocation.ToString(), JammerRadius, *TargetUnitName, DistanceToTarget, DistanceRatio * 100.f);
 		}
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("SpawnRadarJammers: Spawned %d radar jammers"), ActiveRadarJammers.Num());
 }
 
+void UScenarioMenuSubsystem::CollectJammingIgnoredActors(TArray<AActor*>& OutActors) const
+{
+	// 干扰场烘焙时蓝方单位本身不算地形遮挡
+	for (const TWeakObjectPtr<AActor>& Ptr : ActiveBlueUnits)
+	{
+		if (AActor* Unit = Ptr.Get())
+		{
+			OutActors.Add(Unit);
+		}
+	}
+	if (AActor* Container = BlueForceInstances.GetContainer())
+	{
+		OutActors.Add(Container);
+	}
+}
+
+int32 UScenarioMenuSubsystem::VerifyJammingField() const
+{
+	if (JammingField.IsEmpty())
+	{
+		UE_LOG(LogTemp, Log, TEXT("VerifyJammingField: jamming field is empty (ir.Jamming.Field=0 or no jammers)"));
+		return 0;
+	}
+
+	TArray<AActor*> JammingIgnoredActors;
+	CollectJammingIgnoredActors(JammingIgnoredActors);
+	return JammingField.Verify(GetWorld(), JammingIgnoredActors);
+}
+
 void UScenarioMenuSubsystem::ClearRadarJammers()
 {
 	for (TWeakObjectPtr<ARadarJammerActor>& Ptr : ActiveRadarJammers)
@@ -2476,6 +2925,7 @@ void UScenarioMenuSubsystem::ClearRadarJammers()
 		}
 	}
 	ActiveRadarJammers.Reset();
+	JammingField.Reset();
 }
 
 void UScenarioMenuSubsystem::HandleMissileImpact(AMockMissileActor* Missile, AActor* HitActor)
@@ -2492,6 +2942,7 @@ void UScenarioMenuSubsystem::HandleMissileImpact(AMockMissileActor* Missile, AAc
 	if (HitActor && !HitActor->IsPendingKillPending() && ActiveBlueUnits.Contains(HitActor))
 	{
 		UE_LOG(LogTemp, Log, TEXT("HandleMissileImpact: missile direct-hit %s"), *HitActor->GetName());
+		RecordBlueUnitDestroyed(HitActor->GetName(), HitActor->GetActorLocation());
 		HitActor->Destroy();
 		++DestroyedCount;
 	}
@@ -2515,6 +2966,7 @@ void UScenarioMenuSubsystem::HandleMissileImpact(AMockMissileActor* Missile, AAc
 		if (DistanceSq <= FMath::Square(ExplosionRadius))
 		{
 			UE_LOG(LogTemp, Log, TEXT("HandleMissileImpact: AoE destroyed %s (distance %.1f)"), *Unit->GetName(), FMath::Sqrt(DistanceSq));
+			RecordBlueUnitDestroyed(Unit->GetName(), Unit->GetActorLocation());
 			Unit->Destroy();
 			++DestroyedCount;
 			UnitsToRemove.Add(Unit);
@@ -2536,7 +2988,40 @@ void UScenarioMenuSubsystem::HandleMissileImpact(AMockMissileActor* Missile, AAc
 		return UnitsToRemove.Contains(Ptr.Get());
 	});
 
+	// 实例化蓝方：按爆炸位置逐实例移除；导弹目标实例在毁伤范围内且离爆心最近时记为直接命中
+	if (BlueForceInstances.GetAliveCount() > 0)
+	{
+		TArray<FBlueUnitHandle> RemovedInstances;
+		BlueForceInstances.RemoveUnitsInRadius(ExplosionLocation, ExplosionRadius, RemovedInstances);
+		DestroyedCount += RemovedInstances.Num();
+		for (const FBlueUnitHandle& Removed : RemovedInstances)
+		{
+			const FBlueUnitInstance* Instance = BlueForceInstances.Find(Removed);
+			RecordBlueUnitDestroyed(Instance->Name, Instance->GetLocation());
+		}
+
+		const FBlueUnitHandle MissileTargetInstance = Missile ? Missile->GetTargetInstance() : FBlueUnitHandle();
+		if (RemovedInstances.Num() > 0 && MissileTargetInstance.IsValid() && RemovedInstances[0] == MissileTargetInstance)
+		{
+			HitActorName = BlueForceInstances.Find(MissileTargetInstance)->Name;
+		}
+		else if (BlueForceInstances.IsContainer(HitActor))
+		{
+			// 命中了实例容器但不是目标实例：不能按容器名称判定直接命中
+			HitActorName = RemovedInstances.Num() > 0 ? BlueForceInstances.Find(RemovedInstances[0])->Name : TEXT("BlueUnitInstances");
+		}
+
+		if (RemovedInstances.Num() > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("HandleMissileImpact: AoE removed %d blue unit instances (%d remaining)"),
+				RemovedInstances.Num(), BlueForceInstances.GetAliveCount());
+		}
+	}
+
 	UpdateMissileRecordOnImpact(Missile, HitActor, DestroyedCount, HitActorName);
+	PerformanceRecorder.NoteMissileDestroyed();
+	RecordScenarioEvent(EScenarioReplayEvent::MissileImpact, Missile ? static_cast<int32>(Missile->GetSessionSerial()) : INDEX_NONE, ExplosionLocation);
+	PerformanceRecorder.NoteBlueUnitsDestroyed(DestroyedCount);
 
 	if (DestroyedCount == 0)
 	{
@@ -2547,7 +3032,7 @@ void UScenarioMenuSubsystem::HandleMissileImpact(AMockMissileActor* Missile, AAc
 	{
 		NextTargetCursor = NextTargetCursor % ActiveBlueUnits.Num();
 	}
-	else
+	else if (BlueForceInstances.GetAliveCount() == 0)
 	{
 		NextTargetCursor = 0;
 	}
@@ -2581,6 +3066,11 @@ void UScenarioMenuSubsystem::HandleMissileExpired(AMockMissileActor* Missile)
 	const bool bWasCameraTarget = MissileCameraTarget.Get() == Missile;
 
 	UpdateMissileRecordOnExpired(Missile);
+	PerformanceRecorder.NoteMissileDestroyed();
+	if (Missile)
+	{
+		RecordScenarioEvent(EScenarioReplayEvent::MissileExpired, static_cast<int32>(Missile->GetSessionSerial()), Missile->GetActorLocation());
+	}
 
 	ActiveMissiles.RemoveAll([Missile](const TWeakObjectPtr<AMockMissileActor>& Ptr)
 	{
@@ -2591,7 +3081,7 @@ void UScenarioMenuSubsystem::HandleMissileExpired(AMockMissileActor* Missile)
 	{
 		NextTargetCursor = NextTargetCursor % ActiveBlueUnits.Num();
 	}
-	else
+	else if (BlueForceInstances.GetAliveCount() == 0)
 	{
 		NextTargetCursor = 0;
 	}
@@ -2616,6 +3106,7 @@ void UScenarioMenuSubsystem::HandleInterceptorImpact(AMockMissileActor* Intercep
 {
 	if (AMockMissileActor* FriendlyMissile = Cast<AMockMissileActor>(HitActor))
 	{
+		RecordScenarioEvent(EScenarioReplayEvent::Intercepted, static_cast<int32>(FriendlyMissile->GetSessionSerial()), FriendlyMissile->GetActorLocation());
 		FriendlyMissile->HandleInterceptedByEnemy(Interceptor);
 	}
 
@@ -2629,6 +3120,7 @@ void UScenarioMenuSubsystem::HandleInterceptorExpired(AMockMissileActor* Interce
 
 void UScenarioMenuSubsystem::RemoveInterceptor(AMockMissileActor* Interceptor)
 {
+	PerformanceRecorder.NoteInterceptorDestroyed();
 	ActiveInterceptorMissiles.RemoveAll([Interceptor](const TWeakObjectPtr<AMockMissileActor>& Ptr)
 	{
 		return !Ptr.IsValid() || Ptr.Get() == Interceptor;
@@ -2650,49 +3142,19 @@ void UScenarioMenuSubsystem::CleanupMissiles()
 
 AActor* UScenarioMenuSubsystem::GetBlueRocketSpawnAnchor() const
 {
-	if (!CachedBlueRocketSpawnActor.IsValid())
-	{
-		CachedBlueRocketSpawnActor = FindActorByNameSubstring(TEXT("BP_BlueRocketSpawn"));
-	}
-	return CachedBlueRocketSpawnActor.Get();
+	return ActorRegistry.GetFirst(GetWorld(), EScenarioActorRole::RocketSpawnAnchor);
 }
 
 AActor* UScenarioMenuSubsystem::GetBlueDefendZoneAnchor() const
 {
-	if (!CachedBlueDefendZoneActor.IsValid())
-	{
-		CachedBlueDefendZoneActor = FindActorByNameSubstring(TEXT("BP_BlueDefendZone"));
-	}
-	return CachedBlueDefendZoneActor.Get();
-}
-
-AActor* UScenarioMenuSubsystem::FindActorByNameSubstring(const FString& NameFragment) const
-{
-	if (NameFragment.IsEmpty())
-	{
-		return nullptr;
-	}
-
-	if (UWorld* World = GetWorld())
-	{
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			if (!It->IsPendingKillPending() && It->GetName().Contains(NameFragment))
-			{
-				return *It;
-			}
-		}
-	}
-
-	return nullptr;
+	return ActorRegistry.GetFirst(GetWorld(), EScenarioActorRole::DefendZoneAnchor);
 }
 
 UStaticMesh* UScenarioMenuSubsystem::ResolveMissileMesh() const
 {
 	if (!CachedMissileMesh.IsValid())
 	{
-		FSoftObjectPath MeshPath(TEXT("/Game/Sayantan/Props/Small/CruiseMissile_FREE/Models/SM_CruiseMissile.SM_CruiseMissile"));
-		if (UStaticMesh* Mesh = Cast<UStaticMesh>(MeshPath.TryLoad()))
+		if (UStaticMesh* Mesh = ScenarioAssets::ResolveOrLoad<UStaticMesh>(ScenarioAssets::GetMissileMeshPath()))
 		{
 			CachedMissileMesh = Mesh;
 		}
@@ -2710,8 +3172,7 @@ UMaterialInterface* UScenarioMenuSubsystem::ResolveMissileMaterial() const
 {
 	if (!CachedMissileMaterial.IsValid())
 	{
-		FSoftObjectPath MaterialPath(TEXT("/Game/StarterContent/Materials/M_Glow.M_Glow"));
-		if (UMaterialInterface* Material = Cast<UMaterialInterface>(MaterialPath.TryLoad()))
+		if (UMaterialInterface* Material = ScenarioAssets::ResolveOrLoad<UMaterialInterface>(ScenarioAssets::GetMissileMaterialPath()))
 		{
 			CachedMissileMaterial = Material;
 		}
@@ -2731,7 +3192,7 @@ FVector UScenarioMenuSubsystem::GetPlayerStartLocation(FRotator& OutRotation) co
 
 	if (UWorld* World = GetWorld())
 	{
-		if (APlayerStart* PlayerStart = Cast<APlayerStart>(UGameplayStatics::GetActorOfClass(World, APlayerStart::StaticClass())))
+		if (APlayerStart* PlayerStart = ActorRegistry.GetFirst<APlayerStart>(World, EScenarioActorRole::PlayerStart))
 		{
 			OutRotation = PlayerStart->GetActorRotation();
 			return PlayerStart->GetActorLocation();
@@ -2817,6 +3278,7 @@ void UScenarioMenuSubsystem::SetupInputBindings(UWorld* World)
 				MissileInputComponent->BindKey(EKeys::P, IE_Pressed, this, &UScenarioMenuSubsystem::OnInputFinishMissileTest);
 				MissileInputComponent->BindKey(EKeys::Q, IE_Pressed, this, &UScenarioMenuSubsystem::OnInputCycleBackward);
 				MissileInputComponent->BindKey(EKeys::E, IE_Pressed, this, &UScenarioMenuSubsystem::OnInputCycleForward);
+				MissileInputComponent->BindKey(EKeys::B, IE_Pressed, this, &UScenarioMenuSubsystem::OnInputStartBranchRun);
 			}
 		}
 
@@ -2856,7 +3318,35 @@ void UScenarioMenuSubsystem::OnInputFireMissile()
 
 void UScenarioMenuSubsystem::OnInputFinishMissileTest()
 {
+	// 随机采样测试进行中按 P：提前结束，保留已完成轮次的汇总
+	if (IsMonteCarloRunning())
+	{
+		MonteCarloCampaign->Stop(TEXT("用户手动结束"));
+		return;
+	}
+
 	CompleteMissileTest();
+	ReturnToResultsScreen();
+}
+
+void UScenarioMenuSubsystem::OnInputStartBranchRun()
+{
+	FString Error;
+	const bool bStarted = StartBranchRun(Error);
+	if (!bStarted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("StartBranchRun failed: %s"), *Error);
+	}
+	if (GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 4.f, bStarted ? FColor::Cyan : FColor::Yellow,
+			bStarted ? FString::Printf(TEXT("已采集检查点，%d 个分支推演在后台运行"), BranchExecutor->GetBranchCount())
+				: FString::Printf(TEXT("无法开始分支推演：%s"), *Error));
+	}
+}
+
+void UScenarioMenuSubsystem::ReturnToResultsScreen()
+{
 	FocusInitialView();
 	RemoveMissileOverlay();
 	bIsRunningScenario = false;
@@ -3316,6 +3806,7 @@ void UScenarioMenuSubsystem::UpdateMissileOverlay()
 		
 		// 首先检测中心点
 		FHitResult HitResult;
+		FScenarioPerformanceRecorder::NoteTraces();
 		if (!World->LineTraceSingleByChannel(HitResult, TraceStart, TargetCenter, ECC_Visibility, QueryParams) || HitResult.GetActor() == Target)
 		{
 			bIsVisible = true;
@@ -3333,6 +3824,7 @@ void UScenarioMenuSubsystem::UpdateMissileOverlay()
 			for (const FVector& KeyPoint : KeyPoints)
 			{
 				FHitResult KeyHitResult;
+				FScenarioPerformanceRecorder::NoteTraces();
 				if (!World->LineTraceSingleByChannel(KeyHitResult, TraceStart, KeyPoint, ECC_Visibility, QueryParams) || KeyHitResult.GetActor() == Target)
 				{
 					bIsVisible = true;
@@ -3353,6 +3845,7 @@ void UScenarioMenuSubsystem::UpdateMissileOverlay()
 		
 		// 检查标记位置是否可见
 		FHitResult MarkerHitResult;
+		FScenarioPerformanceRecorder::NoteTraces();
 		if (World->LineTraceSingleByChannel(MarkerHitResult, CameraLocation, MarkerLocation, ECC_Visibility, QueryParams))
 		{
 			if (MarkerHitResult.GetActor() != Target)
@@ -3395,7 +3888,7 @@ void UScenarioMenuSubsystem::UpdateMissileOverlay()
 	MissileOverlayWidget->SetTargets(OverlayTargets);
 }
 
-void UScenarioMenuSubsystem::RecordMissileLaunch(AMockMissileActor* Missile, AActor* Target, const FVector& LaunchLocation, bool bFromAutoFire)
+void UScenarioMenuSubsystem::RecordMissileLaunch(AMockMissileActor* Missile, AActor* Target, const FBlueUnitHandle& TargetInstance, const FVector& LaunchLocation, bool bFromAutoFire)
 {
 	if (!Missile)
 	{
@@ -3410,12 +3903,24 @@ void UScenarioMenuSubsystem::RecordMissileLaunch(AMockMissileActor* Missile, AAc
 	Record.LaunchLocation = LaunchLocation;
 	Record.TargetLocation = Target ? Target->GetActorLocation() : FVector::ZeroVector;
 	Record.InitialDistance = Target ? FVector::Dist(LaunchLocation, Record.TargetLocation) : 0.f;
+	if (!Target)
+	{
+		// 实例化蓝方：以实例名称/位置记录，直接命中按名称比较
+		if (const FBlueUnitInstance* Instance = BlueForceInstances.Find(TargetInstance))
+		{
+			Record.TargetInstanceId = TargetInstance.Id;
+			Record.TargetName = Instance->Name;
+			Record.TargetLocation = Instance->GetLocation();
+			Record.InitialDistance = FVector::Dist(LaunchLocation, Record.TargetLocation);
+		}
+	}
 	Record.bIsSplitChild = Missile->IsSplitChild();
 	Record.SplitGroupId = Missile->GetSplitGroupId();
 	Record.CountermeasureStats.bCountermeasureEnabled = Missile->IsCountermeasureEnabled();
 
 	const int32 Index = MissileTestRecords.Add(Record);
 	MissileRecordLookup.Add(Missile, Index);
+	RecordScenarioEvent(EScenarioReplayEvent::MissileLaunch, static_cast<int32>(Missile->GetSessionSerial()), LaunchLocation);
 }
 
 void UScenarioMenuSubsystem::UpdateMissileRecordOnImpact(AMockMissileActor* Missile, AActor* HitActor, int32 DestroyedCount, const FString& HitActorName)
@@ -3441,7 +3946,9 @@ void UScenarioMenuSubsystem::UpdateMissileRecordOnImpact(AMockMissileActor* Miss
 			const FString ActualHitActorName = !HitActorName.IsEmpty() ? HitActorName : (HitActor ? HitActor->GetName() : FString());
 			Record.bDirectHit = !ActualHitActorName.IsEmpty() && !Record.TargetName.IsEmpty() && ActualHitActorName == Record.TargetName;
 			
-			const bool bTargetPointerValid = Record.TargetActor.IsValid();
+			FBlueUnitHandle RecordInstance;
+			RecordInstance.Id = Record.TargetInstanceId;
+			const bool bTargetPointerValid = Record.TargetActor.IsValid() || BlueForceInstances.IsAlive(RecordInstance);
 			Record.bTargetDestroyed = (Record.bDirectHit || (DestroyedCount > 0 && !bTargetPointerValid));
 
 			// 更新反制统计数据（从MockMissileActor获取数据）
@@ -3451,7 +3958,7 @@ void UScenarioMenuSubsystem::UpdateMissileRecordOnImpact(AMockMissileActor* Miss
 				Missile->GetCountermeasureStats(Record.CountermeasureStats);
 
 				// 记录是否在干扰区域内失去目标
-				Record.CountermeasureStats.bLostTargetInJammerRange = !Record.TargetActor.IsValid() && Record.CountermeasureStats.bEnteredJammerRange;
+				Record.CountermeasureStats.bLostTargetInJammerRange = !bTargetPointerValid && Record.CountermeasureStats.bEnteredJammerRange;
 				
 				// 计算干扰持续时间（从激活到命中）
 				if (Record.CountermeasureStats.bCountermeasureActivated && Record.CountermeasureStats.CountermeasureActivationTime >= 0.f)
@@ -3546,219 +4053,574 @@ void UScenarioMenuSubsystem::ResetMissileTestSession()
 	MissileTestRecords.Reset();
 	MissileRecordLookup.Reset();
 	LastMissileSummary = FMissileTestSummary();
+	IndicatorBootstrap.Reset();
+	EnvironmentSweepResult.Reset();
 	ResetHLSplitStats();
+	MissileTrace::ResetTimeline();
+	PerformanceRecorder.Reset();
+	TelemetryRecorder.Reset();
+	TelemetryStream.End();
+	ReplayRecorder.Reset();
+	ReplayPlayer.Close(); // 开始新的测试会话时退出回放查看
+	NextMissileSerial = 1;
+	ActiveBranchVariant = FScenarioBranchVariant();
 	TestSessionStartTime = GetWorld() ? GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
 }
 
-void UScenarioMenuSubsystem::ClearAutoFire()
+void UScenarioMenuSubsystem::BeginPerformanceCapture(UWorld* World)
 {
-	if (UWorld* World = GetWorld())
+	// 部署完成后开始采样，不计入关卡加载耗时
+	PerformanceRecorder.Begin(World);
+
+	// 会话回放自行采样导弹关键帧，不受遥测内存预算影响
+	ReplayRecorder.Begin(World, [this](TArray<AMockMissileActor*>& OutMissiles)
 	{
-		World->GetTimerManager().ClearTimer(AutoFireTimerHandle);
+		CollectInFlightMissiles(OutMissiles);
+	});
+	CaptureReplayDeployment();
+
+	if (FMissileTelemetryRecorder::IsEnabled())
+	{
+		TelemetryRecorder.Begin(World, [this](TArray<AMockMissileActor*>& OutMissiles)
+		{
+			CollectInFlightMissiles(OutMissiles);
+		});
 	}
-	AutoFireRemaining = 0;
+	else
+	{
+		TelemetryRecorder.Reset();
+	}
+
+	// 实时遥测流（仅在 ir.Stream.Enable 开启时生效）
+	TelemetryStream.Begin(World, [this](TArray<AMockMissileActor*>& OutMissiles)
+	{
+		CollectInFlightMissiles(OutMissiles);
+	}, [this](FTelemetryStreamSummary& OutSummary)
+	{
+		CollectStreamSummary(OutSummary);
+	});
 }
 
-void UScenarioMenuSubsystem::CompleteMissileTest()
+void UScenarioMenuSubsystem::CaptureReplayDeployment()
 {
-	// 标记仍在飞行的导弹为过期，避免缺失数据
-	if (MissileRecordLookup.Num() > 0)
+	if (!ReplayRecorder.IsRecording())
 	{
-		TArray<TWeakObjectPtr<AMockMissileActor>> PendingMissiles;
-		MissileRecordLookup.GetKeys(PendingMissiles);
-		for (const TWeakObjectPtr<AMockMissileActor>& MissilePtr : PendingMissiles)
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& Ptr : ActiveBlueUnits)
+	{
+		const AStaticMeshActor* Unit = Cast<AStaticMeshActor>(Ptr.Get());
+		const UStaticMeshComponent* MeshComp = Unit ? Unit->GetStaticMeshComponent() : nullptr;
+		if (MeshComp && !Unit->IsPendingKillPending())
 		{
-			if (MissilePtr.IsValid())
-			{
-				UpdateMissileRecordOnExpired(MissilePtr.Get());
-			}
+			ReplayRecorder.AddBlueUnit(Unit->GetName(), Unit->GetActorTransform(), MeshComp->GetStaticMesh(), MeshComp->GetMaterial(0));
 		}
-		MissileRecordLookup.Reset();
 	}
 
-	ClearAutoFire();
-
-	const double CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
-
-	LastMissileSummary = FMissileTestSummary();
-	LastMissileSummary.SessionDuration = FMath::Max(0.f, static_cast<float>(CurrentTime - TestSessionStartTime));
+	TArray<FBlueUnitHandle> InstanceHandles;
+	BlueForceInstances.GetAliveUnits(InstanceHandles);
+	for (const FBlueUnitHandle& Handle : InstanceHandles)
+	{
+		UStaticMesh* Mesh = nullptr;
+		UMaterialInterface* Material = nullptr;
+		if (BlueForceInstances.GetAppearance(Handle, Mesh, Material))
+		{
+			const FBlueUnitInstance* Instance = BlueForceInstances.Find(Handle);
+			ReplayRecorder.AddBlueUnit(Instance->Name, Instance->Transform, Mesh, Material);
+		}
+	}
 
-	if (MissileTestRecords.Num() == 0)
+	for (const TWeakObjectPtr<ARadarJammerActor>& Ptr : ActiveRadarJammers)
 	{
-		return;
+		if (const ARadarJammerActor* Jammer = Ptr.Get())
+		{
+			ReplayRecorder.AddJammer(Jammer->GetActorLocation(), Jammer->GetBaseRadius());
+		}
 	}
+}
 
-	LastMissileSummary.TotalShots = MissileTestRecords.Num();
-	double TotalFlightTime = 0.0;
-	int32 FlightSamples = 0;
-	double TotalDistance = 0.0;
-	double TotalDestroyed = 0.0;
+void UScenarioMenuSubsystem::CollectInFlightMissiles(TArray<AMockMissileActor*>& OutMissiles) const
+{
+	// GetActiveInterceptorMissiles 会先清空输出数组，因此放在前面
+	GetActiveInterceptorMissiles(OutMissiles);
+	for (const TWeakObjectPtr<AMockMissileActor>& Ptr : ActiveMissiles)
+	{
+		if (AMockMissileActor* Missile = Ptr.Get())
+		{
+			OutMissiles.Add(Missile);
+		}
+	}
+}
 
-	double LastAutoLaunchTime = -1.0;
-	double AutoIntervalAccumulator = 0.0;
-	int32 AutoIntervals = 0;
+bool UScenarioMenuSubsystem::CaptureCheckpoint(FScenarioCheckpoint& OutCheckpoint)
+{
+	UWorld* World = GetWorld();
+	if (!World || !bHasActiveScenarioConfig)
+	{
+		return false;
+	}
 
-	int32 MissCount = 0;
+	CleanupMissiles();
 
-	// 干扰对抗新指标统计
-	int32 CountermeasureEnabledMissiles = 0; // 启用干扰对抗算法的导弹数
-	int32 CountermeasureSuppressionSuccessCount = 0; // 干扰抑制成功数（在干扰区域内失去目标或未命中）
-	int32 CountermeasureRadiusReductionSamples = 0; // 反制半径缩减样本数
-	float CountermeasureRadiusReductionAccumulator = 0.f; // 反制半径缩减累计值
-	int32 CountermeasureEnteredJammerRangeCount = 0; // 进入干扰区域的导弹数
-	int32 CountermeasureCoverageSuccessCount = 0; // 干扰覆盖成功数（进入干扰区域且失去目标或未命中）
-	int32 CountermeasureDurationSamples = 0; // 干扰持续时间样本数
-	float CountermeasureDurationAccumulator = 0.f; // 干扰持续时间累计值
-	float DetectionMarginAccumulator = 0.f;
-	int32 DetectionSamples = 0;
-	float ActivationDelayAccumulator = 0.f;
-	int32 ActivationSamples = 0;
-	int32 ActivationOnTimeCount = 0;
-	float ActivationDistanceAccumulator = 0.f;
-	float ActivationHeightAccumulator = 0.f;
+	OutCheckpoint = FScenarioCheckpoint();
+	OutCheckpoint.Config = ActiveScenarioConfig;
+	OutCheckpoint.MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	OutCheckpoint.CapturedAt = FDateTime::Now().ToString(TEXT("%Y-%m-%d %H:%M:%S"));
+	OutCheckpoint.WorldSeconds = World->GetTimeSeconds();
+	OutCheckpoint.SessionSeconds = static_cast<float>(World->GetTimeSeconds() - TestSessionStartTime);
+	OutCheckpoint.AutoFireRemaining = AutoFireRemaining;
+	OutCheckpoint.NextTargetCursor = NextTargetCursor;
 
-	for (const FMissileTestRecord& Record : MissileTestRecords)
+	for (const TWeakObjectPtr<AActor>& Ptr : ActiveBlueUnits)
 	{
-		if (Record.bAutoFire)
+		const AStaticMeshActor* Unit = Cast<AStaticMeshActor>(Ptr.Get());
+		const UStaticMeshComponent* MeshComp = Unit ? Unit->GetStaticMeshComponent() : nullptr;
+		if (MeshComp && MeshComp->GetStaticMesh() && !Unit->IsPendingKillPending())
 		{
-			++LastMissileSummary.AutoShots;
-			if (LastAutoLaunchTime >= 0.0)
-			{
-				AutoIntervalAccumulator += Record.LaunchTimeSeconds - LastAutoLaunchTime;
-				++AutoIntervals;
-			}
-			LastAutoLaunchTime = Record.LaunchTimeSeconds;
+			FScenarioCheckpointUnit& CheckpointUnit = OutCheckpoint.Units.AddDefaulted_GetRef();
+			CheckpointUnit.Name = Unit->GetName();
+			CheckpointUnit.MeshPath = FSoftObjectPath(MeshComp->GetStaticMesh()).ToString();
+			CheckpointUnit.MaterialPath = MeshComp->GetMaterial(0) ? FSoftObjectPath(MeshComp->GetMaterial(0)).ToString() : FString();
+			CheckpointUnit.Transform = Unit->GetActorTransform();
+		}
+	}
+
+	TArray<FBlueUnitHandle> InstanceHandles;
+	BlueForceInstances.GetAliveUnits(InstanceHandles);
+	for (const FBlueUnitHandle& Handle : InstanceHandles)
+	{
+		UStaticMesh* Mesh = nullptr;
+		UMaterialInterface* Material = nullptr;
+		if (BlueForceInstances.GetAppearance(Handle, Mesh, Material) && Mesh)
+		{
+			const FBlueUnitInstance* Instance = BlueForceInstances.Find(Handle);
+			FScenarioCheckpointUnit& CheckpointUnit = OutCheckpoint.Units.AddDefaulted_GetRef();
+			CheckpointUnit.Name = Instance->Name;
+			CheckpointUnit.MeshPath = FSoftObjectPath(Mesh).ToString();
+			CheckpointUnit.MaterialPath = Material ? FSoftObjectPath(Material).ToString() : FString();
+			CheckpointUnit.Transform = Instance->Transform;
+		}
+	}
+
+	for (const TWeakObjectPtr<ARadarJammerActor>& Ptr : ActiveRadarJammers)
+	{
+		if (const ARadarJammerActor* Jammer = Ptr.Get())
+		{
+			FScenarioCheckpointJammer& CheckpointJammer = OutCheckpoint.Jammers.AddDefaulted_GetRef();
+			CheckpointJammer.Location = Jammer->GetActorLocation();
+			CheckpointJammer.BaseRadius = Jammer->GetBaseRadius();
+			CheckpointJammer.bCountermeasureActive = Jammer->IsCountermeasureActive();
+		}
+	}
+
+	// 拦截弹在前；拦截目标以检查点列表中的下标记录
+	TArray<AMockMissileActor*> Missiles;
+	CollectInFlightMissiles(Missiles);
+	Missiles.RemoveAll([](const AMockMissileActor* Missile)
+	{
+		return Missile->IsPendingKillPending();
+	});
+
+	TMap<const AMockMissileActor*, int32> MissileIndices;
+	for (int32 Index = 0; Index < Missiles.Num(); ++Index)
+	{
+		MissileIndices.Add(Missiles[Index], Index);
+	}
+
+	for (const AMockMissileActor* Missile : Missiles)
+	{
+		FMissileCheckpointState& State = OutCheckpoint.Missiles.AddDefaulted_GetRef();
+		Missile->CaptureCheckpointState(State);
+		if (Missile->IsInterceptor())
+		{
+			const int32* TargetIndex = MissileIndices.Find(Missile->GetInterceptorTarget());
+			State.InterceptorTargetIndex = TargetIndex ? *TargetIndex : INDEX_NONE;
+		}
+		else if (const int32* RecordIndex = MissileRecordLookup.Find(Missile))
+		{
+			State.RecordIndex = *RecordIndex;
+		}
+	}
+
+	OutCheckpoint.Records = MissileTestRecords;
+	OutCheckpoint.Perception = PerceptionStats;
+	OutCheckpoint.HLSplitAttemptCount = HLSplitAttemptCount;
+	OutCheckpoint.HLSplitSuccessCount = HLSplitSuccessCount;
+	OutCheckpoint.HLSplitChildShotCount = HLSplitChildShotCount;
+	OutCheckpoint.HLSplitChildHitCount = HLSplitChildHitCount;
+	OutCheckpoint.HLSplitGroupCount = HLSplitGroupCount;
+	OutCheckpoint.HLSplitGroupIdSeed = HLSplitGroupIdSeed;
+	OutCheckpoint.HLSplitGroupHits = HLSplitGroupHits;
+
+	// 随机数发生器的状态无法读出：以新种子重新初始化，当前会话与各分支从同一状态继续
+	OutCheckpoint.RandomSeed = FMath::Rand();
+	FMath::RandInit(OutCheckpoint.RandomSeed);
+	FMath::SRandInit(OutCheckpoint.RandomSeed);
+
+	UE_LOG(LogTemp, Log, TEXT("CaptureCheckpoint: t=%.2fs units=%d jammers=%d missiles=%d records=%d seed=%d"),
+		OutCheckpoint.SessionSeconds, OutCheckpoint.Units.Num(), OutCheckpoint.Jammers.Num(),
+		OutCheckpoint.Missiles.Num(), OutCheckpoint.Records.Num(), OutCheckpoint.RandomSeed);
+	return true;
+}
+
+bool UScenarioMenuSubsystem::RestoreCheckpoint(UWorld* World, const FScenarioCheckpoint& Checkpoint, const FScenarioBranchVariant& Variant)
+{
+	if (!World)
+	{
+		return false;
+	}
+
+	const FString MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	if (!Checkpoint.MapName.IsEmpty() && !MapName.Equals(Checkpoint.MapName, ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RestoreCheckpoint: checkpoint was captured on %s, current map is %s"), *Checkpoint.MapName, *MapName);
+	}
+
+	// 部署阶段的单位、干扰器与自动发射全部清除，由检查点重建
+	ResetMissileTestSession();
+	ClearSpawnedBlueUnits();
+	FlushPersistentDebugLines(World);
+	ActiveBranchVariant = Variant;
+
+	// 单位名称在新世界中会重新生成：按检查点中的名称建立映射，导弹目标与发射记录据此重新解析
+	struct FRestoredUnit
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FBlueUnitHandle Instance;
+		FString Name;
+	};
+	TMap<FString, FRestoredUnit> RestoredUnits;
+	for (const FScenarioCheckpointUnit& Unit : Checkpoint.Units)
+	{
+		UStaticMesh* Mesh = ScenarioAssets::ResolveOrLoad<UStaticMesh>(FSoftObjectPath(Unit.MeshPath));
+		UMaterialInterface* Material = Unit.MaterialPath.IsEmpty() ? nullptr : ScenarioAssets::ResolveOrLoad<UMaterialInterface>(FSoftObjectPath(Unit.MaterialPath));
+		AActor* SpawnedActor = nullptr;
+		FBlueUnitHandle SpawnedInstance;
+		if (!SpawnBlueUnitAtLocation(World, Unit.Transform.GetLocation(), Unit.Transform.Rotator(), Unit.Name, Mesh, Material, ActiveCountermeasureIndices, true, &SpawnedActor, &SpawnedInstance))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RestoreCheckpoint: failed to restore blue unit %s"), *Unit.Name);
+			continue;
+		}
+
+		FRestoredUnit& Restored = RestoredUnits.Add(Unit.Name);
+		Restored.Actor = SpawnedActor;
+		Restored.Instance = SpawnedInstance;
+		if (SpawnedActor)
+		{
+			Restored.Name = SpawnedActor->GetName();
 		}
 		else
 		{
-			++LastMissileSummary.ManualShots;
+			const FBlueUnitInstance* Instance = BlueForceInstances.Find(SpawnedInstance);
+			Restored.Name = Instance ? Instance->Name : Unit.Name;
 		}
+	}
 
-		TotalDistance += Record.InitialDistance;
+	// 干扰器按基础半径重建；反制造成的半径缩小由恢复后的导弹逐帧重新施加
+	const bool bBakeJammingField = FJammingField::IsEnabled();
+	TArray<AActor*> JammingIgnoredActors;
+	if (bBakeJammingField)
+	{
+		CollectJammingIgnoredActors(JammingIgnoredActors);
+	}
+	for (const FScenarioCheckpointJammer& SavedJammer : Checkpoint.Jammers)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ARadarJammerActor* Jammer = World->SpawnActor<ARadarJammerActor>(SavedJammer.Location, FRotator::ZeroRotator, Params);
+		if (!Jammer)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RestoreCheckpoint: failed to restore jammer at %s"), *SavedJammer.Location.ToString());
+			continue;
+		}
+		Jammer->SetJammerRadius(SavedJammer.BaseRadius);
+		if (SavedJammer.bCountermeasureActive)
+		{
+			Jammer->SetCountermeasureActive(true);
+		}
+		ActiveRadarJammers.Add(Jammer);
+		if (bBakeJammingField)
+		{
+			JammingField.AddJammer(World, Jammer, JammingIgnoredActors);
+		}
+	}
 
-		const float FlightTime = Record.GetFlightDuration();
-		if (FlightTime > 0.f)
+	// 与正常部署一致：单位与干扰器就位后开始采样，导弹计入本次会话
+	BeginPerformanceCapture(World);
+
+	const double NowSeconds = World->GetTimeSeconds();
+	const double TimeShift = NowSeconds - Checkpoint.WorldSeconds;
+	MissileTestRecords = Checkpoint.Records;
+	for (FMissileTestRecord& Record : MissileTestRecords)
+	{
+		Record.LaunchTimeSeconds += TimeShift;
+		if (Record.bImpactRegistered || Record.bExpired)
 		{
-			TotalFlightTime += FlightTime;
-			++FlightSamples;
+			Record.ImpactTimeSeconds += TimeShift;
+		}
+		Record.TargetActor = nullptr;
+		Record.TargetInstanceId = INDEX_NONE;
+		if (const FRestoredUnit* Target = RestoredUnits.Find(Record.TargetName))
+		{
+			Record.TargetActor = Target->Actor;
+			Record.TargetInstanceId = Target->Instance.Id;
+			Record.TargetName = Target->Name;
+		}
+	}
+
+	// 先全部生成再恢复状态，拦截弹的目标可能排在它后面
+	UStaticMesh* MissileMesh = ResolveMissileMesh();
+	UMaterialInterface* MissileMaterial = ResolveMissileMaterial();
+	TArray<AMockMissileActor*> RestoredMissiles;
+	RestoredMissiles.Init(nullptr, Checkpoint.Missiles.Num());
+	for (int32 Index = 0; Index < Checkpoint.Missiles.Num(); ++Index)
+	{
+		const FMissileCheckpointState& State = Checkpoint.Missiles[Index];
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AMockMissileActor* Missile = World->SpawnActor<AMockMissileActor>(State.Location, State.Rotation, Params);
+		if (!Missile)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RestoreCheckpoint: failed to restore missile %d"), Index);
+			continue;
+		}
+		Missile->SetSessionSerial(NextMissileSerial++);
+		Missile->SetupAppearance(MissileMesh, MissileMaterial, State.bIsInterceptor ? FLinearColor(0.1f, 0.4f, 1.f) : FLinearColor(1.f, 0.1f, 0.1f));
+		RestoredMissiles[Index] = Missile;
+	}
+
+	for (int32 Index = 0; Index < Checkpoint.Missiles.Num(); ++Index)
+	{
+		AMockMissileActor* Missile = RestoredMissiles[Index];
+		if (!Missile)
+		{
+			continue;
+		}
+
+		const FMissileCheckpointState& State = Checkpoint.Missiles[Index];
+		AMockMissileActor* InterceptorTarget = RestoredMissiles.IsValidIndex(State.InterceptorTargetIndex) ? RestoredMissiles[State.InterceptorTargetIndex] : nullptr;
+		const FRestoredUnit* Target = State.TargetName.IsEmpty() ? nullptr : RestoredUnits.Find(State.TargetName);
+		Missile->RestoreCheckpointState(State, Target ? Target->Actor.Get() : nullptr, Target ? Target->Instance : FBlueUnitHandle(), InterceptorTarget);
+
+		if (State.bIsInterceptor)
+		{
+			Missile->OnImpact.AddUObject(this, &UScenarioMenuSubsystem::HandleInterceptorImpact);
+			Missile->OnExpired.AddUObject(this, &UScenarioMenuSubsystem::HandleInterceptorExpired);
+			ActiveInterceptorMissiles.Add(Missile);
+			PerformanceRecorder.NoteInterceptorSpawned();
+			continue;
 		}
 
+		Missile->OnImpact.AddUObject(this, &UScenarioMenuSubsystem::HandleMissileImpact);
+		Missile->OnExpired.AddUObject(this, &UScenarioMenuSubsystem::HandleMissileExpired);
+		ActiveMissiles.Add(Missile);
+		PerformanceRecorder.NoteMissileSpawned(ActiveMissiles.Num());
+
+		ApplyBranchVariant(Missile);
+		if (MissileTestRecords.IsValidIndex(State.RecordIndex))
+		{
+			MissileRecordLookup.Add(Missile, State.RecordIndex);
+			MissileTestRecords[State.RecordIndex].CountermeasureStats.bCountermeasureEnabled = Missile->IsCountermeasureEnabled();
+		}
+	}
+
+	PerceptionStats = Checkpoint.Perception;
+	HLSplitAttemptCount = Checkpoint.HLSplitAttemptCount;
+	HLSplitSuccessCount = Checkpoint.HLSplitSuccessCount;
+	HLSplitChildShotCount = Checkpoint.HLSplitChildShotCount;
+	HLSplitChildHitCount = Checkpoint.HLSplitChildHitCount;
+	HLSplitGroupCount = Checkpoint.HLSplitGroupCount;
+	HLSplitGroupIdSeed = Checkpoint.HLSplitGroupIdSeed;
+	HLSplitGroupHits = Checkpoint.HLSplitGroupHits;
+	NextTargetCursor = Checkpoint.NextTargetCursor;
+	TestSessionStartTime = NowSeconds - Checkpoint.SessionSeconds;
+
+	// 与采集时的会话从同一随机状态继续
+	FMath::RandInit(Checkpoint.RandomSeed);
+	FMath::SRandInit(Checkpoint.RandomSeed);
+
+	AutoFireRemaining = Checkpoint.AutoFireRemaining;
+	if (AutoFireRemaining > 0)
+	{
+		World->GetTimerManager().SetTimer(AutoFireTimerHandle, this, &UScenarioMenuSubsystem::HandleAutoFireTick, 0.6f, false);
+	}
+
+	RefreshBlueMonitor();
+	RebuildViewSequence();
+
+	UE_LOG(LogTemp, Log, TEXT("RestoreCheckpoint: variant '%s' units=%d jammers=%d missiles=%d/%d records=%d"),
+		*Variant.Name, RestoredUnits.Num(), ActiveRadarJammers.Num(), ActiveMissiles.Num() + ActiveInterceptorMissiles.Num(),
+		Checkpoint.Missiles.Num(), MissileTestRecords.Num());
+	return true;
+}
+
+void UScenarioMenuSubsystem::ApplyBranchVariant(AMockMissileActor* Missile) const
+{
+	if (!Missile || Missile->IsInterceptor() || ActiveBranchVariant.IsBaseline())
+	{
+		return;
+	}
+
+	if (ActiveBranchVariant.bDisableCountermeasure)
+	{
+		Missile->DisableCountermeasure();
+		return;
+	}
+	Missile->SetCountermeasureLeadTime(ActiveBranchVariant.CountermeasureLeadSeconds);
+}
+
+void UScenarioMenuSubsystem::CollectStreamSummary(FTelemetryStreamSummary& OutSummary) const
+{
+	// 与 CompleteMissileTest 的命中口径一致：摧毁数量大于 0 记为命中，已结束且未摧毁记为未命中
+	OutSummary = FTelemetryStreamSummary();
+	OutSummary.TotalShots = MissileTestRecords.Num();
+	for (const FMissileTestRecord& Record : MissileTestRecords)
+	{
 		if (Record.DestroyedCount > 0)
 		{
-			++LastMissileSummary.Hits;
+			++OutSummary.Hits;
 			if (Record.bDirectHit)
 			{
-				++LastMissileSummary.DirectHits;
+				++OutSummary.DirectHits;
 			}
-			else
-			{
-				++LastMissileSummary.AoEHits;
-			}
-			TotalDestroyed += Record.DestroyedCount;
 		}
-		else
+		else if (Record.bImpactRegistered || Record.bExpired)
 		{
-			++MissCount;
+			++OutSummary.Misses;
 		}
+	}
+	OutSummary.HitRate = OutSummary.TotalShots > 0 ? (static_cast<float>(OutSummary.Hits) * 100.f / OutSummary.TotalShots) : 0.f;
 
-		const FMissileCountermeasureStats& CounterStats = Record.CountermeasureStats;
-		if (CounterStats.bCountermeasureEnabled)
-		{
-			if (CounterStats.bDetectionLogged && CounterStats.DetectionBaseRadius > KINDA_SMALL_NUMBER)
-			{
-				++DetectionSamples;
-				const float MarginPercent = (CounterStats.DetectionDistanceToJammer - CounterStats.DetectionBaseRadius) / CounterStats.DetectionBaseRadius * 100.f;
-				DetectionMarginAccumulator += MarginPercent;
-			}
-			if (CounterStats.bCountermeasureActivated && CounterStats.CountermeasureActivationTime >= 0.f && CounterStats.DetectionTime >= 0.f)
-			{
-				++ActivationSamples;
-				const float DelaySeconds = FMath::Max(0.f, CounterStats.CountermeasureActivationTime - CounterStats.DetectionTime);
-				ActivationDelayAccumulator += DelaySeconds;
-				ActivationDistanceAccumulator += CounterStats.CountermeasureActivationDistanceToJammer;
-				ActivationHeightAccumulator += CounterStats.CountermeasureActivationHeightDifference;
+	for (const TWeakObjectPtr<AMockMissileActor>& Ptr : ActiveMissiles)
+	{
+		OutSummary.ActiveMissiles += Ptr.IsValid() ? 1 : 0;
+	}
+	for (const TWeakObjectPtr<AMockMissileActor>& Ptr : ActiveInterceptorMissiles)
+	{
+		OutSummary.ActiveInterceptors += Ptr.IsValid() ? 1 : 0;
+	}
+}
 
-				const bool bDelayOk = DelaySeconds <= 0.5f;
-				const bool bDistanceOk = CounterStats.CountermeasureActivationBaseRadius > KINDA_SMALL_NUMBER
-					? (CounterStats.CountermeasureActivationDistanceToJammer >= CounterStats.CountermeasureActivationBaseRadius * 0.95f)
-					: true;
-				const bool bHeightOk = FMath::Abs(CounterStats.CountermeasureActivationHeightDifference) <= 1500.f;
+void UScenarioMenuSubsystem::RecordScenarioEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location)
+{
+	ReplayRecorder.AddEvent(Type, Subject, Location);
+	TelemetryStream.PublishEvent(Type, Subject, Location);
+}
 
-				if (bDelayOk && bDistanceOk && bHeightOk)
-				{
-					++ActivationOnTimeCount;
-				}
+void UScenarioMenuSubsystem::RecordBlueUnitDestroyed(const FString& Name, const FVector& Location)
+{
+	ReplayRecorder.NoteBlueUnitDestroyed(Name, Location);
+	TelemetryStream.PublishEvent(EScenarioReplayEvent::BlueUnitDestroyed, INDEX_NONE, Location);
+}
 
-				// 记录反制半径缩减率
-				if (CounterStats.CountermeasureActivationRadiusReductionPercent > 0.f)
-				{
-					++CountermeasureRadiusReductionSamples;
-					CountermeasureRadiusReductionAccumulator += CounterStats.CountermeasureActivationRadiusReductionPercent;
-				}
+bool UScenarioMenuSubsystem::OpenReplay(const FString& FilePath)
+{
+	UWorld* World = GetWorld();
+	const FString ReplayFile = FilePath.IsEmpty() ? FScenarioReplayPlayer::FindLatestReplayFile() : FilePath;
+	if (!World || ReplayFile.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OpenReplay: no world or no replay file found."));
+		return false;
+	}
 
-				// 记录干扰持续时间
-				if (CounterStats.CountermeasureDuration > 0.f)
-				{
-					++CountermeasureDurationSamples;
-					CountermeasureDurationAccumulator += CounterStats.CountermeasureDuration;
-				}
-			}
+	// 回放只驱动代理可视体：清理当前场景的单位、干扰区域与导弹，避免与代理重叠
+	ClearSpawnedBlueUnits();
+	RemoveMissileOverlay();
+	FlushPersistentDebugLines(World);
+	return ReplayPlayer.Open(World, ReplayFile);
+}
 
-			// 统计干扰抑制成功率：启用干扰对抗算法后，导弹在干扰区域内失去目标或未命中
-			if (CounterStats.bCountermeasureEnabled)
+void UScenarioMenuSubsystem::CloseReplay()
+{
+	ReplayPlayer.Close();
+}
+
+bool UScenarioMenuSubsystem::StartResultsExport()
+{
+	if (ResultsExporter.IsRunning() || MissileTestRecords.Num() == 0)
+	{
+		return false;
+	}
+
+	// 在游戏线程拍快照，后台线程只读快照，不访问导弹或世界
+	FScenarioResultsSnapshot Snapshot;
+	Snapshot.Config = ActiveScenarioConfig;
+	Snapshot.Summary = LastMissileSummary;
+	Snapshot.Records = MissileTestRecords;
+	Snapshot.SessionStartTime = TestSessionStartTime;
+	BuildIndicatorEvaluations(Snapshot.Evaluations);
+	return ResultsExporter.Start(MoveTemp(Snapshot));
+}
+
+void UScenarioMenuSubsystem::ClearAutoFire()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AutoFireTimerHandle);
+	}
+	AutoFireRemaining = 0;
+}
+
+void UScenarioMenuSubsystem::CompleteMissileTest()
+{
+	// 标记仍在飞行的导弹为过期，避免缺失数据
+	if (MissileRecordLookup.Num() > 0)
+	{
+		TArray<TWeakObjectPtr<AMockMissileActor>> PendingMissiles;
+		MissileRecordLookup.GetKeys(PendingMissiles);
+		for (const TWeakObjectPtr<AMockMissileActor>& MissilePtr : PendingMissiles)
+		{
+			if (MissilePtr.IsValid())
 			{
-				++CountermeasureEnabledMissiles;
-				// 如果进入过干扰区域，且失去目标或未命中，则算作抑制成功
-				if (CounterStats.bEnteredJammerRange)
-				{
-					++CountermeasureEnteredJammerRangeCount;
-					if (CounterStats.bLostTargetInJammerRange || Record.DestroyedCount == 0)
-					{
-						++CountermeasureSuppressionSuccessCount;
-						++CountermeasureCoverageSuccessCount;
-					}
-				}
+				UpdateMissileRecordOnExpired(MissilePtr.Get());
 			}
 		}
+		MissileRecordLookup.Reset();
 	}
 
-	LastMissileSummary.HitRate = LastMissileSummary.TotalShots > 0 ? (static_cast<float>(LastMissileSummary.Hits) * 100.f / LastMissileSummary.TotalShots) : 0.f;
-	LastMissileSummary.DirectHitRate = LastMissileSummary.Hits > 0 ? (static_cast<float>(LastMissileSummary.DirectHits) * 100.f / LastMissileSummary.Hits) : 0.f;
-	LastMissileSummary.AverageLaunchDistance = LastMissileSummary.TotalShots > 0 ? static_cast<float>(TotalDistance / LastMissileSummary.TotalShots) : 0.f;
-	LastMissileSummary.AverageFlightTime = FlightSamples > 0 ? static_cast<float>(TotalFlightTime / FlightSamples) : 0.f;
-	LastMissileSummary.AverageDestroyedPerHit = LastMissileSummary.Hits > 0 ? static_cast<float>(TotalDestroyed / LastMissileSummary.Hits) : 0.f;
-	LastMissileSummary.AverageAutoLaunchInterval = AutoIntervals > 0 ? static_cast<float>(AutoIntervalAccumulator / AutoIntervals) : 0.f;
-	LastMissileSummary.Misses = MissCount;
-	LastMissileSummary.HLSplitAttemptCount = HLSplitAttemptCount;
-	LastMissileSummary.HLSplitSuccessCount = HLSplitSuccessCount;
-	LastMissileSummary.HLSplitChildShotCount = HLSplitChildShotCount;
-	LastMissileSummary.HLSplitChildHitCount = HLSplitChildHitCount;
-	LastMissileSummary.HLSplitGroupCount = HLSplitGroupCount;
-	float UniqueTotal = 0.f;
-	for (const auto& Pair : HLSplitGroupHits)
-	{
-		UniqueTotal += Pair.Value.Num();
-	}
-	LastMissileSummary.HLSplitGroupUniqueTargetsTotal = UniqueTotal;
-	LastMissileSummary.CountermeasureDetectionSamples = DetectionSamples;
-	LastMissileSummary.CountermeasureAverageDetectionMarginPercent = DetectionSamples > 0 ? (DetectionMarginAccumulator / DetectionSamples) : 0.f;
-	LastMissileSummary.CountermeasureActivationSamples = ActivationSamples;
-	LastMissileSummary.CountermeasureAverageActivationDelay = ActivationSamples > 0 ? (ActivationDelayAccumulator / ActivationSamples) : 0.f;
-	LastMissileSummary.CountermeasureOnTimeRate = ActivationSamples > 0 ? (static_cast<float>(ActivationOnTimeCount) * 100.f / ActivationSamples) : 0.f;
-	LastMissileSummary.CountermeasureAverageActivationDistance = ActivationSamples > 0 ? (ActivationDistanceAccumulator / ActivationSamples) : 0.f;
-	LastMissileSummary.CountermeasureAverageActivationHeightDiff = ActivationSamples > 0 ? (ActivationHeightAccumulator / ActivationSamples) : 0.f;
-	LastMissileSummary.CountermeasureSuppressionSuccessRate = CountermeasureEnabledMissiles > 0 ? (static_cast<float>(CountermeasureSuppressionSuccessCount) * 100.f / CountermeasureEnabledMissiles) : 0.f;
-	LastMissileSummary.CountermeasureAverageRadiusReductionRate = CountermeasureRadiusReductionSamples > 0 ? (CountermeasureRadiusReductionAccumulator / CountermeasureRadiusReductionSamples) : 0.f;
-	LastMissileSummary.CountermeasureCoverageSuccessRate = CountermeasureEnteredJammerRangeCount > 0 ? (static_cast<float>(CountermeasureCoverageSuccessCount) * 100.f / CountermeasureEnteredJammerRangeCount) : 0.f;
-	LastMissileSummary.CountermeasureAverageDuration = CountermeasureDurationSamples > 0 ? (CountermeasureDurationAccumulator / CountermeasureDurationSamples) : 0.f;
+	ClearAutoFire();
 
-	if (bHasActiveScenarioConfig)
+	// 导出导弹生命周期时间线（仅在 ir.MissileTrace.Timeline 开启时生效）
+	FResultsHistoryArtifacts Artifacts;
+	Artifacts.TimelineFile = MissileTrace::ExportTimelineToProfilingDir();
+
+	// 停止遥测采样并导出（数据保留到下一次测试会话开始）
+	TelemetryRecorder.Stop();
+	TelemetryStream.End();
+	Artifacts.TelemetryFile = TelemetryRecorder.ExportToTelemetryDir();
+
+	// 保存会话回放（仅在 ir.Replay.Record 开启时生效）
+	Artifacts.ReplayFile = ReplayRecorder.SaveToReplayDir();
+	ReplayRecorder.Reset();
+
+	const double CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : FPlatformTime::Seconds();
+
+	LastMissileSummary = FMissileTestSummary();
+	LastMissileSummary.SessionDuration = FMath::Max(0.f, static_cast<float>(CurrentTime - TestSessionStartTime));
+	PerformanceRecorder.End(LastMissileSummary.Performance);
+
+	if (MissileTestRecords.Num() == 0)
 	{
-		const FEnvironmentEffect EnvEffect = BuildEnvironmentEffect(ActiveScenarioConfig);
-		ApplyEnvironmentEffectToSummary(EnvEffect, LastMissileSummary);
+		return;
 	}
 
-	ComputeResourceCostScore(LastMissileSummary);
+	TArray<const FMissileTestRecord*> RecordPtrs;
+	GatherRecordPointers(MissileTestRecords, RecordPtrs);
+	const FIndicatorEvaluationInputs Inputs = MakeIndicatorEvaluationInputs();
+	SummarizeMissileRecords(Inputs, RecordPtrs, LastMissileSummary);
+	ApplyEnvironmentToSummary(Inputs, LastMissileSummary);
+	EnvironmentSweepResult.Reset();
+	StartIndicatorBootstrap();
+
+	// 追加到跨会话结果历史（仅在 ir.History.Record 开启时生效）；
+	// 蒙特卡洛/正交批量的各轮不逐轮写入，避免一次批量运行淹没历史记录；批量结束时另行追加一条聚合条目
+	if (FResultsHistoryStore::IsEnabled() && !IsMonteCarloRunning() && !IsOrthogonalBatchRunning())
+	{
+		TArray<FIndicatorEvaluationResult> Evaluations;
+		BuildIndicatorEvaluations(Evaluations);
+		ResultsHistory.Append(bHasActiveScenarioConfig ? ActiveScenarioConfig : FScenarioTestConfig(), LastMissileSummary, Evaluations, Artifacts);
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("Missile test completed: Shots=%d Hits=%d HitRate=%.1f%%"),
 		LastMissileSummary.TotalShots, LastMissileSummary.Hits, LastMissileSummary.HitRate);
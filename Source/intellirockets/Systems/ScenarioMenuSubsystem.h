@@ -4,6 +4,24 @@
 #include "Containers/Set.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Systems/ScenarioTestMetrics.h"
+#include "Systems/ScenarioPerformanceRecorder.h"
+#include "Systems/ScenarioHeadlessRunner.h"
+#include "Systems/OrthogonalBatchExecutor.h"
+#include "Systems/MonteCarloCampaign.h"
+#include "Systems/BlueForceInstances.h"
+#include "Systems/BlueUnitPlacement.h"
+#include "Systems/ScenarioActorRegistry.h"
+#include "Systems/JammingField.h"
+#include "Systems/MissileTelemetryRecorder.h"
+#include "Systems/ScenarioReplay.h"
+#include "Systems/ScenarioResultsExporter.h"
+#include "Systems/ResultsHistoryStore.h"
+#include "Systems/TelemetryStream.h"
+#include "Systems/ScenarioRemoteControl.h"
+#include "Systems/IndicatorBootstrap.h"
+#include "Systems/EnvironmentSensitivity.h"
+#include "Systems/ScenarioBranchExecutor.h"
+#include "Systems/IndicatorFormula.h"
 #include "UI/SScenarioScreen.h"
 #include "ScenarioMenuSubsystem.generated.h"
 
@@ -16,15 +34,34 @@ struct FScenarioTestConfig;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnScenarioTestRequested, const FScenarioTestConfig&);
 
+/** 汇总与指标计算所需的会话级数据（不随发射记录变化），可复制到后台线程使用 */
+struct FIndicatorEvaluationInputs
+{
+	FScenarioTestConfig Config;
+	bool bHasConfig = false;
+	FPerceptionRuntimeStats Perception;
+	TSharedPtr<const FIndicatorFormulaTable, ESPMode::ThreadSafe> Formulas; // 只读，可跨线程共享
+	int32 HLSplitAttemptCount = 0;
+	int32 HLSplitSuccessCount = 0;
+	int32 HLSplitChildShotCount = 0;
+	int32 HLSplitChildHitCount = 0;
+	int32 HLSplitGroupCount = 0;
+	float HLSplitGroupUniqueTargetsTotal = 0.f;
+};
+
 UCLASS()
 class UScenarioMenuSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 	friend class AMockMissileActor;
+	friend class FScenarioHeadlessRunner;
+	friend class FMonteCarloCampaign;
+	friend class FScenarioRemoteControl;
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
-	AMockMissileActor* SpawnMissile(UWorld* World, AActor* Target, bool bFromAutoFire, const FVector* OverrideLocation = nullptr, const FRotator* OverrideRotation = nullptr);
+	/** Target 与 TargetInstance 至多一个有效；都无效时导弹在视野内自动搜索 */
+	AMockMissileActor* SpawnMissile(UWorld* World, AActor* Target, bool bFromAutoFire, const FVector* OverrideLocation = nullptr, const FRotator* OverrideRotation = nullptr, const FBlueUnitHandle& TargetInstance = FBlueUnitHandle());
 
 private:
 	void OnWorldReady(UWorld* World, const UWorld::InitializationValues IVs);
@@ -37,11 +74,14 @@ private:
 	void SaveAll();
 	void BackToMainMenu();
 	void BeginScenarioTest();
+	void StartScenarioWithConfig(const FScenarioTestConfig& Config);
 	void ApplyEnvironmentSettings(UWorld* World, const FScenarioTestConfig& Config);
+	void ScheduleSkyRecapture(UWorld* World, class USkyLightComponent* SkyComp);
 	void DeployBlueForScenario(UWorld* World, const FScenarioTestConfig& Config);
 	void ClearSpawnedBlueUnits();
 	void SpawnRadarJammers(UWorld* World); // 生成雷达干扰区域
 	void ClearRadarJammers(); // 清除雷达干扰区域
+	void CollectJammingIgnoredActors(TArray<AActor*>& OutActors) const;
 	void FinalizeScenarioAfterLoad();
 	bool AreScenarioLevelsReady(UWorld* World) const;
 	UClass* ResolveBlueUnitClass() const;
@@ -58,7 +98,11 @@ private:
 	void EnsureOverviewPawn(UWorld* World);
 	void RestorePreviousPawn();
 	void RefreshBlueMonitor();
-	bool SpawnBlueUnitAtLocation(UWorld* World, const FVector& DesiredLocation, const FRotator& Facing, const FString& MarkerName, class UStaticMesh* UnitMesh, class UMaterialInterface* UnitMaterial, const TArray<int32>& CountermeasureIndices);
+	/**
+	 * bGroundProjected 为 true 时 DesiredLocation 已由 BlueUnitPlacement 投影到地面。
+	 * 成功时 OutActor（Actor 模式）或 OutInstance（实例化模式）返回新单位，另一项保持为空
+	 */
+	bool SpawnBlueUnitAtLocation(UWorld* World, const FVector& DesiredLocation, const FRotator& Facing, const FString& MarkerName, class UStaticMesh* UnitMesh, class UMaterialInterface* UnitMaterial, const TArray<int32>& CountermeasureIndices, bool bGroundProjected = false, AActor** OutActor = nullptr, FBlueUnitHandle* OutInstance = nullptr);
 	bool FireSingleMissile(bool bFromAutoFire = false);
 	void FireMultipleMissiles(int32 Count);
 	AActor* SelectNextBlueTarget();
@@ -92,24 +136,67 @@ private:
 	void EnsureMissileOverlay();
 	void RemoveMissileOverlay();
 	void UpdateMissileOverlay();
-	void RecordMissileLaunch(AMockMissileActor* Missile, AActor* Target, const FVector& LaunchLocation, bool bFromAutoFire);
+	void RecordMissileLaunch(AMockMissileActor* Missile, AActor* Target, const FBlueUnitHandle& TargetInstance, const FVector& LaunchLocation, bool bFromAutoFire);
 	void UpdateMissileRecordOnImpact(AMockMissileActor* Missile, AActor* HitActor, int32 DestroyedCount, const FString& HitActorName = FString());
 	void UpdateMissileRecordOnExpired(AMockMissileActor* Missile);
 	void UpdateMissileSplitMeta(AMockMissileActor* Missile, bool bIsSplitChild, int32 SplitGroupId);
 	void UpdateMissileCountermeasureStats(AMockMissileActor* Missile, const FMissileCountermeasureStats& Stats);
 	void ResetMissileTestSession();
+	void BeginPerformanceCapture(UWorld* World);
+	/** 把当前已部署的蓝方单位与干扰器写入会话回放 */
+	void CaptureReplayDeployment();
+	/** 当前在飞的拦截弹与导弹（遥测记录与实时遥测流共用） */
+	void CollectInFlightMissiles(TArray<AMockMissileActor*>& OutMissiles) const;
+	void CollectStreamSummary(FTelemetryStreamSummary& OutSummary) const;
+	/** 离散事件同时写入会话回放与实时遥测流 */
+	void RecordScenarioEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location);
+	void RecordBlueUnitDestroyed(const FString& Name, const FVector& Location);
+	/** 场景地图已是当前世界且流送完成时可原地重置 */
+	bool CanResetScenarioInPlace(UWorld* World, const FScenarioTestConfig& Config) const;
+	/** 不离开当前世界：清理单位/导弹/干扰/轨迹/相机后重新应用环境并部署 */
+	void ResetScenarioInPlace(UWorld* World, const FScenarioTestConfig& Config, bool bApplyEnvironment);
 	void CompleteMissileTest();
+	void ReturnToResultsScreen();
 	void ClearAutoFire();
 	void BuildIndicatorEvaluations(TArray<FIndicatorEvaluationResult>& OutResults) const;
+	FIndicatorEvaluationInputs MakeIndicatorEvaluationInputs() const;
+	/** 由发射记录统计汇总（不含会话时长与运行性能，不应用环境因子）；Bootstrap 重抽样在工作线程上调用，只能读取参数 */
+	static void SummarizeMissileRecords(const FIndicatorEvaluationInputs& Inputs, TConstArrayView<const FMissileTestRecord*> Records, FMissileTestSummary& InOutSummary);
+	/** 按 Inputs.Config 的天气/时间/地图缩放干扰对抗统计，并计算资源消耗得分 */
+	static void ApplyEnvironmentToSummary(const FIndicatorEvaluationInputs& Inputs, FMissileTestSummary& InOutSummary);
+	static void EvaluateIndicators(const FIndicatorEvaluationInputs& Inputs, const FMissileTestSummary& Summary, TConstArrayView<const FMissileTestRecord*> Records, TArray<FIndicatorEvaluationResult>& OutResults);
+	/** 在后台计算各指标的置信区间（CompleteMissileTest 后调用） */
+	void StartIndicatorBootstrap();
+	/** 采集交战中途的场景检查点；采集后以检查点中的种子重新初始化随机数，当前会话与各分支从同一状态继续 */
+	bool CaptureCheckpoint(FScenarioCheckpoint& OutCheckpoint);
+	/** 清理当前世界后按检查点重建单位、干扰器、导弹与记录，并对导弹应用分支变体 */
+	bool RestoreCheckpoint(UWorld* World, const FScenarioCheckpoint& Checkpoint, const FScenarioBranchVariant& Variant);
+	void ApplyBranchVariant(AMockMissileActor* Missile) const;
+	void OnInputStartBranchRun();
 	AActor* GetBlueRocketSpawnAnchor() const;
 	AActor* GetBlueDefendZoneAnchor() const;
-	AActor* FindActorByNameSubstring(const FString& NameFragment) const;
 
 public:
 	/** 获取所有有效的蓝方单位列表（供导弹搜索目标使用） */
 	void GetActiveBlueUnits(TArray<AActor*>& OutUnits) const;
+	/** 实例化蓝方单位（ir.BlueForce.Instanced = 1 时部署在这里） */
+	const FBlueForceInstances& GetBlueForceInstances() const { return BlueForceInstances; }
+	/** 蓝方单位 Actor 的部署序号（与实例化模式的实例句柄 Id 同一编号空间），不是本次部署的单位时返回 INDEX_NONE */
+	int32 GetBlueUnitId(const AActor* Unit) const;
+	/** 存活蓝方单位数量（Actor + 实例） */
+	int32 GetActiveBlueUnitCount() const { return ActiveBlueUnits.Num() + BlueForceInstances.GetAliveCount(); }
 	/** 获取所有雷达干扰区域列表（供导弹检测干扰使用） */
 	void GetActiveRadarJammers(TArray<class ARadarJammerActor*>& OutJammers) const;
+	/** 干扰场查询（ir.Jamming.Field 关闭或没有干扰器时为空） */
+	const FJammingField& GetJammingField() const { return JammingField; }
+	/** 校验干扰场烘焙精度（ir.Jamming.Verify），返回偏差超限的干扰器数量 */
+	int32 VerifyJammingField() const;
+	/** 导弹遥测（ir.Telemetry.SampleRate > 0 时记录） */
+	const FMissileTelemetryRecorder& GetTelemetryRecorder() const { return TelemetryRecorder; }
+	/** 打开会话回放（路径为空时取 Saved/Replays 下最新的文件）；会先清理当前场景中的单位与导弹 */
+	bool OpenReplay(const FString& FilePath);
+	void CloseReplay();
+	FScenarioReplayPlayer& GetReplayPlayer() { return ReplayPlayer; }
 	/** 获取所有拦截导弹列表（供导弹检测拦截威胁使用） */
 	void GetActiveInterceptorMissiles(TArray<AMockMissileActor*>& OutInterceptors) const;
 	
@@ -118,6 +205,11 @@ public:
 	bool HasMissileTestData() const { return MissileTestRecords.Num() > 0; }
 	const FScenarioTestConfig& GetActiveScenarioConfig() const { return ActiveScenarioConfig; }
 	void GetIndicatorEvaluations(TArray<FIndicatorEvaluationResult>& OutResults) const { BuildIndicatorEvaluations(OutResults); }
+	/** 指标置信区间（ir.Bootstrap.Resamples），下标与 GetIndicatorEvaluations 一致 */
+	const FIndicatorBootstrap& GetIndicatorBootstrap() const { return IndicatorBootstrap; }
+	/** 环境因素敏感性分析（天气 × 时间 × 地图），每个测试会话只计算一次；没有测试数据时返回 nullptr */
+	const FEnvironmentSensitivityResult* RunEnvironmentSensitivitySweep();
+	const FEnvironmentSensitivityResult* GetEnvironmentSensitivity() const { return EnvironmentSweepResult.GetPtrOrNull(); }
 	void RegisterHLSplitAttempt();
 	int32 RegisterHLSplitSuccess(int32 AssignedTargetCount);
 	void RegisterHLSplitChildSpawn();
@@ -126,6 +218,31 @@ public:
 	void ResetHLSplitStats();
 	void ResetToStep1(); // 重置到Step1，用于重新配置（供UI调用）
 
+	// 正交测试方法：按正交表生成试验单元并在本机工作进程池中批量执行（供UI调用）
+	bool StartOrthogonalBatch(const FScenarioTestConfig& BaseConfig, FString& OutError);
+	void CancelOrthogonalBatch();
+	bool IsOrthogonalBatchRunning() const { return OrthogonalExecutor.IsValid() && OrthogonalExecutor->IsRunning(); }
+	bool HasOrthogonalResults() const { return OrthogonalExecutor.IsValid() && OrthogonalExecutor->HasResults(); }
+	const FOrthogonalBatchExecutor* GetOrthogonalExecutor() const { return OrthogonalExecutor.Get(); }
+
+	// 结果导出：在后台线程写出全部发射记录、汇总与指标评估（供UI调用）
+	bool StartResultsExport();
+	const FScenarioResultsExporter& GetResultsExporter() const { return ResultsExporter; }
+
+	// 跨会话结果历史（Step5 历史趋势查询）
+	const FResultsHistoryStore& GetResultsHistory() const { return ResultsHistory; }
+
+	// 随机采样测试方法：重复随机部署/发射直到各指标置信区间收敛（供UI调用）
+	bool StartMonteCarloCampaign(const FScenarioTestConfig& Config);
+	bool IsMonteCarloRunning() const { return MonteCarloCampaign.IsValid() && MonteCarloCampaign->IsRunning(); }
+	bool HasMonteCarloResults() const { return MonteCarloCampaign.IsValid() && MonteCarloCampaign->HasResults(); }
+	const FMonteCarloCampaign* GetMonteCarloCampaign() const { return MonteCarloCampaign.Get(); }
+
+	// 分支推演：测试进行中采集检查点，以默认变体在本机工作进程中并行继续并与基线对比（测试中按 B 键）
+	bool StartBranchRun(FString& OutError);
+	bool IsBranchRunRunning() const { return BranchExecutor.IsValid() && BranchExecutor->IsRunning(); }
+	const FScenarioBranchExecutor* GetBranchExecutor() const { return BranchExecutor.Get(); }
+
 	// 感知算法统计上报（供蓝图/外部系统调用）
 	void Perception_ReportDetection(bool bCorrect);
 	void Perception_ReportFalsePositive();
@@ -159,9 +276,23 @@ private:
 	bool bHasPendingScenarioConfig = false;
 	bool bIsRunningScenario = false;
 	FTimerHandle PendingScenarioTimerHandle;
+
+	/** 已应用到世界的环境状态，用于增量应用 */
+	struct FAppliedEnvironmentState
+	{
+		TWeakObjectPtr<UWorld> World;
+		bool bDay = false;
+		bool bFoggy = false;
+	};
+	FAppliedEnvironmentState AppliedEnvironment;
+	FTimerHandle SkyRecaptureTimerHandle;
 	TWeakObjectPtr<UWorld> PendingScenarioWorld;
 	bool bPendingScenarioWaitingLogged = false;
 	TArray<TWeakObjectPtr<AActor>> ActiveBlueUnits;
+	TMap<TObjectKey<AActor>, int32> BlueUnitIds; // 蓝方单位 Actor -> 部署序号，单位被摧毁后仍保留，供遥测标识目标
+	FBlueForceInstances BlueForceInstances;
+	FBlueUnitPlacementService BlueUnitPlacement; // 落地投影与地面高度缓存
+	FJammingField JammingField; // 干扰器干信比的稀疏体素场
 	TArray<TWeakObjectPtr<class ARadarJammerActor>> ActiveRadarJammers; // 雷达干扰区域
 	TSharedPtr<SBlueUnitMonitor> BlueMonitorWidget;
 	TSharedPtr<SWidget> BlueMonitorRoot;
@@ -220,11 +351,27 @@ private:
 	TMap<TWeakObjectPtr<AMockMissileActor>, int32> MissileRecordLookup;
 	FMissileTestSummary LastMissileSummary;
 	double TestSessionStartTime = 0.0;
+	uint32 NextMissileSerial = 1; // 导弹/拦截弹会话序号，UObject UniqueID 在 GC 后会复用，不能作为回放标识
+	FScenarioPerformanceRecorder PerformanceRecorder;
+	FMissileTelemetryRecorder TelemetryRecorder;
+	FScenarioReplayRecorder ReplayRecorder;
+	FScenarioReplayPlayer ReplayPlayer;
+	FScenarioResultsExporter ResultsExporter;
+	FTelemetryStreamPublisher TelemetryStream;
+	FResultsHistoryStore ResultsHistory;
+	FIndicatorBootstrap IndicatorBootstrap;
+	TOptional<FEnvironmentSensitivityResult> EnvironmentSweepResult; // 当前会话的敏感性分析结果
+	TSharedPtr<const FIndicatorFormulaTable, ESPMode::ThreadSafe> IndicatorFormulas; // DecisionIndicators.json 中的指标公式，Initialize 时编译
+	TUniquePtr<FScenarioHeadlessRunner> HeadlessRunner; // 命令行 -ScenarioFile= 启动的无界面运行
+	TUniquePtr<FOrthogonalBatchExecutor> OrthogonalExecutor;
+	TUniquePtr<FMonteCarloCampaign> MonteCarloCampaign;
+	TUniquePtr<FScenarioRemoteControl> RemoteControl; // -ScenarioRemote 开启的本机 JSON-RPC 接口
+	TUniquePtr<FScenarioBranchExecutor> BranchExecutor;
+	FScenarioBranchVariant ActiveBranchVariant; // 分支推演工作进程中对新发射导弹生效的变体
 	FScenarioTestConfig ActiveScenarioConfig;
 	bool bHasActiveScenarioConfig = false;
 	bool bEvasionSubsystemSelected = false;
-	mutable TWeakObjectPtr<AActor> CachedBlueRocketSpawnActor;
-	mutable TWeakObjectPtr<AActor> CachedBlueDefendZoneActor;
+	mutable FScenarioActorRegistry ActorRegistry; // 部署点、锚点与环境 Actor 的增量索引
 	int32 HLSplitAttemptCount = 0;
 	int32 HLSplitSuccessCount = 0;
 	int32 HLSplitChildShotCount = 0;
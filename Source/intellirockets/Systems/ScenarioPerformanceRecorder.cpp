@@ -0,0 +1,182 @@
+#include "Systems/ScenarioPerformanceRecorder.h"
+
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// 降帧判定阈值
+	constexpr float DegradedMinAverageFps = 20.f;
+	constexpr float DegradedLongFrameMs = 50.f;
+	constexpr float DegradedLongFrameRatio = 0.1f;
+	constexpr float DegradedMinSimToWallRatio = 0.9f;
+	// 帧数过少时不做判定（例如刚部署就结束测试）
+	constexpr int32 MinFramesForDegradation = 30;
+
+	int64 GScenarioTraceCount = 0;
+}
+
+FScenarioPerformanceRecorder::~FScenarioPerformanceRecorder()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void FScenarioPerformanceRecorder::NoteTraces(int32 Count)
+{
+	GScenarioTraceCount += Count;
+}
+
+void FScenarioPerformanceRecorder::Begin(UWorld* World)
+{
+	// 蓝方单位在部署阶段生成，早于采样开始：其计数不随本次重置清零
+	const int32 BlueUnitSpawnCount = Stats.BlueUnitSpawnCount;
+	const int32 BlueUnitDestroyCount = Stats.BlueUnitDestroyCount;
+	Reset();
+	Stats.BlueUnitSpawnCount = BlueUnitSpawnCount;
+	Stats.BlueUnitDestroyCount = BlueUnitDestroyCount;
+
+	WorldWeak = World;
+	WallStartSeconds = FPlatformTime::Seconds();
+	LastWallSeconds = WallStartSeconds;
+	LastWorldSeconds = World ? World->GetTimeSeconds() : 0.0;
+	TraceCountAtBegin = GScenarioTraceCount;
+	bHasLastSample = true;
+	Stats.bValid = true;
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioPerformanceRecorder::HandleTick));
+}
+
+void FScenarioPerformanceRecorder::Reset()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Stats = FScenarioPerformanceStats();
+	WorldWeak = nullptr;
+	WallStartSeconds = 0.0;
+	LastWallSeconds = 0.0;
+	LastWorldSeconds = 0.0;
+	SimAccumulator = 0.0;
+	FrameTimeAccumulatorMs = 0.0;
+	TraceCountAtBegin = GScenarioTraceCount;
+	bHasLastSample = false;
+}
+
+void FScenarioPerformanceRecorder::NoteMissileSpawned(int32 ConcurrentMissiles)
+{
+	++Stats.MissileSpawnCount;
+	Stats.PeakConcurrentMissiles = FMath::Max(Stats.PeakConcurrentMissiles, ConcurrentMissiles);
+}
+
+bool FScenarioPerformanceRecorder::HandleTick(float DeltaTime)
+{
+	if (!bHasLastSample)
+	{
+		return true;
+	}
+
+	// 帧耗时取真实时间差，避免固定步长/时间膨胀掩盖卡顿
+	const double NowSeconds = FPlatformTime::Seconds();
+	const float FrameTimeMs = static_cast<float>((NowSeconds - LastWallSeconds) * 1000.0);
+	LastWallSeconds = NowSeconds;
+
+	++Stats.FrameTimeHistogram[FScenarioPerformanceStats::GetFrameTimeBucketIndex(FrameTimeMs)];
+	++Stats.FrameCount;
+	FrameTimeAccumulatorMs += FrameTimeMs;
+	Stats.MaxFrameTimeMs = FMath::Max(Stats.MaxFrameTimeMs, FrameTimeMs);
+
+	if (UWorld* World = WorldWeak.Get())
+	{
+		const double WorldSeconds = World->GetTimeSeconds();
+		SimAccumulator += FMath::Max(0.0, WorldSeconds - LastWorldSeconds);
+		LastWorldSeconds = WorldSeconds;
+	}
+
+	return true;
+}
+
+void FScenarioPerformanceRecorder::End(FScenarioPerformanceStats& OutStats)
+{
+	if (!Stats.bValid)
+	{
+		OutStats = FScenarioPerformanceStats();
+		return;
+	}
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// 补上最后一次 Tick 之后推进的世界时间
+	if (UWorld* World = WorldWeak.Get())
+	{
+		SimAccumulator += FMath::Max(0.0, World->GetTimeSeconds() - LastWorldSeconds);
+		LastWorldSeconds = World->GetTimeSeconds();
+	}
+
+	Stats.WallDuration = static_cast<float>(FMath::Max(0.0, FPlatformTime::Seconds() - WallStartSeconds));
+	Stats.SimDuration = static_cast<float>(SimAccumulator);
+	Stats.SimToWallRatio = Stats.WallDuration > KINDA_SMALL_NUMBER ? Stats.SimDuration / Stats.WallDuration : 0.f;
+	Stats.AverageFrameTimeMs = Stats.FrameCount > 0 ? static_cast<float>(FrameTimeAccumulatorMs / Stats.FrameCount) : 0.f;
+	Stats.AverageFps = Stats.AverageFrameTimeMs > KINDA_SMALL_NUMBER ? 1000.f / Stats.AverageFrameTimeMs : 0.f;
+	Stats.TraceCount = GScenarioTraceCount - TraceCountAtBegin;
+
+	EvaluateDegradation(Stats);
+
+	OutStats = Stats;
+	bHasLastSample = false;
+
+	UE_LOG(LogTemp, Log, TEXT("Scenario performance: Frames=%d AvgFps=%.1f MaxFrame=%.1fms Sim/Wall=%.2f PeakMissiles=%d Traces=%lld Degraded=%d"),
+		Stats.FrameCount, Stats.AverageFps, Stats.MaxFrameTimeMs, Stats.SimToWallRatio, Stats.PeakConcurrentMissiles, Stats.TraceCount, Stats.bDegradedFrameRate ? 1 : 0);
+}
+
+void FScenarioPerformanceRecorder::EvaluateDegradation(FScenarioPerformanceStats& InOutStats) const
+{
+	InOutStats.bDegradedFrameRate = false;
+	InOutStats.DegradedReason.Reset();
+
+	if (InOutStats.FrameCount < MinFramesForDegradation)
+	{
+		return;
+	}
+
+	int32 LongFrames = 0;
+	for (int32 Index = 0; Index < FScenarioPerformanceStats::NumFrameTimeBuckets; ++Index)
+	{
+		const float LowerEdge = Index > 0 ? FScenarioPerformanceStats::GetFrameTimeBucketEdges()[Index - 1] : 0.f;
+		if (LowerEdge >= DegradedLongFrameMs)
+		{
+			LongFrames += InOutStats.FrameTimeHistogram[Index];
+		}
+	}
+	const float LongFrameRatio = static_cast<float>(LongFrames) / InOutStats.FrameCount;
+
+	TArray<FString> Reasons;
+	if (InOutStats.AverageFps < DegradedMinAverageFps)
+	{
+		Reasons.Add(FString::Printf(TEXT("平均帧率 %.1f < %.0f"), InOutStats.AverageFps, DegradedMinAverageFps));
+	}
+	if (LongFrameRatio > DegradedLongFrameRatio)
+	{
+		Reasons.Add(FString::Printf(TEXT("长帧(>=%.0fms)占比 %.0f%%"), DegradedLongFrameMs, LongFrameRatio * 100.f));
+	}
+	if (InOutStats.SimToWallRatio > 0.f && InOutStats.SimToWallRatio < DegradedMinSimToWallRatio)
+	{
+		Reasons.Add(FString::Printf(TEXT("仿真/真实时间比 %.2f < %.2f"), InOutStats.SimToWallRatio, DegradedMinSimToWallRatio));
+	}
+
+	if (Reasons.Num() > 0)
+	{
+		InOutStats.bDegradedFrameRate = true;
+		InOutStats.DegradedReason = FString::Join(Reasons, TEXT("；"));
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Systems/ScenarioTestMetrics.h"
+
+class UWorld;
+
+/**
+ * 测试会话性能记录：
+ * - 通过 FTSTicker 逐帧采样真实帧耗时与世界时间推进，统计帧耗时直方图与仿真/真实时间比；
+ * - 由场景子系统上报导弹/拦截弹/蓝方单位的生成与销毁、当前在飞导弹数；
+ * - 射线检测次数通过静态计数累计（调用点使用 NoteTraces）。
+ * 平均帧率过低、长帧占比过高或仿真时间明显落后于真实时间时，结果标记为可疑。
+ */
+class FScenarioPerformanceRecorder
+{
+public:
+	~FScenarioPerformanceRecorder();
+
+	/** 开始采样（重复调用会重新开始）；蓝方单位生成/销毁计数保留，部署发生在采样开始之前 */
+	void Begin(UWorld* World);
+
+	/** 停止采样并清空统计 */
+	void Reset();
+
+	/** 清空蓝方单位生成/销毁计数（重新部署前调用） */
+	void ResetBlueUnitCounters()
+	{
+		Stats.BlueUnitSpawnCount = 0;
+		Stats.BlueUnitDestroyCount = 0;
+	}
+
+	/** 停止采样，把统计结果写入 OutStats */
+	void End(FScenarioPerformanceStats& OutStats);
+
+	bool IsRecording() const { return TickerHandle.IsValid(); }
+
+	void NoteMissileSpawned(int32 ConcurrentMissiles);
+	void NoteMissileDestroyed() { ++Stats.MissileDestroyCount; }
+	void NoteInterceptorSpawned() { ++Stats.InterceptorSpawnCount; }
+	void NoteInterceptorDestroyed() { ++Stats.InterceptorDestroyCount; }
+	void NoteBlueUnitSpawned() { ++Stats.BlueUnitSpawnCount; }
+	void NoteBlueUnitsDestroyed(int32 Count) { Stats.BlueUnitDestroyCount += Count; }
+
+	/** 累计射线检测次数（游戏线程调用） */
+	static void NoteTraces(int32 Count = 1);
+
+private:
+	bool HandleTick(float DeltaTime);
+	void EvaluateDegradation(FScenarioPerformanceStats& InOutStats) const;
+
+	FScenarioPerformanceStats Stats;
+	TWeakObjectPtr<UWorld> WorldWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double WallStartSeconds = 0.0;
+	double LastWallSeconds = 0.0;
+	double LastWorldSeconds = 0.0;
+	double SimAccumulator = 0.0;
+	double FrameTimeAccumulatorMs = 0.0;
+	int64 TraceCountAtBegin = 0;
+	bool bHasLastSample = false;
+};
@@ -0,0 +1,932 @@
+#include "Systems/ScenarioRemoteControl.h"
+#include "Systems/ScenarioMenuSubsystem.h"
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/ResultsHistoryStore.h"
+
+#include "Common/TcpSocketBuilder.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#include <atomic>
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarRemoteEnable(
+		TEXT("ir.Remote.Enable"),
+		0,
+		TEXT("1: 启动时在本机开启 JSON-RPC 远程控制接口（也可用命令行 -ScenarioRemote）"));
+
+	TAutoConsoleVariable<int32> CVarRemotePort(
+		TEXT("ir.Remote.Port"),
+		47811,
+		TEXT("远程控制接口监听端口（仅绑定 127.0.0.1，可用命令行 -ScenarioRemotePort= 覆盖）"));
+
+	// JSON-RPC 2.0 错误码
+	constexpr int32 RpcParseError = -32700;
+	constexpr int32 RpcInvalidRequest = -32600;
+	constexpr int32 RpcMethodNotFound = -32601;
+	constexpr int32 RpcInvalidParams = -32602;
+	constexpr int32 RpcServerError = -32000;
+
+	constexpr double DeploymentTimeoutSeconds = 300.0; // 真实时间
+	constexpr double ProgressIntervalSeconds = 0.5;
+	constexpr double RequestTimeoutSeconds = 10.0;     // 连接建立后收齐请求的时限
+	constexpr int32 MaxHeaderBytes = 16 * 1024;
+	constexpr int32 MaxBodyBytes = 1024 * 1024;
+	constexpr int32 MaxShotsPerCall = 1000;
+
+	FString ToJsonLine(const TSharedRef<FJsonObject>& JsonObject)
+	{
+		FString Out;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Out;
+	}
+
+	TSharedRef<FJsonObject> MakeRpcError(const TSharedPtr<FJsonValue>& Id, int32 Code, const FString& Message)
+	{
+		TSharedRef<FJsonObject> Error = MakeShareable(new FJsonObject);
+		Error->SetNumberField(TEXT("code"), Code);
+		Error->SetStringField(TEXT("message"), Message);
+
+		TSharedRef<FJsonObject> Response = MakeShareable(new FJsonObject);
+		Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+		Response->SetField(TEXT("id"), Id.IsValid() ? Id : MakeShareable(new FJsonValueNull));
+		Response->SetObjectField(TEXT("error"), Error);
+		return Response;
+	}
+
+	void AppendUtf8(TArray<uint8>& Out, const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	int32 FindHeaderEnd(const TArray<uint8>& Bytes)
+	{
+		for (int32 Index = 0; Index + 3 < Bytes.Num(); ++Index)
+		{
+			if (Bytes[Index] == '\r' && Bytes[Index + 1] == '\n' && Bytes[Index + 2] == '\r' && Bytes[Index + 3] == '\n')
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	FString Utf8ToString(const uint8* Data, int32 Num)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Num);
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+// ---------------- FScenarioRemoteCall ----------------
+
+void FScenarioRemoteCall::PostProgress(const TSharedRef<FJsonObject>& Progress)
+{
+	if (!bStream)
+	{
+		return;
+	}
+
+	Progress->SetField(TEXT("id"), Id.IsValid() ? Id : MakeShareable(new FJsonValueNull));
+	TSharedRef<FJsonObject> Notification = MakeShareable(new FJsonObject);
+	Notification->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+	Notification->SetStringField(TEXT("method"), TEXT("progress"));
+	Notification->SetObjectField(TEXT("params"), Progress);
+
+	FScopeLock ScopeLock(&Lock);
+	if (!bDone)
+	{
+		Lines.Add(ToJsonLine(Notification));
+	}
+}
+
+void FScenarioRemoteCall::Succeed(const TSharedRef<FJsonObject>& Result)
+{
+	TSharedRef<FJsonObject> Response = MakeShareable(new FJsonObject);
+	Response->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+	Response->SetField(TEXT("id"), Id.IsValid() ? Id : MakeShareable(new FJsonValueNull));
+	Response->SetObjectField(TEXT("result"), Result);
+	Finish(Response);
+}
+
+void FScenarioRemoteCall::Fail(int32 Code, const FString& Message)
+{
+	UE_LOG(LogTemp, Warning, TEXT("RemoteControl: %s failed: %s"), *Method, *Message);
+	Finish(MakeRpcError(Id, Code, Message));
+}
+
+void FScenarioRemoteCall::Finish(const TSharedRef<FJsonObject>& Response)
+{
+	const FString Line = ToJsonLine(Response);
+	FScopeLock ScopeLock(&Lock);
+	if (!bDone)
+	{
+		Lines.Add(Line);
+		bDone = true;
+	}
+}
+
+bool FScenarioRemoteCall::TakeLines(TArray<FString>& OutLines)
+{
+	FScopeLock ScopeLock(&Lock);
+	OutLines.Append(MoveTemp(Lines));
+	Lines.Reset();
+	return bDone;
+}
+
+bool FScenarioRemoteCall::IsDone() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return bDone;
+}
+
+// ---------------- 网络线程 ----------------
+
+/**
+ * 远程控制的 HTTP 服务：每个连接处理一个请求（Connection: close），
+ * 请求解析为 FScenarioRemoteCall 后交给游戏线程，结果或进度在本线程以非阻塞方式写回。
+ */
+class FScenarioRemoteServer : public FRunnable
+{
+public:
+	FScenarioRemoteServer(FScenarioRemoteControl& InOwner, int32 InPort)
+		: Owner(InOwner)
+		, Port(InPort)
+	{
+	}
+
+	virtual ~FScenarioRemoteServer() override
+	{
+		Shutdown();
+	}
+
+	bool Start()
+	{
+		SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (!SocketSubsystem)
+		{
+			return false;
+		}
+
+		ListenSocket = FTcpSocketBuilder(TEXT("IRRemoteControlListen"))
+			.AsNonBlocking()
+			.AsReusable()
+			.BoundToEndpoint(FIPv4Endpoint(FIPv4Address::InternalLoopback, static_cast<uint16>(Port)))
+			.Listening(8);
+		if (!ListenSocket)
+		{
+			UE_LOG(LogTemp, Error, TEXT("RemoteControl: failed to listen on 127.0.0.1:%d"), Port);
+			return false;
+		}
+
+		Thread = FRunnableThread::Create(this, TEXT("IRRemoteControl"), 0, TPri_BelowNormal);
+		if (!Thread)
+		{
+			Shutdown();
+			return false;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("RemoteControl: listening on http://127.0.0.1:%d/rpc"), Port);
+		return true;
+	}
+
+	void Shutdown()
+	{
+		bStopRequested = true;
+		if (Thread)
+		{
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+		if (ListenSocket)
+		{
+			ListenSocket->Close();
+			SocketSubsystem->DestroySocket(ListenSocket);
+			ListenSocket = nullptr;
+		}
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested)
+		{
+			AcceptConnections();
+
+			const double Now = FPlatformTime::Seconds();
+			for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+			{
+				FConnection& Connection = Connections[Index];
+				bool bKeep = true;
+				if (!Connection.bRequestReceived)
+				{
+					bKeep = ReadRequest(Connection) && Now - Connection.AcceptedSeconds < RequestTimeoutSeconds;
+				}
+				if (bKeep && Connection.Call.IsValid())
+				{
+					PumpCall(Connection);
+				}
+				bKeep = bKeep && Flush(Connection);
+				if (!bKeep || (Connection.bClosing && Connection.OutboxOffset >= Connection.Outbox.Num()))
+				{
+					CloseConnection(Connection);
+					Connections.RemoveAtSwap(Index);
+				}
+			}
+
+			FPlatformProcess::Sleep(0.005f);
+		}
+
+		for (FConnection& Connection : Connections)
+		{
+			CloseConnection(Connection);
+		}
+		Connections.Reset();
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested = true;
+	}
+
+private:
+	struct FConnection
+	{
+		FSocket* Socket = nullptr;
+		double AcceptedSeconds = 0.0;
+		TArray<uint8> Inbox;
+		bool bRequestReceived = false;
+		FScenarioRemoteCallPtr Call;
+		bool bHeadersSent = false;
+		TArray<uint8> Outbox;
+		int32 OutboxOffset = 0;
+		bool bClosing = false; // 写完 Outbox 后关闭
+	};
+
+	void AcceptConnections()
+	{
+		bool bPending = false;
+		while (ListenSocket->HasPendingConnection(bPending) && bPending)
+		{
+			FSocket* Socket = ListenSocket->Accept(TEXT("IRRemoteControlClient"));
+			if (!Socket)
+			{
+				break;
+			}
+			Socket->SetNonBlocking(true);
+
+			FConnection& Connection = Connections.AddDefaulted_GetRef();
+			Connection.Socket = Socket;
+			Connection.AcceptedSeconds = FPlatformTime::Seconds();
+		}
+	}
+
+	/** 读取并解析 HTTP 请求；连接出错时返回 false */
+	bool ReadRequest(FConnection& Connection)
+	{
+		uint8 Buffer[4096];
+		int32 BytesRead = 0;
+		if (!Connection.Socket->Recv(Buffer, sizeof(Buffer), BytesRead))
+		{
+			return false;
+		}
+		if (BytesRead > 0)
+		{
+			Connection.Inbox.Append(Buffer, BytesRead);
+		}
+
+		const int32 HeaderEnd = FindHeaderEnd(Connection.Inbox);
+		if (HeaderEnd == INDEX_NONE)
+		{
+			if (Connection.Inbox.Num() > MaxHeaderBytes)
+			{
+				RespondPlain(Connection, 431, TEXT("Request Header Fields Too Large"));
+			}
+			return true;
+		}
+
+		TArray<FString> HeaderLines;
+		Utf8ToString(Connection.Inbox.GetData(), HeaderEnd).ParseIntoArray(HeaderLines, TEXT("\r\n"));
+		TArray<FString> RequestLine;
+		if (HeaderLines.Num() > 0)
+		{
+			HeaderLines[0].ParseIntoArrayWS(RequestLine);
+		}
+		if (RequestLine.Num() < 2)
+		{
+			RespondPlain(Connection, 400, TEXT("Bad Request"));
+			return true;
+		}
+
+		int32 ContentLength = 0;
+		bool bAcceptNdjson = false;
+		for (int32 Index = 1; Index < HeaderLines.Num(); ++Index)
+		{
+			FString Name;
+			FString Value;
+			if (!HeaderLines[Index].Split(TEXT(":"), &Name, &Value))
+			{
+				continue;
+			}
+			Name.TrimStartAndEndInline();
+			Value.TrimStartAndEndInline();
+			if (Name.Equals(TEXT("Content-Length"), ESearchCase::IgnoreCase))
+			{
+				ContentLength = FCString::Atoi(*Value);
+			}
+			else if (Name.Equals(TEXT("Accept"), ESearchCase::IgnoreCase))
+			{
+				bAcceptNdjson = Value.Contains(TEXT("application/x-ndjson"));
+			}
+		}
+
+		if (ContentLength < 0 || ContentLength > MaxBodyBytes)
+		{
+			RespondPlain(Connection, 413, TEXT("Payload Too Large"));
+			return true;
+		}
+		const int32 BodyStart = HeaderEnd + 4;
+		if (Connection.Inbox.Num() < BodyStart + ContentLength)
+		{
+			return true; // 请求体尚未收齐
+		}
+
+		if (!RequestLine[0].Equals(TEXT("POST")))
+		{
+			RespondPlain(Connection, 405, TEXT("Method Not Allowed"));
+			return true;
+		}
+		if (RequestLine[1] != TEXT("/rpc") && RequestLine[1] != TEXT("/"))
+		{
+			RespondPlain(Connection, 404, TEXT("Not Found"));
+			return true;
+		}
+
+		HandleRpc(Connection, Utf8ToString(Connection.Inbox.GetData() + BodyStart, ContentLength), bAcceptNdjson);
+		return true;
+	}
+
+	/** JSON 在网络线程解析，游戏线程只执行调用 */
+	void HandleRpc(FConnection& Connection, const FString& Body, bool bAcceptNdjson)
+	{
+		Connection.bRequestReceived = true;
+		Connection.Inbox.Empty();
+
+		TSharedPtr<FJsonObject> Request;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+		if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid())
+		{
+			RespondJson(Connection, ToJsonLine(MakeRpcError(nullptr, RpcParseError, TEXT("Parse error"))));
+			return;
+		}
+
+		const TSharedPtr<FJsonValue> Id = Request->TryGetField(TEXT("id"));
+		FString Method;
+		if (!Request->TryGetStringField(TEXT("method"), Method) || Method.IsEmpty())
+		{
+			RespondJson(Connection, ToJsonLine(MakeRpcError(Id, RpcInvalidRequest, TEXT("Invalid Request: missing method"))));
+			return;
+		}
+
+		FScenarioRemoteCallPtr Call = MakeShared<FScenarioRemoteCall, ESPMode::ThreadSafe>();
+		Call->Method = Method;
+		Call->Id = Id;
+		const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+		Call->Params = Request->TryGetObjectField(TEXT("params"), ParamsObject) ? *ParamsObject : MakeShareable(new FJsonObject);
+		bool bStreamParam = false;
+		Call->bStream = bAcceptNdjson || (Call->Params->TryGetBoolField(TEXT("stream"), bStreamParam) && bStreamParam);
+
+		Connection.Call = Call;
+		Owner.Enqueue(Call);
+	}
+
+	/** 把游戏线程写入的行转成 HTTP 响应 */
+	void PumpCall(FConnection& Connection)
+	{
+		TArray<FString> NewLines;
+		const bool bDone = Connection.Call->TakeLines(NewLines);
+
+		if (Connection.Call->bStream)
+		{
+			if (!Connection.bHeadersSent)
+			{
+				AppendUtf8(Connection.Outbox, TEXT("HTTP/1.1 200 OK\r\nContent-Type: application/x-ndjson; charset=utf-8\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n"));
+				Connection.bHeadersSent = true;
+			}
+			for (const FString& Line : NewLines)
+			{
+				const FTCHARToUTF8 Utf8(*(Line + TEXT("\n")));
+				AppendUtf8(Connection.Outbox, FString::Printf(TEXT("%x\r\n"), Utf8.Length()));
+				Connection.Outbox.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+				AppendUtf8(Connection.Outbox, TEXT("\r\n"));
+			}
+			if (bDone)
+			{
+				AppendUtf8(Connection.Outbox, TEXT("0\r\n\r\n"));
+				Connection.bClosing = true;
+				Connection.Call.Reset();
+			}
+			return;
+		}
+
+		if (bDone)
+		{
+			RespondJson(Connection, FString::Join(NewLines, TEXT("\n")));
+			Connection.Call.Reset();
+		}
+	}
+
+	void RespondJson(FConnection& Connection, const FString& Body)
+	{
+		Respond(Connection, 200, TEXT("OK"), TEXT("application/json; charset=utf-8"), Body);
+	}
+
+	void RespondPlain(FConnection& Connection, int32 Status, const FString& Reason)
+	{
+		Connection.bRequestReceived = true;
+		Respond(Connection, Status, Reason, TEXT("text/plain; charset=utf-8"), Reason);
+	}
+
+	void Respond(FConnection& Connection, int32 Status, const FString& Reason, const FString& ContentType, const FString& Body)
+	{
+		const FTCHARToUTF8 Utf8(*Body);
+		AppendUtf8(Connection.Outbox, FString::Printf(TEXT("HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: close\r\n\r\n"),
+			Status, *Reason, *ContentType, Utf8.Length()));
+		Connection.Outbox.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		Connection.bClosing = true;
+	}
+
+	/** 非阻塞发送；连接出错时返回 false */
+	bool Flush(FConnection& Connection)
+	{
+		while (Connection.OutboxOffset < Connection.Outbox.Num())
+		{
+			int32 Sent = 0;
+			if (!Connection.Socket->Send(Connection.Outbox.GetData() + Connection.OutboxOffset, Connection.Outbox.Num() - Connection.OutboxOffset, Sent))
+			{
+				return SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK;
+			}
+			if (Sent <= 0)
+			{
+				return true;
+			}
+			Connection.OutboxOffset += Sent;
+		}
+
+		Connection.Outbox.Reset();
+		Connection.OutboxOffset = 0;
+		return true;
+	}
+
+	void CloseConnection(FConnection& Connection)
+	{
+		if (Connection.Socket)
+		{
+			Connection.Socket->Close();
+			SocketSubsystem->DestroySocket(Connection.Socket);
+			Connection.Socket = nullptr;
+		}
+	}
+
+	FScenarioRemoteControl& Owner;
+	int32 Port = 0;
+	ISocketSubsystem* SocketSubsystem = nullptr;
+	FSocket* ListenSocket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopRequested{ false };
+	TArray<FConnection> Connections; // 只在网络线程访问
+};
+
+// ---------------- FScenarioRemoteControl（游戏线程） ----------------
+
+bool FScenarioRemoteControl::IsRequested()
+{
+	return CVarRemoteEnable.GetValueOnGameThread() != 0 || FParse::Param(FCommandLine::Get(), TEXT("ScenarioRemote"));
+}
+
+FScenarioRemoteControl::FScenarioRemoteControl(UScenarioMenuSubsystem* InSubsystem)
+	: SubsystemWeak(InSubsystem)
+{
+}
+
+FScenarioRemoteControl::~FScenarioRemoteControl()
+{
+	Stop();
+}
+
+bool FScenarioRemoteControl::Start()
+{
+	int32 Port = CVarRemotePort.GetValueOnGameThread();
+	FParse::Value(FCommandLine::Get(), TEXT("ScenarioRemotePort="), Port);
+
+	Server = MakeUnique<FScenarioRemoteServer>(*this, Port);
+	if (!Server->Start())
+	{
+		Server.Reset();
+		return false;
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioRemoteControl::HandleTick));
+	return true;
+}
+
+void FScenarioRemoteControl::Stop()
+{
+	// 先停网络线程，之后不会再有新的调用入队
+	Server.Reset();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	ActiveCall.Reset();
+	Phase = EPhase::Idle;
+	PendingCalls.Reset();
+	Inbound.Empty();
+}
+
+void FScenarioRemoteControl::Enqueue(const FScenarioRemoteCallPtr& Call)
+{
+	Inbound.Enqueue(Call);
+}
+
+double FScenarioRemoteControl::GetWorldSeconds() const
+{
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	const UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+bool FScenarioRemoteControl::HandleTick(float DeltaTime)
+{
+	if (!SubsystemWeak.IsValid())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	FScenarioRemoteCallPtr Call;
+	while (Inbound.Dequeue(Call))
+	{
+		// 状态查询不排队，长时间调用执行期间也能轮询
+		if (Call->Method == TEXT("getStatus"))
+		{
+			Call->Succeed(BuildStatus());
+			continue;
+		}
+		PendingCalls.Add(Call);
+	}
+
+	if (ActiveCall.IsValid())
+	{
+		UpdateActiveCall();
+	}
+
+	while (!ActiveCall.IsValid() && PendingCalls.Num() > 0)
+	{
+		Call = PendingCalls[0];
+		PendingCalls.RemoveAt(0);
+		BeginCall(Call);
+	}
+	return true;
+}
+
+bool FScenarioRemoteControl::LoadConfigFromParams(const FScenarioRemoteCall& Call, FString& OutError)
+{
+	const TSharedPtr<FJsonObject>* ConfigObject = nullptr;
+	FString FilePath;
+	FScenarioTestConfig Loaded;
+	if (Call.Params->TryGetObjectField(TEXT("config"), ConfigObject))
+	{
+		if (!ScenarioConfigIO::ConfigFromJson(*ConfigObject, Loaded))
+		{
+			OutError = TEXT("config 字段无法解析");
+			return false;
+		}
+	}
+	else if (Call.Params->TryGetStringField(TEXT("file"), FilePath))
+	{
+		if (FPaths::IsRelative(FilePath))
+		{
+			FilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), FilePath);
+		}
+		if (!ScenarioConfigIO::LoadConfigFromFile(FilePath, Loaded))
+		{
+			OutError = FString::Printf(TEXT("无法读取场景文件 %s"), *FilePath);
+			return false;
+		}
+	}
+	else
+	{
+		OutError = TEXT("需要 config 或 file 参数");
+		return false;
+	}
+
+	// 远程运行不支持手动部署
+	Loaded.bBlueCustomDeployment = false;
+	Config = Loaded;
+	bHasConfig = true;
+	return true;
+}
+
+bool FScenarioRemoteControl::StartScenario(FString& OutError)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem || !bHasConfig)
+	{
+		OutError = TEXT("尚未载入配置（先调用 loadConfig）");
+		return false;
+	}
+
+	int32 Seed = 0;
+	if (ActiveCall->Params->TryGetNumberField(TEXT("seed"), Seed))
+	{
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+	}
+
+	// 同一地图时 StartScenarioWithConfig 会原地重新部署，否则重新加载关卡
+	Subsystem->StartScenarioWithConfig(Config);
+	return true;
+}
+
+void FScenarioRemoteControl::BeginCall(const FScenarioRemoteCallPtr& Call)
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	const FString& Method = Call->Method;
+	FString Error;
+
+	if (Method == TEXT("loadConfig"))
+	{
+		if (!LoadConfigFromParams(*Call, Error))
+		{
+			Call->Fail(RpcInvalidParams, Error);
+			return;
+		}
+		TSharedRef<FJsonObject> Result = MakeShareable(new FJsonObject);
+		Result->SetNumberField(TEXT("configHash"), FResultsHistoryStore::ComputeConfigHash(Config));
+		Result->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Config));
+		Call->Succeed(Result);
+		return;
+	}
+
+	if (Method == TEXT("getResults"))
+	{
+		if (!Subsystem->HasMissileTestData())
+		{
+			Call->Fail(RpcServerError, TEXT("没有测试数据"));
+			return;
+		}
+		Call->Succeed(BuildResults());
+		return;
+	}
+
+	if (Method == TEXT("complete"))
+	{
+		Subsystem->CompleteMissileTest();
+		if (!Subsystem->HasMissileTestData())
+		{
+			Call->Fail(RpcServerError, TEXT("本次测试没有发射记录"));
+			return;
+		}
+		Call->Succeed(BuildResults());
+		return;
+	}
+
+	const bool bStart = Method == TEXT("start");
+	const bool bFire = Method == TEXT("fire");
+	const bool bRun = Method == TEXT("run");
+	if (!bStart && !bFire && !bRun)
+	{
+		Call->Fail(RpcMethodNotFound, FString::Printf(TEXT("Method not found: %s"), *Method));
+		return;
+	}
+
+	ShotCount = 5;
+	Call->Params->TryGetNumberField(bRun ? TEXT("shots") : TEXT("count"), ShotCount);
+	MissileTimeoutSeconds = 180.f;
+	Call->Params->TryGetNumberField(TEXT("timeout"), MissileTimeoutSeconds);
+	MissileTimeoutSeconds = FMath::Max(10.f, MissileTimeoutSeconds);
+	bWaitForMissiles = true;
+	Call->Params->TryGetBoolField(TEXT("wait"), bWaitForMissiles);
+	bWaitForMissiles |= bRun;
+	bTimedOut = false;
+
+	if ((bFire || bRun) && (ShotCount < 1 || ShotCount > MaxShotsPerCall))
+	{
+		Call->Fail(RpcInvalidParams, FString::Printf(TEXT("发射数量需在 1-%d 之间"), MaxShotsPerCall));
+		return;
+	}
+	if (bRun && (Call->Params->HasField(TEXT("config")) || Call->Params->HasField(TEXT("file"))) && !LoadConfigFromParams(*Call, Error))
+	{
+		Call->Fail(RpcInvalidParams, Error);
+		return;
+	}
+	if ((bStart || bRun) && !bHasConfig)
+	{
+		Call->Fail(RpcInvalidParams, TEXT("尚未载入配置（先调用 loadConfig 或在 run 中传入 config/file）"));
+		return;
+	}
+	if (bFire && (Subsystem->bHasPendingScenarioConfig || Subsystem->GetActiveBlueUnitCount() == 0))
+	{
+		Call->Fail(RpcServerError, TEXT("场景尚未部署（先调用 start）"));
+		return;
+	}
+
+	ActiveCall = Call;
+	bFireAfterDeployment = bRun;
+	bCompleteAfterMissiles = bRun;
+	EnterPhase(bFire ? EPhase::Firing : EPhase::WaitingForWorld);
+	UpdateActiveCall();
+}
+
+void FScenarioRemoteControl::EnterPhase(EPhase NewPhase)
+{
+	Phase = NewPhase;
+	PhaseStartSeconds = NewPhase == EPhase::WaitingForMissiles ? GetWorldSeconds() : FPlatformTime::Seconds();
+	LastProgressSeconds = 0.0;
+
+	static const TCHAR* PhaseNames[] = { TEXT("idle"), TEXT("waitingForWorld"), TEXT("deploying"), TEXT("firing"), TEXT("waitingForMissiles") };
+	if (ActiveCall.IsValid())
+	{
+		TSharedRef<FJsonObject> Progress = BuildStatus();
+		Progress->SetStringField(TEXT("phase"), PhaseNames[static_cast<int32>(NewPhase)]);
+		ActiveCall->PostProgress(Progress);
+	}
+}
+
+void FScenarioRemoteControl::UpdateActiveCall()
+{
+	UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	UWorld* World = Subsystem ? Subsystem->GetWorld() : nullptr;
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	switch (Phase)
+	{
+	case EPhase::WaitingForWorld:
+		if (World && World->IsGameWorld() && World->HasBegunPlay())
+		{
+			FString Error;
+			if (!StartScenario(Error))
+			{
+				FailActiveCall(RpcServerError, Error);
+				return;
+			}
+			EnterPhase(EPhase::WaitingForDeployment);
+		}
+		break;
+
+	case EPhase::WaitingForDeployment:
+		if (NowSeconds - PhaseStartSeconds > DeploymentTimeoutSeconds)
+		{
+			FailActiveCall(RpcServerError, TEXT("地图加载或蓝方部署超时"));
+			return;
+		}
+		// OpenLevel 后 FinalizeScenarioAfterLoad 会清除待部署标记
+		if (!Subsystem->bHasPendingScenarioConfig && World && World->HasBegunPlay())
+		{
+			if (Subsystem->GetActiveBlueUnitCount() == 0)
+			{
+				FailActiveCall(RpcServerError, TEXT("未能部署任何蓝方单位（检查地图中的 BluePotentialDeployLocation 部署点）"));
+				return;
+			}
+			if (!bFireAfterDeployment)
+			{
+				FinishActiveCall();
+				return;
+			}
+			EnterPhase(EPhase::Firing);
+		}
+		break;
+
+	case EPhase::Firing:
+		Subsystem->BeginMissileAutoFire(ShotCount);
+		if (!bWaitForMissiles)
+		{
+			FinishActiveCall();
+			return;
+		}
+		EnterPhase(EPhase::WaitingForMissiles);
+		break;
+
+	case EPhase::WaitingForMissiles:
+	{
+		Subsystem->CleanupMissiles();
+		const bool bAllResolved = Subsystem->AutoFireRemaining <= 0
+			&& Subsystem->ActiveMissiles.Num() == 0
+			&& Subsystem->ActiveInterceptorMissiles.Num() == 0;
+		bTimedOut = !bAllResolved && GetWorldSeconds() - PhaseStartSeconds > MissileTimeoutSeconds;
+		if (bAllResolved || bTimedOut)
+		{
+			if (bCompleteAfterMissiles)
+			{
+				Subsystem->CompleteMissileTest();
+			}
+			FinishActiveCall();
+			return;
+		}
+		if (NowSeconds - LastProgressSeconds >= ProgressIntervalSeconds)
+		{
+			LastProgressSeconds = NowSeconds;
+			TSharedRef<FJsonObject> Progress = BuildStatus();
+			Progress->SetStringField(TEXT("phase"), TEXT("waitingForMissiles"));
+			ActiveCall->PostProgress(Progress);
+		}
+		break;
+	}
+
+	case EPhase::Idle:
+		break;
+	}
+}
+
+void FScenarioRemoteControl::FinishActiveCall()
+{
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	TSharedRef<FJsonObject> Result = bCompleteAfterMissiles && Subsystem && Subsystem->HasMissileTestData() ? BuildResults() : BuildStatus();
+	Result->SetBoolField(TEXT("timedOut"), bTimedOut);
+
+	ActiveCall->Succeed(Result);
+	ActiveCall.Reset();
+	Phase = EPhase::Idle;
+}
+
+void FScenarioRemoteControl::FailActiveCall(int32 Code, const FString& Message)
+{
+	ActiveCall->Fail(Code, Message);
+	ActiveCall.Reset();
+	Phase = EPhase::Idle;
+}
+
+TSharedRef<FJsonObject> FScenarioRemoteControl::BuildStatus() const
+{
+	TSharedRef<FJsonObject> Status = MakeShareable(new FJsonObject);
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		return Status;
+	}
+
+	const UWorld* World = Subsystem->GetWorld();
+	Status->SetBoolField(TEXT("busy"), ActiveCall.IsValid());
+	Status->SetNumberField(TEXT("queuedCalls"), PendingCalls.Num());
+	Status->SetBoolField(TEXT("configLoaded"), bHasConfig);
+	Status->SetStringField(TEXT("world"), World ? World->GetMapName() : FString());
+	Status->SetBoolField(TEXT("scenarioRunning"), Subsystem->bIsRunningScenario);
+	Status->SetBoolField(TEXT("deploymentPending"), Subsystem->bHasPendingScenarioConfig);
+	Status->SetNumberField(TEXT("blueUnits"), Subsystem->GetActiveBlueUnitCount());
+	Status->SetNumberField(TEXT("autoFireRemaining"), Subsystem->AutoFireRemaining);
+	Status->SetNumberField(TEXT("activeMissiles"), Subsystem->ActiveMissiles.Num());
+	Status->SetNumberField(TEXT("activeInterceptors"), Subsystem->ActiveInterceptorMissiles.Num());
+	Status->SetNumberField(TEXT("records"), Subsystem->MissileTestRecords.Num());
+	return Status;
+}
+
+TSharedRef<FJsonObject> FScenarioRemoteControl::BuildResults() const
+{
+	TSharedRef<FJsonObject> Result = MakeShareable(new FJsonObject);
+	const UScenarioMenuSubsystem* Subsystem = SubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		return Result;
+	}
+
+	// 字段与无界面运行的结果文件一致
+	TArray<FIndicatorEvaluationResult> Evaluations;
+	Subsystem->BuildIndicatorEvaluations(Evaluations);
+
+	bool bPass = true;
+	TArray<TSharedPtr<FJsonValue>> EvaluationArray;
+	for (const FIndicatorEvaluationResult& Evaluation : Evaluations)
+	{
+		bPass &= !Evaluation.bHasData || Evaluation.bPass;
+		EvaluationArray.Add(MakeShareable(new FJsonValueObject(ScenarioConfigIO::EvaluationToJson(Evaluation))));
+	}
+
+	Result->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Subsystem->GetActiveScenarioConfig()));
+	Result->SetObjectField(TEXT("summary"), ScenarioConfigIO::SummaryToJson(Subsystem->GetMissileTestSummary()));
+	Result->SetArrayField(TEXT("evaluations"), EvaluationArray);
+	Result->SetBoolField(TEXT("pass"), bPass);
+	return Result;
+}
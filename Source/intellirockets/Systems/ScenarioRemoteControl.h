@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "UI/SScenarioScreen.h"
+
+class UScenarioMenuSubsystem;
+class FJsonObject;
+class FJsonValue;
+class FScenarioRemoteServer;
+
+/**
+ * 一次远程调用：由网络线程解析后交给游戏线程执行，游戏线程写入进度与结果，网络线程读取后发送。
+ * 进度与结果都以完整的 JSON-RPC 文本行保存，两个线程之间只交换字符串。
+ */
+class FScenarioRemoteCall
+{
+public:
+	FString Method;
+	TSharedPtr<FJsonObject> Params;
+	TSharedPtr<FJsonValue> Id;
+	bool bStream = false; // 流式调用：进度通知逐行推送（NDJSON，分块传输）
+
+	/** 游戏线程：推送进度通知（非流式调用忽略） */
+	void PostProgress(const TSharedRef<FJsonObject>& Progress);
+	/** 游戏线程：完成调用 */
+	void Succeed(const TSharedRef<FJsonObject>& Result);
+	void Fail(int32 Code, const FString& Message);
+
+	/** 网络线程：取出待发送的行，返回调用是否已完成 */
+	bool TakeLines(TArray<FString>& OutLines);
+	bool IsDone() const;
+
+private:
+	void Finish(const TSharedRef<FJsonObject>& Response);
+
+	mutable FCriticalSection Lock;
+	TArray<FString> Lines;
+	bool bDone = false;
+};
+
+using FScenarioRemoteCallPtr = TSharedPtr<FScenarioRemoteCall, ESPMode::ThreadSafe>;
+
+/**
+ * 本机远程控制接口（-ScenarioRemote 或 ir.Remote.Enable=1 启动时开启）：
+ * 在 127.0.0.1:ir.Remote.Port 上接受 HTTP POST /rpc 的 JSON-RPC 2.0 请求，测试脚本无需操作向导即可批量运行配置。
+ *
+ * 方法：
+ *   getStatus                             当前阶段、部署单位、在飞导弹与记录数量
+ *   loadConfig {config | file}            载入 FScenarioTestConfig（JSON 与场景文件格式相同）
+ *   start      {seed?}                    加载地图并部署，部署完成后返回
+ *   fire       {count, wait?, timeout?}   自动发射 N 枚导弹，默认等待全部结算后返回；wait 为 false 时发射后立即返回
+ *   complete                              结束测试并返回汇总与指标评估
+ *   getResults                            最近一次测试的汇总与指标评估
+ *   run        {config | file, shots, seed?, timeout?}  载入 -> 部署 -> 发射 -> 等待 -> 结算，一次完成
+ * params.stream 为 true（或请求头 Accept 含 application/x-ndjson）时以分块传输逐行返回
+ * {"method":"progress"} 通知，最后一行为调用结果。
+ *
+ * 网络线程负责收发与 JSON 解析，调用按顺序在游戏线程的 Ticker 中执行；
+ * 耗时的调用（部署、等待导弹）跨帧推进，执行期间新的调用排队等待，getStatus 立即返回。
+ */
+class FScenarioRemoteControl
+{
+public:
+	/** ir.Remote.Enable 或命令行 -ScenarioRemote */
+	static bool IsRequested();
+
+	explicit FScenarioRemoteControl(UScenarioMenuSubsystem* InSubsystem);
+	~FScenarioRemoteControl();
+
+	bool Start();
+	void Stop();
+
+	/** 网络线程调用（单生产者） */
+	void Enqueue(const FScenarioRemoteCallPtr& Call);
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		WaitingForWorld,
+		WaitingForDeployment,
+		Firing,
+		WaitingForMissiles,
+	};
+
+	bool HandleTick(float DeltaTime);
+	/** 开始执行一个调用；需要跨帧的调用设置 ActiveCall 与阶段后返回 */
+	void BeginCall(const FScenarioRemoteCallPtr& Call);
+	void UpdateActiveCall();
+	void FinishActiveCall();
+	void FailActiveCall(int32 Code, const FString& Message);
+	void EnterPhase(EPhase NewPhase);
+
+	bool LoadConfigFromParams(const FScenarioRemoteCall& Call, FString& OutError);
+	bool StartScenario(FString& OutError);
+	TSharedRef<FJsonObject> BuildStatus() const;
+	TSharedRef<FJsonObject> BuildResults() const;
+	double GetWorldSeconds() const;
+
+	TWeakObjectPtr<UScenarioMenuSubsystem> SubsystemWeak;
+	TUniquePtr<FScenarioRemoteServer> Server;
+	FTSTicker::FDelegateHandle TickerHandle;
+	TQueue<FScenarioRemoteCallPtr, EQueueMode::Spsc> Inbound;
+	TArray<FScenarioRemoteCallPtr> PendingCalls;
+
+	FScenarioTestConfig Config;
+	bool bHasConfig = false;
+
+	// 当前跨帧执行的调用
+	FScenarioRemoteCallPtr ActiveCall;
+	EPhase Phase = EPhase::Idle;
+	double PhaseStartSeconds = 0.0;
+	double LastProgressSeconds = 0.0;
+	int32 ShotCount = 0;
+	float MissileTimeoutSeconds = 180.f;
+	bool bFireAfterDeployment = false;
+	bool bWaitForMissiles = true;
+	bool bCompleteAfterMissiles = false;
+	bool bTimedOut = false;
+};
@@ -0,0 +1,779 @@
+#include "Systems/ScenarioReplay.h"
+
+#include "Actors/MockMissileActor.h"
+#include "Actors/RadarJammerActor.h"
+#include "Systems/MissileTelemetryRecorder.h"
+#include "Systems/ScenarioAssetPreloader.h"
+#include "Algo/BinarySearch.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/Paths.h"
+#include "UObject/SoftObjectPath.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarReplayRecord(
+		TEXT("ir.Replay.Record"),
+		0,
+		TEXT("1: 记录会话回放（部署、干扰器、导弹关键帧与事件），测试结束后保存到 Saved/Replays"));
+
+	TAutoConsoleVariable<float> CVarReplayKeyframeRate(
+		TEXT("ir.Replay.KeyframeRate"),
+		10.f,
+		TEXT("会话回放采样导弹关键帧的频率（Hz），与遥测采样相互独立"));
+
+	TAutoConsoleVariable<float> CVarReplayKeyframeError(
+		TEXT("ir.Replay.KeyframeError"),
+		50.f,
+		TEXT("合并回放关键帧时允许的位置误差（厘米）；0 表示保留全部关键帧"));
+
+	constexpr int32 MaxMergedKeyframes = 256; // 单段合并的采样点上限，限制逐点校验的开销
+
+	constexpr uint32 ReplayFileMagic = 0x50525249; // "IRRP"
+	constexpr uint32 ReplayFileVersion = 1;
+
+	constexpr float MaxPlaybackSpeed = 64.f;
+	constexpr int32 ReplayStatusMessageKey = 0x52504C59;
+
+	// 与 AMockMissileActor::SetupAppearance 的网格体相对变换一致
+	const FTransform MissileMeshOffset(FRotator(0.f, 90.f, 0.f), FVector::ZeroVector, FVector(0.55f));
+
+	FString GetReplayDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Replays");
+	}
+
+	bool SerializeCount(FArchive& Ar, int32& Count)
+	{
+		Ar << Count;
+		if (Ar.IsLoading() && (Count < 0 || Ar.IsError()))
+		{
+			Ar.SetError();
+			return false;
+		}
+		return true;
+	}
+
+	FTransform MakeHiddenTransform(const FVector& Location)
+	{
+		return FTransform(FQuat::Identity, Location, FVector::ZeroVector);
+	}
+}
+
+bool FScenarioReplayTrack::Evaluate(float Seconds, FVector& OutLocation, FRotator& OutRotation) const
+{
+	if (!IsActiveAt(Seconds))
+	{
+		return false;
+	}
+
+	const int32 Count = Time.Num();
+	if (Count == 1)
+	{
+		OutLocation = FVector(Position[0]);
+		OutRotation = FRotator::ZeroRotator;
+		return true;
+	}
+
+	// 第一个时间大于 Seconds 的关键帧；到达末尾时沿用最后一段
+	const int32 Next = FMath::Clamp(Algo::UpperBound(Time, Seconds), 1, Count - 1);
+	const int32 Prev = Next - 1;
+	const float Span = Time[Next] - Time[Prev];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((Seconds - Time[Prev]) / Span, 0.f, 1.f) : 1.f;
+
+	OutLocation = FVector(FMath::Lerp(Position[Prev], Position[Next], Alpha));
+	const FVector Direction(Position[Next] - Position[Prev]);
+	OutRotation = Direction.IsNearlyZero() ? FRotator::ZeroRotator : Direction.Rotation();
+	return true;
+}
+
+void FScenarioReplayData::Serialize(FArchive& Ar)
+{
+	// 文件头：魔数、版本、地图、记录时间、时长；随后依次为单位、干扰器、轨迹（各列整块）、事件
+	uint32 Magic = ReplayFileMagic;
+	uint32 Version = ReplayFileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != ReplayFileMagic || Version != ReplayFileVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+	Ar << MapName << RecordedAt << Duration;
+
+	int32 UnitCount = Units.Num();
+	if (!SerializeCount(Ar, UnitCount))
+	{
+		return;
+	}
+	Units.SetNum(UnitCount);
+	for (FScenarioReplayUnit& Unit : Units)
+	{
+		Ar << Unit.Name << Unit.MeshPath << Unit.MaterialPath << Unit.Location << Unit.Rotation << Unit.Scale << Unit.SpawnTime;
+	}
+
+	int32 JammerCount = Jammers.Num();
+	if (!SerializeCount(Ar, JammerCount))
+	{
+		return;
+	}
+	Jammers.SetNum(JammerCount);
+	for (FScenarioReplayJammer& Jammer : Jammers)
+	{
+		Ar << Jammer.Location << Jammer.Radius << Jammer.SpawnTime;
+	}
+
+	int32 TrackCount = Tracks.Num();
+	if (!SerializeCount(Ar, TrackCount))
+	{
+		return;
+	}
+	Tracks.SetNum(TrackCount);
+	for (FScenarioReplayTrack& Track : Tracks)
+	{
+		uint8 Flags = Track.bInterceptor ? 1 : 0;
+		Ar << Track.MissileId << Track.Name << Flags;
+		Track.bInterceptor = (Flags & 1) != 0;
+		Track.Time.BulkSerialize(Ar);
+		Track.Position.BulkSerialize(Ar);
+		Track.State.BulkSerialize(Ar);
+		if (Ar.IsLoading() && (Track.Position.Num() != Track.Time.Num() || Track.State.Num() != Track.Time.Num()))
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+
+	int32 EventCount = Events.Num();
+	if (!SerializeCount(Ar, EventCount))
+	{
+		return;
+	}
+	Events.SetNum(EventCount);
+	for (FScenarioReplayEventRecord& Event : Events)
+	{
+		uint8 Type = static_cast<uint8>(Event.Type);
+		Ar << Event.Time << Type << Event.Subject << Event.Location;
+		Event.Type = static_cast<EScenarioReplayEvent>(Type);
+	}
+}
+
+bool FScenarioReplayData::SaveToFile(const FString& FilePath) const
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: 无法创建文件 %s"), *FilePath);
+		return false;
+	}
+
+	const_cast<FScenarioReplayData*>(this)->Serialize(*Ar);
+	return Ar->Close() && !Ar->IsError();
+}
+
+bool FScenarioReplayData::LoadFromFile(const FString& FilePath)
+{
+	*this = FScenarioReplayData();
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: 无法打开文件 %s"), *FilePath);
+		return false;
+	}
+
+	Serialize(*Ar);
+	if (Ar->IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: 文件格式或版本不匹配 %s"), *FilePath);
+		*this = FScenarioReplayData();
+		return false;
+	}
+
+	// 事件已按时间顺序写出；摧毁时间展开到单位上，播放时无需扫描事件
+	for (const FScenarioReplayEventRecord& Event : Events)
+	{
+		if (Event.Type == EScenarioReplayEvent::BlueUnitDestroyed && Units.IsValidIndex(Event.Subject) && Units[Event.Subject].DestroyedTime < 0.f)
+		{
+			Units[Event.Subject].DestroyedTime = Event.Time;
+		}
+	}
+	return true;
+}
+
+FScenarioReplayRecorder::~FScenarioReplayRecorder()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FScenarioReplayRecorder::IsEnabled()
+{
+	return CVarReplayRecord.GetValueOnGameThread() > 0;
+}
+
+float FScenarioReplayRecorder::GetKeyframeRate()
+{
+	return IsEnabled() ? FMath::Max(0.f, CVarReplayKeyframeRate.GetValueOnGameThread()) : 0.f;
+}
+
+void FScenarioReplayRecorder::Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles)
+{
+	Reset();
+	if (!World || !IsEnabled())
+	{
+		return;
+	}
+
+	WorldWeak = World;
+	StartWorldSeconds = World->GetTimeSeconds();
+	Data.MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+
+	CollectMissiles = MoveTemp(InCollectMissiles);
+	if (CollectMissiles)
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioReplayRecorder::HandleTick));
+	}
+}
+
+void FScenarioReplayRecorder::Reset()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Data = FScenarioReplayData();
+	UnitLookup.Reset();
+	TrackLookup.Reset();
+	CollectMissiles = nullptr;
+	WorldWeak = nullptr;
+	StartWorldSeconds = 0.0;
+	LastKeyframeWorldSeconds = -1.0;
+}
+
+float FScenarioReplayRecorder::GetSeconds() const
+{
+	const UWorld* World = WorldWeak.Get();
+	return World ? static_cast<float>(World->GetTimeSeconds() - StartWorldSeconds) : 0.f;
+}
+
+bool FScenarioReplayRecorder::HandleTick(float DeltaTime)
+{
+	UWorld* World = WorldWeak.Get();
+	const float KeyframeRate = GetKeyframeRate();
+	if (!World || KeyframeRate <= 0.f)
+	{
+		return true;
+	}
+
+	// 按世界时间采样，与遥测一致
+	const double WorldSeconds = World->GetTimeSeconds();
+	if (LastKeyframeWorldSeconds >= 0.0 && WorldSeconds - LastKeyframeWorldSeconds < 1.0 / KeyframeRate)
+	{
+		return true;
+	}
+	LastKeyframeWorldSeconds = WorldSeconds;
+
+	TArray<AMockMissileActor*> Missiles;
+	CollectMissiles(Missiles);
+
+	const float Seconds = static_cast<float>(WorldSeconds - StartWorldSeconds);
+	const float ErrorBound = FMath::Max(0.f, CVarReplayKeyframeError.GetValueOnGameThread());
+	TMap<TObjectKey<AMockMissileActor>, FActiveTrack> SeenTracks;
+	SeenTracks.Reserve(Missiles.Num());
+	for (AMockMissileActor* Missile : Missiles)
+	{
+		if (!Missile || Missile->IsPendingKillPending())
+		{
+			continue;
+		}
+
+		const TObjectKey<AMockMissileActor> MissileKey(Missile);
+		FActiveTrack Active;
+		if (FActiveTrack* Found = TrackLookup.Find(MissileKey))
+		{
+			Active = MoveTemp(*Found);
+		}
+		else
+		{
+			FScenarioReplayTrack& NewTrack = Data.Tracks.AddDefaulted_GetRef();
+			NewTrack.MissileId = Missile->GetSessionSerial();
+			NewTrack.Name = Missile->GetName();
+			NewTrack.bInterceptor = Missile->IsInterceptor();
+			Active.TrackIndex = Data.Tracks.Num() - 1;
+		}
+
+		FMissileTelemetrySample Sample;
+		Missile->GetTelemetrySample(Sample);
+		AppendKeyframe(Data.Tracks[Active.TrackIndex], Active, Seconds, FVector3f(Sample.Location), static_cast<uint8>(Sample.State), ErrorBound);
+		SeenTracks.Add(MissileKey, MoveTemp(Active));
+	}
+
+	// 本次未出现的导弹轨迹已结束，不再续写
+	TrackLookup = MoveTemp(SeenTracks);
+	return true;
+}
+
+void FScenarioReplayRecorder::AppendKeyframe(FScenarioReplayTrack& Track, FActiveTrack& Active, float Seconds, const FVector3f& Position, uint8 State, float ErrorBound) const
+{
+	// 锚点、末帧与新帧状态相同时尝试用新帧替换末帧：自锚点以来被合并掉的所有采样点与末帧
+	// 都必须落在锚点到新帧的弦（按时间插值）的误差范围内，否则长弧会被逐步拉成一条弦
+	const int32 Num = Track.Time.Num();
+	if (ErrorBound > 0.f && Num >= 2 && Track.State[Num - 1] == State && Track.State[Num - 2] == State
+		&& Active.MergedTime.Num() < MaxMergedKeyframes)
+	{
+		const float AnchorSeconds = Track.Time[Num - 2];
+		const FVector3f& AnchorPosition = Track.Position[Num - 2];
+		const float SpanSeconds = Seconds - AnchorSeconds;
+		if (SpanSeconds > UE_SMALL_NUMBER)
+		{
+			const float ErrorBoundSq = FMath::Square(ErrorBound);
+			auto IsOnChord = [&](float PointSeconds, const FVector3f& PointPosition)
+			{
+				const float Alpha = (PointSeconds - AnchorSeconds) / SpanSeconds;
+				return FVector3f::DistSquared(FMath::Lerp(AnchorPosition, Position, Alpha), PointPosition) <= ErrorBoundSq;
+			};
+
+			bool bWithinError = IsOnChord(Track.Time[Num - 1], Track.Position[Num - 1]);
+			for (int32 Index = 0; bWithinError && Index < Active.MergedTime.Num(); ++Index)
+			{
+				bWithinError = IsOnChord(Active.MergedTime[Index], Active.MergedPosition[Index]);
+			}
+
+			if (bWithinError)
+			{
+				Active.MergedTime.Add(Track.Time[Num - 1]);
+				Active.MergedPosition.Add(Track.Position[Num - 1]);
+				Track.Time[Num - 1] = Seconds;
+				Track.Position[Num - 1] = Position;
+				return;
+			}
+		}
+	}
+
+	// 末帧保留下来成为新的锚点，重新开始一段合并
+	Active.MergedTime.Reset();
+	Active.MergedPosition.Reset();
+	Track.Time.Add(Seconds);
+	Track.Position.Add(Position);
+	Track.State.Add(State);
+}
+
+void FScenarioReplayRecorder::AddBlueUnit(const FString& Name, const FTransform& Transform, const UStaticMesh* Mesh, const UMaterialInterface* Material)
+{
+	if (!IsRecording() || !Mesh)
+	{
+		return;
+	}
+
+	FScenarioReplayUnit& Unit = Data.Units.AddDefaulted_GetRef();
+	Unit.Name = Name;
+	Unit.MeshPath = FSoftObjectPath(Mesh).ToString();
+	Unit.MaterialPath = Material ? FSoftObjectPath(Material).ToString() : FString();
+	Unit.Location = FVector3f(Transform.GetLocation());
+	Unit.Rotation = FQuat4f(Transform.GetRotation());
+	Unit.Scale = FVector3f(Transform.GetScale3D());
+	Unit.SpawnTime = GetSeconds();
+	UnitLookup.Add(Name, Data.Units.Num() - 1);
+}
+
+void FScenarioReplayRecorder::AddJammer(const FVector& Location, float Radius)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FScenarioReplayJammer& Jammer = Data.Jammers.AddDefaulted_GetRef();
+	Jammer.Location = FVector3f(Location);
+	Jammer.Radius = Radius;
+	Jammer.SpawnTime = GetSeconds();
+	AddEvent(EScenarioReplayEvent::JammerActivated, Data.Jammers.Num() - 1, Location);
+}
+
+void FScenarioReplayRecorder::AddEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FScenarioReplayEventRecord& Event = Data.Events.AddDefaulted_GetRef();
+	Event.Time = GetSeconds();
+	Event.Type = Type;
+	Event.Subject = Subject;
+	Event.Location = FVector3f(Location);
+}
+
+void FScenarioReplayRecorder::NoteBlueUnitDestroyed(const FString& Name, const FVector& Location)
+{
+	if (const int32* UnitIndex = UnitLookup.Find(Name))
+	{
+		AddEvent(EScenarioReplayEvent::BlueUnitDestroyed, *UnitIndex, Location);
+	}
+}
+
+FString FScenarioReplayRecorder::SaveToReplayDir() const
+{
+	if (!IsRecording() || (Data.Units.Num() == 0 && Data.Tracks.Num() == 0))
+	{
+		return FString();
+	}
+
+	FScenarioReplayData Replay = Data;
+	Replay.RecordedAt = FDateTime::Now().ToString();
+	Replay.Duration = GetSeconds();
+	for (const FScenarioReplayTrack& Track : Replay.Tracks)
+	{
+		if (Track.Time.Num() > 0)
+		{
+			Replay.Duration = FMath::Max(Replay.Duration, Track.Time.Last());
+		}
+	}
+
+	const FString FilePath = GetReplayDir() / FString::Printf(TEXT("Session_%s.irrp"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	if (!Replay.SaveToFile(FilePath))
+	{
+		return FString();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ScenarioReplay: 已保存 %.1f 秒会话（单位 %d、干扰器 %d、轨迹 %d、事件 %d）到 %s"),
+		Replay.Duration, Replay.Units.Num(), Replay.Jammers.Num(), Replay.Tracks.Num(), Replay.Events.Num(), *FilePath);
+	return FilePath;
+}
+
+FScenarioReplayPlayer::~FScenarioReplayPlayer()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+FString FScenarioReplayPlayer::FindLatestReplayFile()
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(GetReplayDir() / TEXT("*.irrp")), /*Files*/ true, /*Directories*/ false);
+
+	FString Latest;
+	FDateTime LatestStamp = FDateTime::MinValue();
+	for (const FString& File : Files)
+	{
+		const FString FilePath = GetReplayDir() / File;
+		const FDateTime Stamp = IFileManager::Get().GetTimeStamp(*FilePath);
+		if (Stamp > LatestStamp)
+		{
+			LatestStamp = Stamp;
+			Latest = FilePath;
+		}
+	}
+	return Latest;
+}
+
+bool FScenarioReplayPlayer::Open(UWorld* World, const FString& FilePath)
+{
+	Close();
+	if (!World)
+	{
+		return false;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	if (!Data.LoadFromFile(FilePath))
+	{
+		return false;
+	}
+
+	const FString CurrentMap = UWorld::RemovePIEPrefix(World->GetMapName());
+	if (!Data.MapName.IsEmpty() && Data.MapName != CurrentMap)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: 回放录制于地图 %s，当前地图为 %s"), *Data.MapName, *CurrentMap);
+	}
+
+	SpawnProxies(World);
+	CurrentTime = 0.f;
+	Speed = 1.f;
+	bPaused = false;
+	ApplyTime(CurrentTime);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FScenarioReplayPlayer::HandleTick));
+
+	UE_LOG(LogTemp, Log, TEXT("ScenarioReplay: 已打开 %s（%.1f 秒，单位 %d、干扰器 %d、轨迹 %d、事件 %d），耗时 %.1f ms"),
+		*FilePath, Data.Duration, Data.Units.Num(), Data.Jammers.Num(), Data.Tracks.Num(), Data.Events.Num(),
+		(FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return true;
+}
+
+void FScenarioReplayPlayer::Close()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	for (const TWeakObjectPtr<ARadarJammerActor>& Jammer : JammerProxies)
+	{
+		if (ARadarJammerActor* JammerActor = Jammer.Get())
+		{
+			JammerActor->Destroy();
+		}
+	}
+	if (AActor* Proxy = ProxyActor.Get())
+	{
+		Proxy->Destroy();
+	}
+
+	ProxyActor = nullptr;
+	JammerProxies.Reset();
+	UnitBatches.Reset();
+	UnitVisible.Reset();
+	MissileComponent = nullptr;
+	InterceptorComponent = nullptr;
+	MissileTracks.Reset();
+	InterceptorTracks.Reset();
+	TransformScratch.Reset();
+	Data = FScenarioReplayData();
+	CurrentTime = 0.f;
+
+	if (GEngine)
+	{
+		GEngine->RemoveOnScreenDebugMessage(ReplayStatusMessageKey);
+	}
+}
+
+void FScenarioReplayPlayer::SetSpeed(float InSpeed)
+{
+	// 负值倒放
+	Speed = FMath::Clamp(InSpeed, -MaxPlaybackSpeed, MaxPlaybackSpeed);
+}
+
+void FScenarioReplayPlayer::Seek(float Seconds)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	CurrentTime = FMath::Clamp(Seconds, 0.f, Data.Duration);
+	ApplyTime(CurrentTime);
+}
+
+void FScenarioReplayPlayer::SpawnProxies(UWorld* World)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* Proxy = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!Proxy)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: failed to spawn proxy actor"));
+		return;
+	}
+
+	USceneComponent* Root = NewObject<USceneComponent>(Proxy, TEXT("Root"));
+	Proxy->SetRootComponent(Root);
+	Root->RegisterComponent();
+	Proxy->AddInstanceComponent(Root);
+	ProxyActor = Proxy;
+
+	auto CreateComponent = [Proxy](UStaticMesh* Mesh, UMaterialInterface* Material)
+	{
+		UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(Proxy);
+		Component->SetMobility(EComponentMobility::Movable);
+		Component->SetStaticMesh(Mesh);
+		if (Material)
+		{
+			Component->SetMaterial(0, Material);
+		}
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetupAttachment(Proxy->GetRootComponent());
+		Component->RegisterComponent();
+		Proxy->AddInstanceComponent(Component);
+		return Component;
+	};
+
+	// 蓝方单位：每种网格体/材质组合一个实例化组件
+	TMap<FString, int32> BatchLookup;
+	UnitVisible.Init(false, Data.Units.Num());
+	for (int32 UnitIndex = 0; UnitIndex < Data.Units.Num(); ++UnitIndex)
+	{
+		const FScenarioReplayUnit& Unit = Data.Units[UnitIndex];
+		const FString Key = Unit.MeshPath + TEXT("|") + Unit.MaterialPath;
+		int32 BatchIndex = INDEX_NONE;
+		if (const int32* Found = BatchLookup.Find(Key))
+		{
+			BatchIndex = *Found;
+		}
+		else
+		{
+			UStaticMesh* Mesh = ScenarioAssets::ResolveOrLoad<UStaticMesh>(FSoftObjectPath(Unit.MeshPath));
+			if (!Mesh)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: 无法加载单位网格体 %s"), *Unit.MeshPath);
+				continue;
+			}
+			UMaterialInterface* Material = Unit.MaterialPath.IsEmpty() ? nullptr : ScenarioAssets::ResolveOrLoad<UMaterialInterface>(FSoftObjectPath(Unit.MaterialPath));
+			BatchIndex = UnitBatches.Num();
+			UnitBatches.AddDefaulted_GetRef().Component = CreateComponent(Mesh, Material);
+			BatchLookup.Add(Key, BatchIndex);
+		}
+
+		FUnitBatch& Batch = UnitBatches[BatchIndex];
+		Batch.Component->AddInstance(MakeHiddenTransform(FVector(Unit.Location)), /*bWorldSpace*/ true);
+		Batch.Units.Add(UnitIndex);
+	}
+
+	// 导弹与拦截弹：按阵营各一个实例化组件，颜色与实际导弹一致
+	UStaticMesh* MissileMesh = ScenarioAssets::ResolveOrLoad<UStaticMesh>(ScenarioAssets::GetMissileMeshPath());
+	UMaterialInterface* MissileMaterial = ScenarioAssets::ResolveOrLoad<UMaterialInterface>(ScenarioAssets::GetMissileMaterialPath());
+	if (MissileMesh)
+	{
+		auto CreateMissileComponent = [&CreateComponent, MissileMesh, MissileMaterial, Proxy](const FLinearColor& TintColor)
+		{
+			UMaterialInstanceDynamic* Tinted = MissileMaterial ? UMaterialInstanceDynamic::Create(MissileMaterial, Proxy) : nullptr;
+			if (Tinted)
+			{
+				Tinted->SetVectorParameterValue(TEXT("Color"), TintColor);
+			}
+			return CreateComponent(MissileMesh, Tinted ? Tinted : MissileMaterial);
+		};
+
+		UInstancedStaticMeshComponent* Missiles = CreateMissileComponent(FLinearColor(1.f, 0.1f, 0.1f));
+		UInstancedStaticMeshComponent* Interceptors = CreateMissileComponent(FLinearColor(0.1f, 0.4f, 1.f));
+		for (int32 TrackIndex = 0; TrackIndex < Data.Tracks.Num(); ++TrackIndex)
+		{
+			const FScenarioReplayTrack& Track = Data.Tracks[TrackIndex];
+			UInstancedStaticMeshComponent* Component = Track.bInterceptor ? Interceptors : Missiles;
+			Component->AddInstance(MakeHiddenTransform(Track.Position.Num() > 0 ? FVector(Track.Position[0]) : FVector::ZeroVector), /*bWorldSpace*/ true);
+			(Track.bInterceptor ? InterceptorTracks : MissileTracks).Add(TrackIndex);
+		}
+		MissileComponent = Missiles;
+		InterceptorComponent = Interceptors;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScenarioReplay: failed to load missile mesh, tracks will not be shown"));
+	}
+
+	// 干扰器：沿用干扰区域半球的外观，只设置基础半径
+	for (const FScenarioReplayJammer& Jammer : Data.Jammers)
+	{
+		if (ARadarJammerActor* JammerProxy = World->SpawnActor<ARadarJammerActor>(FVector(Jammer.Location), FRotator::ZeroRotator, SpawnParams))
+		{
+			JammerProxy->SetJammerRadius(Jammer.Radius);
+			JammerProxy->SetActorHiddenInGame(true);
+			JammerProxies.Add(JammerProxy);
+		}
+	}
+}
+
+void FScenarioReplayPlayer::ApplyTime(float Seconds)
+{
+	for (FUnitBatch& Batch : UnitBatches)
+	{
+		UInstancedStaticMeshComponent* Component = Batch.Component.Get();
+		if (!Component)
+		{
+			continue;
+		}
+
+		// 单位只在出现/摧毁时更新
+		bool bChanged = false;
+		for (int32 InstanceIndex = 0; InstanceIndex < Batch.Units.Num(); ++InstanceIndex)
+		{
+			const int32 UnitIndex = Batch.Units[InstanceIndex];
+			const FScenarioReplayUnit& Unit = Data.Units[UnitIndex];
+			const bool bVisible = Seconds >= Unit.SpawnTime && (Unit.DestroyedTime < 0.f || Seconds < Unit.DestroyedTime);
+			if (UnitVisible[UnitIndex] == bVisible)
+			{
+				continue;
+			}
+
+			UnitVisible[UnitIndex] = bVisible;
+			const FTransform Transform = bVisible ? FTransform(FQuat(Unit.Rotation), FVector(Unit.Location), FVector(Unit.Scale)) : MakeHiddenTransform(FVector(Unit.Location));
+			Component->UpdateInstanceTransform(InstanceIndex, Transform, /*bWorldSpace*/ true, /*bMarkRenderStateDirty*/ false, /*bTeleport*/ true);
+			bChanged = true;
+		}
+		if (bChanged)
+		{
+			Component->MarkRenderStateDirty();
+		}
+	}
+
+	auto UpdateTracks = [this, Seconds](UInstancedStaticMeshComponent* Component, const TArray<int32>& TrackIndices)
+	{
+		if (!Component || TrackIndices.Num() == 0)
+		{
+			return;
+		}
+
+		TransformScratch.Reset(TrackIndices.Num());
+		for (const int32 TrackIndex : TrackIndices)
+		{
+			const FScenarioReplayTrack& Track = Data.Tracks[TrackIndex];
+			FVector Location;
+			FRotator Rotation;
+			if (Track.Evaluate(Seconds, Location, Rotation))
+			{
+				TransformScratch.Add(MissileMeshOffset * FTransform(Rotation, Location));
+			}
+			else
+			{
+				TransformScratch.Add(MakeHiddenTransform(Track.Position.Num() > 0 ? FVector(Track.Position[0]) : FVector::ZeroVector));
+			}
+		}
+		Component->BatchUpdateInstancesTransforms(0, TransformScratch, /*bWorldSpace*/ true, /*bMarkRenderStateDirty*/ true, /*bTeleport*/ true);
+	};
+	UpdateTracks(MissileComponent.Get(), MissileTracks);
+	UpdateTracks(InterceptorComponent.Get(), InterceptorTracks);
+
+	for (int32 JammerIndex = 0; JammerIndex < JammerProxies.Num(); ++JammerIndex)
+	{
+		if (ARadarJammerActor* JammerProxy = JammerProxies[JammerIndex].Get())
+		{
+			JammerProxy->SetActorHiddenInGame(Seconds < Data.Jammers[JammerIndex].SpawnTime);
+		}
+	}
+
+	if (GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(ReplayStatusMessageKey, 1.f, FColor::Cyan,
+			FString::Printf(TEXT("回放 %.1f / %.1f s  x%.2g%s"), Seconds, Data.Duration, Speed, bPaused ? TEXT("  已暂停") : TEXT("")));
+	}
+}
+
+bool FScenarioReplayPlayer::HandleTick(float DeltaTime)
+{
+	// 世界切换后代理随旧世界销毁，回放随之结束
+	if (!ProxyActor.IsValid())
+	{
+		TickerHandle.Reset();
+		Close();
+		return false;
+	}
+
+	if (!bPaused)
+	{
+		CurrentTime = FMath::Clamp(CurrentTime + DeltaTime * Speed, 0.f, Data.Duration);
+		if ((Speed > 0.f && CurrentTime >= Data.Duration) || (Speed < 0.f && CurrentTime <= 0.f))
+		{
+			bPaused = true;
+		}
+	}
+
+	ApplyTime(CurrentTime);
+	return true;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class AMockMissileActor;
+class ARadarJammerActor;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+class UWorld;
+
+/** 回放离散事件类型（文件按该编号存储，新增类型只能追加在末尾） */
+enum class EScenarioReplayEvent : uint8
+{
+	MissileLaunch,
+	InterceptorLaunch,
+	MissileImpact,
+	MissileExpired,
+	Intercepted,
+	BlueUnitDestroyed,
+	JammerActivated,
+};
+
+struct FScenarioReplayUnit
+{
+	FString Name;
+	FString MeshPath;
+	FString MaterialPath;
+	FVector3f Location = FVector3f::ZeroVector;
+	FQuat4f Rotation = FQuat4f::Identity;
+	FVector3f Scale = FVector3f::OneVector;
+	float SpawnTime = 0.f;
+	float DestroyedTime = -1.f; // 加载时由 BlueUnitDestroyed 事件得到，未被摧毁为 -1
+};
+
+struct FScenarioReplayJammer
+{
+	FVector3f Location = FVector3f::ZeroVector;
+	float Radius = 0.f;
+	float SpawnTime = 0.f;
+};
+
+/** 单枚导弹/拦截弹的关键帧（回放记录器按 ir.Replay.KeyframeRate 采样，已按误差压缩） */
+struct FScenarioReplayTrack
+{
+	uint32 MissileId = 0;
+	FString Name;
+	bool bInterceptor = false;
+	TArray<float> Time;
+	TArray<FVector3f> Position;
+	TArray<uint8> State; // EMissileTelemetryState
+
+	bool IsActiveAt(float Seconds) const { return Time.Num() > 0 && Seconds >= Time[0] && Seconds <= Time.Last(); }
+	/** 二分查找关键帧并线性插值，朝向取所在线段方向 */
+	bool Evaluate(float Seconds, FVector& OutLocation, FRotator& OutRotation) const;
+};
+
+struct FScenarioReplayEventRecord
+{
+	float Time = 0.f;
+	EScenarioReplayEvent Type = EScenarioReplayEvent::MissileLaunch;
+	int32 Subject = INDEX_NONE; // 导弹事件为 MissileId（会话序号），BlueUnitDestroyed 为单位下标，JammerActivated 为干扰器下标
+	FVector3f Location = FVector3f::ZeroVector;
+};
+
+/**
+ * 会话回放文件（Saved/Replays/Session_*.irrp）：初始部署、干扰器、导弹关键帧与离散事件。
+ * 关键帧各列整块读写，加载不需要逐样本解析。
+ */
+struct FScenarioReplayData
+{
+	FString MapName;
+	FString RecordedAt;
+	float Duration = 0.f;
+	TArray<FScenarioReplayUnit> Units;
+	TArray<FScenarioReplayJammer> Jammers;
+	TArray<FScenarioReplayTrack> Tracks;
+	TArray<FScenarioReplayEventRecord> Events; // 按时间排序
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	/** 读写共用（FArchive 方向决定） */
+	void Serialize(FArchive& Ar);
+};
+
+/**
+ * 会话回放记录：
+ * - 部署完成后 Begin 记录蓝方单位与干扰器，之后新增的单位/干扰器和导弹发射、命中、拦截、摧毁等事件按世界时间追加；
+ * - 导弹与拦截弹的关键帧由回放记录器自行按 ir.Replay.KeyframeRate 采样，不受遥测内存预算的压缩与淘汰影响；
+ *   相邻关键帧状态相同且中间帧偏离首尾连线不超过 ir.Replay.KeyframeError 时合并，长时间会话的关键帧数随轨迹复杂度而非时长增长；
+ * - ir.Replay.Record 开启时在测试结束后保存到 Saved/Replays。
+ */
+class FScenarioReplayRecorder
+{
+public:
+	~FScenarioReplayRecorder();
+
+	/** ir.Replay.Record */
+	static bool IsEnabled();
+	/** 导弹关键帧采样频率；未开启回放记录时为 0 */
+	static float GetKeyframeRate();
+
+	/** 开始记录；CollectMissiles 每次采样关键帧时返回当前在飞的导弹 */
+	void Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles);
+	void Reset();
+	bool IsRecording() const { return WorldWeak.IsValid(); }
+
+	void AddBlueUnit(const FString& Name, const FTransform& Transform, const UStaticMesh* Mesh, const UMaterialInterface* Material);
+	void AddJammer(const FVector& Location, float Radius);
+	void AddEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location);
+	/** 按名称找到已记录的单位并追加 BlueUnitDestroyed 事件 */
+	void NoteBlueUnitDestroyed(const FString& Name, const FVector& Location);
+
+	/** 保存到 Saved/Replays，返回输出路径；未开启或没有数据时返回空 */
+	FString SaveToReplayDir() const;
+
+private:
+	float GetSeconds() const;
+	bool HandleTick(float DeltaTime);
+	/** 在飞导弹的轨迹下标，以及自锚点关键帧（倒数第二帧）以来已被合并掉的采样点 */
+	struct FActiveTrack
+	{
+		int32 TrackIndex = INDEX_NONE;
+		TArray<float> MergedTime;
+		TArray<FVector3f> MergedPosition;
+	};
+
+	void AppendKeyframe(FScenarioReplayTrack& Track, FActiveTrack& Active, float Seconds, const FVector3f& Position, uint8 State, float ErrorBound) const;
+
+	FScenarioReplayData Data;
+	TMap<FString, int32> UnitLookup;
+	TMap<TObjectKey<AMockMissileActor>, FActiveTrack> TrackLookup; // 在飞导弹 -> 轨迹合并状态，导弹离开在飞列表后移除
+	TFunction<void(TArray<AMockMissileActor*>&)> CollectMissiles;
+	TWeakObjectPtr<UWorld> WorldWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartWorldSeconds = 0.0;
+	double LastKeyframeWorldSeconds = -1.0;
+};
+
+/**
+ * 回放查看器：只生成代理可视体（实例化网格的蓝方单位与导弹、干扰器半球），不生成导弹 Actor，
+ * 也不运行任何制导逻辑。由 FTSTicker 按真实时间推进，支持暂停、倍速与任意跳转：
+ * 每帧对每条轨迹二分查找关键帧，跳转与顺序播放的开销相同。
+ */
+class FScenarioReplayPlayer
+{
+public:
+	~FScenarioReplayPlayer();
+
+	bool Open(UWorld* World, const FString& FilePath);
+	void Close();
+	bool IsOpen() const { return ProxyActor.IsValid(); }
+
+	void SetPaused(bool bInPaused) { bPaused = bInPaused; }
+	bool IsPaused() const { return bPaused; }
+	void SetSpeed(float InSpeed);
+	float GetSpeed() const { return Speed; }
+	/** 跳转到指定时间（秒），超出范围时截断 */
+	void Seek(float Seconds);
+	float GetTime() const { return CurrentTime; }
+	float GetDuration() const { return Data.Duration; }
+	const FScenarioReplayData& GetData() const { return Data; }
+
+	/** Saved/Replays 下最新的回放文件 */
+	static FString FindLatestReplayFile();
+
+private:
+	struct FUnitBatch
+	{
+		TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+		TArray<int32> Units; // 实例下标 -> Units 下标
+	};
+
+	bool HandleTick(float DeltaTime);
+	void SpawnProxies(UWorld* World);
+	void ApplyTime(float Seconds);
+
+	FScenarioReplayData Data;
+	TWeakObjectPtr<AActor> ProxyActor;
+	TArray<FUnitBatch> UnitBatches;
+	TArray<bool> UnitVisible;
+	TWeakObjectPtr<UInstancedStaticMeshComponent> MissileComponent;
+	TWeakObjectPtr<UInstancedStaticMeshComponent> InterceptorComponent;
+	TArray<int32> MissileTracks;     // 实例下标 -> Tracks 下标
+	TArray<int32> InterceptorTracks;
+	TArray<TWeakObjectPtr<ARadarJammerActor>> JammerProxies;
+	TArray<FTransform> TransformScratch;
+	FTSTicker::FDelegateHandle TickerHandle;
+	float CurrentTime = 0.f;
+	float Speed = 1.f;
+	bool bPaused = false;
+};
@@ -0,0 +1,378 @@
+#include "Systems/ScenarioResultsExporter.h"
+
+#include "Systems/ScenarioConfigIO.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr uint32 ColumnarFileMagic = 0x43525249; // "IRRC"
+	constexpr uint32 ColumnarFileVersion = 1;
+	constexpr int32 RowsPerBatch = 1024; // 每批写出的行数，批之间检查取消并更新进度
+
+	enum class EResultColumnType : uint8
+	{
+		Int32,
+		Float32,
+		Float64,
+		Bool,
+		String,
+	};
+
+	/** 发射记录的一列：CSV 与列式文件共用同一份列定义 */
+	struct FRecordColumn
+	{
+		const TCHAR* Name;
+		EResultColumnType Type;
+		TFunction<double(const FMissileTestRecord&, const FScenarioResultsSnapshot&)> Number;
+		TFunction<FString(const FMissileTestRecord&)> Text;
+	};
+
+	FString GetOutcomeText(const FMissileTestRecord& Record)
+	{
+		if (Record.bImpactRegistered)
+		{
+			if (Record.DestroyedCount > 0)
+			{
+				return Record.bDirectHit ? TEXT("直接命中") : TEXT("范围命中");
+			}
+			return TEXT("命中未摧毁");
+		}
+		return Record.bExpired ? TEXT("未命中（失去目标）") : TEXT("进行中");
+	}
+
+	const TArray<FRecordColumn>& GetRecordColumns()
+	{
+		using FRecord = FMissileTestRecord;
+		using FSnapshot = FScenarioResultsSnapshot;
+		static const TArray<FRecordColumn> Columns = {
+			{ TEXT("LaunchTime"), EResultColumnType::Float64, [](const FRecord& R, const FSnapshot& S) { return R.LaunchTimeSeconds - S.SessionStartTime; } },
+			{ TEXT("AutoFire"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bAutoFire ? 1.0 : 0.0; } },
+			{ TEXT("TargetName"), EResultColumnType::String, nullptr, [](const FRecord& R) { return R.TargetName; } },
+			{ TEXT("TargetInstanceId"), EResultColumnType::Int32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.TargetInstanceId); } },
+			{ TEXT("LaunchX"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.LaunchLocation.X; } },
+			{ TEXT("LaunchY"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.LaunchLocation.Y; } },
+			{ TEXT("LaunchZ"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.LaunchLocation.Z; } },
+			{ TEXT("TargetX"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.TargetLocation.X; } },
+			{ TEXT("TargetY"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.TargetLocation.Y; } },
+			{ TEXT("TargetZ"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return R.TargetLocation.Z; } },
+			{ TEXT("InitialDistance"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.InitialDistance); } },
+			{ TEXT("FlightDuration"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.GetFlightDuration()); } },
+			{ TEXT("Outcome"), EResultColumnType::String, nullptr, [](const FRecord& R) { return GetOutcomeText(R); } },
+			{ TEXT("ImpactRegistered"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bImpactRegistered ? 1.0 : 0.0; } },
+			{ TEXT("DirectHit"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bDirectHit ? 1.0 : 0.0; } },
+			{ TEXT("DestroyedCount"), EResultColumnType::Int32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.DestroyedCount); } },
+			{ TEXT("Expired"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bExpired ? 1.0 : 0.0; } },
+			{ TEXT("TargetDestroyed"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bTargetDestroyed ? 1.0 : 0.0; } },
+			// 分裂元数据
+			{ TEXT("IsSplitChild"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.bIsSplitChild ? 1.0 : 0.0; } },
+			{ TEXT("SplitGroupId"), EResultColumnType::Int32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.SplitGroupId); } },
+			// 干扰对抗统计
+			{ TEXT("CM_Enabled"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bCountermeasureEnabled ? 1.0 : 0.0; } },
+			{ TEXT("CM_DetectionLogged"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bDetectionLogged ? 1.0 : 0.0; } },
+			{ TEXT("CM_Triggered"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bCountermeasureTriggered ? 1.0 : 0.0; } },
+			{ TEXT("CM_Activated"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bCountermeasureActivated ? 1.0 : 0.0; } },
+			{ TEXT("CM_DetectionTime"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.DetectionTime); } },
+			{ TEXT("CM_DetectionDistanceToJammer"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.DetectionDistanceToJammer); } },
+			{ TEXT("CM_DetectionBaseRadius"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.DetectionBaseRadius); } },
+			{ TEXT("CM_DetectionHeightDifference"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.DetectionHeightDifference); } },
+			{ TEXT("CM_TriggerTime"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureTriggerTime); } },
+			{ TEXT("CM_TargetDistance"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureTargetDistance); } },
+			{ TEXT("CM_ActivationTime"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureActivationTime); } },
+			{ TEXT("CM_ActivationDistanceToJammer"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureActivationDistanceToJammer); } },
+			{ TEXT("CM_ActivationBaseRadius"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureActivationBaseRadius); } },
+			{ TEXT("CM_ActivationHeightDifference"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureActivationHeightDifference); } },
+			{ TEXT("CM_RadiusReductionPercent"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureActivationRadiusReductionPercent); } },
+			{ TEXT("CM_Duration"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.CountermeasureDuration); } },
+			{ TEXT("CM_LostTargetInJammerRange"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bLostTargetInJammerRange ? 1.0 : 0.0; } },
+			{ TEXT("CM_EnteredJammerRange"), EResultColumnType::Bool, [](const FRecord& R, const FSnapshot&) { return R.CountermeasureStats.bEnteredJammerRange ? 1.0 : 0.0; } },
+			{ TEXT("CM_JammerRangeExitTime"), EResultColumnType::Float32, [](const FRecord& R, const FSnapshot&) { return static_cast<double>(R.CountermeasureStats.JammerRangeExitTime); } },
+		};
+		return Columns;
+	}
+
+	FString EscapeCsv(const FString& In)
+	{
+		if (In.Contains(TEXT(",")) || In.Contains(TEXT("\"")) || In.Contains(TEXT("\n")) || In.Contains(TEXT("\r")))
+		{
+			return FString::Printf(TEXT("\"%s\""), *In.Replace(TEXT("\""), TEXT("\"\"")));
+		}
+		return In;
+	}
+
+	void AppendNumber(FString& Line, EResultColumnType Type, double Value)
+	{
+		switch (Type)
+		{
+		case EResultColumnType::Int32:
+		case EResultColumnType::Bool:
+			Line.AppendInt(static_cast<int32>(Value));
+			break;
+		default:
+			Line += FString::Printf(TEXT("%.4f"), Value);
+			break;
+		}
+	}
+
+	/** 把一行（含换行）转成 UTF-8 直接写入文件 */
+	void WriteLine(FArchive& Ar, FString& Line)
+	{
+		Line += TEXT("\n");
+		FTCHARToUTF8 Utf8(*Line, Line.Len());
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+		Line.Reset();
+	}
+
+	TUniquePtr<FArchive> CreateCsvWriter(const FString& FilePath)
+	{
+		TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Ar)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ResultsExport: 无法创建文件 %s"), *FilePath);
+			return nullptr;
+		}
+
+		// UTF-8 BOM，便于 Excel 直接打开
+		uint8 Bom[3] = { 0xEF, 0xBB, 0xBF };
+		Ar->Serialize(Bom, sizeof(Bom));
+		return Ar;
+	}
+
+	template <typename T>
+	void WriteNumericColumn(FArchive& Ar, const FRecordColumn& Column, const FScenarioResultsSnapshot& Snapshot, TArray<T>& Buffer, std::atomic<int64>& UnitsDone)
+	{
+		const int32 RowCount = Snapshot.Records.Num();
+		for (int32 BatchStart = 0; BatchStart < RowCount; BatchStart += RowsPerBatch)
+		{
+			const int32 BatchEnd = FMath::Min(BatchStart + RowsPerBatch, RowCount);
+			Buffer.Reset(BatchEnd - BatchStart);
+			for (int32 Row = BatchStart; Row < BatchEnd; ++Row)
+			{
+				Buffer.Add(static_cast<T>(Column.Number(Snapshot.Records[Row], Snapshot)));
+			}
+			Ar.Serialize(Buffer.GetData(), Buffer.Num() * sizeof(T));
+			UnitsDone += BatchEnd - BatchStart;
+		}
+	}
+}
+
+FScenarioResultsExporter::~FScenarioResultsExporter()
+{
+	Cancel();
+	if (Future.IsValid())
+	{
+		Future.Wait();
+	}
+}
+
+bool FScenarioResultsExporter::Start(FScenarioResultsSnapshot&& Snapshot)
+{
+	if (IsRunning())
+	{
+		return false;
+	}
+
+	OutputDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Results") / FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+	RowCount = Snapshot.Records.Num();
+
+	// 进度单位：CSV 每行 1、列式文件每列每行 1、指标评估每条 1
+	State = MakeShared<FSharedState, ESPMode::ThreadSafe>();
+	State->UnitsTotal = FMath::Max<int64>(1, static_cast<int64>(RowCount) * (1 + GetRecordColumns().Num()) + Snapshot.Evaluations.Num());
+
+	TSharedPtr<FScenarioResultsSnapshot, ESPMode::ThreadSafe> SharedSnapshot = MakeShared<FScenarioResultsSnapshot, ESPMode::ThreadSafe>(MoveTemp(Snapshot));
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> SharedState = State;
+	const FString Directory = OutputDirectory;
+	Future = Async(EAsyncExecution::Thread, [SharedSnapshot, SharedState, Directory]()
+	{
+		return Run(*SharedSnapshot, Directory, *SharedState);
+	});
+
+	UE_LOG(LogTemp, Log, TEXT("ResultsExport: exporting %d launch records and %d evaluations to %s"), RowCount, SharedSnapshot->Evaluations.Num(), *OutputDirectory);
+	return true;
+}
+
+void FScenarioResultsExporter::Cancel()
+{
+	if (State.IsValid())
+	{
+		State->bCancelRequested = true;
+	}
+}
+
+bool FScenarioResultsExporter::IsRunning() const
+{
+	return Future.IsValid() && !Future.IsReady();
+}
+
+float FScenarioResultsExporter::GetProgress() const
+{
+	if (!State.IsValid())
+	{
+		return 0.f;
+	}
+	return FMath::Clamp(static_cast<float>(static_cast<double>(State->UnitsDone.load()) / State->UnitsTotal), 0.f, 1.f);
+}
+
+bool FScenarioResultsExporter::HasSucceeded() const
+{
+	return Future.IsValid() && Future.IsReady() && Future.Get();
+}
+
+bool FScenarioResultsExporter::Run(const FScenarioResultsSnapshot& Snapshot, const FString& Directory, FSharedState& State)
+{
+	const TArray<FRecordColumn>& Columns = GetRecordColumns();
+	const int32 RowCount = Snapshot.Records.Num();
+	FString Line;
+
+	// 1. 发射记录 CSV：逐行格式化后立即写出
+	{
+		TUniquePtr<FArchive> Ar = CreateCsvWriter(Directory / TEXT("launch_records.csv"));
+		if (!Ar)
+		{
+			return false;
+		}
+
+		Line = TEXT("Index");
+		for (const FRecordColumn& Column : Columns)
+		{
+			Line += TEXT(",");
+			Line += Column.Name;
+		}
+		WriteLine(*Ar, Line);
+
+		for (int32 Row = 0; Row < RowCount; ++Row)
+		{
+			if (Row % RowsPerBatch == 0 && State.bCancelRequested)
+			{
+				return false;
+			}
+
+			const FMissileTestRecord& Record = Snapshot.Records[Row];
+			Line.AppendInt(Row + 1);
+			for (const FRecordColumn& Column : Columns)
+			{
+				Line += TEXT(",");
+				if (Column.Type == EResultColumnType::String)
+				{
+					Line += EscapeCsv(Column.Text(Record));
+				}
+				else
+				{
+					AppendNumber(Line, Column.Type, Column.Number(Record, Snapshot));
+				}
+			}
+			WriteLine(*Ar, Line);
+			++State.UnitsDone;
+		}
+
+		if (!Ar->Close() || Ar->IsError())
+		{
+			return false;
+		}
+	}
+
+	// 2. 列式二进制：文件头（魔数、版本、行数、列数），随后每列为 名称、类型、整列数据
+	{
+		const FString FilePath = Directory / TEXT("launch_records.irrc");
+		TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Ar)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ResultsExport: 无法创建文件 %s"), *FilePath);
+			return false;
+		}
+
+		uint32 Magic = ColumnarFileMagic;
+		uint32 Version = ColumnarFileVersion;
+		int32 FileRowCount = RowCount;
+		int32 ColumnCount = Columns.Num();
+		*Ar << Magic << Version << FileRowCount << ColumnCount;
+
+		TArray<int32> IntBuffer;
+		TArray<float> FloatBuffer;
+		TArray<double> DoubleBuffer;
+		TArray<uint8> BoolBuffer;
+		for (const FRecordColumn& Column : Columns)
+		{
+			if (State.bCancelRequested)
+			{
+				return false;
+			}
+
+			FString Name = Column.Name;
+			uint8 Type = static_cast<uint8>(Column.Type);
+			*Ar << Name << Type;
+
+			switch (Column.Type)
+			{
+			case EResultColumnType::Int32:
+				WriteNumericColumn(*Ar, Column, Snapshot, IntBuffer, State.UnitsDone);
+				break;
+			case EResultColumnType::Float32:
+				WriteNumericColumn(*Ar, Column, Snapshot, FloatBuffer, State.UnitsDone);
+				break;
+			case EResultColumnType::Float64:
+				WriteNumericColumn(*Ar, Column, Snapshot, DoubleBuffer, State.UnitsDone);
+				break;
+			case EResultColumnType::Bool:
+				WriteNumericColumn(*Ar, Column, Snapshot, BoolBuffer, State.UnitsDone);
+				break;
+			case EResultColumnType::String:
+				for (const FMissileTestRecord& Record : Snapshot.Records)
+				{
+					FString Value = Column.Text(Record);
+					*Ar << Value;
+				}
+				State.UnitsDone += RowCount;
+				break;
+			}
+		}
+
+		if (!Ar->Close() || Ar->IsError())
+		{
+			return false;
+		}
+	}
+
+	// 3. 指标评估 CSV
+	{
+		TUniquePtr<FArchive> Ar = CreateCsvWriter(Directory / TEXT("indicator_evaluations.csv"));
+		if (!Ar)
+		{
+			return false;
+		}
+
+		Line = TEXT("IndicatorId,DisplayName,HasData,Pass,Value,TargetValue,HigherIsBetter,Status,ValueText,TargetText,Remark");
+		WriteLine(*Ar, Line);
+		for (const FIndicatorEvaluationResult& Evaluation : Snapshot.Evaluations)
+		{
+			Line += FString::Printf(TEXT("%s,%s,%d,%d,%.4f,%.4f,%d,%s,%s,%s,%s"),
+				*EscapeCsv(Evaluation.IndicatorId), *EscapeCsv(Evaluation.DisplayName),
+				Evaluation.bHasData ? 1 : 0, Evaluation.bPass ? 1 : 0, Evaluation.Value, Evaluation.TargetValue, Evaluation.bHigherIsBetter ? 1 : 0,
+				*EscapeCsv(Evaluation.StatusText), *EscapeCsv(Evaluation.ValueText), *EscapeCsv(Evaluation.TargetText), *EscapeCsv(Evaluation.RemarkText));
+			WriteLine(*Ar, Line);
+			++State.UnitsDone;
+		}
+
+		if (!Ar->Close() || Ar->IsError())
+		{
+			return false;
+		}
+	}
+
+	// 4. 配置、汇总与指标评估（体积小，沿用结果 JSON 格式）
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetObjectField(TEXT("config"), ScenarioConfigIO::ConfigToJson(Snapshot.Config));
+	Root->SetObjectField(TEXT("summary"), ScenarioConfigIO::SummaryToJson(Snapshot.Summary));
+	TArray<TSharedPtr<FJsonValue>> EvaluationValues;
+	for (const FIndicatorEvaluationResult& Evaluation : Snapshot.Evaluations)
+	{
+		EvaluationValues.Add(MakeShared<FJsonValueObject>(ScenarioConfigIO::EvaluationToJson(Evaluation)));
+	}
+	Root->SetArrayField(TEXT("evaluations"), EvaluationValues);
+	Root->SetNumberField(TEXT("launchRecordCount"), RowCount);
+	return ScenarioConfigIO::WriteJsonToFile(Root, Directory / TEXT("summary.json"));
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Systems/ScenarioTestMetrics.h"
+#include "UI/SScenarioScreen.h"
+
+#include <atomic>
+
+/** 导出时在游戏线程拍下的数据快照，后台线程只读 */
+struct FScenarioResultsSnapshot
+{
+	FScenarioTestConfig Config;
+	FMissileTestSummary Summary;
+	TArray<FMissileTestRecord> Records;
+	TArray<FIndicatorEvaluationResult> Evaluations;
+	double SessionStartTime = 0.0;
+};
+
+/**
+ * Step5 结果导出（Saved/Results/<时间戳>/）：
+ * - launch_records.csv：全部发射记录，包含干扰对抗统计与分裂元数据（UTF-8 BOM，逐行写出，不拼接整份文本）；
+ * - launch_records.irrc：同样的列按列式二进制存储，每列整块写出，便于离线分析大批量数据；
+ * - indicator_evaluations.csv：指标评估结果；
+ * - summary.json：配置、汇总与指标评估。
+ * 导出在后台线程执行，界面通过 GetProgress 显示进度。
+ */
+class FScenarioResultsExporter
+{
+public:
+	~FScenarioResultsExporter();
+
+	/** 开始导出；已有导出在进行时返回 false */
+	bool Start(FScenarioResultsSnapshot&& Snapshot);
+	/** 请求取消，后台线程在下一批行之间退出 */
+	void Cancel();
+
+	bool IsRunning() const;
+	/** 0-1 */
+	float GetProgress() const;
+	/** 上一次导出是否完整写出 */
+	bool HasSucceeded() const;
+	int32 GetRowCount() const { return RowCount; }
+	const FString& GetOutputDirectory() const { return OutputDirectory; }
+
+private:
+	struct FSharedState
+	{
+		std::atomic<int64> UnitsDone{ 0 };
+		int64 UnitsTotal = 1;
+		std::atomic<bool> bCancelRequested{ false };
+	};
+
+	static bool Run(const FScenarioResultsSnapshot& Snapshot, const FString& Directory, FSharedState& State);
+
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> State;
+	TFuture<bool> Future;
+	FString OutputDirectory;
+	int32 RowCount = 0;
+};
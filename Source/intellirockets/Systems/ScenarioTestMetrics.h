@@ -30,6 +30,7 @@ struct FMissileTestRecord
 	double LaunchTimeSeconds = 0.0;
 	bool bAutoFire = false;
 	TWeakObjectPtr<AActor> TargetActor;
+	int32 TargetInstanceId = INDEX_NONE; // 实例化蓝方目标（FBlueUnitHandle::Id）
 	FString TargetName;
 	FVector LaunchLocation = FVector::ZeroVector;
 	FVector TargetLocation = FVector::ZeroVector;
@@ -51,6 +52,54 @@ struct FMissileTestRecord
 	}
 };
 
+// 测试会话运行性能（用于判断结果是否在降帧条件下产生）
+struct FScenarioPerformanceStats
+{
+	// 帧耗时直方图分桶上限（毫秒），最后一个桶为 >= 最后一个上限
+	static constexpr int32 NumFrameTimeBuckets = 6;
+	static const float* GetFrameTimeBucketEdges()
+	{
+		static const float Edges[NumFrameTimeBuckets - 1] = { 8.4f, 16.7f, 33.4f, 50.f, 100.f };
+		return Edges;
+	}
+	static int32 GetFrameTimeBucketIndex(float FrameTimeMs)
+	{
+		const float* Edges = GetFrameTimeBucketEdges();
+		for (int32 Index = 0; Index < NumFrameTimeBuckets - 1; ++Index)
+		{
+			if (FrameTimeMs < Edges[Index])
+			{
+				return Index;
+			}
+		}
+		return NumFrameTimeBuckets - 1;
+	}
+
+	bool bValid = false;
+
+	int32 FrameTimeHistogram[NumFrameTimeBuckets] = {};
+	int32 FrameCount = 0;
+	float AverageFrameTimeMs = 0.f;
+	float MaxFrameTimeMs = 0.f;
+	float AverageFps = 0.f;
+
+	float WallDuration = 0.f; // 真实耗时（秒）
+	float SimDuration = 0.f; // 仿真耗时（秒，受暂停/时间膨胀影响）
+	float SimToWallRatio = 0.f;
+
+	int32 PeakConcurrentMissiles = 0;
+	int32 MissileSpawnCount = 0;
+	int32 MissileDestroyCount = 0;
+	int32 InterceptorSpawnCount = 0;
+	int32 InterceptorDestroyCount = 0;
+	int32 BlueUnitSpawnCount = 0;
+	int32 BlueUnitDestroyCount = 0;
+	int64 TraceCount = 0; // 射线检测次数
+
+	bool bDegradedFrameRate = false; // 降帧：本次结果可疑
+	FString DegradedReason;
+};
+
 struct FMissileTestSummary
 {
 	int32 TotalShots = 0;
@@ -87,6 +136,8 @@ struct FMissileTestSummary
 	float CountermeasureCoverageSuccessRate = 0.f; // 干扰覆盖成功率
 	float CountermeasureAverageDuration = 0.f; // 平均干扰持续时间
 	float CountermeasureResourceCostScore = 0.f; // 资源消耗控制得分（0-100）
+
+	FScenarioPerformanceStats Performance; // 会话运行性能
 };
 
 struct FIndicatorEvaluationResult
@@ -100,6 +151,10 @@ struct FIndicatorEvaluationResult
 	FLinearColor StatusColor = FLinearColor::Gray;
 	bool bHasData = false;
 	bool bPass = false;
+	float Value = 0.f; // 数值结果（bHasData 为 true 时有效），供批量统计使用
+	float TargetValue = 0.f;
+	bool bHigherIsBetter = true;
+	bool bRecordBased = true; // 由逐发记录统计得出（可对记录重抽样估计置信区间）；感知与分裂计数类指标为 false
 };
 
 // 轻量级：感知算法-运行期统计（用于 9.1.1 指标计算）
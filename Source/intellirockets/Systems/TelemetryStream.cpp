@@ -0,0 +1,645 @@
+#include "Systems/TelemetryStream.h"
+
+#include "Actors/MockMissileActor.h"
+#include "Systems/MissileTelemetryRecorder.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Containers/Queue.h"
+#include "Engine/World.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#include <atomic>
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarStreamEnable(
+		TEXT("ir.Stream.Enable"),
+		0,
+		TEXT("1: 在本机 TCP 端口上推送实时遥测流（导弹状态、事件与汇总指标），供外部看板订阅"));
+
+	TAutoConsoleVariable<int32> CVarStreamPort(
+		TEXT("ir.Stream.Port"),
+		47810,
+		TEXT("实时遥测流监听端口（仅绑定 127.0.0.1，首次开始推送时生效）"));
+
+	TAutoConsoleVariable<float> CVarStreamRate(
+		TEXT("ir.Stream.Rate"),
+		30.f,
+		TEXT("游戏线程拍下导弹状态帧的频率（Hz，按世界时间）"));
+
+	TAutoConsoleVariable<float> CVarStreamClientMaxRate(
+		TEXT("ir.Stream.ClientMaxRate"),
+		30.f,
+		TEXT("单个客户端的状态帧频率上限（Hz），客户端可请求更低的频率"));
+
+	TAutoConsoleVariable<int32> CVarStreamClientQueueKB(
+		TEXT("ir.Stream.ClientQueueKB"),
+		256,
+		TEXT("单个客户端待发数据上限（KB），超出后丢弃状态帧，超出四倍时断开该客户端"));
+
+	TAutoConsoleVariable<float> CVarStreamStallSeconds(
+		TEXT("ir.Stream.StallSeconds"),
+		10.f,
+		TEXT("客户端有待发数据却连续该秒数未能发出任何字节时断开（客户端停止读取）"));
+
+	TAutoConsoleVariable<int32> CVarStreamMaxClients(
+		TEXT("ir.Stream.MaxClients"),
+		8,
+		TEXT("实时遥测流同时连接的客户端上限"));
+
+	constexpr uint32 StreamMagic = 0x53545249; // "IRTS"
+	constexpr uint16 StreamVersion = 2; // 2: 状态帧每枚导弹新增目标类别
+	constexpr int32 MaxQueuedFrames = 512;  // 网络线程积压超过该帧数时游戏线程不再生成状态帧
+	constexpr int32 MaxClientFrameSize = 64; // 客户端 -> 服务端的帧只有控制消息
+	constexpr int32 PendingCompactThreshold = 64; // 已发送的队首帧达到该数量且过半时压缩待发数组
+	constexpr float SummaryInterval = 1.f;
+}
+
+/** 已编码的完整帧（含长度前缀），由游戏线程生成后在所有客户端之间共享 */
+struct FTelemetryStreamFrame
+{
+	ETelemetryStreamFrame Type = ETelemetryStreamFrame::State;
+	TArray<uint8> Bytes;
+};
+
+using FTelemetryStreamFramePtr = TSharedPtr<const FTelemetryStreamFrame, ESPMode::ThreadSafe>;
+
+namespace
+{
+	FTelemetryStreamFramePtr MakeFrame(ETelemetryStreamFrame Type, TFunctionRef<void(FArchive&)> WritePayload)
+	{
+		TSharedRef<FTelemetryStreamFrame, ESPMode::ThreadSafe> Frame = MakeShared<FTelemetryStreamFrame, ESPMode::ThreadSafe>();
+		Frame->Type = Type;
+
+		FMemoryWriter Writer(Frame->Bytes);
+		uint32 Length = 0;
+		uint8 TypeByte = static_cast<uint8>(Type);
+		Writer << Length;
+		Writer << TypeByte;
+		WritePayload(Writer);
+
+		// 回填长度（不含长度字段本身）
+		Length = static_cast<uint32>(Frame->Bytes.Num() - sizeof(uint32));
+		Writer.Seek(0);
+		Writer << Length;
+		return Frame;
+	}
+}
+
+/**
+ * 网络线程：接受连接、把游戏线程的帧分发给各客户端并以非阻塞方式发送。
+ * 游戏线程只调用 Enqueue（无锁队列 + 事件唤醒），从不等待网络。
+ */
+class FTelemetryStreamServer : public FRunnable
+{
+public:
+	explicit FTelemetryStreamServer(int32 InPort)
+		: Port(InPort)
+	{
+	}
+
+	virtual ~FTelemetryStreamServer() override
+	{
+		Shutdown();
+	}
+
+	bool Start()
+	{
+		SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (!SocketSubsystem)
+		{
+			return false;
+		}
+
+		ListenSocket = FTcpSocketBuilder(TEXT("IRTelemetryStreamListen"))
+			.AsNonBlocking()
+			.AsReusable()
+			.BoundToEndpoint(FIPv4Endpoint(FIPv4Address::InternalLoopback, static_cast<uint16>(Port)))
+			.Listening(8);
+		if (!ListenSocket)
+		{
+			UE_LOG(LogTemp, Error, TEXT("TelemetryStream: failed to listen on 127.0.0.1:%d"), Port);
+			return false;
+		}
+
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("IRTelemetryStream"), 0, TPri_BelowNormal);
+		if (!Thread)
+		{
+			Shutdown();
+			return false;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("TelemetryStream: listening on 127.0.0.1:%d"), Port);
+		return true;
+	}
+
+	void Shutdown()
+	{
+		bStopRequested = true;
+		if (Thread)
+		{
+			WakeEvent->Trigger();
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+		if (WakeEvent)
+		{
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+			WakeEvent = nullptr;
+		}
+		if (ListenSocket)
+		{
+			ListenSocket->Close();
+			SocketSubsystem->DestroySocket(ListenSocket);
+			ListenSocket = nullptr;
+		}
+	}
+
+	/** 仅游戏线程调用（单生产者） */
+	void Enqueue(const FTelemetryStreamFramePtr& Frame)
+	{
+		Inbound.Enqueue(Frame);
+		QueuedFrames.fetch_add(1, std::memory_order_relaxed);
+		WakeEvent->Trigger();
+	}
+
+	int32 GetClientCount() const { return ClientCount.load(std::memory_order_relaxed); }
+	int32 GetQueuedFrames() const { return QueuedFrames.load(std::memory_order_relaxed); }
+
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested)
+		{
+			AcceptClients();
+			DistributeFrames();
+
+			const double Now = FPlatformTime::Seconds();
+			const double StallSeconds = FMath::Max(1.f, CVarStreamStallSeconds.GetValueOnAnyThread());
+			bool bHasPending = false;
+			for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+			{
+				FClient& Client = Clients[Index];
+				const bool bConnected = !Client.bOverflowed && ReadClient(Client) && FlushClient(Client, Now);
+				// 积压未到断开阈值、但客户端已停止读取时，状态帧只会被一直丢弃，Gap 帧也发不出去
+				const bool bStalled = bConnected && Client.PendingHead < Client.Pending.Num() && Now - Client.LastSendTime > StallSeconds;
+				if (!bConnected || bStalled)
+				{
+					UE_LOG(LogTemp, Log, TEXT("TelemetryStream: client #%d disconnected%s"), Client.Id,
+						Client.bOverflowed ? TEXT(" (too slow)") : bStalled ? TEXT(" (stalled)") : TEXT(""));
+					CloseClient(Client);
+					Clients.RemoveAtSwap(Index);
+					continue;
+				}
+				bHasPending |= Client.PendingHead < Client.Pending.Num();
+			}
+			ClientCount.store(Clients.Num(), std::memory_order_relaxed);
+
+			// 有待发数据时短暂等待发送缓冲区腾出空间，否则等待新帧
+			WakeEvent->Wait(bHasPending ? 1 : 10);
+		}
+
+		for (FClient& Client : Clients)
+		{
+			CloseClient(Client);
+		}
+		Clients.Reset();
+		ClientCount.store(0, std::memory_order_relaxed);
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested = true;
+	}
+
+private:
+	struct FClient
+	{
+		int32 Id = 0;
+		FSocket* Socket = nullptr;
+		TArray<FTelemetryStreamFramePtr> Pending;
+		int32 PendingHead = 0;
+		int32 HeadOffset = 0; // 队首帧已发送的字节数
+		int64 PendingBytes = 0;
+		double LastSendTime = 0.0; // 最近一次发出数据（或待发队列为空）的时间
+		float RequestedRate = 0.f; // 0 表示按服务端上限
+		double NextStateTime = 0.0;
+		uint32 DroppedStates = 0;
+		bool bOverflowed = false;
+		TArray<uint8> Inbox;
+	};
+
+	void AcceptClients()
+	{
+		bool bPending = false;
+		while (ListenSocket->HasPendingConnection(bPending) && bPending)
+		{
+			FSocket* Socket = ListenSocket->Accept(TEXT("IRTelemetryStreamClient"));
+			if (!Socket)
+			{
+				break;
+			}
+			if (Clients.Num() >= FMath::Max(1, CVarStreamMaxClients.GetValueOnAnyThread()))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TelemetryStream: client limit reached, connection refused"));
+				Socket->Close();
+				SocketSubsystem->DestroySocket(Socket);
+				continue;
+			}
+
+			Socket->SetNonBlocking(true);
+			Socket->SetNoDelay(true);
+
+			FClient& Client = Clients.AddDefaulted_GetRef();
+			Client.Id = ++NextClientId;
+			Client.Socket = Socket;
+			Client.LastSendTime = FPlatformTime::Seconds();
+
+			const float StreamRate = CVarStreamRate.GetValueOnAnyThread();
+			const float ClientMaxRate = CVarStreamClientMaxRate.GetValueOnAnyThread();
+			Push(Client, MakeFrame(ETelemetryStreamFrame::Hello, [&](FArchive& Ar)
+			{
+				uint32 Magic = StreamMagic;
+				uint16 Version = StreamVersion;
+				float ServerRate = StreamRate;
+				float MaxRate = ClientMaxRate;
+				Ar << Magic << Version << ServerRate << MaxRate;
+			}));
+			if (CurrentSessionFrame.IsValid())
+			{
+				Push(Client, CurrentSessionFrame);
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("TelemetryStream: client #%d connected"), Client.Id);
+		}
+	}
+
+	void DistributeFrames()
+	{
+		const double Now = FPlatformTime::Seconds();
+		const int64 QueueLimit = static_cast<int64>(FMath::Max(16, CVarStreamClientQueueKB.GetValueOnAnyThread())) * 1024;
+		const float ClientMaxRate = CVarStreamClientMaxRate.GetValueOnAnyThread();
+
+		FTelemetryStreamFramePtr Frame;
+		while (Inbound.Dequeue(Frame))
+		{
+			QueuedFrames.fetch_sub(1, std::memory_order_relaxed);
+
+			if (Frame->Type == ETelemetryStreamFrame::SessionBegin)
+			{
+				CurrentSessionFrame = Frame;
+			}
+			else if (Frame->Type == ETelemetryStreamFrame::SessionEnd)
+			{
+				CurrentSessionFrame.Reset();
+			}
+
+			for (FClient& Client : Clients)
+			{
+				Offer(Client, Frame, Now, QueueLimit, ClientMaxRate);
+			}
+		}
+	}
+
+	void Offer(FClient& Client, const FTelemetryStreamFramePtr& Frame, double Now, int64 QueueLimit, float ClientMaxRate)
+	{
+		if (Frame->Type != ETelemetryStreamFrame::State)
+		{
+			// 事件与汇总不丢弃；积压到上限的四倍说明客户端已跟不上，断开
+			if (Client.PendingBytes > QueueLimit * 4)
+			{
+				Client.bOverflowed = true;
+				return;
+			}
+			Push(Client, Frame);
+			return;
+		}
+
+		// 单客户端频率限制：跳过的状态帧不算丢弃
+		if (Now < Client.NextStateTime)
+		{
+			return;
+		}
+
+		// 背压：待发数据超过上限时丢弃状态帧（后续状态帧包含完整状态，可以直接替代）
+		if (Client.PendingBytes + Frame->Bytes.Num() > QueueLimit)
+		{
+			++Client.DroppedStates;
+			return;
+		}
+
+		const float Rate = Client.RequestedRate > 0.f ? FMath::Min(Client.RequestedRate, ClientMaxRate) : ClientMaxRate;
+		if (Rate > 0.f)
+		{
+			Client.NextStateTime = FMath::Max(Client.NextStateTime + 1.0 / Rate, Now - 0.5 / Rate);
+		}
+
+		if (Client.DroppedStates > 0)
+		{
+			uint32 Dropped = Client.DroppedStates;
+			Push(Client, MakeFrame(ETelemetryStreamFrame::Gap, [&](FArchive& Ar) { Ar << Dropped; }));
+			Client.DroppedStates = 0;
+		}
+		Push(Client, Frame);
+	}
+
+	static void Push(FClient& Client, const FTelemetryStreamFramePtr& Frame)
+	{
+		Client.Pending.Add(Frame);
+		Client.PendingBytes += Frame->Bytes.Num();
+	}
+
+	/** 读取客户端的控制帧；连接关闭或数据非法时返回 false */
+	bool ReadClient(FClient& Client)
+	{
+		uint8 Buffer[256];
+		int32 BytesRead = 0;
+		if (!Client.Socket->Recv(Buffer, sizeof(Buffer), BytesRead))
+		{
+			return false;
+		}
+		if (BytesRead <= 0)
+		{
+			return true;
+		}
+		Client.Inbox.Append(Buffer, BytesRead);
+
+		while (Client.Inbox.Num() >= static_cast<int32>(sizeof(uint32)))
+		{
+			uint32 Length = 0;
+			FMemory::Memcpy(&Length, Client.Inbox.GetData(), sizeof(uint32));
+			if (Length < 1 || Length > MaxClientFrameSize)
+			{
+				return false;
+			}
+			const int32 FrameSize = static_cast<int32>(sizeof(uint32) + Length);
+			if (Client.Inbox.Num() < FrameSize)
+			{
+				break;
+			}
+
+			const ETelemetryStreamFrame Type = static_cast<ETelemetryStreamFrame>(Client.Inbox[sizeof(uint32)]);
+			if (Type == ETelemetryStreamFrame::ClientRate && Length >= 1 + sizeof(float))
+			{
+				float Rate = 0.f;
+				FMemory::Memcpy(&Rate, Client.Inbox.GetData() + sizeof(uint32) + 1, sizeof(float));
+				Client.RequestedRate = FMath::IsFinite(Rate) ? FMath::Max(0.f, Rate) : 0.f;
+				Client.NextStateTime = 0.0;
+			}
+			Client.Inbox.RemoveAt(0, FrameSize, EAllowShrinking::No);
+		}
+		return true;
+	}
+
+	/** 尽量发送待发数据；连接出错时返回 false */
+	bool FlushClient(FClient& Client, double Now)
+	{
+		bool bConnected = true;
+		while (Client.PendingHead < Client.Pending.Num())
+		{
+			const TArray<uint8>& Bytes = Client.Pending[Client.PendingHead]->Bytes;
+			const int32 Remaining = Bytes.Num() - Client.HeadOffset;
+			int32 Sent = 0;
+			if (!Client.Socket->Send(Bytes.GetData() + Client.HeadOffset, Remaining, Sent))
+			{
+				bConnected = SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK;
+				break;
+			}
+
+			Client.HeadOffset += Sent;
+			Client.PendingBytes -= Sent;
+			if (Sent > 0)
+			{
+				Client.LastSendTime = Now;
+			}
+			if (Sent < Remaining)
+			{
+				break; // 发送缓冲区已满，下一轮继续
+			}
+
+			Client.HeadOffset = 0;
+			Client.Pending[Client.PendingHead++].Reset();
+		}
+
+		if (Client.PendingHead >= Client.Pending.Num())
+		{
+			Client.Pending.Reset();
+			Client.PendingHead = 0;
+			Client.LastSendTime = Now; // 没有积压时不计入停滞时间
+		}
+		else if (Client.PendingHead >= PendingCompactThreshold && Client.PendingHead * 2 >= Client.Pending.Num())
+		{
+			// 客户端持续有积压时队列可能一直排不空，已发送的空槽不能只在排空后才回收
+			Client.Pending.RemoveAt(0, Client.PendingHead, EAllowShrinking::No);
+			Client.PendingHead = 0;
+		}
+		return bConnected;
+	}
+
+	void CloseClient(FClient& Client)
+	{
+		if (Client.Socket)
+		{
+			Client.Socket->Close();
+			SocketSubsystem->DestroySocket(Client.Socket);
+			Client.Socket = nullptr;
+		}
+	}
+
+	int32 Port = 0;
+	ISocketSubsystem* SocketSubsystem = nullptr;
+	FSocket* ListenSocket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	TQueue<FTelemetryStreamFramePtr, EQueueMode::Spsc> Inbound;
+	std::atomic<int32> QueuedFrames{ 0 };
+	std::atomic<int32> ClientCount{ 0 };
+	std::atomic<bool> bStopRequested{ false };
+
+	// 以下只在网络线程访问
+	TArray<FClient> Clients;
+	FTelemetryStreamFramePtr CurrentSessionFrame;
+	int32 NextClientId = 0;
+};
+
+FTelemetryStreamPublisher::~FTelemetryStreamPublisher()
+{
+	Shutdown();
+}
+
+bool FTelemetryStreamPublisher::IsEnabled()
+{
+	return CVarStreamEnable.GetValueOnGameThread() != 0;
+}
+
+int32 FTelemetryStreamPublisher::GetClientCount() const
+{
+	return Server.IsValid() ? Server->GetClientCount() : 0;
+}
+
+void FTelemetryStreamPublisher::Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles, TFunction<void(FTelemetryStreamSummary&)> InCollectSummary)
+{
+	End();
+	if (!World || !InCollectMissiles || !IsEnabled())
+	{
+		return;
+	}
+
+	if (!Server.IsValid())
+	{
+		Server = MakeUnique<FTelemetryStreamServer>(CVarStreamPort.GetValueOnGameThread());
+		if (!Server->Start())
+		{
+			Server.Reset();
+			return;
+		}
+	}
+
+	WorldWeak = World;
+	CollectMissiles = MoveTemp(InCollectMissiles);
+	CollectSummary = MoveTemp(InCollectSummary);
+	StartWorldSeconds = World->GetTimeSeconds();
+	LastStateWorldSeconds = -1.0;
+	LastSummaryWorldSeconds = -1.0;
+	StateSequence = 0;
+	++SessionId;
+
+	uint32 Id = SessionId;
+	Server->Enqueue(MakeFrame(ETelemetryStreamFrame::SessionBegin, [&](FArchive& Ar) { Ar << Id; }));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FTelemetryStreamPublisher::HandleTick));
+}
+
+void FTelemetryStreamPublisher::End()
+{
+	if (!TickerHandle.IsValid())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (Server.IsValid())
+	{
+		PublishSummary();
+		float Seconds = GetSeconds();
+		Server->Enqueue(MakeFrame(ETelemetryStreamFrame::SessionEnd, [&](FArchive& Ar) { Ar << Seconds; }));
+	}
+
+	CollectMissiles = nullptr;
+	CollectSummary = nullptr;
+	WorldWeak = nullptr;
+}
+
+void FTelemetryStreamPublisher::Shutdown()
+{
+	End();
+	if (Server.IsValid())
+	{
+		Server->Shutdown();
+		Server.Reset();
+	}
+}
+
+float FTelemetryStreamPublisher::GetSeconds() const
+{
+	const UWorld* World = WorldWeak.Get();
+	return World ? static_cast<float>(World->GetTimeSeconds() - StartWorldSeconds) : 0.f;
+}
+
+void FTelemetryStreamPublisher::PublishEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location)
+{
+	if (!IsStreaming() || !Server.IsValid() || Server->GetClientCount() == 0)
+	{
+		return;
+	}
+
+	float Seconds = GetSeconds();
+	uint8 TypeByte = static_cast<uint8>(Type);
+	FVector3f Position(Location);
+	Server->Enqueue(MakeFrame(ETelemetryStreamFrame::Event, [&](FArchive& Ar)
+	{
+		Ar << Seconds << TypeByte << Subject << Position;
+	}));
+}
+
+void FTelemetryStreamPublisher::PublishSummary()
+{
+	if (!CollectSummary || Server->GetClientCount() == 0)
+	{
+		return;
+	}
+
+	FTelemetryStreamSummary Summary;
+	CollectSummary(Summary);
+	float Seconds = GetSeconds();
+	Server->Enqueue(MakeFrame(ETelemetryStreamFrame::Summary, [&](FArchive& Ar)
+	{
+		Ar << Seconds << Summary.TotalShots << Summary.Hits << Summary.DirectHits << Summary.Misses
+			<< Summary.ActiveMissiles << Summary.ActiveInterceptors << Summary.HitRate;
+	}));
+}
+
+bool FTelemetryStreamPublisher::HandleTick(float DeltaTime)
+{
+	UWorld* World = WorldWeak.Get();
+	if (!World || !Server.IsValid() || Server->GetClientCount() == 0)
+	{
+		return true; // 没有客户端时不采样
+	}
+
+	const double WorldSeconds = World->GetTimeSeconds();
+	if (LastSummaryWorldSeconds < 0.0 || WorldSeconds - LastSummaryWorldSeconds >= SummaryInterval)
+	{
+		LastSummaryWorldSeconds = WorldSeconds;
+		PublishSummary();
+	}
+
+	const float Rate = CVarStreamRate.GetValueOnGameThread();
+	if (Rate <= 0.f || (LastStateWorldSeconds >= 0.0 && WorldSeconds - LastStateWorldSeconds < 1.0 / Rate))
+	{
+		return true;
+	}
+	LastStateWorldSeconds = WorldSeconds;
+
+	// 网络线程积压时直接跳过本次状态帧，游戏线程不等待
+	if (Server->GetQueuedFrames() > MaxQueuedFrames)
+	{
+		return true;
+	}
+
+	TArray<AMockMissileActor*> Missiles;
+	CollectMissiles(Missiles);
+	Missiles.RemoveAll([](const AMockMissileActor* Missile) { return !Missile || Missile->IsPendingKillPending(); });
+
+	uint32 Sequence = ++StateSequence;
+	float Seconds = static_cast<float>(WorldSeconds - StartWorldSeconds);
+	Server->Enqueue(MakeFrame(ETelemetryStreamFrame::State, [&](FArchive& Ar)
+	{
+		int32 Count = Missiles.Num();
+		Ar << Sequence << Seconds << Count;
+		for (AMockMissileActor* Missile : Missiles)
+		{
+			FMissileTelemetrySample Sample;
+			Missile->GetTelemetrySample(Sample);
+
+			uint32 MissileId = Missile->GetSessionSerial();
+			uint8 bInterceptor = Missile->IsInterceptor() ? 1 : 0;
+			uint8 State = static_cast<uint8>(Sample.State);
+			FVector3f Position(Sample.Location);
+			uint8 TargetKind = static_cast<uint8>(Sample.TargetKind);
+			Ar << MissileId << bInterceptor << State << Position << Sample.NearestJammerDistance << TargetKind << Sample.TargetId;
+		}
+	}));
+	return true;
+}
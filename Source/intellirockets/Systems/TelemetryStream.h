@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Systems/ScenarioReplay.h"
+
+class AMockMissileActor;
+class UWorld;
+class FTelemetryStreamServer;
+
+/** 实时遥测流的帧类型（外部看板按该编号解析，新增类型只能追加在末尾） */
+enum class ETelemetryStreamFrame : uint8
+{
+	Hello,        // 连接后首帧：Magic、版本、服务端状态帧频率、单客户端频率上限
+	SessionBegin, // 会话编号（连接时会话已开始则紧随 Hello 补发）
+	State,        // 序号、会话时间、所有在飞导弹的状态（导弹以会话序号标识，与 Event 帧的 Subject 一致）
+	Event,        // 发射、命中、拦截、摧毁等离散事件（EScenarioReplayEvent）
+	Summary,      // 运行中的汇总指标
+	SessionEnd,
+	Gap,          // 该客户端因积压被丢弃的状态帧数量（紧接在下一帧之前）
+
+	ClientRate = 0x80, // 客户端 -> 服务端：请求的状态帧频率（Hz）
+};
+
+/** 运行中的汇总指标（由子系统按当前发射记录统计） */
+struct FTelemetryStreamSummary
+{
+	int32 TotalShots = 0;
+	int32 Hits = 0;
+	int32 DirectHits = 0;
+	int32 Misses = 0;
+	int32 ActiveMissiles = 0;
+	int32 ActiveInterceptors = 0;
+	float HitRate = 0.f;
+};
+
+/**
+ * 实时遥测流（ir.Stream.Enable）：在 127.0.0.1:ir.Stream.Port 上以 TCP 推送长度前缀的二进制帧，
+ * 帧格式为 [uint32 长度（不含自身）][uint8 ETelemetryStreamFrame][载荷]，小端序。
+ * - 游戏线程按 ir.Stream.Rate 拍下导弹状态、按 1Hz 拍下汇总指标，编码成帧后放入无锁队列，不做任何网络操作；
+ *   没有客户端连接时不采样，队列积压过多时丢弃状态帧（事件帧保留）；
+ * - 网络线程负责接受连接与非阻塞发送：每个客户端的状态帧频率不超过 ir.Stream.ClientMaxRate
+ *   （客户端可用 ClientRate 帧请求更低的频率），待发数据超过 ir.Stream.ClientQueueKB 时丢弃状态帧并补发 Gap 帧，
+ *   超过四倍仍未发出、或有待发数据却连续 ir.Stream.StallSeconds 未发出任何字节时断开该客户端。
+ * 参考客户端见 Tools/telemetry_stream_consumer.py。
+ */
+class FTelemetryStreamPublisher
+{
+public:
+	~FTelemetryStreamPublisher();
+
+	/** ir.Stream.Enable */
+	static bool IsEnabled();
+
+	/** 开始推送（首次调用时启动监听）；CollectMissiles 与遥测记录器相同，CollectSummary 统计当前汇总指标 */
+	void Begin(UWorld* World, TFunction<void(TArray<AMockMissileActor*>&)> InCollectMissiles, TFunction<void(FTelemetryStreamSummary&)> InCollectSummary);
+	/** 结束当前会话（发送最后一次汇总与 SessionEnd），保持监听 */
+	void End();
+	/** 断开所有客户端并停止网络线程 */
+	void Shutdown();
+
+	bool IsStreaming() const { return TickerHandle.IsValid(); }
+	int32 GetClientCount() const;
+
+	void PublishEvent(EScenarioReplayEvent Type, int32 Subject, const FVector& Location);
+
+private:
+	bool HandleTick(float DeltaTime);
+	float GetSeconds() const;
+	void PublishSummary();
+
+	TUniquePtr<FTelemetryStreamServer> Server;
+	TFunction<void(TArray<AMockMissileActor*>&)> CollectMissiles;
+	TFunction<void(FTelemetryStreamSummary&)> CollectSummary;
+	TWeakObjectPtr<UWorld> WorldWeak;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartWorldSeconds = 0.0;
+	double LastStateWorldSeconds = -1.0;
+	double LastSummaryWorldSeconds = -1.0;
+	uint32 SessionId = 0;
+	uint32 StateSequence = 0;
+};
@@ -43,6 +43,17 @@ bool FIndicatorDataLoader::LoadFromString(const FString& JsonString, FIndicatorD
 		OutData.Categories.Add(ParseCategory(CategoryValue->AsObject()));
 	}
 
+	OutData.EvaluationOnlyIndicators.Empty();
+	const TArray<TSharedPtr<FJsonValue>>* EvaluationOnlyArray;
+	if (JsonObject->TryGetArrayField(TEXT("evaluationOnlyIndicators"), EvaluationOnlyArray))
+	{
+		for (const TSharedPtr<FJsonValue>& IndicatorValue : *EvaluationOnlyArray)
+		{
+			if (IndicatorValue->Type != EJson::Object) continue;
+			OutData.EvaluationOnlyIndicators.Add(ParseIndicator(IndicatorValue->AsObject()));
+		}
+	}
+
 	return true;
 }
 
@@ -67,36 +78,7 @@ bool FIndicatorDataLoader::SaveToFile(const FString& FilePath, const FIndicatorD
 			TArray<TSharedPtr<FJsonValue>> IndicatorsArray;
 			for (const FIndicatorInfo& Indicator : SubCat.Indicators)
 			{
-				TSharedPtr<FJsonObject> IndObj = MakeShareable(new FJsonObject);
-				IndObj->SetStringField(TEXT("id"), Indicator.Id);
-				IndObj->SetStringField(TEXT("name"), Indicator.Name);
-				IndObj->SetStringField(TEXT("nameEn"), Indicator.NameEn);
-				IndObj->SetStringField(TEXT("description"), Indicator.Description);
-				IndObj->SetStringField(TEXT("level"), Indicator.Level);
-				
-				// 保存算法名称数组
-				if (Indicator.AlgorithmNames.Num() > 0)
-				{
-					TArray<TSharedPtr<FJsonValue>> AlgorithmNamesArray;
-					for (const FString& Name : Indicator.AlgorithmNames)
-					{
-						AlgorithmNamesArray.Add(MakeShareable(new FJsonValueString(Name)));
-					}
-					IndObj->SetArrayField(TEXT("algorithmNames"), AlgorithmNamesArray);
-				}
-				
-				// 保存分系统名称数组
-				if (Indicator.PrototypeNames.Num() > 0)
-				{
-					TArray<TSharedPtr<FJsonValue>> PrototypeNamesArray;
-					for (const FString& Name : Indicator.PrototypeNames)
-					{
-						PrototypeNamesArray.Add(MakeShareable(new FJsonValueString(Name)));
-					}
-					IndObj->SetArrayField(TEXT("prototypeNames"), PrototypeNamesArray);
-				}
-				
-				IndicatorsArray.Add(MakeShareable(new FJsonValueObject(IndObj)));
+				IndicatorsArray.Add(MakeShareable(new FJsonValueObject(WriteIndicator(Indicator))));
 			}
 			SubCatObj->SetArrayField(TEXT("indicators"), IndicatorsArray);
 			SubCategoriesArray.Add(MakeShareable(new FJsonValueObject(SubCatObj)));
@@ -107,6 +89,16 @@ bool FIndicatorDataLoader::SaveToFile(const FString& FilePath, const FIndicatorD
 
 	JsonObject->SetArrayField(TEXT("categories"), CategoriesArray);
 
+	if (Data.EvaluationOnlyIndicators.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> EvaluationOnlyArray;
+		for (const FIndicatorInfo& Indicator : Data.EvaluationOnlyIndicators)
+		{
+			EvaluationOnlyArray.Add(MakeShareable(new FJsonValueObject(WriteIndicator(Indicator))));
+		}
+		JsonObject->SetArrayField(TEXT("evaluationOnlyIndicators"), EvaluationOnlyArray);
+	}
+
 	FString OutputString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
@@ -114,6 +106,52 @@ bool FIndicatorDataLoader::SaveToFile(const FString& FilePath, const FIndicatorD
 	return FFileHelper::SaveStringToFile(OutputString, *FilePath);
 }
 
+TSharedPtr<FJsonObject> FIndicatorDataLoader::WriteIndicator(const FIndicatorInfo& Indicator)
+{
+	TSharedPtr<FJsonObject> IndObj = MakeShareable(new FJsonObject);
+	IndObj->SetStringField(TEXT("id"), Indicator.Id);
+	IndObj->SetStringField(TEXT("name"), Indicator.Name);
+	IndObj->SetStringField(TEXT("nameEn"), Indicator.NameEn);
+	IndObj->SetStringField(TEXT("description"), Indicator.Description);
+	IndObj->SetStringField(TEXT("level"), Indicator.Level);
+	IndObj->SetNumberField(TEXT("targetValue"), Indicator.TargetValue);
+	IndObj->SetBoolField(TEXT("higherIsBetter"), Indicator.bHigherIsBetter);
+	IndObj->SetStringField(TEXT("unit"), Indicator.Unit);
+	IndObj->SetStringField(TEXT("evaluationRemark"), Indicator.EvaluationRemark);
+	if (!Indicator.Formula.IsEmpty())
+	{
+		IndObj->SetStringField(TEXT("formula"), Indicator.Formula);
+	}
+	if (!Indicator.bRecordBased)
+	{
+		IndObj->SetBoolField(TEXT("recordBased"), false);
+	}
+
+	// 保存算法名称数组
+	if (Indicator.AlgorithmNames.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> AlgorithmNamesArray;
+		for (const FString& Name : Indicator.AlgorithmNames)
+		{
+			AlgorithmNamesArray.Add(MakeShareable(new FJsonValueString(Name)));
+		}
+		IndObj->SetArrayField(TEXT("algorithmNames"), AlgorithmNamesArray);
+	}
+
+	// 保存分系统名称数组
+	if (Indicator.PrototypeNames.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> PrototypeNamesArray;
+		for (const FString& Name : Indicator.PrototypeNames)
+		{
+			PrototypeNamesArray.Add(MakeShareable(new FJsonValueString(Name)));
+		}
+		IndObj->SetArrayField(TEXT("prototypeNames"), PrototypeNamesArray);
+	}
+
+	return IndObj;
+}
+
 FIndicatorInfo FIndicatorDataLoader::ParseIndicator(const TSharedPtr<FJsonObject>& JsonObj)
 {
 	FIndicatorInfo Info;
@@ -122,6 +160,12 @@ FIndicatorInfo FIndicatorDataLoader::ParseIndicator(const TSharedPtr<FJsonObject
 	JsonObj->TryGetStringField(TEXT("nameEn"), Info.NameEn);
 	JsonObj->TryGetStringField(TEXT("description"), Info.Description);
 	JsonObj->TryGetStringField(TEXT("level"), Info.Level);
+	JsonObj->TryGetNumberField(TEXT("targetValue"), Info.TargetValue);
+	JsonObj->TryGetBoolField(TEXT("higherIsBetter"), Info.bHigherIsBetter);
+	JsonObj->TryGetStringField(TEXT("unit"), Info.Unit);
+	JsonObj->TryGetStringField(TEXT("evaluationRemark"), Info.EvaluationRemark);
+	JsonObj->TryGetStringField(TEXT("formula"), Info.Formula);
+	JsonObj->TryGetBoolField(TEXT("recordBased"), Info.bRecordBased);
 	
 	// 解析算法名称数组
 	const TArray<TSharedPtr<FJsonValue>>* AlgorithmNamesArray;
@@ -29,12 +29,36 @@ struct FIndicatorInfo
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString Level;  // "algorithm" 或 "system"，表示算法级还是系统级
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float TargetValue;  // 达标阈值
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHigherIsBetter;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Unit;  // 数值后缀，如 "%"、" s"
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString EvaluationRemark;  // 结果表中的备注
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Formula;  // 计算公式（见 Systems/IndicatorFormula.h），为空表示尚未实现
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRecordBased;  // 由逐发记录统计得出；感知与分裂计数类指标为 false
+
 	FIndicatorInfo()
 		: Id(TEXT(""))
 		, Name(TEXT(""))
 		, NameEn(TEXT(""))
 		, Description(TEXT(""))
 		, Level(TEXT(""))
+		, TargetValue(0.f)
+		, bHigherIsBetter(true)
+		, Unit(TEXT(""))
+		, EvaluationRemark(TEXT(""))
+		, Formula(TEXT(""))
+		, bRecordBased(true)
 	{
 	}
 };
@@ -89,6 +113,9 @@ struct FIndicatorData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FIndicatorCategory> Categories;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FIndicatorInfo> EvaluationOnlyIndicators;  // 参与结果计算但不在指标选择界面列出（感知算法等）
+
 	FIndicatorData()
 	{
 	}
@@ -105,6 +132,7 @@ public:
 	static bool SaveToFile(const FString& FilePath, const FIndicatorData& Data);
 
 private:
+	static TSharedPtr<FJsonObject> WriteIndicator(const FIndicatorInfo& Indicator);
 	static FIndicatorInfo ParseIndicator(const TSharedPtr<FJsonObject>& JsonObj);
 	static FIndicatorSubCategory ParseSubCategory(const TSharedPtr<FJsonObject>& JsonObj);
 	static FIndicatorCategory ParseCategory(const TSharedPtr<FJsonObject>& JsonObj);
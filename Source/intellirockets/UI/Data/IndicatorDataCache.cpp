@@ -0,0 +1,542 @@
+#include "UI/Data/IndicatorDataCache.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarIndicatorBinaryCache(
+		TEXT("ir.Indicators.BinaryCache"),
+		1,
+		TEXT("指标定义是否使用二进制缓存（0 = 每次解析 JSON 且不写缓存）"));
+
+	constexpr uint32 CacheFileMagic = 0x43495249; // "IRIC"
+	// FIndicatorInfo 字段或下列记录布局变化时递增
+	constexpr uint32 CacheFileVersion = 1;
+
+	/** 文件内一段同类记录：起始偏移（4 字节对齐）与记录数 */
+	struct FCacheSection
+	{
+		uint32 Offset = 0;
+		uint32 Count = 0;
+	};
+
+	struct FCacheHeader
+	{
+		uint32 Magic = CacheFileMagic;
+		uint32 Version = CacheFileVersion;
+		uint8 SourceHash[16] = {};
+		uint32 FileSize = 0;
+		uint32 TreeIndicatorCount = 0; // Indicators 中属于分类树的前若干条，其余为 EvaluationOnlyIndicators
+		FCacheSection Strings;         // FCacheString
+		FCacheSection StringData;      // UTF-8 字节
+		FCacheSection Categories;      // FCacheCategory
+		FCacheSection SubCategories;   // FCacheSubCategory
+		FCacheSection Indicators;      // FCacheIndicator
+		FCacheSection NameRefs;        // uint32 字符串下标（算法/分系统名称列表）
+		FCacheSection FilterKeys;      // FCacheFilterKey
+		FCacheSection FilterPostings;  // uint32 扁平指标下标
+	};
+
+	struct FCacheString
+	{
+		uint32 Offset; // 相对 StringData 起点
+		uint32 Length;
+	};
+
+	struct FCacheCategory
+	{
+		uint32 Id;
+		uint32 Name;
+		uint32 FirstSubCategory;
+		uint32 SubCategoryCount;
+	};
+
+	struct FCacheSubCategory
+	{
+		uint32 Id;
+		uint32 Name;
+		uint32 FirstIndicator;
+		uint32 IndicatorCount;
+	};
+
+	struct FCacheIndicator
+	{
+		uint32 Id;
+		uint32 Name;
+		uint32 NameEn;
+		uint32 Description;
+		uint32 Level;
+		uint32 Unit;
+		uint32 EvaluationRemark;
+		uint32 Formula;
+		float TargetValue;
+		uint32 Flags;
+		uint32 FirstAlgorithmName;
+		uint32 AlgorithmNameCount;
+		uint32 FirstPrototypeName;
+		uint32 PrototypeNameCount;
+	};
+
+	enum ECacheIndicatorFlags : uint32
+	{
+		CacheFlag_HigherIsBetter = 1 << 0,
+		CacheFlag_RecordBased = 1 << 1,
+	};
+
+	enum class ECacheFilterKind : uint32
+	{
+		Algorithm = 0,
+		Prototype = 1,
+	};
+
+	struct FCacheFilterKey
+	{
+		uint32 Name;
+		ECacheFilterKind Kind;
+		uint32 FirstPosting;
+		uint32 PostingCount;
+	};
+
+	static_assert(sizeof(FCacheHeader) % 4 == 0 && sizeof(FCacheIndicator) == 56, "Indicator cache records must stay 4-byte packed");
+
+	/** 字符串驻留按大小写区分（FString 默认的 == 与哈希不区分大小写） */
+	struct FCaseSensitiveStringKeyFuncs : BaseKeyFuncs<TPair<FString, uint32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, uint32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/** 写缓存时的顺序缓冲区与字符串驻留表 */
+	class FCacheBuilder
+	{
+	public:
+		uint32 Intern(const FString& Value)
+		{
+			if (const uint32* Existing = StringIndices.Find(Value))
+			{
+				return *Existing;
+			}
+			const FTCHARToUTF8 Utf8(*Value);
+			const uint32 Index = Strings.Num();
+			Strings.Add({ static_cast<uint32>(StringData.Num()), static_cast<uint32>(Utf8.Length()) });
+			StringData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+			StringIndices.Add(Value, Index);
+			return Index;
+		}
+
+		uint32 AddNames(const TArray<FString>& Names, uint32& OutCount)
+		{
+			const uint32 First = NameRefs.Num();
+			for (const FString& Name : Names)
+			{
+				NameRefs.Add(Intern(Name));
+			}
+			OutCount = Names.Num();
+			return First;
+		}
+
+		template <typename T>
+		static FCacheSection AppendSection(TArray<uint8>& Buffer, const T* Data, int32 Count)
+		{
+			FCacheSection Section;
+			Section.Offset = Buffer.Num();
+			Section.Count = Count;
+			Buffer.Append(reinterpret_cast<const uint8*>(Data), Count * sizeof(T));
+			Buffer.AddZeroed(Align(Buffer.Num(), 4) - Buffer.Num());
+			return Section;
+		}
+
+		TArray<FCacheString> Strings;
+		TArray<uint8> StringData;
+		TArray<uint32> NameRefs;
+		TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> StringIndices;
+	};
+
+	/** 读缓存时对各段做边界校验后以数组视图访问（映射内存页对齐，段偏移 4 字节对齐） */
+	class FCacheReader
+	{
+	public:
+		FCacheReader(const uint8* InBytes, int64 InSize)
+			: Bytes(InBytes)
+			, Size(InSize)
+		{
+		}
+
+		template <typename T>
+		bool GetSection(const FCacheSection& Section, TConstArrayView<T>& OutView) const
+		{
+			if (Section.Offset % alignof(T) != 0 || static_cast<uint64>(Section.Offset) + static_cast<uint64>(Section.Count) * sizeof(T) > static_cast<uint64>(Size))
+			{
+				return false;
+			}
+			OutView = TConstArrayView<T>(reinterpret_cast<const T*>(Bytes + Section.Offset), Section.Count);
+			return true;
+		}
+
+	private:
+		const uint8* Bytes;
+		int64 Size;
+	};
+
+	bool IsValidRange(uint32 First, uint32 Count, int32 Num)
+	{
+		return static_cast<uint64>(First) + Count <= static_cast<uint64>(Num);
+	}
+}
+
+void FIndicatorCatalog::BuildIndices()
+{
+	IndicatorCount = 0;
+	IndicatorsByAlgorithm.Reset();
+	IndicatorsByPrototype.Reset();
+
+	const auto AddPostings = [](TMap<FString, TArray<int32>>& Index, const TArray<FString>& Names, int32 FlatIndex)
+	{
+		for (const FString& Name : Names)
+		{
+			TArray<int32>& Postings = Index.FindOrAdd(Name);
+			if (Postings.Num() == 0 || Postings.Last() != FlatIndex)
+			{
+				Postings.Add(FlatIndex);
+			}
+		}
+	};
+
+	for (const FIndicatorCategory& Category : Data.Categories)
+	{
+		for (const FIndicatorSubCategory& SubCategory : Category.SubCategories)
+		{
+			for (const FIndicatorInfo& Indicator : SubCategory.Indicators)
+			{
+				AddPostings(IndicatorsByAlgorithm, Indicator.AlgorithmNames, IndicatorCount);
+				AddPostings(IndicatorsByPrototype, Indicator.PrototypeNames, IndicatorCount);
+				++IndicatorCount;
+			}
+		}
+	}
+}
+
+FString FIndicatorDataCache::GetCachePath(const FString& SourcePath)
+{
+	const FString FullPath = FPaths::ConvertRelativePathToFull(SourcePath);
+	return FPaths::ProjectSavedDir() / TEXT("Cache") / FString::Printf(TEXT("%s-%08x.ircache"), *FPaths::GetBaseFilename(SourcePath), FCrc::StrCrc32(*FullPath));
+}
+
+bool FIndicatorDataCache::Load(const FString& SourcePath, FIndicatorCatalog& OutCatalog)
+{
+	OutCatalog = FIndicatorCatalog();
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	TArray<uint8> SourceBytes;
+	if (!FFileHelper::LoadFileToArray(SourceBytes, *SourcePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load indicator file: %s"), *SourcePath);
+		return false;
+	}
+
+	uint8 SourceHash[16];
+	FMD5 Md5;
+	Md5.Update(SourceBytes.GetData(), SourceBytes.Num());
+	Md5.Final(SourceHash);
+
+	const bool bUseCache = CVarIndicatorBinaryCache.GetValueOnAnyThread() != 0;
+	const FString CachePath = GetCachePath(SourcePath);
+	if (bUseCache && ReadCache(CachePath, SourceHash, OutCatalog))
+	{
+		UE_LOG(LogTemp, Log, TEXT("IndicatorDataCache: %d indicators from cache in %.2f ms"),
+			OutCatalog.IndicatorCount, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+		return true;
+	}
+
+	OutCatalog = FIndicatorCatalog();
+	FString JsonString;
+	FFileHelper::BufferToString(JsonString, SourceBytes.GetData(), SourceBytes.Num());
+	if (!FIndicatorDataLoader::LoadFromString(JsonString, OutCatalog.Data))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse indicator file: %s"), *SourcePath);
+		return false;
+	}
+	OutCatalog.BuildIndices();
+
+	if (bUseCache && !WriteCache(CachePath, SourceHash, OutCatalog))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("IndicatorDataCache: 无法写入缓存 %s"), *CachePath);
+	}
+	UE_LOG(LogTemp, Log, TEXT("IndicatorDataCache: %d indicators parsed from JSON in %.2f ms"),
+		OutCatalog.IndicatorCount, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return true;
+}
+
+bool FIndicatorDataCache::ReadCache(const FString& CachePath, const uint8 (&SourceHash)[16], FIndicatorCatalog& OutCatalog)
+{
+	if (!IFileManager::Get().FileExists(*CachePath))
+	{
+		return false;
+	}
+
+	// 区域需先于文件句柄释放
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CachePath));
+	if (MappedFile)
+	{
+		TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (Region)
+		{
+			return ParseCache(Region->GetMappedPtr(), Region->GetMappedSize(), SourceHash, OutCatalog);
+		}
+	}
+
+	// 平台不支持内存映射时整块读入
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *CachePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+	return ParseCache(Bytes.GetData(), Bytes.Num(), SourceHash, OutCatalog);
+}
+
+bool FIndicatorDataCache::ParseCache(const uint8* Bytes, int64 Size, const uint8 (&SourceHash)[16], FIndicatorCatalog& OutCatalog)
+{
+	if (!Bytes || Size < static_cast<int64>(sizeof(FCacheHeader)))
+	{
+		return false;
+	}
+
+	FCacheHeader Header;
+	FMemory::Memcpy(&Header, Bytes, sizeof(Header));
+	if (Header.Magic != CacheFileMagic || Header.Version != CacheFileVersion || static_cast<int64>(Header.FileSize) != Size
+		|| FMemory::Memcmp(Header.SourceHash, SourceHash, sizeof(Header.SourceHash)) != 0)
+	{
+		return false;
+	}
+
+	const FCacheReader Reader(Bytes, Size);
+	TConstArrayView<FCacheString> Strings;
+	TConstArrayView<uint8> StringData;
+	TConstArrayView<FCacheCategory> Categories;
+	TConstArrayView<FCacheSubCategory> SubCategories;
+	TConstArrayView<FCacheIndicator> Indicators;
+	TConstArrayView<uint32> NameRefs;
+	TConstArrayView<FCacheFilterKey> FilterKeys;
+	TConstArrayView<uint32> FilterPostings;
+	if (!Reader.GetSection(Header.Strings, Strings) || !Reader.GetSection(Header.StringData, StringData)
+		|| !Reader.GetSection(Header.Categories, Categories) || !Reader.GetSection(Header.SubCategories, SubCategories)
+		|| !Reader.GetSection(Header.Indicators, Indicators) || !Reader.GetSection(Header.NameRefs, NameRefs)
+		|| !Reader.GetSection(Header.FilterKeys, FilterKeys) || !Reader.GetSection(Header.FilterPostings, FilterPostings)
+		|| Header.TreeIndicatorCount > static_cast<uint32>(Indicators.Num()))
+	{
+		return false;
+	}
+
+	// 驻留字符串只解码一次，各记录按下标引用
+	TArray<FString> DecodedStrings;
+	DecodedStrings.Reserve(Strings.Num());
+	for (const FCacheString& String : Strings)
+	{
+		if (!IsValidRange(String.Offset, String.Length, StringData.Num()))
+		{
+			return false;
+		}
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(StringData.GetData() + String.Offset), String.Length);
+		DecodedStrings.Emplace(Converted.Length(), Converted.Get());
+	}
+
+	bool bValid = true;
+	const auto GetString = [&DecodedStrings, &bValid](uint32 Index) -> const FString&
+	{
+		if (!DecodedStrings.IsValidIndex(Index))
+		{
+			bValid = false;
+			static const FString Empty;
+			return Empty;
+		}
+		return DecodedStrings[Index];
+	};
+	const auto GetNames = [&NameRefs, &GetString, &bValid](uint32 First, uint32 Count, TArray<FString>& OutNames)
+	{
+		if (!IsValidRange(First, Count, NameRefs.Num()))
+		{
+			bValid = false;
+			return;
+		}
+		OutNames.Reserve(Count);
+		for (uint32 Index = First; Index < First + Count; ++Index)
+		{
+			OutNames.Add(GetString(NameRefs[Index]));
+		}
+	};
+	const auto ReadIndicator = [&GetString, &GetNames](const FCacheIndicator& Record)
+	{
+		FIndicatorInfo Info;
+		Info.Id = GetString(Record.Id);
+		Info.Name = GetString(Record.Name);
+		Info.NameEn = GetString(Record.NameEn);
+		Info.Description = GetString(Record.Description);
+		Info.Level = GetString(Record.Level);
+		Info.Unit = GetString(Record.Unit);
+		Info.EvaluationRemark = GetString(Record.EvaluationRemark);
+		Info.Formula = GetString(Record.Formula);
+		Info.TargetValue = Record.TargetValue;
+		Info.bHigherIsBetter = (Record.Flags & CacheFlag_HigherIsBetter) != 0;
+		Info.bRecordBased = (Record.Flags & CacheFlag_RecordBased) != 0;
+		GetNames(Record.FirstAlgorithmName, Record.AlgorithmNameCount, Info.AlgorithmNames);
+		GetNames(Record.FirstPrototypeName, Record.PrototypeNameCount, Info.PrototypeNames);
+		return Info;
+	};
+
+	FIndicatorData& Data = OutCatalog.Data;
+	Data.Categories.Reserve(Categories.Num());
+	for (const FCacheCategory& CategoryRecord : Categories)
+	{
+		if (!IsValidRange(CategoryRecord.FirstSubCategory, CategoryRecord.SubCategoryCount, SubCategories.Num()))
+		{
+			return false;
+		}
+
+		FIndicatorCategory& Category = Data.Categories.AddDefaulted_GetRef();
+		Category.Id = GetString(CategoryRecord.Id);
+		Category.Name = GetString(CategoryRecord.Name);
+		Category.SubCategories.Reserve(CategoryRecord.SubCategoryCount);
+		for (const FCacheSubCategory& SubCategoryRecord : SubCategories.Slice(CategoryRecord.FirstSubCategory, CategoryRecord.SubCategoryCount))
+		{
+			if (!IsValidRange(SubCategoryRecord.FirstIndicator, SubCategoryRecord.IndicatorCount, Header.TreeIndicatorCount))
+			{
+				return false;
+			}
+
+			FIndicatorSubCategory& SubCategory = Category.SubCategories.AddDefaulted_GetRef();
+			SubCategory.Id = GetString(SubCategoryRecord.Id);
+			SubCategory.Name = GetString(SubCategoryRecord.Name);
+			SubCategory.Indicators.Reserve(SubCategoryRecord.IndicatorCount);
+			for (const FCacheIndicator& IndicatorRecord : Indicators.Slice(SubCategoryRecord.FirstIndicator, SubCategoryRecord.IndicatorCount))
+			{
+				SubCategory.Indicators.Add(ReadIndicator(IndicatorRecord));
+			}
+		}
+	}
+	for (const FCacheIndicator& IndicatorRecord : Indicators.Slice(Header.TreeIndicatorCount, Indicators.Num() - Header.TreeIndicatorCount))
+	{
+		Data.EvaluationOnlyIndicators.Add(ReadIndicator(IndicatorRecord));
+	}
+
+	OutCatalog.IndicatorCount = Header.TreeIndicatorCount;
+	for (const FCacheFilterKey& Key : FilterKeys)
+	{
+		if (!IsValidRange(Key.FirstPosting, Key.PostingCount, FilterPostings.Num()))
+		{
+			return false;
+		}
+		TMap<FString, TArray<int32>>& Index = Key.Kind == ECacheFilterKind::Algorithm ? OutCatalog.IndicatorsByAlgorithm : OutCatalog.IndicatorsByPrototype;
+		TArray<int32>& Postings = Index.Add(GetString(Key.Name));
+		for (const uint32 Posting : FilterPostings.Slice(Key.FirstPosting, Key.PostingCount))
+		{
+			if (Posting >= Header.TreeIndicatorCount)
+			{
+				return false;
+			}
+			Postings.Add(static_cast<int32>(Posting));
+		}
+	}
+
+	return bValid;
+}
+
+bool FIndicatorDataCache::WriteCache(const FString& CachePath, const uint8 (&SourceHash)[16], const FIndicatorCatalog& Catalog)
+{
+	FCacheBuilder Builder;
+	TArray<FCacheCategory> Categories;
+	TArray<FCacheSubCategory> SubCategories;
+	TArray<FCacheIndicator> Indicators;
+
+	const auto AddIndicator = [&Builder, &Indicators](const FIndicatorInfo& Info)
+	{
+		FCacheIndicator& Record = Indicators.AddZeroed_GetRef();
+		Record.Id = Builder.Intern(Info.Id);
+		Record.Name = Builder.Intern(Info.Name);
+		Record.NameEn = Builder.Intern(Info.NameEn);
+		Record.Description = Builder.Intern(Info.Description);
+		Record.Level = Builder.Intern(Info.Level);
+		Record.Unit = Builder.Intern(Info.Unit);
+		Record.EvaluationRemark = Builder.Intern(Info.EvaluationRemark);
+		Record.Formula = Builder.Intern(Info.Formula);
+		Record.TargetValue = Info.TargetValue;
+		Record.Flags = (Info.bHigherIsBetter ? CacheFlag_HigherIsBetter : 0) | (Info.bRecordBased ? CacheFlag_RecordBased : 0);
+		Record.FirstAlgorithmName = Builder.AddNames(Info.AlgorithmNames, Record.AlgorithmNameCount);
+		Record.FirstPrototypeName = Builder.AddNames(Info.PrototypeNames, Record.PrototypeNameCount);
+	};
+
+	for (const FIndicatorCategory& Category : Catalog.Data.Categories)
+	{
+		Categories.Add({ Builder.Intern(Category.Id), Builder.Intern(Category.Name), static_cast<uint32>(SubCategories.Num()), static_cast<uint32>(Category.SubCategories.Num()) });
+		for (const FIndicatorSubCategory& SubCategory : Category.SubCategories)
+		{
+			SubCategories.Add({ Builder.Intern(SubCategory.Id), Builder.Intern(SubCategory.Name), static_cast<uint32>(Indicators.Num()), static_cast<uint32>(SubCategory.Indicators.Num()) });
+			for (const FIndicatorInfo& Indicator : SubCategory.Indicators)
+			{
+				AddIndicator(Indicator);
+			}
+		}
+	}
+	const uint32 TreeIndicatorCount = Indicators.Num();
+	for (const FIndicatorInfo& Indicator : Catalog.Data.EvaluationOnlyIndicators)
+	{
+		AddIndicator(Indicator);
+	}
+
+	TArray<FCacheFilterKey> FilterKeys;
+	TArray<uint32> FilterPostings;
+	const auto AddFilterKeys = [&Builder, &FilterKeys, &FilterPostings](const TMap<FString, TArray<int32>>& Index, ECacheFilterKind Kind)
+	{
+		for (const TPair<FString, TArray<int32>>& Pair : Index)
+		{
+			FilterKeys.Add({ Builder.Intern(Pair.Key), Kind, static_cast<uint32>(FilterPostings.Num()), static_cast<uint32>(Pair.Value.Num()) });
+			for (const int32 Posting : Pair.Value)
+			{
+				FilterPostings.Add(Posting);
+			}
+		}
+	};
+	AddFilterKeys(Catalog.IndicatorsByAlgorithm, ECacheFilterKind::Algorithm);
+	AddFilterKeys(Catalog.IndicatorsByPrototype, ECacheFilterKind::Prototype);
+
+	// 头部先占位，各段写完后回填偏移
+	FCacheHeader Header;
+	FMemory::Memcpy(Header.SourceHash, SourceHash, sizeof(Header.SourceHash));
+	Header.TreeIndicatorCount = TreeIndicatorCount;
+
+	TArray<uint8> Buffer;
+	Buffer.AddZeroed(sizeof(FCacheHeader));
+	Header.Strings = FCacheBuilder::AppendSection(Buffer, Builder.Strings.GetData(), Builder.Strings.Num());
+	Header.StringData = FCacheBuilder::AppendSection(Buffer, Builder.StringData.GetData(), Builder.StringData.Num());
+	Header.Categories = FCacheBuilder::AppendSection(Buffer, Categories.GetData(), Categories.Num());
+	Header.SubCategories = FCacheBuilder::AppendSection(Buffer, SubCategories.GetData(), SubCategories.Num());
+	Header.Indicators = FCacheBuilder::AppendSection(Buffer, Indicators.GetData(), Indicators.Num());
+	Header.NameRefs = FCacheBuilder::AppendSection(Buffer, Builder.NameRefs.GetData(), Builder.NameRefs.Num());
+	Header.FilterKeys = FCacheBuilder::AppendSection(Buffer, FilterKeys.GetData(), FilterKeys.Num());
+	Header.FilterPostings = FCacheBuilder::AppendSection(Buffer, FilterPostings.GetData(), FilterPostings.Num());
+	Header.FileSize = Buffer.Num();
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(Header));
+
+	// 先写临时文件再替换，避免并行启动的工作进程读到半个缓存
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.MakeDirectory(*FPaths::GetPath(CachePath), true);
+	const FString TempPath = CachePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath))
+	{
+		return false;
+	}
+	if (!FileManager.Move(*CachePath, *TempPath, true, true))
+	{
+		FileManager.Delete(*TempPath, false, false, true);
+		return false;
+	}
+	return true;
+}
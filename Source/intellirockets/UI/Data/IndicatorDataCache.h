@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/Data/IndicatorData.h"
+
+/**
+ * 指标定义及其过滤索引。
+ * 指标的扁平下标按 分类 -> 子分类 -> 指标 的遍历顺序编号，仅覆盖分类树中的指标（不含 EvaluationOnlyIndicators）。
+ */
+struct FIndicatorCatalog
+{
+	FIndicatorData Data;
+	int32 IndicatorCount = 0;
+	TMap<FString, TArray<int32>> IndicatorsByAlgorithm; // 算法名称 -> 扁平下标（升序）
+	TMap<FString, TArray<int32>> IndicatorsByPrototype; // 分系统名称 -> 扁平下标（升序）
+
+	/** 由 Data 重新生成扁平计数与过滤索引 */
+	void BuildIndices();
+};
+
+/**
+ * DecisionIndicators.json 的二进制缓存（Saved/Cache/<文件名>-<路径CRC>.ircache）：
+ * 文件头记录格式版本与源文件 MD5，其后为驻留字符串表、分类/子分类/指标的扁平数组与过滤索引。
+ * 源文件内容变化或版本不一致时重新解析 JSON 并重写缓存；缓存以内存映射方式读取，映射不可用时整块读入。
+ */
+class FIndicatorDataCache
+{
+public:
+	/** 加载指标定义：命中缓存则直接读取，否则解析并校验 JSON 后写出新缓存 */
+	static bool Load(const FString& SourcePath, FIndicatorCatalog& OutCatalog);
+
+	static FString GetCachePath(const FString& SourcePath);
+
+private:
+	static bool ReadCache(const FString& CachePath, const uint8 (&SourceHash)[16], FIndicatorCatalog& OutCatalog);
+	static bool ParseCache(const uint8* Bytes, int64 Size, const uint8 (&SourceHash)[16], FIndicatorCatalog& OutCatalog);
+	static bool WriteCache(const FString& CachePath, const uint8 (&SourceHash)[16], const FIndicatorCatalog& Catalog);
+};
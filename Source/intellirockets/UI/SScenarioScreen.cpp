@@ -7,6 +7,9 @@
 #include "UI/Styles/ScenarioStyle.h"
 #include "Systems/ScenarioMenuSubsystem.h"
 #include "Systems/ScenarioTestMetrics.h"
+#include "Systems/ScenarioConfigIO.h"
+#include "Systems/OrthogonalDesign.h"
+#include "Systems/ScenarioAssetPreloader.h"
 #include "Misc/PackageName.h"
 
 #include "Widgets/Layout/SBorder.h"
@@ -19,6 +22,8 @@
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SGridPanel.h"
+#include "Widgets/Layout/SExpandableArea.h"
+#include "Widgets/Notifications/SProgressBar.h"
 
 void SScenarioScreen::Construct(const FArguments& InArgs)
 {
@@ -689,6 +694,42 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep4()
 		]
 	];
 	
+	// 场景资源预加载进度（Step3 确认后在后台加载，完成后隐藏）
+	FinalContainer->AddSlot().AutoHeight().Padding(0.f,0.f,0.f,12.f)
+	[
+		SNew(STextBlock)
+		.Visibility_Lambda([]()
+		{
+			return FScenarioAssetPreloader::Get().IsLoading() ? EVisibility::Visible : EVisibility::Collapsed;
+		})
+		.Text_Lambda([]()
+		{
+			const FScenarioAssetPreloader& Preloader = FScenarioAssetPreloader::Get();
+			return FText::FromString(FString::Printf(TEXT("正在预加载场景资源（%d 项）… %d%%"),
+				Preloader.GetRequestedAssetCount(), FMath::RoundToInt(Preloader.GetProgress() * 100.f)));
+		})
+		.ColorAndOpacity(ScenarioStyle::TextDim)
+		.Font(ScenarioStyle::Font(12))
+		.Justification(ETextJustify::Center)
+	];
+
+	// 正交测试方法：提供按正交表批量执行的入口
+	if (Snapshot.TestMethodTypeIndex == 1)
+	{
+		FinalContainer->AddSlot().AutoHeight().Padding(0.f,0.f,0.f,12.f)
+		[
+			BuildOrthogonalBatchCard(Snapshot)
+		];
+	}
+	// 随机采样测试方法：提供重复随机部署直到统计收敛的入口
+	else if (Snapshot.TestMethodTypeIndex == 0)
+	{
+		FinalContainer->AddSlot().AutoHeight().Padding(0.f,0.f,0.f,12.f)
+		[
+			BuildMonteCarloCard()
+		];
+	}
+
 	// 三列布局
 	FinalContainer->AddSlot().AutoHeight().Padding(0.f,0.f,0.f,12.f)
 	[
@@ -1115,18 +1156,11 @@ bool SScenarioScreen::CollectScenarioConfig(FScenarioTestConfig& OutConfig) cons
 		OutConfig.PresetIndex = -1;
 	}
 
-	static const TCHAR* MapLevelPaths[] =
-	{
-		TEXT("/Game/Desert/Desert"),
-		TEXT("/Game/EF_Grounds/Maps/ExampleMap"),
-		TEXT("/Game/ProceduralNtr_vol2/maps/Demo_Scene"),
-		TEXT("/Game/MWLandscapeAutoMaterial/Maps/LandscapeAutoMaterial_Island_Example")  // 插件地图使用插件路径格式（不带/Game/前缀）
-	};
 	bool bPackageExists = false;
-	if (OutConfig.MapIndex >= 0 && OutConfig.MapIndex < UE_ARRAY_COUNT(MapLevelPaths))
+	if (const TCHAR* LevelPath = ScenarioConfigIO::GetMapLevelPath(OutConfig.MapIndex))
 	{
 		// 校验关卡包是否存在，不存在则置空，避免 OpenLevel 失败无反馈
-		FString LevelRef = MapLevelPaths[OutConfig.MapIndex];
+		FString LevelRef = LevelPath;
 		{
 			// 允许传递 /Game/Path/Level 的地图名；检查对应包是否存在
 			// 这里只能做轻量校验：若编辑器环境无法确认，则继续沿用默认行为
@@ -1222,6 +1256,28 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 	UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
 	const bool bHasData = Subsystem && Subsystem->HasMissileTestData();
 
+	const bool bHasOrthogonalResults = Subsystem && Subsystem->HasOrthogonalResults();
+	const bool bHasMonteCarloResults = Subsystem && Subsystem->HasMonteCarloResults();
+
+	if (!bHasData && (bHasOrthogonalResults || bHasMonteCarloResults))
+	{
+		Root->AddSlot()
+		.FillHeight(1.f)
+		[
+			SNew(SScrollBox)
+			+ SScrollBox::Slot()
+			[
+				BuildMonteCarloPanel()
+			]
+			+ SScrollBox::Slot()
+			[
+				BuildOrthogonalEffectsPanel()
+			]
+		];
+
+		return Root;
+	}
+
 	if (!bHasData)
 	{
 		Root->AddSlot()
@@ -1310,14 +1366,228 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 		]
 	];
 
+	// 仿真性能（可折叠）：降帧时结果标记为可疑
+	const FScenarioPerformanceStats& Perf = Summary.Performance;
+	if (Perf.bValid)
+	{
+		if (Perf.bDegradedFrameRate)
+		{
+			ContentBox->AddSlot()
+			.AutoHeight()
+			.Padding(0.f, 8.f, 0.f, 0.f)
+			[
+				SNew(SBorder)
+				.Padding(10.f)
+				.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+				.BorderBackgroundColor(ScenarioStyle::Panel)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(FString::Printf(TEXT("结果可疑：测试期间帧率下降（%s），建议降低负载后重新测试。"), *Perf.DegradedReason)))
+					.ColorAndOpacity(FLinearColor(0.85f, 0.2f, 0.2f))
+					.Font(ScenarioStyle::BoldFont(12))
+					.AutoWrapText(true)
+				]
+			];
+		}
+
+		TSharedRef<SGridPanel> PerfGrid = SNew(SGridPanel)
+			.FillColumn(0, 0.45f)
+			.FillColumn(1, 0.55f);
+
+		int32 PerfRow = 0;
+		const auto AddPerfRow = [&PerfGrid, &PerfRow](const FString& Label, const FString& Value, const FLinearColor& Color)
+		{
+			PerfGrid->AddSlot(0, PerfRow)
+			.Padding(FMargin(0.f, 2.f, 8.f, 2.f))
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Label))
+				.ColorAndOpacity(ScenarioStyle::TextDim)
+				.Font(ScenarioStyle::Font(12))
+			];
+
+			PerfGrid->AddSlot(1, PerfRow)
+			.Padding(FMargin(0.f, 2.f))
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Value))
+				.ColorAndOpacity(Color)
+				.Font(ScenarioStyle::BoldFont(12))
+			];
+			++PerfRow;
+		};
+
+		AddPerfRow(TEXT("帧数 / 平均帧率"), FString::Printf(TEXT("%d / %.1f FPS"), Perf.FrameCount, Perf.AverageFps), Perf.bDegradedFrameRate ? FLinearColor(0.85f, 0.2f, 0.2f) : ScenarioStyle::Text);
+		AddPerfRow(TEXT("平均 / 最大帧耗时"), FString::Printf(TEXT("%.1f ms / %.1f ms"), Perf.AverageFrameTimeMs, Perf.MaxFrameTimeMs), ScenarioStyle::Text);
+		AddPerfRow(TEXT("仿真时间 / 真实时间"), FString::Printf(TEXT("%.2f s / %.2f s（%.2f）"), Perf.SimDuration, Perf.WallDuration, Perf.SimToWallRatio), ScenarioStyle::Text);
+		AddPerfRow(TEXT("同时在飞导弹峰值"), FString::FromInt(Perf.PeakConcurrentMissiles), ScenarioStyle::Accent);
+		AddPerfRow(TEXT("导弹生成 / 销毁"), FString::Printf(TEXT("%d / %d"), Perf.MissileSpawnCount, Perf.MissileDestroyCount), ScenarioStyle::Text);
+		AddPerfRow(TEXT("拦截弹生成 / 销毁"), FString::Printf(TEXT("%d / %d"), Perf.InterceptorSpawnCount, Perf.InterceptorDestroyCount), ScenarioStyle::Text);
+		AddPerfRow(TEXT("蓝方单位生成 / 摧毁"), FString::Printf(TEXT("%d / %d"), Perf.BlueUnitSpawnCount, Perf.BlueUnitDestroyCount), ScenarioStyle::Text);
+		AddPerfRow(TEXT("射线检测次数"), FString::Printf(TEXT("%lld"), Perf.TraceCount), ScenarioStyle::Text);
+
+		// 帧耗时直方图：每个分桶一行，条形宽度按占比缩放
+		const float* BucketEdges = FScenarioPerformanceStats::GetFrameTimeBucketEdges();
+		for (int32 Bucket = 0; Bucket < FScenarioPerformanceStats::NumFrameTimeBuckets; ++Bucket)
+		{
+			const FString BucketLabel = Bucket == 0
+				? FString::Printf(TEXT("帧耗时 < %.1f ms"), BucketEdges[0])
+				: (Bucket == FScenarioPerformanceStats::NumFrameTimeBuckets - 1
+					? FString::Printf(TEXT("帧耗时 >= %.1f ms"), BucketEdges[Bucket - 1])
+					: FString::Printf(TEXT("帧耗时 %.1f - %.1f ms"), BucketEdges[Bucket - 1], BucketEdges[Bucket]));
+			const int32 BucketCount = Perf.FrameTimeHistogram[Bucket];
+			const float Ratio = Perf.FrameCount > 0 ? static_cast<float>(BucketCount) / Perf.FrameCount : 0.f;
+			const bool bSlowBucket = Bucket >= 3;
+
+			PerfGrid->AddSlot(0, PerfRow)
+			.Padding(FMargin(0.f, 2.f, 8.f, 2.f))
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(BucketLabel))
+				.ColorAndOpacity(ScenarioStyle::TextDim)
+				.Font(ScenarioStyle::Font(11))
+			];
+
+			PerfGrid->AddSlot(1, PerfRow)
+			.Padding(FMargin(0.f, 2.f))
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SBox)
+					.WidthOverride(FMath::Max(2.f, 240.f * Ratio))
+					.HeightOverride(10.f)
+					[
+						SNew(SBorder)
+						.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+						.BorderBackgroundColor(bSlowBucket ? FLinearColor(0.85f, 0.2f, 0.2f) : ScenarioStyle::Accent)
+					]
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f, 0.f, 0.f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(FString::Printf(TEXT("%d（%.1f%%）"), BucketCount, Ratio * 100.f)))
+					.ColorAndOpacity(ScenarioStyle::Text)
+					.Font(ScenarioStyle::Font(11))
+				]
+			];
+			++PerfRow;
+		}
+
+		ContentBox->AddSlot()
+		.AutoHeight()
+		.Padding(0.f, 12.f, 0.f, 0.f)
+		[
+			SNew(SExpandableArea)
+			.InitiallyCollapsed(!Perf.bDegradedFrameRate)
+			.BorderBackgroundColor(ScenarioStyle::Panel)
+			.HeaderContent()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Perf.bDegradedFrameRate ? TEXT("仿真性能（结果可疑）") : TEXT("仿真性能")))
+				.ColorAndOpacity(Perf.bDegradedFrameRate ? FLinearColor(0.85f, 0.2f, 0.2f) : ScenarioStyle::Text)
+				.Font(ScenarioStyle::BoldFont(14))
+			]
+			.BodyContent()
+			[
+				SNew(SBorder)
+				.Padding(12.f)
+				.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+				.BorderBackgroundColor(ScenarioStyle::Panel)
+				[
+					PerfGrid
+				]
+			]
+		];
+	}
+
+	constexpr int32 MaxRows = 50;
+	const int32 StartIndex = FMath::Max(0, Records.Num() - MaxRows);
+
 	ContentBox->AddSlot()
 	.AutoHeight()
 	.Padding(0.f, 12.f, 0.f, 8.f)
 	[
-		SNew(STextBlock)
-		.Text(FText::FromString(TEXT("发射明细（按时间排序）")))
-		.ColorAndOpacity(ScenarioStyle::Text)
-		.Font(ScenarioStyle::BoldFont(14))
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(StartIndex > 0
+				? FString::Printf(TEXT("发射明细（按时间排序，显示最近 %d 条 / 共 %d 条）"), MaxRows, Records.Num())
+				: FString(TEXT("发射明细（按时间排序）"))))
+			.ColorAndOpacity(ScenarioStyle::Text)
+			.Font(ScenarioStyle::BoldFont(14))
+		]
+		+ SHorizontalBox::Slot().FillWidth(1.f)
+		[
+			SNew(SSpacer)
+		]
+		// 导出全部记录：后台线程写出，进度条显示进度
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f)
+		[
+			SNew(SButton)
+			.ButtonStyle(FCoreStyle::Get(), "Button")
+			.ContentPadding(FMargin(12.f, 6.f))
+			.IsEnabled_Lambda([this]()
+			{
+				const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+				return Subsystem && !Subsystem->GetResultsExporter().IsRunning();
+			})
+			.OnClicked_Lambda([this]()
+			{
+				if (UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get())
+				{
+					Subsystem->StartResultsExport();
+				}
+				return FReply::Handled();
+			})
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("导出全部结果（CSV/列式）")))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::Font(12))
+			]
+		]
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+		[
+			SNew(SBox)
+			.WidthOverride(160.f)
+			.Visibility_Lambda([this]()
+			{
+				const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+				return Subsystem && Subsystem->GetResultsExporter().IsRunning() ? EVisibility::Visible : EVisibility::Collapsed;
+			})
+			[
+				SNew(SProgressBar)
+				.Percent_Lambda([this]() -> TOptional<float>
+				{
+					const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+					return Subsystem ? Subsystem->GetResultsExporter().GetProgress() : 0.f;
+				})
+			]
+		]
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f, 0.f, 0.f)
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]()
+			{
+				const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+				if (!Subsystem || Subsystem->GetResultsExporter().GetOutputDirectory().IsEmpty())
+				{
+					return FText::GetEmpty();
+				}
+				const FScenarioResultsExporter& Exporter = Subsystem->GetResultsExporter();
+				if (Exporter.IsRunning())
+				{
+					return FText::FromString(FString::Printf(TEXT("导出中 %.0f%%"), Exporter.GetProgress() * 100.f));
+				}
+				return FText::FromString(Exporter.HasSucceeded()
+					? FString::Printf(TEXT("已导出 %d 条到 %s"), Exporter.GetRowCount(), *Exporter.GetOutputDirectory())
+					: FString(TEXT("导出失败或已取消，详见日志")));
+			})
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::Font(11))
+		]
 	];
 
 	TSharedRef<SVerticalBox> TableHeader = SNew(SVerticalBox)
@@ -1335,9 +1605,6 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 
 	TSharedRef<SScrollBox> Scroll = SNew(SScrollBox);
 
-	constexpr int32 MaxRows = 50;
-	const int32 StartIndex = FMath::Max(0, Records.Num() - MaxRows);
-
 	for (int32 Index = StartIndex; Index < Records.Num(); ++Index)
 	{
 		const FMissileTestRecord& Record = Records[Index];
@@ -1464,7 +1731,7 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 	{
 		TSharedRef<SVerticalBox> IndicatorTable = SNew(SVerticalBox);
 
-		const auto AddIndicatorRow = [&IndicatorTable](int32 Index, const FIndicatorEvaluationResult& Eval)
+		const auto AddIndicatorRow = [this, &IndicatorTable](int32 Index, const FIndicatorEvaluationResult& Eval)
 		{
 			IndicatorTable->AddSlot().AutoHeight()
 			[
@@ -1507,6 +1774,14 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 							.Font(ScenarioStyle::BoldFont(11))
 						]
 					]
+					// 置信结论在后台计算，完成前显示进度
+					+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 4.f, 0.f, 0.f)
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this, Index]() { return GetIndicatorConfidenceText(Index); })
+						.ColorAndOpacity_Lambda([this, Index]() { return GetIndicatorConfidenceColor(Index); })
+						.Font(ScenarioStyle::Font(11))
+					]
 					+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 4.f, 0.f, 0.f)
 					[
 						SNew(STextBlock)
@@ -1544,6 +1819,47 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 		];
 	}
 
+	ContentBox->AddSlot()
+	.AutoHeight()
+	.Padding(0.f, 16.f, 0.f, 0.f)
+	[
+		BuildResultsHistoryPanel()
+	];
+
+	ContentBox->AddSlot()
+	.AutoHeight()
+	.Padding(0.f, 16.f, 0.f, 0.f)
+	[
+		BuildEnvironmentSensitivityPanel()
+	];
+
+	ContentBox->AddSlot()
+	.AutoHeight()
+	.Padding(0.f, 16.f, 0.f, 0.f)
+	[
+		BuildBranchComparisonPanel()
+	];
+
+	if (bHasMonteCarloResults)
+	{
+		ContentBox->AddSlot()
+		.AutoHeight()
+		.Padding(0.f, 12.f, 0.f, 0.f)
+		[
+			BuildMonteCarloPanel()
+		];
+	}
+
+	if (bHasOrthogonalResults)
+	{
+		ContentBox->AddSlot()
+		.AutoHeight()
+		.Padding(0.f, 12.f, 0.f, 0.f)
+		[
+			BuildOrthogonalEffectsPanel()
+		];
+	}
+
 	// 将内容容器放在滚动框中
 	Root->AddSlot()
 	.FillHeight(1.f)
@@ -1558,75 +1874,1041 @@ TSharedRef<SWidget> SScenarioScreen::BuildDecisionStep5()
 	return Root;
 }
 
-TSharedRef<SWidget> SScenarioScreen::BuildPerceptionContent()
+TSharedRef<SWidget> SScenarioScreen::BuildOrthogonalBatchCard(const FScenarioTestConfig& Snapshot)
 {
-	// 与决策 Tab 完全一致的面板与按钮，确保样式/间距/按钮完全相同
-	UE_LOG(LogTemp, Log, TEXT("BuildPerceptionContent called - reuse BuildDecisionContent"));
-	return BuildDecisionContent();
-}
+	FOrthogonalDesign Design;
+	OrthogonalDesign::GenerateDesign(Snapshot, TArray<EScenarioFactor>(), EOrthogonalArrayType::Auto, Design);
 
-void SScenarioScreen::UpdateIndicatorFilter()
-{
-	if (!IndicatorSelector.IsValid())
-	{
-		return;
-	}
-	
-	const bool bPerception = (ActiveTabIndex == 0);
-	
-	// 获取Step1的选择状态
-	TArray<FString> SelectedAlgorithmNames;
-	TArray<FString> SelectedPrototypeNames;
-	bool bHasAlgorithmSelection = false;
-	bool bHasPrototypeSelection = false;
-	
-	if (bPerception)
-	{
-		if (MainTablePerception.IsValid())
-		{
-			MainTablePerception->GetSelectedAlgorithmNames(SelectedAlgorithmNames);
-			bHasAlgorithmSelection = (SelectedAlgorithmNames.Num() > 0);
-		}
-		if (PrototypeTablePerception.IsValid())
-		{
-			PrototypeTablePerception->GetSelectedPrototypeNames(SelectedPrototypeNames);
-			bHasPrototypeSelection = (SelectedPrototypeNames.Num() > 0);
-		}
-	}
-	else
-	{
-		if (MainTableDecision.IsValid())
-		{
-			MainTableDecision->GetSelectedAlgorithmNames(SelectedAlgorithmNames);
-			bHasAlgorithmSelection = (SelectedAlgorithmNames.Num() > 0);
-		}
-		if (PrototypeTableDecision.IsValid())
-		{
-			PrototypeTableDecision->GetSelectedPrototypeNames(SelectedPrototypeNames);
-			bHasPrototypeSelection = (SelectedPrototypeNames.Num() > 0);
-		}
-	}
-	
-	const bool bSubsystemOverride = bPerception ? bPerceptionSubsystemOverride : bDecisionSubsystemOverride;
-	
-	// 优先级：分系统覆盖 > 算法 > 分系统 > 显示全部
-	if (bSubsystemOverride && bHasPrototypeSelection)
-	{
-		IndicatorSelector->SetFilter(false, SelectedPrototypeNames, TestMethodIndex == 0, bPerception);
-	}
-	else if (bHasAlgorithmSelection)
+	FString FactorText;
+	for (EScenarioFactor Factor : Design.Factors)
 	{
-		IndicatorSelector->SetFilter(true, SelectedAlgorithmNames, TestMethodIndex == 0, bPerception);
-	}
-	else if (bHasPrototypeSelection)
-	{
-		IndicatorSelector->SetFilter(false, SelectedPrototypeNames, TestMethodIndex == 0, bPerception);
-	}
-	else
-	{
-		// 没有选择，清空过滤（显示所有指标）
-		IndicatorSelector->SetFilter(false, TArray<FString>(), false, bPerception);
+		if (!FactorText.IsEmpty()) { FactorText += TEXT("、"); }
+		FactorText += FString::Printf(TEXT("%s(%d)"), *OrthogonalDesign::GetFactorName(Factor), OrthogonalDesign::GetFactorLevelCount(Factor));
 	}
-}
 
+	const FString DesignText = FString::Printf(TEXT("正交表 %s，共 %d 个试验单元；因素（水平数）：%s"),
+		*Design.Array.Name, Design.Cells.Num(), *FactorText);
 
+	return SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f,0.f,0.f,6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("正交批量测试")))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::BoldFont(13))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f,0.f,0.f,6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(DesignText))
+				.ColorAndOpacity(ScenarioStyle::TextDim)
+				.Font(ScenarioStyle::Font(12))
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.ButtonStyle(FCoreStyle::Get(), "Button")
+					.ContentPadding(FMargin(12.f, 6.f))
+					.OnClicked_Lambda([this]()
+					{
+						UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+						if (!Subsystem)
+						{
+							return FReply::Handled();
+						}
+						if (Subsystem->IsOrthogonalBatchRunning())
+						{
+							Subsystem->CancelOrthogonalBatch();
+						}
+						else
+						{
+							FScenarioTestConfig Config;
+							CollectScenarioConfig(Config);
+							FString Error;
+							Subsystem->StartOrthogonalBatch(Config, Error);
+						}
+						return FReply::Handled();
+					})
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this]()
+						{
+							const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+							const bool bRunning = Subsystem && Subsystem->IsOrthogonalBatchRunning();
+							return FText::FromString(bRunning ? TEXT("取消正交批量测试") : TEXT("启动正交批量测试"));
+						})
+						.ColorAndOpacity(ScenarioStyle::Text)
+						.Font(ScenarioStyle::Font(12))
+					]
+				]
+				+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center).Padding(12.f,0.f,0.f,0.f)
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this]()
+					{
+						const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+						const FOrthogonalBatchExecutor* Executor = Subsystem ? Subsystem->GetOrthogonalExecutor() : nullptr;
+						if (!Executor || (!Executor->IsRunning() && !Executor->HasResults()))
+						{
+							return FText::FromString(TEXT("工作进程在后台以无界面模式运行，可通过 ir.Orthogonal.* 控制台变量调整并行数与重复次数"));
+						}
+						if (Executor->IsRunning())
+						{
+							return FText::FromString(FString::Printf(TEXT("进度：%d / %d（运行中 %d，失败 %d）"),
+								Executor->GetFinishedCellCount(), Executor->GetCellCount(), Executor->GetActiveWorkerCount(), Executor->GetFailedCellCount()));
+						}
+						return FText::FromString(FString::Printf(TEXT("已完成：%d / %d 个单元有效，结果目录 %s"),
+							Executor->GetMainEffects().CompletedCells, Executor->GetCellCount(), *Executor->GetOutputDirectory()));
+					})
+					.ColorAndOpacity(ScenarioStyle::TextDim)
+					.Font(ScenarioStyle::Font(12))
+					.AutoWrapText(true)
+				]
+			]
+		];
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildOrthogonalEffectsPanel()
+{
+	const TSharedRef<SVerticalBox> Panel = SNew(SVerticalBox);
+
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	const FOrthogonalBatchExecutor* Executor = Subsystem ? Subsystem->GetOrthogonalExecutor() : nullptr;
+	if (!Executor || !Executor->HasResults())
+	{
+		return Panel;
+	}
+
+	const FOrthogonalMainEffects& Effects = Executor->GetMainEffects();
+
+	Panel->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(TEXT("正交试验主效应（极差分析）")))
+		.ColorAndOpacity(ScenarioStyle::Text)
+		.Font(ScenarioStyle::BoldFont(16))
+	];
+
+	Panel->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(FString::Printf(TEXT("%s，有效单元 %d / %d；极差 R 越大，该因素对响应影响越显著。结果目录：%s"),
+			*Effects.ArrayName, Effects.CompletedCells, Effects.CellCount, *Executor->GetOutputDirectory())))
+		.ColorAndOpacity(ScenarioStyle::TextDim)
+		.Font(ScenarioStyle::Font(12))
+		.AutoWrapText(true)
+	];
+
+	if (Effects.Responses.Num() == 0)
+	{
+		Panel->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(TEXT("所有试验单元均未产生结果，请检查工作进程日志。")))
+			.ColorAndOpacity(FLinearColor(0.85f, 0.2f, 0.2f))
+			.Font(ScenarioStyle::Font(13))
+		];
+	}
+
+	for (const FOrthogonalResponseEffects& Response : Effects.Responses)
+	{
+		TSharedRef<SGridPanel> Grid = SNew(SGridPanel).FillColumn(3, 1.f);
+		static const TCHAR* Headers[] = { TEXT("因素"), TEXT("极差 R"), TEXT("最优水平"), TEXT("各水平均值") };
+		for (int32 Column = 0; Column < static_cast<int32>(UE_ARRAY_COUNT(Headers)); ++Column)
+		{
+			Grid->AddSlot(Column, 0).Padding(4.f, 2.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Headers[Column]))
+				.ColorAndOpacity(ScenarioStyle::TextDim)
+				.Font(ScenarioStyle::BoldFont(12))
+			];
+		}
+
+		int32 Row = 1;
+		for (const FOrthogonalFactorEffect& Effect : Response.Factors)
+		{
+			FString LevelText;
+			for (int32 Level = 0; Level < Effect.LevelMeans.Num(); ++Level)
+			{
+				if (Effect.LevelSamples[Level] == 0)
+				{
+					continue;
+				}
+				if (!LevelText.IsEmpty()) { LevelText += TEXT("  "); }
+				LevelText += FString::Printf(TEXT("%s %.2f"), *OrthogonalDesign::GetFactorLevelName(Effect.Factor, Level), Effect.LevelMeans[Level]);
+			}
+
+			Grid->AddSlot(0, Row).Padding(4.f, 2.f)
+			[
+				SNew(STextBlock).Text(FText::FromString(OrthogonalDesign::GetFactorName(Effect.Factor))).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+			];
+			Grid->AddSlot(1, Row).Padding(4.f, 2.f)
+			[
+				SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.2f"), Effect.Range)))
+				.ColorAndOpacity(Row == 1 ? ScenarioStyle::Accent : ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+			];
+			Grid->AddSlot(2, Row).Padding(4.f, 2.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Effect.BestLevel != INDEX_NONE ? OrthogonalDesign::GetFactorLevelName(Effect.Factor, Effect.BestLevel) : TEXT("-")))
+				.ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+			];
+			Grid->AddSlot(3, Row).Padding(4.f, 2.f)
+			[
+				SNew(STextBlock).Text(FText::FromString(LevelText)).ColorAndOpacity(ScenarioStyle::TextDim).Font(ScenarioStyle::Font(12)).AutoWrapText(true)
+			];
+			++Row;
+		}
+
+		Panel->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+		[
+			SNew(SBorder)
+			.Padding(12.f)
+			.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+			.BorderBackgroundColor(ScenarioStyle::Panel)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(FString::Printf(TEXT("%s（%s）"), *Response.Name, Response.bHigherIsBetter ? TEXT("越大越好") : TEXT("越小越好"))))
+					.ColorAndOpacity(ScenarioStyle::Text)
+					.Font(ScenarioStyle::BoldFont(13))
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					Grid
+				]
+			]
+		];
+	}
+
+	return Panel;
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildBranchComparisonPanel()
+{
+	const TSharedRef<SVerticalBox> Panel = SNew(SVerticalBox);
+
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	const FScenarioBranchExecutor* Executor = Subsystem ? Subsystem->GetBranchExecutor() : nullptr;
+	if (!Executor || (!Executor->IsRunning() && !Executor->HasResults()))
+	{
+		return Panel;
+	}
+
+	Panel->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(TEXT("分支推演（what-if）对比")))
+		.ColorAndOpacity(ScenarioStyle::Text)
+		.Font(ScenarioStyle::BoldFont(16))
+	];
+
+	// 运行中只显示进度，结束后由子系统刷新 Step5 展示对比表
+	if (Executor->IsRunning())
+	{
+		Panel->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text_Lambda([this]()
+			{
+				const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+				const FScenarioBranchExecutor* Executor = Subsystem ? Subsystem->GetBranchExecutor() : nullptr;
+				if (!Executor)
+				{
+					return FText::GetEmpty();
+				}
+				return FText::FromString(FString::Printf(TEXT("检查点 %.1f 秒，进度：%d / %d 个分支（运行中 %d）"),
+					Executor->GetCheckpointSessionSeconds(), Executor->GetFinishedBranchCount(), Executor->GetBranchCount(), Executor->GetActiveWorkerCount()));
+			})
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::Font(12))
+			.AutoWrapText(true)
+		];
+		return Panel;
+	}
+
+	const TArray<FScenarioBranchResult>& Results = Executor->GetResults();
+	const FScenarioBranchResult* Baseline = Results.Num() > 0 && Results[0].bCompleted ? &Results[0] : nullptr;
+
+	Panel->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(FString::Printf(TEXT("各分支从测试第 %.1f 秒的检查点继续（同一随机种子），Δ 为相对基线的差值。结果目录：%s"),
+			Executor->GetCheckpointSessionSeconds(), *Executor->GetOutputDirectory())))
+		.ColorAndOpacity(ScenarioStyle::TextDim)
+		.Font(ScenarioStyle::Font(12))
+		.AutoWrapText(true)
+	];
+
+	TSharedRef<SGridPanel> Grid = SNew(SGridPanel).FillColumn(0, 1.f);
+	static const TCHAR* Headers[] = { TEXT("分支"), TEXT("命中"), TEXT("命中率"), TEXT("Δ命中率"), TEXT("达标指标"), TEXT("状态") };
+	for (int32 Column = 0; Column < static_cast<int32>(UE_ARRAY_COUNT(Headers)); ++Column)
+	{
+		Grid->AddSlot(Column, 0).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Headers[Column]))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::BoldFont(12))
+		];
+	}
+
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FScenarioBranchResult& Result = Results[Index];
+		const int32 Row = Index + 1;
+		const bool bHasDelta = Result.bCompleted && Baseline && Index > 0;
+		const float Delta = bHasDelta ? Result.HitRate - Baseline->HitRate : 0.f;
+		const FString StatusText = !Result.bCompleted ? (Result.bTimedOut ? TEXT("超时终止") : TEXT("无结果")) : (Result.bTimedOut ? TEXT("超时") : TEXT("完成"));
+
+		Grid->AddSlot(0, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Result.Variant.Name)).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(1, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result.bCompleted ? FString::Printf(TEXT("%d / %d"), Result.Hits, Result.TotalShots) : TEXT("-")))
+			.ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(2, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result.bCompleted ? FString::Printf(TEXT("%.1f%%"), Result.HitRate) : TEXT("-")))
+			.ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(3, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(bHasDelta ? FString::Printf(TEXT("%+.1f%%"), Delta) : TEXT("-")))
+			.ColorAndOpacity(!bHasDelta || FMath::IsNearlyZero(Delta) ? ScenarioStyle::TextDim
+				: (Delta > 0.f ? FLinearColor(0.2f, 0.8f, 0.3f) : FLinearColor(0.85f, 0.2f, 0.2f)))
+			.Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(4, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result.bCompleted ? FString::Printf(TEXT("%d / %d"), Result.PassedIndicators, Result.EvaluatedIndicators) : TEXT("-")))
+			.ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(5, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(StatusText))
+			.ColorAndOpacity(Result.bCompleted && !Result.bTimedOut ? ScenarioStyle::TextDim : ScenarioStyle::Accent)
+			.Font(ScenarioStyle::Font(12))
+		];
+	}
+
+	Panel->AddSlot().AutoHeight()
+	[
+		SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			Grid
+		]
+	];
+
+	return Panel;
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildResultsHistoryPanel()
+{
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	const FScenarioTestConfig Config = Subsystem ? Subsystem->GetActiveScenarioConfig() : FScenarioTestConfig();
+
+	const auto MakeFilterToggle = [this](const FString& Label, bool* bFlag) -> TSharedRef<SWidget>
+	{
+		return SNew(SCheckBox)
+			.IsChecked_Lambda([bFlag]() { return *bFlag ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+			.OnCheckStateChanged_Lambda([this, bFlag](ECheckBoxState NewState)
+			{
+				*bFlag = NewState == ECheckBoxState::Checked;
+				RefreshResultsHistory();
+			})
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Label))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::Font(12))
+			];
+	};
+
+	const FString AlgorithmText = Config.SelectedAlgorithmNames.Num() > 0 ? FString::Join(Config.SelectedAlgorithmNames, TEXT("、")) : FString(TEXT("-"));
+
+	HistoryContentBox = SNew(SVerticalBox);
+	RefreshResultsHistory();
+
+	return SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("历史趋势（跨会话命中率）")))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::BoldFont(14))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0.f, 0.f, 16.f, 0.f)
+				[
+					MakeFilterToggle(FString::Printf(TEXT("同地图（%s）"), *OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Map, Config.MapIndex)), &bHistoryMatchMap)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0.f, 0.f, 16.f, 0.f)
+				[
+					MakeFilterToggle(FString::Printf(TEXT("同天气（%s）"), *OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Weather, Config.WeatherIndex)), &bHistoryMatchWeather)
+				]
+				+ SHorizontalBox::Slot().AutoWidth().Padding(0.f, 0.f, 16.f, 0.f)
+				[
+					MakeFilterToggle(FString::Printf(TEXT("同时间（%s）"), *OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Time, Config.TimeIndex)), &bHistoryMatchTime)
+				]
+				+ SHorizontalBox::Slot().FillWidth(1.f)
+				[
+					MakeFilterToggle(FString::Printf(TEXT("包含当前算法（%s）"), *AlgorithmText), &bHistoryMatchAlgorithms)
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				HistoryContentBox.ToSharedRef()
+			]
+		];
+}
+
+void SScenarioScreen::RefreshResultsHistory()
+{
+	if (!HistoryContentBox.IsValid())
+	{
+		return;
+	}
+	HistoryContentBox->ClearChildren();
+
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	const FScenarioTestConfig& Config = Subsystem->GetActiveScenarioConfig();
+	const FResultsHistoryStore& History = Subsystem->GetResultsHistory();
+
+	FResultsHistoryQuery Query;
+	Query.MapIndex = bHistoryMatchMap ? Config.MapIndex : INDEX_NONE;
+	Query.WeatherIndex = bHistoryMatchWeather ? Config.WeatherIndex : INDEX_NONE;
+	Query.TimeIndex = bHistoryMatchTime ? Config.TimeIndex : INDEX_NONE;
+	if (bHistoryMatchAlgorithms)
+	{
+		Query.RequiredAlgorithms = Config.SelectedAlgorithmNames;
+	}
+
+	// 筛选只在内存中的索引上进行，不读取会话详情
+	TArray<int32> Matches;
+	History.Query(Query, Matches);
+
+	if (Matches.Num() == 0)
+	{
+		HistoryContentBox->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(FString::Printf(TEXT("没有符合条件的历史会话（历史共 %d 次会话）。"), History.GetEntryCount())))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::Font(12))
+		];
+		return;
+	}
+
+	double HitRateSum = 0.0;
+	int64 ShotSum = 0;
+	for (int32 Index : Matches)
+	{
+		HitRateSum += History.GetEntry(Index).HitRate;
+		ShotSum += History.GetEntry(Index).TotalShots;
+	}
+
+	HistoryContentBox->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(FString::Printf(TEXT("匹配 %d / %d 次会话，累计发射 %lld 枚，平均命中率 %.1f%%"),
+			Matches.Num(), History.GetEntryCount(), ShotSum, HitRateSum / Matches.Num())))
+		.ColorAndOpacity(ScenarioStyle::Text)
+		.Font(ScenarioStyle::Font(12))
+	];
+
+	// 命中率趋势：最近的会话在右侧，每根柱子一次会话
+	constexpr int32 MaxTrendBars = 60;
+	constexpr float TrendHeight = 80.f;
+	const TSharedRef<SHorizontalBox> Trend = SNew(SHorizontalBox);
+	for (int32 MatchIndex = FMath::Max(0, Matches.Num() - MaxTrendBars); MatchIndex < Matches.Num(); ++MatchIndex)
+	{
+		const FResultsHistoryEntry& Entry = History.GetEntry(Matches[MatchIndex]);
+		Trend->AddSlot().AutoWidth().Padding(1.f, 0.f)
+		[
+			SNew(SBox)
+			.WidthOverride(8.f)
+			.HeightOverride(TrendHeight)
+			.ToolTipText(FText::FromString(FString::Printf(TEXT("%s  命中率 %.1f%%  发射 %d"),
+				*Entry.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M")), Entry.HitRate, Entry.TotalShots)))
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().FillHeight(1.f)
+				[
+					SNew(SSpacer)
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					SNew(SBox)
+					.HeightOverride(FMath::Clamp(Entry.HitRate, 1.f, 100.f) * TrendHeight / 100.f)
+					[
+						SNew(SBorder)
+						.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+						.BorderBackgroundColor(ScenarioStyle::Accent)
+					]
+				]
+			]
+		];
+	}
+
+	HistoryContentBox->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+	[
+		Trend
+	];
+
+	// 最近会话列表
+	TSharedRef<SGridPanel> Grid = SNew(SGridPanel).FillColumn(4, 1.f);
+	static const TCHAR* Headers[] = { TEXT("时间"), TEXT("发射"), TEXT("命中率"), TEXT("直接命中率"), TEXT("场景") };
+	for (int32 Column = 0; Column < static_cast<int32>(UE_ARRAY_COUNT(Headers)); ++Column)
+	{
+		Grid->AddSlot(Column, 0).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Headers[Column]))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::BoldFont(12))
+		];
+	}
+
+	constexpr int32 MaxListedSessions = 10;
+	int32 Row = 1;
+	for (int32 MatchIndex = Matches.Num() - 1; MatchIndex >= FMath::Max(0, Matches.Num() - MaxListedSessions); --MatchIndex)
+	{
+		const FResultsHistoryEntry& Entry = History.GetEntry(Matches[MatchIndex]);
+		const FString SceneText = FString::Printf(TEXT("%s / %s / %s"),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Map, Entry.MapIndex),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Weather, Entry.WeatherIndex),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Time, Entry.TimeIndex));
+
+		Grid->AddSlot(0, Row).Padding(4.f, 2.f)[ SNew(STextBlock).Text(FText::FromString(Entry.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M:%S")))).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12)) ];
+		Grid->AddSlot(1, Row).Padding(4.f, 2.f)[ SNew(STextBlock).Text(FText::AsNumber(Entry.TotalShots)).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12)) ];
+		Grid->AddSlot(2, Row).Padding(4.f, 2.f)[ SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.1f%%"), Entry.HitRate))).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12)) ];
+		Grid->AddSlot(3, Row).Padding(4.f, 2.f)[ SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.1f%%"), Entry.DirectHitRate))).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12)) ];
+		Grid->AddSlot(4, Row).Padding(4.f, 2.f)[ SNew(STextBlock).Text(FText::FromString(SceneText)).ColorAndOpacity(ScenarioStyle::TextDim).Font(ScenarioStyle::Font(12)) ];
+		++Row;
+	}
+
+	HistoryContentBox->AddSlot().AutoHeight()
+	[
+		Grid
+	];
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildEnvironmentSensitivityPanel()
+{
+	SensitivityContentBox = SNew(SVerticalBox);
+	RefreshEnvironmentSensitivity();
+
+	return SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(TEXT("环境因素敏感性（天气 × 时间 × 地图）")))
+					.ColorAndOpacity(ScenarioStyle::Text)
+					.Font(ScenarioStyle::BoldFont(14))
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.ButtonStyle(FCoreStyle::Get(), "Button")
+					.ContentPadding(FMargin(12.f, 6.f))
+					.IsEnabled_Lambda([this]()
+					{
+						const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+						return Subsystem && Subsystem->HasMissileTestData() && !Subsystem->GetEnvironmentSensitivity();
+					})
+					.OnClicked_Lambda([this]()
+					{
+						if (UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get())
+						{
+							Subsystem->RunEnvironmentSensitivitySweep();
+							RefreshEnvironmentSensitivity();
+						}
+						return FReply::Handled();
+					})
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString(TEXT("分析环境影响")))
+						.ColorAndOpacity(ScenarioStyle::Text)
+						.Font(ScenarioStyle::Font(12))
+					]
+				]
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				SensitivityContentBox.ToSharedRef()
+			]
+		];
+}
+
+void SScenarioScreen::RefreshEnvironmentSensitivity()
+{
+	if (!SensitivityContentBox.IsValid())
+	{
+		return;
+	}
+	SensitivityContentBox->ClearChildren();
+
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	const FEnvironmentSensitivityResult* Result = Subsystem ? Subsystem->GetEnvironmentSensitivity() : nullptr;
+	if (!Result)
+	{
+		SensitivityContentBox->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(TEXT("用本次发射记录在全部环境组合下重新评估指标（不重新仿真），查看哪个环境因素导致指标未达标。")))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::Font(12))
+			.WrapTextAt(720.f)
+		];
+		return;
+	}
+
+	SensitivityContentBox->AddSlot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(FString::Printf(TEXT("基线：%s / %s / %s，共 %d 种组合。条形为单个因素遍历全部水平（其余因素保持基线）时指标的最差值到最好值，红色为比基线差的一侧。"),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Map, Result->BaseMapIndex),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Weather, Result->BaseWeatherIndex),
+			*OrthogonalDesign::GetFactorLevelName(EScenarioFactor::Time, Result->BaseTimeIndex),
+			Result->CellCount)))
+		.ColorAndOpacity(ScenarioStyle::TextDim)
+		.Font(ScenarioStyle::Font(11))
+		.WrapTextAt(720.f)
+	];
+
+	constexpr float ChartWidth = 360.f;
+	const FLinearColor WorseColor(0.85f, 0.2f, 0.2f);
+	const FLinearColor BetterColor(0.1f, 0.8f, 0.3f);
+	int32 UnaffectedCount = 0;
+
+	for (const FEnvironmentIndicatorSensitivity& Indicator : Result->Indicators)
+	{
+		if (Indicator.Swings.Num() == 0 || Indicator.Swings[0].GetSwing() <= KINDA_SMALL_NUMBER)
+		{
+			++UnaffectedCount;
+			continue;
+		}
+
+		// 同一指标的各因素共用一条坐标轴，包含基线与目标值
+		float AxisMin = FMath::Min(Indicator.BaselineValue, Indicator.TargetValue);
+		float AxisMax = FMath::Max(Indicator.BaselineValue, Indicator.TargetValue);
+		for (const FEnvironmentFactorSwing& Swing : Indicator.Swings)
+		{
+			AxisMin = FMath::Min3(AxisMin, Swing.WorstValue, Swing.BestValue);
+			AxisMax = FMath::Max3(AxisMax, Swing.WorstValue, Swing.BestValue);
+		}
+		const float AxisRange = FMath::Max(AxisMax - AxisMin, KINDA_SMALL_NUMBER);
+
+		TSharedRef<SVerticalBox> Bars = SNew(SVerticalBox);
+		for (const FEnvironmentFactorSwing& Swing : Indicator.Swings)
+		{
+			const float Low = FMath::Min(Swing.WorstValue, Swing.BestValue);
+			const float High = FMath::Max(Swing.WorstValue, Swing.BestValue);
+			const float Baseline = FMath::Clamp(Indicator.BaselineValue, Low, High);
+			// 基线以下一侧在越大越好时为较差的一侧
+			const FLinearColor LowColor = Indicator.bHigherIsBetter ? WorseColor : BetterColor;
+			const FLinearColor HighColor = Indicator.bHigherIsBetter ? BetterColor : WorseColor;
+
+			Bars->AddSlot().AutoHeight().Padding(0.f, 1.f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SBox)
+					.WidthOverride(48.f)
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString(OrthogonalDesign::GetFactorName(Swing.Factor)))
+						.ColorAndOpacity(ScenarioStyle::TextDim)
+						.Font(ScenarioStyle::Font(11))
+					]
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SBox)
+					.WidthOverride(ChartWidth)
+					.HeightOverride(12.f)
+					[
+						SNew(SHorizontalBox)
+						+ SHorizontalBox::Slot().FillWidth(Low - AxisMin)[ SNew(SSpacer) ]
+						+ SHorizontalBox::Slot().FillWidth(Baseline - Low)
+						[
+							SNew(SBorder)
+							.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+							.BorderBackgroundColor(LowColor)
+						]
+						+ SHorizontalBox::Slot().FillWidth(High - Baseline)
+						[
+							SNew(SBorder)
+							.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+							.BorderBackgroundColor(HighColor)
+						]
+						+ SHorizontalBox::Slot().FillWidth(AxisMax - High)[ SNew(SSpacer) ]
+					]
+				]
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f, 0.f, 0.f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString(FString::Printf(TEXT("%s %.2f  ~  %s %.2f（%d/%d 个水平达标）"),
+						*OrthogonalDesign::GetFactorLevelName(Swing.Factor, Swing.WorstLevel), Swing.WorstValue,
+						*OrthogonalDesign::GetFactorLevelName(Swing.Factor, Swing.BestLevel), Swing.BestValue,
+						Swing.PassingLevels, Swing.LevelCount)))
+					.ColorAndOpacity(ScenarioStyle::Text)
+					.Font(ScenarioStyle::Font(11))
+				]
+			];
+		}
+
+		SensitivityContentBox->AddSlot().AutoHeight().Padding(0.f, 4.f, 0.f, 8.f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 2.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%s  基线 %.2f（%s），目标 %s %.2f，%d/%d 种组合达标（坐标 %.2f ~ %.2f）"),
+					*Indicator.DisplayName, Indicator.BaselineValue, Indicator.bBaselinePass ? TEXT("达标") : TEXT("未达标"),
+					Indicator.bHigherIsBetter ? TEXT("≥") : TEXT("≤"), Indicator.TargetValue,
+					Indicator.PassingCells, Result->CellCount, AxisMin, AxisMin + AxisRange)))
+				.ColorAndOpacity(Indicator.bBaselinePass ? ScenarioStyle::Text : WorseColor)
+				.Font(ScenarioStyle::BoldFont(12))
+				.WrapTextAt(720.f)
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				Bars
+			]
+		];
+	}
+
+	if (UnaffectedCount > 0)
+	{
+		SensitivityContentBox->AddSlot().AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(FString::Printf(TEXT("另有 %d 项指标不受天气、时间与地图因子影响。"), UnaffectedCount)))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::Font(11))
+		];
+	}
+}
+
+FText SScenarioScreen::GetIndicatorConfidenceText(int32 IndicatorIndex) const
+{
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	if (!Subsystem)
+	{
+		return FText::GetEmpty();
+	}
+
+	const FIndicatorBootstrap& Bootstrap = Subsystem->GetIndicatorBootstrap();
+	if (Bootstrap.IsRunning())
+	{
+		return FText::FromString(FString::Printf(TEXT("置信区间计算中 %.0f%%"), Bootstrap.GetProgress() * 100.f));
+	}
+
+	const FIndicatorConfidenceInterval Interval = Bootstrap.GetInterval(IndicatorIndex);
+	const FString Range = FString::Printf(TEXT("95%% 置信区间 [%.2f, %.2f]，%d 次重抽样"), Interval.Lower, Interval.Upper, Bootstrap.GetResampleCount());
+	switch (Interval.Verdict)
+	{
+	case EIndicatorConfidence::ConfidentPass:
+		return FText::FromString(FString::Printf(TEXT("置信达标（%s）"), *Range));
+	case EIndicatorConfidence::ConfidentFail:
+		return FText::FromString(FString::Printf(TEXT("置信未达标（%s）"), *Range));
+	case EIndicatorConfidence::Inconclusive:
+		return FText::FromString(FString::Printf(TEXT("结论不确定：区间跨过目标值，需要更多发射（%s）"), *Range));
+	case EIndicatorConfidence::InsufficientData:
+		return FText::FromString(TEXT("结论不确定：样本不足，无法估计置信区间"));
+	case EIndicatorConfidence::NotApplicable:
+		return FText::FromString(TEXT("置信区间：不适用（非逐发记录统计的指标）"));
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+FSlateColor SScenarioScreen::GetIndicatorConfidenceColor(int32 IndicatorIndex) const
+{
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	if (!Subsystem || Subsystem->GetIndicatorBootstrap().IsRunning())
+	{
+		return ScenarioStyle::TextDim;
+	}
+
+	switch (Subsystem->GetIndicatorBootstrap().GetInterval(IndicatorIndex).Verdict)
+	{
+	case EIndicatorConfidence::ConfidentPass:
+		return FLinearColor(0.1f, 0.8f, 0.3f);
+	case EIndicatorConfidence::ConfidentFail:
+		return FLinearColor(0.85f, 0.2f, 0.2f);
+	case EIndicatorConfidence::Inconclusive:
+	case EIndicatorConfidence::InsufficientData:
+		return FLinearColor(0.95f, 0.7f, 0.2f);
+	default:
+		return ScenarioStyle::TextDim;
+	}
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildPerceptionContent()
+{
+	// 与决策 Tab 完全一致的面板与按钮，确保样式/间距/按钮完全相同
+	UE_LOG(LogTemp, Log, TEXT("BuildPerceptionContent called - reuse BuildDecisionContent"));
+	return BuildDecisionContent();
+}
+
+void SScenarioScreen::UpdateIndicatorFilter()
+{
+	if (!IndicatorSelector.IsValid())
+	{
+		return;
+	}
+	
+	const bool bPerception = (ActiveTabIndex == 0);
+	
+	// 获取Step1的选择状态
+	TArray<FString> SelectedAlgorithmNames;
+	TArray<FString> SelectedPrototypeNames;
+	bool bHasAlgorithmSelection = false;
+	bool bHasPrototypeSelection = false;
+	
+	if (bPerception)
+	{
+		if (MainTablePerception.IsValid())
+		{
+			MainTablePerception->GetSelectedAlgorithmNames(SelectedAlgorithmNames);
+			bHasAlgorithmSelection = (SelectedAlgorithmNames.Num() > 0);
+		}
+		if (PrototypeTablePerception.IsValid())
+		{
+			PrototypeTablePerception->GetSelectedPrototypeNames(SelectedPrototypeNames);
+			bHasPrototypeSelection = (SelectedPrototypeNames.Num() > 0);
+		}
+	}
+	else
+	{
+		if (MainTableDecision.IsValid())
+		{
+			MainTableDecision->GetSelectedAlgorithmNames(SelectedAlgorithmNames);
+			bHasAlgorithmSelection = (SelectedAlgorithmNames.Num() > 0);
+		}
+		if (PrototypeTableDecision.IsValid())
+		{
+			PrototypeTableDecision->GetSelectedPrototypeNames(SelectedPrototypeNames);
+			bHasPrototypeSelection = (SelectedPrototypeNames.Num() > 0);
+		}
+	}
+	
+	const bool bSubsystemOverride = bPerception ? bPerceptionSubsystemOverride : bDecisionSubsystemOverride;
+	
+	// 优先级：分系统覆盖 > 算法 > 分系统 > 显示全部
+	if (bSubsystemOverride && bHasPrototypeSelection)
+	{
+		IndicatorSelector->SetFilter(false, SelectedPrototypeNames, TestMethodIndex == 0, bPerception);
+	}
+	else if (bHasAlgorithmSelection)
+	{
+		IndicatorSelector->SetFilter(true, SelectedAlgorithmNames, TestMethodIndex == 0, bPerception);
+	}
+	else if (bHasPrototypeSelection)
+	{
+		IndicatorSelector->SetFilter(false, SelectedPrototypeNames, TestMethodIndex == 0, bPerception);
+	}
+	else
+	{
+		// 没有选择，清空过滤（显示所有指标）
+		IndicatorSelector->SetFilter(false, TArray<FString>(), false, bPerception);
+	}
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildMonteCarloCard()
+{
+	return SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f,0.f,0.f,6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("随机采样蒙特卡洛测试")))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::BoldFont(13))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f,0.f,0.f,6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("每轮使用新的随机种子重新部署蓝方并自动发射，各指标 95% 置信区间足够窄后自动停止；按 P 可提前结束。阈值与轮数见 ir.MonteCarlo.* 控制台变量。")))
+				.ColorAndOpacity(ScenarioStyle::TextDim)
+				.Font(ScenarioStyle::Font(12))
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.ButtonStyle(FCoreStyle::Get(), "Button")
+					.ContentPadding(FMargin(12.f, 6.f))
+					.OnClicked_Lambda([this]()
+					{
+						if (UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get())
+						{
+							FScenarioTestConfig Config;
+							CollectScenarioConfig(Config);
+							Subsystem->StartMonteCarloCampaign(Config);
+						}
+						return FReply::Handled();
+					})
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString(TEXT("启动随机采样测试")))
+						.ColorAndOpacity(ScenarioStyle::Text)
+						.Font(ScenarioStyle::Font(12))
+					]
+				]
+			]
+		];
+}
+
+TSharedRef<SWidget> SScenarioScreen::BuildMonteCarloPanel()
+{
+	const TSharedRef<SVerticalBox> Panel = SNew(SVerticalBox);
+
+	const UScenarioMenuSubsystem* Subsystem = OwnerSubsystemWeak.Get();
+	const FMonteCarloCampaign* Campaign = Subsystem ? Subsystem->GetMonteCarloCampaign() : nullptr;
+	if (!Campaign || !Campaign->HasResults())
+	{
+		return Panel;
+	}
+
+	const FMonteCarloAggregates& Aggregates = Campaign->GetAggregates();
+
+	TSharedRef<SGridPanel> Grid = SNew(SGridPanel).FillColumn(0, 1.f);
+	static const TCHAR* Headers[] = { TEXT("指标"), TEXT("均值 ± 95%半宽"), TEXT("标准差"), TEXT("样本"), TEXT("达标率"), TEXT("收敛") };
+	for (int32 Column = 0; Column < static_cast<int32>(UE_ARRAY_COUNT(Headers)); ++Column)
+	{
+		Grid->AddSlot(Column, 0).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Headers[Column]))
+			.ColorAndOpacity(ScenarioStyle::TextDim)
+			.Font(ScenarioStyle::BoldFont(12))
+		];
+	}
+
+	int32 Row = 1;
+	for (const FMonteCarloIndicatorStats& Indicator : Aggregates.GetIndicators())
+	{
+		const FString MeanText = Indicator.Value.Count > 1
+			? FString::Printf(TEXT("%.2f ± %.2f"), Indicator.Value.Mean, Indicator.Value.GetHalfWidth95())
+			: FString::Printf(TEXT("%.2f"), Indicator.Value.Mean);
+		const FString PassText = Indicator.bHasTarget ? FString::Printf(TEXT("%.0f%%"), Indicator.GetPassRate()) : TEXT("—");
+		const FLinearColor ConvergedColor = Indicator.bConverged ? FLinearColor(0.1f, 0.8f, 0.3f) : FLinearColor(0.85f, 0.6f, 0.2f);
+
+		Grid->AddSlot(0, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Indicator.Name)).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12)).AutoWrapText(true)
+		];
+		Grid->AddSlot(1, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(MeanText)).ColorAndOpacity(ScenarioStyle::Text).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(2, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.2f"), Indicator.Value.GetStdDev()))).ColorAndOpacity(ScenarioStyle::TextDim).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(3, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::AsNumber(Indicator.Value.Count)).ColorAndOpacity(ScenarioStyle::TextDim).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(4, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(PassText)).ColorAndOpacity(ScenarioStyle::TextDim).Font(ScenarioStyle::Font(12))
+		];
+		Grid->AddSlot(5, Row).Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Indicator.bConverged ? TEXT("是") : TEXT("否"))).ColorAndOpacity(ConvergedColor).Font(ScenarioStyle::Font(12))
+		];
+		++Row;
+	}
+
+	const FString StatusText = Campaign->IsRunning()
+		? FString::Printf(TEXT("运行中：已完成 %d 轮（最多 %d 轮）"), Aggregates.GetRunCount(), Campaign->GetMaxRuns())
+		: FString::Printf(TEXT("%s；共 %d 轮有效。下方“测试结果”为最后一轮数据。结果目录：%s"),
+			*Campaign->GetStopReason(), Aggregates.GetRunCount(), *Campaign->GetOutputDirectory());
+
+	Panel->AddSlot().AutoHeight()
+	[
+		SNew(SBorder)
+		.Padding(12.f)
+		.BorderImage(FCoreStyle::Get().GetBrush("NoBorder"))
+		.BorderBackgroundColor(ScenarioStyle::Panel)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 6.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(TEXT("随机采样统计（蒙特卡洛）")))
+				.ColorAndOpacity(ScenarioStyle::Text)
+				.Font(ScenarioStyle::BoldFont(16))
+			]
+			+ SVerticalBox::Slot().AutoHeight().Padding(0.f, 0.f, 0.f, 8.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(StatusText))
+				.ColorAndOpacity(Campaign->IsConverged() ? ScenarioStyle::TextDim : FLinearColor(0.85f, 0.6f, 0.2f))
+				.Font(ScenarioStyle::Font(12))
+				.AutoWrapText(true)
+			]
+			+ SVerticalBox::Slot().AutoHeight()
+			[
+				Grid
+			]
+		]
+	];
+
+	return Panel;
+}
@@ -85,6 +85,17 @@ private:
 	TSharedRef<SWidget> BuildDecisionStep3();
 	TSharedRef<SWidget> BuildDecisionStep4();
 	TSharedRef<SWidget> BuildDecisionStep5();
+	TSharedRef<SWidget> BuildOrthogonalBatchCard(const FScenarioTestConfig& Snapshot); // Step4：正交批量测试
+	TSharedRef<SWidget> BuildOrthogonalEffectsPanel(); // Step5：正交试验主效应表
+	TSharedRef<SWidget> BuildMonteCarloCard(); // Step4：随机采样蒙特卡洛测试
+	TSharedRef<SWidget> BuildMonteCarloPanel(); // Step5：随机采样统计
+	TSharedRef<SWidget> BuildResultsHistoryPanel(); // Step5：跨会话历史趋势
+	void RefreshResultsHistory();
+	TSharedRef<SWidget> BuildEnvironmentSensitivityPanel(); // Step5：环境因素敏感性（龙卷风图）
+	void RefreshEnvironmentSensitivity();
+	TSharedRef<SWidget> BuildBranchComparisonPanel(); // Step5：分支推演对比
+	FText GetIndicatorConfidenceText(int32 IndicatorIndex) const; // Step5：指标的 Bootstrap 置信结论
+	FSlateColor GetIndicatorConfidenceColor(int32 IndicatorIndex) const;
 	
 	// 根据Step1的选择状态更新Step2的指标过滤
 	void UpdateIndicatorFilter();
@@ -109,6 +120,13 @@ private:
 	TSharedPtr<class SIndicatorSelector> IndicatorSelector; // Step2
 	TSharedPtr<class SEnvironmentBuilder> EnvironmentBuilder; // Step3
 	TSharedPtr<class SVerticalBox> DecisionContentBox; // content container for step area
+	// Step5 历史趋势的筛选条件：勾选时按当前配置的对应项筛选
+	TSharedPtr<class SVerticalBox> HistoryContentBox;
+	bool bHistoryMatchMap = true;
+	bool bHistoryMatchWeather = true;
+	bool bHistoryMatchTime = false;
+	bool bHistoryMatchAlgorithms = true;
+	TSharedPtr<class SVerticalBox> SensitivityContentBox;
 	TWeakObjectPtr<class UScenarioMenuSubsystem> OwnerSubsystemWeak;
 
 	FOnPrevStep OnPrevStep;
@@ -14,6 +14,7 @@
 #include "Slate/SlateBrushAsset.h"
 #include "Engine/Texture2D.h"
 #include "UObject/SoftObjectPath.h"
+#include "Systems/ScenarioAssetPreloader.h"
 
 namespace
 {
@@ -819,19 +820,43 @@ void SEnvironmentBuilder::OnApplyPreset(int32 PresetIndex)
 
 void SEnvironmentBuilder::UpdateMapPreview()
 {
-	static const TCHAR* PreviewPaths[] =
-	{
-		TEXT("Texture2D'/Game/Map_Cover/Desert.Desert'"),
-		TEXT("Texture2D'/Game/Map_Cover/Forest.Forest'"),
-		TEXT("Texture2D'/Game/Map_Cover/Snow.Snow'"),
-		TEXT("Texture2D'/Game/Map_Cover/Sea.Sea'")
-	};
-
 	UTexture2D* DesiredTexture = nullptr;
-	if (SelectedMapIndex >= 0 && SelectedMapIndex < UE_ARRAY_COUNT(PreviewPaths))
+	bool bWaitingForPreview = false;
+	if (SelectedMapIndex >= 0 && SelectedMapIndex < ScenarioAssets::MapPreviewCount)
 	{
-		DesiredTexture = LoadMapPreviewTexture(PreviewPaths[SelectedMapIndex]);
-		if (!DesiredTexture && SelectedMapIndex == 3)
+		const FSoftObjectPath PreviewPath = ScenarioAssets::GetMapPreviewPath(SelectedMapIndex);
+		DesiredTexture = ScenarioAssets::ResolveLoaded<UTexture2D>(PreviewPath);
+		if (!DesiredTexture && !bMapPreviewsRequested)
+		{
+			// 预览图异步加载，完成后刷新；界面先显示加载提示，不阻塞游戏线程
+			bMapPreviewsRequested = true;
+			TWeakPtr<SEnvironmentBuilder> WeakSelf = SharedThis(this);
+			FScenarioAssetPreloader::Get().PreloadMapPreviews(FSimpleDelegate::CreateLambda([WeakSelf]()
+			{
+				if (TSharedPtr<SEnvironmentBuilder> Self = WeakSelf.Pin())
+				{
+					Self->bMapPreviewsLoaded = true;
+					Self->UpdateMapPreview();
+				}
+			}));
+			if (bMapPreviewsLoaded)
+			{
+				// 回调已同步执行并刷新了预览
+				return;
+			}
+			bWaitingForPreview = true;
+		}
+		else if (!DesiredTexture && !bMapPreviewsLoaded)
+		{
+			bWaitingForPreview = true;
+		}
+		else if (!DesiredTexture)
+		{
+			// 异步加载后仍未找到：回退到同步加载与名称查找（资源命名不一致时）
+			DesiredTexture = LoadMapPreviewTexture(*PreviewPath.ToString());
+		}
+
+		if (!DesiredTexture && !bWaitingForPreview && SelectedMapIndex == 3)
 		{
 			// 如果Sea.Sea加载失败，尝试使用资源名称查找（更灵活）
 			DesiredTexture = LoadMapPreviewTextureByName(TEXT("Sea"));
@@ -885,7 +910,7 @@ void SEnvironmentBuilder::UpdateMapPreview()
 		if (MapPreviewText.IsValid())
 		{
 			MapPreviewText->SetVisibility(EVisibility::Visible);
-			MapPreviewText->SetText(FText::FromString(TEXT("请选择地图以查看预览")));
+			MapPreviewText->SetText(FText::FromString(bWaitingForPreview ? TEXT("正在加载地图预览…") : TEXT("请选择地图以查看预览")));
 			MapPreviewText->SetWrapTextAt(520.f);
 		}
 	}
@@ -89,4 +89,6 @@ private:
 	TSharedPtr<STextBlock> MapPreviewText;
 	TSharedPtr<FSlateBrush> MapPreviewBrush;
 	TWeakObjectPtr<UTexture2D> CachedPreviewTexture;
+	bool bMapPreviewsRequested = false; // 预览图已发起异步加载
+	bool bMapPreviewsLoaded = false;
 };
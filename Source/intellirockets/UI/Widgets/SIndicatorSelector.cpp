@@ -1,6 +1,6 @@
 #include "UI/Widgets/SIndicatorSelector.h"
 #include "UI/Styles/ScenarioStyle.h"
-#include "UI/Data/IndicatorData.h"
+#include "UI/Data/IndicatorDataCache.h"
 
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -50,10 +50,16 @@ void SIndicatorSelector::Construct(const FArguments& InArgs)
 	{
 		ConfigPath = FPaths::ProjectConfigDir() / TEXT("DecisionIndicators.json");
 	}
-	if (!FIndicatorDataLoader::LoadFromFile(ConfigPath, IndicatorData))
+	// 返回步骤二时会重建本控件，经二进制缓存加载避免每次重新解析 JSON
+	FIndicatorCatalog Catalog;
+	if (!FIndicatorDataCache::Load(ConfigPath, Catalog))
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to load indicator data from: %s"), *ConfigPath);
 	}
+	IndicatorData = MoveTemp(Catalog.Data);
+	IndicatorCount = Catalog.IndicatorCount;
+	IndicatorsByAlgorithm = MoveTemp(Catalog.IndicatorsByAlgorithm);
+	IndicatorsByPrototype = MoveTemp(Catalog.IndicatorsByPrototype);
 
 	// 默认选择第一个分类和子分类
 	if (IndicatorData.Categories.Num() > 0 && IndicatorData.Categories[0].SubCategories.Num() > 0)
@@ -233,8 +239,23 @@ void SIndicatorSelector::SetFilter(bool bIsAlgorithm, const TArray<FString>& Sel
 	bFilterIsAlgorithmLevel = bIsAlgorithmLevel;
 	bFilterIsPerceptionTab = bIsPerceptionTab;
 	
+	// 由过滤索引求出名称匹配的指标（扁平下标）
+	TBitArray<> NameMatches(false, IndicatorCount);
+	const TMap<FString, TArray<int32>>& NameIndex = bFilterIsAlgorithm ? IndicatorsByAlgorithm : IndicatorsByPrototype;
+	for (const FString& SelectedName : FilterSelectedNames)
+	{
+		if (const TArray<int32>* Postings = NameIndex.Find(SelectedName))
+		{
+			for (const int32 FlatIndex : *Postings)
+			{
+				NameMatches[FlatIndex] = true;
+			}
+		}
+	}
+
 	// 应用过滤，生成过滤后的数据
 	FilteredIndicatorData.Categories.Empty();
+	int32 FlatIndex = 0;
 	for (const FIndicatorCategory& Category : IndicatorData.Categories)
 	{
 		FIndicatorCategory FilteredCategory;
@@ -249,10 +270,11 @@ void SIndicatorSelector::SetFilter(bool bIsAlgorithm, const TArray<FString>& Sel
 			
 			for (const FIndicatorInfo& Indicator : SubCat.Indicators)
 			{
-				if (!bFilterActive || MatchesFilter(Indicator))
+				if (!bFilterActive || (NameMatches[FlatIndex] && MatchesFilterLevel(Indicator)))
 				{
 					FilteredSubCat.Indicators.Add(Indicator);
 				}
+				++FlatIndex;
 			}
 			
 			if (FilteredSubCat.Indicators.Num() > 0)
@@ -283,42 +305,13 @@ void SIndicatorSelector::SetFilter(bool bIsAlgorithm, const TArray<FString>& Sel
 	RefreshIndicatorList();
 }
 
-bool SIndicatorSelector::MatchesFilter(const FIndicatorInfo& Indicator) const
+bool SIndicatorSelector::MatchesFilterLevel(const FIndicatorInfo& Indicator) const
 {
 	if (!bFilterActive) return true;
 	
 	// 检查级别匹配
 	FString ExpectedLevel = bFilterIsAlgorithmLevel ? TEXT("algorithm") : TEXT("system");
-	if (!Indicator.Level.IsEmpty() && Indicator.Level != ExpectedLevel)
-	{
-		return false;
-	}
-	
-	// 检查名称匹配
-	if (bFilterIsAlgorithm)
-	{
-		// 选择的是算法，检查algorithmNames
-		for (const FString& SelectedName : FilterSelectedNames)
-		{
-			if (Indicator.AlgorithmNames.Contains(SelectedName))
-			{
-				return true;
-			}
-		}
-		return false;
-	}
-	else
-	{
-		// 选择的是分系统，检查prototypeNames
-		for (const FString& SelectedName : FilterSelectedNames)
-		{
-			if (Indicator.PrototypeNames.Contains(SelectedName))
-			{
-				return true;
-			}
-		}
-		return false;
-	}
+	return Indicator.Level.IsEmpty() || Indicator.Level == ExpectedLevel;
 }
 
 void SIndicatorSelector::RefreshIndicatorList()
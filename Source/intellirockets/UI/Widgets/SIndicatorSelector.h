@@ -2,7 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
-#include "UI/Data/IndicatorData.h"
+#include "UI/Data/IndicatorDataCache.h"
 
 /**
  * 指标选择器：左侧分类列表，中间指标列表，右侧已选指标列表
@@ -47,6 +47,9 @@ private:
 private:
 	FIndicatorData IndicatorData;
 	FIndicatorData FilteredIndicatorData;  // 过滤后的指标数据
+	int32 IndicatorCount = 0;              // 分类树中的指标数（扁平下标上限）
+	TMap<FString, TArray<int32>> IndicatorsByAlgorithm;  // 缓存中预先生成的过滤索引：名称 -> 扁平下标
+	TMap<FString, TArray<int32>> IndicatorsByPrototype;
 	int32 SelectedCategoryIndex = -1;
 	int32 SelectedSubCategoryIndex = -1;
 	TSet<FString> SelectedIndicatorIds;  // 已选择的指标ID集合
@@ -58,8 +61,8 @@ private:
 	bool bFilterIsAlgorithmLevel = false;
 	bool bFilterIsPerceptionTab = false;
 	
-	// 检查指标是否匹配过滤条件
-	bool MatchesFilter(const FIndicatorInfo& Indicator) const;
+	// 检查指标级别是否匹配过滤条件（名称匹配由过滤索引完成）
+	bool MatchesFilterLevel(const FIndicatorInfo& Indicator) const;
 
 	TSharedPtr<SScrollBox> CategoryListScrollBox;
 	TSharedPtr<SScrollBox> IndicatorListScrollBox;
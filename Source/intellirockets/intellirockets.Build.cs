@@ -23,7 +23,10 @@ public class intellirockets : ModuleRules
 				"JsonUtilities",
 				"NavigationSystem",
 				"AIModule",
-				"ProceduralMeshComponent"
+				"ProceduralMeshComponent",
+				"TraceLog",
+				"Sockets",
+				"Networking"
 			}
 		);
 
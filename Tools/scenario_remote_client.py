@@ -0,0 +1,98 @@
+"""场景远程控制接口示例客户端（-ScenarioRemote 或 ir.Remote.Enable=1）。
+
+依次对每个场景文件调用 run（载入 -> 部署 -> 发射 -> 等待 -> 结算），
+流式打印进度，并把每次的结果写入输出目录。任一场景调用失败时以非零退出码结束。
+
+用法：
+    python scenario_remote_client.py Scenarios/a.json Scenarios/b.json --shots 10 --seed 42 --out Saved/RemoteRuns
+    python scenario_remote_client.py --status
+"""
+
+import argparse
+import itertools
+import json
+import os
+import sys
+import urllib.request
+
+_ids = itertools.count(1)
+
+
+def call(url, method, params=None, stream=False, timeout=900):
+    payload = {"jsonrpc": "2.0", "id": next(_ids), "method": method, "params": params or {}}
+    request = urllib.request.Request(
+        url,
+        data=json.dumps(payload).encode("utf-8"),
+        headers={
+            "Content-Type": "application/json",
+            "Accept": "application/x-ndjson" if stream else "application/json",
+        },
+    )
+    response = None
+    with urllib.request.urlopen(request, timeout=timeout) as http:
+        # urllib 自动处理分块传输，逐行读取即可
+        for raw in http:
+            line = raw.decode("utf-8").strip()
+            if not line:
+                continue
+            message = json.loads(line)
+            if message.get("method") == "progress":
+                progress = message["params"]
+                print("  [%s] remaining=%s active=%s/%s records=%s" % (
+                    progress.get("phase"), progress.get("autoFireRemaining"), progress.get("activeMissiles"),
+                    progress.get("activeInterceptors"), progress.get("records")))
+            else:
+                response = message
+    if response is None:
+        raise RuntimeError("%s: no response" % method)
+    if "error" in response:
+        raise RuntimeError("%s: %s (%s)" % (method, response["error"]["message"], response["error"]["code"]))
+    return response["result"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="intellirockets 场景远程控制客户端")
+    parser.add_argument("scenarios", nargs="*", help="场景文件（相对路径按工程目录解析）")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=47811)
+    parser.add_argument("--shots", type=int, default=5)
+    parser.add_argument("--seed", type=int, default=None)
+    parser.add_argument("--timeout", type=float, default=180.0, help="等待导弹结算的世界时间上限（秒）")
+    parser.add_argument("--out", default=None, help="结果输出目录")
+    parser.add_argument("--status", action="store_true", help="只查询当前状态")
+    args = parser.parse_args()
+
+    url = "http://%s:%d/rpc" % (args.host, args.port)
+    if args.status or not args.scenarios:
+        print(json.dumps(call(url, "getStatus"), indent=2, ensure_ascii=False))
+        return 0
+
+    if args.out:
+        os.makedirs(args.out, exist_ok=True)
+
+    failures = 0
+    for scenario in args.scenarios:
+        print("== %s" % scenario)
+        params = {"file": scenario, "shots": args.shots, "timeout": args.timeout}
+        if args.seed is not None:
+            params["seed"] = args.seed
+        try:
+            result = call(url, "run", params, stream=True)
+        except (RuntimeError, OSError) as error:
+            print("  FAILED: %s" % error)
+            failures += 1
+            continue
+
+        summary = result.get("summary", {})
+        print("  pass=%s timedOut=%s summary=%s" % (result.get("pass"), result.get("timedOut"),
+                                                    json.dumps(summary, ensure_ascii=False)))
+        if args.out:
+            name = os.path.splitext(os.path.basename(scenario))[0] + "_result.json"
+            with open(os.path.join(args.out, name), "w", encoding="utf-8") as handle:
+                json.dump(result, handle, indent=2, ensure_ascii=False)
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
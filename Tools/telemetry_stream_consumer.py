@@ -0,0 +1,196 @@
+"""实时遥测流参考客户端（ir.Stream.Enable=1）。
+
+连接 127.0.0.1:ir.Stream.Port，解析长度前缀的二进制帧并校验格式，
+不依赖任何外部服务。校验失败时以非零退出码结束，可直接用于测试。
+
+用法：
+    python telemetry_stream_consumer.py --port 47810 --rate 10 --duration 30
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+MAGIC = 0x53545249  # "IRTS"
+VERSION = 2
+
+FRAME_HELLO = 0
+FRAME_SESSION_BEGIN = 1
+FRAME_STATE = 2
+FRAME_EVENT = 3
+FRAME_SUMMARY = 4
+FRAME_SESSION_END = 5
+FRAME_GAP = 6
+FRAME_CLIENT_RATE = 0x80
+
+STATE_HEADER = struct.Struct("<IfI")  # 序号、会话时间、导弹数量
+STATE_MISSILE = struct.Struct("<IBB3ffBi")  # Id、是否拦截弹、状态、位置、最近干扰器距离、目标类别、目标
+EVENT = struct.Struct("<fBi3f")
+SUMMARY = struct.Struct("<f6if")
+
+TARGET_KIND_NAMES = ["none", "missile", "blue"]  # EMissileTelemetryTargetKind
+
+EVENT_NAMES = [
+    "MissileLaunch",
+    "InterceptorLaunch",
+    "MissileImpact",
+    "MissileExpired",
+    "Intercepted",
+    "BlueUnitDestroyed",
+    "JammerActivated",
+]
+
+
+class ValidationError(Exception):
+    pass
+
+
+def recv_exact(sock, size):
+    data = bytearray()
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError("server closed the connection")
+        data.extend(chunk)
+    return bytes(data)
+
+
+def read_frame(sock):
+    (length,) = struct.unpack("<I", recv_exact(sock, 4))
+    if length < 1 or length > 16 * 1024 * 1024:
+        raise ValidationError("invalid frame length %d" % length)
+    body = recv_exact(sock, length)
+    return body[0], body[1:]
+
+
+def send_client_rate(sock, rate):
+    payload = struct.pack("<Bf", FRAME_CLIENT_RATE, rate)
+    sock.sendall(struct.pack("<I", len(payload)) + payload)
+
+
+class StreamValidator:
+    def __init__(self, verbose):
+        self.verbose = verbose
+        self.frames = 0
+        self.states = 0
+        self.events = 0
+        self.summaries = 0
+        self.dropped = 0
+        self.last_sequence = None
+        self.last_state_time = None
+        self.session = None
+        self.state_times = []
+
+    def handle(self, frame_type, payload):
+        self.frames += 1
+        if self.frames == 1 and frame_type != FRAME_HELLO:
+            raise ValidationError("first frame must be Hello, got %d" % frame_type)
+
+        if frame_type == FRAME_HELLO:
+            magic, version, server_rate, max_rate = struct.unpack("<IHff", payload)
+            if magic != MAGIC or version != VERSION:
+                raise ValidationError("bad hello magic=%08x version=%d" % (magic, version))
+            print("hello: server rate %.1f Hz, client limit %.1f Hz" % (server_rate, max_rate))
+        elif frame_type == FRAME_SESSION_BEGIN:
+            (self.session,) = struct.unpack("<I", payload)
+            self.last_sequence = None
+            self.last_state_time = None
+            print("session %d begin" % self.session)
+        elif frame_type == FRAME_STATE:
+            self.handle_state(payload)
+        elif frame_type == FRAME_EVENT:
+            seconds, event_type, subject, x, y, z = EVENT.unpack(payload)
+            self.events += 1
+            name = EVENT_NAMES[event_type] if event_type < len(EVENT_NAMES) else str(event_type)
+            if self.verbose:
+                print("  %8.2fs %-18s subject=%d at (%.0f, %.0f, %.0f)" % (seconds, name, subject, x, y, z))
+        elif frame_type == FRAME_SUMMARY:
+            seconds, shots, hits, direct, misses, active, interceptors, hit_rate = SUMMARY.unpack(payload)
+            self.summaries += 1
+            if hits + misses > shots or min(shots, hits, direct, misses, active, interceptors) < 0:
+                raise ValidationError("inconsistent summary at %.2fs" % seconds)
+            print("  %8.2fs shots=%d hits=%d (direct %d) misses=%d active=%d/%d hit rate %.1f%%"
+                  % (seconds, shots, hits, direct, misses, active, interceptors, hit_rate))
+        elif frame_type == FRAME_SESSION_END:
+            (seconds,) = struct.unpack("<f", payload)
+            print("session %s end at %.2fs" % (self.session, seconds))
+            self.session = None
+        elif frame_type == FRAME_GAP:
+            (dropped,) = struct.unpack("<I", payload)
+            self.dropped += dropped
+            print("  gap: server dropped %d state frames (client too slow)" % dropped)
+        else:
+            raise ValidationError("unknown frame type %d" % frame_type)
+
+    def handle_state(self, payload):
+        sequence, seconds, count = STATE_HEADER.unpack_from(payload)
+        expected = STATE_HEADER.size + count * STATE_MISSILE.size
+        if len(payload) != expected:
+            raise ValidationError("state frame size %d, expected %d" % (len(payload), expected))
+        if self.last_sequence is not None and sequence <= self.last_sequence:
+            raise ValidationError("state sequence went backwards: %d -> %d" % (self.last_sequence, sequence))
+        if self.last_state_time is not None and seconds < self.last_state_time:
+            raise ValidationError("state time went backwards: %.3f -> %.3f" % (self.last_state_time, seconds))
+        self.last_sequence = sequence
+        self.last_state_time = seconds
+        self.states += 1
+        self.state_times.append(time.monotonic())
+        if self.verbose:
+            for index in range(count):
+                missile_id, interceptor, state, x, y, z, jammer, target_kind, target = STATE_MISSILE.unpack_from(
+                    payload, STATE_HEADER.size + index * STATE_MISSILE.size)
+                print("    #%d %s state=%d pos=(%.0f, %.0f, %.0f) jammer=%.0f target=%s:%d"
+                      % (missile_id, "interceptor" if interceptor else "missile", state, x, y, z, jammer,
+                         TARGET_KIND_NAMES[target_kind] if target_kind < len(TARGET_KIND_NAMES) else target_kind, target))
+
+    def observed_rate(self):
+        if len(self.state_times) < 2:
+            return 0.0
+        return (len(self.state_times) - 1) / (self.state_times[-1] - self.state_times[0])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="intellirockets 实时遥测流参考客户端")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=47810)
+    parser.add_argument("--rate", type=float, default=0.0, help="请求的状态帧频率（Hz），0 表示按服务端上限")
+    parser.add_argument("--duration", type=float, default=0.0, help="接收时长（秒），0 表示直到会话结束")
+    parser.add_argument("--slow", type=float, default=0.0, help="每帧处理后额外等待的秒数，用于验证背压")
+    parser.add_argument("--verbose", action="store_true")
+    args = parser.parse_args()
+
+    validator = StreamValidator(args.verbose)
+    deadline = time.monotonic() + args.duration if args.duration > 0 else None
+    try:
+        with socket.create_connection((args.host, args.port), timeout=10) as sock:
+            if args.rate > 0:
+                send_client_rate(sock, args.rate)
+            while deadline is None or time.monotonic() < deadline:
+                frame_type, payload = read_frame(sock)
+                validator.handle(frame_type, payload)
+                if frame_type == FRAME_SESSION_END and deadline is None:
+                    break
+                if args.slow > 0:
+                    time.sleep(args.slow)
+    except ValidationError as error:
+        print("INVALID: %s" % error)
+        return 1
+    except (ConnectionError, socket.timeout) as error:
+        print("connection: %s" % error)
+
+    rate = validator.observed_rate()
+    print("frames=%d states=%d events=%d summaries=%d dropped=%d observed state rate %.1f Hz"
+          % (validator.frames, validator.states, validator.events, validator.summaries, validator.dropped, rate))
+    if validator.frames == 0:
+        print("INVALID: no frames received")
+        return 1
+    if args.rate > 0 and rate > args.rate * 1.5:
+        print("INVALID: state rate %.1f Hz exceeds requested %.1f Hz" % (rate, args.rate))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())